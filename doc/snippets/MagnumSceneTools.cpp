@@ -31,6 +31,7 @@
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/DeduplicateMeshes.h"
 #include "Magnum/SceneTools/FlattenMeshHierarchy.h"
 #include "Magnum/SceneTools/OrderClusterParents.h"
 #include "Magnum/Trade/SceneData.h"
@@ -109,6 +110,37 @@ scene.meshesMaterialsInto(
 /* [flattenMeshHierarchy3DInto] */
 }
 
+{
+UnsignedInt selectedObject{};
+/* [FlattenedMeshHierarchy] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+SceneTools::FlattenedMeshHierarchy3D flattened{scene};
+
+/* Every frame, modify transformations in the scene in-place and recalculate
+   only the affected subtrees */
+scene.mutableField<Matrix4>(Trade::SceneField::Transformation)[DOXYGEN_ELLIPSIS(0)] = DOXYGEN_ELLIPSIS(Matrix4{});
+flattened.update({selectedObject});
+for(const Matrix4& transformation: flattened.transformations()) {
+    DOXYGEN_ELLIPSIS(static_cast<void>(transformation);)
+}
+/* [FlattenedMeshHierarchy] */
+}
+
+{
+/* [deduplicateMeshes] */
+Trade::SceneData scene = DOXYGEN_ELLIPSIS(Trade::SceneData{{}, 0, nullptr, {}});
+Containers::Array<Trade::MeshData> meshes = DOXYGEN_ELLIPSIS({});
+
+/* Meshes that are exact or rigidly transformed copies of another get dropped,
+   references to them replaced with the mesh they're a copy of */
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out =
+    SceneTools::deduplicateMeshes(scene, std::move(meshes),
+        SceneTools::DuplicateMeshFlag::RigidTransformations);
+scene = std::move(out.first());
+meshes = std::move(out.second());
+/* [deduplicateMeshes] */
+}
+
 
 {
 /* [orderClusterParents-transformations] */
@@ -87,6 +87,8 @@
 #  VulkanTester                 - VulkanTester class
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImporter               - Magnum blob importer plugin
+#  MagnumSceneConverter         - Magnum blob scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -373,8 +375,9 @@ set(_MAGNUM_LIBRARY_COMPONENTS
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
-    TgaImageConverter TgaImporter WavAudioImporter)
+    AnySceneImporter MagnumFont MagnumFontConverter MagnumImporter
+    MagnumSceneConverter ObjImporter TgaImageConverter TgaImporter
+    WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
 # Audio and Vk libs aren't enabled by default, and none of the Context,
@@ -460,7 +463,11 @@ if(MAGNUM_TARGET_GL)
 endif()
 
 set(_MAGNUM_SceneGraph_DEPENDENCIES )
-set(_MAGNUM_SceneTools_DEPENDENCIES Trade)
+set(_MAGNUM_SceneTools_DEPENDENCIES MeshTools Trade)
+if(MAGNUM_TARGET_GL)
+    # GL not required by SceneTools themselves, but transitively by MeshTools
+    list(APPEND _MAGNUM_SceneTools_DEPENDENCIES GL)
+endif()
 set(_MAGNUM_Shaders_DEPENDENCIES GL)
 
 set(_MAGNUM_Text_DEPENDENCIES TextureTools)
@@ -893,6 +900,9 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # MeshTools library
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
 
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
@@ -911,6 +921,9 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # SceneTools library
         elseif(_component STREQUAL SceneTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES FlattenMeshHierarchy.h)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
 
         # ShaderTools library
         elseif(_component STREQUAL ShaderTools)
@@ -938,6 +951,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             find_package(Vulkan REQUIRED)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Vulkan::Vulkan)
+
+        # ObjImporter plugin
+        elseif(_component STREQUAL ObjImporter)
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
         endif()
 
         # No special setup for AnyAudioImporter plugin
@@ -946,7 +965,8 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnySceneImporter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
-        # No special setup for ObjImporter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
         # No special setup for WavAudioImporter plugin
@@ -44,6 +44,8 @@ cmake .. \
     -DMAGNUM_WITH_ANYSHADERCONVERTER=OFF \
     -DMAGNUM_WITH_MAGNUMFONT=ON \
     -DMAGNUM_WITH_MAGNUMFONTCONVERTER=ON \
+    -DMAGNUM_WITH_MAGNUMIMPORTER=OFF \
+    -DMAGNUM_WITH_MAGNUMSCENECONVERTER=OFF \
     -DMAGNUM_WITH_OBJIMPORTER=OFF \
     -DMAGNUM_WITH_TGAIMAGECONVERTER=ON \
     -DMAGNUM_WITH_TGAIMPORTER=ON \
@@ -0,0 +1,382 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include <limits>
+#include <Corrade/Cpu.h>
+
+#ifdef CORRADE_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_SSE41
+#include <smmintrin.h>
+#endif
+#if defined(CORRADE_ENABLE_AVX) || defined(CORRADE_ENABLE_AVX2)
+#include <immintrin.h>
+#endif
+
+#include "Magnum/Math/Implementation/functionsBatch.h"
+
+namespace Magnum { namespace Math {
+
+Corrade::Cpu::Features& Implementation::functionsBatchCpuFeatures() {
+    static Corrade::Cpu::Features features = Corrade::Cpu::runtimeFeatures();
+    return features;
+}
+
+namespace {
+
+/* All kernels operate on a contiguous run of `count` scalars, with
+   `count` being a multiple of `componentCount`. The SIMD variants always
+   process three registers at a time, which makes the lane-to-component
+   mapping the same in every iteration even for three-component vectors, and
+   then delegate the remaining few values to the scalar variant.
+
+   The min/max kernels update `min` and `max` that have `componentCount`
+   items and are expected to be initialized by the caller. NaNs compare false
+   to everything, so they never replace an existing value and thus are
+   skipped. */
+
+/* Initial values for the accumulators, for floats chosen so any value
+   including an infinity replaces them */
+template<class T> constexpr T minInitial() { return std::numeric_limits<T>::max(); }
+template<class T> constexpr T maxInitial() { return std::numeric_limits<T>::min(); }
+template<> constexpr Float minInitial<Float>() { return std::numeric_limits<Float>::infinity(); }
+template<> constexpr Float maxInitial<Float>() { return -std::numeric_limits<Float>::infinity(); }
+
+template<class T> void minmaxScalar(const T* data, const std::size_t count, const std::size_t componentCount, T* const min, T* const max) {
+    for(std::size_t i = 0; i != count; i += componentCount) {
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            const T value = data[i + j];
+            if(value < min[j]) min[j] = value;
+            if(value > max[j]) max[j] = value;
+        }
+    }
+}
+
+/* Folds per-lane minima and maxima of a SIMD kernel into the output */
+template<class T> void minmaxFoldLanes(const T* const laneMin, const T* const laneMax, const std::size_t laneCount, const std::size_t componentCount, T* const min, T* const max) {
+    for(std::size_t i = 0; i != laneCount; i += componentCount) {
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            if(laneMin[i + j] < min[j]) min[j] = laneMin[i + j];
+            if(laneMax[i + j] > max[j]) max[j] = laneMax[i + j];
+        }
+    }
+}
+
+/* Returns a mask of components that are NaN in at least one item, exits
+   early once all components are found to be NaN */
+UnsignedInt isNanScalar(const Float* data, const std::size_t count, const std::size_t componentCount, UnsignedInt mask) {
+    const UnsignedInt all = (1u << componentCount) - 1;
+    for(std::size_t i = 0; i != count && mask != all; i += componentCount)
+        for(std::size_t j = 0; j != componentCount; ++j)
+            if(data[i + j] != data[i + j]) mask |= 1u << j;
+    return mask;
+}
+
+/* Converts a mask of NaN lanes to a mask of NaN components. The lanes are
+   expected to start at the first component. */
+UnsignedInt isNanLaneMask(UnsignedInt lanes, const std::size_t componentCount) {
+    UnsignedInt mask = 0;
+    for(std::size_t i = 0; lanes; ++i, lanes >>= 1)
+        if(lanes & 1) mask |= 1u << (i % componentCount);
+    return mask;
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+CORRADE_ENABLE_SSE2 void minmaxSse2(const Float* data, const std::size_t count, const std::size_t componentCount, Float* const min, Float* const max) {
+    __m128 min0 = _mm_set1_ps(minInitial<Float>());
+    __m128 min1 = min0, min2 = min0;
+    __m128 max0 = _mm_set1_ps(maxInitial<Float>());
+    __m128 max1 = max0, max2 = max0;
+
+    std::size_t i = 0;
+    for(; i + 12 <= count; i += 12) {
+        const __m128 a = _mm_loadu_ps(data + i + 0);
+        const __m128 b = _mm_loadu_ps(data + i + 4);
+        const __m128 c = _mm_loadu_ps(data + i + 8);
+        /* If either operand is a NaN, the second one is returned */
+        min0 = _mm_min_ps(a, min0);
+        min1 = _mm_min_ps(b, min1);
+        min2 = _mm_min_ps(c, min2);
+        max0 = _mm_max_ps(a, max0);
+        max1 = _mm_max_ps(b, max1);
+        max2 = _mm_max_ps(c, max2);
+    }
+
+    Float laneMin[12], laneMax[12];
+    _mm_storeu_ps(laneMin + 0, min0);
+    _mm_storeu_ps(laneMin + 4, min1);
+    _mm_storeu_ps(laneMin + 8, min2);
+    _mm_storeu_ps(laneMax + 0, max0);
+    _mm_storeu_ps(laneMax + 4, max1);
+    _mm_storeu_ps(laneMax + 8, max2);
+    minmaxFoldLanes(laneMin, laneMax, 12, componentCount, min, max);
+    minmaxScalar(data + i, count - i, componentCount, min, max);
+}
+
+CORRADE_ENABLE_SSE2 UnsignedInt isNanSse2(const Float* data, const std::size_t count, const std::size_t componentCount) {
+    const UnsignedInt all = (1u << componentCount) - 1;
+    UnsignedInt mask = 0;
+
+    std::size_t i = 0;
+    for(; i + 12 <= count; i += 12) {
+        const __m128 a = _mm_loadu_ps(data + i + 0);
+        const __m128 b = _mm_loadu_ps(data + i + 4);
+        const __m128 c = _mm_loadu_ps(data + i + 8);
+        const __m128 nanA = _mm_cmpunord_ps(a, a);
+        const __m128 nanB = _mm_cmpunord_ps(b, b);
+        const __m128 nanC = _mm_cmpunord_ps(c, c);
+        /* NaNs are rare, so check all three at once first */
+        if(!_mm_movemask_ps(_mm_or_ps(nanA, _mm_or_ps(nanB, nanC))))
+            continue;
+
+        mask |= isNanLaneMask(_mm_movemask_ps(nanA)|
+                              _mm_movemask_ps(nanB) << 4|
+                              _mm_movemask_ps(nanC) << 8, componentCount);
+        if(mask == all) return mask;
+    }
+
+    return isNanScalar(data + i, count - i, componentCount, mask);
+}
+#endif
+
+#ifdef CORRADE_ENABLE_SSE41
+template<class T> CORRADE_ENABLE_SSE41 void minmaxSse41(const T* data, const std::size_t count, const std::size_t componentCount, T* const min, T* const max) {
+    __m128i min0 = _mm_set1_epi32(Int(minInitial<T>()));
+    __m128i min1 = min0, min2 = min0;
+    __m128i max0 = _mm_set1_epi32(Int(maxInitial<T>()));
+    __m128i max1 = max0, max2 = max0;
+
+    std::size_t i = 0;
+    for(; i + 12 <= count; i += 12) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 0));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 8));
+        if(std::is_signed<T>::value) {
+            min0 = _mm_min_epi32(a, min0);
+            min1 = _mm_min_epi32(b, min1);
+            min2 = _mm_min_epi32(c, min2);
+            max0 = _mm_max_epi32(a, max0);
+            max1 = _mm_max_epi32(b, max1);
+            max2 = _mm_max_epi32(c, max2);
+        } else {
+            min0 = _mm_min_epu32(a, min0);
+            min1 = _mm_min_epu32(b, min1);
+            min2 = _mm_min_epu32(c, min2);
+            max0 = _mm_max_epu32(a, max0);
+            max1 = _mm_max_epu32(b, max1);
+            max2 = _mm_max_epu32(c, max2);
+        }
+    }
+
+    T laneMin[12], laneMax[12];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMin + 0), min0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMin + 4), min1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMin + 8), min2);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMax + 0), max0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMax + 4), max1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(laneMax + 8), max2);
+    minmaxFoldLanes(laneMin, laneMax, 12, componentCount, min, max);
+    minmaxScalar(data + i, count - i, componentCount, min, max);
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX
+/* Same as the SSE2 variants, but with eight-wide registers */
+CORRADE_ENABLE_AVX void minmaxAvx(const Float* data, const std::size_t count, const std::size_t componentCount, Float* const min, Float* const max) {
+    __m256 min0 = _mm256_set1_ps(minInitial<Float>());
+    __m256 min1 = min0, min2 = min0;
+    __m256 max0 = _mm256_set1_ps(maxInitial<Float>());
+    __m256 max1 = max0, max2 = max0;
+
+    std::size_t i = 0;
+    for(; i + 24 <= count; i += 24) {
+        const __m256 a = _mm256_loadu_ps(data + i + 0);
+        const __m256 b = _mm256_loadu_ps(data + i + 8);
+        const __m256 c = _mm256_loadu_ps(data + i + 16);
+        min0 = _mm256_min_ps(a, min0);
+        min1 = _mm256_min_ps(b, min1);
+        min2 = _mm256_min_ps(c, min2);
+        max0 = _mm256_max_ps(a, max0);
+        max1 = _mm256_max_ps(b, max1);
+        max2 = _mm256_max_ps(c, max2);
+    }
+
+    Float laneMin[24], laneMax[24];
+    _mm256_storeu_ps(laneMin + 0, min0);
+    _mm256_storeu_ps(laneMin + 8, min1);
+    _mm256_storeu_ps(laneMin + 16, min2);
+    _mm256_storeu_ps(laneMax + 0, max0);
+    _mm256_storeu_ps(laneMax + 8, max1);
+    _mm256_storeu_ps(laneMax + 16, max2);
+    minmaxFoldLanes(laneMin, laneMax, 24, componentCount, min, max);
+    minmaxScalar(data + i, count - i, componentCount, min, max);
+}
+
+CORRADE_ENABLE_AVX UnsignedInt isNanAvx(const Float* data, const std::size_t count, const std::size_t componentCount) {
+    const UnsignedInt all = (1u << componentCount) - 1;
+    UnsignedInt mask = 0;
+
+    std::size_t i = 0;
+    for(; i + 24 <= count; i += 24) {
+        const __m256 a = _mm256_loadu_ps(data + i + 0);
+        const __m256 b = _mm256_loadu_ps(data + i + 8);
+        const __m256 c = _mm256_loadu_ps(data + i + 16);
+        const __m256 nanA = _mm256_cmp_ps(a, a, _CMP_UNORD_Q);
+        const __m256 nanB = _mm256_cmp_ps(b, b, _CMP_UNORD_Q);
+        const __m256 nanC = _mm256_cmp_ps(c, c, _CMP_UNORD_Q);
+        if(!_mm256_movemask_ps(_mm256_or_ps(nanA, _mm256_or_ps(nanB, nanC))))
+            continue;
+
+        mask |= isNanLaneMask(_mm256_movemask_ps(nanA)|
+                              _mm256_movemask_ps(nanB) << 8|
+                              _mm256_movemask_ps(nanC) << 16, componentCount);
+        if(mask == all) return mask;
+    }
+
+    return isNanScalar(data + i, count - i, componentCount, mask);
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX2
+/* Same as the SSE4.1 variant, but with eight-wide registers */
+template<class T> CORRADE_ENABLE_AVX2 void minmaxAvx2(const T* data, const std::size_t count, const std::size_t componentCount, T* const min, T* const max) {
+    __m256i min0 = _mm256_set1_epi32(Int(minInitial<T>()));
+    __m256i min1 = min0, min2 = min0;
+    __m256i max0 = _mm256_set1_epi32(Int(maxInitial<T>()));
+    __m256i max1 = max0, max2 = max0;
+
+    std::size_t i = 0;
+    for(; i + 24 <= count; i += 24) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 0));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 16));
+        if(std::is_signed<T>::value) {
+            min0 = _mm256_min_epi32(a, min0);
+            min1 = _mm256_min_epi32(b, min1);
+            min2 = _mm256_min_epi32(c, min2);
+            max0 = _mm256_max_epi32(a, max0);
+            max1 = _mm256_max_epi32(b, max1);
+            max2 = _mm256_max_epi32(c, max2);
+        } else {
+            min0 = _mm256_min_epu32(a, min0);
+            min1 = _mm256_min_epu32(b, min1);
+            min2 = _mm256_min_epu32(c, min2);
+            max0 = _mm256_max_epu32(a, max0);
+            max1 = _mm256_max_epu32(b, max1);
+            max2 = _mm256_max_epu32(c, max2);
+        }
+    }
+
+    T laneMin[24], laneMax[24];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMin + 0), min0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMin + 8), min1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMin + 16), min2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMax + 0), max0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMax + 8), max1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(laneMax + 16), max2);
+    minmaxFoldLanes(laneMin, laneMax, 24, componentCount, min, max);
+    minmaxScalar(data + i, count - i, componentCount, min, max);
+}
+#endif
+
+auto minmaxKernel(const Float*, const Corrade::Cpu::Features features) -> void(*)(const Float*, std::size_t, std::size_t, Float*, Float*) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return minmaxAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return minmaxSse2;
+    #endif
+    static_cast<void>(features);
+    return minmaxScalar<Float>;
+}
+
+template<class T> auto minmaxKernel(const T*, const Corrade::Cpu::Features features) -> void(*)(const T*, std::size_t, std::size_t, T*, T*) {
+    #ifdef CORRADE_ENABLE_AVX2
+    if(features & Corrade::Cpu::Avx2) return minmaxAvx2<T>;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    if(features & Corrade::Cpu::Sse41) return minmaxSse41<T>;
+    #endif
+    static_cast<void>(features);
+    return minmaxScalar<T>;
+}
+
+UnsignedInt isNanScalarKernel(const Float* data, const std::size_t count, const std::size_t componentCount) {
+    return isNanScalar(data, count, componentCount, 0);
+}
+
+auto isNanKernel(const Corrade::Cpu::Features features) -> UnsignedInt(*)(const Float*, std::size_t, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return isNanAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return isNanSse2;
+    #endif
+    static_cast<void>(features);
+    return isNanScalarKernel;
+}
+
+template<class T> void minmaxBatchImplementation(const T* const data, const std::size_t size, const std::size_t componentCount, T* const min, T* const max) {
+    T minOut[4], maxOut[4];
+    for(std::size_t i = 0; i != componentCount; ++i) {
+        minOut[i] = minInitial<T>();
+        maxOut[i] = maxInitial<T>();
+    }
+
+    minmaxKernel(data, Implementation::functionsBatchCpuFeatures())(data, size*componentCount, componentCount, minOut, maxOut);
+
+    /* If a component is still at the initial values, it had only NaNs. Any
+       other value, including an infinity, would make the minimum less or
+       equal to the maximum. */
+    for(std::size_t i = 0; i != componentCount; ++i) {
+        if(std::numeric_limits<T>::has_quiet_NaN && minOut[i] > maxOut[i])
+            minOut[i] = maxOut[i] = std::numeric_limits<T>::quiet_NaN();
+        if(min) min[i] = minOut[i];
+        if(max) max[i] = maxOut[i];
+    }
+}
+
+}
+
+UnsignedInt Implementation::isNanBatch(const Float* const data, const std::size_t size, const std::size_t componentCount) {
+    return isNanKernel(functionsBatchCpuFeatures())(data, size*componentCount, componentCount);
+}
+
+void Implementation::minmaxBatch(const Float* const data, const std::size_t size, const std::size_t componentCount, Float* const min, Float* const max) {
+    minmaxBatchImplementation(data, size, componentCount, min, max);
+}
+
+void Implementation::minmaxBatch(const Int* const data, const std::size_t size, const std::size_t componentCount, Int* const min, Int* const max) {
+    minmaxBatchImplementation(data, size, componentCount, min, max);
+}
+
+void Implementation::minmaxBatch(const UnsignedInt* const data, const std::size_t size, const std::size_t componentCount, UnsignedInt* const min, UnsignedInt* const max) {
+    minmaxBatchImplementation(data, size, componentCount, min, max);
+}
+
+}}
@@ -32,6 +32,7 @@
 #include <initializer_list>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/visibility.h"
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace Math {
@@ -44,6 +45,65 @@ template<class T, class View = decltype(Corrade::Containers::Implementation::Era
 template<class T> static typename std::remove_const<T>::type stridedArrayViewTypeFor(const Corrade::Containers::ArrayView<T>&);
 template<class T> static typename std::remove_const<T>::type stridedArrayViewTypeFor(const Corrade::Containers::StridedArrayView1D<T>&);
 
+/* Contiguous ranges of Float, Int and UnsignedInt scalars and vectors of up
+   to four components are processed with SIMD kernels implemented in
+   FunctionsBatch.cpp, the generic loops below are used for everything else */
+template<class T, bool = IsVector<T>::value> struct BatchKernelTraits {
+    typedef UnderlyingTypeOf<T> Type;
+    enum: std::size_t { ComponentCount = 1 };
+};
+template<class T> struct BatchKernelTraits<T, true> {
+    typedef UnderlyingTypeOf<T> Type;
+    enum: std::size_t { ComponentCount = T::Size };
+};
+template<class T, class Traits = BatchKernelTraits<T>> struct HasMinmaxBatchKernel: std::integral_constant<bool,
+    (std::is_same<typename Traits::Type, Float>::value ||
+     std::is_same<typename Traits::Type, Int>::value ||
+     std::is_same<typename Traits::Type, UnsignedInt>::value) &&
+    Traits::ComponentCount <= 4 &&
+    sizeof(T) == Traits::ComponentCount*sizeof(typename Traits::Type)> {};
+template<class T> struct HasIsNanBatchKernel: std::integral_constant<bool,
+    HasMinmaxBatchKernel<T>::value &&
+    std::is_same<typename BatchKernelTraits<T>::Type, Float>::value> {};
+
+/* Returns a bit mask of components that are NaN in at least one of the
+   items */
+MAGNUM_EXPORT UnsignedInt isNanBatch(const Float* data, std::size_t size, std::size_t componentCount);
+
+/* Calculates per-component minimum and maximum of all items, ignoring NaNs
+   for floats. Either of min and max can be null. */
+MAGNUM_EXPORT void minmaxBatch(const Float* data, std::size_t size, std::size_t componentCount, Float* min, Float* max);
+MAGNUM_EXPORT void minmaxBatch(const Int* data, std::size_t size, std::size_t componentCount, Int* min, Int* max);
+MAGNUM_EXPORT void minmaxBatch(const UnsignedInt* data, std::size_t size, std::size_t componentCount, UnsignedInt* min, UnsignedInt* max);
+
+inline void isNanBatchResult(const UnsignedInt mask, bool& out) {
+    out = mask != 0;
+}
+template<std::size_t size> inline void isNanBatchResult(const UnsignedInt mask, BitVector<size>& out) {
+    out = BitVector<size>{UnsignedByte(mask)};
+}
+
+/* Returns false if the range can't be processed by a kernel, in which case
+   the caller falls back to the generic loop */
+template<class T, class U> inline bool isNanBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, U& out, std::true_type) {
+    if(!range.isContiguous()) return false;
+    isNanBatchResult(isNanBatch(static_cast<const Float*>(range.data()), range.size(), BatchKernelTraits<T>::ComponentCount), out);
+    return true;
+}
+template<class T, class U> constexpr bool isNanBatch(const Corrade::Containers::StridedArrayView1D<const T>&, U&, std::false_type) {
+    return false;
+}
+
+template<class T> inline bool minmaxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T* min, T* max, std::true_type) {
+    if(!range.isContiguous()) return false;
+    typedef typename BatchKernelTraits<T>::Type Type;
+    minmaxBatch(static_cast<const Type*>(range.data()), range.size(), BatchKernelTraits<T>::ComponentCount, reinterpret_cast<Type*>(min), reinterpret_cast<Type*>(max));
+    return true;
+}
+template<class T> constexpr bool minmaxBatch(const Corrade::Containers::StridedArrayView1D<const T>&, T*, T*, std::false_type) {
+    return false;
+}
+
 }
 
 /**
@@ -51,6 +111,18 @@ template<class T> static typename std::remove_const<T>::type stridedArrayViewTyp
 
 These functions process an ubounded range of values, as opposed to single
 vectors or scalars.
+
+If the range is contiguous and contains @relativeref{Magnum,Float},
+@relativeref{Magnum,Int} or @relativeref{Magnum,UnsignedInt} scalars or
+vectors of up to four components, @ref isNan(),
+@ref min(const Corrade::Containers::StridedArrayView1D<const T>&) "min()",
+@ref max(const Corrade::Containers::StridedArrayView1D<const T>&) "max()" and
+@ref minmax(const Corrade::Containers::StridedArrayView1D<const T>&) "minmax()"
+use SSE2, AVX, SSE4.1 or AVX2 implementations, picked at runtime based on
+@ref Corrade::Cpu::runtimeFeatures(). Their output is the same as with the
+scalar implementation, except for the sign of a zero result if the range
+contains both a positive and a negative zero. Other types and non-contiguous
+ranges take the scalar code path.
 */
 
 /**
@@ -117,6 +189,13 @@ returns @cpp false @ce or a @ref BitVector with no bits set.
 template<class T> inline auto isNan(const Corrade::Containers::StridedArrayView1D<const T>& range) -> decltype(isNan(std::declval<T>())) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float ranges are processed with a SIMD kernel */
+    {
+        decltype(isNan(std::declval<T>())) out{};
+        if(Implementation::isNanBatch(range, out, Implementation::HasIsNanBatchKernel<T>{}))
+            return out;
+    }
+
     /* For scalars, this loop exits once any value is infinity. For vectors
        the loop accumulates the bits and exits as soon as all bits are set
        or the input is exhausted */
@@ -202,6 +281,14 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline T min(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float, Int and UnsignedInt ranges are processed with a SIMD
+       kernel */
+    {
+        T out{};
+        if(Implementation::minmaxBatch(range, &out, nullptr, Implementation::HasMinmaxBatchKernel<T>{}))
+            return out;
+    }
+
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     for(++iOut.first; iOut.first != range.size(); ++iOut.first)
         iOut.second = Math::min(iOut.second, range[iOut.first]);
@@ -247,6 +334,14 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline T max(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float, Int and UnsignedInt ranges are processed with a SIMD
+       kernel */
+    {
+        T out{};
+        if(Implementation::minmaxBatch(range, nullptr, &out, Implementation::HasMinmaxBatchKernel<T>{}))
+            return out;
+    }
+
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     for(++iOut.first; iOut.first != range.size(); ++iOut.first)
         iOut.second = Math::max(iOut.second, range[iOut.first]);
@@ -307,6 +402,14 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline std::pair<T, T> minmax(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.isEmpty()) return {};
 
+    /* Contiguous Float, Int and UnsignedInt ranges are processed with a SIMD
+       kernel */
+    {
+        std::pair<T, T> out;
+        if(Implementation::minmaxBatch(range, &out.first, &out.second, Implementation::HasMinmaxBatchKernel<T>{}))
+            return out;
+    }
+
     std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     T min{iOut.second}, max{iOut.second};
     for(++iOut.first; iOut.first != range.size(); ++iOut.first)
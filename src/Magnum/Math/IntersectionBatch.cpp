@@ -0,0 +1,343 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#ifdef CORRADE_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_AVX
+#include <immintrin.h>
+#endif
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Implementation/intersectionBatch.h"
+
+namespace Magnum { namespace Math {
+
+Corrade::Cpu::Features& Implementation::intersectionBatchCpuFeatures() {
+    static Corrade::Cpu::Features features = Corrade::Cpu::runtimeFeatures();
+    return features;
+}
+
+namespace Intersection {
+
+namespace {
+
+/* Kernels testing a range of volumes against a frustum. The SIMD variants
+   gather the components of four or eight volumes into separate registers and
+   test them against all planes at once, delegating the remaining few volumes
+   to the scalar variant. The operations are done in the same order as in the
+   single-volume functions in Intersection.h to give the same results. */
+
+void sphereFrustumScalar(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t offset) {
+    for(std::size_t i = offset; i != centers.size(); ++i)
+        visible.set(i, sphereFrustum(centers[i], radii[i], frustum));
+}
+
+void aabbFrustumScalar(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t offset) {
+    for(std::size_t i = offset; i != centers.size(); ++i)
+        visible.set(i, aabbFrustum(centers[i], extents[i], frustum));
+}
+
+void rangeFrustumScalar(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t offset) {
+    for(std::size_t i = offset; i != ranges.size(); ++i)
+        visible.set(i, rangeFrustum(ranges[i], frustum));
+}
+
+/* Helper to avoid repeating the same cast everywhere */
+inline Float load(const char* data, const std::ptrdiff_t offset) {
+    return *reinterpret_cast<const Float*>(data + offset);
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+/* Loads four floats, each stride bytes apart */
+CORRADE_ENABLE_SSE2 inline __m128 loadSse2(const char* data, const std::ptrdiff_t stride) {
+    return _mm_setr_ps(load(data, 0), load(data, stride), load(data, 2*stride), load(data, 3*stride));
+}
+
+/* dot(a, b) for four vectors at once, with the same operation order as
+   Vector::dot() */
+CORRADE_ENABLE_SSE2 inline __m128 dotSse2(const __m128 ax, const __m128 ay, const __m128 az, const __m128 bx, const __m128 by, const __m128 bz) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+inline void storeSse2(const Corrade::Containers::MutableBitArrayView& visible, const std::size_t i, const Int mask) {
+    for(std::size_t j = 0; j != 4; ++j)
+        visible.set(i + j, mask & (1 << j));
+}
+
+CORRADE_ENABLE_SSE2 void sphereFrustumSse2(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* center = static_cast<const char*>(centers.data());
+    const char* radius = static_cast<const char*>(radii.data());
+    const std::ptrdiff_t centerStride = centers.stride();
+    const std::ptrdiff_t radiusStride = radii.stride();
+
+    std::size_t i = 0;
+    for(; i + 4 <= centers.size(); i += 4, center += 4*centerStride, radius += 4*radiusStride) {
+        const __m128 cx = loadSse2(center, centerStride);
+        const __m128 cy = loadSse2(center + 4, centerStride);
+        const __m128 cz = loadSse2(center + 8, centerStride);
+        const __m128 r = loadSse2(radius, radiusStride);
+        const __m128 minusRadiusSquared = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(r, r));
+
+        /* A lane is culled if the sphere is in front of any plane */
+        __m128 culled = _mm_setzero_ps();
+        for(const Vector4<Float>& plane: frustum) {
+            const __m128 distance = _mm_add_ps(dotSse2(
+                _mm_set1_ps(plane.x()), _mm_set1_ps(plane.y()), _mm_set1_ps(plane.z()),
+                cx, cy, cz), _mm_set1_ps(plane.w()));
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(distance, minusRadiusSquared));
+        }
+
+        storeSse2(visible, i, ~_mm_movemask_ps(culled));
+    }
+
+    sphereFrustumScalar(centers, radii, frustum, visible, i);
+}
+
+/* Shared between the AABB and range variant, the range one passes the
+   center and extents multiplied by two and expects planeScale to be 2 */
+CORRADE_ENABLE_SSE2 inline Int aabbFrustumSse2(const __m128 cx, const __m128 cy, const __m128 cz, const __m128 ex, const __m128 ey, const __m128 ez, const Frustum<Float>& frustum, const Float planeScale) {
+    __m128 culled = _mm_setzero_ps();
+    for(const Vector4<Float>& plane: frustum) {
+        const __m128 d = dotSse2(cx, cy, cz,
+            _mm_set1_ps(plane.x()), _mm_set1_ps(plane.y()), _mm_set1_ps(plane.z()));
+        const __m128 r = dotSse2(ex, ey, ez,
+            _mm_set1_ps(Math::abs(plane.x())), _mm_set1_ps(Math::abs(plane.y())), _mm_set1_ps(Math::abs(plane.z())));
+        culled = _mm_or_ps(culled, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_set1_ps(-planeScale*plane.w())));
+    }
+
+    return ~_mm_movemask_ps(culled);
+}
+
+CORRADE_ENABLE_SSE2 void aabbFrustumSse2(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* center = static_cast<const char*>(centers.data());
+    const char* extent = static_cast<const char*>(extents.data());
+    const std::ptrdiff_t centerStride = centers.stride();
+    const std::ptrdiff_t extentStride = extents.stride();
+
+    std::size_t i = 0;
+    for(; i + 4 <= centers.size(); i += 4, center += 4*centerStride, extent += 4*extentStride) {
+        storeSse2(visible, i, aabbFrustumSse2(
+            loadSse2(center, centerStride),
+            loadSse2(center + 4, centerStride),
+            loadSse2(center + 8, centerStride),
+            loadSse2(extent, extentStride),
+            loadSse2(extent + 4, extentStride),
+            loadSse2(extent + 8, extentStride), frustum, 1.0f));
+    }
+
+    aabbFrustumScalar(centers, extents, frustum, visible, i);
+}
+
+CORRADE_ENABLE_SSE2 void rangeFrustumSse2(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* range = static_cast<const char*>(ranges.data());
+    const std::ptrdiff_t stride = ranges.stride();
+
+    std::size_t i = 0;
+    for(; i + 4 <= ranges.size(); i += 4, range += 4*stride) {
+        const __m128 minX = loadSse2(range, stride);
+        const __m128 minY = loadSse2(range + 4, stride);
+        const __m128 minZ = loadSse2(range + 8, stride);
+        const __m128 maxX = loadSse2(range + 12, stride);
+        const __m128 maxY = loadSse2(range + 16, stride);
+        const __m128 maxZ = loadSse2(range + 20, stride);
+        /* Same as in rangeFrustum(), avoiding division by 2 and comparing to
+           2*-plane.w() instead */
+        storeSse2(visible, i, aabbFrustumSse2(
+            _mm_add_ps(minX, maxX), _mm_add_ps(minY, maxY), _mm_add_ps(minZ, maxZ),
+            _mm_sub_ps(maxX, minX), _mm_sub_ps(maxY, minY), _mm_sub_ps(maxZ, minZ),
+            frustum, 2.0f));
+    }
+
+    rangeFrustumScalar(ranges, frustum, visible, i);
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX
+/* Loads eight floats, each stride bytes apart */
+CORRADE_ENABLE_AVX inline __m256 loadAvx(const char* data, const std::ptrdiff_t stride) {
+    return _mm256_setr_ps(load(data, 0), load(data, stride), load(data, 2*stride), load(data, 3*stride), load(data, 4*stride), load(data, 5*stride), load(data, 6*stride), load(data, 7*stride));
+}
+
+CORRADE_ENABLE_AVX inline __m256 dotAvx(const __m256 ax, const __m256 ay, const __m256 az, const __m256 bx, const __m256 by, const __m256 bz) {
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+}
+
+inline void storeAvx(const Corrade::Containers::MutableBitArrayView& visible, const std::size_t i, const Int mask) {
+    for(std::size_t j = 0; j != 8; ++j)
+        visible.set(i + j, mask & (1 << j));
+}
+
+CORRADE_ENABLE_AVX void sphereFrustumAvx(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* center = static_cast<const char*>(centers.data());
+    const char* radius = static_cast<const char*>(radii.data());
+    const std::ptrdiff_t centerStride = centers.stride();
+    const std::ptrdiff_t radiusStride = radii.stride();
+
+    std::size_t i = 0;
+    for(; i + 8 <= centers.size(); i += 8, center += 8*centerStride, radius += 8*radiusStride) {
+        const __m256 cx = loadAvx(center, centerStride);
+        const __m256 cy = loadAvx(center + 4, centerStride);
+        const __m256 cz = loadAvx(center + 8, centerStride);
+        const __m256 r = loadAvx(radius, radiusStride);
+        const __m256 minusRadiusSquared = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(r, r));
+
+        __m256 culled = _mm256_setzero_ps();
+        for(const Vector4<Float>& plane: frustum) {
+            const __m256 distance = _mm256_add_ps(dotAvx(
+                _mm256_set1_ps(plane.x()), _mm256_set1_ps(plane.y()), _mm256_set1_ps(plane.z()),
+                cx, cy, cz), _mm256_set1_ps(plane.w()));
+            culled = _mm256_or_ps(culled, _mm256_cmp_ps(distance, minusRadiusSquared, _CMP_LT_OQ));
+        }
+
+        storeAvx(visible, i, ~_mm256_movemask_ps(culled));
+    }
+
+    sphereFrustumScalar(centers, radii, frustum, visible, i);
+}
+
+CORRADE_ENABLE_AVX inline Int aabbFrustumAvx(const __m256 cx, const __m256 cy, const __m256 cz, const __m256 ex, const __m256 ey, const __m256 ez, const Frustum<Float>& frustum, const Float planeScale) {
+    __m256 culled = _mm256_setzero_ps();
+    for(const Vector4<Float>& plane: frustum) {
+        const __m256 d = dotAvx(cx, cy, cz,
+            _mm256_set1_ps(plane.x()), _mm256_set1_ps(plane.y()), _mm256_set1_ps(plane.z()));
+        const __m256 r = dotAvx(ex, ey, ez,
+            _mm256_set1_ps(Math::abs(plane.x())), _mm256_set1_ps(Math::abs(plane.y())), _mm256_set1_ps(Math::abs(plane.z())));
+        culled = _mm256_or_ps(culled, _mm256_cmp_ps(_mm256_add_ps(d, r), _mm256_set1_ps(-planeScale*plane.w()), _CMP_LT_OQ));
+    }
+
+    return ~_mm256_movemask_ps(culled);
+}
+
+CORRADE_ENABLE_AVX void aabbFrustumAvx(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* center = static_cast<const char*>(centers.data());
+    const char* extent = static_cast<const char*>(extents.data());
+    const std::ptrdiff_t centerStride = centers.stride();
+    const std::ptrdiff_t extentStride = extents.stride();
+
+    std::size_t i = 0;
+    for(; i + 8 <= centers.size(); i += 8, center += 8*centerStride, extent += 8*extentStride) {
+        storeAvx(visible, i, aabbFrustumAvx(
+            loadAvx(center, centerStride),
+            loadAvx(center + 4, centerStride),
+            loadAvx(center + 8, centerStride),
+            loadAvx(extent, extentStride),
+            loadAvx(extent + 4, extentStride),
+            loadAvx(extent + 8, extentStride), frustum, 1.0f));
+    }
+
+    aabbFrustumScalar(centers, extents, frustum, visible, i);
+}
+
+CORRADE_ENABLE_AVX void rangeFrustumAvx(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView& visible, std::size_t) {
+    const char* range = static_cast<const char*>(ranges.data());
+    const std::ptrdiff_t stride = ranges.stride();
+
+    std::size_t i = 0;
+    for(; i + 8 <= ranges.size(); i += 8, range += 8*stride) {
+        const __m256 minX = loadAvx(range, stride);
+        const __m256 minY = loadAvx(range + 4, stride);
+        const __m256 minZ = loadAvx(range + 8, stride);
+        const __m256 maxX = loadAvx(range + 12, stride);
+        const __m256 maxY = loadAvx(range + 16, stride);
+        const __m256 maxZ = loadAvx(range + 20, stride);
+        storeAvx(visible, i, aabbFrustumAvx(
+            _mm256_add_ps(minX, maxX), _mm256_add_ps(minY, maxY), _mm256_add_ps(minZ, maxZ),
+            _mm256_sub_ps(maxX, minX), _mm256_sub_ps(maxY, minY), _mm256_sub_ps(maxZ, minZ),
+            frustum, 2.0f));
+    }
+
+    rangeFrustumScalar(ranges, frustum, visible, i);
+}
+#endif
+
+auto sphereFrustumKernel(const Corrade::Cpu::Features features) -> void(*)(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Float>&, const Frustum<Float>&, const Corrade::Containers::MutableBitArrayView&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return sphereFrustumAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return sphereFrustumSse2;
+    #endif
+    static_cast<void>(features);
+    return sphereFrustumScalar;
+}
+
+auto aabbFrustumKernel(const Corrade::Cpu::Features features) -> void(*)(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Frustum<Float>&, const Corrade::Containers::MutableBitArrayView&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return aabbFrustumAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return aabbFrustumSse2;
+    #endif
+    static_cast<void>(features);
+    return aabbFrustumScalar;
+}
+
+auto rangeFrustumKernel(const Corrade::Cpu::Features features) -> void(*)(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>&, const Frustum<Float>&, const Corrade::Containers::MutableBitArrayView&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return rangeFrustumAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return rangeFrustumSse2;
+    #endif
+    static_cast<void>(features);
+    return rangeFrustumScalar;
+}
+
+}
+
+void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(radii.size() == centers.size(),
+        "Math::Intersection::sphereFrustumInto(): expected center and radius views to have the same size but got" << centers.size() << "and" << radii.size(), );
+    CORRADE_ASSERT(visible.size() == centers.size(),
+        "Math::Intersection::sphereFrustumInto(): wrong output size, got" << visible.size() << "but expected" << centers.size(), );
+
+    sphereFrustumKernel(Implementation::intersectionBatchCpuFeatures())(centers, radii, frustum, visible, 0);
+}
+
+void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(extents.size() == centers.size(),
+        "Math::Intersection::aabbFrustumInto(): expected center and extent views to have the same size but got" << centers.size() << "and" << extents.size(), );
+    CORRADE_ASSERT(visible.size() == centers.size(),
+        "Math::Intersection::aabbFrustumInto(): wrong output size, got" << visible.size() << "but expected" << centers.size(), );
+
+    aabbFrustumKernel(Implementation::intersectionBatchCpuFeatures())(centers, extents, frustum, visible, 0);
+}
+
+void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::MutableBitArrayView visible) {
+    CORRADE_ASSERT(visible.size() == ranges.size(),
+        "Math::Intersection::rangeFrustumInto(): wrong output size, got" << visible.size() << "but expected" << ranges.size(), );
+
+    rangeFrustumKernel(Implementation::intersectionBatchCpuFeatures())(ranges, frustum, visible, 0);
+}
+
+}}}
@@ -0,0 +1,107 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Intersection::sphereFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::rangeFrustumInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch frustum culling functions
+
+These functions test an unbounded range of volumes against a single frustum,
+as opposed to @ref sphereFrustum(), @ref aabbFrustum() and
+@ref rangeFrustum() that test just a single volume. The result for each item
+is written into a bit array, with a bit set if given volume intersects the
+frustum.
+
+The volumes are loaded four or eight at a time, transposed into a
+structure-of-arrays form and tested against all six frustum planes at once.
+There's an SSE2 and an AVX implementation, picked at runtime based on
+@ref Corrade::Cpu::runtimeFeatures(). The arithmetic is done in the same order
+as in the single-volume functions, so their output is the same as with the
+scalar implementation. The input views can have arbitrary strides, which means
+the volumes can be taken directly from for example an interleaved instance
+buffer.
+*/
+
+/**
+@brief Intersection of a batch of spheres and a frustum
+@param[in]  centers Sphere centers
+@param[in]  radii   Sphere radii
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the intersection results
+@m_since_latest
+
+Equivalent to calling @ref sphereFrustum() for each item in @p centers and
+@p radii and setting corresponding bit in @p visible to the result. Expects
+that @p centers, @p radii and @p visible all have the same size.
+@see @ref MeshTools::boundingSphereBouncingBubble()
+*/
+MAGNUM_EXPORT void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Float>& radii, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView visible);
+
+/**
+@brief Intersection of a batch of axis-aligned boxes and a frustum
+@param[in]  centers Box centers
+@param[in]  extents Box (half-)extents
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the intersection results
+@m_since_latest
+
+Equivalent to calling @ref aabbFrustum() for each item in @p centers and
+@p extents and setting corresponding bit in @p visible to the result. Expects
+that @p centers, @p extents and @p visible all have the same size.
+*/
+MAGNUM_EXPORT void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& centers, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& extents, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView visible);
+
+/**
+@brief Intersection of a batch of ranges and a frustum
+@param[in]  ranges  Ranges
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] visible Where to put the intersection results
+@m_since_latest
+
+Equivalent to calling @ref rangeFrustum() for each item in @p ranges and
+setting corresponding bit in @p visible to the result. Expects that @p ranges
+and @p visible have the same size.
+@see @ref MeshTools::boundingRange()
+*/
+MAGNUM_EXPORT void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, Corrade::Containers::MutableBitArrayView visible);
+
+/*@}*/
+
+}}}
+
+#endif
@@ -0,0 +1,364 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MatrixBatch.h"
+
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#ifdef CORRADE_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_AVX
+#include <immintrin.h>
+#endif
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Implementation/matrixBatch.h"
+
+namespace Magnum { namespace Math {
+
+Corrade::Cpu::Features& Implementation::matrixBatchCpuFeatures() {
+    static Corrade::Cpu::Features features = Corrade::Cpu::runtimeFeatures();
+    return features;
+}
+
+namespace {
+
+/* Transformation kernels. The x86 variants gather components of four or eight
+   vectors into separate registers, transform them and scatter them back,
+   delegating the remaining few vectors to the scalar variant. All
+   operations, including the initial addition to zero that
+   RectangularMatrix::operator*() does, are done in the same order as in the
+   scalar code to give the same results. ARM targets use the scalar variants
+   until NEON kernels can be built and tested there. */
+
+void transformPoints3DScalar(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, const std::size_t offset) {
+    for(std::size_t i = offset; i != src.size(); ++i)
+        dst[i] = matrix.transformPoint(src[i]);
+}
+
+void transformPoints2DScalar(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst, const std::size_t offset) {
+    for(std::size_t i = offset; i != src.size(); ++i)
+        dst[i] = matrix.transformPoint(src[i]);
+}
+
+void transformVectors3DScalar(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, const std::size_t offset) {
+    for(std::size_t i = offset; i != src.size(); ++i)
+        dst[i] = matrix*src[i];
+}
+
+template<class T> void multiplyScalar(const Corrade::Containers::StridedArrayView1D<const T>& a, const Corrade::Containers::StridedArrayView1D<const T>& b, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    for(std::size_t i = 0; i != a.size(); ++i)
+        dst[i] = a[i]*b[i];
+}
+
+/* Helpers to avoid repeating the same casts everywhere */
+inline Float load(const char* data, const std::ptrdiff_t offset) {
+    return *reinterpret_cast<const Float*>(data + offset);
+}
+
+inline void store(char* data, const std::ptrdiff_t offset, const Float value) {
+    *reinterpret_cast<Float*>(data + offset) = value;
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+/* Loads four floats, each stride bytes apart */
+CORRADE_ENABLE_SSE2 inline __m128 loadSse2(const char* data, const std::ptrdiff_t stride) {
+    return _mm_setr_ps(load(data, 0), load(data, stride), load(data, 2*stride), load(data, 3*stride));
+}
+
+/* Stores four floats, each stride bytes apart */
+CORRADE_ENABLE_SSE2 inline void storeSse2(char* data, const std::ptrdiff_t stride, const __m128 value) {
+    alignas(16) Float values[4];
+    _mm_store_ps(values, value);
+    for(std::size_t i = 0; i != 4; ++i)
+        store(data, i*stride, values[i]);
+}
+
+/* ((0 + a*x) + b*y) + c*z, with x, y, z being four different vectors and a,
+   b, c being scalars from a single matrix row */
+CORRADE_ENABLE_SSE2 inline __m128 rowSse2(const Float a, const Float b, const Float c, const __m128 x, const __m128 y, const __m128 z) {
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_setzero_ps(), _mm_mul_ps(_mm_set1_ps(a), x)), _mm_mul_ps(_mm_set1_ps(b), y)), _mm_mul_ps(_mm_set1_ps(c), z));
+}
+
+CORRADE_ENABLE_SSE2 void transformPoints3DSse2(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    std::size_t i = 0;
+    for(; i + 4 <= src.size(); i += 4, srcPtr += 4*srcStride, dstPtr += 4*dstStride) {
+        const __m128 x = loadSse2(srcPtr, srcStride);
+        const __m128 y = loadSse2(srcPtr + 4, srcStride);
+        const __m128 z = loadSse2(srcPtr + 8, srcStride);
+
+        /* The fourth input component is 1, so the last column is added
+           directly */
+        const __m128 w = _mm_add_ps(rowSse2(matrix[0][3], matrix[1][3], matrix[2][3], x, y, z), _mm_set1_ps(matrix[3][3]));
+        storeSse2(dstPtr, dstStride, _mm_div_ps(_mm_add_ps(rowSse2(matrix[0][0], matrix[1][0], matrix[2][0], x, y, z), _mm_set1_ps(matrix[3][0])), w));
+        storeSse2(dstPtr + 4, dstStride, _mm_div_ps(_mm_add_ps(rowSse2(matrix[0][1], matrix[1][1], matrix[2][1], x, y, z), _mm_set1_ps(matrix[3][1])), w));
+        storeSse2(dstPtr + 8, dstStride, _mm_div_ps(_mm_add_ps(rowSse2(matrix[0][2], matrix[1][2], matrix[2][2], x, y, z), _mm_set1_ps(matrix[3][2])), w));
+    }
+
+    transformPoints3DScalar(matrix, src, dst, i);
+}
+
+CORRADE_ENABLE_SSE2 void transformPoints2DSse2(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    /* The third input component is 1, so the last column is multiplied with
+       an all-ones vector to have the same code as in the 3D case */
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    std::size_t i = 0;
+    for(; i + 4 <= src.size(); i += 4, srcPtr += 4*srcStride, dstPtr += 4*dstStride) {
+        const __m128 x = loadSse2(srcPtr, srcStride);
+        const __m128 y = loadSse2(srcPtr + 4, srcStride);
+        storeSse2(dstPtr, dstStride, rowSse2(matrix[0][0], matrix[1][0], matrix[2][0], x, y, one));
+        storeSse2(dstPtr + 4, dstStride, rowSse2(matrix[0][1], matrix[1][1], matrix[2][1], x, y, one));
+    }
+
+    transformPoints2DScalar(matrix, src, dst, i);
+}
+
+CORRADE_ENABLE_SSE2 void transformVectors3DSse2(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    std::size_t i = 0;
+    for(; i + 4 <= src.size(); i += 4, srcPtr += 4*srcStride, dstPtr += 4*dstStride) {
+        const __m128 x = loadSse2(srcPtr, srcStride);
+        const __m128 y = loadSse2(srcPtr + 4, srcStride);
+        const __m128 z = loadSse2(srcPtr + 8, srcStride);
+        storeSse2(dstPtr, dstStride, rowSse2(matrix[0][0], matrix[1][0], matrix[2][0], x, y, z));
+        storeSse2(dstPtr + 4, dstStride, rowSse2(matrix[0][1], matrix[1][1], matrix[2][1], x, y, z));
+        storeSse2(dstPtr + 8, dstStride, rowSse2(matrix[0][2], matrix[1][2], matrix[2][2], x, y, z));
+    }
+
+    transformVectors3DScalar(matrix, src, dst, i);
+}
+
+/* Matrix multiplication processes one matrix at a time, with columns of the
+   left matrix in registers and each output column calculated as a linear
+   combination of them */
+CORRADE_ENABLE_SSE2 void multiply4Sse2(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        const Float* const aData = a[i].data();
+        const Float* const bData = b[i].data();
+        Float* const dstData = dst[i].data();
+        const __m128 a0 = _mm_loadu_ps(aData + 0);
+        const __m128 a1 = _mm_loadu_ps(aData + 4);
+        const __m128 a2 = _mm_loadu_ps(aData + 8);
+        const __m128 a3 = _mm_loadu_ps(aData + 12);
+
+        /* All of b is loaded before storing, so the output can be the same
+           as either of the inputs */
+        __m128 out[4];
+        for(std::size_t col = 0; col != 4; ++col) {
+            const Float* const bCol = bData + col*4;
+            out[col] = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_setzero_ps(),
+                _mm_mul_ps(a0, _mm_set1_ps(bCol[0]))),
+                _mm_mul_ps(a1, _mm_set1_ps(bCol[1]))),
+                _mm_mul_ps(a2, _mm_set1_ps(bCol[2]))),
+                _mm_mul_ps(a3, _mm_set1_ps(bCol[3])));
+        }
+        for(std::size_t col = 0; col != 4; ++col)
+            _mm_storeu_ps(dstData + col*4, out[col]);
+    }
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX
+/* Loads eight floats, each stride bytes apart */
+CORRADE_ENABLE_AVX inline __m256 loadAvx(const char* data, const std::ptrdiff_t stride) {
+    return _mm256_setr_ps(load(data, 0), load(data, stride), load(data, 2*stride), load(data, 3*stride), load(data, 4*stride), load(data, 5*stride), load(data, 6*stride), load(data, 7*stride));
+}
+
+/* Stores eight floats, each stride bytes apart */
+CORRADE_ENABLE_AVX inline void storeAvx(char* data, const std::ptrdiff_t stride, const __m256 value) {
+    alignas(32) Float values[8];
+    _mm256_store_ps(values, value);
+    for(std::size_t i = 0; i != 8; ++i)
+        store(data, i*stride, values[i]);
+}
+
+CORRADE_ENABLE_AVX inline __m256 rowAvx(const Float a, const Float b, const Float c, const __m256 x, const __m256 y, const __m256 z) {
+    return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_setzero_ps(), _mm256_mul_ps(_mm256_set1_ps(a), x)), _mm256_mul_ps(_mm256_set1_ps(b), y)), _mm256_mul_ps(_mm256_set1_ps(c), z));
+}
+
+CORRADE_ENABLE_AVX void transformPoints3DAvx(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    std::size_t i = 0;
+    for(; i + 8 <= src.size(); i += 8, srcPtr += 8*srcStride, dstPtr += 8*dstStride) {
+        const __m256 x = loadAvx(srcPtr, srcStride);
+        const __m256 y = loadAvx(srcPtr + 4, srcStride);
+        const __m256 z = loadAvx(srcPtr + 8, srcStride);
+        const __m256 w = _mm256_add_ps(rowAvx(matrix[0][3], matrix[1][3], matrix[2][3], x, y, z), _mm256_set1_ps(matrix[3][3]));
+        storeAvx(dstPtr, dstStride, _mm256_div_ps(_mm256_add_ps(rowAvx(matrix[0][0], matrix[1][0], matrix[2][0], x, y, z), _mm256_set1_ps(matrix[3][0])), w));
+        storeAvx(dstPtr + 4, dstStride, _mm256_div_ps(_mm256_add_ps(rowAvx(matrix[0][1], matrix[1][1], matrix[2][1], x, y, z), _mm256_set1_ps(matrix[3][1])), w));
+        storeAvx(dstPtr + 8, dstStride, _mm256_div_ps(_mm256_add_ps(rowAvx(matrix[0][2], matrix[1][2], matrix[2][2], x, y, z), _mm256_set1_ps(matrix[3][2])), w));
+    }
+
+    transformPoints3DScalar(matrix, src, dst, i);
+}
+
+CORRADE_ENABLE_AVX void transformPoints2DAvx(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    std::size_t i = 0;
+    for(; i + 8 <= src.size(); i += 8, srcPtr += 8*srcStride, dstPtr += 8*dstStride) {
+        const __m256 x = loadAvx(srcPtr, srcStride);
+        const __m256 y = loadAvx(srcPtr + 4, srcStride);
+        storeAvx(dstPtr, dstStride, rowAvx(matrix[0][0], matrix[1][0], matrix[2][0], x, y, one));
+        storeAvx(dstPtr + 4, dstStride, rowAvx(matrix[0][1], matrix[1][1], matrix[2][1], x, y, one));
+    }
+
+    transformPoints2DScalar(matrix, src, dst, i);
+}
+
+CORRADE_ENABLE_AVX void transformVectors3DAvx(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst, std::size_t) {
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
+    const std::ptrdiff_t srcStride = src.stride();
+    const std::ptrdiff_t dstStride = dst.stride();
+
+    std::size_t i = 0;
+    for(; i + 8 <= src.size(); i += 8, srcPtr += 8*srcStride, dstPtr += 8*dstStride) {
+        const __m256 x = loadAvx(srcPtr, srcStride);
+        const __m256 y = loadAvx(srcPtr + 4, srcStride);
+        const __m256 z = loadAvx(srcPtr + 8, srcStride);
+        storeAvx(dstPtr, dstStride, rowAvx(matrix[0][0], matrix[1][0], matrix[2][0], x, y, z));
+        storeAvx(dstPtr + 4, dstStride, rowAvx(matrix[0][1], matrix[1][1], matrix[2][1], x, y, z));
+        storeAvx(dstPtr + 8, dstStride, rowAvx(matrix[0][2], matrix[1][2], matrix[2][2], x, y, z));
+    }
+
+    transformVectors3DScalar(matrix, src, dst, i);
+}
+#endif
+
+auto transformPoints3DKernel(const Corrade::Cpu::Features features) -> void(*)(const Matrix4<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return transformPoints3DAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return transformPoints3DSse2;
+    #endif
+    static_cast<void>(features);
+    return transformPoints3DScalar;
+}
+
+auto transformPoints2DKernel(const Corrade::Cpu::Features features) -> void(*)(const Matrix3<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return transformPoints2DAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return transformPoints2DSse2;
+    #endif
+    static_cast<void>(features);
+    return transformPoints2DScalar;
+}
+
+auto transformVectors3DKernel(const Corrade::Cpu::Features features) -> void(*)(const Matrix3x3<Float>&, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>&, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>&, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX
+    if(features & Corrade::Cpu::Avx) return transformVectors3DAvx;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return transformVectors3DSse2;
+    #endif
+    static_cast<void>(features);
+    return transformVectors3DScalar;
+}
+
+/* There's no AVX variant for the matrix multiplication, as there's not
+   enough work per matrix to benefit from the wider registers */
+auto multiply4Kernel(const Corrade::Cpu::Features features) -> void(*)(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>&, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>&, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>&) {
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return multiply4Sse2;
+    #endif
+    static_cast<void>(features);
+    return multiplyScalar<Matrix4<Float>>;
+}
+
+}
+
+void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    transformPoints3DKernel(Implementation::matrixBatchCpuFeatures())(matrix, src, dst, 0);
+}
+
+void transformPointsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    transformPoints2DKernel(Implementation::matrixBatchCpuFeatures())(matrix, src, dst, 0);
+}
+
+void transformVectorsInto(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    transformVectors3DKernel(Implementation::matrixBatchCpuFeatures())(matrix, src, dst, 0);
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::multiplyInto(): expected source views to have the same size but got" << a.size() << "and" << b.size(), );
+    CORRADE_ASSERT(a.size() == dst.size(),
+        "Math::multiplyInto(): wrong destination size, got" << dst.size() << "but expected" << a.size(), );
+
+    multiply4Kernel(Implementation::matrixBatchCpuFeatures())(a, b, dst);
+}
+
+void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& dst) {
+    CORRADE_ASSERT(a.size() == b.size(),
+        "Math::multiplyInto(): expected source views to have the same size but got" << a.size() << "and" << b.size(), );
+    CORRADE_ASSERT(a.size() == dst.size(),
+        "Math::multiplyInto(): wrong destination size, got" << dst.size() << "but expected" << a.size(), );
+
+    /* Three-component columns don't map well to four-component registers,
+       the scalar code is good enough here */
+    multiplyScalar(a, b, dst);
+}
+
+}}
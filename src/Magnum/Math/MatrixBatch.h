@@ -0,0 +1,140 @@
+#ifndef Magnum_Math_MatrixBatch_h
+#define Magnum_Math_MatrixBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::transformPointsInto(), @ref Magnum::Math::transformVectorsInto(), @ref Magnum::Math::multiplyInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch matrix functions
+
+These functions process an unbounded range of vectors or matrices, as opposed
+to @ref Matrix3::transformPoint(), @ref Matrix4::transformPoint() or
+@ref RectangularMatrix::operator*() that operate on a single value.
+
+The @ref transformPointsInto() and @ref transformVectorsInto() functions have
+SSE2 and AVX implementations, picked at runtime based on
+@ref Corrade::Cpu::runtimeFeatures(). They load four or eight vectors at a
+time, transpose them into a structure-of-arrays form and transform all of them
+at once. The 4x4 @ref multiplyInto() has an SSE2 implementation operating on
+whole matrix columns. Other platforms use a scalar implementation. The arithmetic is done in the same order as in the
+single-value functions, so the output is the same as with the scalar
+implementation.
+
+The views can have arbitrary strides, which means the data can be transformed
+directly inside an interleaved vertex buffer. The destination is allowed to be
+the same view as the source, but the two shouldn't partially overlap.
+*/
+
+/**
+@brief Transform 3D points with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::transformPoint() on each item in @p src and
+putting the result to corresponding item in @p dst, including the division by
+the resulting W component. Expects that @p src and @p dst have the same size.
+@see @ref MeshTools::transform3D()
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform 2D points with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calling @ref Matrix3::transformPoint() on each item in @p src and
+putting the result to corresponding item in @p dst. Expects that @p src and
+@p dst have the same size.
+@see @ref MeshTools::transform2D(),
+    @ref MeshTools::transformTextureCoordinates2D()
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst);
+
+/**
+@brief Transform 3D vectors with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to multiplying each item in @p src with @p matrix and putting the
+result to corresponding item in @p dst. Usable for example for transforming
+normals with a @ref Matrix4::normalMatrix() or directions with
+@ref Matrix4::rotationScaling(). Expects that @p src and @p dst have the same
+size.
+@see @ref MeshTools::transform3D()
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix3x3<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Multiply two lists of 4x4 matrices
+@param[in]  a       Left matrices
+@param[in]  b       Right matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp a[i]*b[i] @ce for each item and putting the
+result to corresponding item in @p dst, such as when calculating absolute
+transformations from parent and local transformations. Expects that @p a,
+@p b and @p dst all have the same size. The destination is allowed to be the
+same view as either of the sources.
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix4<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix4<Float>>& dst);
+
+/**
+@brief Multiply two lists of 3x3 matrices
+@param[in]  a       Left matrices
+@param[in]  b       Right matrices
+@param[out] dst     Destination matrices
+@m_since_latest
+
+Equivalent to calculating @cpp a[i]*b[i] @ce for each item and putting the
+result to corresponding item in @p dst. Expects that @p a, @p b and @p dst all
+have the same size. The destination is allowed to be the same view as either
+of the sources.
+*/
+MAGNUM_EXPORT void multiplyInto(const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Matrix3<Float>>& b, const Corrade::Containers::StridedArrayView1D<Matrix3<Float>>& dst);
+
+/*@}*/
+
+}}
+
+#endif
@@ -25,98 +25,375 @@
 
 #include "PackingBatch.h"
 
+#include <cstring>
+#include <Corrade/Cpu.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 
+#ifdef CORRADE_ENABLE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef CORRADE_ENABLE_SSE41
+#include <smmintrin.h>
+#endif
+#if defined(CORRADE_ENABLE_AVX2) || defined(CORRADE_ENABLE_AVX_F16C)
+#include <immintrin.h>
+#endif
+
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
+#include "Magnum/Math/Implementation/packingBatch.h"
 
 namespace Magnum { namespace Math {
 
+Corrade::Cpu::Features& Implementation::packingBatchCpuFeatures() {
+    static Corrade::Cpu::Features features = Corrade::Cpu::runtimeFeatures();
+    return features;
+}
+
 namespace {
 
-template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>(),
-        "Math::unpackInto(): second source view dimension is not contiguous", );
-    CORRADE_ASSERT(dst.isContiguous<1>(),
-        "Math::unpackInto(): second destination view dimension is not contiguous", );
+/* Conversion kernels between 8- and 16-bit integers and floats, operating on
+   a contiguous run of values. If normalized is true, they do what unpack() /
+   pack() does, otherwise just a plain cast. The SIMD variants process the
+   bulk of the data and delegate the remaining few values to a narrower
+   variant, ending with the scalar one. Their output is bit-exact with the
+   scalar variant for all inputs that have a defined conversion result. */
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+template<bool normalized, class T> void toFloatScalar(const T* src, Float* dst, std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i) {
+        if(normalized) {
+            const Float value = src[i]/bitMax;
+            /* Avoiding a max() call in Debug. For unsigned types the value
+               is never negative so this is a no-op. */
+            dst[i] = value < -1.0f ? -1.0f : value;
+        } else dst[i] = Float(src[i]);
+    }
+}
 
-    /* Caching values to avoid inline function calls in ebug builds */
+template<bool normalized, class T> void fromFloatScalar(const Float* src, T* dst, std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
     constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
+    for(std::size_t i = 0; i != count; ++i) {
+        /** @todo provide a version that doesn't do rounding */
+        if(normalized) dst[i] = T(std::round(src[i]*bitMax));
+        else dst[i] = T(src[i]);
+    }
+}
 
-        srcPtr += srcStride;
-        dstPtr += dstStride;
+#ifdef CORRADE_ENABLE_SSE2
+/* Loads four values, zero- or sign-extended to 32 bits */
+CORRADE_ENABLE_SSE2 inline __m128i loadSse2(const UnsignedByte* src) {
+    Int bits;
+    std::memcpy(&bits, src, 4);
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bits), zero), zero);
+}
+CORRADE_ENABLE_SSE2 inline __m128i loadSse2(const Byte* src) {
+    Int bits;
+    std::memcpy(&bits, src, 4);
+    /* Replicate each byte into all four bytes of a 32-bit lane and then
+       arithmetic-shift it back down to sign-extend */
+    __m128i a = _mm_cvtsi32_si128(bits);
+    a = _mm_unpacklo_epi8(a, a);
+    return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 24);
+}
+CORRADE_ENABLE_SSE2 inline __m128i loadSse2(const UnsignedShort* src) {
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+}
+CORRADE_ENABLE_SSE2 inline __m128i loadSse2(const Short* src) {
+    const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+
+/* Stores four 32-bit values, saturated to the destination type range */
+CORRADE_ENABLE_SSE2 inline void storeSse2(UnsignedByte* dst, const __m128i a) {
+    const __m128i packed = _mm_packs_epi32(a, a);
+    const Int bits = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+    std::memcpy(dst, &bits, 4);
+}
+CORRADE_ENABLE_SSE2 inline void storeSse2(Byte* dst, const __m128i a) {
+    const __m128i packed = _mm_packs_epi32(a, a);
+    const Int bits = _mm_cvtsi128_si32(_mm_packs_epi16(packed, packed));
+    std::memcpy(dst, &bits, 4);
+}
+CORRADE_ENABLE_SSE2 inline void storeSse2(UnsignedShort* dst, const __m128i a) {
+    /* There's no unsigned 32-to-16-bit pack before SSE4.1, so shift the
+       range to signed, pack with signed saturation and shift it back */
+    const __m128i shifted = _mm_sub_epi32(a, _mm_set1_epi32(0x8000));
+    const __m128i packed = _mm_packs_epi32(shifted, shifted);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_xor_si128(packed, _mm_set1_epi16(-0x8000)));
+}
+CORRADE_ENABLE_SSE2 inline void storeSse2(Short* dst, const __m128i a) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(a, a));
+}
+
+/* Equivalent of std::round() followed by a conversion to an integer, i.e.
+   rounding half away from zero, unlike _mm_cvtps_epi32() which rounds half
+   to even. Valid for values that fit into a 32-bit integer. */
+CORRADE_ENABLE_SSE2 inline __m128i roundSse2(const __m128 a) {
+    const __m128i truncated = _mm_cvttps_epi32(a);
+    /* The difference is exact, being just the fractional part of the value */
+    const __m128 fraction = _mm_sub_ps(a, _mm_cvtepi32_ps(truncated));
+    const __m128 roundAway = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), fraction), _mm_set1_ps(0.5f));
+    /* -1 for negative values, 1 for positive */
+    const __m128i sign = _mm_or_si128(_mm_srai_epi32(_mm_castps_si128(a), 31), _mm_set1_epi32(1));
+    return _mm_add_epi32(truncated, _mm_and_si128(_mm_castps_si128(roundAway), sign));
+}
+
+template<bool normalized, class T> CORRADE_ENABLE_SSE2 void toFloatSse2(const T* src, Float* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 value = _mm_cvtepi32_ps(loadSse2(src + i));
+        if(normalized) {
+            value = _mm_div_ps(value, bitMax);
+            if(std::is_signed<T>::value) value = _mm_max_ps(value, minusOne);
+        }
+        _mm_storeu_ps(dst + i, value);
     }
+    toFloatScalar<normalized>(src + i, dst + i, count - i);
 }
 
+template<bool normalized, class T> CORRADE_ENABLE_SSE2 void fromFloatSse2(const Float* src, T* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128 value = _mm_loadu_ps(src + i);
+        storeSse2(dst + i, normalized ?
+            roundSse2(_mm_mul_ps(value, bitMax)) : _mm_cvttps_epi32(value));
+    }
+    fromFloatScalar<normalized>(src + i, dst + i, count - i);
 }
+#endif
 
-void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+#ifdef CORRADE_ENABLE_SSE41
+/* Same as loadSse2() / storeSse2() but with dedicated extension and
+   pack instructions */
+CORRADE_ENABLE_SSE41 inline __m128i loadSse41(const UnsignedByte* src) {
+    Int bits;
+    std::memcpy(&bits, src, 4);
+    return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bits));
+}
+CORRADE_ENABLE_SSE41 inline __m128i loadSse41(const Byte* src) {
+    Int bits;
+    std::memcpy(&bits, src, 4);
+    return _mm_cvtepi8_epi32(_mm_cvtsi32_si128(bits));
+}
+CORRADE_ENABLE_SSE41 inline __m128i loadSse41(const UnsignedShort* src) {
+    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+CORRADE_ENABLE_SSE41 inline __m128i loadSse41(const Short* src) {
+    return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
 }
 
-void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+CORRADE_ENABLE_SSE41 inline void storeSse41(UnsignedByte* dst, const __m128i a) {
+    const __m128i packed = _mm_packs_epi32(a, a);
+    const Int bits = _mm_cvtsi128_si32(_mm_packus_epi16(packed, packed));
+    std::memcpy(dst, &bits, 4);
+}
+CORRADE_ENABLE_SSE41 inline void storeSse41(Byte* dst, const __m128i a) {
+    const __m128i packed = _mm_packs_epi32(a, a);
+    const Int bits = _mm_cvtsi128_si32(_mm_packs_epi16(packed, packed));
+    std::memcpy(dst, &bits, 4);
+}
+CORRADE_ENABLE_SSE41 inline void storeSse41(UnsignedShort* dst, const __m128i a) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi32(a, a));
+}
+CORRADE_ENABLE_SSE41 inline void storeSse41(Short* dst, const __m128i a) {
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(a, a));
 }
 
-namespace {
+/* Same as roundSse2() but with a dedicated truncation instruction */
+CORRADE_ENABLE_SSE41 inline __m128i roundSse41(const __m128 a) {
+    const __m128 truncated = _mm_round_ps(a, _MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+    const __m128 roundAway = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(a, truncated)), _mm_set1_ps(0.5f));
+    /* -1.0f for negative values, 1.0f for positive */
+    const __m128 sign = _mm_or_ps(_mm_and_ps(a, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f));
+    return _mm_cvttps_epi32(_mm_add_ps(truncated, _mm_and_ps(roundAway, sign)));
+}
 
-template<class T> inline void unpackSignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>(),
-        "Math::unpackInto(): second source view dimension is not contiguous", );
-    CORRADE_ASSERT(dst.isContiguous<1>(),
-        "Math::unpackInto(): second destination view dimension is not contiguous", );
+template<bool normalized, class T> CORRADE_ENABLE_SSE41 void toFloatSse41(const T* src, Float* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 value = _mm_cvtepi32_ps(loadSse41(src + i));
+        if(normalized) {
+            value = _mm_div_ps(value, bitMax);
+            if(std::is_signed<T>::value) value = _mm_max_ps(value, minusOne);
+        }
+        _mm_storeu_ps(dst + i, value);
+    }
+    toFloatScalar<normalized>(src + i, dst + i, count - i);
+}
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+template<bool normalized, class T> CORRADE_ENABLE_SSE41 void fromFloatSse41(const Float* src, T* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128 value = _mm_loadu_ps(src + i);
+        storeSse41(dst + i, normalized ?
+            roundSse41(_mm_mul_ps(value, bitMax)) : _mm_cvttps_epi32(value));
+    }
+    fromFloatScalar<normalized>(src + i, dst + i, count - i);
+}
+#endif
 
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
+#if defined(CORRADE_ENABLE_AVX2) && defined(CORRADE_ENABLE_SSE41)
+/* Loads eight values, zero- or sign-extended to 32 bits */
+CORRADE_ENABLE_AVX2 inline __m256i loadAvx2(const UnsignedByte* src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+CORRADE_ENABLE_AVX2 inline __m256i loadAvx2(const Byte* src) {
+    return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+CORRADE_ENABLE_AVX2 inline __m256i loadAvx2(const UnsignedShort* src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+CORRADE_ENABLE_AVX2 inline __m256i loadAvx2(const Short* src) {
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+/* Stores eight 32-bit values, saturated to the destination type range. The
+   256-bit pack instructions operate on each 128-bit lane separately, so the
+   two halves are packed using 128-bit instructions instead to avoid an
+   additional permute. */
+CORRADE_ENABLE_AVX2 inline void storeAvx2(UnsignedByte* dst, const __m256i a) {
+    const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(packed, packed));
+}
+CORRADE_ENABLE_AVX2 inline void storeAvx2(Byte* dst, const __m256i a) {
+    const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packs_epi16(packed, packed));
+}
+CORRADE_ENABLE_AVX2 inline void storeAvx2(UnsignedShort* dst, const __m256i a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+}
+CORRADE_ENABLE_AVX2 inline void storeAvx2(Short* dst, const __m256i a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+}
+
+/* Same as roundSse41() */
+CORRADE_ENABLE_AVX2 inline __m256i roundAvx2(const __m256 a) {
+    const __m256 truncated = _mm256_round_ps(a, _MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+    const __m256 roundAway = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), _mm256_sub_ps(a, truncated)), _mm256_set1_ps(0.5f), _CMP_GE_OQ);
+    const __m256 sign = _mm256_or_ps(_mm256_and_ps(a, _mm256_set1_ps(-0.0f)), _mm256_set1_ps(1.0f));
+    return _mm256_cvttps_epi32(_mm256_add_ps(truncated, _mm256_and_ps(roundAway, sign)));
+}
+
+template<bool normalized, class T> CORRADE_ENABLE_AVX2 void toFloatAvx2(const T* src, Float* dst, const std::size_t count) {
+    const __m256 bitMax = _mm256_set1_ps(Implementation::bitMax<T>());
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256 value = _mm256_cvtepi32_ps(loadAvx2(src + i));
+        if(normalized) {
+            value = _mm256_div_ps(value, bitMax);
+            if(std::is_signed<T>::value) value = _mm256_max_ps(value, minusOne);
+        }
+        _mm256_storeu_ps(dst + i, value);
+    }
+    toFloatSse41<normalized>(src + i, dst + i, count - i);
+}
+
+template<bool normalized, class T> CORRADE_ENABLE_AVX2 void fromFloatAvx2(const Float* src, T* dst, const std::size_t count) {
+    const __m256 bitMax = _mm256_set1_ps(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256 value = _mm256_loadu_ps(src + i);
+        storeAvx2(dst + i, normalized ?
+            roundAvx2(_mm256_mul_ps(value, bitMax)) : _mm256_cvttps_epi32(value));
+    }
+    fromFloatSse41<normalized>(src + i, dst + i, count - i);
+}
+#endif
+
+template<bool normalized, class T> auto toFloatKernel(const Corrade::Cpu::Features features) -> void(*)(const T*, Float*, std::size_t) {
+    #if defined(CORRADE_ENABLE_AVX2) && defined(CORRADE_ENABLE_SSE41)
+    if(features & Corrade::Cpu::Avx2) return toFloatAvx2<normalized, T>;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    if(features & Corrade::Cpu::Sse41) return toFloatSse41<normalized, T>;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return toFloatSse2<normalized, T>;
+    #endif
+    static_cast<void>(features);
+    return toFloatScalar<normalized, T>;
+}
+
+template<bool normalized, class T> auto fromFloatKernel(const Corrade::Cpu::Features features) -> void(*)(const Float*, T*, std::size_t) {
+    #if defined(CORRADE_ENABLE_AVX2) && defined(CORRADE_ENABLE_SSE41)
+    if(features & Corrade::Cpu::Avx2) return fromFloatAvx2<normalized, T>;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    if(features & Corrade::Cpu::Sse41) return fromFloatSse41<normalized, T>;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return fromFloatSse2<normalized, T>;
+    #endif
+    static_cast<void>(features);
+    return fromFloatScalar<normalized, T>;
+}
+
+template<class T, class U> void kernelInto(void(*const kernel)(const T*, U*, std::size_t), const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
+    const std::size_t maxJ = src.size()[1];
+
+    /* If both views are contiguous, process everything as a single run so
+       the SIMD kernels don't depend on the component count. That's the case
+       for example when converting a whole non-interleaved attribute or an
+       image. */
+    if(src.isContiguous() && dst.isContiguous()) {
+        kernel(static_cast<const T*>(src.data()), static_cast<U*>(dst.data()), src.size()[0]*maxJ);
+        return;
+    }
+
+    /* Otherwise go row by row. Rows with enough components still make use of
+       the SIMD kernels, shorter are handled by the scalar remainder. */
+    const char* srcPtr = static_cast<const char*>(src.data());
+    char* dstPtr = static_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
     for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
+        kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ);
 
         srcPtr += srcStride;
         dstPtr += dstStride;
     }
 }
 
+template<class T> inline void unpackIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>(),
+        "Math::unpackInto(): second source view dimension is not contiguous", );
+    CORRADE_ASSERT(dst.isContiguous<1>(),
+        "Math::unpackInto(): second destination view dimension is not contiguous", );
+
+    kernelInto(toFloatKernel<true, T>(Implementation::packingBatchCpuFeatures()), src, dst);
+}
+
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    unpackIntoImplementation(src, dst);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackIntoImplementation(src, dst);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackIntoImplementation(src, dst);
 }
 
 namespace {
@@ -129,26 +406,7 @@ template<class T> inline void packIntoImplementation(const Corrade::Containers::
     CORRADE_ASSERT(dst.template isContiguous<1>(),
         "Math::packInto(): second destination view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    kernelInto(fromFloatKernel<true, T>(Implementation::packingBatchCpuFeatures()), src, dst);
 }
 
 }
@@ -199,22 +457,44 @@ template<class T, class U> inline void castIntoImplementation(const Corrade::Con
     }
 }
 
+template<class T> inline void castIntoFloatImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::castInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>(),
+        "Math::castInto(): second source view dimension is not contiguous", );
+    CORRADE_ASSERT(dst.isContiguous<1>(),
+        "Math::castInto(): second destination view dimension is not contiguous", );
+
+    kernelInto(toFloatKernel<false, T>(Implementation::packingBatchCpuFeatures()), src, dst);
+}
+
+template<class T> inline void castFromFloatIntoImplementation(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<T>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::castInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.isContiguous<1>(),
+        "Math::castInto(): second source view dimension is not contiguous", );
+    CORRADE_ASSERT(dst.template isContiguous<1>(),
+        "Math::castInto(): second destination view dimension is not contiguous", );
+
+    kernelInto(fromFloatKernel<false, T>(Implementation::packingBatchCpuFeatures()), src, dst);
+}
+
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoFloatImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoFloatImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoFloatImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoFloatImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
@@ -250,19 +530,19 @@ void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, con
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    castIntoImplementation(src, dst);
+    castFromFloatIntoImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    castIntoImplementation(src, dst);
+    castFromFloatIntoImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    castIntoImplementation(src, dst);
+    castFromFloatIntoImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    castIntoImplementation(src, dst);
+    castFromFloatIntoImplementation(src, dst);
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
@@ -466,6 +746,182 @@ static_assert(sizeof(HalfMantissaTable) + sizeof(HalfOffsetTable) + sizeof(HalfE
 static_assert(sizeof(HalfBaseTable) + sizeof(HalfShiftTable) == 1536,
     "improper size of float->half conversion tables");
 
+namespace {
+
+/* Half-float conversion kernels, operating on a contiguous run of values.
+   The table-based scalar variant is the reference, the SIMD variants
+   produce bit-exact output with it for all inputs, including the
+   round-toward-zero behavior, overflow to infinity and NaN payloads. All
+   SIMD variants process eight values per iteration. */
+
+void unpackHalfScalar(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    UnsignedInt* dstBits = reinterpret_cast<UnsignedInt*>(dst);
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedShort h = src[i];
+        dstBits[i] = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
+    }
+}
+
+void packHalfScalar(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const UnsignedInt* srcBits = reinterpret_cast<const UnsignedInt*>(src);
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedInt f = srcBits[i];
+        dst[i] = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
+    }
+}
+
+#ifdef CORRADE_ENABLE_SSE2
+/* Same algorithm as unpackHalf(), which gives the same result as the tables
+   including NaN payloads, just on four zero-extended values at once */
+CORRADE_ENABLE_SSE2 inline __m128 unpackHalfSse2(const __m128i h) {
+    const __m128i shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+    __m128i o = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+    const __m128i exp = _mm_and_si128(o, shiftedExp);
+    o = _mm_add_epi32(o, _mm_set1_epi32((127 - 15) << 23));
+
+    /* Extra exponent adjust for Inf / NaN */
+    const __m128i infNan = _mm_cmpeq_epi32(exp, shiftedExp);
+    o = _mm_add_epi32(o, _mm_and_si128(infNan, _mm_set1_epi32((128 - 16) << 23)));
+
+    /* Extra exponent adjust and renormalization for zero / denormals */
+    const __m128i zeroDenormal = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const __m128i renormalized = _mm_castps_si128(_mm_sub_ps(
+        _mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))),
+        _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+    o = _mm_or_si128(_mm_and_si128(zeroDenormal, renormalized),
+                     _mm_andnot_si128(zeroDenormal, o));
+
+    /* Sign bit */
+    return _mm_castsi128_ps(_mm_or_si128(o, _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16)));
+}
+
+/* Emulates the tables on four values at once, the result is zero-extended to
+   32 bits. Signed comparisons are fine as the absolute value is always below
+   0x80000000. */
+CORRADE_ENABLE_SSE2 inline __m128i packHalfSse2(const __m128 value) {
+    const __m128i f = _mm_castps_si128(value);
+    const __m128i abs = _mm_and_si128(f, _mm_set1_epi32(0x7fffffff));
+    const __m128i sign = _mm_and_si128(_mm_srli_epi32(f, 16), _mm_set1_epi32(0x8000));
+
+    /* Normalized numbers, with the exponent rebiased and the mantissa
+       truncated */
+    const __m128i normal = _mm_sub_epi32(_mm_srli_epi32(abs, 13), _mm_set1_epi32((127 - 15) << 10));
+
+    /* Denormals and values too small to be represented. Multiplying by 2^24
+       is exact and the truncation is what the tables do as well. */
+    const __m128i denormal = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(abs), _mm_set1_ps(16777216.0f)));
+
+    /* Overflow is an infinity, NaN keeps the truncated payload */
+    const __m128i infNan = _mm_or_si128(_mm_set1_epi32(0x7c00),
+        _mm_andnot_si128(_mm_cmplt_epi32(abs, _mm_set1_epi32(0x7f800000)),
+            _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(0x3ff))));
+
+    const __m128i isDenormal = _mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000));
+    const __m128i isOverflow = _mm_cmpgt_epi32(abs, _mm_set1_epi32(0x477fffff));
+    const __m128i out =
+        _mm_or_si128(_mm_and_si128(isDenormal, denormal),
+        _mm_or_si128(_mm_and_si128(isOverflow, infNan),
+            _mm_andnot_si128(_mm_or_si128(isDenormal, isOverflow), normal)));
+    return _mm_or_si128(out, sign);
+}
+
+CORRADE_ENABLE_SSE2 void unpackHalfSse2(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_ps(dst + i, unpackHalfSse2(_mm_unpacklo_epi16(h, zero)));
+        _mm_storeu_ps(dst + i + 4, unpackHalfSse2(_mm_unpackhi_epi16(h, zero)));
+    }
+    unpackHalfScalar(src + i, dst + i, count - i);
+}
+
+CORRADE_ENABLE_SSE2 void packHalfSse2(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    /* There's no unsigned 32-to-16-bit pack before SSE4.1, so shift the
+       range to signed, pack and shift it back */
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16(-0x8000);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i a = _mm_sub_epi32(packHalfSse2(_mm_loadu_ps(src + i)), bias32);
+        const __m128i b = _mm_sub_epi32(packHalfSse2(_mm_loadu_ps(src + i + 4)), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+    }
+    packHalfScalar(src + i, dst + i, count - i);
+}
+#endif
+
+#ifdef CORRADE_ENABLE_AVX_F16C
+CORRADE_ENABLE_AVX_F16C void unpackHalfF16c(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    const __m128i absMask = _mm_set1_epi16(0x7fff);
+    const __m128i infinity = _mm_set1_epi16(0x7c00);
+    const __m128i quietNan = _mm_set1_epi16(0x7e00);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+        /* The instruction turns signaling NaNs into quiet ones, while the
+           tables preserve them. Those are rare, so in that case convert the
+           whole batch with the tables instead of patching the result. */
+        const __m128i abs = _mm_and_si128(h, absMask);
+        if(_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi16(abs, infinity), _mm_cmplt_epi16(abs, quietNan)))) {
+            unpackHalfScalar(src + i, dst + i, 8);
+            continue;
+        }
+
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(h));
+    }
+    unpackHalfScalar(src + i, dst + i, count - i);
+}
+
+CORRADE_ENABLE_AVX_F16C void packHalfF16c(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 overflow = _mm256_set1_ps(65536.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256 value = _mm256_loadu_ps(src + i);
+
+        /* Rounding toward zero matches the tables, except for values that
+           are too large to be represented or are NaN, where the instruction
+           produces the largest finite value / a quiet NaN and the tables an
+           infinity / a truncated payload. Those are rare, so in that case
+           convert the whole batch with the tables instead of patching the
+           result. */
+        if(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(signMask, value), overflow, _CMP_NLT_UQ))) {
+            packHalfScalar(src + i, dst + i, 8);
+            continue;
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(value, _MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC));
+    }
+    packHalfScalar(src + i, dst + i, count - i);
+}
+#endif
+
+auto unpackHalfKernel(const Corrade::Cpu::Features features) -> void(*)(const UnsignedShort*, Float*, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX_F16C
+    if(features & Corrade::Cpu::AvxF16c) return unpackHalfF16c;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return unpackHalfSse2;
+    #endif
+    static_cast<void>(features);
+    return unpackHalfScalar;
+}
+
+auto packHalfKernel(const Corrade::Cpu::Features features) -> void(*)(const Float*, UnsignedShort*, std::size_t) {
+    #ifdef CORRADE_ENABLE_AVX_F16C
+    if(features & Corrade::Cpu::AvxF16c) return packHalfF16c;
+    #endif
+    #ifdef CORRADE_ENABLE_SSE2
+    if(features & Corrade::Cpu::Sse2) return packHalfSse2;
+    #endif
+    static_cast<void>(features);
+    return packHalfScalar;
+}
+
+}
+
 void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::unpackHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
@@ -474,23 +930,7 @@ void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const Unsigned
     CORRADE_ASSERT(dst.isContiguous<1>(),
         "Math::unpackHalfInto(): second destination view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedShort* srcPtrI = reinterpret_cast<const UnsignedShort*>(srcPtr);
-        UnsignedInt* dstPtrI = reinterpret_cast<UnsignedInt*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedShort h = *srcPtrI++;
-            *dstPtrI++ = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    kernelInto(unpackHalfKernel(Implementation::packingBatchCpuFeatures()), src, dst);
 }
 
 void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
@@ -501,23 +941,7 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     CORRADE_ASSERT(dst.isContiguous<1>(),
         "Math::packHalfInto(): second destination view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedInt* srcPtrI = reinterpret_cast<const UnsignedInt*>(srcPtr);
-        UnsignedShort* dstPtrI = reinterpret_cast<UnsignedShort*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedInt f = *srcPtrI++;
-            *dstPtrI++ = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    kernelInto(packHalfKernel(Implementation::packingBatchCpuFeatures()), src, dst);
 }
 
 }}
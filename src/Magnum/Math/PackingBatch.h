@@ -42,6 +42,20 @@ namespace Magnum { namespace Math {
 
 These functions process an ubounded range of values, as opposed to single
 vectors or scalars.
+
+The @ref packInto(), @ref unpackInto() and @ref castInto() overloads
+converting between 8- and 16-bit integer types and @relativeref{Magnum,Float}
+have SSE2, SSE4.1 and AVX2 implementations, picked at runtime based on
+@ref Corrade::Cpu::runtimeFeatures(). Their output is the same as with the
+scalar implementation. They're the most efficient if both views are
+contiguous, otherwise the data are processed row by row, and rows with less
+than four components take the scalar code path.
+
+Similarly, @ref packHalfInto() and @ref unpackHalfInto() have an AVX F16C and
+an SSE2 implementation, processing eight values at once and producing the
+same output as the table-based scalar implementation. The same contiguity
+considerations apply, with rows of less than eight components taking the
+scalar code path.
 */
 
 /**
@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Implementation/functionsBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct FunctionsBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit FunctionsBatchBenchmark();
+
+    template<class T> void isNan();
+    template<class T> void minmaxFloat();
+    template<class T> void minmaxInteger();
+
+    void resetCpuFeatures();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector3<UnsignedInt> Vector3ui;
+
+/* The interleaved variant has the values padded, which makes it take the
+   original generic code path the SIMD variants are compared against */
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+    bool interleaved;
+} FloatData[]{
+    {"generic, interleaved", Corrade::Cpu::Scalar, true},
+    {"scalar", Corrade::Cpu::Scalar, false},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2, false},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx, false},
+    #endif
+};
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+    bool interleaved;
+} IntegerData[]{
+    {"generic, interleaved", Corrade::Cpu::Scalar, true},
+    {"scalar", Corrade::Cpu::Scalar, false},
+    #ifdef CORRADE_ENABLE_SSE41
+    {"SSE4.1", Corrade::Cpu::Sse41, false},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX2
+    {"AVX2", Corrade::Cpu::Avx2, false},
+    #endif
+};
+
+/* Four million values, i.e. a 16 MB input, spread across the items */
+constexpr std::size_t ValueCount = 4000000;
+
+FunctionsBatchBenchmark::FunctionsBatchBenchmark() {
+    addInstancedBenchmarks<FunctionsBatchBenchmark>({
+        &FunctionsBatchBenchmark::isNan<Float>,
+        &FunctionsBatchBenchmark::isNan<Vector3>,
+        &FunctionsBatchBenchmark::minmaxFloat<Float>,
+        &FunctionsBatchBenchmark::minmaxFloat<Vector3>}, 10,
+        Corrade::Containers::arraySize(FloatData),
+        &FunctionsBatchBenchmark::resetCpuFeatures,
+        &FunctionsBatchBenchmark::resetCpuFeatures);
+
+    addInstancedBenchmarks<FunctionsBatchBenchmark>({
+        &FunctionsBatchBenchmark::minmaxInteger<UnsignedInt>,
+        &FunctionsBatchBenchmark::minmaxInteger<Vector3ui>}, 10,
+        Corrade::Containers::arraySize(IntegerData),
+        &FunctionsBatchBenchmark::resetCpuFeatures,
+        &FunctionsBatchBenchmark::resetCpuFeatures);
+}
+
+void FunctionsBatchBenchmark::resetCpuFeatures() {
+    Implementation::functionsBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+template<class> struct TypeName;
+template<> struct TypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct TypeName<Vector3> { static const char* name() { return "Vector3"; } };
+template<> struct TypeName<UnsignedInt> { static const char* name() { return "UnsignedInt"; } };
+template<> struct TypeName<Vector3ui> { static const char* name() { return "Vector3ui"; } };
+
+template<class T> struct Padded {
+    T value;
+    T padding;
+};
+
+/* Returns either a contiguous view or a padded one, with the values filled
+   using the passed function */
+template<class T, class F> Corrade::Containers::StridedArrayView1D<const T> values(Corrade::Containers::Array<Padded<T>>& storage, const bool interleaved, F value) {
+    typedef UnderlyingTypeOf<T> Type;
+    constexpr std::size_t ComponentCount = sizeof(T)/sizeof(Type);
+    const std::size_t size = ValueCount/ComponentCount;
+    storage = Corrade::Containers::Array<Padded<T>>{Corrade::ValueInit, size};
+
+    Corrade::Containers::StridedArrayView1D<T> out;
+    if(interleaved)
+        out = Corrade::Containers::stridedArrayView(storage).slice(&Padded<T>::value);
+    else
+        out = Corrade::Containers::arrayCast<T>(Corrade::Containers::arrayView(storage)).prefix(size);
+
+    for(std::size_t i = 0; i != size; ++i)
+        for(std::size_t j = 0; j != ComponentCount; ++j)
+            reinterpret_cast<Type*>(&out[i])[j] = value(i*ComponentCount + j);
+
+    return out;
+}
+
+template<class T> void FunctionsBatchBenchmark::isNan() {
+    auto&& data = FloatData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    /* No NaNs, so the whole range has to be checked */
+    Corrade::Containers::Array<Padded<T>> storage;
+    const Corrade::Containers::StridedArrayView1D<const T> in = values<T>(storage, data.interleaved, [](std::size_t i) {
+        return Float(i%1013) - 500.0f;
+    });
+
+    decltype(Math::isNan(std::declval<T>())) out{};
+    CORRADE_BENCHMARK(1) {
+        out = Math::isNan(in);
+    }
+
+    CORRADE_VERIFY(out == decltype(out){});
+}
+
+template<class T> void FunctionsBatchBenchmark::minmaxFloat() {
+    auto&& data = FloatData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Padded<T>> storage;
+    const Corrade::Containers::StridedArrayView1D<const T> in = values<T>(storage, data.interleaved, [](std::size_t i) {
+        return Float(i%1013) - 500.0f;
+    });
+
+    std::pair<T, T> out;
+    CORRADE_BENCHMARK(1) {
+        out = Math::minmax(in);
+    }
+
+    CORRADE_COMPARE(out.first, T(-500.0f));
+    CORRADE_COMPARE(out.second, T(512.0f));
+}
+
+template<class T> void FunctionsBatchBenchmark::minmaxInteger() {
+    auto&& data = IntegerData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Padded<T>> storage;
+    const Corrade::Containers::StridedArrayView1D<const T> in = values<T>(storage, data.interleaved, [](std::size_t i) {
+        return UnsignedInt(i%1013 + 7);
+    });
+
+    std::pair<T, T> out;
+    CORRADE_BENCHMARK(1) {
+        out = Math::minmax(in);
+    }
+
+    CORRADE_COMPARE(out.first, T(7));
+    CORRADE_COMPARE(out.second, T(1019));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchBenchmark)
@@ -24,12 +24,14 @@
 */
 
 #include <vector>
+#include <Corrade/Cpu.h>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Implementation/functionsBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -47,6 +49,12 @@ struct FunctionsBatchTest: Corrade::TestSuite::Tester {
     void nanIgnoringVector();
 
     void constIterable();
+
+    template<class T> void isNanKernel();
+    template<class T> void minmaxKernelFloat();
+    template<class T> void minmaxKernelInteger();
+
+    void resetCpuFeatures();
 };
 
 using namespace Literals;
@@ -55,6 +63,35 @@ typedef Math::Constants<Float> Constants;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Int> Vector3i;
 typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Vector2<Int> Vector2i;
+typedef Math::Vector4<UnsignedInt> Vector4ui;
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} FloatCpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx},
+    #endif
+};
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} IntegerCpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE41
+    {"SSE4.1", Corrade::Cpu::Sse41},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX2
+    {"AVX2", Corrade::Cpu::Avx2},
+    #endif
+};
 
 FunctionsBatchTest::FunctionsBatchTest() {
     addTests({&FunctionsBatchTest::isInf,
@@ -68,6 +105,29 @@ FunctionsBatchTest::FunctionsBatchTest() {
               &FunctionsBatchTest::nanIgnoringVector,
 
               &FunctionsBatchTest::constIterable});
+
+    addInstancedTests<FunctionsBatchTest>({
+        &FunctionsBatchTest::isNanKernel<Float>,
+        &FunctionsBatchTest::isNanKernel<Vector2>,
+        &FunctionsBatchTest::isNanKernel<Vector3>,
+        &FunctionsBatchTest::isNanKernel<Vector4>,
+        &FunctionsBatchTest::minmaxKernelFloat<Float>,
+        &FunctionsBatchTest::minmaxKernelFloat<Vector2>,
+        &FunctionsBatchTest::minmaxKernelFloat<Vector3>,
+        &FunctionsBatchTest::minmaxKernelFloat<Vector4>},
+        Corrade::Containers::arraySize(FloatCpuVariantData),
+        &FunctionsBatchTest::resetCpuFeatures,
+        &FunctionsBatchTest::resetCpuFeatures);
+
+    addInstancedTests<FunctionsBatchTest>({
+        &FunctionsBatchTest::minmaxKernelInteger<Int>,
+        &FunctionsBatchTest::minmaxKernelInteger<UnsignedInt>,
+        &FunctionsBatchTest::minmaxKernelInteger<Vector2i>,
+        &FunctionsBatchTest::minmaxKernelInteger<Vector3i>,
+        &FunctionsBatchTest::minmaxKernelInteger<Vector4ui>},
+        Corrade::Containers::arraySize(IntegerCpuVariantData),
+        &FunctionsBatchTest::resetCpuFeatures,
+        &FunctionsBatchTest::resetCpuFeatures);
 }
 
 void FunctionsBatchTest::isInf() {
@@ -303,6 +363,150 @@ void FunctionsBatchTest::constIterable() {
         std::make_pair(Vector2{-2, -5}, Vector2{9, 14}));
 }
 
+void FunctionsBatchTest::resetCpuFeatures() {
+    Implementation::functionsBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+template<class> struct TypeName;
+template<> struct TypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct TypeName<Vector2> { static const char* name() { return "Vector2"; } };
+template<> struct TypeName<Vector3> { static const char* name() { return "Vector3"; } };
+template<> struct TypeName<Vector4> { static const char* name() { return "Vector4"; } };
+template<> struct TypeName<Int> { static const char* name() { return "Int"; } };
+template<> struct TypeName<UnsignedInt> { static const char* name() { return "UnsignedInt"; } };
+template<> struct TypeName<Vector2i> { static const char* name() { return "Vector2i"; } };
+template<> struct TypeName<Vector3i> { static const char* name() { return "Vector3i"; } };
+template<> struct TypeName<Vector4ui> { static const char* name() { return "Vector4ui"; } };
+
+/* Enough items to go through the SIMD loops several times for all sizes
+   plus a few that take the scalar remainder */
+constexpr std::size_t KernelItemCount = 67;
+
+/* Contiguous views take the SIMD kernels, views with a padding between the
+   items the generic code path, which the output is compared against */
+template<class T> struct Padded {
+    T value;
+    T padding;
+};
+
+template<class T> void FunctionsBatchTest::isNanKernel() {
+    auto&& data = FloatCpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    constexpr std::size_t ComponentCount = sizeof(T)/sizeof(Float);
+    Corrade::Containers::Array<T> values{Corrade::ValueInit, KernelItemCount};
+    Float* components = reinterpret_cast<Float*>(values.data());
+    for(std::size_t i = 0; i != KernelItemCount*ComponentCount; ++i)
+        components[i] = Float(i)*0.75f - 20.0f;
+
+    /* No NaNs */
+    CORRADE_COMPARE(Math::isNan(values), decltype(Math::isNan(std::declval<T>())){});
+
+    /* A NaN in the last component of an item in the middle of the SIMD part
+       and in the first component in the scalar remainder */
+    components[40*ComponentCount + ComponentCount - 1] = Constants::nan();
+    components[(KernelItemCount - 1)*ComponentCount] = -Constants::nan();
+
+    Corrade::Containers::Array<Padded<T>> padded{Corrade::ValueInit, KernelItemCount};
+    for(std::size_t i = 0; i != KernelItemCount; ++i)
+        padded[i].value = values[i];
+    const Corrade::Containers::StridedArrayView1D<const T> paddedValues = Corrade::Containers::stridedArrayView(padded).slice(&Padded<T>::value);
+    CORRADE_VERIFY(!paddedValues.isContiguous());
+
+    CORRADE_COMPARE(Math::isNan(values), Math::isNan(paddedValues));
+    CORRADE_VERIFY(Math::isNan(values) != decltype(Math::isNan(std::declval<T>())){});
+}
+
+template<class T> void FunctionsBatchTest::minmaxKernelFloat() {
+    auto&& data = FloatCpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    constexpr std::size_t ComponentCount = sizeof(T)/sizeof(Float);
+    Corrade::Containers::Array<T> values{Corrade::ValueInit, KernelItemCount};
+    Float* components = reinterpret_cast<Float*>(values.data());
+    for(std::size_t i = 0; i != KernelItemCount*ComponentCount; ++i)
+        components[i] = Float((i*37)%101)*0.5f - 25.0f;
+
+    /* The extremes in various places, both in the SIMD part and in the
+       scalar remainder */
+    components[ComponentCount*5] = -1000.0f;
+    components[KernelItemCount*ComponentCount - 1] = 1000.0f;
+    components[ComponentCount*30] = Constants::inf();
+    /* NaNs sprinkled in, including the very first item */
+    components[0] = Constants::nan();
+    components[ComponentCount*17] = Constants::nan();
+    components[KernelItemCount*ComponentCount - 2] = Constants::nan();
+    /* For vectors the second component is all NaNs, which should result in
+       a NaN */
+    if(ComponentCount > 1) for(std::size_t i = 0; i != KernelItemCount; ++i)
+        components[i*ComponentCount + 1] = Constants::nan();
+
+    Corrade::Containers::Array<Padded<T>> padded{Corrade::ValueInit, KernelItemCount};
+    for(std::size_t i = 0; i != KernelItemCount; ++i)
+        padded[i].value = values[i];
+    const Corrade::Containers::StridedArrayView1D<const T> paddedValues = Corrade::Containers::stridedArrayView(padded).slice(&Padded<T>::value);
+    CORRADE_VERIFY(!paddedValues.isContiguous());
+
+    /* Comparing component-wise as vector comparison would fail on NaNs */
+    const T min = Math::min(values);
+    const T max = Math::max(values);
+    const std::pair<T, T> minmax = Math::minmax(values);
+    const T expectedMin = Math::min(paddedValues);
+    const T expectedMax = Math::max(paddedValues);
+    for(std::size_t i = 0; i != ComponentCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(reinterpret_cast<const Float*>(&min)[i], reinterpret_cast<const Float*>(&expectedMin)[i]);
+        CORRADE_COMPARE(reinterpret_cast<const Float*>(&max)[i], reinterpret_cast<const Float*>(&expectedMax)[i]);
+        CORRADE_COMPARE(reinterpret_cast<const Float*>(&minmax.first)[i], reinterpret_cast<const Float*>(&expectedMin)[i]);
+        CORRADE_COMPARE(reinterpret_cast<const Float*>(&minmax.second)[i], reinterpret_cast<const Float*>(&expectedMax)[i]);
+    }
+
+    /* Verify the reference isn't accidentally all NaNs */
+    CORRADE_COMPARE(reinterpret_cast<const Float*>(&expectedMin)[0], -1000.0f);
+    CORRADE_COMPARE(reinterpret_cast<const Float*>(&expectedMax)[0], Constants::inf());
+}
+
+template<class T> void FunctionsBatchTest::minmaxKernelInteger() {
+    auto&& data = IntegerCpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeName<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::functionsBatchCpuFeatures() = data.features;
+
+    typedef UnderlyingTypeOf<T> Type;
+    constexpr std::size_t ComponentCount = sizeof(T)/sizeof(Type);
+    Corrade::Containers::Array<T> values{Corrade::ValueInit, KernelItemCount};
+    Type* components = reinterpret_cast<Type*>(values.data());
+    /* Spanning the whole range to catch signedness errors */
+    for(std::size_t i = 0; i != KernelItemCount*ComponentCount; ++i)
+        components[i] = Type(UnsignedInt(i*2654435761u));
+
+    Corrade::Containers::Array<Padded<T>> padded{Corrade::ValueInit, KernelItemCount};
+    for(std::size_t i = 0; i != KernelItemCount; ++i)
+        padded[i].value = values[i];
+    const Corrade::Containers::StridedArrayView1D<const T> paddedValues = Corrade::Containers::stridedArrayView(padded).slice(&Padded<T>::value);
+    CORRADE_VERIFY(!paddedValues.isContiguous());
+
+    CORRADE_COMPARE(Math::min(values), Math::min(paddedValues));
+    CORRADE_COMPARE(Math::max(values), Math::max(paddedValues));
+    CORRADE_COMPARE(Math::minmax(values), Math::minmax(paddedValues));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchTest)
@@ -0,0 +1,278 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/Implementation/intersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void sphereFrustum();
+    void aabbFrustum();
+    void rangeFrustum();
+    void empty();
+    void resetCpuFeatures();
+
+    void sphereFrustumInvalidSize();
+    void aabbFrustumInvalidSize();
+    void rangeFrustumInvalidSize();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} CpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx},
+    #endif
+};
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addInstancedTests({&IntersectionBatchTest::sphereFrustum,
+                       &IntersectionBatchTest::aabbFrustum,
+                       &IntersectionBatchTest::rangeFrustum,
+                       &IntersectionBatchTest::empty},
+        Corrade::Containers::arraySize(CpuVariantData),
+        &IntersectionBatchTest::resetCpuFeatures,
+        &IntersectionBatchTest::resetCpuFeatures);
+
+    addTests({&IntersectionBatchTest::sphereFrustumInvalidSize,
+              &IntersectionBatchTest::aabbFrustumInvalidSize,
+              &IntersectionBatchTest::rangeFrustumInvalidSize});
+}
+
+/* Same frustum as in IntersectionTest::aabbFrustum() */
+const Frustum TestFrustum{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {-1.0f, 0.0f, 0.0f, 5.0f},
+    {0.0f, 1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, 1.0f, 0.0f},
+    {0.0f, 0.0f, -1.0f, 10.0f}};
+
+/* Interleaved volume data, 29 items in total to exercise both the SIMD loops
+   and the scalar remainder. The items are generated along a line crossing
+   the frustum so some end up inside, some outside and some intersecting it
+   with the sizes varying as well. */
+struct Volume {
+    Vector3 center;
+    Float radius;
+    Vector3 extents;
+    Range3D range;
+};
+
+constexpr std::size_t VolumeCount = 29;
+
+Corrade::Containers::Array<Volume> volumes() {
+    Corrade::Containers::Array<Volume> out{Corrade::NoInit, VolumeCount};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        out[i].center = Vector3{-5.0f, -2.0f, -5.0f} + Vector3{0.5f, 0.15f, 0.75f}*Float(i);
+        out[i].radius = 0.1f + (i % 5)*0.2f;
+        out[i].extents = Vector3{0.1f, 0.3f, 0.2f}*Float(i % 4 + 1);
+        out[i].range = Range3D::fromCenter(out[i].center, out[i].extents);
+    }
+    return out;
+}
+
+void IntersectionBatchTest::resetCpuFeatures() {
+    Implementation::intersectionBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Volume> volumes = Test::volumes();
+    Corrade::Containers::StridedArrayView1D<const Volume> view = volumes;
+
+    /* Writing to a view that doesn't start at a byte boundary, with the bits
+       around filled to verify they don't get overwritten */
+    Corrade::Containers::BitArray visible{Corrade::DirectInit, VolumeCount + 5, true};
+    Intersection::sphereFrustumInto(
+        view.slice(&Volume::center),
+        view.slice(&Volume::radius),
+        TestFrustum, visible.slice(3, 3 + VolumeCount));
+
+    std::size_t visibleCount = 0;
+    for(std::size_t i = 0; i != VolumeCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[3 + i], Intersection::sphereFrustum(volumes[i].center, volumes[i].radius, TestFrustum));
+        if(visible[3 + i]) ++visibleCount;
+    }
+    CORRADE_VERIFY(visible[0] && visible[1] && visible[2]);
+    CORRADE_VERIFY(visible[VolumeCount + 3] && visible[VolumeCount + 4]);
+
+    /* Verify the data is actually testing something */
+    CORRADE_COMPARE(visibleCount, 10);
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Volume> volumes = Test::volumes();
+    Corrade::Containers::StridedArrayView1D<const Volume> view = volumes;
+
+    Corrade::Containers::BitArray visible{Corrade::DirectInit, VolumeCount + 5, true};
+    Intersection::aabbFrustumInto(
+        view.slice(&Volume::center),
+        view.slice(&Volume::extents),
+        TestFrustum, visible.slice(3, 3 + VolumeCount));
+
+    std::size_t visibleCount = 0;
+    for(std::size_t i = 0; i != VolumeCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[3 + i], Intersection::aabbFrustum(volumes[i].center, volumes[i].extents, TestFrustum));
+        if(visible[3 + i]) ++visibleCount;
+    }
+    CORRADE_VERIFY(visible[0] && visible[1] && visible[2]);
+    CORRADE_VERIFY(visible[VolumeCount + 3] && visible[VolumeCount + 4]);
+
+    CORRADE_COMPARE(visibleCount, 11);
+}
+
+void IntersectionBatchTest::rangeFrustum() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Volume> volumes = Test::volumes();
+    Corrade::Containers::StridedArrayView1D<const Volume> view = volumes;
+
+    Corrade::Containers::BitArray visible{Corrade::DirectInit, VolumeCount + 5, true};
+    Intersection::rangeFrustumInto(
+        view.slice(&Volume::range),
+        TestFrustum, visible.slice(3, 3 + VolumeCount));
+
+    std::size_t visibleCount = 0;
+    for(std::size_t i = 0; i != VolumeCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(visible[3 + i], Intersection::rangeFrustum(volumes[i].range, TestFrustum));
+        if(visible[3 + i]) ++visibleCount;
+    }
+    CORRADE_VERIFY(visible[0] && visible[1] && visible[2]);
+    CORRADE_VERIFY(visible[VolumeCount + 3] && visible[VolumeCount + 4]);
+
+    /* Same volumes as in aabbFrustum(), so the same count */
+    CORRADE_COMPARE(visibleCount, 11);
+}
+
+void IntersectionBatchTest::empty() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    /* Shouldn't crash or do anything */
+    Intersection::sphereFrustumInto(nullptr, nullptr, TestFrustum, nullptr);
+    Intersection::aabbFrustumInto(nullptr, nullptr, TestFrustum, nullptr);
+    Intersection::rangeFrustumInto(nullptr, TestFrustum, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void IntersectionBatchTest::sphereFrustumInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 centers[3];
+    Float radii[2];
+    Corrade::Containers::BitArray visible{Corrade::ValueInit, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::sphereFrustumInto(centers, radii, TestFrustum, visible);
+    Intersection::sphereFrustumInto(Corrade::Containers::arrayView(centers).exceptSuffix(1), radii, TestFrustum, visible.prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::sphereFrustumInto(): expected center and radius views to have the same size but got 3 and 2\n"
+        "Math::Intersection::sphereFrustumInto(): wrong output size, got 1 but expected 2\n");
+}
+
+void IntersectionBatchTest::aabbFrustumInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 centers[3];
+    Vector3 extents[2];
+    Corrade::Containers::BitArray visible{Corrade::ValueInit, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::aabbFrustumInto(centers, extents, TestFrustum, visible);
+    Intersection::aabbFrustumInto(Corrade::Containers::arrayView(centers).exceptSuffix(1), extents, TestFrustum, visible.prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::aabbFrustumInto(): expected center and extent views to have the same size but got 3 and 2\n"
+        "Math::Intersection::aabbFrustumInto(): wrong output size, got 1 but expected 2\n");
+}
+
+void IntersectionBatchTest::rangeFrustumInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Range3D ranges[3];
+    Corrade::Containers::BitArray visible{Corrade::ValueInit, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Intersection::rangeFrustumInto(ranges, TestFrustum, visible);
+    CORRADE_COMPARE(out.str(),
+        "Math::Intersection::rangeFrustumInto(): wrong output size, got 2 but expected 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
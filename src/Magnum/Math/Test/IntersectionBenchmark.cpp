@@ -26,10 +26,18 @@
 
 #include <random>
 #include <utility>
+#include <vector>
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/BitArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/Implementation/intersectionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -111,6 +119,12 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
     void sphereCone();
     void sphereConeView();
 
+    void sphereFrustumBatch();
+    void aabbFrustumBatch();
+    void rangeFrustumBatch();
+
+    void resetCpuFeatures();
+
     Frustum _frustum;
     struct {
         Vector3 origin;
@@ -121,8 +135,34 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     std::vector<Range3D> _boxes;
     std::vector<Vector4> _spheres;
+
+    /* Interleaved like a typical per-instance buffer */
+    struct Instance {
+        Vector3 center;
+        Float radius;
+        Vector3 extents;
+        Range3D range;
+    };
+    std::vector<Instance> _instances;
+};
+
+/* The scalar variant calls the single-volume functions in a loop */
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} BatchData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx},
+    #endif
 };
 
+/* Roughly what a scene with a lot of instances culls each frame */
+constexpr std::size_t BatchCount = 200000;
+
 IntersectionBenchmark::IntersectionBenchmark() {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
@@ -135,6 +175,13 @@ IntersectionBenchmark::IntersectionBenchmark() {
                    &IntersectionBenchmark::sphereCone,
                    &IntersectionBenchmark::sphereConeView}, 10);
 
+    addInstancedBenchmarks({&IntersectionBenchmark::sphereFrustumBatch,
+                            &IntersectionBenchmark::aabbFrustumBatch,
+                            &IntersectionBenchmark::rangeFrustumBatch}, 10,
+        Corrade::Containers::arraySize(BatchData),
+        &IntersectionBenchmark::resetCpuFeatures,
+        &IntersectionBenchmark::resetCpuFeatures);
+
     /* Generate random data for the benchmarks */
     std::random_device rnd;
     std::mt19937 g(rnd());
@@ -157,6 +204,21 @@ IntersectionBenchmark::IntersectionBenchmark() {
         _boxes.emplace_back(center - extents, center + extents);
         _spheres.emplace_back(center, extents.length());
     }
+
+    /* Spread the instances over a larger area so only a part of them is
+       visible, with the frustum pointing at the origin */
+    std::uniform_real_distribution<float> bd(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> sd(0.1f, 2.0f);
+    _instances.reserve(BatchCount);
+    for(std::size_t i = 0; i != BatchCount; ++i) {
+        Vector3 center{bd(g), bd(g), bd(g)};
+        Vector3 extents{sd(g), sd(g), sd(g)};
+        _instances.push_back({center, extents.length(), extents, Range3D::fromCenter(center, extents)});
+    }
+}
+
+void IntersectionBenchmark::resetCpuFeatures() {
+    Implementation::intersectionBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
 }
 
 void IntersectionBenchmark::rangeFrustumNaive() {
@@ -221,6 +283,71 @@ void IntersectionBenchmark::sphereConeView() {
     }
 }
 
+void IntersectionBenchmark::sphereFrustumBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::StridedArrayView1D<const Instance> instances = Corrade::Containers::arrayView(_instances.data(), _instances.size());
+    Corrade::Containers::BitArray visible{Corrade::NoInit, BatchCount};
+    CORRADE_BENCHMARK(1) {
+        Intersection::sphereFrustumInto(
+            instances.slice(&Instance::center),
+            instances.slice(&Instance::radius),
+            _frustum, visible);
+    }
+
+    CORRADE_COMPARE_AS(visible.count(), 0,
+        Corrade::TestSuite::Compare::Greater);
+}
+
+void IntersectionBenchmark::aabbFrustumBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::StridedArrayView1D<const Instance> instances = Corrade::Containers::arrayView(_instances.data(), _instances.size());
+    Corrade::Containers::BitArray visible{Corrade::NoInit, BatchCount};
+    CORRADE_BENCHMARK(1) {
+        Intersection::aabbFrustumInto(
+            instances.slice(&Instance::center),
+            instances.slice(&Instance::extents),
+            _frustum, visible);
+    }
+
+    CORRADE_COMPARE_AS(visible.count(), 0,
+        Corrade::TestSuite::Compare::Greater);
+}
+
+void IntersectionBenchmark::rangeFrustumBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::intersectionBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::StridedArrayView1D<const Instance> instances = Corrade::Containers::arrayView(_instances.data(), _instances.size());
+    Corrade::Containers::BitArray visible{Corrade::NoInit, BatchCount};
+    CORRADE_BENCHMARK(1) {
+        Intersection::rangeFrustumInto(
+            instances.slice(&Instance::range),
+            _frustum, visible);
+    }
+
+    CORRADE_COMPARE_AS(visible.count(), 0,
+        Corrade::TestSuite::Compare::Greater);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBenchmark)
@@ -0,0 +1,322 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
+#include "Magnum/Math/Implementation/matrixBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct MatrixBatchTest: Corrade::TestSuite::Tester {
+    explicit MatrixBatchTest();
+
+    void transformPoints3D();
+    void transformPoints2D();
+    void transformVectors3D();
+    void multiply4();
+    void empty();
+    void resetCpuFeatures();
+
+    void multiply3();
+
+    void transformPointsInvalidSize();
+    void transformVectorsInvalidSize();
+    void multiplyInvalidSize();
+};
+
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix3x3<Float> Matrix3x3;
+typedef Math::Matrix3<Float> Matrix3;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Deg<Float> Deg;
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} CpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx},
+    #endif
+};
+
+MatrixBatchTest::MatrixBatchTest() {
+    addInstancedTests({&MatrixBatchTest::transformPoints3D,
+                       &MatrixBatchTest::transformPoints2D,
+                       &MatrixBatchTest::transformVectors3D,
+                       &MatrixBatchTest::multiply4,
+                       &MatrixBatchTest::empty},
+        Corrade::Containers::arraySize(CpuVariantData),
+        &MatrixBatchTest::resetCpuFeatures,
+        &MatrixBatchTest::resetCpuFeatures);
+
+    addTests({&MatrixBatchTest::multiply3,
+
+              &MatrixBatchTest::transformPointsInvalidSize,
+              &MatrixBatchTest::transformVectorsInvalidSize,
+              &MatrixBatchTest::multiplyInvalidSize});
+}
+
+/* Interleaved vertex data, 19 items in total to exercise both the SIMD loops
+   and the scalar remainder */
+struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+    Vector3 normal;
+};
+
+constexpr std::size_t VertexCount = 19;
+
+Corrade::Containers::Array<Vertex> vertices() {
+    Corrade::Containers::Array<Vertex> out{Corrade::NoInit, VertexCount};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const Float f = Float(i);
+        out[i].position = {f*0.5f - 3.0f, 2.0f - f*0.25f, f*f*0.125f};
+        out[i].textureCoordinates = {f/VertexCount, 1.0f - f*f/(VertexCount*VertexCount)};
+        out[i].normal = Vector3{f - 7.0f, 3.0f, f*0.5f}.normalized();
+    }
+    return out;
+}
+
+void MatrixBatchTest::resetCpuFeatures() {
+    Implementation::matrixBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+void MatrixBatchTest::transformPoints3D() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    /* A projective matrix to verify the division by W is done as well */
+    const Matrix4 matrix = Matrix4::perspectiveProjection(Deg(35.0f), 1.5f, 0.1f, 100.0f)*Matrix4::translation({1.0f, -2.0f, -15.0f})*Matrix4::rotationX(Deg(30.0f))*Matrix4::scaling({2.0f, 1.5f, 0.5f});
+
+    const Corrade::Containers::Array<Vertex> vertices = Test::vertices();
+    Corrade::Containers::Array<Vertex> transformed = Test::vertices();
+    const Corrade::Containers::StridedArrayView1D<Vector3> positions = Corrade::Containers::stridedArrayView(transformed).slice(&Vertex::position);
+
+    /* In-place, the other interleaved attributes shouldn't be touched */
+    transformPointsInto(matrix, positions, positions);
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(transformed[i].position, matrix.transformPoint(vertices[i].position));
+        CORRADE_COMPARE(transformed[i].textureCoordinates, vertices[i].textureCoordinates);
+        CORRADE_COMPARE(transformed[i].normal, vertices[i].normal);
+    }
+
+    /* Into a different view */
+    Vector3 out[VertexCount];
+    transformPointsInto(matrix, Corrade::Containers::stridedArrayView(vertices).slice(&Vertex::position), out);
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], matrix.transformPoint(vertices[i].position));
+    }
+}
+
+void MatrixBatchTest::transformPoints2D() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    const Matrix3 matrix = Matrix3::translation({0.25f, -1.0f})*Matrix3::rotation(Deg(35.0f))*Matrix3::scaling({2.0f, -0.5f});
+
+    const Corrade::Containers::Array<Vertex> vertices = Test::vertices();
+    Corrade::Containers::Array<Vertex> transformed = Test::vertices();
+    const Corrade::Containers::StridedArrayView1D<Vector2> textureCoordinates = Corrade::Containers::stridedArrayView(transformed).slice(&Vertex::textureCoordinates);
+
+    transformPointsInto(matrix, textureCoordinates, textureCoordinates);
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(transformed[i].position, vertices[i].position);
+        CORRADE_COMPARE(transformed[i].textureCoordinates, matrix.transformPoint(vertices[i].textureCoordinates));
+        CORRADE_COMPARE(transformed[i].normal, vertices[i].normal);
+    }
+}
+
+void MatrixBatchTest::transformVectors3D() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    const Matrix3x3 matrix = (Matrix4::rotationY(Deg(-75.0f))*Matrix4::scaling({2.0f, 1.5f, 0.5f})).normalMatrix();
+
+    const Corrade::Containers::Array<Vertex> vertices = Test::vertices();
+    Corrade::Containers::Array<Vertex> transformed = Test::vertices();
+    const Corrade::Containers::StridedArrayView1D<Vector3> normals = Corrade::Containers::stridedArrayView(transformed).slice(&Vertex::normal);
+
+    transformVectorsInto(matrix, normals, normals);
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(transformed[i].position, vertices[i].position);
+        CORRADE_COMPARE(transformed[i].textureCoordinates, vertices[i].textureCoordinates);
+        CORRADE_COMPARE(transformed[i].normal, matrix*vertices[i].normal);
+    }
+}
+
+void MatrixBatchTest::multiply4() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    Matrix4 a[5];
+    Matrix4 b[5];
+    for(std::size_t i = 0; i != 5; ++i) {
+        a[i] = Matrix4::translation({Float(i), 1.0f, -2.0f})*Matrix4::rotationZ(Deg(15.0f*i));
+        b[i] = Matrix4::perspectiveProjection(Deg(35.0f + i), 1.5f, 0.1f, 100.0f)*Matrix4::scaling({1.0f, 2.0f, Float(i)});
+    }
+
+    Matrix4 out[5];
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+
+    /* In-place, with the output being either of the inputs */
+    Matrix4 a2[5];
+    Matrix4 b2[5];
+    for(std::size_t i = 0; i != 5; ++i) {
+        a2[i] = a[i];
+        b2[i] = b[i];
+    }
+    multiplyInto(a2, b, a2);
+    multiplyInto(a, b2, b2);
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(a2[i], a[i]*b[i]);
+        CORRADE_COMPARE(b2[i], a[i]*b[i]);
+    }
+}
+
+void MatrixBatchTest::empty() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    /* Shouldn't crash or do anything */
+    transformPointsInto(Matrix4{}, Corrade::Containers::StridedArrayView1D<const Vector3>{}, nullptr);
+    transformPointsInto(Matrix3{}, Corrade::Containers::StridedArrayView1D<const Vector2>{}, nullptr);
+    transformVectorsInto(Matrix3x3{}, nullptr, nullptr);
+    multiplyInto(Corrade::Containers::StridedArrayView1D<const Matrix4>{}, nullptr, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void MatrixBatchTest::multiply3() {
+    Matrix3 a[3];
+    Matrix3 b[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        a[i] = Matrix3::translation({Float(i), 1.0f})*Matrix3::rotation(Deg(15.0f*i));
+        b[i] = Matrix3::scaling({1.0f, Float(i)});
+    }
+
+    Matrix3 out[3];
+    multiplyInto(a, b, out);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i], a[i]*b[i]);
+    }
+}
+
+void MatrixBatchTest::transformPointsInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 points3[3];
+    Vector2 points2[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformPointsInto(Matrix4{}, points3, Corrade::Containers::arrayView(points3).exceptSuffix(1));
+    transformPointsInto(Matrix3{}, points2, Corrade::Containers::arrayView(points2).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::transformPointsInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::transformPointsInto(): wrong destination size, got 2 but expected 3\n");
+}
+
+void MatrixBatchTest::transformVectorsInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3 vectors[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformVectorsInto(Matrix3x3{}, vectors, Corrade::Containers::arrayView(vectors).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::transformVectorsInto(): wrong destination size, got 2 but expected 3\n");
+}
+
+void MatrixBatchTest::multiplyInvalidSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Matrix4 matrices4[3];
+    Matrix3 matrices3[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiplyInto(matrices4, Corrade::Containers::arrayView(matrices4).exceptSuffix(1), matrices4);
+    multiplyInto(matrices4, matrices4, Corrade::Containers::arrayView(matrices4).exceptSuffix(1));
+    multiplyInto(matrices3, Corrade::Containers::arrayView(matrices3).exceptSuffix(1), matrices3);
+    multiplyInto(matrices3, matrices3, Corrade::Containers::arrayView(matrices3).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "Math::multiplyInto(): expected source views to have the same size but got 3 and 2\n"
+        "Math::multiplyInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::multiplyInto(): expected source views to have the same size but got 3 and 2\n"
+        "Math::multiplyInto(): wrong destination size, got 2 but expected 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBatchTest)
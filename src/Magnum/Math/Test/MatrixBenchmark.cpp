@@ -23,11 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/MatrixBatch.h"
 #include "Magnum/Math/Algorithms/GaussJordan.h"
+#include "Magnum/Math/Implementation/matrixBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -52,8 +57,30 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
     void transformPoint3();
     void transformVector4();
     void transformPoint4();
+
+    void transformPoints2DBatch();
+    void transformPoints3DBatch();
+    void transformVectors3DBatch();
+    void multiply4Batch();
+
+    void resetCpuFeatures();
 };
 
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} BatchData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX
+    {"AVX", Corrade::Cpu::Avx},
+    #endif
+};
+
+constexpr std::size_t BatchCount = 1000000;
+
 MatrixBenchmark::MatrixBenchmark() {
     addBenchmarks({&MatrixBenchmark::multiply3,
                    &MatrixBenchmark::multiply4}, 500);
@@ -73,6 +100,14 @@ MatrixBenchmark::MatrixBenchmark() {
                    &MatrixBenchmark::transformPoint3,
                    &MatrixBenchmark::transformVector4,
                    &MatrixBenchmark::transformPoint4}, 1000);
+
+    addInstancedBenchmarks({&MatrixBenchmark::transformPoints2DBatch,
+                            &MatrixBenchmark::transformPoints3DBatch,
+                            &MatrixBenchmark::transformVectors3DBatch,
+                            &MatrixBenchmark::multiply4Batch}, 10,
+        Corrade::Containers::arraySize(BatchData),
+        &MatrixBenchmark::resetCpuFeatures,
+        &MatrixBenchmark::resetCpuFeatures);
 }
 
 typedef Math::Vector2<Float> Vector2;
@@ -237,6 +272,79 @@ void MatrixBenchmark::transformPoint4() {
     CORRADE_VERIFY(a.sum() != 0);
 }
 
+void MatrixBenchmark::resetCpuFeatures() {
+    Implementation::matrixBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+void MatrixBenchmark::transformPoints2DBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Vector2> a{Corrade::DirectInit, BatchCount, 3.0f, -2.2f};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInto(Data3, Corrade::Containers::arrayView(a), a);
+    }
+
+    CORRADE_VERIFY(a[BatchCount - 1].sum() != 0);
+}
+
+void MatrixBenchmark::transformPoints3DBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Vector3> a{Corrade::DirectInit, BatchCount, 1.0f, 3.0f, -2.2f};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInto(Data4, Corrade::Containers::arrayView(a), a);
+    }
+
+    CORRADE_VERIFY(a[BatchCount - 1].sum() != 0);
+}
+
+void MatrixBenchmark::transformVectors3DBatch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Vector3> a{Corrade::DirectInit, BatchCount, 1.0f, 3.0f, -2.2f};
+    CORRADE_BENCHMARK(1) {
+        transformVectorsInto(Data4.normalMatrix(), Corrade::Containers::arrayView(a), a);
+    }
+
+    CORRADE_VERIFY(a[BatchCount - 1].sum() != 0);
+}
+
+void MatrixBenchmark::multiply4Batch() {
+    auto&& data = BatchData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::matrixBatchCpuFeatures() = data.features;
+
+    /* Four times less items as each matrix is sixteen floats */
+    Corrade::Containers::Array<Matrix4> a{Corrade::DirectInit, BatchCount/4, Data4};
+    CORRADE_BENCHMARK(1) {
+        multiplyInto(Corrade::Containers::arrayView(a), a, a);
+    }
+
+    CORRADE_VERIFY(a[BatchCount/4 - 1].toVector().sum() != 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBenchmark)
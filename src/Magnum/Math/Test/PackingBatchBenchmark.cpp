@@ -0,0 +1,295 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Implementation/packingBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    template<class T> void unpack();
+    template<class T> void pack();
+    template<class T> void castIntoFloat();
+    template<class T> void castFromFloat();
+
+    void unpackHalf();
+    void packHalf();
+
+    void resetCpuFeatures();
+};
+
+/* The scalar variant is the original per-component loop the SIMD variants
+   are compared against */
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+    bool interleaved;
+} Data[]{
+    {"scalar", Corrade::Cpu::Scalar, false},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2, false},
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    {"SSE4.1", Corrade::Cpu::Sse41, false},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX2
+    {"AVX2", Corrade::Cpu::Avx2, false},
+    #endif
+    {"scalar, interleaved", Corrade::Cpu::Scalar, true},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2, interleaved", Corrade::Cpu::Sse2, true},
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    {"SSE4.1, interleaved", Corrade::Cpu::Sse41, true},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX2
+    {"AVX2, interleaved", Corrade::Cpu::Avx2, true},
+    #endif
+};
+
+/* A million four-component vertex attributes. The interleaved variant
+   converts them as 4-component rows with a stride of eight components, which
+   is what a typical interleaved vertex buffer looks like, the other converts
+   a contiguous array. */
+constexpr std::size_t Rows = 1000000;
+
+/* The scalar variant is the original table-based implementation */
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+    bool interleaved;
+} HalfData[]{
+    {"scalar", Corrade::Cpu::Scalar, false},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2, false},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX_F16C
+    {"AVX F16C", Corrade::Cpu::Avx|Corrade::Cpu::AvxF16c, false},
+    #endif
+    {"scalar, interleaved", Corrade::Cpu::Scalar, true},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2, interleaved", Corrade::Cpu::Sse2, true},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX_F16C
+    {"AVX F16C, interleaved", Corrade::Cpu::Avx|Corrade::Cpu::AvxF16c, true},
+    #endif
+};
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addInstancedBenchmarks({&PackingBatchBenchmark::unpack<UnsignedByte>,
+                            &PackingBatchBenchmark::unpack<Byte>,
+                            &PackingBatchBenchmark::unpack<UnsignedShort>,
+                            &PackingBatchBenchmark::unpack<Short>,
+                            &PackingBatchBenchmark::pack<UnsignedByte>,
+                            &PackingBatchBenchmark::pack<Byte>,
+                            &PackingBatchBenchmark::pack<UnsignedShort>,
+                            &PackingBatchBenchmark::pack<Short>,
+                            &PackingBatchBenchmark::castIntoFloat<UnsignedByte>,
+                            &PackingBatchBenchmark::castIntoFloat<Short>,
+                            &PackingBatchBenchmark::castFromFloat<UnsignedByte>,
+                            &PackingBatchBenchmark::castFromFloat<Short>}, 10,
+        Corrade::Containers::arraySize(Data),
+        &PackingBatchBenchmark::resetCpuFeatures,
+        &PackingBatchBenchmark::resetCpuFeatures);
+
+    addInstancedBenchmarks({&PackingBatchBenchmark::unpackHalf,
+                            &PackingBatchBenchmark::packHalf}, 10,
+        Corrade::Containers::arraySize(HalfData),
+        &PackingBatchBenchmark::resetCpuFeatures,
+        &PackingBatchBenchmark::resetCpuFeatures);
+}
+
+void PackingBatchBenchmark::resetCpuFeatures() {
+    Implementation::packingBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+template<class T> Corrade::Containers::StridedArrayView2D<T> view(Corrade::Containers::ArrayView<T> data, bool interleaved) {
+    if(interleaved)
+        return Corrade::Containers::StridedArrayView2D<T>{data, {Rows, 8}}.prefix({Rows, 4});
+    return Corrade::Containers::StridedArrayView2D<T>{data.prefix(Rows*4), {Rows, 4}};
+}
+
+template<class T> void PackingBatchBenchmark::unpack() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<T> src{Corrade::NoInit, Rows*8};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = T(i*40503);
+    Corrade::Containers::Array<Float> dst{Corrade::ValueInit, Rows*8};
+
+    CORRADE_BENCHMARK(1) {
+        unpackInto(view<const T>(src, data.interleaved), view<Float>(dst, data.interleaved));
+    }
+
+    CORRADE_COMPARE(dst[3], Math::unpack<Float>(src[3]));
+}
+
+template<class T> void PackingBatchBenchmark::pack() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Float> src{Corrade::NoInit, Rows*8};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i % 1001)/1000.0f;
+    Corrade::Containers::Array<T> dst{Corrade::ValueInit, Rows*8};
+
+    CORRADE_BENCHMARK(1) {
+        packInto(view<const Float>(src, data.interleaved), view<T>(dst, data.interleaved));
+    }
+
+    CORRADE_COMPARE(dst[3], Math::pack<T>(src[3]));
+}
+
+template<class T> void PackingBatchBenchmark::castIntoFloat() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<T> src{Corrade::NoInit, Rows*8};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = T(i*40503);
+    Corrade::Containers::Array<Float> dst{Corrade::ValueInit, Rows*8};
+
+    CORRADE_BENCHMARK(1) {
+        castInto(view<const T>(src, data.interleaved), view<Float>(dst, data.interleaved));
+    }
+
+    CORRADE_COMPARE(dst[3], Float(src[3]));
+}
+
+template<class T> void PackingBatchBenchmark::castFromFloat() {
+    auto&& data = Data[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<Float> src{Corrade::NoInit, Rows*8};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i % 101) + 0.25f;
+    Corrade::Containers::Array<T> dst{Corrade::ValueInit, Rows*8};
+
+    CORRADE_BENCHMARK(1) {
+        castInto(view<const Float>(src, data.interleaved), view<T>(dst, data.interleaved));
+    }
+
+    CORRADE_COMPARE(dst[3], T(src[3]));
+}
+
+void PackingBatchBenchmark::unpackHalf() {
+    auto&& data = HalfData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    /* Interleaved rows have only four components, which would make them all
+       go through the scalar code path. Use eight instead. */
+    Corrade::Containers::Array<UnsignedShort> src{Corrade::NoInit, Rows*16};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Math::packHalf(Float(i % 1001)/10.0f);
+    Corrade::Containers::Array<Float> dst{Corrade::ValueInit, Rows*16};
+
+    const Corrade::Containers::StridedArrayView2D<const UnsignedShort> srcView = data.interleaved ?
+        Corrade::Containers::StridedArrayView2D<const UnsignedShort>{src, {Rows, 16}}.prefix({Rows, 8}) :
+        Corrade::Containers::StridedArrayView2D<const UnsignedShort>{src.prefix(Rows*8), {Rows, 8}};
+    const Corrade::Containers::StridedArrayView2D<Float> dstView = data.interleaved ?
+        Corrade::Containers::StridedArrayView2D<Float>{dst, {Rows, 16}}.prefix({Rows, 8}) :
+        Corrade::Containers::StridedArrayView2D<Float>{dst.prefix(Rows*8), {Rows, 8}};
+
+    CORRADE_BENCHMARK(1) {
+        unpackHalfInto(srcView, dstView);
+    }
+
+    CORRADE_COMPARE(dst[3], Math::unpackHalf(src[3]));
+}
+
+void PackingBatchBenchmark::packHalf() {
+    auto&& data = HalfData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    /* Interleaved rows have only four components, which would make them all
+       go through the scalar code path. Use eight instead. */
+    Corrade::Containers::Array<Float> src{Corrade::NoInit, Rows*16};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = Float(i % 1001)/10.0f;
+    Corrade::Containers::Array<UnsignedShort> dst{Corrade::ValueInit, Rows*16};
+
+    const Corrade::Containers::StridedArrayView2D<const Float> srcView = data.interleaved ?
+        Corrade::Containers::StridedArrayView2D<const Float>{src, {Rows, 16}}.prefix({Rows, 8}) :
+        Corrade::Containers::StridedArrayView2D<const Float>{src.prefix(Rows*8), {Rows, 8}};
+    const Corrade::Containers::StridedArrayView2D<UnsignedShort> dstView = data.interleaved ?
+        Corrade::Containers::StridedArrayView2D<UnsignedShort>{dst, {Rows, 16}}.prefix({Rows, 8}) :
+        Corrade::Containers::StridedArrayView2D<UnsignedShort>{dst.prefix(Rows*8), {Rows, 8}};
+
+    CORRADE_BENCHMARK(1) {
+        packHalfInto(srcView, dstView);
+    }
+
+    /* The batch implementation truncates, while packHalf() would round to
+       0x34cd */
+    CORRADE_COMPARE(dst[3], UnsignedShort(0x34cc));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
@@ -24,6 +24,8 @@
 */
 
 #include <sstream>
+#include <Corrade/Cpu.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -33,6 +35,7 @@
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/PackingBatch.h"
 #include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Implementation/packingBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -48,8 +51,16 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     void packSignedByte();
     void packSignedShort();
 
+    template<class T> void unpackCpuVariant();
+    template<class T> void packCpuVariant();
+    template<class T> void castIntoFloatCpuVariant();
+    template<class T> void castFromFloatCpuVariant();
+    void resetCpuFeatures();
+
     void unpackHalf();
     void packHalf();
+    void unpackHalfCpuVariant();
+    void packHalfCpuVariant();
 
     template<class FloatingPoint, class Integral> void castUnsignedFloatingPoint();
     template<class FloatingPoint, class Integral> void castSignedFloatingPoint();
@@ -63,6 +74,35 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     template<class U, class T> void assertionsCast();
 };
 
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} CpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_SSE41
+    {"SSE4.1", Corrade::Cpu::Sse41},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX2
+    {"AVX2", Corrade::Cpu::Avx2},
+    #endif
+};
+
+const struct {
+    const char* name;
+    Corrade::Cpu::Features features;
+} HalfCpuVariantData[]{
+    {"scalar", Corrade::Cpu::Scalar},
+    #ifdef CORRADE_ENABLE_SSE2
+    {"SSE2", Corrade::Cpu::Sse2},
+    #endif
+    #ifdef CORRADE_ENABLE_AVX_F16C
+    {"AVX F16C", Corrade::Cpu::Avx|Corrade::Cpu::AvxF16c},
+    #endif
+};
+
 PackingBatchTest::PackingBatchTest() {
     addTests({&PackingBatchTest::unpackUnsignedByte,
               &PackingBatchTest::unpackUnsignedShort,
@@ -71,12 +111,38 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::packUnsignedByte,
               &PackingBatchTest::packUnsignedShort,
               &PackingBatchTest::packSignedByte,
-              &PackingBatchTest::packSignedShort,
-
-              &PackingBatchTest::unpackHalf,
-              &PackingBatchTest::packHalf,
-
-              &PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedByte>,
+              &PackingBatchTest::packSignedShort});
+
+    addInstancedTests({&PackingBatchTest::unpackCpuVariant<UnsignedByte>,
+                       &PackingBatchTest::unpackCpuVariant<Byte>,
+                       &PackingBatchTest::unpackCpuVariant<UnsignedShort>,
+                       &PackingBatchTest::unpackCpuVariant<Short>,
+                       &PackingBatchTest::packCpuVariant<UnsignedByte>,
+                       &PackingBatchTest::packCpuVariant<Byte>,
+                       &PackingBatchTest::packCpuVariant<UnsignedShort>,
+                       &PackingBatchTest::packCpuVariant<Short>,
+                       &PackingBatchTest::castIntoFloatCpuVariant<UnsignedByte>,
+                       &PackingBatchTest::castIntoFloatCpuVariant<Byte>,
+                       &PackingBatchTest::castIntoFloatCpuVariant<UnsignedShort>,
+                       &PackingBatchTest::castIntoFloatCpuVariant<Short>,
+                       &PackingBatchTest::castFromFloatCpuVariant<UnsignedByte>,
+                       &PackingBatchTest::castFromFloatCpuVariant<Byte>,
+                       &PackingBatchTest::castFromFloatCpuVariant<UnsignedShort>,
+                       &PackingBatchTest::castFromFloatCpuVariant<Short>},
+        Corrade::Containers::arraySize(CpuVariantData),
+        &PackingBatchTest::resetCpuFeatures,
+        &PackingBatchTest::resetCpuFeatures);
+
+    addTests({&PackingBatchTest::unpackHalf,
+              &PackingBatchTest::packHalf});
+
+    addInstancedTests({&PackingBatchTest::unpackHalfCpuVariant,
+                       &PackingBatchTest::packHalfCpuVariant},
+        Corrade::Containers::arraySize(HalfCpuVariantData),
+        &PackingBatchTest::resetCpuFeatures,
+        &PackingBatchTest::resetCpuFeatures);
+
+    addTests({&PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedByte>,
               &PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedShort>,
               &PackingBatchTest::castUnsignedFloatingPoint<Float, UnsignedInt>,
               &PackingBatchTest::castUnsignedFloatingPoint<Double, UnsignedByte>,
@@ -399,6 +465,152 @@ void PackingBatchTest::packSignedShort() {
         CORRADE_COMPARE(Math::pack<Vector2s>(data[i].src), data[i].dst);
 }
 
+void PackingBatchTest::resetCpuFeatures() {
+    Implementation::packingBatchCpuFeatures() = Corrade::Cpu::runtimeFeatures();
+}
+
+/* 37 rows of 9 components. Taking a prefix of 9, 8, 5 and 3 components of
+   each row exercises the single contiguous run as well as row-wise processing
+   with both the SIMD loops and the scalar remainder. */
+constexpr std::size_t CpuVariantRows = 37;
+constexpr std::size_t CpuVariantComponents[]{9, 8, 5, 3};
+
+template<class T> void PackingBatchTest::unpackCpuVariant() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<T> src{Corrade::NoInit, CpuVariantRows*9};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = T(i*40503);
+
+    for(std::size_t size: CpuVariantComponents) {
+        CORRADE_ITERATION(size);
+
+        Corrade::Containers::Array<Float> expected{Corrade::ValueInit, CpuVariantRows*9};
+        for(std::size_t i = 0; i != CpuVariantRows; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                expected[i*9 + j] = Math::unpack<Float>(src[i*9 + j]);
+
+        Corrade::Containers::Array<Float> actual{Corrade::ValueInit, CpuVariantRows*9};
+        unpackInto(
+            Corrade::Containers::StridedArrayView2D<const T>{src, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}),
+            Corrade::Containers::StridedArrayView2D<Float>{actual, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}));
+
+        /* The output should be bit-exact with the scalar variant */
+        CORRADE_COMPARE_AS(Corrade::Containers::arrayCast<UnsignedInt>(actual),
+            Corrade::Containers::arrayCast<UnsignedInt>(expected),
+            Corrade::TestSuite::Compare::Container);
+    }
+}
+
+template<class T> void PackingBatchTest::packCpuVariant() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    /* Every other value is exactly in the middle between two integers to
+       verify the rounding is the same as with std::round() */
+    Corrade::Containers::Array<Float> src{Corrade::NoInit, CpuVariantRows*9};
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const Float value = i % 2 ?
+            (Float(i % 100) + 0.5f)/Implementation::bitMax<T>() :
+            Float(i % 101)/100.0f;
+        src[i] = std::is_signed<T>::value && i % 3 ? -value : value;
+    }
+
+    for(std::size_t size: CpuVariantComponents) {
+        CORRADE_ITERATION(size);
+
+        Corrade::Containers::Array<T> expected{Corrade::ValueInit, CpuVariantRows*9};
+        for(std::size_t i = 0; i != CpuVariantRows; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                expected[i*9 + j] = Math::pack<T>(src[i*9 + j]);
+
+        Corrade::Containers::Array<T> actual{Corrade::ValueInit, CpuVariantRows*9};
+        packInto(
+            Corrade::Containers::StridedArrayView2D<const Float>{src, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}),
+            Corrade::Containers::StridedArrayView2D<T>{actual, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}));
+        CORRADE_COMPARE_AS(actual, expected,
+            Corrade::TestSuite::Compare::Container);
+    }
+}
+
+template<class T> void PackingBatchTest::castIntoFloatCpuVariant() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    Corrade::Containers::Array<T> src{Corrade::NoInit, CpuVariantRows*9};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = T(i*40503);
+
+    for(std::size_t size: CpuVariantComponents) {
+        CORRADE_ITERATION(size);
+
+        Corrade::Containers::Array<Float> expected{Corrade::ValueInit, CpuVariantRows*9};
+        for(std::size_t i = 0; i != CpuVariantRows; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                expected[i*9 + j] = Float(src[i*9 + j]);
+
+        Corrade::Containers::Array<Float> actual{Corrade::ValueInit, CpuVariantRows*9};
+        castInto(
+            Corrade::Containers::StridedArrayView2D<const T>{src, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}),
+            Corrade::Containers::StridedArrayView2D<Float>{actual, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}));
+        CORRADE_COMPARE_AS(actual, expected,
+            Corrade::TestSuite::Compare::Container);
+    }
+}
+
+template<class T> void PackingBatchTest::castFromFloatCpuVariant() {
+    auto&& data = CpuVariantData[testCaseInstanceId()];
+    setTestCaseTemplateName(TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    Implementation::packingBatchCpuFeatures() = data.features;
+
+    /* Values with a fractional part to verify it gets truncated */
+    Corrade::Containers::Array<Float> src{Corrade::NoInit, CpuVariantRows*9};
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const Float value = Float(i*7 % Implementation::bitMax<T>()) + 0.75f;
+        src[i] = std::is_signed<T>::value && i % 3 ? -value : value;
+    }
+
+    for(std::size_t size: CpuVariantComponents) {
+        CORRADE_ITERATION(size);
+
+        Corrade::Containers::Array<T> expected{Corrade::ValueInit, CpuVariantRows*9};
+        for(std::size_t i = 0; i != CpuVariantRows; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                expected[i*9 + j] = T(src[i*9 + j]);
+
+        Corrade::Containers::Array<T> actual{Corrade::ValueInit, CpuVariantRows*9};
+        castInto(
+            Corrade::Containers::StridedArrayView2D<const Float>{src, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}),
+            Corrade::Containers::StridedArrayView2D<T>{actual, {CpuVariantRows, 9}}.prefix({CpuVariantRows, size}));
+        CORRADE_COMPARE_AS(actual, expected,
+            Corrade::TestSuite::Compare::Container);
+    }
+}
+
 void PackingBatchTest::unpackHalf() {
     /* Test data adapted from HalfTest */
     struct Data {
@@ -465,6 +677,108 @@ void PackingBatchTest::packHalf() {
         CORRADE_COMPARE(Math::packHalf(data[i].src), data[i].dst);
 }
 
+void PackingBatchTest::unpackHalfCpuVariant() {
+    auto&& data = HalfCpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    /* All possible half-float values, including denormals, infinities and
+       both quiet and signaling NaNs. Not a multiple of eight in order to
+       test the remainder as well. */
+    Corrade::Containers::Array<UnsignedShort> src{Corrade::NoInit, 65536 + 5};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = UnsignedShort(i);
+
+    Corrade::Containers::Array<Float> expected{Corrade::NoInit, src.size()};
+    Implementation::packingBatchCpuFeatures() = Corrade::Cpu::Scalar;
+    unpackHalfInto(Corrade::Containers::StridedArrayView2D<const UnsignedShort>{src, {src.size(), 1}},
+                   Corrade::Containers::StridedArrayView2D<Float>{expected, {expected.size(), 1}});
+
+    Corrade::Containers::Array<Float> actual{Corrade::NoInit, src.size()};
+    Implementation::packingBatchCpuFeatures() = data.features;
+    unpackHalfInto(Corrade::Containers::StridedArrayView2D<const UnsignedShort>{src, {src.size(), 1}},
+                   Corrade::Containers::StridedArrayView2D<Float>{actual, {actual.size(), 1}});
+
+    /* Comparing the bit representation to verify the NaN payloads as well */
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayCast<UnsignedInt>(actual),
+        Corrade::Containers::arrayCast<UnsignedInt>(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Strided rows of eight and three components, going through the SIMD
+       and the scalar code path */
+    for(std::size_t size: {8, 3}) {
+        CORRADE_ITERATION(size);
+        Corrade::Containers::Array<Float> actualStrided{Corrade::ValueInit, 16*9};
+        unpackHalfInto(
+            Corrade::Containers::StridedArrayView2D<const UnsignedShort>{src.prefix(16*9), {16, 9}}.prefix({16, size}),
+            Corrade::Containers::StridedArrayView2D<Float>{actualStrided, {16, 9}}.prefix({16, size}));
+        for(std::size_t i = 0; i != 16; ++i) for(std::size_t j = 0; j != size; ++j)
+            CORRADE_COMPARE(reinterpret_cast<UnsignedInt&>(actualStrided[i*9 + j]), reinterpret_cast<UnsignedInt&>(expected[i*9 + j]));
+    }
+}
+
+void PackingBatchTest::packHalfCpuVariant() {
+    auto&& data = HalfCpuVariantData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if((Corrade::Cpu::runtimeFeatures() & data.features) != data.features)
+        CORRADE_SKIP("CPU features" << data.features << "not supported");
+
+    /* Values where the rounding toward zero, denormal handling, overflow to
+       infinity or NaN payload truncation is observable, followed by a sweep
+       over the whole 32-bit range. The last value is repeated to not have
+       the size a multiple of eight. */
+    const UnsignedInt special[]{
+        0x00000000, 0x80000000, /* ±0 */
+        0x00000001, 0x807fffff, /* float denormals */
+        0x33000000, 0x337fffff, 0x33800000, 0xb3800001, /* around 2^-24 */
+        0x387fc000, 0x387fdfff, 0x387fe000, 0xb87fffff, /* around 2^-14 */
+        0x38800000, 0x38801fff, 0x38802000, 0xb8800001,
+        0x3f800fff, 0x3f801000, 0x3f801001, 0xbf801fff, /* around 1.0 */
+        0x477fe000, 0x477fefff, 0x477ff000, 0xc77fffff, /* around 65504 */
+        0x47800000, 0xc7800001, 0x4f000000, 0xff7fffff, /* overflow */
+        0x7f800000, 0xff800000, /* ±inf */
+        0x7f800001, 0x7f801fff, 0x7fa02000, 0xff800123, /* signaling NaN */
+        0x7fc00000, 0xffc00001, 0x7fffffff, 0xffffe000  /* quiet NaN */
+    };
+    constexpr std::size_t SweepStep = 4093;
+    constexpr std::size_t SweepSize = 0xffffffffull/SweepStep;
+    Corrade::Containers::Array<UnsignedInt> src{Corrade::NoInit, Corrade::Containers::arraySize(special) + SweepSize + 3};
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(special); ++i)
+        src[i] = special[i];
+    for(std::size_t i = 0; i != SweepSize; ++i)
+        src[Corrade::Containers::arraySize(special) + i] = UnsignedInt(i*SweepStep);
+    for(std::size_t i = src.size() - 3; i != src.size(); ++i)
+        src[i] = special[0];
+    const Corrade::Containers::ArrayView<const Float> srcFloat = Corrade::Containers::arrayCast<const Float>(src);
+
+    Corrade::Containers::Array<UnsignedShort> expected{Corrade::NoInit, src.size()};
+    Implementation::packingBatchCpuFeatures() = Corrade::Cpu::Scalar;
+    packHalfInto(Corrade::Containers::StridedArrayView2D<const Float>{srcFloat, {srcFloat.size(), 1}},
+                 Corrade::Containers::StridedArrayView2D<UnsignedShort>{expected, {expected.size(), 1}});
+
+    Corrade::Containers::Array<UnsignedShort> actual{Corrade::NoInit, src.size()};
+    Implementation::packingBatchCpuFeatures() = data.features;
+    packHalfInto(Corrade::Containers::StridedArrayView2D<const Float>{srcFloat, {srcFloat.size(), 1}},
+                 Corrade::Containers::StridedArrayView2D<UnsignedShort>{actual, {actual.size(), 1}});
+    CORRADE_COMPARE_AS(actual, expected,
+        Corrade::TestSuite::Compare::Container);
+
+    /* Strided rows of eight and three components, going through the SIMD
+       and the scalar code path */
+    for(std::size_t size: {8, 3}) {
+        CORRADE_ITERATION(size);
+        Corrade::Containers::Array<UnsignedShort> actualStrided{Corrade::ValueInit, 4*9};
+        packHalfInto(
+            Corrade::Containers::StridedArrayView2D<const Float>{srcFloat.prefix(4*9), {4, 9}}.prefix({4, size}),
+            Corrade::Containers::StridedArrayView2D<UnsignedShort>{actualStrided, {4, 9}}.prefix({4, size}));
+        for(std::size_t i = 0; i != 4; ++i) for(std::size_t j = 0; j != size; ++j)
+            CORRADE_COMPARE(actualStrided[i*9 + j], expected[i*9 + j]);
+    }
+}
+
 template<class FloatingPoint, class Integral> void PackingBatchTest::castUnsignedFloatingPoint() {
     setTestCaseTemplateName({TypeTraits<FloatingPoint>::name(), TypeTraits<Integral>::name()});
 
@@ -191,6 +191,7 @@ enum class MeshPrimitive: UnsignedInt {
      * Can be used to annotate @ref Trade::MeshData containing meshlet chunks,
      * i.e. groups of vertex references together with per-meshlet culling
      * information such as a bounding sphere or visibility cone.
+     * @see @ref MeshTools::generateMeshlets()
      */
     Meshlets
 };
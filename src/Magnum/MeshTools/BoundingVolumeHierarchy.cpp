@@ -0,0 +1,509 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/Threads.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Count of bins for evaluating the SAH along each axis */
+constexpr std::size_t BinCount = 16;
+
+/* Cost of traversing an inner node relative to intersecting a triangle */
+constexpr Float TraversalCost = 1.0f;
+
+/* Depth after which nodes are split at the object median instead of using
+   the SAH. Each median split halves the triangle count, which limits the
+   total depth to 32 + 32 levels and thus the size of the traversal stack. */
+constexpr UnsignedInt MaxSahDepth = 32;
+constexpr std::size_t TraversalStackSize = 64;
+
+/* Marks a node of the top-level tree that's a root of a subtree built on a
+   separate thread, with the node offset being the subtree index */
+constexpr UnsignedInt SubtreeMarker = ~UnsignedInt{};
+
+typedef BoundingVolumeHierarchy::Node Node;
+
+/* Half of the surface area, the constant factor doesn't matter for the SAH */
+inline Float halfArea(const Range3D& range) {
+    const Vector3 size = range.size();
+    return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+}
+
+inline Range3D emptyRange() {
+    return {Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+}
+
+inline void joinInPlace(Range3D& range, const Range3D& other) {
+    range.min() = Math::min(range.min(), other.min());
+    range.max() = Math::max(range.max(), other.max());
+}
+
+struct BuildState {
+    Containers::ArrayView<const Range3D> bounds;
+    Containers::ArrayView<const Vector3> centroids;
+    Containers::ArrayView<UnsignedInt> ids;
+    UnsignedInt maxLeafSize;
+};
+
+/* Calculates bounds of the triangles in given range and decides how to split
+   them. Returns the split position, with the triangles reordered so the
+   first child has triangles [begin, middle) and the second [middle, end).
+   If the triangles should become a leaf, returns begin. */
+UnsignedInt split(const BuildState& state, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, Range3D& bounds) {
+    bounds = emptyRange();
+    Range3D centroidBounds = emptyRange();
+    for(UnsignedInt i = begin; i != end; ++i) {
+        const UnsignedInt id = state.ids[i];
+        joinInPlace(bounds, state.bounds[id]);
+        centroidBounds.min() = Math::min(centroidBounds.min(), state.centroids[id]);
+        centroidBounds.max() = Math::max(centroidBounds.max(), state.centroids[id]);
+    }
+
+    const UnsignedInt count = end - begin;
+    if(count == 1) return begin;
+
+    const Vector3 centroidExtent = centroidBounds.size();
+    if(depth < MaxSahDepth && centroidExtent.max() > 0.0f) {
+        /* Put the triangles into bins along all three axes at once. Axes with
+           zero extent get everything into the first bin and are skipped when
+           evaluating the splits. */
+        UnsignedInt binCounts[3][BinCount]{};
+        Range3D binBounds[3][BinCount];
+        for(std::size_t axis = 0; axis != 3; ++axis)
+            for(std::size_t bin = 0; bin != BinCount; ++bin)
+                binBounds[axis][bin] = emptyRange();
+
+        const Vector3 binScale = Math::lerp(Vector3{0.0f}, Float(BinCount)/centroidExtent, centroidExtent > Vector3{0.0f});
+        for(UnsignedInt i = begin; i != end; ++i) {
+            const UnsignedInt id = state.ids[i];
+            const Vector3 bin = (state.centroids[id] - centroidBounds.min())*binScale;
+            for(std::size_t axis = 0; axis != 3; ++axis) {
+                const std::size_t b = Math::min(std::size_t(bin[axis]), BinCount - 1);
+                ++binCounts[axis][b];
+                joinInPlace(binBounds[axis][b], state.bounds[id]);
+            }
+        }
+
+        /* For each axis sweep from the right to get the cost of all possible
+           right sides, then from the left to get the total costs. The split
+           is before the bin with index splitBin. */
+        Float bestCost = Constants::inf();
+        std::size_t bestAxis = 0;
+        std::size_t bestBin = 0;
+        for(std::size_t axis = 0; axis != 3; ++axis) {
+            if(centroidExtent[axis] <= 0.0f) continue;
+
+            Float rightCosts[BinCount];
+            Range3D rightBounds = emptyRange();
+            UnsignedInt rightCount = 0;
+            for(std::size_t bin = BinCount - 1; bin != 0; --bin) {
+                joinInPlace(rightBounds, binBounds[axis][bin]);
+                rightCount += binCounts[axis][bin];
+                rightCosts[bin] = rightCount ? halfArea(rightBounds)*rightCount : 0.0f;
+            }
+
+            Range3D leftBounds = emptyRange();
+            UnsignedInt leftCount = 0;
+            for(std::size_t splitBin = 1; splitBin != BinCount; ++splitBin) {
+                joinInPlace(leftBounds, binBounds[axis][splitBin - 1]);
+                leftCount += binCounts[axis][splitBin - 1];
+                if(!leftCount || leftCount == count) continue;
+
+                const Float cost = halfArea(leftBounds)*leftCount + rightCosts[splitBin];
+                if(cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = splitBin;
+                }
+            }
+        }
+
+        /* The centroids span a non-zero extent along at least one axis, so
+           the first and the last bin of it are never empty and there's
+           always a valid split. The costs aren't divided by the area of the
+           parent to avoid issues with zero-area nodes. */
+        CORRADE_INTERNAL_ASSERT(bestBin);
+        const Float area = halfArea(bounds);
+        if(count <= state.maxLeafSize && area*count <= area*TraversalCost + bestCost)
+            return begin;
+
+        const Float splitPosition = centroidBounds.min()[bestAxis];
+        const Float splitScale = binScale[bestAxis];
+        UnsignedInt* const middle = std::partition(state.ids.data() + begin, state.ids.data() + end, [&](const UnsignedInt id) {
+            return Math::min(std::size_t((state.centroids[id][bestAxis] - splitPosition)*splitScale), BinCount - 1) < bestBin;
+        });
+        return middle - state.ids.data();
+    }
+
+    if(count <= state.maxLeafSize) return begin;
+
+    /* Either all centroids are the same or the max SAH depth was reached,
+       split at the object median along the longest axis */
+    const UnsignedInt middle = begin + count/2;
+    if(centroidExtent.max() > 0.0f) {
+        const std::size_t axis = centroidExtent[0] >= centroidExtent[1] && centroidExtent[0] >= centroidExtent[2] ? 0 : centroidExtent[1] >= centroidExtent[2] ? 1 : 2;
+        std::nth_element(state.ids.data() + begin, state.ids.data() + middle, state.ids.data() + end, [&](const UnsignedInt a, const UnsignedInt b) {
+            return state.centroids[a][axis] < state.centroids[b][axis];
+        });
+    }
+    return middle;
+}
+
+void buildSubtree(const BuildState& state, Containers::Array<Node>& nodes, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth) {
+    const std::size_t id = nodes.size();
+    arrayAppend(nodes, NoInit, 1);
+    const UnsignedInt middle = split(state, begin, end, depth, nodes[id].bounds);
+    if(middle == begin) {
+        nodes[id].offset = begin;
+        nodes[id].count = end - begin;
+        return;
+    }
+
+    nodes[id].count = 0;
+    buildSubtree(state, nodes, begin, middle, depth + 1);
+    nodes[id].offset = nodes.size();
+    buildSubtree(state, nodes, middle, end, depth + 1);
+}
+
+struct Subtree {
+    UnsignedInt begin, end, depth;
+};
+
+/* Same as buildSubtree(), but turns all nodes with at most subtreeSize
+   triangles into subtree markers, to be built later in parallel */
+void buildTopLevel(const BuildState& state, Containers::Array<Node>& nodes, Containers::Array<Subtree>& subtrees, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, const UnsignedInt subtreeSize) {
+    const std::size_t id = nodes.size();
+    arrayAppend(nodes, NoInit, 1);
+    if(end - begin <= subtreeSize) {
+        nodes[id].offset = subtrees.size();
+        nodes[id].count = SubtreeMarker;
+        arrayAppend(subtrees, Subtree{begin, end, depth});
+        return;
+    }
+
+    const UnsignedInt middle = split(state, begin, end, depth, nodes[id].bounds);
+    if(middle == begin) {
+        nodes[id].offset = begin;
+        nodes[id].count = end - begin;
+        return;
+    }
+
+    nodes[id].count = 0;
+    buildTopLevel(state, nodes, subtrees, begin, middle, depth + 1, subtreeSize);
+    nodes[id].offset = nodes.size();
+    buildTopLevel(state, nodes, subtrees, middle, end, depth + 1, subtreeSize);
+}
+
+/* Copies the top-level tree to the output, replacing subtree markers with the
+   actual subtrees and relocating their second child offsets */
+void assemble(const Containers::ArrayView<const Node> topLevelNodes, const Containers::ArrayView<const Containers::Array<Node>> subtreeNodes, Containers::Array<Node>& nodes, const std::size_t id) {
+    const Node& node = topLevelNodes[id];
+    if(node.count == SubtreeMarker) {
+        const UnsignedInt base = nodes.size();
+        for(const Node& subtreeNode: subtreeNodes[node.offset])
+            arrayAppend(nodes, Node{subtreeNode.bounds,
+                subtreeNode.count ? subtreeNode.offset : subtreeNode.offset + base,
+                subtreeNode.count});
+        return;
+    }
+
+    const std::size_t outputId = nodes.size();
+    arrayAppend(nodes, node);
+    if(node.count) return;
+
+    assemble(topLevelNodes, subtreeNodes, nodes, id + 1);
+    nodes[outputId].offset = nodes.size();
+    assemble(topLevelNodes, subtreeNodes, nodes, node.offset);
+}
+
+/* Returns distance at which the ray enters the box, or infinity if it misses
+   it or enters it only after maxDistance */
+inline Float rayRangeDistance(const Vector3& origin, const Vector3& inverseDirection, const Range3D& range, const Float maxDistance) {
+    const Vector3 t0 = (range.min() - origin)*inverseDirection;
+    const Vector3 t1 = (range.max() - origin)*inverseDirection;
+    const Float entry = Math::max(Math::min(t0, t1).max(), 0.0f);
+    const Float exit = Math::min(Math::max(t0, t1).min(), maxDistance);
+    return entry <= exit ? entry : Constants::inf();
+}
+
+/* Möller-Trumbore, without backface culling */
+inline bool rayTriangle(const Vector3& origin, const Vector3& direction, const Vector3* const triangle, const Float maxDistance, Float& distance, Vector2& barycentric) {
+    const Vector3 edge1 = triangle[1] - triangle[0];
+    const Vector3 edge2 = triangle[2] - triangle[0];
+    const Vector3 p = Math::cross(direction, edge2);
+    const Float determinant = Math::dot(edge1, p);
+    if(determinant == 0.0f) return false;
+
+    const Float inverseDeterminant = 1.0f/determinant;
+    const Vector3 s = origin - triangle[0];
+    const Float u = Math::dot(s, p)*inverseDeterminant;
+    if(u < 0.0f || u > 1.0f) return false;
+
+    const Vector3 q = Math::cross(s, edge1);
+    const Float v = Math::dot(direction, q)*inverseDeterminant;
+    if(v < 0.0f || u + v > 1.0f) return false;
+
+    const Float t = Math::dot(edge2, q)*inverseDeterminant;
+    if(t < 0.0f || t > maxDistance) return false;
+
+    distance = t;
+    barycentric = {u, v};
+    return true;
+}
+
+template<bool anyHit> bool traverse(const Containers::ArrayView<const Node> nodes, const Containers::ArrayView<const UnsignedInt> triangleIds, const Containers::ArrayView<const Vector3> triangles, const Vector3& origin, const Vector3& direction, Float maxDistance, BoundingVolumeHierarchy::Hit& hit) {
+    if(nodes.isEmpty()) return false;
+
+    const Vector3 inverseDirection = 1.0f/direction;
+    if(rayRangeDistance(origin, inverseDirection, nodes[0].bounds, maxDistance) == Constants::inf())
+        return false;
+
+    /* Nodes to visit next together with the distance at which the ray enters
+       them, so they can be skipped if a closer hit is found meanwhile */
+    UnsignedInt stack[TraversalStackSize];
+    Float stackDistances[TraversalStackSize];
+    std::size_t stackSize = 0;
+    std::size_t id = 0;
+    bool found = false;
+    for(;;) {
+        const Node& node = nodes[id];
+
+        /* Leaf node, intersect all its triangles */
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                Float distance;
+                Vector2 barycentric;
+                if(!rayTriangle(origin, direction, triangles.data() + 3*i, maxDistance, distance, barycentric))
+                    continue;
+
+                hit.triangleId = triangleIds[i];
+                hit.distance = distance;
+                hit.barycentric = barycentric;
+                if(anyHit) return true;
+                found = true;
+                maxDistance = distance;
+            }
+
+        /* Inner node, continue to the closer child and remember the other
+           one if it's hit as well */
+        } else {
+            std::size_t first = id + 1;
+            std::size_t second = node.offset;
+            Float firstDistance = rayRangeDistance(origin, inverseDirection, nodes[first].bounds, maxDistance);
+            Float secondDistance = rayRangeDistance(origin, inverseDirection, nodes[second].bounds, maxDistance);
+            if(secondDistance < firstDistance) {
+                std::swap(first, second);
+                std::swap(firstDistance, secondDistance);
+            }
+
+            if(firstDistance != Constants::inf()) {
+                if(secondDistance != Constants::inf()) {
+                    CORRADE_INTERNAL_ASSERT(stackSize < TraversalStackSize);
+                    stack[stackSize] = second;
+                    stackDistances[stackSize] = secondDistance;
+                    ++stackSize;
+                }
+                id = first;
+                continue;
+            }
+        }
+
+        /* Continue with the next remembered node that's not further than the
+           closest hit so far */
+        for(;;) {
+            if(!stackSize) return found;
+            --stackSize;
+            if(stackDistances[stackSize] <= maxDistance) {
+                id = stack[stackSize];
+                break;
+            }
+        }
+    }
+}
+
+template<class T> Containers::Array<Vector3> gatherTriangles(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::BoundingVolumeHierarchy: index count not divisible by 3", {});
+
+    Containers::Array<Vector3> triangles{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const T index = indices[i];
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::BoundingVolumeHierarchy: index" << index << "out of bounds for" << positions.size() << "elements", {});
+        triangles[i] = positions[index];
+    }
+
+    return triangles;
+}
+
+Containers::Array<Vector3> gatherTriangles(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::BoundingVolumeHierarchy: second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return gatherTriangles(Containers::arrayCast<1, const UnsignedInt>(indices), positions);
+    else if(indices.size()[1] == 2)
+        return gatherTriangles(Containers::arrayCast<1, const UnsignedShort>(indices), positions);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::BoundingVolumeHierarchy: expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return gatherTriangles(Containers::arrayCast<1, const UnsignedByte>(indices), positions);
+    }
+}
+
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    build(gatherTriangles(indices, positions), maxLeafSize, threadCount);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    build(gatherTriangles(indices, positions), maxLeafSize, threadCount);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    build(gatherTriangles(indices, positions), maxLeafSize, threadCount);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    build(gatherTriangles(indices, positions), maxLeafSize, threadCount);
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(const Trade::MeshData& mesh, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::BoundingVolumeHierarchy: expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(), );
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::BoundingVolumeHierarchy: mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), );
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::BoundingVolumeHierarchy: the mesh has no positions", );
+
+    Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    if(mesh.isIndexed())
+        build(gatherTriangles(mesh.indices(), positions), maxLeafSize, threadCount);
+    else {
+        CORRADE_ASSERT(positions.size() % 3 == 0,
+            "MeshTools::BoundingVolumeHierarchy: vertex count not divisible by 3", );
+        build(std::move(positions), maxLeafSize, threadCount);
+    }
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept = default;
+
+BoundingVolumeHierarchy::~BoundingVolumeHierarchy() = default;
+
+BoundingVolumeHierarchy& BoundingVolumeHierarchy::operator=(BoundingVolumeHierarchy&&) noexcept = default;
+
+void BoundingVolumeHierarchy::build(Containers::Array<Vector3>&& triangles, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(maxLeafSize,
+        "MeshTools::BoundingVolumeHierarchy: expected max leaf size to be at least 1", );
+
+    const UnsignedInt triangleCount = triangles.size()/3;
+    if(!triangleCount) return;
+
+    /* Calculate bounds and centroids of all triangles */
+    const std::size_t actualThreadCount = Implementation::threadCountFor(threadCount, triangleCount);
+    Containers::Array<Range3D> bounds{NoInit, triangleCount};
+    Containers::Array<Vector3> centroids{NoInit, triangleCount};
+    Containers::Array<UnsignedInt> ids{NoInit, triangleCount};
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t thread) {
+        const std::size_t begin = triangleCount*thread/actualThreadCount;
+        const std::size_t end = triangleCount*(thread + 1)/actualThreadCount;
+        for(std::size_t i = begin; i != end; ++i) {
+            const Vector3* const triangle = triangles.data() + 3*i;
+            bounds[i] = {Math::min(Math::min(triangle[0], triangle[1]), triangle[2]),
+                         Math::max(Math::max(triangle[0], triangle[1]), triangle[2])};
+            centroids[i] = bounds[i].center();
+            ids[i] = i;
+        }
+    });
+
+    const BuildState state{bounds, centroids, ids, maxLeafSize};
+    if(actualThreadCount == 1)
+        buildSubtree(state, _nodes, 0, triangleCount, 0);
+
+    /* Build the top levels on this thread, with enough subtrees below them
+       to have the threads load-balanced, then build the subtrees in parallel
+       and assemble them into the final node array */
+    else {
+        Containers::Array<Node> topLevelNodes;
+        Containers::Array<Subtree> subtrees;
+        buildTopLevel(state, topLevelNodes, subtrees, 0, triangleCount, 0, Math::max(triangleCount/UnsignedInt(8*actualThreadCount), maxLeafSize));
+
+        Containers::Array<Containers::Array<Node>> subtreeNodes{subtrees.size()};
+        std::atomic<std::size_t> nextSubtree{0};
+        Implementation::runOnThreads(actualThreadCount, [&](std::size_t) {
+            std::size_t i;
+            while((i = nextSubtree++) < subtrees.size())
+                buildSubtree(state, subtreeNodes[i], subtrees[i].begin, subtrees[i].end, subtrees[i].depth);
+        });
+
+        assemble(topLevelNodes, subtreeNodes, _nodes, 0);
+    }
+
+    /* Convert back to a default deleter to not waste memory with the growable
+       capacity */
+    arrayShrink(_nodes, DefaultInit);
+
+    /* Copy the triangles in leaf order */
+    _triangles = Containers::Array<Vector3>{NoInit, triangles.size()};
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t thread) {
+        const std::size_t begin = triangleCount*thread/actualThreadCount;
+        const std::size_t end = triangleCount*(thread + 1)/actualThreadCount;
+        for(std::size_t i = begin; i != end; ++i) {
+            _triangles[3*i + 0] = triangles[3*ids[i] + 0];
+            _triangles[3*i + 1] = triangles[3*ids[i] + 1];
+            _triangles[3*i + 2] = triangles[3*ids[i] + 2];
+        }
+    });
+    _triangleIds = std::move(ids);
+}
+
+Range3D BoundingVolumeHierarchy::bounds() const {
+    return _nodes.isEmpty() ? Range3D{} : _nodes[0].bounds;
+}
+
+Containers::Optional<BoundingVolumeHierarchy::Hit> BoundingVolumeHierarchy::closestHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    Hit hit;
+    if(!traverse<false>(_nodes, _triangleIds, _triangles, origin, direction, maxDistance, hit))
+        return {};
+    return hit;
+}
+
+bool BoundingVolumeHierarchy::anyHit(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    Hit hit;
+    return traverse<true>(_nodes, _triangleIds, _triangles, origin, direction, maxDistance, hit);
+}
+
+}}
@@ -0,0 +1,251 @@
+#ifndef Magnum_MeshTools_BoundingVolumeHierarchy_h
+#define Magnum_MeshTools_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::BoundingVolumeHierarchy
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Bounding volume hierarchy for ray queries on a triangle mesh
+@m_since_latest
+
+A binary tree of axis-aligned bounding boxes over mesh triangles, built using
+the surface area heuristic (SAH) evaluated on 16 bins per axis, as described
+in *Ingo Wald --- On fast Construction of SAH-based Bounding Volume
+Hierarchies, 2007*. Suitable for CPU ray queries such as picking or baking
+lighting, use @ref closestHit() to find the nearest intersected triangle and
+@ref anyHit() for occlusion tests.
+
+@section MeshTools-BoundingVolumeHierarchy-layout Memory layout
+
+The nodes are stored in a single flat array in a depth-first order, where the
+first child of an inner node directly follows it and the second child is at
+@ref Node::offset. Each @ref Node is 32 bytes, so two of them fit into a
+typical 64-byte cache line. Triangles of leaf nodes are stored in leaf order
+with their positions copied out of the original vertex data, so traversal
+doesn't need to access the index buffer and a leaf accesses a contiguous
+memory range. The class thus needs about 40 bytes per triangle plus the
+nodes, independently of the input index and vertex data, which don't need to
+be kept around after construction.
+
+@section MeshTools-BoundingVolumeHierarchy-multithreading Multithreaded construction
+
+If a thread count is passed to the constructor, the top levels of the tree
+are built on the calling thread, with subtrees below them built in parallel.
+The resulting tree is the same as when built on a single thread. At most one
+thread is used for every 16384 triangles, if there's not enough triangles or
+the platform doesn't support threads, the whole tree is built on the calling
+thread.
+*/
+class MAGNUM_MESHTOOLS_EXPORT BoundingVolumeHierarchy {
+    public:
+        /**
+         * @brief Hierarchy node
+         *
+         * @see @ref nodes()
+         */
+        struct Node {
+            /** @brief Bounds of all triangles in the subtree */
+            Range3D bounds;
+
+            /**
+             * @brief Offset
+             *
+             * If @ref count is @cpp 0 @ce, it's an inner node and the offset
+             * is the index of its second child in @ref nodes(). The first
+             * child is always directly after the node. Otherwise it's a leaf
+             * node and the offset is index of its first triangle in
+             * @ref triangleIds().
+             */
+            UnsignedInt offset;
+
+            /**
+             * @brief Triangle count
+             *
+             * Non-zero for leaf nodes, @cpp 0 @ce for inner nodes.
+             */
+            UnsignedInt count;
+        };
+
+        /**
+         * @brief Ray hit
+         *
+         * @see @ref closestHit()
+         */
+        struct Hit {
+            /** @brief Index of the hit triangle in the original mesh */
+            UnsignedInt triangleId;
+
+            /**
+             * @brief Hit distance
+             *
+             * In multiples of the ray direction length, i.e. the hit point is
+             * @cpp origin + direction*distance @ce.
+             */
+            Float distance;
+
+            /**
+             * @brief Barycentric coordinates of the hit point
+             *
+             * Weights of the second and third triangle vertex, weight of the
+             * first vertex is @cpp 1.0f - barycentric.sum() @ce.
+             */
+            Vector2 barycentric;
+        };
+
+        /**
+         * @brief Constructor
+         * @param indices       Triangle indices
+         * @param positions     Triangle vertex positions
+         * @param maxLeafSize   Max count of triangles in a leaf node
+         * @param threadCount   Count of threads to use. If @cpp 0 @ce, uses
+         *      @ref std::thread::hardware_concurrency().
+         *
+         * Expects that the index count is divisible by @cpp 3 @ce, all
+         * indices are less than size of @p positions and @p maxLeafSize is
+         * at least @cpp 1 @ce. See the
+         * @ref MeshTools-BoundingVolumeHierarchy-multithreading "class documentation"
+         * for details about multithreaded construction.
+         */
+        explicit BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+        /** @overload */
+        explicit BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+        /** @overload */
+        explicit BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Construct with type-erased indices
+         *
+         * Expects that the second dimension of @p indices is contiguous and
+         * represents the actual 1/2/4-byte index type. Based on its size
+         * then calls one of the
+         * @ref BoundingVolumeHierarchy(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+         * etc. overloads.
+         */
+        explicit BoundingVolumeHierarchy(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Construct from a mesh
+         *
+         * Expects that the mesh is a @ref MeshPrimitive::Triangles with a
+         * @ref Trade::MeshAttribute::Position, which is converted using
+         * @ref Trade::MeshData::positions3DAsArray(). If the mesh isn't
+         * indexed, each three consecutive vertices form a triangle. The mesh
+         * is also expected to not have an implementation-specific index
+         * type.
+         * @see @ref isMeshIndexTypeImplementationSpecific()
+         */
+        explicit BoundingVolumeHierarchy(const Trade::MeshData& mesh, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy(const BoundingVolumeHierarchy&) = delete;
+
+        /** @brief Move constructor */
+        BoundingVolumeHierarchy(BoundingVolumeHierarchy&&) noexcept;
+
+        ~BoundingVolumeHierarchy();
+
+        /** @brief Copying is not allowed */
+        BoundingVolumeHierarchy& operator=(const BoundingVolumeHierarchy&) = delete;
+
+        /** @brief Move assignment */
+        BoundingVolumeHierarchy& operator=(BoundingVolumeHierarchy&&) noexcept;
+
+        /**
+         * @brief Bounds of the whole mesh
+         *
+         * Same as bounds of the first node in @ref nodes(). If the mesh has
+         * no triangles, returns a default-constructed range.
+         */
+        Range3D bounds() const;
+
+        /**
+         * @brief Hierarchy nodes
+         *
+         * The first node is the root. If the mesh has no triangles, the
+         * array is empty. See the
+         * @ref MeshTools-BoundingVolumeHierarchy-layout "class documentation"
+         * for details about the layout.
+         */
+        Containers::ArrayView<const Node> nodes() const { return _nodes; }
+
+        /**
+         * @brief Triangle IDs in leaf order
+         *
+         * Maps triangles referenced by leaf nodes to triangle indices in the
+         * original mesh.
+         */
+        Containers::ArrayView<const UnsignedInt> triangleIds() const { return _triangleIds; }
+
+        /**
+         * @brief Find the closest hit along a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance in multiples of @p direction
+         *      length
+         *
+         * Triangles are intersected from both sides using the
+         * *Möller--Trumbore* algorithm. Returns
+         * @relativeref{Corrade,Containers::NullOpt} if no triangle is hit
+         * at a distance in range @f$ [0, d_{max}] @f$.
+         * @see @ref anyHit()
+         */
+        Containers::Optional<Hit> closestHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Whether any triangle is hit along a ray
+         *
+         * Same as @ref closestHit(), but returns as soon as any hit is
+         * found, which makes it faster for occlusion tests.
+         */
+        bool anyHit(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+    private:
+        void build(Containers::Array<Vector3>&& triangles, UnsignedInt maxLeafSize, UnsignedInt threadCount);
+
+        Containers::Array<Node> _nodes;
+        Containers::Array<UnsignedInt> _triangleIds;
+        /* Three positions for each triangle, in leaf order */
+        Containers::Array<Vector3> _triangles;
+};
+
+}}
+
+#endif
@@ -0,0 +1,670 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EncodeMesh.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Size of the edge FIFO. Has to be a power of two and at most 16 in order to
+   fit into the upper four bits of the code byte. */
+constexpr std::size_t EdgeFifoSize = 16;
+
+/* Triangle code byte layout. If the lowest two bits are 0, 1 or 2, the
+   triangle shares an edge with a FIFO entry. The value is then a rotation of
+   the triangle such that the shared edge is its first two vertices, bit 2 is
+   set if the remaining vertex is encoded explicitly and the upper four bits
+   are the FIFO entry index, 0 being the most recently added one. If the
+   lowest two bits are 3, the triangle doesn't share any edge and bits 2, 3
+   and 4 are set if the first, second and third vertex is encoded explicitly.
+   Vertices not encoded explicitly are implicitly the next not-yet-referenced
+   vertex. */
+constexpr UnsignedByte CodeNoEdge = 3;
+constexpr UnsignedByte CodeExplicit = 1 << 2;
+
+struct Edge {
+    UnsignedInt a, b;
+};
+
+inline UnsignedInt zigZagEncode(const UnsignedInt value) {
+    return (value << 1) ^ (0u - (value >> 31));
+}
+
+inline UnsignedInt zigZagDecode(const UnsignedInt value) {
+    return (value >> 1) ^ (0u - (value & 1));
+}
+
+void writeVarint(Containers::Array<char>& out, UnsignedInt value) {
+    while(value >= 0x80) {
+        arrayAppend(out, char((value & 0x7f)|0x80));
+        value >>= 7;
+    }
+    arrayAppend(out, char(value));
+}
+
+bool readVarint(const char*& data, const char* const end, UnsignedInt& value) {
+    value = 0;
+    for(UnsignedInt shift = 0; shift < 32; shift += 7) {
+        if(data == end) return false;
+        const UnsignedByte byte = *data++;
+        value |= UnsignedInt(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+
+    /* More than five bytes */
+    return false;
+}
+
+template<class T> Containers::Array<char> encodeTriangleIndicesImplementation(const Containers::StridedArrayView1D<const T>& indices) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::encodeTriangleIndices(): index count not divisible by 3", {});
+
+    /* Code bytes first, variable-length data appended after */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<char> out;
+    arrayResize(out, NoInit, triangleCount);
+
+    Edge fifo[EdgeFifoSize]{};
+    std::size_t fifoOffset = 0;
+    UnsignedInt next = 0;
+    UnsignedInt last = 0;
+    /* Returns true if the vertex had to be encoded explicitly */
+    const auto encodeVertex = [&](const UnsignedInt vertex) {
+        if(vertex == next) {
+            ++next;
+            return false;
+        }
+
+        writeVarint(out, zigZagEncode(vertex - last));
+        last = vertex;
+        return true;
+    };
+
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedInt a = indices[i*3 + 0];
+        const UnsignedInt b = indices[i*3 + 1];
+        const UnsignedInt c = indices[i*3 + 2];
+        const UnsignedInt rotated[]{a, b, c, a, b};
+
+        UnsignedByte code = CodeNoEdge;
+        for(std::size_t j = 0; j != EdgeFifoSize && code == CodeNoEdge; ++j) {
+            const Edge& edge = fifo[(fifoOffset - 1 - j) & (EdgeFifoSize - 1)];
+            for(UnsignedByte rotation = 0; rotation != 3; ++rotation) {
+                if(edge.a != rotated[rotation] || edge.b != rotated[rotation + 1])
+                    continue;
+
+                code = UnsignedByte(j << 4)|rotation;
+                if(encodeVertex(rotated[rotation + 2]))
+                    code |= CodeExplicit;
+                break;
+            }
+        }
+
+        if(code == CodeNoEdge) {
+            if(encodeVertex(a)) code |= CodeExplicit << 0;
+            if(encodeVertex(b)) code |= CodeExplicit << 1;
+            if(encodeVertex(c)) code |= CodeExplicit << 2;
+        }
+
+        out[i] = code;
+
+        /* Adjacent triangles with the same winding have the shared edge in
+           the opposite direction */
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {b, a};
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {c, b};
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {a, c};
+    }
+
+    /* Convert back to a default deleter to make the array usable in
+       MeshData */
+    arrayShrink(out, DefaultInit);
+    return out;
+}
+
+template<class T> bool decodeTriangleIndices(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<T>& indices) {
+    const std::size_t triangleCount = indices.size()/3;
+    if(data.size() < triangleCount) return false;
+
+    const char* extra = data.data() + triangleCount;
+    const char* const end = data.end();
+    Edge fifo[EdgeFifoSize]{};
+    std::size_t fifoOffset = 0;
+    UnsignedInt next = 0;
+    UnsignedInt last = 0;
+    const auto decodeVertex = [&](const bool isExplicit, UnsignedInt& vertex) {
+        if(!isExplicit) {
+            vertex = next++;
+            return true;
+        }
+
+        UnsignedInt delta;
+        if(!readVarint(extra, end, delta)) return false;
+        vertex = last += zigZagDecode(delta);
+        return true;
+    };
+
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedByte code = data[i];
+        const UnsignedByte rotation = code & 0x03;
+        UnsignedInt a, b, c;
+        if(rotation != CodeNoEdge) {
+            if(code & 0x08) return false;
+
+            const Edge& edge = fifo[(fifoOffset - 1 - (code >> 4)) & (EdgeFifoSize - 1)];
+            UnsignedInt remaining;
+            if(!decodeVertex(code & CodeExplicit, remaining)) return false;
+            if(rotation == 0) {
+                a = edge.a;
+                b = edge.b;
+                c = remaining;
+            } else if(rotation == 1) {
+                b = edge.a;
+                c = edge.b;
+                a = remaining;
+            } else {
+                c = edge.a;
+                a = edge.b;
+                b = remaining;
+            }
+        } else {
+            if(code >> 5) return false;
+
+            if(!decodeVertex(code & (CodeExplicit << 0), a) ||
+               !decodeVertex(code & (CodeExplicit << 1), b) ||
+               !decodeVertex(code & (CodeExplicit << 2), c))
+                return false;
+        }
+
+        indices[i*3 + 0] = T(a);
+        indices[i*3 + 1] = T(b);
+        indices[i*3 + 2] = T(c);
+
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {b, a};
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {c, b};
+        fifo[fifoOffset++ & (EdgeFifoSize - 1)] = {a, c};
+    }
+
+    /* All data should be consumed */
+    return extra == end;
+}
+
+template<class T> bool decodeTriangleIndicesIntoImplementation(const Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<T>& indices) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::decodeTriangleIndicesInto(): index count not divisible by 3", {});
+
+    if(!decodeTriangleIndices({static_cast<const char*>(data.data()), data.size()}, indices)) {
+        Error{} << "MeshTools::decodeTriangleIndicesInto(): invalid data";
+        return false;
+    }
+
+    return true;
+}
+
+/* The output is split into byte planes, each having vertexCount bytes. The
+   vertex-major iteration order is the same in the encoder and decoder, which
+   touches the vertex data only once. */
+template<class T> void encodeVertexStreamImplementation(const Containers::StridedArrayView2D<const char>& data, char* const out) {
+    const std::size_t vertexCount = data.size()[0];
+    const std::size_t componentCount = data.size()[1]/sizeof(T);
+    Containers::Array<T> previous{ValueInit, componentCount};
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        const char* const vertex = static_cast<const char*>(data.data()) + std::ptrdiff_t(i)*data.stride()[0];
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            T value;
+            std::memcpy(&value, vertex + j*sizeof(T), sizeof(T));
+            const T delta = T(value - previous[j]);
+            previous[j] = value;
+
+            const T zigZag = T(T(delta << 1) ^ T(T(0) - T(delta >> (sizeof(T)*8 - 1))));
+            char* const planes = out + j*sizeof(T)*vertexCount + i;
+            for(std::size_t k = 0; k != sizeof(T); ++k)
+                planes[k*vertexCount] = char(zigZag >> k*8);
+        }
+    }
+}
+
+template<class T> void decodeVertexStreamImplementation(const char* const data, const Containers::StridedArrayView2D<char>& vertices) {
+    const std::size_t vertexCount = vertices.size()[0];
+    const std::size_t componentCount = vertices.size()[1]/sizeof(T);
+    Containers::Array<T> previous{ValueInit, componentCount};
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        char* const vertex = static_cast<char*>(vertices.data()) + std::ptrdiff_t(i)*vertices.stride()[0];
+        for(std::size_t j = 0; j != componentCount; ++j) {
+            const UnsignedByte* const planes = reinterpret_cast<const UnsignedByte*>(data) + j*sizeof(T)*vertexCount + i;
+            T zigZag = 0;
+            for(std::size_t k = 0; k != sizeof(T); ++k)
+                zigZag |= T(T(planes[k*vertexCount]) << k*8);
+
+            previous[j] = T(previous[j] + T(T(zigZag >> 1) ^ T(T(0) - T(zigZag & 1))));
+            std::memcpy(vertex + j*sizeof(T), &previous[j], sizeof(T));
+        }
+    }
+}
+
+void encodeVertexStreamIntoImplementation(const Containers::StridedArrayView2D<const char>& data, const UnsignedInt componentSize, char* const out) {
+    if(componentSize == 1)
+        encodeVertexStreamImplementation<UnsignedByte>(data, out);
+    else if(componentSize == 2)
+        encodeVertexStreamImplementation<UnsignedShort>(data, out);
+    else if(componentSize == 4)
+        encodeVertexStreamImplementation<UnsignedInt>(data, out);
+    else if(componentSize == 8)
+        encodeVertexStreamImplementation<UnsignedLong>(data, out);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+void decodeVertexStreamIntoImplementation(const char* const data, const Containers::StridedArrayView2D<char>& vertices, const UnsignedInt componentSize) {
+    if(componentSize == 1)
+        decodeVertexStreamImplementation<UnsignedByte>(data, vertices);
+    else if(componentSize == 2)
+        decodeVertexStreamImplementation<UnsignedShort>(data, vertices);
+    else if(componentSize == 4)
+        decodeVertexStreamImplementation<UnsignedInt>(data, vertices);
+    else if(componentSize == 8)
+        decodeVertexStreamImplementation<UnsignedLong>(data, vertices);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* All fields are naturally aligned, padding is explicit so it gets
+   zero-initialized as well */
+struct MeshHeader {
+    char signature[4];
+    UnsignedByte version;
+    UnsignedByte bigEndian;
+    UnsignedByte indexEncoding;
+    UnsignedByte padding0;
+    UnsignedInt primitive;
+    UnsignedInt indexType;
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    UnsignedInt padding1;
+    UnsignedLong indexDataSize;
+};
+
+static_assert(sizeof(MeshHeader) == 40, "unexpected MeshHeader size");
+
+struct MeshAttributeHeader {
+    UnsignedShort name;
+    UnsignedShort arraySize;
+    UnsignedInt format;
+    UnsignedLong dataSize;
+};
+
+static_assert(sizeof(MeshAttributeHeader) == 16, "unexpected MeshAttributeHeader size");
+
+constexpr char Signature[]{'M', 'M', 'C', 'D'};
+constexpr UnsignedByte Version = 1;
+
+enum: UnsignedByte {
+    IndexEncodingNone = 0,
+    IndexEncodingTriangles = 1,
+    IndexEncodingStream = 2
+};
+
+}
+
+Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    return encodeTriangleIndicesImplementation(indices);
+}
+
+Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedShort>& indices) {
+    return encodeTriangleIndicesImplementation(indices);
+}
+
+Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedByte>& indices) {
+    return encodeTriangleIndicesImplementation(indices);
+}
+
+Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView2D<const char>& indices) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::encodeTriangleIndices(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return encodeTriangleIndicesImplementation(Containers::arrayCast<1, const UnsignedInt>(indices));
+    else if(indices.size()[1] == 2)
+        return encodeTriangleIndicesImplementation(Containers::arrayCast<1, const UnsignedShort>(indices));
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::encodeTriangleIndices(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return encodeTriangleIndicesImplementation(Containers::arrayCast<1, const UnsignedByte>(indices));
+    }
+}
+
+bool decodeTriangleIndicesInto(const Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    return decodeTriangleIndicesIntoImplementation(data, indices);
+}
+
+bool decodeTriangleIndicesInto(const Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedShort>& indices) {
+    return decodeTriangleIndicesIntoImplementation(data, indices);
+}
+
+bool decodeTriangleIndicesInto(const Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedByte>& indices) {
+    return decodeTriangleIndicesIntoImplementation(data, indices);
+}
+
+bool decodeTriangleIndicesInto(const Containers::ArrayView<const void> data, const Containers::StridedArrayView2D<char>& indices) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::decodeTriangleIndicesInto(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return decodeTriangleIndicesIntoImplementation(data, Containers::arrayCast<1, UnsignedInt>(indices));
+    else if(indices.size()[1] == 2)
+        return decodeTriangleIndicesIntoImplementation(data, Containers::arrayCast<1, UnsignedShort>(indices));
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::decodeTriangleIndicesInto(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return decodeTriangleIndicesIntoImplementation(data, Containers::arrayCast<1, UnsignedByte>(indices));
+    }
+}
+
+Containers::Array<char> encodeVertexStream(const Containers::StridedArrayView2D<const char>& data, const UnsignedInt componentSize) {
+    CORRADE_ASSERT(data.isContiguous<1>(),
+        "MeshTools::encodeVertexStream(): second view dimension is not contiguous", {});
+    CORRADE_ASSERT(componentSize == 1 || componentSize == 2 || componentSize == 4 || componentSize == 8,
+        "MeshTools::encodeVertexStream(): expected component size 1, 2, 4 or 8 but got" << componentSize, {});
+    CORRADE_ASSERT(data.size()[1] % componentSize == 0,
+        "MeshTools::encodeVertexStream(): vertex size" << data.size()[1] << "not divisible by component size" << componentSize, {});
+
+    Containers::Array<char> out{NoInit, data.size()[0]*data.size()[1]};
+    encodeVertexStreamIntoImplementation(data, componentSize, out);
+    return out;
+}
+
+bool decodeVertexStreamInto(const Containers::ArrayView<const void> data, const Containers::StridedArrayView2D<char>& vertices, const UnsignedInt componentSize) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "MeshTools::decodeVertexStreamInto(): second view dimension is not contiguous", {});
+    CORRADE_ASSERT(componentSize == 1 || componentSize == 2 || componentSize == 4 || componentSize == 8,
+        "MeshTools::decodeVertexStreamInto(): expected component size 1, 2, 4 or 8 but got" << componentSize, {});
+    CORRADE_ASSERT(vertices.size()[1] % componentSize == 0,
+        "MeshTools::decodeVertexStreamInto(): vertex size" << vertices.size()[1] << "not divisible by component size" << componentSize, {});
+
+    if(data.size() != vertices.size()[0]*vertices.size()[1]) {
+        Error{} << "MeshTools::decodeVertexStreamInto(): expected" << vertices.size()[0]*vertices.size()[1] << "bytes but got" << data.size();
+        return false;
+    }
+
+    decodeVertexStreamIntoImplementation(static_cast<const char*>(data.data()), vertices, componentSize);
+    return true;
+}
+
+Containers::Array<char> encodeMesh(const Trade::MeshData& mesh) {
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::encodeMesh(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), {});
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::encodeMesh(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)), {});
+    }
+    #endif
+
+    MeshHeader header{};
+    std::memcpy(header.signature, Signature, sizeof(Signature));
+    header.version = Version;
+    header.bigEndian = Utility::Endianness::isBigEndian();
+    header.primitive = UnsignedInt(mesh.primitive());
+    header.vertexCount = mesh.vertexCount();
+    header.attributeCount = mesh.attributeCount();
+
+    /* Triangle index encoding produces data of unknown size, so it's done
+       upfront. Stream encoding has the same size as the input and is done
+       directly into the output. */
+    Containers::Array<char> triangleIndexData;
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        if(mesh.primitive() == MeshPrimitive::Triangles && !(mesh.indexCount() % 3)) {
+            header.indexEncoding = IndexEncodingTriangles;
+            triangleIndexData = encodeTriangleIndices(mesh.indices());
+            header.indexDataSize = triangleIndexData.size();
+        } else {
+            header.indexEncoding = IndexEncodingStream;
+            header.indexDataSize = mesh.indexCount()*meshIndexTypeSize(mesh.indexType());
+        }
+    } else header.indexEncoding = IndexEncodingNone;
+
+    std::size_t size = sizeof(MeshHeader) + mesh.attributeCount()*sizeof(MeshAttributeHeader) + header.indexDataSize;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        size += mesh.vertexCount()*mesh.attribute(i).size()[1];
+
+    Containers::Array<char> out{NoInit, size};
+    std::memcpy(out, &header, sizeof(MeshHeader));
+    std::size_t offset = sizeof(MeshHeader);
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        MeshAttributeHeader attributeHeader{};
+        attributeHeader.name = UnsignedShort(mesh.attributeName(i));
+        attributeHeader.arraySize = mesh.attributeArraySize(i);
+        attributeHeader.format = UnsignedInt(mesh.attributeFormat(i));
+        attributeHeader.dataSize = mesh.vertexCount()*mesh.attribute(i).size()[1];
+        std::memcpy(out.data() + offset, &attributeHeader, sizeof(MeshAttributeHeader));
+        offset += sizeof(MeshAttributeHeader);
+    }
+
+    if(header.indexEncoding == IndexEncodingTriangles)
+        Utility::copy(triangleIndexData, out.slice(offset, offset + header.indexDataSize));
+    else if(header.indexEncoding == IndexEncodingStream)
+        encodeVertexStreamIntoImplementation(mesh.indices(), meshIndexTypeSize(mesh.indexType()), out.data() + offset);
+    offset += header.indexDataSize;
+
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Containers::StridedArrayView2D<const char> attribute = mesh.attribute(i);
+        encodeVertexStreamIntoImplementation(attribute, vertexFormatSize(vertexFormatComponentFormat(mesh.attributeFormat(i))), out.data() + offset);
+        offset += attribute.size()[0]*attribute.size()[1];
+    }
+
+    CORRADE_INTERNAL_ASSERT(offset == out.size());
+    return out;
+}
+
+Containers::Optional<Trade::MeshData> decodeMesh(const Containers::ArrayView<const void> data) {
+    const Containers::ArrayView<const char> bytes{static_cast<const char*>(data.data()), data.size()};
+    if(bytes.size() < sizeof(MeshHeader)) {
+        Error{} << "MeshTools::decodeMesh(): expected at least" << sizeof(MeshHeader) << "bytes for a header but got" << bytes.size();
+        return {};
+    }
+
+    MeshHeader header;
+    std::memcpy(&header, bytes, sizeof(MeshHeader));
+    if(std::memcmp(header.signature, Signature, sizeof(Signature)) != 0) {
+        Error{} << "MeshTools::decodeMesh(): invalid signature";
+        return {};
+    }
+    if(header.version != Version) {
+        Error{} << "MeshTools::decodeMesh(): unsupported version" << header.version;
+        return {};
+    }
+    if(bool(header.bigEndian) != Utility::Endianness::isBigEndian()) {
+        Error{} << "MeshTools::decodeMesh(): data encoded on a" << (header.bigEndian ? "big-endian" : "little-endian") << "platform";
+        return {};
+    }
+    /* The check for the last known primitive has to be updated when new
+       primitives are added */
+    const MeshPrimitive primitive = MeshPrimitive(header.primitive);
+    if(!isMeshPrimitiveImplementationSpecific(primitive) && (!header.primitive || header.primitive > UnsignedInt(MeshPrimitive::Meshlets))) {
+        Error{} << "MeshTools::decodeMesh(): invalid primitive" << primitive;
+        return {};
+    }
+    if(header.indexEncoding > IndexEncodingStream) {
+        Error{} << "MeshTools::decodeMesh(): invalid index encoding" << header.indexEncoding;
+        return {};
+    }
+    if(header.indexEncoding == IndexEncodingNone && header.indexDataSize) {
+        Error{} << "MeshTools::decodeMesh(): expected no index data for a non-indexed mesh but got" << header.indexDataSize << "bytes";
+        return {};
+    }
+    if(header.indexEncoding != IndexEncodingNone && (header.indexType < UnsignedInt(MeshIndexType::UnsignedByte) || header.indexType > UnsignedInt(MeshIndexType::UnsignedInt))) {
+        Error{} << "MeshTools::decodeMesh(): invalid index type" << header.indexType;
+        return {};
+    }
+    if(header.indexEncoding == IndexEncodingTriangles && header.indexCount % 3) {
+        Error{} << "MeshTools::decodeMesh(): triangle index count" << header.indexCount << "not divisible by 3";
+        return {};
+    }
+    /* There's one code byte per triangle, check that upfront to not allocate
+       the output for a huge index count only to discover the data are too
+       short */
+    if(header.indexEncoding == IndexEncodingTriangles && header.indexDataSize < header.indexCount/3) {
+        Error{} << "MeshTools::decodeMesh(): expected at least" << header.indexCount/3 << "bytes of index data for" << header.indexCount/3 << "triangles but got" << header.indexDataSize;
+        return {};
+    }
+    if(header.indexEncoding == IndexEncodingStream && header.indexDataSize != UnsignedLong(header.indexCount)*meshIndexTypeSize(MeshIndexType(header.indexType))) {
+        Error{} << "MeshTools::decodeMesh(): expected" << UnsignedLong(header.indexCount)*meshIndexTypeSize(MeshIndexType(header.indexType)) << "bytes of index data but got" << header.indexDataSize;
+        return {};
+    }
+
+    /* Comparing the count instead of the total size to avoid an overflow on
+       32-bit platforms */
+    if(header.attributeCount > (bytes.size() - sizeof(MeshHeader))/sizeof(MeshAttributeHeader)) {
+        Error{} << "MeshTools::decodeMesh(): expected at least" << sizeof(MeshHeader) + UnsignedLong(header.attributeCount)*sizeof(MeshAttributeHeader) << "bytes for" << header.attributeCount << "attribute headers but got" << bytes.size();
+        return {};
+    }
+    const std::size_t attributeHeaderEnd = sizeof(MeshHeader) + std::size_t(header.attributeCount)*sizeof(MeshAttributeHeader);
+
+    /* Validate the attribute headers together with calculating the stride of
+       a tightly packed interleaved layout. Each data size is checked against
+       the remaining bytes instead of being added to a total, as the sizes
+       come from the file and the sum could overflow. */
+    std::size_t remaining = bytes.size() - attributeHeaderEnd;
+    if(header.indexDataSize > remaining) {
+        Error{} << "MeshTools::decodeMesh(): index data size" << header.indexDataSize << "out of range for" << remaining << "bytes";
+        return {};
+    }
+    remaining -= header.indexDataSize;
+
+    Containers::Array<MeshAttributeHeader> attributeHeaders{NoInit, header.attributeCount};
+    Utility::copy(bytes.slice(sizeof(MeshHeader), attributeHeaderEnd), Containers::arrayCast<char>(attributeHeaders));
+    std::size_t stride = 0;
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const MeshAttributeHeader& attributeHeader = attributeHeaders[i];
+        const Trade::MeshAttribute name = Trade::MeshAttribute(attributeHeader.name);
+        const VertexFormat format = VertexFormat(attributeHeader.format);
+
+        /* Zero and implementation-specific formats are invalid. The check for
+           the last known format has to be updated when new formats are
+           added. */
+        if(attributeHeader.format - 1 >= UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned) ||
+           !Trade::Implementation::isVertexFormatCompatibleWithAttribute(name, format) ||
+           (attributeHeader.arraySize && !Trade::Implementation::isAttributeArrayAllowed(name)) ||
+           (!attributeHeader.arraySize && Trade::Implementation::isAttributeArrayExpected(name))) {
+            Error{} << "MeshTools::decodeMesh(): invalid attribute" << i << "properties";
+            return {};
+        }
+
+        if(attributeHeader.dataSize > remaining) {
+            Error{} << "MeshTools::decodeMesh(): attribute" << i << "data size" << attributeHeader.dataSize << "out of range for" << remaining << "bytes";
+            return {};
+        }
+
+        const std::size_t attributeSize = vertexFormatSize(format)*(attributeHeader.arraySize ? attributeHeader.arraySize : 1);
+        if(attributeHeader.dataSize != UnsignedLong(header.vertexCount)*attributeSize) {
+            Error{} << "MeshTools::decodeMesh(): expected" << UnsignedLong(header.vertexCount)*attributeSize << "bytes of data for attribute" << i << "but got" << attributeHeader.dataSize;
+            return {};
+        }
+
+        stride += attributeSize;
+        remaining -= attributeHeader.dataSize;
+    }
+
+    if(remaining) {
+        Error{} << "MeshTools::decodeMesh(): expected" << bytes.size() - remaining << "bytes but got" << bytes.size();
+        return {};
+    }
+
+    std::size_t offset = attributeHeaderEnd;
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(header.indexEncoding != IndexEncodingNone) {
+        const MeshIndexType indexType = MeshIndexType(header.indexType);
+        const UnsignedInt indexTypeSize = meshIndexTypeSize(indexType);
+        indexData = Containers::Array<char>{NoInit, std::size_t(header.indexCount)*indexTypeSize};
+        const Containers::StridedArrayView2D<char> indexView{indexData, {header.indexCount, indexTypeSize}};
+        const Containers::ArrayView<const char> encodedIndexData = bytes.slice(offset, offset + header.indexDataSize);
+        if(header.indexEncoding == IndexEncodingTriangles) {
+            bool decoded;
+            if(indexType == MeshIndexType::UnsignedInt)
+                decoded = decodeTriangleIndices(encodedIndexData, Containers::arrayCast<1, UnsignedInt>(indexView));
+            else if(indexType == MeshIndexType::UnsignedShort)
+                decoded = decodeTriangleIndices(encodedIndexData, Containers::arrayCast<1, UnsignedShort>(indexView));
+            else
+                decoded = decodeTriangleIndices(encodedIndexData, Containers::arrayCast<1, UnsignedByte>(indexView));
+            if(!decoded) {
+                Error{} << "MeshTools::decodeMesh(): invalid index data";
+                return {};
+            }
+        } else decodeVertexStreamIntoImplementation(encodedIndexData.data(), indexView, indexTypeSize);
+
+        /* Neither of the encodings guarantees the indices are in range, and
+           MeshData doesn't check that either */
+        UnsignedInt maxIndex;
+        if(indexType == MeshIndexType::UnsignedInt)
+            maxIndex = Math::max(Containers::arrayCast<1, UnsignedInt>(indexView));
+        else if(indexType == MeshIndexType::UnsignedShort)
+            maxIndex = Math::max(Containers::arrayCast<1, UnsignedShort>(indexView));
+        else
+            maxIndex = Math::max(Containers::arrayCast<1, UnsignedByte>(indexView));
+        if(header.indexCount && maxIndex >= header.vertexCount) {
+            Error{} << "MeshTools::decodeMesh(): index" << maxIndex << "out of range for" << header.vertexCount << "vertices";
+            return {};
+        }
+
+        indices = Trade::MeshIndexData{indexType, Containers::StridedArrayView1D<const void>{indexData, header.indexCount, std::ptrdiff_t(indexTypeSize)}};
+        offset += header.indexDataSize;
+    }
+
+    /* Vertex stream decoding can't fail, so the attributes can be decoded
+       directly into the output without any further checks */
+    Containers::Array<char> vertexData{NoInit, header.vertexCount*stride};
+    Containers::Array<Trade::MeshAttributeData> attributes{header.attributeCount};
+    std::size_t attributeOffset = 0;
+    for(UnsignedInt i = 0; i != header.attributeCount; ++i) {
+        const MeshAttributeHeader& attributeHeader = attributeHeaders[i];
+        const VertexFormat format = VertexFormat(attributeHeader.format);
+        const std::size_t attributeSize = attributeHeader.dataSize/(header.vertexCount ? header.vertexCount : 1);
+        attributes[i] = Trade::MeshAttributeData{Trade::MeshAttribute(attributeHeader.name), format, attributeOffset, header.vertexCount, std::ptrdiff_t(stride), attributeHeader.arraySize};
+
+        const Containers::StridedArrayView2D<char> attributeView{vertexData,
+            vertexData.data() + attributeOffset,
+            {header.vertexCount, attributeSize},
+            {std::ptrdiff_t(stride), 1}};
+        decodeVertexStreamIntoImplementation(bytes.data() + offset, attributeView, vertexFormatSize(vertexFormatComponentFormat(format)));
+        offset += attributeHeader.dataSize;
+        attributeOffset += attributeSize;
+    }
+
+    if(header.indexEncoding == IndexEncodingNone)
+        return Trade::MeshData{primitive, std::move(vertexData), std::move(attributes), header.vertexCount};
+    return Trade::MeshData{primitive, std::move(indexData), indices, std::move(vertexData), std::move(attributes), header.vertexCount};
+}
+
+}}
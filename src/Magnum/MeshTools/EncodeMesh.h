@@ -0,0 +1,216 @@
+#ifndef Magnum_MeshTools_EncodeMesh_h
+#define Magnum_MeshTools_EncodeMesh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::encodeTriangleIndices(), @ref Magnum::MeshTools::decodeTriangleIndicesInto(), @ref Magnum::MeshTools::encodeVertexStream(), @ref Magnum::MeshTools::decodeVertexStreamInto(), @ref Magnum::MeshTools::encodeMesh(), @ref Magnum::MeshTools::decodeMesh()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Encode a triangle index buffer
+@param indices  Triangle indices
+@m_since_latest
+
+Each triangle is encoded as a single code byte, optionally followed by
+variable-length index deltas. The encoder keeps a FIFO of the last 16 edges
+and if a triangle shares an edge with one of them, which is the common case
+for adjacent triangles, only the position of the edge in the FIFO and the
+remaining vertex is encoded. Vertices that were not referenced before and
+come in order are encoded implicitly, other vertices are encoded as a
+zig-zag-encoded difference from the last explicitly encoded vertex. All code
+bytes are put first, followed by the variable-length data, which makes the
+output well compressible with general-purpose compressors such as zstd or
+gzip.
+
+The encoding works best on meshes optimized with @ref tipsify() and
+@ref reorderForVertexFetch(), where a triangle usually shares an edge with
+one of the preceding triangles and new vertices are referenced in order. It's
+lossless, including the order of triangles and their vertices. Expects that
+the index count is divisible by @cpp 3 @ce. Use
+@ref decodeTriangleIndicesInto() to decode the data back.
+@see @ref encodeMesh()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedShort>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedByte>& indices);
+
+/**
+@brief Encode a type-erased triangle index buffer
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref encodeTriangleIndices(const Containers::StridedArrayView1D<const UnsignedInt>&)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeTriangleIndices(const Containers::StridedArrayView2D<const char>& indices);
+
+/**
+@brief Decode a triangle index buffer
+@param[in]  data        Data produced by @ref encodeTriangleIndices()
+@param[out] indices     Where to put the decoded indices
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+@m_since_latest
+
+The size of @p indices is expected to be the same as the size of the encoded
+index buffer, which isn't stored in the data. The index type doesn't need to
+match the one used for encoding, however decoded indices that don't fit into
+the type are truncated. If the data are invalid, prints a message to
+@relativeref{Magnum,Error} and returns @cpp false @ce, contents of @p indices
+are unspecified in that case. Note that the decoder doesn't check the decoded
+indices against any vertex count.
+
+Expects that the index count is divisible by @cpp 3 @ce.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeTriangleIndicesInto(Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT bool decodeTriangleIndicesInto(Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedShort>& indices);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT bool decodeTriangleIndicesInto(Containers::ArrayView<const void> data, const Containers::StridedArrayView1D<UnsignedByte>& indices);
+
+/**
+@brief Decode a triangle index buffer into a type-erased view
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref decodeTriangleIndicesInto(Containers::ArrayView<const void>, const Containers::StridedArrayView1D<UnsignedInt>&)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeTriangleIndicesInto(Containers::ArrayView<const void> data, const Containers::StridedArrayView2D<char>& indices);
+
+/**
+@brief Encode a vertex stream
+@param data             Vertex data
+@param componentSize    Size of a single component
+@m_since_latest
+
+The first dimension of @p data is the vertices, the second the bytes of each
+vertex, which are treated as an array of integer components of
+@p componentSize bytes. Each component is replaced with a difference from the
+same component in the previous vertex, zig-zag-encoded so small negative
+differences have small values as well. The output is then split into byte
+planes, with the first plane containing the lowest byte of the first
+component of all vertices, and so on.
+
+The output has the same size as the input. Its purpose is to make the data
+compress considerably better with general-purpose compressors such as zstd or
+gzip, as the higher bytes of smoothly varying attributes are often close to
+zero. As the components are treated as integers, the encoding is lossless
+also for floating-point data. Use @ref decodeVertexStreamInto() to decode the
+data back on a platform with the same endianness.
+
+Expects that the second dimension of @p data is contiguous, @p componentSize
+is @cpp 1 @ce, @cpp 2 @ce, @cpp 4 @ce or @cpp 8 @ce and the vertex size is
+divisible by it.
+@see @ref encodeMesh()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeVertexStream(const Containers::StridedArrayView2D<const char>& data, UnsignedInt componentSize);
+
+/**
+@brief Decode a vertex stream
+@param[in]  data            Data produced by @ref encodeVertexStream()
+@param[out] vertices        Where to put the decoded vertex data
+@param[in]  componentSize   Size of a single component
+@return @cpp true @ce on success, @cpp false @ce if the data are invalid
+@m_since_latest
+
+If the size of @p data doesn't match the size of @p vertices, prints a message
+to @relativeref{Magnum,Error} and returns @cpp false @ce. Expects that the
+second dimension of @p vertices is contiguous, @p componentSize is
+@cpp 1 @ce, @cpp 2 @ce, @cpp 4 @ce or @cpp 8 @ce and the vertex size is
+divisible by it.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool decodeVertexStreamInto(Containers::ArrayView<const void> data, const Containers::StridedArrayView2D<char>& vertices, UnsignedInt componentSize);
+
+/**
+@brief Encode a mesh
+@m_since_latest
+
+Stores the mesh primitive, index type and attribute properties in a header,
+followed by the index buffer encoded with @ref encodeTriangleIndices() for
+indexed @ref MeshPrimitive::Triangles meshes or with
+@ref encodeVertexStream() for other indexed meshes, and by data of each
+attribute encoded with @ref encodeVertexStream(), using size of the
+attribute component format as the component size. The encoding is lossless,
+i.e. @ref decodeMesh() produces a mesh with the same primitive, index type,
+indices, vertex count and attribute names, formats, array sizes and values,
+but the vertex layout isn't preserved. For best results, pass the mesh through
+@ref tipsify() and @ref reorderForVertexFetch() first and compress the output
+with a general-purpose compressor such as zstd or gzip.
+
+Expects that the mesh doesn't have an implementation-specific index type or
+any attribute with an implementation-specific vertex format. Data in the
+output are in the native endianness.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> encodeMesh(const Trade::MeshData& mesh);
+
+/**
+@brief Decode a mesh
+@m_since_latest
+
+Decodes data produced by @ref encodeMesh(). The output has the attributes in
+the same order as the original mesh, tightly packed in a single interleaved
+buffer, and the indices, if any, in a tightly packed buffer of the original
+type. If the data are invalid, including indices out of range for the vertex
+count, or were encoded on a platform with a different endianness, prints a
+message to @relativeref{Magnum,Error} and returns
+@relativeref{Corrade,Containers::NullOpt}.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Optional<Trade::MeshData> decodeMesh(Containers::ArrayView<const void> data);
+
+}}
+
+#endif
@@ -0,0 +1,325 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateMeshlets.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+struct Meshlet {
+    UnsignedInt vertexOffset;
+    UnsignedInt vertexCount;
+    UnsignedInt triangleOffset;
+    UnsignedInt triangleCount;
+};
+
+/* Marks a vertex that's not in the current meshlet. There's at most 255
+   vertices in a meshlet, so it never clashes with a valid local index. */
+constexpr UnsignedByte NotInMeshlet = 0xff;
+
+template<class T> Trade::MeshData generateMeshletsImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::generateMeshlets(): index count not divisible by 3",
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 255,
+        "MeshTools::generateMeshlets(): expected max vertex count to be between 3 and 255 but got" << maxVertexCount,
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    CORRADE_ASSERT(maxTriangleCount >= 1 && maxTriangleCount <= 512,
+        "MeshTools::generateMeshlets(): expected max triangle count to be between 1 and 512 but got" << maxTriangleCount,
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::generateMeshlets(): index" << index << "out of bounds for" << positions.size() << "elements",
+            (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    #endif
+
+    const std::size_t vertexCount = positions.size();
+    const std::size_t triangleCount = indices.size()/3;
+
+    /* Triangles adjacent to each vertex. The offsets are first calculated
+       shifted by one and then the shift is undone while filling the
+       adjacency. */
+    Containers::Array<UnsignedInt> adjacencyOffsets{ValueInit, vertexCount + 2};
+    for(const T index: indices)
+        ++adjacencyOffsets[index + 2];
+    for(std::size_t i = 2; i != adjacencyOffsets.size(); ++i)
+        adjacencyOffsets[i] += adjacencyOffsets[i - 1];
+    Containers::Array<UnsignedInt> adjacency{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        adjacency[adjacencyOffsets[indices[i] + 1]++] = i/3;
+
+    /* Count of not yet used triangles for each vertex */
+    Containers::Array<UnsignedInt> liveTriangleCount{NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        liveTriangleCount[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+
+    Containers::Array<bool> emitted{ValueInit, triangleCount};
+    Containers::Array<UnsignedByte> localIndex{DirectInit, vertexCount, NotInMeshlet};
+
+    Containers::Array<Meshlet> meshlets;
+    Containers::Array<UnsignedInt> meshletVertices;
+    Containers::Array<Vector3ub> meshletTriangles;
+    Meshlet current{0, 0, 0, 0};
+
+    const auto newVertexCount = [&](const std::size_t triangle) {
+        return UnsignedInt(localIndex[indices[triangle*3 + 0]] == NotInMeshlet) +
+               UnsignedInt(localIndex[indices[triangle*3 + 1]] == NotInMeshlet) +
+               UnsignedInt(localIndex[indices[triangle*3 + 2]] == NotInMeshlet);
+    };
+
+    const auto finishMeshlet = [&]() {
+        for(const UnsignedInt vertex: meshletVertices.exceptPrefix(current.vertexOffset))
+            localIndex[vertex] = NotInMeshlet;
+        arrayAppend(meshlets, current);
+        current = Meshlet{UnsignedInt(meshletVertices.size()), 0, UnsignedInt(meshletTriangles.size()), 0};
+    };
+
+    std::size_t nextSeed = 0;
+    for(;;) {
+        if(current.triangleCount == maxTriangleCount)
+            finishMeshlet();
+
+        /* Pick the best of the not yet used triangles adjacent to vertices
+           in the current meshlet. Triangles that don't add any new vertices
+           are preferred, then triangles that would otherwise become isolated
+           as they're expensive to put into a meshlet of their own, then
+           triangles adding the least new vertices. */
+        std::size_t best = ~std::size_t{};
+        UnsignedInt bestScore = ~UnsignedInt{};
+        for(const UnsignedInt vertex: meshletVertices.exceptPrefix(current.vertexOffset)) {
+            if(!liveTriangleCount[vertex]) continue;
+
+            for(std::size_t i = adjacencyOffsets[vertex], end = adjacencyOffsets[vertex + 1]; i != end; ++i) {
+                const UnsignedInt triangle = adjacency[i];
+                if(emitted[triangle]) continue;
+
+                const UnsignedInt extra = newVertexCount(triangle);
+                if(current.vertexCount + extra > maxVertexCount) continue;
+
+                UnsignedInt score = extra;
+                if(extra && (liveTriangleCount[indices[triangle*3 + 0]] == 1 ||
+                             liveTriangleCount[indices[triangle*3 + 1]] == 1 ||
+                             liveTriangleCount[indices[triangle*3 + 2]] == 1))
+                    score = 1;
+                else if(extra)
+                    score = extra + 1;
+
+                if(score < bestScore) {
+                    best = triangle;
+                    bestScore = score;
+                    if(!score) break;
+                }
+            }
+
+            if(!bestScore) break;
+        }
+
+        /* If there's no adjacent triangle, continue with the next unused
+           triangle in the index buffer, as it's likely close to the previous
+           ones. If it doesn't fit, start a new meshlet with it. */
+        if(best == ~std::size_t{}) {
+            while(nextSeed != triangleCount && emitted[nextSeed])
+                ++nextSeed;
+            if(nextSeed == triangleCount) break;
+
+            best = nextSeed;
+            if(current.vertexCount + newVertexCount(best) > maxVertexCount)
+                finishMeshlet();
+        }
+
+        /* Add the triangle to the meshlet */
+        Vector3ub triangle{NoInit};
+        for(std::size_t i = 0; i != 3; ++i) {
+            const UnsignedInt vertex = indices[best*3 + i];
+            if(localIndex[vertex] == NotInMeshlet) {
+                localIndex[vertex] = UnsignedByte(current.vertexCount++);
+                arrayAppend(meshletVertices, vertex);
+            }
+            triangle[i] = localIndex[vertex];
+            --liveTriangleCount[vertex];
+        }
+        arrayAppend(meshletTriangles, triangle);
+        ++current.triangleCount;
+        emitted[best] = true;
+    }
+
+    if(current.triangleCount)
+        finishMeshlet();
+
+    /* Interleaved output layout, ordered to have everything aligned. The
+       stride is rounded up to 16 bytes so the Vector4 attributes stay aligned
+       for all meshlets, not just the first one. */
+    const std::size_t boundingSphereOffset = 0;
+    const std::size_t normalConeOffset = boundingSphereOffset + sizeof(Vector4);
+    const std::size_t normalConeApexOffset = normalConeOffset + sizeof(Vector4);
+    const std::size_t verticesOffset = normalConeApexOffset + sizeof(Vector3);
+    const std::size_t triangleCountOffset = verticesOffset + maxVertexCount*sizeof(UnsignedInt);
+    const std::size_t vertexCountOffset = triangleCountOffset + sizeof(UnsignedShort);
+    const std::size_t trianglesOffset = vertexCountOffset + sizeof(UnsignedByte);
+    const std::size_t stride = (trianglesOffset + maxTriangleCount*sizeof(Vector3ub) + 15)/16*16;
+
+    Containers::Array<char> data{ValueInit, meshlets.size()*stride};
+    const Containers::StridedArrayView1D<Vector4> boundingSpheres{data, reinterpret_cast<Vector4*>(data.data() + boundingSphereOffset), meshlets.size(), std::ptrdiff_t(stride)};
+    const Containers::StridedArrayView1D<Vector4> normalCones{data, reinterpret_cast<Vector4*>(data.data() + normalConeOffset), meshlets.size(), std::ptrdiff_t(stride)};
+    const Containers::StridedArrayView1D<Vector3> normalConeApexes{data, reinterpret_cast<Vector3*>(data.data() + normalConeApexOffset), meshlets.size(), std::ptrdiff_t(stride)};
+    const Containers::StridedArrayView2D<UnsignedInt> vertices{data, reinterpret_cast<UnsignedInt*>(data.data() + verticesOffset), {meshlets.size(), maxVertexCount}, {std::ptrdiff_t(stride), std::ptrdiff_t(sizeof(UnsignedInt))}};
+    const Containers::StridedArrayView1D<UnsignedShort> triangleCounts{data, reinterpret_cast<UnsignedShort*>(data.data() + triangleCountOffset), meshlets.size(), std::ptrdiff_t(stride)};
+    const Containers::StridedArrayView1D<UnsignedByte> vertexCounts{data, reinterpret_cast<UnsignedByte*>(data.data() + vertexCountOffset), meshlets.size(), std::ptrdiff_t(stride)};
+    const Containers::StridedArrayView2D<Vector3ub> triangles{data, reinterpret_cast<Vector3ub*>(data.data() + trianglesOffset), {meshlets.size(), maxTriangleCount}, {std::ptrdiff_t(stride), std::ptrdiff_t(sizeof(Vector3ub))}};
+
+    Containers::Array<Vector3> meshletPositions{NoInit, maxVertexCount};
+    Containers::Array<Vector3> triangleNormals{NoInit, maxTriangleCount};
+    for(std::size_t i = 0; i != meshlets.size(); ++i) {
+        const Meshlet& meshlet = meshlets[i];
+        const Containers::ArrayView<const UnsignedInt> currentVertices = meshletVertices.sliceSize(meshlet.vertexOffset, meshlet.vertexCount);
+        const Containers::ArrayView<const Vector3ub> currentTriangles = meshletTriangles.sliceSize(meshlet.triangleOffset, meshlet.triangleCount);
+
+        for(std::size_t j = 0; j != currentVertices.size(); ++j) {
+            vertices[i][j] = currentVertices[j];
+            meshletPositions[j] = positions[currentVertices[j]];
+        }
+        for(std::size_t j = 0; j != currentTriangles.size(); ++j)
+            triangles[i][j] = currentTriangles[j];
+        vertexCounts[i] = meshlet.vertexCount;
+        triangleCounts[i] = meshlet.triangleCount;
+
+        const Containers::Pair<Vector3, Float> sphere = boundingSphereBouncingBubble(meshletPositions.prefix(meshlet.vertexCount));
+        boundingSpheres[i] = {sphere.first(), sphere.second()};
+
+        /* The cone axis is an average of all triangle normals, degenerate
+           triangles are ignored */
+        Vector3 normalSum;
+        for(std::size_t j = 0; j != currentTriangles.size(); ++j) {
+            const Vector3 a = meshletPositions[currentTriangles[j][0]];
+            const Vector3 b = meshletPositions[currentTriangles[j][1]];
+            const Vector3 c = meshletPositions[currentTriangles[j][2]];
+            const Vector3 normal = Math::cross(b - a, c - a);
+            const Float length = normal.length();
+            triangleNormals[j] = length == 0.0f ? Vector3{} : normal/length;
+            normalSum += triangleNormals[j];
+        }
+
+        /* The cone spans the largest angle between the axis and any of the
+           normals. If it's a hemisphere or more or there are no usable
+           normals, the meshlet can't be culled. */
+        const Float normalSumLength = normalSum.length();
+        Float minDot = 1.0f;
+        Vector3 axis;
+        if(normalSumLength != 0.0f) {
+            axis = normalSum/normalSumLength;
+            for(std::size_t j = 0; j != currentTriangles.size(); ++j)
+                if(!triangleNormals[j].isZero())
+                    minDot = Math::min(minDot, Math::dot(triangleNormals[j], axis));
+        }
+        if(normalSumLength == 0.0f || minDot <= 0.0f) {
+            normalCones[i] = {0.0f, 0.0f, 0.0f, 1.0f};
+            normalConeApexes[i] = sphere.first();
+            continue;
+        }
+
+        /* Move the apex back from the sphere center along the axis until all
+           triangle planes are in front of it, so the cone test is
+           conservative for cameras close to the meshlet */
+        Float maxDistance = 0.0f;
+        for(std::size_t j = 0; j != currentTriangles.size(); ++j) {
+            if(triangleNormals[j].isZero()) continue;
+            const Vector3 a = meshletPositions[currentTriangles[j][0]];
+            maxDistance = Math::max(maxDistance, Math::dot(sphere.first() - a, triangleNormals[j])/Math::dot(axis, triangleNormals[j]));
+        }
+
+        normalCones[i] = {axis, Math::sqrt(1.0f - minDot*minDot)};
+        normalConeApexes[i] = sphere.first() - axis*maxDistance;
+    }
+
+    return Trade::MeshData{MeshPrimitive::Meshlets, std::move(data), {
+        Trade::MeshAttributeData{MeshAttributeMeshletBoundingSphere, boundingSpheres},
+        Trade::MeshAttributeData{MeshAttributeMeshletNormalCone, normalCones},
+        Trade::MeshAttributeData{MeshAttributeMeshletNormalConeApex, normalConeApexes},
+        Trade::MeshAttributeData{MeshAttributeMeshletVertices, vertices},
+        Trade::MeshAttributeData{MeshAttributeMeshletTriangleCount, triangleCounts},
+        Trade::MeshAttributeData{MeshAttributeMeshletVertexCount, vertexCounts},
+        Trade::MeshAttributeData{MeshAttributeMeshletTriangles, triangles}
+    }, UnsignedInt(meshlets.size())};
+}
+
+}
+
+Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return generateMeshletsImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Trade::MeshData generateMeshlets(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateMeshlets(): second index view dimension is not contiguous", (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    if(indices.size()[1] == 4)
+        return generateMeshletsImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), positions, maxVertexCount, maxTriangleCount);
+    else if(indices.size()[1] == 2)
+        return generateMeshletsImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), positions, maxVertexCount, maxTriangleCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateMeshlets(): expected index type size 1, 2 or 4 but got" << indices.size()[1], (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+        return generateMeshletsImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), positions, maxVertexCount, maxTriangleCount);
+    }
+}
+
+Trade::MeshData generateMeshlets(const Trade::MeshData& mesh, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::generateMeshlets(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::generateMeshlets(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::generateMeshlets(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Meshlets, 0}));
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    if(mesh.isIndexed())
+        return generateMeshlets(mesh.indices(), positions, maxVertexCount, maxTriangleCount);
+
+    /* A non-indexed mesh is treated as having a trivial index buffer */
+    Containers::Array<UnsignedInt> indices{NoInit, mesh.vertexCount()};
+    for(UnsignedInt i = 0; i != indices.size(); ++i)
+        indices[i] = i;
+    return generateMeshlets(Containers::stridedArrayView(indices), positions, maxVertexCount, maxTriangleCount);
+}
+
+}}
@@ -0,0 +1,210 @@
+#ifndef Magnum_MeshTools_GenerateMeshlets_h
+#define Magnum_MeshTools_GenerateMeshlets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateMeshlets(), constant @ref Magnum::MeshTools::MeshAttributeMeshletBoundingSphere, @ref Magnum::MeshTools::MeshAttributeMeshletNormalCone, @ref Magnum::MeshTools::MeshAttributeMeshletNormalConeApex, @ref Magnum::MeshTools::MeshAttributeMeshletVertices, @ref Magnum::MeshTools::MeshAttributeMeshletTriangleCount, @ref Magnum::MeshTools::MeshAttributeMeshletVertexCount, @ref Magnum::MeshTools::MeshAttributeMeshletTriangles
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet bounding sphere attribute
+@m_since_latest
+
+@ref VertexFormat::Vector4, with the XYZ components being the sphere center
+and W the radius. Calculated with @ref boundingSphereBouncingBubble() from all
+vertices referenced by the meshlet. Can be used for frustum and occlusion
+culling.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletBoundingSphere = Trade::meshAttributeCustom(32752);
+
+/**
+@brief Meshlet normal cone attribute
+@m_since_latest
+
+@ref VertexFormat::Vector4, with the XYZ components being a normalized cone
+axis and W a cutoff. If a camera at position @f$ \boldsymbol{c} @f$ satisfies
+the following condition, where @f$ \boldsymbol{a} @f$ is the cone apex from
+@ref MeshAttributeMeshletNormalConeApex, @f$ \boldsymbol{n} @f$ the cone axis
+and @f$ t @f$ the cutoff, all triangles in the meshlet are back-facing and
+the meshlet can be culled:
+
+@f[
+    \frac{\boldsymbol{a} - \boldsymbol{c}}{|\boldsymbol{a} - \boldsymbol{c}|} \cdot \boldsymbol{n} \ge t
+@f]
+
+If the triangle normals span a hemisphere or more, or all triangles in the
+meshlet are degenerate, the axis is a zero vector and the cutoff is
+@cpp 1.0f @ce, which makes the condition never pass.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletNormalCone = Trade::meshAttributeCustom(32753);
+
+/**
+@brief Meshlet normal cone apex attribute
+@m_since_latest
+
+@ref VertexFormat::Vector3. See @ref MeshAttributeMeshletNormalCone for how
+it's used.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletNormalConeApex = Trade::meshAttributeCustom(32754);
+
+/**
+@brief Meshlet vertices attribute
+@m_since_latest
+
+Array of @ref VertexFormat::UnsignedInt, with the array size being the
+maximum vertex count per meshlet. First @ref MeshAttributeMeshletVertexCount
+items are indices into vertex data of the original mesh, the remaining items
+are zero.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletVertices = Trade::meshAttributeCustom(32755);
+
+/**
+@brief Meshlet triangle count attribute
+@m_since_latest
+
+@ref VertexFormat::UnsignedShort.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletTriangleCount = Trade::meshAttributeCustom(32756);
+
+/**
+@brief Meshlet vertex count attribute
+@m_since_latest
+
+@ref VertexFormat::UnsignedByte.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletVertexCount = Trade::meshAttributeCustom(32757);
+
+/**
+@brief Meshlet triangles attribute
+@m_since_latest
+
+Array of @ref VertexFormat::Vector3ub, with the array size being the maximum
+triangle count per meshlet. First @ref MeshAttributeMeshletTriangleCount
+items are triangles indexing into @ref MeshAttributeMeshletVertices of the
+same meshlet, the remaining items are zero.
+@see @ref generateMeshlets()
+*/
+constexpr Trade::MeshAttribute MeshAttributeMeshletTriangles = Trade::meshAttributeCustom(32758);
+
+/**
+@brief Split a triangle mesh into meshlets
+@param indices          Triangle index array
+@param positions        Vertex positions
+@param maxVertexCount   Max count of unique vertices in a meshlet
+@param maxTriangleCount Max count of triangles in a meshlet
+@m_since_latest
+
+Groups triangles into meshlets of at most @p maxVertexCount unique vertices
+and @p maxTriangleCount triangles, suitable for mesh shaders and GPU-driven
+culling. The default values fit the limits of commonly used mesh shader
+implementations. A meshlet is grown greedily from triangles adjacent to
+vertices it already contains, preferring triangles that add the least new
+vertices, and a new meshlet is started once no adjacent triangle fits
+anymore. Triangles that are close together in the index buffer are more
+likely to end up in the same meshlet, so optimizing the mesh with
+@ref optimizeVertexCacheInPlace() first is recommended.
+
+The result is a @ref MeshPrimitive::Meshlets mesh where each vertex describes
+one meshlet with the following interleaved attributes:
+
+-   @ref MeshAttributeMeshletBoundingSphere
+-   @ref MeshAttributeMeshletNormalCone
+-   @ref MeshAttributeMeshletNormalConeApex
+-   @ref MeshAttributeMeshletVertices, with array size @p maxVertexCount
+-   @ref MeshAttributeMeshletTriangleCount
+-   @ref MeshAttributeMeshletVertexCount
+-   @ref MeshAttributeMeshletTriangles, with array size @p maxTriangleCount
+
+The vertex stride is a multiple of 16 bytes, which means the
+@ref VertexFormat::Vector4 attributes are 16-byte aligned for all meshlets.
+All attributes use custom IDs from the range reserved for Magnum itself, see
+@ref Trade::MeshAttribute for details.
+
+The meshlets reference the original vertex data, which isn't included in the
+output. Triangles in each meshlet keep their winding.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than size of @p positions, @p maxVertexCount is between @cpp 3 @ce and
+@cpp 255 @ce and @p maxTriangleCount is between @cpp 1 @ce and @cpp 512 @ce.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateMeshlets(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Split a type-erased triangle mesh into meshlets
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateMeshlets(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateMeshlets(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Split a mesh into meshlets
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles with a
+@ref Trade::MeshAttribute::Position, which is converted to a 3D vector
+array using @ref Trade::MeshData::positions3DAsArray() and then passed
+together with the index buffer to
+@ref generateMeshlets(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt).
+If the mesh is not indexed, it's treated as if it had a trivial index buffer.
+The returned meshlets reference vertices of @p mesh.
+@see @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateMeshlets(const Trade::MeshData& mesh, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+}}
+
+#endif
@@ -25,11 +25,13 @@
 
 #include "GenerateNormals.h"
 
+#include <atomic>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Implementation/Threads.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -98,57 +100,11 @@ namespace {
 using namespace Math::Literals;
 #endif
 
-template<class T> inline void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
-    CORRADE_ASSERT(indices.size() % 3 == 0,
-        "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
-    CORRADE_ASSERT(normals.size() == positions.size(),
-        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
-
-    if(indices.isEmpty()) return;
-
-    /* Gather count of triangles for every vertex. This abuses the output
-       storage to avoid extra allocations, zero-initialize it first to avoid
-       random memory getting used. */
-    Containers::StridedArrayView1D<UnsignedInt> triangleCount =
-        Containers::arrayCast<UnsignedInt>(normals);
-    for(UnsignedInt& i: triangleCount) i = 0;
-    for(const T index: indices) {
-        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateSmoothNormalsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
-        ++triangleCount[index];
-    }
-
-    /* Turn that into a running offset array:
-       triangleOffset[i + 1] - triangleOffset[i] is triangle count for vertex i
-       triangleOffset[i] is offset into an triangle ID array for vertex i */
-    Containers::Array<UnsignedInt> triangleOffset{NoInit, positions.size() + 1};
-    triangleOffset[0] = 0;
-    for(std::size_t i = 0; i != triangleCount.size(); ++i)
-        triangleOffset[i + 1] = triangleOffset[i] + triangleCount[i];
-
-    CORRADE_INTERNAL_ASSERT(triangleOffset.back() == indices.size());
-
-    /* Gather triangle IDs for every vertex. For vertex i,
-       triangleIds[triangleOffset[i]] until triangleIds[triangleOffset[i + 1]]
-       contains IDs of triangles that contain it. */
-    Containers::Array<T> triangleIds{NoInit, indices.size()};
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        const T triangleId = i/3;
-        const T vertexId = indices[i];
-
-        /* How many triangle IDs is still left to be written, which also means
-           the offset where we put the ID. Decrement that for the next run. */
-        const std::size_t triangleIdsLeftForVertex = triangleCount[vertexId]--;
-        triangleIds[triangleOffset[vertexId + 1] - triangleIdsLeftForVertex] = triangleId;
-    }
-
-    /* Now, triangleCount should be all zeros, we don't need it anymore and the
-       underlying `normals` array is ready to get filled with real output. */
-
-    /* Precalculate cross product and interior angles of each face --- the loop
-       below would otherwise calculate it for every vertex, which is at least
-       3x as much work */
-    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, indices.size()/3};
-    for(std::size_t i = 0; i != crossAngles.size(); ++i) {
+/* Precalculate cross product and interior angles of faces in given range ---
+   the accumulation below would otherwise calculate it for every vertex, which
+   is at least 3x as much work */
+template<class T> void calculateCrossAngles(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
         const Vector3 v0 = positions[indices[i*3 + 0]];
         const Vector3 v1 = positions[indices[i*3 + 1]];
         const Vector3 v2 = positions[indices[i*3 + 2]];
@@ -179,16 +135,18 @@ template<class T> inline void generateSmoothNormalsIntoImplementation(const Cont
         crossAngles[i].second[2] = Rad(180.0_degf)
             - crossAngles[i].second[0] - crossAngles[i].second[1];
     }
+}
 
-    /* For every vertex v, calculate normals from all faces it belongs to and
-       average them */
-    for(std::size_t v = 0; v != positions.size(); ++v) {
+/* For every vertex v in given range, calculate normals from all faces it
+   belongs to and average them */
+template<class T> void accumulateNormals(const Containers::StridedArrayView1D<const T>& indices, const Containers::ArrayView<const UnsignedInt> triangleOffset, const Containers::ArrayView<const UnsignedInt> triangleIds, const Containers::ArrayView<const std::pair<Vector3, Math::Vector3<Rad>>> crossAngles, const Containers::StridedArrayView1D<Vector3>& normals, const std::size_t begin, const std::size_t end) {
+    for(std::size_t v = begin; v != end; ++v) {
         /* normals are an external memory, ensure we accumulate from zero */
         normals[v] = Vector3{Math::ZeroInit};
 
         /* Go through all triangles sharing this vertex */
         for(std::size_t t = triangleOffset[v]; t != triangleOffset[v + 1]; ++t) {
-            const std::size_t baseIndex = triangleIds[t]*3;
+            const std::size_t baseIndex = std::size_t(triangleIds[t])*3;
             const T v0i = indices[baseIndex + 0];
             const T v1i = indices[baseIndex + 1];
             const T v2i = indices[baseIndex + 2];
@@ -221,6 +179,171 @@ template<class T> inline void generateSmoothNormalsIntoImplementation(const Cont
     }
 }
 
+template<class T> void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+
+    if(indices.isEmpty()) return;
+
+    /* Gather count of triangles for every vertex. This abuses the output
+       storage to avoid extra allocations, zero-initialize it first to avoid
+       random memory getting used. */
+    Containers::StridedArrayView1D<UnsignedInt> triangleCount =
+        Containers::arrayCast<UnsignedInt>(normals);
+    for(UnsignedInt& i: triangleCount) i = 0;
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateSmoothNormalsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+        ++triangleCount[index];
+    }
+
+    /* Turn that into a running offset array:
+       triangleOffset[i + 1] - triangleOffset[i] is triangle count for vertex i
+       triangleOffset[i] is offset into an triangle ID array for vertex i */
+    Containers::Array<UnsignedInt> triangleOffset{NoInit, positions.size() + 1};
+    triangleOffset[0] = 0;
+    for(std::size_t i = 0; i != triangleCount.size(); ++i)
+        triangleOffset[i + 1] = triangleOffset[i] + triangleCount[i];
+
+    CORRADE_INTERNAL_ASSERT(triangleOffset.back() == indices.size());
+
+    /* Gather triangle IDs for every vertex. For vertex i,
+       triangleIds[triangleOffset[i]] until triangleIds[triangleOffset[i + 1]]
+       contains IDs of triangles that contain it, in an increasing order. The
+       IDs are 32-bit even for smaller index types, as there can be more
+       triangles than vertices. */
+    Containers::Array<UnsignedInt> triangleIds{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        const T vertexId = indices[i];
+
+        /* How many triangle IDs is still left to be written, which also means
+           the offset where we put the ID. Decrement that for the next run. */
+        const std::size_t triangleIdsLeftForVertex = triangleCount[vertexId]--;
+        triangleIds[triangleOffset[vertexId + 1] - triangleIdsLeftForVertex] = i/3;
+    }
+
+    /* Now, triangleCount should be all zeros, we don't need it anymore and the
+       underlying `normals` array is ready to get filled with real output. */
+
+    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, indices.size()/3};
+    calculateCrossAngles(indices, positions, crossAngles, 0, crossAngles.size());
+
+    accumulateNormals<T>(indices, triangleOffset, triangleIds, crossAngles, normals, 0, positions.size());
+}
+
+/* Parallel variant of generateSmoothNormalsIntoImplementation(), producing
+   bit-exact output. Triangle counts and IDs are gathered from contiguous
+   index ranges, one per thread, using atomic counters. As the threads then
+   put the triangle IDs for each vertex in a nondeterministic order, the IDs
+   get sorted before the accumulation, which is split into vertex ranges. Each
+   vertex is thus accumulated by a single thread from the same values and in
+   the same order as in the serial variant. */
+template<class T> void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    /* If there's not enough data to make use of more than one thread, defer
+       to the serial variant */
+    const std::size_t actualThreadCount = Implementation::threadCountFor(threadCount, indices.size());
+    if(actualThreadCount == 1)
+        return generateSmoothNormalsIntoImplementation(indices, positions, normals);
+
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+
+    const std::size_t triangleCount = indices.size()/3;
+    const std::size_t vertexCount = positions.size();
+
+    /* Gather count of triangles for every vertex. The ranges can share
+       vertices, so the counters are atomic. Assertions can't be fired from a
+       worker thread, so the first out-of-bounds index in each range is
+       remembered and checked afterwards, which results in the same message as
+       in the serial variant. */
+    Containers::Array<std::atomic<UnsignedInt>> triangleCounts{ValueInit, vertexCount};
+    #ifndef CORRADE_NO_ASSERT
+    Containers::Array<std::size_t> outOfBounds{DirectInit, actualThreadCount, ~std::size_t{}};
+    #endif
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t end = triangleCount*(range + 1)/actualThreadCount*3;
+        for(std::size_t i = triangleCount*range/actualThreadCount*3; i != end; ++i) {
+            const T index = indices[i];
+            #ifndef CORRADE_NO_ASSERT
+            if(index >= vertexCount) {
+                outOfBounds[range] = i;
+                return;
+            }
+            #endif
+            triangleCounts[index].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    #ifndef CORRADE_NO_ASSERT
+    for(const std::size_t i: outOfBounds)
+        CORRADE_ASSERT(i == ~std::size_t{}, "MeshTools::generateSmoothNormalsInto(): index" << indices[i] << "out of bounds for" << vertexCount << "elements", );
+    #endif
+
+    /* Turn that into a running offset array. Each thread sums the counts in
+       its vertex range first, the sums are then turned into a starting offset
+       for every range and each thread fills in its part of the offsets. */
+    Containers::Array<UnsignedInt> triangleOffset{NoInit, vertexCount + 1};
+    Containers::Array<UnsignedInt> rangeOffset{ValueInit, actualThreadCount + 1};
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t end = vertexCount*(range + 1)/actualThreadCount;
+        UnsignedInt sum = 0;
+        for(std::size_t i = vertexCount*range/actualThreadCount; i != end; ++i)
+            sum += triangleCounts[i].load(std::memory_order_relaxed);
+        rangeOffset[range + 1] = sum;
+    });
+    for(std::size_t i = 0; i != actualThreadCount; ++i)
+        rangeOffset[i + 1] += rangeOffset[i];
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t end = vertexCount*(range + 1)/actualThreadCount;
+        UnsignedInt offset = rangeOffset[range];
+        for(std::size_t i = vertexCount*range/actualThreadCount; i != end; ++i) {
+            triangleOffset[i] = offset;
+            offset += triangleCounts[i].load(std::memory_order_relaxed);
+        }
+    });
+    triangleOffset[vertexCount] = rangeOffset[actualThreadCount];
+
+    CORRADE_INTERNAL_ASSERT(triangleOffset.back() == indices.size());
+
+    /* Gather triangle IDs for every vertex, decrementing the atomic counters
+       to get the slot, and calculate the cross products and angles for the
+       same triangle range */
+    Containers::Array<UnsignedInt> triangleIds{NoInit, indices.size()};
+    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, triangleCount};
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t begin = triangleCount*range/actualThreadCount;
+        const std::size_t end = triangleCount*(range + 1)/actualThreadCount;
+        for(std::size_t i = begin*3; i != end*3; ++i) {
+            const T vertexId = indices[i];
+            const std::size_t triangleIdsLeftForVertex = triangleCounts[vertexId].fetch_sub(1, std::memory_order_relaxed);
+            triangleIds[triangleOffset[vertexId + 1] - triangleIdsLeftForVertex] = i/3;
+        }
+
+        calculateCrossAngles(indices, positions, crossAngles, begin, end);
+    });
+
+    /* Sort the triangle IDs of each vertex to have them in the same order as
+       in the serial variant and accumulate the normals. Usually there's just
+       a handful of triangles per vertex so an insertion sort is enough. */
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t begin = vertexCount*range/actualThreadCount;
+        const std::size_t end = vertexCount*(range + 1)/actualThreadCount;
+        for(std::size_t v = begin; v != end; ++v) {
+            for(std::size_t i = triangleOffset[v] + 1; i < triangleOffset[v + 1]; ++i) {
+                const UnsignedInt id = triangleIds[i];
+                std::size_t j = i;
+                for(; j != triangleOffset[v] && triangleIds[j - 1] > id; --j)
+                    triangleIds[j] = triangleIds[j - 1];
+                triangleIds[j] = id;
+            }
+        }
+
+        accumulateNormals<T>(indices, triangleOffset, triangleIds, crossAngles, normals, begin, end);
+    });
+}
+
 }
 
 /* If not done this way but with templates instead, C++ wouldn't be able to
@@ -248,6 +371,28 @@ void generateSmoothNormalsInto(const Containers::StridedArrayView2D<const char>&
     }
 }
 
+void generateSmoothNormalsInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(indices, positions, normals, threadCount);
+}
+void generateSmoothNormalsInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(indices, positions, normals, threadCount);
+}
+void generateSmoothNormalsInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(indices, positions, normals, threadCount);
+}
+
+void generateSmoothNormalsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateSmoothNormalsInto(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return generateSmoothNormalsIntoImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), positions, normals, threadCount);
+    else if(indices.size()[1] == 2)
+        return generateSmoothNormalsIntoImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), positions, normals, threadCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateSmoothNormalsInto(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return generateSmoothNormalsIntoImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), positions, normals, threadCount);
+    }
+}
+
 namespace {
 
 template<class T> inline Containers::Array<Vector3> generateSmoothNormalsImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
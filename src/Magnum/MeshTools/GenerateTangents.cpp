@@ -0,0 +1,255 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <limits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/FilterAttributes.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Implementation/Threads.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Count of triangles processed at once. The per-corner data for a chunk are
+   3 MB, which fits into a cache, and the chunk is still large enough to be
+   worth splitting among threads. */
+constexpr std::size_t ChunkTriangleCount = 65536;
+
+/* Same as the NotZero() and NormalizeSafe() helpers in MikkTSpace, in order
+   to treat degenerate cases the same */
+inline bool notZero(const Float value) {
+    return Math::abs(value) > std::numeric_limits<Float>::min();
+}
+
+inline Vector3 normalizeSafe(const Vector3& vector) {
+    const Float length = vector.length();
+    return notZero(length) ? vector/length : vector;
+}
+
+inline Vector3 projectToPlane(const Vector3& vector, const Vector3& normal) {
+    return vector - Math::dot(normal, vector)*normal;
+}
+
+/* Calculates per-corner tangent contributions of triangles in given range,
+   as done in InitTriInfo() and EvalTspace() in MikkTSpace. The corners view
+   has three items for each triangle in the range. The XYZ part is the
+   triangle tangent projected to the plane of the corner normal, weighted by
+   the corner angle. The W part is the angle, negative if the texture space of
+   the triangle is mirrored. Triangles with a degenerate texture space get
+   zeros, which means they don't contribute to anything. */
+template<class T> void calculateCornerTangents(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::ArrayView<Vector4> corners, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        const T ids[]{indices[i*3 + 0], indices[i*3 + 1], indices[i*3 + 2]};
+        const Vector3 p[]{positions[ids[0]], positions[ids[1]], positions[ids[2]]};
+        const Vector2 t10 = textureCoordinates[ids[1]] - textureCoordinates[ids[0]];
+        const Vector2 t20 = textureCoordinates[ids[2]] - textureCoordinates[ids[0]];
+
+        /* The tangent direction scaled by twice the signed texture space area.
+           Flip it if the area is negative, i.e. if the texture space is
+           mirrored, so it points in the direction of increasing U in both
+           cases. */
+        const Float signedArea = Math::cross(t10, t20);
+        const Vector3 scaledTangent = t20.y()*(p[1] - p[0]) - t10.y()*(p[2] - p[0]);
+        const Float scaledTangentLength = scaledTangent.length();
+        Vector4* const triangleCorners = corners.data() + (i - begin)*3;
+        if(!notZero(signedArea) || !notZero(scaledTangentLength)) {
+            triangleCorners[0] = triangleCorners[1] = triangleCorners[2] = {};
+            continue;
+        }
+        const bool mirrored = signedArea < 0.0f;
+        const Vector3 tangent = scaledTangent*((mirrored ? -1.0f : 1.0f)/scaledTangentLength);
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const Vector3& normal = normals[ids[j]];
+
+            /* Angle between the two triangle edges sharing this corner,
+               projected to the normal plane */
+            const Vector3 a = normalizeSafe(projectToPlane(p[(j + 2) % 3] - p[j], normal));
+            const Vector3 b = normalizeSafe(projectToPlane(p[(j + 1) % 3] - p[j], normal));
+            const Float angle = std::acos(Math::clamp(Math::dot(a, b), -1.0f, 1.0f));
+
+            triangleCorners[j] = {normalizeSafe(projectToPlane(tangent, normal))*angle, mirrored ? -angle : angle};
+        }
+    }
+}
+
+template<class T> void generateTangentsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateTangentsInto(): index count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "normals and texture coordinates but got" << normals.size() << "and" << textureCoordinates.size(), );
+    CORRADE_ASSERT(tangents.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): bad output size, expected" << positions.size() << "but got" << tangents.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateTangentsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    /* Tangent contributions accumulated for each vertex, with triangles with
+       a right-handed texture space in even items and the mirrored ones in
+       odd items. The W component is the sum of corner angles. */
+    Containers::Array<Vector4> accumulated{ValueInit, positions.size()*2};
+
+    /* Calculate the corner contributions for each chunk, split into
+       contiguous ranges among the threads, and then add them to the
+       accumulated values. The accumulation is done on a single thread in the
+       order of corners, which makes the result the same regardless of the
+       thread count. */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<Vector4> corners{NoInit, Math::min(triangleCount, ChunkTriangleCount)*3};
+    for(std::size_t chunk = 0; chunk < triangleCount; chunk += ChunkTriangleCount) {
+        const std::size_t chunkTriangleCount = Math::min(triangleCount - chunk, ChunkTriangleCount);
+        const std::size_t actualThreadCount = Implementation::threadCountFor(threadCount, chunkTriangleCount*3);
+        Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+            const std::size_t begin = chunkTriangleCount*range/actualThreadCount;
+            const std::size_t end = chunkTriangleCount*(range + 1)/actualThreadCount;
+            calculateCornerTangents(indices, positions, normals, textureCoordinates, corners.slice(begin*3, end*3), chunk + begin, chunk + end);
+        });
+
+        for(std::size_t i = 0; i != chunkTriangleCount*3; ++i) {
+            const Vector4& corner = corners[i];
+            accumulated[std::size_t(indices[chunk*3 + i])*2 + (corner.w() < 0.0f ? 1 : 0)] += Vector4{corner.xyz(), Math::abs(corner.w())};
+        }
+    }
+
+    /* Pick the handedness with a larger total angle for each vertex and
+       normalize the accumulated direction. Vertices with no contribution get
+       a default. */
+    const std::size_t actualThreadCount = Implementation::threadCountFor(threadCount, positions.size());
+    Implementation::runOnThreads(actualThreadCount, [&](const std::size_t range) {
+        const std::size_t end = positions.size()*(range + 1)/actualThreadCount;
+        for(std::size_t i = positions.size()*range/actualThreadCount; i != end; ++i) {
+            const Vector4& rightHanded = accumulated[i*2 + 0];
+            const Vector4& mirrored = accumulated[i*2 + 1];
+            if(mirrored.w() > rightHanded.w())
+                tangents[i] = {normalizeSafe(mirrored.xyz()), -1.0f};
+            else if(notZero(rightHanded.w()))
+                tangents[i] = {normalizeSafe(rightHanded.xyz()), 1.0f};
+            else
+                tangents[i] = {1.0f, 0.0f, 0.0f, 1.0f};
+        }
+    });
+}
+
+}
+
+/* If not done this way but with templates instead, C++ wouldn't be able to
+   figure out on its own which overload to use when indices are not already a
+   strided arrray view */
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, threadCount);
+}
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, threadCount);
+}
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, threadCount);
+}
+
+void generateTangentsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateTangentsInto(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return generateTangentsIntoImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), positions, normals, textureCoordinates, tangents, threadCount);
+    else if(indices.size()[1] == 2)
+        return generateTangentsIntoImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), positions, normals, textureCoordinates, tangents, threadCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateTangentsInto(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return generateTangentsIntoImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), positions, normals, textureCoordinates, tangents, threadCount);
+    }
+}
+
+namespace {
+
+template<class T> inline Containers::Array<Vector4> generateTangentsImplementation(const T& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    Containers::Array<Vector4> out{NoInit, positions.size()};
+    generateTangentsInto(indices, positions, normals, textureCoordinates, out, threadCount);
+    return out;
+}
+
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, threadCount);
+}
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, threadCount);
+}
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, threadCount);
+}
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, threadCount);
+}
+
+Trade::MeshData generateTangents(const Trade::MeshData& mesh, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::generateTangents(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::generateTangents(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::generateTangents(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Normal),
+        "MeshTools::generateTangents(): the mesh has no normals",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::TextureCoordinates),
+        "MeshTools::generateTangents(): the mesh has no texture coordinates",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make room for the tangents, replacing existing tangents and bitangents,
+       if there are any */
+    Trade::MeshData out = interleave(
+        filterExceptAttributes(mesh, {Trade::MeshAttribute::Tangent,
+                                      Trade::MeshAttribute::Bitangent}),
+        {Trade::MeshAttributeData{Trade::MeshAttribute::Tangent, VertexFormat::Vector4, nullptr}});
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    const Containers::Array<Vector3> normals = mesh.normalsAsArray();
+    const Containers::Array<Vector2> textureCoordinates = mesh.textureCoordinates2DAsArray();
+    const Containers::StridedArrayView1D<Vector4> tangents = out.mutableAttribute<Vector4>(Trade::MeshAttribute::Tangent);
+    if(mesh.isIndexed()) {
+        generateTangentsInto(mesh.indices(), positions, normals, textureCoordinates, tangents, threadCount);
+        return out;
+    }
+
+    /* A non-indexed mesh is treated as having a trivial index buffer */
+    Containers::Array<UnsignedInt> indices{NoInit, mesh.vertexCount()};
+    for(UnsignedInt i = 0; i != indices.size(); ++i)
+        indices[i] = i;
+    generateTangentsInto(Containers::stridedArrayView(indices), positions, normals, textureCoordinates, tangents, threadCount);
+    return out;
+}
+
+}}
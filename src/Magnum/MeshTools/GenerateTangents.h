@@ -0,0 +1,183 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents(), @ref Magnum::MeshTools::generateTangentsInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents
+@param indices              Triangle face indices
+@param positions            Vertex positions
+@param normals              Vertex normals
+@param textureCoordinates   Vertex texture coordinates
+@param threadCount          Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@return Per-vertex four-component tangents
+@m_since_latest
+
+Calculates tangents in a way compatible with
+[MikkTSpace](http://www.mikktspace.com/) by Morten S. Mikkelsen, which is what
+most tools and engines expect normal maps to be baked with. For each triangle
+a tangent direction is calculated from its positions and texture coordinates.
+For every vertex the tangent directions of all triangles sharing it are then
+projected to the plane defined by the vertex normal, weighted by the triangle
+angle at given vertex and averaged. The fourth component is the bitangent sign,
+@cpp +1.0f @ce if the texture space of the triangles is right-handed and
+@cpp -1.0f @ce if it's mirrored; the bitangent can be reconstructed as
+described in the documentation of @ref Trade::MeshAttribute::Tangent.
+
+Unlike MikkTSpace, which outputs a tangent for each face corner, this function
+produces a single tangent per vertex. The output thus matches MikkTSpace only
+if vertices are shared just by triangles of the same texture space handedness,
+if that's not the case, the handedness that spans a larger angle around the
+vertex is picked. Vertices that have equal position, normal and texture
+coordinates are treated as a single vertex by MikkTSpace, use
+@ref removeDuplicates() on the mesh first to have them treated that way here
+as well. Triangles with a zero-area texture space don't contribute to the
+calculated tangents, vertices that aren't part of any other triangle get
+@cpp {1.0f, 0.0f, 0.0f, 1.0f} @ce.
+
+The calculation goes through the triangles in a single pass, processing them in
+chunks sized to fit in a cache. The per-triangle part of the work can be split
+among @p threadCount threads, at most one thread is used for every 16384
+indices, if there's not enough indices or the platform doesn't support
+threads, the operation is done on the calling thread. The output is exactly the
+same independently of the thread count used.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than size of @p positions and that @p normals and @p textureCoordinates have
+the same size as @p positions.
+@see @ref generateTangentsInto(), @ref generateSmoothNormals(),
+    @ref removeDuplicates()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents using a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents into an existing array
+@param[in] indices              Triangle face indices
+@param[in] positions            Vertex positions
+@param[in] normals              Vertex normals
+@param[in] textureCoordinates   Vertex texture coordinates
+@param[out] tangents            Where to put the generated tangents
+@param[in] threadCount          Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+A variant of @ref generateTangents() that fills existing memory instead of
+allocating a new array. The @p tangents array is expected to have the same
+size as @p positions. Note that even with the output array this function isn't
+fully allocation-free --- it still allocates internal arrays for the
+per-vertex accumulation and per-triangle data.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents into an existing array using a type-erased index array
+@m_since_latest
+
+Expects that @p tangents has the same size as @p positions and that the second
+dimension of @p indices is contiguous and represents the actual 1/2/4-byte
+index type. Based on its size then calls one of the
+@ref generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<Vector4>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents for a mesh
+@param mesh         Input mesh
+@param threadCount  Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles with a
+@ref Trade::MeshAttribute::Position, @relativeref{Trade::MeshAttribute,Normal}
+and @relativeref{Trade::MeshAttribute,TextureCoordinates}, which are
+converted to float arrays using @ref Trade::MeshData::positions3DAsArray(),
+@relativeref{Trade::MeshData,normalsAsArray()} and
+@relativeref{Trade::MeshData,textureCoordinates2DAsArray()} and passed together
+with the index buffer to
+@ref generateTangentsInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<Vector4>&, UnsignedInt).
+If the mesh isn't indexed, it's treated as having a trivial index buffer.
+
+The result is a copy of @p mesh made with @ref interleave() with a new
+@ref VertexFormat::Vector4 @ref Trade::MeshAttribute::Tangent added. If there
+are any tangents or bitangents in the mesh already, they're removed, as the
+bitangent can be reconstructed from the normal and the four-component tangent.
+Indices are kept as described in @ref interleave(). Expects that the index
+type and the attribute formats aren't implementation-specific.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateTangents(const Trade::MeshData& mesh, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
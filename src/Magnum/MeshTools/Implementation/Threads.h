@@ -0,0 +1,78 @@
+#ifndef Magnum_MeshTools_Implementation_Threads_h
+#define Magnum_MeshTools_Implementation_Threads_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <thread>
+#else
+#define MAGNUM_MESHTOOLS_NO_THREADS
+#endif
+
+namespace Magnum { namespace MeshTools { namespace Implementation { namespace {
+
+#ifndef MAGNUM_MESHTOOLS_NO_THREADS
+/* Minimal amount of items processed by a single thread */
+constexpr std::size_t MinThreadItemCount = 16384;
+#endif
+
+/* Decide on the thread count. Use just one if the platform doesn't have
+   threads, and at most one thread per MinThreadItemCount items so small
+   inputs don't get slower due to the thread creation overhead. */
+inline std::size_t threadCountFor(const UnsignedInt threadCount, const std::size_t itemCount) {
+    #ifndef MAGNUM_MESHTOOLS_NO_THREADS
+    const std::size_t count = threadCount ? threadCount : Math::max(std::thread::hardware_concurrency(), 1u);
+    return Math::max(Math::min(count, itemCount/MinThreadItemCount), std::size_t{1});
+    #else
+    static_cast<void>(threadCount);
+    static_cast<void>(itemCount);
+    return 1;
+    #endif
+}
+
+/* Calls function(i) for all i in [0, threadCount), the first on the calling
+   thread and the others on worker threads, waiting for all of them to
+   finish */
+template<class Function> void runOnThreads(const std::size_t threadCount, const Function& function) {
+    #ifndef MAGNUM_MESHTOOLS_NO_THREADS
+    Containers::Array<std::thread> threads{threadCount - 1};
+    for(std::size_t i = 1; i != threadCount; ++i)
+        threads[i - 1] = std::thread{function, i};
+    function(0);
+    for(std::thread& thread: threads) thread.join();
+    #else
+    CORRADE_INTERNAL_ASSERT(threadCount == 1);
+    function(0);
+    #endif
+}
+
+}}}}
+
+#endif
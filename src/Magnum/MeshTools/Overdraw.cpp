@@ -0,0 +1,382 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Overdraw.h"
+
+#include <algorithm> /* std::stable_sort() */
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold, const std::size_t cacheSize) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3", );
+    CORRADE_ASSERT(threshold >= 1.0f,
+        "MeshTools::optimizeOverdrawInPlace(): expected threshold to be at least 1 but got" << threshold, );
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::optimizeOverdrawInPlace(): expected a non-zero cache size", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::optimizeOverdrawInPlace(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    /* FIFO post-transform cache simulation, same as in
+       vertexCacheStatistics(). Increasing the time by more than the cache
+       size flushes the cache. */
+    Containers::Array<std::size_t> timestamp{ValueInit, positions.size()};
+    std::size_t time = cacheSize + 1;
+    const auto triangleCacheMisses = [&](const std::size_t triangle) {
+        UnsignedInt misses = 0;
+        for(std::size_t i = triangle*3, end = i + 3; i != end; ++i) {
+            const T v = indices[i];
+            if(time - timestamp[v] > cacheSize) {
+                timestamp[v] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+
+    /* Hard cluster boundaries are at triangles where all three vertices are
+       cache misses, which is where the vertex cache optimizer got to a dead
+       end and had to restart elsewhere */
+    Containers::Array<std::size_t> hardBoundaries;
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        if(triangleCacheMisses(i) == 3 || i == 0)
+            arrayAppend(hardBoundaries, i);
+    arrayAppend(hardBoundaries, triangleCount);
+
+    /* Split each hard cluster further at places where the running ACMR gets
+       below the ACMR of the whole cluster multiplied by the threshold */
+    Containers::Array<std::size_t> clusters;
+    for(std::size_t i = 0; i != hardBoundaries.size() - 1; ++i) {
+        const std::size_t begin = hardBoundaries[i];
+        const std::size_t end = hardBoundaries[i + 1];
+
+        time += cacheSize + 1;
+        std::size_t misses = 0;
+        for(std::size_t j = begin; j != end; ++j)
+            misses += triangleCacheMisses(j);
+        const Float maxAcmr = threshold*Float(misses)/Float(end - begin);
+
+        arrayAppend(clusters, begin);
+        time += cacheSize + 1;
+        std::size_t runningMisses = 0;
+        std::size_t runningCount = 0;
+        for(std::size_t j = begin; j != end; ++j) {
+            runningMisses += triangleCacheMisses(j);
+            ++runningCount;
+            if(Float(runningMisses) <= maxAcmr*Float(runningCount)) {
+                arrayAppend(clusters, j + 1);
+                time += cacheSize + 1;
+                runningMisses = 0;
+                runningCount = 0;
+            }
+        }
+
+        /* The last cluster by definition didn't get below the target ACMR,
+           which means it's usually just a few triangles with a bad ACMR.
+           Merge it with the previous one. If the last triangle happened to
+           get below the target, this removes the boundary at the end, which
+           would otherwise result in an empty cluster. */
+        if(clusters.back() != begin) arrayRemoveSuffix(clusters);
+    }
+    arrayAppend(clusters, triangleCount);
+    const std::size_t clusterCount = clusters.size() - 1;
+
+    /* Calculate the mesh centroid */
+    Vector3 meshCentroid;
+    for(const T index: indices)
+        meshCentroid += positions[index];
+    meshCentroid /= Float(indices.size());
+
+    /* Sort key for each cluster is the distance of its area-weighted
+       centroid from the mesh centroid, projected on its average normal.
+       Clusters on the outside facing outwards have the highest value,
+       clusters facing inwards the lowest. */
+    Containers::Array<Float> clusterSortKey{NoInit, clusterCount};
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        Vector3 centroid;
+        Vector3 normal;
+        Float area = 0.0f;
+        for(std::size_t j = clusters[i]; j != clusters[i + 1]; ++j) {
+            const Vector3 a = positions[indices[j*3 + 0]];
+            const Vector3 b = positions[indices[j*3 + 1]];
+            const Vector3 c = positions[indices[j*3 + 2]];
+            /* Twice the area, but that doesn't matter */
+            const Vector3 triangleNormal = Math::cross(b - a, c - a);
+            const Float triangleArea = triangleNormal.length();
+            centroid += (a + b + c)*triangleArea;
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        const Float normalLength = normal.length();
+        clusterSortKey[i] = area == 0.0f || normalLength == 0.0f ? 0.0f :
+            Math::dot(centroid/(3.0f*area) - meshCentroid, normal/normalLength);
+    }
+
+    /* Sort the clusters by the key, keeping the original order for clusters
+       with the same key */
+    Containers::Array<UnsignedInt> clusterOrder{NoInit, clusterCount};
+    for(std::size_t i = 0; i != clusterCount; ++i)
+        clusterOrder[i] = i;
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](UnsignedInt a, UnsignedInt b) {
+        return clusterSortKey[a] > clusterSortKey[b];
+    });
+
+    /* Copy the clusters to the output in the new order */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+    for(const UnsignedInt cluster: clusterOrder)
+        for(std::size_t i = clusters[cluster]*3, end = clusters[cluster + 1]*3; i != end; ++i)
+            outputIndices[outputIndex++] = indices[i];
+    CORRADE_INTERNAL_ASSERT(outputIndex == indices.size());
+
+    /* Copy the reordered index buffer back */
+    Utility::copy(outputIndices, indices);
+}
+
+/* View bases for estimateOverdraw(), each being the right, up and towards
+   the viewer direction. All of them form a right-handed coordinate system so
+   counter-clockwise triangles stay counter-clockwise in all views. */
+constexpr Vector3 ViewBases[6][3]{
+    {{ 1.0f,  0.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, { 0.0f,  0.0f,  1.0f}},
+    {{-1.0f,  0.0f,  0.0f}, {0.0f,  1.0f,  0.0f}, { 0.0f,  0.0f, -1.0f}},
+    {{ 0.0f,  0.0f, -1.0f}, {0.0f,  1.0f,  0.0f}, { 1.0f,  0.0f,  0.0f}},
+    {{ 0.0f,  0.0f,  1.0f}, {0.0f,  1.0f,  0.0f}, {-1.0f,  0.0f,  0.0f}},
+    {{ 1.0f,  0.0f,  0.0f}, {0.0f,  0.0f, -1.0f}, { 0.0f,  1.0f,  0.0f}},
+    {{ 1.0f,  0.0f,  0.0f}, {0.0f,  0.0f,  1.0f}, { 0.0f, -1.0f,  0.0f}}
+};
+
+template<class T> Float estimateOverdrawImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt resolution) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::estimateOverdraw(): index count not divisible by 3", {});
+    CORRADE_ASSERT(resolution,
+        "MeshTools::estimateOverdraw(): expected a non-zero resolution", {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::estimateOverdraw(): index" << index << "out of bounds for" << positions.size() << "elements", {});
+    #endif
+
+    if(indices.isEmpty()) return 0.0f;
+
+    /* Scale the mesh uniformly so its largest bounding box side spans the
+       whole resolution */
+    const Range3D bounds = boundingRange(positions);
+    const Float extent = bounds.size().max();
+    const Float scale = extent == 0.0f ? 0.0f : Float(resolution)/extent;
+
+    Containers::Array<Vector3> projected{NoInit, positions.size()};
+    Containers::Array<Float> depth{NoInit, std::size_t(resolution)*resolution};
+    std::size_t coveredCount = 0;
+    std::size_t shadedCount = 0;
+    for(const auto& basis: ViewBases) {
+        /* Project the vertices to the view. Directions going against the
+           axis would give negative coordinates, offset them back to the
+           [0, resolution] range. The depth doesn't need to be offset. */
+        const Float offsetX = Float(resolution)*(1.0f - basis[0].sum())*0.5f;
+        const Float offsetY = Float(resolution)*(1.0f - basis[1].sum())*0.5f;
+        for(std::size_t i = 0; i != positions.size(); ++i) {
+            const Vector3 position = (positions[i] - bounds.min())*scale;
+            projected[i] = {
+                Math::dot(position, basis[0]) + offsetX,
+                Math::dot(position, basis[1]) + offsetY,
+                Math::dot(position, basis[2])
+            };
+        }
+
+        for(Float& i: depth) i = -Constants::inf();
+
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            const Vector3 a = projected[indices[i + 0]];
+            const Vector3 b = projected[indices[i + 1]];
+            const Vector3 c = projected[indices[i + 2]];
+
+            /* Skip back-facing and degenerate triangles */
+            const Float area = (b.x() - a.x())*(c.y() - a.y()) - (b.y() - a.y())*(c.x() - a.x());
+            if(!(area > 0.0f)) continue;
+
+            /* For pixel centers lying exactly on an edge, consider the pixel
+               inside only for one of the two directions the edge can have,
+               so pixels on edges shared by two triangles aren't counted
+               twice */
+            const auto includesEdge = [](const Vector3& from, const Vector3& to) {
+                return to.y() < from.y() || (to.y() == from.y() && to.x() < from.x());
+            };
+            const bool includesEdgeA = includesEdge(b, c);
+            const bool includesEdgeB = includesEdge(c, a);
+            const bool includesEdgeC = includesEdge(a, b);
+
+            const Int minX = Math::max(Int(Math::min(a.x(), Math::min(b.x(), c.x()))), 0);
+            const Int minY = Math::max(Int(Math::min(a.y(), Math::min(b.y(), c.y()))), 0);
+            const Int maxX = Math::min(Int(Math::max(a.x(), Math::max(b.x(), c.x()))) + 1, Int(resolution));
+            const Int maxY = Math::min(Int(Math::max(a.y(), Math::max(b.y(), c.y()))) + 1, Int(resolution));
+            for(Int y = minY; y < maxY; ++y) {
+                const Float py = Float(y) + 0.5f;
+                for(Int x = minX; x < maxX; ++x) {
+                    const Float px = Float(x) + 0.5f;
+
+                    /* Edge functions, each being the (twice the) area of the
+                       triangle opposite to given vertex */
+                    const Float wa = (c.x() - b.x())*(py - b.y()) - (c.y() - b.y())*(px - b.x());
+                    const Float wb = (a.x() - c.x())*(py - c.y()) - (a.y() - c.y())*(px - c.x());
+                    const Float wc = (b.x() - a.x())*(py - a.y()) - (b.y() - a.y())*(px - a.x());
+                    if(!(wa > 0.0f || (wa == 0.0f && includesEdgeA)) ||
+                       !(wb > 0.0f || (wb == 0.0f && includesEdgeB)) ||
+                       !(wc > 0.0f || (wc == 0.0f && includesEdgeC)))
+                        continue;
+
+                    /* Early depth test, the pixel is shaded only if it's
+                       closer to the viewer than everything drawn so far */
+                    const Float z = (wa*a.z() + wb*b.z() + wc*c.z())/area;
+                    Float& pixelDepth = depth[std::size_t(y)*resolution + x];
+                    if(z > pixelDepth) {
+                        if(pixelDepth == -Constants::inf()) ++coveredCount;
+                        pixelDepth = z;
+                        ++shadedCount;
+                    }
+                }
+            }
+        }
+    }
+
+    return coveredCount ? Float(shadedCount)/Float(coveredCount) : 0.0f;
+}
+
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold, const std::size_t cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold, const std::size_t cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold, const std::size_t cacheSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, threshold, cacheSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Float threshold, const std::size_t cacheSize) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeOverdrawInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), positions, threshold, cacheSize);
+    else if(indices.size()[1] == 2)
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), positions, threshold, cacheSize);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeOverdrawInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return optimizeOverdrawInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), positions, threshold, cacheSize);
+    }
+}
+
+Trade::MeshData optimizeOverdraw(Trade::MeshData&& mesh, const Float threshold, const std::size_t cacheSize) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeOverdraw(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::optimizeOverdraw(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::optimizeOverdraw(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    /* Make the data owned (which is a passthrough if they already are) and
+       reorder the index buffer directly there */
+    Trade::MeshData out = owned(std::move(mesh));
+    optimizeOverdrawInPlace(out.mutableIndices(), out.positions3DAsArray(), threshold, cacheSize);
+    return out;
+}
+
+Trade::MeshData optimizeOverdraw(const Trade::MeshData& mesh, const Float threshold, const std::size_t cacheSize) {
+    /* Pass through to the && overload, which then decides whether to reuse
+       anything based on the DataFlags */
+    return optimizeOverdraw(reference(mesh), threshold, cacheSize);
+}
+
+Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt resolution) {
+    return estimateOverdrawImplementation(indices, positions, resolution);
+}
+
+Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt resolution) {
+    return estimateOverdrawImplementation(indices, positions, resolution);
+}
+
+Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt resolution) {
+    return estimateOverdrawImplementation(indices, positions, resolution);
+}
+
+Float estimateOverdraw(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt resolution) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::estimateOverdraw(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return estimateOverdrawImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), positions, resolution);
+    else if(indices.size()[1] == 2)
+        return estimateOverdrawImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), positions, resolution);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::estimateOverdraw(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return estimateOverdrawImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), positions, resolution);
+    }
+}
+
+Float estimateOverdraw(const Trade::MeshData& mesh, const UnsignedInt resolution) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::estimateOverdraw(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(), {});
+    CORRADE_ASSERT(!mesh.isIndexed() || !isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::estimateOverdraw(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())), {});
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::estimateOverdraw(): the mesh has no positions", {});
+
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    if(mesh.isIndexed())
+        return estimateOverdraw(mesh.indices(), positions, resolution);
+
+    /* Non-indexed meshes are drawn in the vertex order */
+    Containers::Array<UnsignedInt> indices{NoInit, mesh.vertexCount()};
+    for(UnsignedInt i = 0; i != indices.size(); ++i)
+        indices[i] = i;
+    return estimateOverdraw(indices, positions, resolution);
+}
+
+}}
@@ -0,0 +1,189 @@
+#ifndef Magnum_MeshTools_Overdraw_h
+#define Magnum_MeshTools_Overdraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeOverdrawInPlace(), @ref Magnum::MeshTools::optimizeOverdraw(), @ref Magnum::MeshTools::estimateOverdraw()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Reorder triangle clusters to reduce overdraw in-place
+@param[in,out] indices  Triangle index array to operate on
+@param[in] positions    Vertex positions
+@param[in] threshold    Cache efficiency threshold
+@param[in] cacheSize    Post-transform vertex cache size
+@m_since_latest
+
+Splits the index buffer into clusters of triangles and reorders them so
+clusters that are likely to occlude other parts of the mesh are drawn first,
+independently of the view direction. Algorithm used: *Pedro V. Sander, Diego
+Nehab, and Joshua Barczak --- Fast Triangle Reordering for Vertex Locality and
+Reduced Overdraw, SIGGRAPH 2007,
+https://gfx.cs.princeton.edu/pubs/Sander_2007_%3eTR/tipsy.pdf*.
+
+The index buffer is expected to be already optimized for the post-transform
+vertex cache using @ref optimizeVertexCacheInPlace() or @ref tipsifyInPlace()
+with the same @p cacheSize. It's first split into clusters at places where all
+three vertices of a triangle are cache misses, which is where the vertex cache
+optimizer had to restart. Each such cluster is then further split into smaller
+ones as soon as their average cache miss ratio gets below the ACMR of the
+whole cluster multiplied by @p threshold. A value of @cpp 1.0f @ce thus
+produces fewer larger clusters and preserves the vertex cache efficiency
+almost exactly, while higher values produce more smaller clusters and result
+in less overdraw at the cost of more vertex shader invocations. Clusters are
+then sorted by a dot product of the cluster normal and a direction from the
+mesh centroid to the cluster centroid, putting clusters facing outwards
+first. Triangles inside the clusters keep their order and winding.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than size of @p positions, @p threshold is at least @cpp 1.0f @ce and
+@p cacheSize is not zero.
+@see @ref estimateOverdraw(), @ref vertexCacheStatistics()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+@brief Reorder triangle clusters of a type-erased index array to reduce overdraw in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, Float, std::size_t)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+@brief Reorder triangle clusters of a mesh to reduce overdraw
+@m_since_latest
+
+Expects that the mesh is an indexed @ref MeshPrimitive::Triangles with a
+@ref Trade::MeshAttribute::Position, which is converted to a 3D vector
+array using @ref Trade::MeshData::positions3DAsArray() and then passed
+together with the index buffer to
+@ref optimizeOverdrawInPlace(const Containers::StridedArrayView2D<char>&, const Containers::StridedArrayView1D<const Vector3>&, Float, std::size_t).
+The index type and vertex data are preserved. This function will unconditionally
+make a copy of all data, use @ref optimizeOverdraw(Trade::MeshData&&, Float, std::size_t)
+to avoid copies of already owned data.
+@see @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(const Trade::MeshData& mesh, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+@brief Reorder triangle clusters of a mesh to reduce overdraw
+@m_since_latest
+
+Compared to @ref optimizeOverdraw(const Trade::MeshData&, Float, std::size_t)
+this function can reuse the index and vertex data if they're owned and
+modifies the index data directly in that case.
+@see @ref Trade::MeshData::indexDataFlags(),
+    @ref Trade::MeshData::vertexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(Trade::MeshData&& mesh, Float threshold = 1.05f, std::size_t cacheSize = 32);
+
+/**
+@brief Estimate overdraw of a triangle mesh
+@param indices      Triangle index array
+@param positions    Vertex positions
+@param resolution   Resolution of the rasterized views
+@return Ratio of shaded fragments and covered pixels
+@m_since_latest
+
+Rasterizes the mesh with back-face culling and a depth test, in the order
+given by @p indices, into @p resolution × @p resolution orthographic views
+along all six positive and negative axes, fitting the mesh bounding box. The
+fragments that pass the depth test are counted as shaded, the result is their
+count divided by count of pixels covered by the mesh. The result is thus
+@cpp 1.0f @ce if no pixel gets shaded more than once, and larger values
+indicate more overdraw. If the mesh doesn't cover any pixels, returns
+@cpp 0.0f @ce. Counter-clockwise triangles are considered front-facing.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than size of @p positions and @p resolution is not zero.
+@see @ref optimizeOverdrawInPlace(), @ref vertexCacheStatistics()
+*/
+MAGNUM_MESHTOOLS_EXPORT Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt resolution = 256);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt resolution = 256);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Float estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt resolution = 256);
+
+/**
+@brief Estimate overdraw of a triangle mesh with a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref estimateOverdraw(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Float estimateOverdraw(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt resolution = 256);
+
+/**
+@brief Estimate overdraw of a mesh
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles with a
+@ref Trade::MeshAttribute::Position, which is converted to a 3D vector array
+using @ref Trade::MeshData::positions3DAsArray() and then passed to
+@ref estimateOverdraw(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt).
+If the mesh isn't indexed, the vertices are drawn in order.
+@see @ref isMeshIndexTypeImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Float estimateOverdraw(const Trade::MeshData& mesh, UnsignedInt resolution = 256);
+
+}}
+
+#endif
@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <type_traits>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
+
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/FilterAttributes.h"
+#include "Magnum/MeshTools/Interleave.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Bounding box offset and size, with zero sizes replaced by 1 so the
+   dequantization matrix stays invertible */
+template<class T> std::pair<T, T> boundsOffsetSize(const Containers::StridedArrayView1D<const T>& values, const bool centered) {
+    const std::pair<T, T> minmax = Math::minmax(values);
+    T size = minmax.second - minmax.first;
+    for(std::size_t i = 0; i != T::Size; ++i)
+        if(size[i] == 0.0f) size[i] = 1.0f;
+
+    /* For signed output the [-1, 1] range maps to the bounding box, so the
+       offset is the center and the size is halved */
+    if(centered) return {(minmax.first + minmax.second)*0.5f, size*0.5f};
+    return {minmax.first, size};
+}
+
+template<class T> Matrix4 quantizePositionsIntoImplementation(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<T>& quantized) {
+    CORRADE_ASSERT(quantized.size() == positions.size(),
+        "MeshTools::quantizePositionsInto(): bad output size, expected" << positions.size() << "but got" << quantized.size(), {});
+
+    constexpr bool IsSigned = std::is_signed<typename T::Type>::value;
+    const std::pair<Vector3, Vector3> offsetSize = boundsOffsetSize(positions, IsSigned);
+    const Vector3 min{IsSigned ? -1.0f : 0.0f};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        quantized[i] = Math::pack<T>(Math::clamp((positions[i] - offsetSize.first)/offsetSize.second, min, Vector3{1.0f}));
+
+    return Matrix4::translation(offsetSize.first)*Matrix4::scaling(offsetSize.second);
+}
+
+/* Math::sign() returns 0 for 0, here both zeros are treated as positive */
+inline Vector2 signNotZero(const Vector2& value) {
+    return {value.x() >= 0.0f ? 1.0f : -1.0f,
+            value.y() >= 0.0f ? 1.0f : -1.0f};
+}
+
+template<class T> void quantizeNormalsOctahedralIntoImplementation(const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<T>& quantized) {
+    CORRADE_ASSERT(quantized.size() == normals.size(),
+        "MeshTools::quantizeNormalsOctahedralInto(): bad output size, expected" << normals.size() << "but got" << quantized.size(), );
+
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Vector3& normal = normals[i];
+        const Float sum = Math::abs(normal.x()) + Math::abs(normal.y()) + Math::abs(normal.z());
+        if(sum == 0.0f) {
+            quantized[i] = {};
+            continue;
+        }
+
+        /* Project onto the octahedron, then fold the lower half over the
+           diagonals */
+        Vector2 encoded = normal.xy()/sum;
+        if(normal.z() < 0.0f)
+            encoded = (Vector2{1.0f} - Math::abs(Vector2{encoded.y(), encoded.x()}))*signNotZero(encoded);
+
+        quantized[i] = Math::pack<T>(encoded);
+    }
+}
+
+template<class T> void dequantizeNormalsOctahedralIntoImplementation(const Containers::StridedArrayView1D<const T>& quantized, const Containers::StridedArrayView1D<Vector3>& normals) {
+    CORRADE_ASSERT(normals.size() == quantized.size(),
+        "MeshTools::dequantizeNormalsOctahedralInto(): bad output size, expected" << quantized.size() << "but got" << normals.size(), );
+
+    for(std::size_t i = 0; i != quantized.size(); ++i) {
+        const Vector2 encoded = Math::unpack<Vector2>(quantized[i]);
+        Vector3 normal{encoded, 1.0f - Math::abs(encoded.x()) - Math::abs(encoded.y())};
+        const Float t = Math::max(-normal.z(), 0.0f);
+        normal.xy() -= signNotZero(normal.xy())*t;
+        normals[i] = normal.normalized();
+    }
+}
+
+}
+
+Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3us>& quantized) {
+    return quantizePositionsIntoImplementation(positions, quantized);
+}
+
+Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3s>& quantized) {
+    return quantizePositionsIntoImplementation(positions, quantized);
+}
+
+void quantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector2s>& quantized) {
+    quantizeNormalsOctahedralIntoImplementation(normals, quantized);
+}
+
+void quantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector2b>& quantized) {
+    quantizeNormalsOctahedralIntoImplementation(normals, quantized);
+}
+
+void dequantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector2s>& quantized, const Containers::StridedArrayView1D<Vector3>& normals) {
+    dequantizeNormalsOctahedralIntoImplementation(quantized, normals);
+}
+
+void dequantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector2b>& quantized, const Containers::StridedArrayView1D<Vector3>& normals) {
+    dequantizeNormalsOctahedralIntoImplementation(quantized, normals);
+}
+
+Matrix3 quantizeTextureCoordinatesInto(const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector2us>& quantized) {
+    CORRADE_ASSERT(quantized.size() == textureCoordinates.size(),
+        "MeshTools::quantizeTextureCoordinatesInto(): bad output size, expected" << textureCoordinates.size() << "but got" << quantized.size(), {});
+
+    const std::pair<Vector2, Vector2> offsetSize = boundsOffsetSize(textureCoordinates, false);
+    for(std::size_t i = 0; i != textureCoordinates.size(); ++i)
+        quantized[i] = Math::pack<Vector2us>(Math::clamp((textureCoordinates[i] - offsetSize.first)/offsetSize.second, Vector2{0.0f}, Vector2{1.0f}));
+
+    return Matrix3::translation(offsetSize.first)*Matrix3::scaling(offsetSize.second);
+}
+
+Containers::Triple<Trade::MeshData, Matrix4, Matrix3> quantize(const Trade::MeshData& mesh, const QuantizeFlags flags) {
+    const Containers::Optional<UnsignedInt> positionAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Position);
+    const Containers::Optional<UnsignedInt> normalAttributeId = mesh.findAttributeId(Trade::MeshAttribute::Normal);
+    const Containers::Optional<UnsignedInt> textureCoordinateAttributeId = mesh.findAttributeId(Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_ASSERT(!positionAttributeId ||
+        isVertexFormatImplementationSpecific(mesh.attributeFormat(*positionAttributeId)) ||
+        vertexFormatComponentCount(mesh.attributeFormat(*positionAttributeId)) == 3,
+        "MeshTools::quantize(): expected 3D positions but got" << mesh.attributeFormat(*positionAttributeId),
+        (Containers::Triple<Trade::MeshData, Matrix4, Matrix3>{Trade::MeshData{MeshPrimitive::Triangles, 0}, {}, {}}));
+
+    /* Remove the attributes that get quantized and add their quantized
+       variants to the end */
+    Containers::Array<UnsignedInt> removed;
+    Containers::Array<Trade::MeshAttributeData> extra;
+    if(positionAttributeId) {
+        arrayAppend(removed, *positionAttributeId);
+        arrayAppend(extra, Trade::MeshAttributeData{Trade::MeshAttribute::Position, flags & QuantizeFlag::SignedPositions ? VertexFormat::Vector3sNormalized : VertexFormat::Vector3usNormalized, nullptr});
+    }
+    if(normalAttributeId) {
+        arrayAppend(removed, *normalAttributeId);
+        arrayAppend(extra, Trade::MeshAttributeData{MeshAttributeOctahedralNormal, flags & QuantizeFlag::Normals8Bit ? VertexFormat::Vector2bNormalized : VertexFormat::Vector2sNormalized, nullptr});
+    }
+    if(textureCoordinateAttributeId) {
+        arrayAppend(removed, *textureCoordinateAttributeId);
+        arrayAppend(extra, Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, VertexFormat::Vector2usNormalized, nullptr});
+    }
+
+    /* Not preserving the original layout, as that would keep the space
+       occupied by the original floating-point attributes */
+    Trade::MeshData out = interleave(filterExceptAttributes(mesh, removed), extra, {});
+
+    UnsignedInt id = out.attributeCount() - extra.size();
+    Matrix4 positionMatrix;
+    if(positionAttributeId) {
+        const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+        if(flags & QuantizeFlag::SignedPositions)
+            positionMatrix = quantizePositionsInto(positions, out.mutableAttribute<Vector3s>(id++));
+        else
+            positionMatrix = quantizePositionsInto(positions, out.mutableAttribute<Vector3us>(id++));
+    }
+    if(normalAttributeId) {
+        const Containers::Array<Vector3> normals = mesh.normalsAsArray();
+        if(flags & QuantizeFlag::Normals8Bit)
+            quantizeNormalsOctahedralInto(normals, out.mutableAttribute<Vector2b>(id++));
+        else
+            quantizeNormalsOctahedralInto(normals, out.mutableAttribute<Vector2s>(id++));
+    }
+    Matrix3 textureCoordinateMatrix;
+    if(textureCoordinateAttributeId)
+        textureCoordinateMatrix = quantizeTextureCoordinatesInto(mesh.textureCoordinates2DAsArray(), out.mutableAttribute<Vector2us>(id++));
+
+    return {std::move(out), positionMatrix, textureCoordinateMatrix};
+}
+
+}}
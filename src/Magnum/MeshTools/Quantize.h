@@ -0,0 +1,241 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantizePositionsInto(), @ref Magnum::MeshTools::quantizeNormalsOctahedralInto(), @ref Magnum::MeshTools::dequantizeNormalsOctahedralInto(), @ref Magnum::MeshTools::quantizeTextureCoordinatesInto(), @ref Magnum::MeshTools::quantize(), enum @ref Magnum::MeshTools::QuantizeFlag, enum set @ref Magnum::MeshTools::QuantizeFlags, constant @ref Magnum::MeshTools::MeshAttributeOctahedralNormal
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Octahedral normal attribute
+@m_since_latest
+
+@ref VertexFormat::Vector2sNormalized or @ref VertexFormat::Vector2bNormalized
+containing a normal encoded with @ref quantizeNormalsOctahedralInto(). As
+builtin normal attributes can only be three-component, this attribute replaces
+@ref Trade::MeshAttribute::Normal in meshes produced by @ref quantize(). Use
+@ref dequantizeNormalsOctahedralInto() to decode the normals on the CPU, see
+its documentation for an equivalent shader code.
+
+The attribute ID is taken from the custom range reserved for Magnum, see
+@ref Trade::MeshAttribute for the list of IDs that are already in use.
+*/
+constexpr Trade::MeshAttribute MeshAttributeOctahedralNormal = Trade::meshAttributeCustom(32751);
+
+/**
+@brief Quantize positions
+@param[in]  positions   Input positions
+@param[out] quantized   Where to put the quantized positions
+@return Dequantization matrix
+@m_since_latest
+
+Positions are normalized against their axis-aligned bounding box and packed
+with @ref Math::pack() so each component covers the whole 16-bit range. The
+output is meant to be interpreted as @ref VertexFormat::Vector3usNormalized,
+which the returned matrix scales and translates back to the original bounding
+box. Multiply it into the transformation of given mesh, as it has in general a
+non-uniform scale, the normal matrix has to be calculated from the original
+transformation without it. If the bounding box has a zero size in some
+dimension, the matrix has a scale of @cpp 1.0f @ce in that dimension. If
+@p positions are empty, an identity matrix is returned.
+
+Expects that both views have the same size.
+@see @ref quantize(), @ref Math::Matrix4::normalMatrix()
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3us>& quantized);
+
+/**
+@brief Quantize positions into signed integers
+@m_since_latest
+
+Like @ref quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3us>&),
+but the output is meant to be interpreted as
+@ref VertexFormat::Vector3sNormalized, with the center of the bounding box
+mapped to zero.
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix4 quantizePositionsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3s>& quantized);
+
+/**
+@brief Quantize normals using octahedral encoding
+@param[in]  normals     Input normals
+@param[out] quantized   Where to put the quantized normals
+@m_since_latest
+
+Projects the normals onto an octahedron that's then unfolded into a square, as
+described in *Quirin Meyer, Jochen Süßmuth, Gerd Sußner, Marc Stamminger,
+Günther Greiner --- On Floating-Point Normal Vectors, EGSR 2010*. Compared to
+@ref VertexFormat::Vector3sNormalized the output takes only two thirds of the
+memory while having a more uniform precision. The output is meant to be
+interpreted as @ref VertexFormat::Vector2sNormalized and decoded with
+@ref dequantizeNormalsOctahedralInto(). Zero-length normals are encoded to a
+value that decodes to @f$ (0, 0, 1)^T @f$.
+
+Expects that both views have the same size. The input normals don't need to be
+normalized.
+@see @ref quantize(), @ref MeshAttributeOctahedralNormal
+*/
+MAGNUM_MESHTOOLS_EXPORT void quantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector2s>& quantized);
+
+/**
+ * @overload
+ * @m_since_latest
+ *
+ * Output is meant to be interpreted as @ref VertexFormat::Vector2bNormalized.
+ * The precision is sufficient for lighting of most models, but not for
+ * smooth surfaces with sharp highlights.
+ */
+MAGNUM_MESHTOOLS_EXPORT void quantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector2b>& quantized);
+
+/**
+@brief Dequantize octahedral-encoded normals
+@param[in]  quantized   Normals encoded with @ref quantizeNormalsOctahedralInto()
+@param[out] normals     Where to put the normalized output
+@m_since_latest
+
+Equivalent to the following GLSL code, where @glsl e @ce is the encoded value
+already unpacked to the @f$ [-1, 1] @f$ range:
+
+@code{.glsl}
+vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+float t = max(-n.z, 0.0);
+n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+n = normalize(n);
+@endcode
+
+Expects that both views have the same size.
+*/
+MAGNUM_MESHTOOLS_EXPORT void dequantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector2s>& quantized, const Containers::StridedArrayView1D<Vector3>& normals);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void dequantizeNormalsOctahedralInto(const Containers::StridedArrayView1D<const Vector2b>& quantized, const Containers::StridedArrayView1D<Vector3>& normals);
+
+/**
+@brief Quantize texture coordinates
+@param[in]  textureCoordinates  Input texture coordinates
+@param[out] quantized           Where to put the quantized texture coordinates
+@return Dequantization matrix
+@m_since_latest
+
+Texture coordinates are normalized against their bounding rectangle and packed
+with @ref Math::pack() so each component covers the whole 16-bit range. The
+output is meant to be interpreted as @ref VertexFormat::Vector2usNormalized,
+the returned matrix scales and translates them back to the original range and
+can be used directly as a texture transformation, for example with
+@ref Shaders::PhongGL::setTextureMatrix(), multiplied with any existing texture
+transformation. Contrary to @ref VertexFormat::Vector2h, the precision is
+the same over the whole range. If the bounding rectangle has a zero size in
+some dimension, the matrix has a scale of @cpp 1.0f @ce in that dimension. If
+@p textureCoordinates are empty, an identity matrix is returned.
+
+Expects that both views have the same size.
+@see @ref quantize()
+*/
+MAGNUM_MESHTOOLS_EXPORT Matrix3 quantizeTextureCoordinatesInto(const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector2us>& quantized);
+
+/**
+@brief Mesh quantization flag
+@m_since_latest
+
+@see @ref QuantizeFlags, @ref quantize()
+*/
+enum class QuantizeFlag: UnsignedByte {
+    /**
+     * Quantize positions to @ref VertexFormat::Vector3sNormalized instead of
+     * @ref VertexFormat::Vector3usNormalized, with the bounding box center
+     * mapped to zero.
+     */
+    SignedPositions = 1 << 0,
+
+    /**
+     * Quantize normals to @ref VertexFormat::Vector2bNormalized instead of
+     * @ref VertexFormat::Vector2sNormalized.
+     */
+    Normals8Bit = 1 << 1
+};
+
+/**
+@brief Mesh quantization flags
+@m_since_latest
+
+@see @ref quantize()
+*/
+typedef Containers::EnumSet<QuantizeFlag> QuantizeFlags;
+
+CORRADE_ENUMSET_OPERATORS(QuantizeFlags)
+
+/**
+@brief Quantize a mesh
+@return The quantized mesh, position dequantization matrix and texture
+    coordinate dequantization matrix
+@m_since_latest
+
+If the mesh has a @ref Trade::MeshAttribute::Position, it's quantized with
+@ref quantizePositionsInto() to @ref VertexFormat::Vector3usNormalized, or to
+@ref VertexFormat::Vector3sNormalized if @ref QuantizeFlag::SignedPositions is
+set. If the mesh has a @ref Trade::MeshAttribute::Normal, it's replaced with a
+@ref MeshAttributeOctahedralNormal produced by
+@ref quantizeNormalsOctahedralInto() in a
+@ref VertexFormat::Vector2sNormalized, or in a
+@ref VertexFormat::Vector2bNormalized if @ref QuantizeFlag::Normals8Bit is
+set. If the mesh has a @ref Trade::MeshAttribute::TextureCoordinates, it's
+quantized with @ref quantizeTextureCoordinatesInto() to
+@ref VertexFormat::Vector2usNormalized. If there's more than one attribute of
+given kind, only the first one is quantized, the remaining ones as well as all
+other attributes are passed through unchanged. The quantized attributes are
+put after all other attributes. If the mesh doesn't have positions or texture
+coordinates, the corresponding returned matrix is an identity.
+
+Compared to a mesh with @ref VertexFormat::Vector3 positions and normals and
+@ref VertexFormat::Vector2 texture coordinates, which takes 32 bytes per
+vertex, the quantized mesh takes 14 bytes with the default flags and 12 bytes
+with @ref QuantizeFlag::Normals8Bit. The index buffer, if any, is passed
+through unchanged.
+
+Expects that the positions, if present, are three-component. The output has
+an interleaved vertex layout with no padding as produced by
+@ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
+without @ref InterleaveFlag::PreserveInterleavedAttributes, which means no
+attribute can have an implementation-specific format. This function will
+unconditionally make a copy of all vertex data.
+@see @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Triple<Trade::MeshData, Matrix4, Matrix3> quantize(const Trade::MeshData& mesh, QuantizeFlags flags = {});
+
+}}
+
+#endif
@@ -25,43 +25,255 @@
 
 #include "RemoveDuplicates.h"
 
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <numeric>
-#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Implementation/Threads.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools {
 
-struct ArrayEqual {
-    explicit ArrayEqual(std::size_t size): _size{size} {}
+namespace {
 
-    bool operator()(const void* a, const void* b) const {
-        return std::memcmp(a, b, _size) == 0;
+/* Hash for small keys, consuming eight bytes at a time with a rotate-xor-
+   multiply step and finishing with the 64-bit avalanche mix from
+   MurmurHash3. For keys with a compile-time size the loop gets fully
+   unrolled, making it considerably faster than a generic MurmurHash2 for the
+   typical 4- to 32-byte vertex data. */
+inline std::uint64_t hashKey(const char* const key, const std::size_t size) {
+    constexpr std::uint64_t Multiplier = 0x9e3779b97f4a7c15ull;
+    std::uint64_t hash = size*Multiplier;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8) {
+        std::uint64_t value;
+        std::memcpy(&value, key + i, 8);
+        hash = (((hash << 5)|(hash >> 59)) ^ value)*Multiplier;
+    }
+    if(i != size) {
+        std::uint64_t value = 0;
+        std::memcpy(&value, key + i, size - i);
+        hash = (((hash << 5)|(hash >> 59)) ^ value)*Multiplier;
     }
 
-    private: std::size_t _size;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/* Flat open-addressing hash table with linear probing. It doesn't store the
+   keys, only indices of rows in an external strided array where the keys
+   are, together with upper 32 bits of their hash to avoid most of the key
+   comparisons. It's sized up front for the worst case of all keys being
+   unique, with load factor at most 3/4, so it never needs to grow and there's
+   always at least one empty slot to terminate the probing. If KeySize is
+   non-zero, it's used instead of the runtime key size to allow the compiler
+   to specialize the hashing and comparison. */
+template<std::size_t KeySize> class FlatHashTable {
+    public:
+        explicit FlatHashTable(const void* const data, const std::ptrdiff_t stride, const std::size_t keySize, const std::size_t maxSize): _data{static_cast<const char*>(data)}, _stride{stride}, _keySize{keySize} {
+            CORRADE_INTERNAL_ASSERT(!KeySize || KeySize == keySize);
+            std::size_t capacity = 1;
+            while(capacity < maxSize + maxSize/3 + 1) capacity <<= 1;
+            _mask = capacity - 1;
+            _slots = Containers::Array<Slot>{NoInit, capacity};
+            clear();
+        }
+
+        std::size_t size() const { return _size; }
+
+        void clear() {
+            for(Slot& slot: _slots) slot.index = Empty;
+            _size = 0;
+        }
+
+        /* If a key equal to the one at row `index` is already present, returns
+           the row index it was inserted with, otherwise inserts it and returns
+           `index` */
+        UnsignedInt insert(const UnsignedInt index) {
+            return insert(index, hashKey(_data + std::ptrdiff_t(index)*_stride, KeySize ? KeySize : _keySize));
+        }
+
+        /* Same as above, but with the hash calculated by hashKey() already */
+        UnsignedInt insert(const UnsignedInt index, const std::uint64_t hash) {
+            const std::size_t keySize = KeySize ? KeySize : _keySize;
+            const char* const key = _data + std::ptrdiff_t(index)*_stride;
+            const UnsignedInt tag = hash >> 32;
+            for(std::size_t i = hash & _mask; ; i = (i + 1) & _mask) {
+                Slot& slot = _slots[i];
+                if(slot.index == Empty) {
+                    slot.tag = tag;
+                    slot.index = index;
+                    ++_size;
+                    return index;
+                }
+
+                if(slot.tag == tag && std::memcmp(_data + std::ptrdiff_t(slot.index)*_stride, key, keySize) == 0)
+                    return slot.index;
+            }
+        }
+
+        /* If a key equal to the one at row `index` is present, returns the
+           row index it was inserted with, otherwise returns
+           ~UnsignedInt{} */
+        UnsignedInt find(const UnsignedInt index) const {
+            const std::size_t keySize = KeySize ? KeySize : _keySize;
+            const char* const key = _data + std::ptrdiff_t(index)*_stride;
+            const std::uint64_t hash = hashKey(key, keySize);
+            const UnsignedInt tag = hash >> 32;
+            for(std::size_t i = hash & _mask; ; i = (i + 1) & _mask) {
+                const Slot& slot = _slots[i];
+                if(slot.index == Empty) return Empty;
+
+                if(slot.tag == tag && std::memcmp(_data + std::ptrdiff_t(slot.index)*_stride, key, keySize) == 0)
+                    return slot.index;
+            }
+        }
+
+    private:
+        enum: UnsignedInt { Empty = ~UnsignedInt{} };
+
+        struct Slot {
+            UnsignedInt tag;
+            UnsignedInt index;
+        };
+
+        const char* _data;
+        std::ptrdiff_t _stride;
+        std::size_t _keySize;
+        std::size_t _mask;
+        std::size_t _size;
+        Containers::Array<Slot> _slots;
 };
 
-struct ArrayHash {
-    explicit ArrayHash(std::size_t size): _size{size} {}
+template<std::size_t KeySize> std::size_t removeDuplicatesIntoImplementation(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    /* Table containing index of first occurrence for each unique entry. The
+       inserted index points into the original unchanged data array. */
+    const std::size_t dataSize = data.size()[0];
+    FlatHashTable<KeySize> table{data.data(), data.stride()[0], data.size()[1], dataSize};
+
+    /* Go through all entries and put the (either new or already existing)
+       index into the output index array */
+    for(std::size_t i = 0; i != dataSize; ++i)
+        indices[i] = table.insert(i);
+
+    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
+    return table.size();
+}
+
+template<std::size_t KeySize> std::size_t removeDuplicatesInPlaceIntoImplementation(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    /* Table containing index of first occurrence for each unique entry */
+    const std::size_t dataSize = data.size()[0];
+    FlatHashTable<KeySize> table{data.data(), data.stride()[0], data.size()[1], dataSize};
 
-    std::size_t operator()(const void* a) const {
-        return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2{}(static_cast<const char*>(a), _size).byteArray());
+    /* Go through all entries and insert them into the table. The table
+       doesn't store a copy of the keys, only a row index. The rows are in the
+       original data that we mutate in-place, so extra care needs to be taken
+       to prevent already-inserted keys from getting modified. */
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        /* First copy the key data to a potentially final no-longer-mutable
+           place (except if the source and target location is the same). Data
+           in [table.size()-1, i) is already present in the [0, table.size()-1)
+           range from previous iterations so we aren't overwriting anything. If
+           insertion succeeds, this location will not be touched ever again; if
+           it fails the location isn't used as a key anywhere and so it can be
+           reused next time for a different key.
+
+           Alternatively we could first look the key up and only then
+           conditionally do a copy() and insert, but that means the hash &
+           search would be performed twice, which is never faster than a plain
+           memory copy. */
+        const std::size_t unique = table.size();
+        if(i != unique)
+            Utility::copy(data[i].asContiguous(), data[unique].asContiguous());
+
+        /* Insert the new entry into the table. If it succeeds, the row is
+           guaranteed to not change anymore. Put the (either new or already
+           existing) index into the output index array. */
+        indices[i] = table.insert(unique);
     }
 
-    private: std::size_t _size;
-};
+    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
+    return table.size();
+}
+
+/* Parallel variant of removeDuplicatesIntoImplementation(), producing the
+   exact same output. The input is split into contiguous ranges, one per
+   thread, for which the hashes are calculated. The items are then scattered
+   into shards by their hash, with each shard keeping the original item
+   order, and every shard is deduplicated on its own thread. As all equal
+   items land in the same shard, the first occurrence found in the shard is
+   the first occurrence in the whole input. */
+template<std::size_t KeySize> std::size_t removeDuplicatesIntoParallelImplementation(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const std::size_t threadCount) {
+    const std::size_t dataSize = data.size()[0];
+    const std::size_t keySize = data.size()[1];
+    const char* const begin = static_cast<const char*>(data.data());
+    const std::ptrdiff_t stride = data.stride()[0];
+
+    /* Shard is picked from the upper 32 bits of the hash, while the hash
+       table uses the lower bits for the slot position */
+    const auto shardFor = [threadCount](const std::uint64_t hash) {
+        return std::size_t(((hash >> 32)*threadCount) >> 32);
+    };
+
+    /* Calculate hashes and count how many items of each range go to which
+       shard. The counts are stored shard-major so a prefix sum over them gives
+       an offset for each range in each shard directly. */
+    Containers::Array<std::uint64_t> hashes{NoInit, dataSize};
+    Containers::Array<std::size_t> offsets{ValueInit, threadCount*threadCount + 1};
+    Implementation::runOnThreads(threadCount, [&](const std::size_t range) {
+        const std::size_t rangeEnd = dataSize*(range + 1)/threadCount;
+        for(std::size_t i = dataSize*range/threadCount; i != rangeEnd; ++i) {
+            const std::uint64_t hash = hashKey(begin + std::ptrdiff_t(i)*stride, KeySize ? KeySize : keySize);
+            hashes[i] = hash;
+            ++offsets[shardFor(hash)*threadCount + range + 1];
+        }
+    });
+    for(std::size_t i = 1; i != offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    /* Scatter the items into shards, preserving their order */
+    Containers::Array<UnsignedInt> shardItems{NoInit, dataSize};
+    Implementation::runOnThreads(threadCount, [&](const std::size_t range) {
+        Containers::Array<std::size_t> cursors{NoInit, threadCount};
+        for(std::size_t shard = 0; shard != threadCount; ++shard)
+            cursors[shard] = offsets[shard*threadCount + range];
+        const std::size_t rangeEnd = dataSize*(range + 1)/threadCount;
+        for(std::size_t i = dataSize*range/threadCount; i != rangeEnd; ++i)
+            shardItems[cursors[shardFor(hashes[i])]++] = i;
+    });
+
+    /* Deduplicate each shard. The table again contains index of first
+       occurrence for each unique entry, pointing into the original unchanged
+       data array. */
+    Containers::Array<std::size_t> uniqueCounts{NoInit, threadCount};
+    Implementation::runOnThreads(threadCount, [&](const std::size_t shard) {
+        const Containers::ArrayView<const UnsignedInt> items = shardItems.slice(offsets[shard*threadCount], offsets[(shard + 1)*threadCount]);
+        FlatHashTable<KeySize> table{begin, stride, keySize, items.size()};
+        for(const UnsignedInt i: items)
+            indices[i] = table.insert(i, hashes[i]);
+        uniqueCounts[shard] = table.size();
+    });
+
+    std::size_t uniqueCount = 0;
+    for(const std::size_t count: uniqueCounts) uniqueCount += count;
+    CORRADE_INTERNAL_ASSERT(dataSize >= uniqueCount);
+    return uniqueCount;
+}
+
+}
 
 std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
     /* Assuming the second dimension is contiguous so we can calculate the
@@ -73,28 +285,17 @@ std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
-
-    /* Go through all entries */
-    for(std::size_t i = 0; i != dataSize; ++i) {
-        /* Try to insert new entry into the table. The inserted index points
-           into the original unchanged data array. */
-        const Containers::ArrayView<const char> entry = data[i].asContiguous();
-        const auto result = table.emplace(entry, i);
-
-        /* Put the (either new or already existing) index into the output
-           index array */
-        indices[i] = result.first->second;
+    /* Specialize for the most common vertex and index sizes */
+    switch(data.size()[1]) {
+        case 4: return removeDuplicatesIntoImplementation<4>(data, indices);
+        case 8: return removeDuplicatesIntoImplementation<8>(data, indices);
+        case 12: return removeDuplicatesIntoImplementation<12>(data, indices);
+        case 16: return removeDuplicatesIntoImplementation<16>(data, indices);
+        case 24: return removeDuplicatesIntoImplementation<24>(data, indices);
+        case 32: return removeDuplicatesIntoImplementation<32>(data, indices);
     }
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    return removeDuplicatesIntoImplementation<0>(data, indices);
 }
 
 std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Containers::StridedArrayView2D<const char>& data) {
@@ -103,6 +304,33 @@ std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicates(const Co
     return {std::move(indices), size};
 }
 
+std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(data.isEmpty()[0] || data.isContiguous<1>(),
+        "MeshTools::removeDuplicatesInto(): second data view dimension is not contiguous", {});
+
+    const std::size_t dataSize = data.size()[0];
+    CORRADE_ASSERT(indices.size() == dataSize,
+        "MeshTools::removeDuplicatesInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+
+    /* If there's not enough data to make use of more than one thread, defer
+       to the serial variant */
+    const std::size_t actualThreadCount = Implementation::threadCountFor(threadCount, dataSize);
+    if(actualThreadCount == 1)
+        return removeDuplicatesInto(data, indices);
+
+    /* Specialize for the most common vertex and index sizes */
+    switch(data.size()[1]) {
+        case 4: return removeDuplicatesIntoParallelImplementation<4>(data, indices, actualThreadCount);
+        case 8: return removeDuplicatesIntoParallelImplementation<8>(data, indices, actualThreadCount);
+        case 12: return removeDuplicatesIntoParallelImplementation<12>(data, indices, actualThreadCount);
+        case 16: return removeDuplicatesIntoParallelImplementation<16>(data, indices, actualThreadCount);
+        case 24: return removeDuplicatesIntoParallelImplementation<24>(data, indices, actualThreadCount);
+        case 32: return removeDuplicatesIntoParallelImplementation<32>(data, indices, actualThreadCount);
+    }
+
+    return removeDuplicatesIntoParallelImplementation<0>(data, indices, actualThreadCount);
+}
+
 std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
@@ -113,46 +341,17 @@ std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<cha
     CORRADE_ASSERT(indices.size() == dataSize,
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
 
-    /* Table containing index of first occurrence for each unique entry.
-       Reserving more buckets than necessary (i.e. as if each entry was
-       unique). */
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]},
-        ArrayEqual{data.size()[1]}};
-
-    /* Go through all entries and insert them into the table. Because the keys
-       have runtime size, the table doesn't store a copy of the keys, only a
-       reference. The reference is to the original data that we mutate
-       in-place, so extra care needs to be taken to prevent already-inserted
-       keys from getting modified. */
-    for(std::size_t i = 0; i != dataSize; ++i) {
-        /* First copy the key data to a potentially final no-longer-mutable
-           place (except if the source and target location is the same). Data
-           in [table.size()-1, i) is already present in the [0, table.size()-1)
-           range from previous iterations so we aren't overwriting anything. If
-           insertion succeeds, this location will not be touched ever again; if
-           it fails the location isn't used as a key anywhere and so it can be
-           reused next time for a different key.
-
-           Alternatively we could first call find() and only then conditionally
-           do a copy() and emplace(), but that means the hash & search would be
-           performed twice, which is never faster than a plain memory copy. */
-        const Containers::ArrayView<char> dst = data[table.size()].asContiguous();
-        if(i != table.size())
-            Utility::copy(data[i].asContiguous(), dst);
-
-        /* Insert the new entry into the table. If it succeeds, dst is
-           guaranteed to not change anymore. */
-        const auto result = table.emplace(dst, table.size());
-
-        /* Put the (either new or already existing) index into the output index
-           array */
-        indices[i] = result.first->second;
+    /* Specialize for the most common vertex and index sizes */
+    switch(data.size()[1]) {
+        case 4: return removeDuplicatesInPlaceIntoImplementation<4>(data, indices);
+        case 8: return removeDuplicatesInPlaceIntoImplementation<8>(data, indices);
+        case 12: return removeDuplicatesInPlaceIntoImplementation<12>(data, indices);
+        case 16: return removeDuplicatesInPlaceIntoImplementation<16>(data, indices);
+        case 24: return removeDuplicatesInPlaceIntoImplementation<24>(data, indices);
+        case 32: return removeDuplicatesInPlaceIntoImplementation<32>(data, indices);
     }
 
-    CORRADE_INTERNAL_ASSERT(dataSize >= table.size());
-    return table.size();
+    return removeDuplicatesInPlaceIntoImplementation<0>(data, indices);
 }
 
 std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data) {
@@ -207,10 +406,119 @@ std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<
 
 namespace {
 
+/* The data are put into a uniform grid with cells of size 4*epsilon, which
+   means that all vectors closer than epsilon to given vector in a particular
+   dimension are either in the same cell or, if the vector is closer than
+   epsilon to the cell boundary, in the neighbor cell on that side. Thus for
+   every vector it's enough to check at most 2^N neighbor cells, and in
+   practice much less as most vectors aren't close to the boundary in all
+   dimensions. To keep the number bounded for large vector sizes, the grid is
+   built from just the first GridSize dimensions, the remaining ones are
+   checked only when comparing individual vectors. */
+template<std::size_t GridSize, class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceGrid(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, const Containers::Array<T>& offsets, const T epsilon) {
+    const std::size_t vectorSize = data.size()[1];
+
+    /* If all values are the same, the epsilon is zero and the cell size is
+       infinite */
+    const T cellSizeInverted = epsilon == T(0.0) ? T(0.0) : T(0.25)/epsilon;
+
+    /* Cell coordinates of each unique vector. The extra last row is for
+       neighbor cell lookups. */
+    const std::size_t dataSize = data.size()[0];
+    Containers::Array<std::size_t> cells{NoInit, (dataSize + 1)*GridSize};
+    std::size_t* const lookupCell = cells.data() + dataSize*GridSize;
+
+    /* Table containing index of the first unique vector in each cell, and a
+       linked list of other unique vectors in the same cell. For the first
+       vector in each cell there's also the last vector in the list to make
+       appending O(1). */
+    FlatHashTable<GridSize*sizeof(std::size_t)> table{cells.data(), std::ptrdiff_t(GridSize*sizeof(std::size_t)), GridSize*sizeof(std::size_t), dataSize};
+    Containers::Array<UnsignedInt> nextInCell{NoInit, dataSize};
+    Containers::Array<UnsignedInt> lastInCell{NoInit, dataSize};
+
+    /* Index array that'll be used for remapping the `indices` */
+    Containers::Array<UnsignedInt> remapping{NoInit, dataSize};
+
+    std::size_t uniqueCount = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const Containers::StridedArrayView1D<T> entry = data[i];
+
+        /* Calculate the cell and for each dimension whether the vector is
+           closer than epsilon to the upper or lower cell boundary. Cells
+           under the lower bound aren't possible, so no need to check
+           those. */
+        std::size_t* const cell = cells.data() + uniqueCount*GridSize;
+        UnsignedInt neighbors = 0;
+        UnsignedInt neighborsAbove = 0;
+        for(std::size_t vi = 0; vi != GridSize; ++vi) {
+            const T position = (entry[vi] - offsets[vi])*cellSizeInverted;
+            cell[vi] = std::size_t(position);
+            const T fraction = position - T(cell[vi]);
+            if(fraction >= T(0.75)) {
+                neighbors |= 1 << vi;
+                neighborsAbove |= 1 << vi;
+            } else if(fraction <= T(0.25) && cell[vi])
+                neighbors |= 1 << vi;
+        }
+
+        /* Go through all unique vectors in the cell and all neighbor cells
+           (i.e., all subsets of the neighbor dimensions) and pick the
+           earliest one that's closer than epsilon in all dimensions. Picking
+           the earliest and not the first found makes the output independent
+           of the hash table layout. */
+        UnsignedInt found = ~UnsignedInt{};
+        for(UnsignedInt neighbor = neighbors; ; neighbor = (neighbor - 1) & neighbors) {
+            for(std::size_t vi = 0; vi != GridSize; ++vi) {
+                if(!(neighbor & (1 << vi)))
+                    lookupCell[vi] = cell[vi];
+                else if(neighborsAbove & (1 << vi))
+                    lookupCell[vi] = cell[vi] + 1;
+                else
+                    lookupCell[vi] = cell[vi] - 1;
+            }
+
+            /* The lists are ordered by the unique index, so the search can
+               stop once it gets past an already found candidate */
+            for(UnsignedInt candidate = table.find(dataSize); candidate < found; candidate = nextInCell[candidate]) {
+                const Containers::StridedArrayView1D<T> candidateEntry = data[candidate];
+                std::size_t vi = 0;
+                for(; vi != vectorSize; ++vi)
+                    if(Math::abs(candidateEntry[vi] - entry[vi]) > epsilon) break;
+                if(vi == vectorSize) found = candidate;
+            }
+
+            if(!neighbor) break;
+        }
+
+        if(found != ~UnsignedInt{}) {
+            remapping[i] = found;
+            continue;
+        }
+
+        /* If this is a new vector, copy the data to new (earlier) position in
+           the array. Data in [uniqueCount, i) are already present in the
+           [0, uniqueCount) range from previous iterations so we aren't
+           overwriting anything. Then append it to the list in its cell. */
+        if(i != uniqueCount) Utility::copy(entry, data[uniqueCount]);
+        remapping[i] = uniqueCount;
+        nextInCell[uniqueCount] = ~UnsignedInt{};
+        const UnsignedInt first = table.insert(uniqueCount);
+        if(first != uniqueCount) nextInCell[lastInCell[first]] = uniqueCount;
+        lastInCell[first] = uniqueCount;
+        ++uniqueCount;
+    }
+
+    /* Remap the resulting index array */
+    for(auto& i: indices) i = remapping[i];
+
+    CORRADE_INTERNAL_ASSERT(dataSize >= uniqueCount);
+    return uniqueCount;
+}
+
 template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon) {
     /* Compared to the discrete version, we don't require the second dimension
-       to be contiguous, as we calculate the hash from a discretized contiguous
-       copy */
+       to be contiguous, as we calculate the hash from a contiguous copy of
+       the discretized grid cell */
 
     /* Somehow ~IndexType{} doesn't work for < 4byte types, as the result is
        int(-1) instead of the type I want */
@@ -234,78 +542,24 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
         }
     }
 
-    /* Make epsilon so large that std::size_t can index all vectors inside the
-       bounds. */
+    /* Make epsilon so large that std::size_t can index all grid cells inside
+       the bounds. */
     epsilon = Math::max(epsilon, range/T(~std::size_t{}));
 
-    /* Table containing original vector index for each discretized vector.
-       Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
-    std::size_t dataSize = data.size()[0];
-    std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
-        ArrayHash{data.size()[1]*sizeof(std::size_t)},
-        ArrayEqual{data.size()[1]*sizeof(std::size_t)}};
-
-    /* Index array that'll be filled in each pass and then used for remapping
-       the `indices`; discretized storage for all map keys. */
-    Containers::Array<UnsignedInt> remapping{NoInit, dataSize};
-    Containers::Array<std::size_t> discretized{NoInit, dataSize*vectorSize};
-
-    /* First go with original coordinates, then move them by epsilon/2 in each
-       dimension. */
-    T moveAmount = T(0.0);
-    for(std::size_t moving = 0; moving <= vectorSize; ++moving) {
-        for(std::size_t i = 0; i != dataSize; ++i) {
-            /* Take the original vector and discretize it -- append the move
-               amount to given dimension, subtract the minmal offset and divide
-               by epsilon. */
-            const Containers::StridedArrayView1D<T> entry = data[i];
-            const Containers::ArrayView<std::size_t> discretizedEntry = discretized.slice(i*vectorSize, (i + 1)*vectorSize);
-            for(std::size_t vi = 0; vi != vectorSize; ++vi) {
-                T c = entry[vi];
-                /* In iteration `0` we're not moving in any dimension, in
-                   iteration `vectorSize` we're moving in `vectorSize - 1`
-                   dimension */
-                if(vi + 1 == moving) c += moveAmount;
-                discretizedEntry[vi] = (c - offsets[vi])/epsilon;
-            }
-
-            /* Try to insert new entry into the table. The inserted index
-               points into the new data array that has all duplicates removed.
-               This is a similar workflow to removeDuplicatesInPlaceInto() with
-               the only difference that we're remapping an existing index array
-               several times over instead of creating a new one */
-            const auto result = table.emplace(discretizedEntry, table.size());
-
-            /* Add the (either new or already existing) index into the array */
-            remapping[i] = result.first->second;
-
-            /* If this is a new combination, copy the data to new (earlier)
-               position in the array. Data in [table.size()-1, i) are already
-               present in the [0, table.size()-1) range from previous
-               iterations so we aren't overwriting anything. */
-            if(result.second && i != table.size() - 1)
-                Utility::copy(entry, data[table.size() - 1]);
-        }
-
-        /* Remap the resulting index array */
-        for(auto& i: indices) i = remapping[i];
-
-        /* Move vertex coordinates by epsilon/2 in the next dimension (which
-           is moving + 1 in the next loop iteration) */
-        moveAmount = epsilon/2;
-
-        /* Next time go only through the unique prefix; clear the table for the
-           next pass */
-        dataSize = table.size();
-        table.clear();
+    /* Specialize for the grid size to make the cell hashing and lookup
+       faster. Vectors with more dimensions use just the first four for the
+       grid. */
+    switch(vectorSize) {
+        case 0: return removeDuplicatesFuzzyIndexedInPlaceGrid<0>(indices, data, offsets, epsilon);
+        case 1: return removeDuplicatesFuzzyIndexedInPlaceGrid<1>(indices, data, offsets, epsilon);
+        case 2: return removeDuplicatesFuzzyIndexedInPlaceGrid<2>(indices, data, offsets, epsilon);
+        case 3: return removeDuplicatesFuzzyIndexedInPlaceGrid<3>(indices, data, offsets, epsilon);
     }
 
-    CORRADE_INTERNAL_ASSERT(data.size()[0] >= dataSize);
-    return dataSize;
+    return removeDuplicatesFuzzyIndexedInPlaceGrid<4>(indices, data, offsets, epsilon);
 }
 
+
 }
 
 std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<Float>& data, const Float epsilon) {
@@ -396,7 +650,34 @@ std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayVi
     return removeDuplicatesFuzzyIndexedInPlaceImplementation(indices, data, epsilon);
 }
 
-Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
+namespace {
+
+/* Turns the output of removeDuplicatesInto() into an output of
+   removeDuplicatesInPlaceInto(), moving the first occurrences to the front
+   and remapping the indices to point to them */
+std::size_t compactDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        /* First occurrence, move it to the end of the unique prefix. Data in
+           [count, i) are either already moved earlier or duplicates of items
+           in the prefix, so we aren't overwriting anything. */
+        if(indices[i] == i) {
+            if(i != count)
+                Utility::copy(data[i].asContiguous(), data[count].asContiguous());
+            indices[i] = count++;
+
+        /* Duplicate, the first occurrence was already remapped */
+        } else indices[i] = indices[indices[i]];
+    }
+
+    return count;
+}
+
+template<class T> void remapIndicesInPlace(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const UnsignedInt>& mapping) {
+    for(T& i: indices) i = mapping[i];
+}
+
+Trade::MeshData removeDuplicatesImplementation(const Trade::MeshData& data, const UnsignedInt threadCount) {
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicates(): can't remove duplicates in an attributeless mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
@@ -434,14 +715,42 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
     UnsignedInt uniqueVertexCount;
     Containers::Array<char> indexData;
     MeshIndexType indexType;
-    if(ownedInterleaved.isIndexed()) {
-        uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData);
-        indexData = ownedInterleaved.releaseIndexData();
-        indexType = ownedInterleaved.indexType();
+    if(Implementation::threadCountFor(threadCount, vertexData.size()[0]) == 1) {
+        if(ownedInterleaved.isIndexed()) {
+            uniqueVertexCount = removeDuplicatesIndexedInPlace(ownedInterleaved.mutableIndices(), vertexData);
+            indexData = ownedInterleaved.releaseIndexData();
+            indexType = ownedInterleaved.indexType();
+        } else {
+            indexData = Containers::Array<char>{NoInit, ownedInterleaved.vertexCount()*sizeof(UnsignedInt)};
+            uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData));
+            indexType = MeshIndexType::UnsignedInt;
+        }
+
+    /* Find the first occurrences in parallel and then compact the data in a
+       single linear pass, which gives the same result as the serial variant
+       above */
     } else {
-        indexData = Containers::Array<char>{NoInit, ownedInterleaved.vertexCount()*sizeof(UnsignedInt)};
-        uniqueVertexCount = removeDuplicatesInPlaceInto(vertexData, Containers::arrayCast<UnsignedInt>(indexData));
-        indexType = MeshIndexType::UnsignedInt;
+        if(ownedInterleaved.isIndexed()) {
+            Containers::Array<UnsignedInt> mapping{NoInit, vertexData.size()[0]};
+            removeDuplicatesInto(vertexData, mapping, threadCount);
+            uniqueVertexCount = compactDuplicatesInPlace(vertexData, mapping);
+
+            indexType = ownedInterleaved.indexType();
+            if(indexType == MeshIndexType::UnsignedInt)
+                remapIndicesInPlace(ownedInterleaved.mutableIndices<UnsignedInt>(), mapping);
+            else if(indexType == MeshIndexType::UnsignedShort)
+                remapIndicesInPlace(ownedInterleaved.mutableIndices<UnsignedShort>(), mapping);
+            else if(indexType == MeshIndexType::UnsignedByte)
+                remapIndicesInPlace(ownedInterleaved.mutableIndices<UnsignedByte>(), mapping);
+            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            indexData = ownedInterleaved.releaseIndexData();
+        } else {
+            indexData = Containers::Array<char>{NoInit, ownedInterleaved.vertexCount()*sizeof(UnsignedInt)};
+            const Containers::ArrayView<UnsignedInt> mapping = Containers::arrayCast<UnsignedInt>(indexData);
+            removeDuplicatesInto(vertexData, mapping, threadCount);
+            uniqueVertexCount = compactDuplicatesInPlace(vertexData, mapping);
+            indexType = MeshIndexType::UnsignedInt;
+        }
     }
 
     /* Allocate a new, shorter vertex data and copy the prefix */
@@ -471,6 +780,16 @@ Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
         uniqueVertexCount};
 }
 
+}
+
+Trade::MeshData removeDuplicates(const Trade::MeshData& data) {
+    return removeDuplicatesImplementation(data, 1);
+}
+
+Trade::MeshData removeDuplicates(const Trade::MeshData& data, const UnsignedInt threadCount) {
+    return removeDuplicatesImplementation(data, threadCount);
+}
+
 Trade::MeshData removeDuplicatesFuzzy(const Trade::MeshData& data, const Float floatEpsilon, const Double doubleEpsilon) {
     CORRADE_ASSERT(data.attributeCount(),
         "MeshTools::removeDuplicatesFuzzy(): can't remove duplicates in an attributeless mesh",
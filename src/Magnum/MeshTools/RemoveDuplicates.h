@@ -110,6 +110,24 @@ makes an index array pointing to original data locations.
 */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
+/**
+@brief Remove duplicate data from given array into given output index array using multiple threads
+@param[in]  data        Data array
+@param[out] indices     Where to put the resulting index array
+@param[in]  threadCount Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@return Count of unique items in the original @p data array
+@m_since_latest
+
+Produces the same output as
+@ref removeDuplicatesInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<UnsignedInt>&),
+but the items are split into shards by their hash and each shard is processed
+on a separate thread. At most one thread is used for every 16384 items, if
+there's not enough items or the platform doesn't support threads, the
+operation is done on the calling thread.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount);
+
 /**
 @brief Remove duplicates from indexed data in-place
 @param[in,out] indices  Index array, which will get remapped to list just
@@ -158,9 +176,14 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesIndexedInPlace(const Contain
     index array
 @m_since{2020,06}
 
-Removes duplicate data from the array by collapsing them into buckets of size
-@p epsilon. First vector in given bucket is used, other ones are thrown away,
-no interpolation is done. Note that this function is meant to be used for
+Removes duplicate data from the array by merging each vector into the first
+preceding unique vector that's not further than @p epsilon from it in any
+dimension. No interpolation is done, the first vector is used and other ones
+are thrown away. Candidates are found using a uniform grid with cells of size
+@cpp 4*epsilon @ce built on the first four dimensions, which makes the
+operation run in linear time for all practical inputs and the result doesn't
+depend on where the vectors happen to lie relative to cell boundaries. Note
+that this function is meant to be used for
 floating-point data (or generally with non-zero @p epsilon), for data where
 bit-exact matching is sufficient use @ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&)
 instead.
@@ -311,6 +334,19 @@ copies and interleaves the input vertex and index data.
 */
 MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data);
 
+/**
+@brief Remove mesh data duplicates using multiple threads
+@m_since_latest
+
+Produces the same output as @ref removeDuplicates(const Trade::MeshData&),
+including the order of unique vertices and the resulting index buffer, but
+finds the duplicates using
+@ref removeDuplicatesInto(const Containers::StridedArrayView2D<const char>&, const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
+with @p threadCount threads. If @p threadCount is @cpp 0 @ce, uses
+@ref std::thread::hardware_concurrency().
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData removeDuplicates(const Trade::MeshData& data, UnsignedInt threadCount);
+
 /**
 @brief Remove mesh data duplicates with fuzzy comparison for floating-point attributes
 @m_since{2020,06}
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ReorderForVertexFetch.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> Containers::Array<UnsignedInt> reorderForVertexFetchInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount) {
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::reorderForVertexFetchInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+    #endif
+
+    /* Assign new vertex indices in order of first use, remembering which
+       original vertex each new index corresponds to */
+    constexpr UnsignedInt Unused = ~UnsignedInt{};
+    Containers::Array<UnsignedInt> remap{DirectInit, vertexCount, Unused};
+    Containers::Array<UnsignedInt> mapping{NoInit, vertexCount};
+    UnsignedInt next = 0;
+    for(T& index: indices) {
+        UnsignedInt& remapped = remap[index];
+        if(remapped == Unused) {
+            remapped = next;
+            mapping[next] = index;
+            ++next;
+        }
+
+        /* The new index is never larger than the original one could be, so
+           it fits the type */
+        index = T(remapped);
+    }
+
+    /* Put the unreferenced vertices at the end so the mapping is a complete
+       permutation */
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        if(remap[i] == Unused) mapping[next++] = i;
+    CORRADE_INTERNAL_ASSERT(next == vertexCount);
+
+    return mapping;
+}
+
+}
+
+Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    return reorderForVertexFetchInPlaceImplementation(indices, vertexCount);
+}
+
+Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount) {
+    return reorderForVertexFetchInPlaceImplementation(indices, vertexCount);
+}
+
+Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount) {
+    return reorderForVertexFetchInPlaceImplementation(indices, vertexCount);
+}
+
+Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::reorderForVertexFetchInPlace(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return reorderForVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), vertexCount);
+    else if(indices.size()[1] == 2)
+        return reorderForVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), vertexCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::reorderForVertexFetchInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return reorderForVertexFetchInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), vertexCount);
+    }
+}
+
+Trade::MeshData reorderForVertexFetch(const Trade::MeshData& mesh) {
+    /* Pass through to the && overload, which then decides whether to reuse
+       anything based on the DataFlags */
+    return reorderForVertexFetch(reference(mesh));
+}
+
+Trade::MeshData reorderForVertexFetch(Trade::MeshData&& mesh) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::reorderForVertexFetch(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::reorderForVertexFetch(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::reorderForVertexFetch(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (Trade::MeshData{MeshPrimitive{}, 0}));
+    }
+    #endif
+
+    /* If the index data are already owned, move them to the output,
+       otherwise copy them */
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(mesh.indexDataFlags() & Trade::DataFlag::Owned) {
+        indices = Trade::MeshIndexData{mesh.indices()};
+        indexData = mesh.releaseIndexData();
+    } else {
+        indexData = Containers::Array<char>{NoInit, mesh.indexData().size()};
+        indices = Trade::MeshIndexData{
+            mesh.indexType(),
+            Containers::StridedArrayView1D<const void>{
+                indexData,
+                indexData.data() + mesh.indexOffset(),
+                mesh.indexCount(),
+                mesh.indexStride()}};
+        Utility::copy(mesh.indexData(), indexData);
+    }
+
+    /* The vertex data have to be copied always as the attributes are
+       permuted from the original. Copying the whole thing first preserves
+       also any data not covered by the attributes, such as padding in
+       interleaved layouts. */
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    Containers::Array<char> vertexData{NoInit, mesh.vertexData().size()};
+    Utility::copy(mesh.vertexData(), vertexData);
+
+    /* Route the attributes to the same offsets in the new vertex data */
+    Containers::Array<Trade::MeshAttributeData> attributeData{mesh.attributeCount()};
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Trade::MeshAttributeData& attribute = mesh.attributeData()[i];
+        attributeData[i] = Trade::MeshAttributeData{
+            attribute.name(),
+            attribute.format(),
+            Containers::StridedArrayView1D<const void>{
+                vertexData,
+                vertexData.data() + attribute.offset(mesh.vertexData()),
+                vertexCount,
+                attribute.stride()},
+            attribute.arraySize()};
+    }
+
+    Trade::MeshData out{mesh.primitive(),
+        std::move(indexData), indices,
+        std::move(vertexData), std::move(attributeData),
+        vertexCount};
+
+    /* Rewrite the indices and permute the attributes from the original
+       vertex data */
+    const Containers::Array<UnsignedInt> mapping = reorderForVertexFetchInPlace(out.mutableIndices(), vertexCount);
+    for(UnsignedInt i = 0; i != out.attributeCount(); ++i)
+        duplicateInto(Containers::stridedArrayView(mapping), mesh.attribute(i), out.mutableAttribute(i));
+
+    return out;
+}
+
+}}
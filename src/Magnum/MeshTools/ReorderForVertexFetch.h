@@ -0,0 +1,121 @@
+#ifndef Magnum_MeshTools_ReorderForVertexFetch_h
+#define Magnum_MeshTools_ReorderForVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::reorderForVertexFetchInPlace(), @ref Magnum::MeshTools::reorderForVertexFetch()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Reorder vertex references for vertex fetch efficiency in-place
+@param[in,out] indices  Index array to operate on
+@param[in] vertexCount  Vertex count
+@return Vertex mapping, with @p vertexCount items
+@m_since_latest
+
+Rewrites @p indices so vertices get referenced in the order they're first
+used, making vertex data fetches go linearly through memory. The returned
+array contains, for each output vertex, index of the original vertex it
+should be taken from --- pass it to @ref duplicateInto() to permute the
+actual vertex data. Vertices that aren't referenced by @p indices at all are
+put at the end, in their original order, so the vertex count stays the same.
+
+Since the vertex order depends on the order of the index buffer, this should
+be done *after* @ref optimizeVertexCacheInPlace(), @ref tipsifyInPlace() or
+@ref optimizeOverdrawInPlace(). The primitive type doesn't matter.
+
+Expects that all indices are less than @p vertexCount.
+@see @ref reorderForVertexFetch(const Trade::MeshData&)
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Reorder type-erased vertex references for vertex fetch efficiency in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref reorderForVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<UnsignedInt> reorderForVertexFetchInPlace(const Containers::StridedArrayView2D<char>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Reorder mesh vertices for vertex fetch efficiency
+@m_since_latest
+
+Expects that the mesh is indexed. The index buffer is passed to
+@ref reorderForVertexFetchInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt)
+and all attributes are then permuted using the returned mapping. The
+primitive, index type, vertex count and vertex data layout are preserved,
+which means the attributes can be both interleaved and in separate arrays.
+Any vertex data not covered by the attributes are copied unchanged. Expects
+that no attribute has an implementation-specific format, as the size of such
+attributes isn't known.
+
+This function will unconditionally make a copy of all data, use
+@ref reorderForVertexFetch(Trade::MeshData&&) to avoid a copy of already
+owned index data.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData reorderForVertexFetch(const Trade::MeshData& mesh);
+
+/**
+@brief Reorder mesh vertices for vertex fetch efficiency
+@m_since_latest
+
+Compared to @ref reorderForVertexFetch(const Trade::MeshData&) this function
+can reuse the index data if they're owned and modifies them directly in that
+case. The vertex data are always copied, as they can't be permuted in-place.
+@see @ref Trade::MeshData::indexDataFlags()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData reorderForVertexFetch(Trade::MeshData&& mesh);
+
+}}
+
+#endif
@@ -0,0 +1,689 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm> /* std::sort() */
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BoundingVolume.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/ReorderForVertexFetch.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Topological kind of a vertex, deciding where it can be collapsed to */
+enum class VertexKind: UnsignedByte {
+    /* Interior vertex with no seams */
+    Manifold,
+    /* Vertex on an open border, with exactly one border edge going in and
+       one going out */
+    Border,
+    /* Vertex on an attribute seam, with exactly two vertices sharing the
+       position and the seam edges on both sides connecting to the same
+       vertices */
+    Seam,
+    /* Anything else, never moved */
+    Locked
+};
+
+/* Whether a vertex of given kind can be collapsed onto a vertex of another
+   kind. Border and seam vertices can move only along the border or seam. */
+constexpr bool CanCollapse[4][4]{
+    {true, true, true, false},
+    {false, true, false, false},
+    {false, false, true, false},
+    {false, false, false, false}
+};
+
+/* Whether an edge between vertices of given kinds is guaranteed to have an
+   opposite half-edge, considering the positions only. Used to consider each
+   such edge just once. */
+constexpr bool HasOpposite[4][4]{
+    {true, true, true, true},
+    {true, false, true, false},
+    {true, true, true, true},
+    {true, false, true, false}
+};
+
+/* Symmetric 4x4 quadric matrix, with the 3x3 part stored as the upper
+   triangle, and the total weight of all planes added to it */
+struct Quadric {
+    Float a00, a11, a22, a01, a02, a12;
+    Vector3 b;
+    Float c;
+    Float weight;
+};
+
+void addPlaneQuadric(Quadric& q, const Vector3& normal, const Float distance, const Float weight) {
+    q.a00 += weight*normal.x()*normal.x();
+    q.a11 += weight*normal.y()*normal.y();
+    q.a22 += weight*normal.z()*normal.z();
+    q.a01 += weight*normal.x()*normal.y();
+    q.a02 += weight*normal.x()*normal.z();
+    q.a12 += weight*normal.y()*normal.z();
+    q.b += weight*distance*normal;
+    q.c += weight*distance*distance;
+    q.weight += weight;
+}
+
+void addQuadric(Quadric& q, const Quadric& other) {
+    q.a00 += other.a00;
+    q.a11 += other.a11;
+    q.a22 += other.a22;
+    q.a01 += other.a01;
+    q.a02 += other.a02;
+    q.a12 += other.a12;
+    q.b += other.b;
+    q.c += other.c;
+    q.weight += other.weight;
+}
+
+/* Weighted average of squared distances of the point from all planes in the
+   quadric */
+Float quadricError(const Quadric& q, const Vector3& p) {
+    const Float error =
+        q.a00*p.x()*p.x() + q.a11*p.y()*p.y() + q.a22*p.z()*p.z() +
+        2.0f*(q.a01*p.x()*p.y() + q.a02*p.x()*p.z() + q.a12*p.y()*p.z()) +
+        2.0f*Math::dot(q.b, p) + q.c;
+    return q.weight == 0.0f ? 0.0f : Math::abs(error)/q.weight;
+}
+
+/* Half-edges going out of each vertex, each stored as the next and previous
+   vertex of the triangle. If remap is non-empty, the vertices are first
+   mapped through it. */
+void buildEdgeAdjacency(const Containers::ArrayView<const UnsignedInt> indices, const UnsignedInt vertexCount, const Containers::ArrayView<const UnsignedInt> remap, Containers::Array<UnsignedInt>& offsets, Containers::Array<Vector2ui>& edges) {
+    const auto map = [&](const UnsignedInt i) {
+        return remap.isEmpty() ? i : remap[i];
+    };
+
+    /* Building the offset array from counts shifted by one to the right, the
+       next loop will shift them back, same as in buildAdjacency() for
+       tipsify() */
+    offsets = Containers::Array<UnsignedInt>{ValueInit, std::size_t(vertexCount) + 1};
+    for(const UnsignedInt i: indices)
+        ++offsets[map(i) + 1];
+    UnsignedInt sum = 0;
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        const UnsignedInt count = offsets[i + 1];
+        offsets[i + 1] = sum;
+        sum += count;
+    }
+
+    edges = Containers::Array<Vector2ui>{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt a = map(indices[i + 0]);
+        const UnsignedInt b = map(indices[i + 1]);
+        const UnsignedInt c = map(indices[i + 2]);
+        edges[offsets[a + 1]++] = {b, c};
+        edges[offsets[b + 1]++] = {c, a};
+        edges[offsets[c + 1]++] = {a, b};
+    }
+}
+
+bool hasEdge(const Containers::ArrayView<const UnsignedInt> offsets, const Containers::ArrayView<const Vector2ui> edges, const UnsignedInt from, const UnsignedInt to) {
+    for(std::size_t i = offsets[from], end = offsets[from + 1]; i != end; ++i)
+        if(edges[i].x() == to) return true;
+    return false;
+}
+
+struct Collapse {
+    UnsignedInt from, to;
+    Float error;
+    bool bidirectional;
+};
+
+Containers::Pair<std::size_t, Float> simplifyImplementation(const Containers::ArrayView<UnsignedInt> indices, const Containers::StridedArrayView1D<const Vector3>& originalPositions, const std::size_t targetIndexCount, const Float targetError) {
+    const UnsignedInt vertexCount = originalPositions.size();
+    if(indices.isEmpty()) return {0, 0.0f};
+
+    /* Normalize the positions to a unit cube so the error is relative to the
+       mesh size */
+    const Range3D bounds = boundingRange(originalPositions);
+    const Float extent = bounds.size().max();
+    const Float scale = extent == 0.0f ? 0.0f : 1.0f/extent;
+    Containers::Array<Vector3> positions{NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        positions[i] = (originalPositions[i] - bounds.min())*scale;
+
+    /* Vertices with the same position map to the first of them. Wedge is a
+       circular list of all vertices with the same position. */
+    Containers::Array<UnsignedInt> remap{NoInit, vertexCount};
+    removeDuplicatesInto(Containers::arrayCast<2, const char>(originalPositions), remap);
+    Containers::Array<UnsignedInt> wedge{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i)
+        wedge[i] = i;
+    for(UnsignedInt i = 0; i != vertexCount; ++i) {
+        const UnsignedInt r = remap[i];
+        if(r == i) continue;
+        wedge[i] = wedge[r];
+        wedge[r] = i;
+    }
+
+    /* For each vertex, find the open half-edges going in and out, i.e.
+       half-edges with no opposite half-edge in the index buffer. ~0 means
+       there's none, the vertex itself means there's more than one. Border
+       edges are open on one side, seam edges on both sides, but with
+       different vertices. */
+    constexpr UnsignedInt None = ~UnsignedInt{};
+    Containers::Array<UnsignedInt> offsets;
+    Containers::Array<Vector2ui> edges;
+    buildEdgeAdjacency(indices, vertexCount, {}, offsets, edges);
+    Containers::Array<UnsignedInt> loop{DirectInit, vertexCount, None};
+    Containers::Array<UnsignedInt> loopback{DirectInit, vertexCount, None};
+    for(UnsignedInt vertex = 0; vertex != vertexCount; ++vertex) {
+        for(std::size_t i = offsets[vertex], end = offsets[vertex + 1]; i != end; ++i) {
+            const UnsignedInt target = edges[i].x();
+
+            /* A degenerate triangle has an edge to the same vertex, which
+               would make the vertex look like not having an open edge. Mark
+               it as having multiple instead to have it locked. */
+            if(target == vertex) {
+                loop[vertex] = loopback[vertex] = vertex;
+            } else if(!hasEdge(offsets, edges, target, vertex)) {
+                loopback[target] = loopback[target] == None ? vertex : target;
+                loop[vertex] = loop[vertex] == None ? target : vertex;
+            }
+        }
+    }
+
+    /* Classify the vertices */
+    Containers::Array<VertexKind> kinds{NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i) {
+        /* All vertices with the same position share the kind of the first
+           one, which is always earlier in the array */
+        if(remap[i] != i) {
+            kinds[i] = kinds[remap[i]];
+
+        /* No other vertex with the same position, the vertex is either
+           manifold or on a border if it has exactly one open edge in and
+           out */
+        } else if(wedge[i] == i) {
+            if(loopback[i] == None && loop[i] == None)
+                kinds[i] = VertexKind::Manifold;
+            else if(loopback[i] != i && loop[i] != i)
+                kinds[i] = VertexKind::Border;
+            else
+                kinds[i] = VertexKind::Locked;
+
+        /* Exactly two vertices with the same position, it's a seam if each
+           has exactly one open edge in and out and the edges on both sides
+           connect to the same positions */
+        } else if(wedge[wedge[i]] == i) {
+            const UnsignedInt w = wedge[i];
+            const UnsignedInt in = loopback[i];
+            const UnsignedInt out = loop[i];
+            const UnsignedInt inW = loopback[w];
+            const UnsignedInt outW = loop[w];
+            if(in != None && in != i && out != None && out != i &&
+               inW != None && inW != w && outW != None && outW != w &&
+               remap[in] == remap[outW] && remap[out] == remap[inW] &&
+               remap[in] != remap[out])
+                kinds[i] = VertexKind::Seam;
+            else
+                kinds[i] = VertexKind::Locked;
+
+        /* More than two vertices with the same position */
+        } else kinds[i] = VertexKind::Locked;
+    }
+
+    const auto kind = [&](const UnsignedInt i) {
+        return UnsignedInt(kinds[i]);
+    };
+
+    /* Quadrics of all planes around each vertex, stored for the first vertex
+       of each position */
+    Containers::Array<Quadric> quadrics{ValueInit, vertexCount};
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Vector3 a = positions[indices[i + 0]];
+        const Vector3 b = positions[indices[i + 1]];
+        const Vector3 c = positions[indices[i + 2]];
+
+        /* Weighting by area so large triangles contribute more. The normal
+           length is twice the area, which doesn't matter. */
+        const Vector3 normal = Math::cross(b - a, c - a);
+        const Float area = normal.length();
+        if(area == 0.0f) continue;
+        const Vector3 normalized = normal/area;
+        for(std::size_t j = 0; j != 3; ++j)
+            addPlaneQuadric(quadrics[remap[indices[i + j]]], normalized, -Math::dot(normalized, a), area);
+    }
+
+    /* Whether there's a half-edge going from any vertex with the same
+       position as `from` to any vertex with the same position as `to` */
+    const auto hasEdgeBetweenPositions = [&](const UnsignedInt from, const UnsignedInt to) {
+        UnsignedInt a = from;
+        do {
+            UnsignedInt b = to;
+            do {
+                if(hasEdge(offsets, edges, a, b)) return true;
+                b = wedge[b];
+            } while(b != to);
+            a = wedge[a];
+        } while(a != from);
+        return false;
+    };
+
+    /* Add planes perpendicular to open edges to prevent borders and seams
+       from moving inwards. This is done for all open edges, including ones
+       that end in a locked vertex, otherwise for example a corner next to a
+       locked vertex would be free to slide along the other edge. Seam edges
+       are present twice, with opposite directions and different vertices,
+       so they're added just once. Borders get a much larger weight as their
+       shape is more important, seams can move a bit more freely. The weight
+       is proportional to the squared edge length to match the area-weighted
+       triangle planes. */
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        for(std::size_t e = 0; e != 3; ++e) {
+            const UnsignedInt i0 = indices[i + e];
+            const UnsignedInt i1 = indices[i + (e + 1)%3];
+            const UnsignedInt i2 = indices[i + (e + 2)%3];
+            if(i0 == i1 || hasEdge(offsets, edges, i1, i0))
+                continue;
+            const bool seam = hasEdgeBetweenPositions(i1, i0);
+            if(seam && remap[i1] > remap[i0])
+                continue;
+
+            const Vector3 p0 = positions[i0];
+            const Vector3 edge = positions[i1] - p0;
+            const Float length = edge.length();
+            if(length == 0.0f) continue;
+            const Vector3 direction = edge/length;
+            const Vector3 toOpposite = positions[i2] - p0;
+            const Vector3 perpendicular = toOpposite - direction*Math::dot(toOpposite, direction);
+            const Float perpendicularLength = perpendicular.length();
+            if(perpendicularLength == 0.0f) continue;
+            const Vector3 normal = perpendicular/perpendicularLength;
+
+            const Float weight = (seam ? 1.0f : 10.0f)*length*length;
+            const Float distance = -Math::dot(normal, p0);
+            addPlaneQuadric(quadrics[remap[i0]], normal, distance, weight);
+            addPlaneQuadric(quadrics[remap[i1]], normal, distance, weight);
+        }
+    }
+
+    /* The errors are squared distances */
+    const Float errorLimit = targetError*targetError;
+    Float resultError = 0.0f;
+    std::size_t resultCount = indices.size();
+    Containers::Array<Collapse> collapses;
+    Containers::Array<UnsignedInt> collapseOrder;
+    Containers::Array<UnsignedInt> collapseRemap{NoInit, vertexCount};
+    Containers::Array<UnsignedInt> positionRemap{NoInit, vertexCount};
+    Containers::Array<bool> collapseLocked{NoInit, vertexCount};
+    while(resultCount > targetIndexCount) {
+        const Containers::ArrayView<UnsignedInt> result = indices.prefix(resultCount);
+
+        /* Adjacency of the current result with vertices of the same position
+           welded together, used for checking triangle flips */
+        buildEdgeAdjacency(result, vertexCount, remap, offsets, edges);
+
+        /* Pick edges that can be collapsed without changing the topology */
+        collapses = Containers::Array<Collapse>{NoInit, resultCount};
+        std::size_t collapseCount = 0;
+        for(std::size_t i = 0; i != resultCount; i += 3) {
+            for(std::size_t e = 0; e != 3; ++e) {
+                const UnsignedInt i0 = result[i + e];
+                const UnsignedInt i1 = result[i + (e + 1)%3];
+
+                /* Zero-length edges, or a result of a previous collapse of
+                   a vertex connecting to both sides of a seam. Leave these
+                   alone. */
+                if(remap[i0] == remap[i1]) continue;
+
+                const UnsignedInt k0 = kind(i0);
+                const UnsignedInt k1 = kind(i1);
+                if(!CanCollapse[k0][k1] && !CanCollapse[k1][k0]) continue;
+
+                /* Consider edges with an opposite half-edge only once */
+                if(HasOpposite[k0][k1] && remap[i1] > remap[i0]) continue;
+
+                /* Two border or seam vertices not connected by a border or
+                   seam edge, meaning they're on two different edge loops or
+                   the edge goes across. Collapsing those would change the
+                   topology. */
+                if((kinds[i0] == VertexKind::Border || kinds[i0] == VertexKind::Seam) && kinds[i1] != VertexKind::Manifold && loop[i0] != i1)
+                    continue;
+                if((kinds[i1] == VertexKind::Border || kinds[i1] == VertexKind::Seam) && kinds[i0] != VertexKind::Manifold && loopback[i1] != i0)
+                    continue;
+
+                /* If the edge can be collapsed only in one direction, make
+                   it the first one */
+                const bool bidirectional = CanCollapse[k0][k1] && CanCollapse[k1][k0];
+                if(bidirectional || CanCollapse[k0][k1])
+                    collapses[collapseCount++] = {i0, i1, 0.0f, bidirectional};
+                else
+                    collapses[collapseCount++] = {i1, i0, 0.0f, bidirectional};
+            }
+        }
+
+        /* No edge can be collapsed anymore due to topology restrictions */
+        if(!collapseCount) break;
+
+        /* Calculate the collapse errors. For bidirectional edges pick the
+           direction with the smaller error. */
+        for(std::size_t i = 0; i != collapseCount; ++i) {
+            Collapse& c = collapses[i];
+            const Float error = quadricError(quadrics[remap[c.from]], positions[c.to]);
+            if(c.bidirectional) {
+                const Float errorReverse = quadricError(quadrics[remap[c.to]], positions[c.from]);
+                if(errorReverse < error) {
+                    std::swap(c.from, c.to);
+                    c.error = errorReverse;
+                    continue;
+                }
+            }
+            c.error = error;
+        }
+
+        /* Sort the collapses by the error, keeping the order stable for the
+           output to be deterministic */
+        collapseOrder = Containers::Array<UnsignedInt>{NoInit, collapseCount};
+        for(UnsignedInt i = 0; i != collapseCount; ++i)
+            collapseOrder[i] = i;
+        std::sort(collapseOrder.begin(), collapseOrder.end(), [&](UnsignedInt a, UnsignedInt b) {
+            return collapses[a].error < collapses[b].error ||
+                (collapses[a].error == collapses[b].error && a < b);
+        });
+
+        /* Perform the cheapest collapses that don't touch vertices already
+           collapsed in this pass, as the errors of those would be no longer
+           valid */
+        for(UnsignedInt i = 0; i != vertexCount; ++i) {
+            collapseRemap[i] = i;
+            positionRemap[i] = i;
+            collapseLocked[i] = false;
+        }
+        const std::size_t triangleCollapseGoal = (resultCount - targetIndexCount)/3;
+        std::size_t triangleCollapseCount = 0;
+        std::size_t edgeCollapseCount = 0;
+        /* Most collapses remove two triangles, many of the others will be
+           locked by the collapses done before. Limit the error in a pass
+           to the error of the collapse that would be roughly last if none
+           was locked, with some extra margin. */
+        std::size_t edgeCollapseGoal = triangleCollapseGoal/2;
+        for(std::size_t i = 0; i != collapseCount; ++i) {
+            const Collapse& c = collapses[collapseOrder[i]];
+            if(c.error > errorLimit || triangleCollapseCount >= triangleCollapseGoal)
+                break;
+
+            /* Stop at the per-pass error goal only if enough collapses were
+               done already, to avoid degenerate passes on meshes where most
+               collapses get locked */
+            const Float errorGoal = edgeCollapseGoal < collapseCount ?
+                1.5f*collapses[collapseOrder[edgeCollapseGoal]].error :
+                Constants::inf();
+            if(c.error > errorGoal && triangleCollapseCount > triangleCollapseGoal/6)
+                break;
+
+            const UnsignedInt r0 = remap[c.from];
+            const UnsignedInt r1 = remap[c.to];
+            if(collapseLocked[r0] || collapseLocked[r1]) continue;
+
+            /* Check that none of the triangles around the collapsed vertex
+               flips. Triangles that contain the target vertex degenerate and
+               get removed, so those are skipped. Rotating the normal by more
+               than ~75 degrees is considered a flip as well, as it usually
+               creates slivers that flip in later collapses. */
+            const Vector3 p0 = positions[r0];
+            const Vector3 p1 = positions[r1];
+            bool flips = false;
+            for(std::size_t j = offsets[r0], end = offsets[r0 + 1]; j != end; ++j) {
+                const UnsignedInt a = positionRemap[edges[j].x()];
+                const UnsignedInt b = positionRemap[edges[j].y()];
+                if(a == r1 || b == r1 || a == b) continue;
+
+                const Vector3 ab = positions[b] - positions[a];
+                const Vector3 normalBefore = Math::cross(ab, p0 - positions[a]);
+                const Vector3 normalAfter = Math::cross(ab, p1 - positions[a]);
+                if(Math::dot(normalBefore, normalAfter) <= 0.25f*normalBefore.length()*normalAfter.length()) {
+                    flips = true;
+                    break;
+                }
+            }
+            if(flips) {
+                /* This collapse doesn't count towards the error goal */
+                ++edgeCollapseGoal;
+                continue;
+            }
+
+            addQuadric(quadrics[r1], quadrics[r0]);
+
+            /* On a seam, the other vertex of the pair gets collapsed to the
+               other vertex of the target pair. In other cases the vertex has
+               no other vertices with the same position. */
+            if(kinds[c.from] == VertexKind::Seam) {
+                collapseRemap[c.from] = c.to;
+                collapseRemap[wedge[c.from]] = wedge[c.to];
+            } else {
+                CORRADE_INTERNAL_ASSERT(wedge[c.from] == c.from);
+                collapseRemap[c.from] = c.to;
+            }
+            positionRemap[r0] = r1;
+            collapseLocked[r0] = collapseLocked[r1] = true;
+
+            /* Border edge collapses remove one triangle, others two or
+               more */
+            triangleCollapseCount += kinds[c.from] == VertexKind::Border ? 1 : 2;
+            ++edgeCollapseCount;
+            resultError = Math::max(resultError, c.error);
+        }
+
+        /* No edge can be collapsed anymore due to the error or triangle
+           count limit */
+        if(!edgeCollapseCount) break;
+
+        /* Update the border and seam loops to skip the collapsed vertices.
+           If the target points back to the vertex itself, the edge was
+           collapsed in the direction opposite to the loop and the loop
+           continues from where the collapsed vertex pointed to. That one
+           may or may not be already updated, so it's remapped again. */
+        for(Containers::ArrayView<UnsignedInt> loopArray: {Containers::arrayView(loop), Containers::arrayView(loopback)}) {
+            for(UnsignedInt j = 0; j != vertexCount; ++j) {
+                const UnsignedInt l = loopArray[j];
+                if(l == None) continue;
+                const UnsignedInt r = collapseRemap[l];
+                if(j != r)
+                    loopArray[j] = r;
+                else
+                    loopArray[j] = loopArray[l] == None ? None : collapseRemap[loopArray[l]];
+            }
+        }
+
+        /* Remap the index buffer and remove degenerate triangles */
+        std::size_t newResultCount = 0;
+        for(std::size_t i = 0; i != resultCount; i += 3) {
+            const UnsignedInt a = collapseRemap[result[i + 0]];
+            const UnsignedInt b = collapseRemap[result[i + 1]];
+            const UnsignedInt c = collapseRemap[result[i + 2]];
+            if(a == b || a == c || b == c) continue;
+            result[newResultCount++] = a;
+            result[newResultCount++] = b;
+            result[newResultCount++] = c;
+        }
+        CORRADE_INTERNAL_ASSERT(newResultCount < resultCount);
+        resultCount = newResultCount;
+    }
+
+    return {resultCount, Math::sqrt(resultError)};
+}
+
+template<class T> Containers::Pair<std::size_t, Float> simplifyInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::simplifyInPlace(): index count not divisible by 3", {});
+    CORRADE_ASSERT(targetError >= 0.0f,
+        "MeshTools::simplifyInPlace(): expected a non-negative target error but got" << targetError, {});
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::simplifyInPlace(): index" << index << "out of bounds for" << positions.size() << "elements", {});
+    #endif
+
+    /* Operate on a contiguous 32-bit copy of the indices and copy the result
+       back */
+    Containers::Array<UnsignedInt> indicesUnsignedInt{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indicesUnsignedInt[i] = indices[i];
+    const Containers::Pair<std::size_t, Float> out = simplifyImplementation(indicesUnsignedInt, positions, targetIndexCount, targetError);
+    for(std::size_t i = 0; i != out.first(); ++i)
+        indices[i] = T(indicesUnsignedInt[i]);
+    return out;
+}
+
+template<class T> void copyIndicesInto(const Containers::ArrayView<const UnsignedInt> indices, const Containers::ArrayView<char> out) {
+    const Containers::ArrayView<T> outT = Containers::arrayCast<T>(out);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        outT[i] = T(indices[i]);
+}
+
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, targetError);
+}
+
+Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const std::size_t targetIndexCount, const Float targetError) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::simplifyInPlace(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return simplifyInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), positions, targetIndexCount, targetError);
+    else if(indices.size()[1] == 2)
+        return simplifyInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), positions, targetIndexCount, targetError);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::simplifyInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return simplifyInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), positions, targetIndexCount, targetError);
+    }
+}
+
+Trade::MeshData simplify(const Trade::MeshData& mesh, const std::size_t targetIndexCount, const Float targetError) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplify(): expected" << MeshPrimitive::Triangles << "but got" << mesh.primitive(),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::simplify(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(!isMeshIndexTypeImplementationSpecific(mesh.indexType()),
+        "MeshTools::simplify(): mesh has an implementation-specific index type" << reinterpret_cast<void*>(meshIndexTypeUnwrap(mesh.indexType())),
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplify(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const VertexFormat format = mesh.attributeFormat(i);
+        CORRADE_ASSERT(!isVertexFormatImplementationSpecific(format),
+            "MeshTools::simplify(): attribute" << i << "has an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format)),
+            (Trade::MeshData{MeshPrimitive{}, 0}));
+    }
+    #endif
+
+    Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    const std::size_t indexCount = simplifyInPlace(Containers::stridedArrayView(indices), positions, targetIndexCount, targetError).first();
+    const Containers::ArrayView<UnsignedInt> simplified = indices.prefix(indexCount);
+
+    /* Put the vertices in the order of first use. All vertices that are no
+       longer referenced are at the end, which makes the remaining vertex
+       count equal to the largest index plus one. */
+    const Containers::Array<UnsignedInt> mapping = reorderForVertexFetchInPlace(simplified, mesh.vertexCount());
+    UnsignedInt vertexCount = 0;
+    for(const UnsignedInt index: simplified)
+        vertexCount = Math::max(vertexCount, index + 1);
+
+    /* Copy the referenced vertices to a new interleaved layout */
+    Trade::MeshData layout = interleavedLayout(mesh, vertexCount);
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        duplicateInto(mapping.prefix(vertexCount), mesh.attribute(i), layout.mutableAttribute(i));
+
+    /* Put the indices back into the original type */
+    const MeshIndexType indexType = mesh.indexType();
+    Containers::Array<char> indexData{NoInit, indexCount*meshIndexTypeSize(indexType)};
+    if(indexType == MeshIndexType::UnsignedInt)
+        copyIndicesInto<UnsignedInt>(simplified, indexData);
+    else if(indexType == MeshIndexType::UnsignedShort)
+        copyIndicesInto<UnsignedShort>(simplified, indexData);
+    else if(indexType == MeshIndexType::UnsignedByte)
+        copyIndicesInto<UnsignedByte>(simplified, indexData);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    const Trade::MeshIndexData indexDataView{indexType, indexData};
+
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), indexDataView,
+        layout.releaseVertexData(), layout.releaseAttributeData(),
+        vertexCount};
+}
+
+Containers::Array<Trade::MeshData> simplifyLevels(const Trade::MeshData& mesh, const UnsignedInt levelCount, const Float ratio, const Float targetError) {
+    CORRADE_ASSERT(ratio > 0.0f && ratio < 1.0f,
+        "MeshTools::simplifyLevels(): expected ratio to be between 0 and 1 but got" << ratio,
+        {});
+
+    Containers::Array<Trade::MeshData> out;
+    if(!levelCount) return out;
+
+    /* The first level is the original mesh. Passing it through simplify()
+       with no reduction to get the same asserts and a copy with the same
+       layout as the other levels. */
+    arrayAppend(out, simplify(mesh, mesh.indexCount()));
+
+    for(UnsignedInt i = 1; i != levelCount; ++i) {
+        const Trade::MeshData& previous = out.back();
+        const std::size_t targetIndexCount = std::size_t(previous.indexCount()*ratio)/3*3;
+        Trade::MeshData level = simplify(previous, targetIndexCount, targetError);
+
+        /* Stop if the level couldn't be simplified any further */
+        if(level.indexCount() == previous.indexCount()) break;
+
+        /* If the target error was hit before reaching the index count, the
+           next levels would only accumulate more error while removing just a
+           few more triangles. Keep the level but end the chain. */
+        const bool errorLimited = level.indexCount() > targetIndexCount;
+        arrayAppend(out, std::move(level));
+        if(errorLimited) break;
+    }
+
+    /* Convert back to a default deleter to make this usable in plugins */
+    arrayShrink(out, DefaultInit);
+    return out;
+}
+
+}}
@@ -0,0 +1,159 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplifyInPlace(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::simplifyLevels()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify a triangle mesh in-place
+@param[in,out] indices      Triangle index array to operate on
+@param[in] positions        Vertex positions
+@param[in] targetIndexCount Target index count
+@param[in] targetError      Target error relative to the mesh size
+@return Resulting index count and the error it was achieved with
+@m_since_latest
+
+Reduces the triangle count using edge collapses ranked by a quadric error
+metric, as described in *Michael Garland, Paul S. Heckbert --- Surface
+Simplification Using Quadric Error Metrics, SIGGRAPH 1997*. The simplified
+triangles are put in the prefix of @p indices with size equal to the first
+returned value, contents of the remaining part are unspecified. Vertex data are
+not touched, each collapse moves a vertex onto one of its neighbors, so the
+output references a subset of the original vertices.
+
+Vertices with bitwise equal positions are treated as a single vertex for the
+purposes of mesh topology. Such vertices usually come from an attribute seam,
+where for example two different normals or texture coordinates meet at a
+single position. If the seam forms a continuous edge loop, it's preserved by
+collapsing only along it, mesh borders are preserved the same way and vertices
+with a more complex topology are not moved at all. To simplify meshes with no
+shared vertices, such as non-indexed meshes or meshes with flat normals,
+remove the duplicate data with @ref removeDuplicates() first. Note that only
+the topology of the seams is preserved, attribute values don't affect the
+collapse ranking.
+
+The simplification stops when @p targetIndexCount is reached, when the next
+collapse would result in a distance from the original surface larger than
+@p targetError or when there's no collapse left that would preserve the mesh
+topology and not flip any triangle. The error is relative to the largest side
+of the mesh bounding box. Pass @cpp 0 @ce for @p targetIndexCount to have the
+simplification driven only by the error, the default @ref Constants::inf()
+for @p targetError makes it driven only by the index count. The second
+returned value is the largest error of all performed collapses, relative to
+the mesh size as well.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than size of @p positions and @p targetError is not negative.
+@see @ref MeshPrimitive::Triangles, @ref simplify(), @ref simplifyLevels()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf());
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf());
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf());
+
+/**
+@brief Simplify a type-erased triangle mesh in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, std::size_t, Float)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<std::size_t, Float> simplifyInPlace(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf());
+
+/**
+@brief Simplify a mesh
+@m_since_latest
+
+Expects that the mesh is an indexed @ref MeshPrimitive::Triangles with a
+@ref Trade::MeshAttribute::Position, which is converted to a 3D vector array
+using @ref Trade::MeshData::positions3DAsArray() and passed together with a
+copy of the index buffer to
+@ref simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, std::size_t, Float).
+The vertices that are no longer referenced are then removed, with the rest
+put in an order matching @ref reorderForVertexFetch(). The output has the same
+index type as @p mesh and an interleaved vertex layout as produced by
+@ref interleavedLayout().
+
+Expects that no attribute has an implementation-specific format. This
+function will unconditionally make a copy of all data.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(const Trade::MeshData& mesh, std::size_t targetIndexCount, Float targetError = Constants::inf());
+
+/**
+@brief Create a chain of progressively simplified meshes
+@param mesh         Mesh to simplify
+@param levelCount   Maximum count of levels, including the original
+@param ratio        Index count ratio between consecutive levels
+@param targetError  Target error relative to the mesh size
+@m_since_latest
+
+The first level is @p mesh passed through @ref simplify() with the target
+index count equal to its index count, i.e. with no triangles removed but with
+the vertex data compacted the same way as in the other levels. Each following
+level is made with @ref simplify() from the previous one with the target index
+count being @p ratio times the index count of the previous level. The error is
+not accumulated across the levels, i.e. each level has an error at most
+@p targetError relative to the previous one. If a level can't be simplified
+any further or it doesn't reach the target index count because of
+@p targetError, the chain ends early, so the returned array can have less than
+@p levelCount items. The result can be passed directly to
+@ref Trade::AbstractSceneConverter::add(const Containers::Iterable<const Trade::MeshData>&, Containers::StringView)
+for converters supporting @ref Trade::SceneConverterFeature::MeshLevels.
+
+Expects that @p ratio is greater than @cpp 0.0f @ce and less than
+@cpp 1.0f @ce, the same requirements as in @ref simplify() are imposed on
+@p mesh.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshData> simplifyLevels(const Trade::MeshData& mesh, UnsignedInt levelCount, Float ratio = 0.5f, Float targetError = Constants::inf());
+
+}}
+
+#endif
@@ -0,0 +1,617 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/BoundingVolumeHierarchy.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct BoundingVolumeHierarchyTest: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyTest();
+
+    template<class T> void construct();
+    void constructErased();
+    void constructErasedNotContiguous();
+    void constructErasedWrongIndexSize();
+    void constructEmpty();
+    void constructSphere();
+    void constructMultithreaded();
+    void constructMeshData();
+    void constructMeshDataNotIndexed();
+    void constructIndexCountNotDivisibleByThree();
+    void constructIndexOutOfBounds();
+    void constructZeroMaxLeafSize();
+    void constructMeshDataNotTriangles();
+    void constructMeshDataImplementationSpecificIndexType();
+    void constructMeshDataNoPositions();
+    void constructMeshDataVertexCountNotDivisibleByThree();
+
+    void closestHit();
+    void closestHitMaxDistance();
+    void closestHitBackFace();
+    void closestHitEmpty();
+    void anyHit();
+    void hitSphere();
+
+    void benchmarkConstruct();
+    void benchmarkConstructMultithreaded();
+    void benchmarkClosestHit();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt maxLeafSize;
+} SphereData[]{
+    {"max leaf size 1", 1},
+    {"max leaf size 4", 4},
+    {"max leaf size 16", 16}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} MultithreadedData[]{
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"all available threads", 0}
+};
+
+/* Two quads, the second is two units below the first. Triangles 0 and 2
+   cover the bottom right half of each quad, 1 and 3 the top left half. */
+const Vector3 QuadPositions[]{
+    {-1.0f, -1.0f, 0.0f},
+    { 1.0f, -1.0f, 0.0f},
+    { 1.0f,  1.0f, 0.0f},
+    {-1.0f,  1.0f, 0.0f},
+
+    {-1.0f, -1.0f, -2.0f},
+    { 1.0f, -1.0f, -2.0f},
+    { 1.0f,  1.0f, -2.0f},
+    {-1.0f,  1.0f, -2.0f}
+};
+
+const UnsignedInt QuadIndices[]{
+    0, 1, 2, 0, 2, 3,
+    4, 5, 6, 4, 6, 7
+};
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests<BoundingVolumeHierarchyTest>({
+        &BoundingVolumeHierarchyTest::construct<UnsignedInt>,
+        &BoundingVolumeHierarchyTest::construct<UnsignedShort>,
+        &BoundingVolumeHierarchyTest::construct<UnsignedByte>,
+        &BoundingVolumeHierarchyTest::constructErased,
+        &BoundingVolumeHierarchyTest::constructErasedNotContiguous,
+        &BoundingVolumeHierarchyTest::constructErasedWrongIndexSize,
+        &BoundingVolumeHierarchyTest::constructEmpty});
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::constructSphere},
+        Containers::arraySize(SphereData));
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::constructMultithreaded},
+        Containers::arraySize(MultithreadedData));
+
+    addTests({&BoundingVolumeHierarchyTest::constructMeshData,
+              &BoundingVolumeHierarchyTest::constructMeshDataNotIndexed,
+              &BoundingVolumeHierarchyTest::constructIndexCountNotDivisibleByThree,
+              &BoundingVolumeHierarchyTest::constructIndexOutOfBounds,
+              &BoundingVolumeHierarchyTest::constructZeroMaxLeafSize,
+              &BoundingVolumeHierarchyTest::constructMeshDataNotTriangles,
+              &BoundingVolumeHierarchyTest::constructMeshDataImplementationSpecificIndexType,
+              &BoundingVolumeHierarchyTest::constructMeshDataNoPositions,
+              &BoundingVolumeHierarchyTest::constructMeshDataVertexCountNotDivisibleByThree,
+
+              &BoundingVolumeHierarchyTest::closestHit,
+              &BoundingVolumeHierarchyTest::closestHitMaxDistance,
+              &BoundingVolumeHierarchyTest::closestHitBackFace,
+              &BoundingVolumeHierarchyTest::closestHitEmpty,
+              &BoundingVolumeHierarchyTest::anyHit});
+
+    addInstancedTests({&BoundingVolumeHierarchyTest::hitSphere},
+        Containers::arraySize(SphereData));
+
+    addBenchmarks({&BoundingVolumeHierarchyTest::benchmarkConstruct,
+                   &BoundingVolumeHierarchyTest::benchmarkConstructMultithreaded,
+                   &BoundingVolumeHierarchyTest::benchmarkClosestHit}, 10);
+}
+
+/* Returns an empty string if the hierarchy is valid, a description of the
+   first problem otherwise */
+std::string validate(const BoundingVolumeHierarchy& bvh, const Containers::StridedArrayView1D<const Vector3>& triangles, const UnsignedInt maxLeafSize) {
+    const Containers::ArrayView<const BoundingVolumeHierarchy::Node> nodes = bvh.nodes();
+    const auto contains = [](const Range3D& a, const Range3D& b) {
+        return (a.min() <= b.min()).all() && (a.max() >= b.max()).all();
+    };
+
+    Containers::Array<UnsignedInt> triangleUseCount{ValueInit, triangles.size()/3};
+    for(std::size_t i = 0; i != nodes.size(); ++i) {
+        const BoundingVolumeHierarchy::Node& node = nodes[i];
+        if(node.count) {
+            if(node.count > maxLeafSize)
+                return "leaf " + std::to_string(i) + " has " + std::to_string(node.count) + " triangles";
+            for(UnsignedInt j = node.offset; j != node.offset + node.count; ++j) {
+                const UnsignedInt id = bvh.triangleIds()[j];
+                ++triangleUseCount[id];
+                for(std::size_t k = 0; k != 3; ++k)
+                    if(!contains(node.bounds, Range3D{triangles[id*3 + k], triangles[id*3 + k]}))
+                        return "triangle " + std::to_string(id) + " outside of leaf " + std::to_string(i);
+            }
+        } else {
+            if(node.offset <= i + 1 || node.offset >= nodes.size())
+                return "node " + std::to_string(i) + " has an invalid second child " + std::to_string(node.offset);
+            if(!contains(node.bounds, nodes[i + 1].bounds) ||
+               !contains(node.bounds, nodes[node.offset].bounds))
+                return "children of node " + std::to_string(i) + " are not contained in it";
+        }
+    }
+
+    for(std::size_t i = 0; i != triangleUseCount.size(); ++i)
+        if(triangleUseCount[i] != 1)
+            return "triangle " + std::to_string(i) + " referenced " + std::to_string(triangleUseCount[i]) + " times";
+
+    return {};
+}
+
+/* Brute-force reference for closestHit(), returns the closest distance or
+   infinity if nothing was hit */
+Float bruteForceClosestHit(const Containers::StridedArrayView1D<const Vector3>& triangles, const Vector3& origin, const Vector3& direction) {
+    Float closest = Constants::inf();
+    for(std::size_t i = 0; i != triangles.size(); i += 3) {
+        const Vector3 edge1 = triangles[i + 1] - triangles[i];
+        const Vector3 edge2 = triangles[i + 2] - triangles[i];
+        const Vector3 p = Math::cross(direction, edge2);
+        const Float determinant = Math::dot(edge1, p);
+        if(determinant == 0.0f) continue;
+        const Float inverseDeterminant = 1.0f/determinant;
+        const Vector3 s = origin - triangles[i];
+        const Float u = Math::dot(s, p)*inverseDeterminant;
+        const Vector3 q = Math::cross(s, edge1);
+        const Float v = Math::dot(direction, q)*inverseDeterminant;
+        const Float t = Math::dot(edge2, q)*inverseDeterminant;
+        if(u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f)
+            closest = Math::min(closest, t);
+    }
+    return closest;
+}
+
+template<class T> void BoundingVolumeHierarchyTest::construct() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(QuadIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(QuadIndices); ++i)
+        indices[i] = QuadIndices[i];
+
+    /* With one triangle per leaf it has to be split all the way down */
+    BoundingVolumeHierarchy bvh{Containers::stridedArrayView(indices), QuadPositions, 1};
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, -2.0f}, {1.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(bvh.nodes().size(), 7);
+    CORRADE_COMPARE(bvh.triangleIds().size(), 4);
+    CORRADE_COMPARE(bvh.nodes()[0].count, 0);
+
+    Vector3 triangles[Containers::arraySize(QuadIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(QuadIndices); ++i)
+        triangles[i] = QuadPositions[QuadIndices[i]];
+    CORRADE_COMPARE(validate(bvh, triangles, 1), "");
+}
+
+void BoundingVolumeHierarchyTest::constructErased() {
+    const UnsignedShort indices[]{0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+
+    BoundingVolumeHierarchy bvh{Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), QuadPositions};
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, -2.0f}, {1.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(bvh.triangleIds().size(), 4);
+
+    Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangleId, 0);
+}
+
+void BoundingVolumeHierarchyTest::constructErasedNotContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, QuadPositions};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: second index view dimension is not contiguous\n");
+}
+
+void BoundingVolumeHierarchyTest::constructErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Containers::StridedArrayView2D<const char>{indices, {6, 3}}, QuadPositions};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void BoundingVolumeHierarchyTest::constructEmpty() {
+    BoundingVolumeHierarchy bvh{Containers::StridedArrayView1D<const UnsignedInt>{}, QuadPositions};
+    CORRADE_COMPARE(bvh.bounds(), Range3D{});
+    CORRADE_VERIFY(bvh.nodes().isEmpty());
+    CORRADE_VERIFY(bvh.triangleIds().isEmpty());
+}
+
+void BoundingVolumeHierarchyTest::constructSphere() {
+    auto&& data = SphereData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData sphere = Primitives::icosphereSolid(4);
+    const Containers::Array<UnsignedInt> indices = sphere.indicesAsArray();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    BoundingVolumeHierarchy bvh{indices, positions, data.maxLeafSize};
+    CORRADE_COMPARE(bvh.triangleIds().size(), indices.size()/3);
+
+    Containers::Array<Vector3> triangles{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        triangles[i] = positions[indices[i]];
+    CORRADE_COMPARE(validate(bvh, triangles, data.maxLeafSize), "");
+
+    /* A balanced-enough tree should have less than twice the nodes needed
+       for a full binary tree with the leaves all full */
+    CORRADE_COMPARE_AS(bvh.nodes().size(), 4*indices.size()/3,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void BoundingVolumeHierarchyTest::constructMultithreaded() {
+    auto&& data = MultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Over 200k triangles, which is enough to be split among at least 8
+       threads. The result should be exactly the same as with the serial
+       variant. */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(320, 320);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    BoundingVolumeHierarchy expected{indices, positions};
+    BoundingVolumeHierarchy bvh{indices, positions, 4, data.threadCount};
+    CORRADE_COMPARE_AS(bvh.triangleIds(),
+        expected.triangleIds(),
+        TestSuite::Compare::Container);
+    /* Comparing the nodes bitwise, as there's no comparison operator for
+       them */
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(bvh.nodes()),
+        Containers::arrayCast<const UnsignedInt>(expected.nodes()),
+        TestSuite::Compare::Container);
+}
+
+void BoundingVolumeHierarchyTest::constructMeshData() {
+    Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32);
+
+    BoundingVolumeHierarchy bvh{sphere, 2};
+    CORRADE_COMPARE(bvh.triangleIds().size(), sphere.indexCount()/3);
+    CORRADE_COMPARE(bvh.bounds(), (Range3D{{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}));
+
+    const Containers::Array<UnsignedInt> indices = sphere.indicesAsArray();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    Containers::Array<Vector3> triangles{NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        triangles[i] = positions[indices[i]];
+    CORRADE_COMPARE(validate(bvh, triangles, 2), "");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshDataNotIndexed() {
+    Vector3 triangles[Containers::arraySize(QuadIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(QuadIndices); ++i)
+        triangles[i] = QuadPositions[QuadIndices[i]];
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, triangles, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(triangles)}
+    }};
+
+    BoundingVolumeHierarchy bvh{mesh, 1};
+    CORRADE_COMPARE(bvh.triangleIds().size(), 4);
+    CORRADE_COMPARE(validate(bvh, triangles, 1), "");
+
+    Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({-0.5f, 0.5f, -5.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangleId, 3);
+    CORRADE_COMPARE(hit->distance, 3.0f);
+}
+
+void BoundingVolumeHierarchyTest::constructIndexCountNotDivisibleByThree() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{Containers::arrayView(QuadIndices).exceptSuffix(1), QuadPositions};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: index count not divisible by 3\n");
+}
+
+void BoundingVolumeHierarchyTest::constructIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{QuadIndices, Containers::arrayView(QuadPositions).exceptSuffix(1)};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: index 7 out of bounds for 7 elements\n");
+}
+
+void BoundingVolumeHierarchyTest::constructZeroMaxLeafSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{QuadIndices, QuadPositions, 0};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: expected max leaf size to be at least 1\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::TriangleFan, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{mesh};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: expected MeshPrimitive::Triangles but got MeshPrimitive::TriangleFan\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{mesh};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{mesh};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: the mesh has no positions\n");
+}
+
+void BoundingVolumeHierarchyTest::constructMeshDataVertexCountNotDivisibleByThree() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, QuadPositions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(QuadPositions)}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    BoundingVolumeHierarchy{mesh};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::BoundingVolumeHierarchy: vertex count not divisible by 3\n");
+}
+
+void BoundingVolumeHierarchyTest::closestHit() {
+    BoundingVolumeHierarchy bvh{QuadIndices, QuadPositions, 1};
+
+    /* From above hits the first quad, bottom right triangle */
+    {
+        Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f});
+        CORRADE_VERIFY(hit);
+        CORRADE_COMPARE(hit->triangleId, 0);
+        CORRADE_COMPARE(hit->distance, 5.0f);
+        CORRADE_COMPARE(hit->barycentric, (Vector2{0.5f, 0.25f}));
+
+    /* From below hits the second quad, top left triangle. The distance is in
+       multiples of the direction length. */
+    } {
+        Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({-0.5f, 0.5f, -5.0f}, {0.0f, 0.0f, 2.0f});
+        CORRADE_VERIFY(hit);
+        CORRADE_COMPARE(hit->triangleId, 3);
+        CORRADE_COMPARE(hit->distance, 1.5f);
+
+    /* From between the quads in a slanted direction hits the first */
+    } {
+        Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({0.0f, 0.0f, -1.0f}, {0.5f, 0.0f, 1.0f});
+        CORRADE_VERIFY(hit);
+        CORRADE_COMPARE(hit->triangleId, 0);
+        CORRADE_COMPARE(hit->distance, 1.0f);
+        CORRADE_COMPARE(hit->barycentric, (Vector2{0.25f, 0.5f}));
+
+    /* Missing both quads */
+    } {
+        CORRADE_VERIFY(!bvh.closestHit({3.0f, 0.0f, 5.0f}, {0.0f, 0.0f, -1.0f}));
+
+    /* Pointing away from both quads */
+    } {
+        CORRADE_VERIFY(!bvh.closestHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, 1.0f}));
+    }
+}
+
+void BoundingVolumeHierarchyTest::closestHitMaxDistance() {
+    BoundingVolumeHierarchy bvh{QuadIndices, QuadPositions, 1};
+
+    CORRADE_VERIFY(!bvh.closestHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f}, 4.5f));
+
+    /* Max distance is inclusive */
+    Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f}, 5.0f);
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->distance, 5.0f);
+}
+
+void BoundingVolumeHierarchyTest::closestHitBackFace() {
+    BoundingVolumeHierarchy bvh{QuadIndices, QuadPositions, 1};
+
+    /* Starting between the quads and going up hits the first quad from the
+       back */
+    Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit({0.5f, -0.5f, -1.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit->triangleId, 0);
+    CORRADE_COMPARE(hit->distance, 1.0f);
+    CORRADE_COMPARE(hit->barycentric, (Vector2{0.5f, 0.25f}));
+}
+
+void BoundingVolumeHierarchyTest::closestHitEmpty() {
+    BoundingVolumeHierarchy bvh{Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr};
+    CORRADE_VERIFY(!bvh.closestHit({}, {0.0f, 0.0f, 1.0f}));
+    CORRADE_VERIFY(!bvh.anyHit({}, {0.0f, 0.0f, 1.0f}));
+}
+
+void BoundingVolumeHierarchyTest::anyHit() {
+    BoundingVolumeHierarchy bvh{QuadIndices, QuadPositions, 1};
+
+    CORRADE_VERIFY(bvh.anyHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f}));
+    CORRADE_VERIFY(bvh.anyHit({0.5f, -0.5f, -1.0f}, {0.0f, 0.0f, -1.0f}));
+    CORRADE_VERIFY(!bvh.anyHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, -1.0f}, 4.5f));
+    CORRADE_VERIFY(!bvh.anyHit({3.0f, 0.0f, 5.0f}, {0.0f, 0.0f, -1.0f}));
+    CORRADE_VERIFY(!bvh.anyHit({0.5f, -0.5f, 5.0f}, {0.0f, 0.0f, 1.0f}));
+}
+
+void BoundingVolumeHierarchyTest::hitSphere() {
+    auto&& data = SphereData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A bigger and a smaller sphere inside it, to have rays from outside hit
+       the smaller one from the inside of the bigger one as well */
+    Trade::MeshData sphere = Primitives::icosphereSolid(3);
+    const Containers::Array<UnsignedInt> indices = sphere.indicesAsArray();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    Containers::Array<Vector3> triangles{NoInit, indices.size()*2};
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        triangles[i] = positions[indices[i]]*2.0f;
+        triangles[indices.size() + i] = positions[indices[i]]*0.5f + Vector3{0.25f, 0.0f, 0.0f};
+    }
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, triangles, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(triangles)}
+    }};
+    BoundingVolumeHierarchy bvh{mesh, data.maxLeafSize};
+
+    /* Rays from outside and from inside, toward points around the center */
+    std::size_t hitCount = 0;
+    for(std::size_t i = 0; i != 200; ++i) {
+        CORRADE_ITERATION(i);
+        const Float angle = Float(i)*0.37f;
+        const Vector3 origin = (i % 2 ? 4.0f : 1.0f)*Vector3{Math::cos(Rad(angle)), Math::sin(Rad(angle*1.7f)), Math::sin(Rad(angle))};
+        const Vector3 target{Math::sin(Rad(angle*2.3f)), Math::cos(Rad(angle*0.9f)), 0.0f};
+        const Vector3 direction = target - origin;
+
+        const Float expected = bruteForceClosestHit(triangles, origin, direction);
+        Containers::Optional<BoundingVolumeHierarchy::Hit> hit = bvh.closestHit(origin, direction);
+        CORRADE_COMPARE(bool(hit), expected != Constants::inf());
+        CORRADE_COMPARE(bvh.anyHit(origin, direction), bool(hit));
+        if(!hit) continue;
+
+        ++hitCount;
+        CORRADE_COMPARE(hit->distance, expected);
+
+        /* The hit point calculated from the barycentric coordinates should
+           match the one calculated from the distance */
+        const Vector3* triangle = triangles.data() + 3*hit->triangleId;
+        CORRADE_COMPARE_AS((
+            triangle[0]*(1.0f - hit->barycentric.sum()) +
+            triangle[1]*hit->barycentric.x() +
+            triangle[2]*hit->barycentric.y() -
+            origin - direction*hit->distance).length(), 1.0e-4f,
+            TestSuite::Compare::Less);
+    }
+
+    /* Most rays should hit something */
+    CORRADE_COMPARE_AS(hitCount, 150,
+        TestSuite::Compare::Greater);
+}
+
+void BoundingVolumeHierarchyTest::benchmarkConstruct() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    std::size_t nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        BoundingVolumeHierarchy bvh{indices, positions};
+        nodeCount += bvh.nodes().size();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BoundingVolumeHierarchyTest::benchmarkConstructMultithreaded() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    std::size_t nodeCount = 0;
+    CORRADE_BENCHMARK(1) {
+        BoundingVolumeHierarchy bvh{indices, positions, 4, 0};
+        nodeCount += bvh.nodes().size();
+    }
+
+    CORRADE_VERIFY(nodeCount);
+}
+
+void BoundingVolumeHierarchyTest::benchmarkClosestHit() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500);
+    BoundingVolumeHierarchy bvh{sphere};
+
+    /* 10k rays from outside toward the center */
+    std::size_t hitCount = 0;
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != 10000; ++i) {
+            const Float angle = Float(i)*0.01f;
+            const Vector3 origin = 3.0f*Vector3{Math::cos(Rad(angle)), Math::sin(Rad(angle*1.7f)), Math::sin(Rad(angle))};
+            if(bvh.closestHit(origin, -origin)) ++hitCount;
+        }
+    }
+
+    CORRADE_VERIFY(hitCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::BoundingVolumeHierarchyTest)
@@ -0,0 +1,657 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/EncodeMesh.h"
+#include "Magnum/Primitives/Cube.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct EncodeMeshTest: TestSuite::Tester {
+    explicit EncodeMeshTest();
+
+    template<class T> void triangleIndices();
+    void triangleIndicesErased();
+    void triangleIndicesErasedNotContiguous();
+    void triangleIndicesErasedWrongIndexSize();
+    void triangleIndicesDifferentDecodedType();
+    void triangleIndicesSphere();
+    void triangleIndicesEmpty();
+    void triangleIndicesInvalid();
+    void triangleIndicesNotDivisibleByThree();
+
+    void vertexStream();
+    void vertexStreamRoundTrip();
+    void vertexStreamInvalidSize();
+    void vertexStreamInvalidComponentSize();
+
+    void mesh();
+    void meshImplementationSpecificIndexType();
+    void meshImplementationSpecificVertexFormat();
+    void meshInvalid();
+    void meshInvalidIndexOutOfRange();
+    void meshDifferentEndianness();
+
+    void benchmarkDecodeTriangleIndices();
+    void benchmarkDecodeVertexStream();
+};
+
+const UnsignedInt TriangleIndices[]{
+    0, 1, 2,
+    2, 1, 3,    /* shares the 2-1 edge with the first triangle */
+    4, 2, 3,    /* shares the 2-3 edge with the second triangle */
+    6, 5, 0,    /* no shared edge, 6 and 0 are encoded explicitly */
+    5, 6, 7     /* shares the 5-6 edge, 7 is explicit as 6 was skipped */
+};
+
+/* Code bytes first, then the zig-zag-encoded deltas of explicit vertices */
+const char TriangleIndicesEncoded[]{
+    '\x03', '\x10', '\x01', '\x17', '\x24',
+    '\x0c', '\x0b', '\x0e'
+};
+
+const struct {
+    const char* name;
+    std::size_t size;
+    char data[10];
+} TriangleIndicesInvalidData[]{
+    {"too short for all code bytes", 4,
+        {'\x03', '\x10', '\x01', '\x17'}},
+    {"truncated explicit vertex data", 7,
+        {'\x03', '\x10', '\x01', '\x17', '\x24', '\x0c', '\x0b'}},
+    {"unconsumed data at the end", 9,
+        {'\x03', '\x10', '\x01', '\x17', '\x24', '\x0c', '\x0b', '\x0e', '\x00'}},
+    {"reserved bit set for a shared edge", 8,
+        {'\x03', '\x18', '\x01', '\x17', '\x24', '\x0c', '\x0b', '\x0e'}},
+    {"reserved bits set for no shared edge", 8,
+        {'\x03', '\x10', '\x01', '\x37', '\x24', '\x0c', '\x0b', '\x0e'}},
+    {"delta longer than five bytes", 10,
+        {'\x03', '\x10', '\x01', '\x17', '\x24', '\xff', '\xff', '\xff', '\xff', '\xff'}},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt componentSize;
+} VertexStreamRoundTripData[]{
+    {"1-byte components", 1},
+    {"2-byte components", 2},
+    {"4-byte components", 4},
+    {"8-byte components", 8}
+};
+
+const struct ArrayAttributeVertex {
+    Vector3 position;
+    Double weights[2];
+    UnsignedShort objectId;
+} ArrayAttributeVertices[]{
+    {{0.0f, 1.0f, 1.5f}, {0.25, 0.75}, 1000},
+    {{1.0f, 0.0f, 1.5f}, {0.5, 0.5}, 999},
+    {{1.0f, 1.0f, -1.5f}, {1.0, 0.0}, 1003},
+    {{0.0f, 0.0f, -1.5f}, {0.0, 1.0}, 997}
+};
+
+const UnsignedByte ArrayAttributeIndices[]{2, 1, 0, 1, 2, 3};
+
+Trade::MeshData meshWithArrayAttribute() {
+    Containers::StridedArrayView1D<const ArrayAttributeVertex> vertices = ArrayAttributeVertices;
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, ArrayAttributeIndices, Trade::MeshIndexData{ArrayAttributeIndices},
+        {}, ArrayAttributeVertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                vertices.slice(&ArrayAttributeVertex::position)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(15),
+                VertexFormat::Double,
+                vertices.slice(&ArrayAttributeVertex::weights), 2},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                vertices.slice(&ArrayAttributeVertex::objectId)},
+        }};
+}
+
+const struct {
+    const char* name;
+    Trade::MeshData(*mesh)();
+    bool compressesIndices;
+} MeshData[]{
+    {"indexed triangles", []() {
+        return Primitives::icosphereSolid(3);
+    }, true},
+    {"indexed triangles with all attributes", []() {
+        return Primitives::uvSphereSolid(16, 32,
+            Primitives::UVSphereFlag::TextureCoordinates|
+            Primitives::UVSphereFlag::Tangents);
+    }, true},
+    {"indexed lines", []() {
+        return Primitives::grid3DWireframe({5, 3});
+    }, false},
+    {"non-indexed triangle strip", Primitives::cubeSolidStrip, false},
+    {"8-bit indices, array attribute", meshWithArrayAttribute, true},
+};
+
+/* Header of a mesh with three Vector3 positions and a single 16-bit indexed
+   triangle is 40 bytes, the attribute header is 16 bytes, followed by a
+   single code byte and 36 bytes of positions */
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    UnsignedLong value;
+    UnsignedInt valueSize;
+    const char* message;
+} MeshInvalidData[]{
+    {"too short for a header", 39, 0, 0, 0,
+        "expected at least 40 bytes for a header but got 39"},
+    {"invalid signature", 93, 0, 'N', 1,
+        "invalid signature"},
+    {"unsupported version", 93, 4, 2, 1,
+        "unsupported version 2"},
+    {"invalid primitive", 93, 8, 0xdead, 4,
+        "invalid primitive MeshPrimitive(0xdead)"},
+    {"invalid index encoding", 93, 6, 3, 1,
+        "invalid index encoding 3"},
+    {"index data for a non-indexed mesh", 93, 6, 0, 1,
+        "expected no index data for a non-indexed mesh but got 1 bytes"},
+    {"invalid index type", 93, 12, 4, 4,
+        "invalid index type 4"},
+    {"triangle index count not divisible by three", 93, 16, 4, 4,
+        "triangle index count 4 not divisible by 3"},
+    {"triangle index data too short", 93, 16, 3000, 4,
+        "expected at least 1000 bytes of index data for 1000 triangles but got 1"},
+    {"stream index data size mismatch", 93, 6, 2, 1,
+        "expected 6 bytes of index data but got 1"},
+    {"too short for attribute headers", 50, 0, 0, 0,
+        "expected at least 56 bytes for 1 attribute headers but got 50"},
+    {"too many attribute headers", 93, 24, 0xffffffffu, 4,
+        "expected at least 68719476760 bytes for 4294967295 attribute headers but got 93"},
+    {"index data size overflow", 93, 32, ~UnsignedLong{}, 8,
+        "index data size 18446744073709551615 out of range for 37 bytes"},
+    {"invalid attribute format", 93, 44, 0, 4,
+        "invalid attribute 0 properties"},
+    {"attribute format not compatible with the name", 93, 44, UnsignedInt(VertexFormat::UnsignedInt), 4,
+        "invalid attribute 0 properties"},
+    {"attribute array not allowed", 93, 42, 2, 2,
+        "invalid attribute 0 properties"},
+    {"attribute data size mismatch", 93, 48, 35, 4,
+        "expected 36 bytes of data for attribute 0 but got 35"},
+    {"attribute data size overflow", 93, 48, ~UnsignedLong{}, 8,
+        "attribute 0 data size 18446744073709551615 out of range for 36 bytes"},
+    {"too short for attribute data", 92, 0, 0, 0,
+        "attribute 0 data size 36 out of range for 35 bytes"},
+    {"invalid index data", 93, 56, 0xff, 1,
+        "invalid index data"},
+};
+
+Containers::Array<char> contiguous(const Containers::StridedArrayView2D<const char>& data) {
+    Containers::Array<char> out{NoInit, data.size()[0]*data.size()[1]};
+    Utility::copy(data, Containers::StridedArrayView2D<char>{out, data.size()});
+    return out;
+}
+
+EncodeMeshTest::EncodeMeshTest() {
+    addTests<EncodeMeshTest>({
+        &EncodeMeshTest::triangleIndices<UnsignedInt>,
+        &EncodeMeshTest::triangleIndices<UnsignedShort>,
+        &EncodeMeshTest::triangleIndices<UnsignedByte>,
+        &EncodeMeshTest::triangleIndicesErased,
+        &EncodeMeshTest::triangleIndicesErasedNotContiguous,
+        &EncodeMeshTest::triangleIndicesErasedWrongIndexSize,
+        &EncodeMeshTest::triangleIndicesDifferentDecodedType,
+        &EncodeMeshTest::triangleIndicesSphere,
+        &EncodeMeshTest::triangleIndicesEmpty});
+
+    addInstancedTests({&EncodeMeshTest::triangleIndicesInvalid},
+        Containers::arraySize(TriangleIndicesInvalidData));
+
+    addTests({&EncodeMeshTest::triangleIndicesNotDivisibleByThree,
+
+              &EncodeMeshTest::vertexStream});
+
+    addInstancedTests({&EncodeMeshTest::vertexStreamRoundTrip},
+        Containers::arraySize(VertexStreamRoundTripData));
+
+    addTests({&EncodeMeshTest::vertexStreamInvalidSize,
+              &EncodeMeshTest::vertexStreamInvalidComponentSize});
+
+    addInstancedTests({&EncodeMeshTest::mesh},
+        Containers::arraySize(MeshData));
+
+    addTests({&EncodeMeshTest::meshImplementationSpecificIndexType,
+              &EncodeMeshTest::meshImplementationSpecificVertexFormat});
+
+    addInstancedTests({&EncodeMeshTest::meshInvalid},
+        Containers::arraySize(MeshInvalidData));
+
+    addTests({&EncodeMeshTest::meshInvalidIndexOutOfRange,
+              &EncodeMeshTest::meshDifferentEndianness});
+
+    addBenchmarks({&EncodeMeshTest::benchmarkDecodeTriangleIndices,
+                   &EncodeMeshTest::benchmarkDecodeVertexStream}, 10);
+}
+
+template<class T> void EncodeMeshTest::triangleIndices() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(TriangleIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(TriangleIndices); ++i)
+        indices[i] = T(TriangleIndices[i]);
+
+    Containers::Array<char> encoded = encodeTriangleIndices(Containers::stridedArrayView(indices));
+    CORRADE_COMPARE_AS(encoded,
+        Containers::arrayView(TriangleIndicesEncoded),
+        TestSuite::Compare::Container);
+
+    T decoded[Containers::arraySize(TriangleIndices)];
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::triangleIndicesErased() {
+    UnsignedShort indices[Containers::arraySize(TriangleIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(TriangleIndices); ++i)
+        indices[i] = TriangleIndices[i];
+
+    Containers::Array<char> encoded = encodeTriangleIndices(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)));
+    CORRADE_COMPARE_AS(encoded,
+        Containers::arrayView(TriangleIndicesEncoded),
+        TestSuite::Compare::Container);
+
+    UnsignedShort decoded[Containers::arraySize(TriangleIndices)];
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, Containers::arrayCast<2, char>(Containers::stridedArrayView(decoded))));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::triangleIndicesErasedNotContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*4]{};
+    Containers::StridedArrayView2D<char> view{indices, {6, 2}, {4, 2}};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeTriangleIndices(view);
+    decodeTriangleIndicesInto(Containers::arrayView(TriangleIndicesEncoded), view);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeTriangleIndices(): second index view dimension is not contiguous\n"
+        "MeshTools::decodeTriangleIndicesInto(): second index view dimension is not contiguous\n");
+}
+
+void EncodeMeshTest::triangleIndicesErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*3]{};
+    Containers::StridedArrayView2D<char> view{indices, {6, 3}};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeTriangleIndices(view);
+    decodeTriangleIndicesInto(Containers::arrayView(TriangleIndicesEncoded), view);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeTriangleIndices(): expected index type size 1, 2 or 4 but got 3\n"
+        "MeshTools::decodeTriangleIndicesInto(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void EncodeMeshTest::triangleIndicesDifferentDecodedType() {
+    /* The index type isn't stored in the data, so it can be decoded to a
+       different type, and with a stride */
+    Containers::Array<char> encoded = encodeTriangleIndices(Containers::stridedArrayView(TriangleIndices));
+
+    UnsignedByte decoded[Containers::arraySize(TriangleIndices)*2]{};
+    Containers::StridedArrayView1D<UnsignedByte> decodedView = Containers::stridedArrayView(decoded).every(2);
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, decodedView));
+    CORRADE_COMPARE_AS(Containers::StridedArrayView1D<const UnsignedByte>{decodedView}, Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 2, 1, 3, 4, 2, 3, 6, 5, 0, 5, 6, 7
+    }), TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::triangleIndicesSphere() {
+    Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+
+    /* Most triangles share an edge with a preceding one and reference a
+       new vertex, so the encoded size is less than a byte per index */
+    Containers::Array<char> encoded = encodeTriangleIndices(indices);
+    CORRADE_COMPARE_AS(encoded.size(), indices.size(),
+        TestSuite::Compare::Less);
+
+    Containers::Array<UnsignedInt> decoded{NoInit, indices.size()};
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, decoded));
+    CORRADE_COMPARE_AS(decoded, indices,
+        TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::triangleIndicesEmpty() {
+    Containers::Array<char> encoded = encodeTriangleIndices(Containers::StridedArrayView1D<const UnsignedInt>{});
+    CORRADE_VERIFY(encoded.isEmpty());
+    CORRADE_VERIFY(decodeTriangleIndicesInto(encoded, Containers::StridedArrayView1D<UnsignedInt>{}));
+}
+
+void EncodeMeshTest::triangleIndicesInvalid() {
+    auto&& data = TriangleIndicesInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    UnsignedInt decoded[Containers::arraySize(TriangleIndices)];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeTriangleIndicesInto(Containers::arrayView(data.data).prefix(data.size), Containers::stridedArrayView(decoded)));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeTriangleIndicesInto(): invalid data\n");
+}
+
+void EncodeMeshTest::triangleIndicesNotDivisibleByThree() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeTriangleIndices(Containers::stridedArrayView(indices));
+    decodeTriangleIndicesInto(Containers::arrayView(TriangleIndicesEncoded), Containers::stridedArrayView(indices));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeTriangleIndices(): index count not divisible by 3\n"
+        "MeshTools::decodeTriangleIndicesInto(): index count not divisible by 3\n");
+}
+
+void EncodeMeshTest::vertexStream() {
+    const Vector2us vertices[]{
+        {1, 2},
+        {3, 1},
+        {65535, 1}
+    };
+
+    /* Differences are {1, 2}, {2, -1} and {-4, 0}, zig-zag encoded to
+       {2, 4}, {4, 1} and {7, 0}, and then split into byte planes */
+    Containers::Array<char> encoded = encodeVertexStream(Containers::arrayCast<2, const char>(Containers::stridedArrayView(vertices)), 2);
+    CORRADE_COMPARE_AS(encoded, Containers::arrayView<char>({
+        2, 4, 7,
+        0, 0, 0,
+        4, 1, 0,
+        0, 0, 0
+    }), TestSuite::Compare::Container);
+
+    Vector2us decoded[3];
+    CORRADE_VERIFY(decodeVertexStreamInto(encoded, Containers::arrayCast<2, char>(Containers::stridedArrayView(decoded)), 2));
+    CORRADE_COMPARE_AS(Containers::arrayView(decoded),
+        Containers::arrayView(vertices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::vertexStreamRoundTrip() {
+    auto&& data = VertexStreamRoundTripData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Positions and normals of every other sphere vertex, to test strided
+       input as well */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32, Primitives::UVSphereFlag::TextureCoordinates);
+    const Containers::StridedArrayView2D<const char> vertices{sphere.vertexData(),
+        {sphere.vertexCount()/2, 24},
+        {2*sphere.attributeStride(0), 1}};
+
+    Containers::Array<char> encoded = encodeVertexStream(vertices, data.componentSize);
+    CORRADE_COMPARE(encoded.size(), vertices.size()[0]*24);
+
+    Containers::Array<char> decoded{NoInit, vertices.size()[0]*24};
+    CORRADE_VERIFY(decodeVertexStreamInto(encoded, Containers::StridedArrayView2D<char>{decoded, {vertices.size()[0], 24}}, data.componentSize));
+    CORRADE_COMPARE_AS(decoded, contiguous(vertices),
+        TestSuite::Compare::Container);
+}
+
+void EncodeMeshTest::vertexStreamInvalidSize() {
+    Vector3 decoded[3];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVertexStreamInto(Containers::arrayView(TriangleIndicesEncoded), Containers::arrayCast<2, char>(Containers::stridedArrayView(decoded)), 4));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeVertexStreamInto(): expected 36 bytes but got 8\n");
+}
+
+void EncodeMeshTest::vertexStreamInvalidComponentSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char vertices[3*12]{};
+    const Containers::StridedArrayView2D<char> view{vertices, {3, 12}};
+    const Containers::StridedArrayView2D<char> viewNotContiguous{vertices, {3, 6}, {12, 2}};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeVertexStream(viewNotContiguous, 1);
+    encodeVertexStream(view, 3);
+    encodeVertexStream(view, 8);
+    decodeVertexStreamInto(vertices, viewNotContiguous, 1);
+    decodeVertexStreamInto(vertices, view, 3);
+    decodeVertexStreamInto(vertices, view, 8);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertexStream(): second view dimension is not contiguous\n"
+        "MeshTools::encodeVertexStream(): expected component size 1, 2, 4 or 8 but got 3\n"
+        "MeshTools::encodeVertexStream(): vertex size 12 not divisible by component size 8\n"
+        "MeshTools::decodeVertexStreamInto(): second view dimension is not contiguous\n"
+        "MeshTools::decodeVertexStreamInto(): expected component size 1, 2, 4 or 8 but got 3\n"
+        "MeshTools::decodeVertexStreamInto(): vertex size 12 not divisible by component size 8\n");
+}
+
+void EncodeMeshTest::mesh() {
+    auto&& data = MeshData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData mesh = data.mesh();
+    Containers::Array<char> encoded = encodeMesh(mesh);
+
+    /* The vertex data have the same size as the original, so only the
+       triangle index encoding makes the output smaller. The header is 40
+       bytes and 16 bytes for each attribute. */
+    const std::size_t indexDataSize = mesh.isIndexed() ? mesh.indexCount()*meshIndexTypeSize(mesh.indexType()) : 0;
+    std::size_t vertexDataSize = 0;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        vertexDataSize += mesh.vertexCount()*mesh.attribute(i).size()[1];
+    const std::size_t originalSize = 40 + 16*mesh.attributeCount() + indexDataSize + vertexDataSize;
+    if(data.compressesIndices)
+        CORRADE_COMPARE_AS(encoded.size(), originalSize,
+            TestSuite::Compare::Less);
+    else
+        CORRADE_COMPARE(encoded.size(), originalSize);
+
+    Containers::Optional<Trade::MeshData> decoded = decodeMesh(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE(decoded->primitive(), mesh.primitive());
+    CORRADE_COMPARE(decoded->isIndexed(), mesh.isIndexed());
+    if(mesh.isIndexed()) {
+        CORRADE_COMPARE(decoded->indexType(), mesh.indexType());
+        CORRADE_COMPARE(decoded->indexStride(), meshIndexTypeSize(mesh.indexType()));
+        CORRADE_COMPARE_AS(decoded->indicesAsArray(),
+            mesh.indicesAsArray(),
+            TestSuite::Compare::Container);
+    }
+
+    /* The attributes are tightly interleaved in the original order */
+    CORRADE_COMPARE(decoded->vertexCount(), mesh.vertexCount());
+    CORRADE_COMPARE(decoded->attributeCount(), mesh.attributeCount());
+    CORRADE_COMPARE(decoded->vertexData().size(), vertexDataSize);
+    std::size_t offset = 0;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(decoded->attributeName(i), mesh.attributeName(i));
+        CORRADE_COMPARE(decoded->attributeFormat(i), mesh.attributeFormat(i));
+        CORRADE_COMPARE(decoded->attributeArraySize(i), mesh.attributeArraySize(i));
+        CORRADE_COMPARE(decoded->attributeOffset(i), offset);
+        CORRADE_COMPARE(decoded->attributeStride(i), vertexDataSize/(mesh.vertexCount() ? mesh.vertexCount() : 1));
+        CORRADE_COMPARE_AS(contiguous(decoded->attribute(i)),
+            contiguous(mesh.attribute(i)),
+            TestSuite::Compare::Container);
+        offset += mesh.attribute(i).size()[1];
+    }
+}
+
+void EncodeMeshTest::meshImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeMesh(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeMesh(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void EncodeMeshTest::meshImplementationSpecificVertexFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, VertexFormat::Vector3, nullptr},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(3), vertexFormatWrap(0xcaca), nullptr}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    encodeMesh(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeMesh(): attribute 1 has an implementation-specific format 0xcaca\n");
+}
+
+void EncodeMeshTest::meshInvalid() {
+    auto&& data = MeshInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const UnsignedShort indices[]{0, 1, 2};
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Containers::Array<char> encoded = encodeMesh(mesh);
+    CORRADE_COMPARE(encoded.size(), 93);
+    CORRADE_VERIFY(decodeMesh(encoded));
+
+    /* Assuming a little-endian platform for the multi-byte values */
+    if(data.valueSize > 1 && Utility::Endianness::isBigEndian())
+        CORRADE_SKIP("Modifying the data assumes a little-endian platform.");
+    for(std::size_t i = 0; i != data.valueSize; ++i)
+        encoded[data.offset + i] = char(data.value >> i*8);
+
+    std::stringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeMesh(encoded.prefix(data.size)));
+    CORRADE_COMPARE(out.str(), Utility::formatString("MeshTools::decodeMesh(): {}\n", data.message));
+}
+
+void EncodeMeshTest::meshInvalidIndexOutOfRange() {
+    /* Neither the encoder nor MeshData check the index range, so it's
+       possible to create such data without patching the bytes */
+    const UnsignedShort indices[]{0, 1, 3};
+    const Vector3 positions[]{
+        {-1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Containers::Array<char> encoded = encodeMesh(mesh);
+
+    std::stringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeMesh(encoded));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeMesh(): index 3 out of range for 3 vertices\n");
+}
+
+void EncodeMeshTest::meshDifferentEndianness() {
+    Containers::Array<char> encoded = encodeMesh(Primitives::cubeSolid());
+
+    /* The endianness flag is the sixth byte */
+    encoded[5] = !Utility::Endianness::isBigEndian();
+
+    std::stringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeMesh(encoded));
+    if(Utility::Endianness::isBigEndian())
+        CORRADE_COMPARE(out.str(), "MeshTools::decodeMesh(): data encoded on a little-endian platform\n");
+    else
+        CORRADE_COMPARE(out.str(), "MeshTools::decodeMesh(): data encoded on a big-endian platform\n");
+}
+
+void EncodeMeshTest::benchmarkDecodeTriangleIndices() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    Containers::Array<char> encoded = encodeTriangleIndices(indices);
+
+    Containers::Array<UnsignedInt> decoded{NoInit, indices.size()};
+    CORRADE_BENCHMARK(1) {
+        decodeTriangleIndicesInto(encoded, decoded);
+    }
+
+    CORRADE_COMPARE(decoded[1000], indices[1000]);
+}
+
+void EncodeMeshTest::benchmarkDecodeVertexStream() {
+    /* 125k vertices, 32 bytes each */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500, Primitives::UVSphereFlag::TextureCoordinates);
+    const Containers::StridedArrayView2D<const char> vertices{sphere.vertexData(),
+        {sphere.vertexCount(), sphere.attributeStride(0)}};
+    Containers::Array<char> encoded = encodeVertexStream(vertices, 4);
+
+    Containers::Array<char> decoded{NoInit, sphere.vertexData().size()};
+    CORRADE_BENCHMARK(1) {
+        decodeVertexStreamInto(encoded, Containers::StridedArrayView2D<char>{decoded, vertices.size()}, 4);
+    }
+
+    CORRADE_COMPARE(decoded[1000], sphere.vertexData()[1000]);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::EncodeMeshTest)
@@ -0,0 +1,476 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <set>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/GenerateMeshlets.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateMeshletsTest: TestSuite::Tester {
+    explicit GenerateMeshletsTest();
+
+    template<class T> void generate();
+    void maxTriangleCount();
+    void maxVertexCount();
+    void twoSided();
+    void sphere();
+    void empty();
+    void erased();
+    void erasedNonContiguous();
+    void erasedWrongIndexSize();
+    void invalidIndexCount();
+    void indexOutOfBounds();
+    void invalidMaxCount();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataNotTriangles();
+    void meshDataImplementationSpecificIndexType();
+    void meshDataNoPositions();
+};
+
+GenerateMeshletsTest::GenerateMeshletsTest() {
+    addTests({&GenerateMeshletsTest::generate<UnsignedByte>,
+              &GenerateMeshletsTest::generate<UnsignedShort>,
+              &GenerateMeshletsTest::generate<UnsignedInt>,
+              &GenerateMeshletsTest::maxTriangleCount,
+              &GenerateMeshletsTest::maxVertexCount,
+              &GenerateMeshletsTest::twoSided,
+              &GenerateMeshletsTest::sphere,
+              &GenerateMeshletsTest::empty,
+              &GenerateMeshletsTest::erased,
+              &GenerateMeshletsTest::erasedNonContiguous,
+              &GenerateMeshletsTest::erasedWrongIndexSize,
+              &GenerateMeshletsTest::invalidIndexCount,
+              &GenerateMeshletsTest::indexOutOfBounds,
+              &GenerateMeshletsTest::invalidMaxCount,
+
+              &GenerateMeshletsTest::meshData,
+              &GenerateMeshletsTest::meshDataNotIndexed,
+              &GenerateMeshletsTest::meshDataNotTriangles,
+              &GenerateMeshletsTest::meshDataImplementationSpecificIndexType,
+              &GenerateMeshletsTest::meshDataNoPositions});
+}
+
+/* A unit quad in the XY plane, facing +Z */
+const Vector3 QuadPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+
+/* A flat 5x5 vertex grid with 32 triangles, facing +Z:
+
+    20--21--22--23--24
+     | / | / | / | / |
+    15--16--17--18--19
+     | / | / | / | / |
+    10--11--12--13--14
+     | / | / | / | / |
+     5---6---7---8---9
+     | / | / | / | / |
+     0---1---2---3---4 */
+Containers::Array<Vector3> gridPositions() {
+    Containers::Array<Vector3> out{NoInit, 25};
+    for(std::size_t y = 0; y != 5; ++y)
+        for(std::size_t x = 0; x != 5; ++x)
+            out[y*5 + x] = {Float(x), Float(y), 0.0f};
+    return out;
+}
+Containers::Array<UnsignedInt> gridIndices() {
+    Containers::Array<UnsignedInt> out{NoInit, 4*4*6};
+    std::size_t i = 0;
+    for(UnsignedInt y = 0; y != 4; ++y) for(UnsignedInt x = 0; x != 4; ++x) {
+        const UnsignedInt a = y*5 + x;
+        for(UnsignedInt index: {a, a + 1, a + 6, a, a + 6, a + 5})
+            out[i++] = index;
+    }
+    return out;
+}
+
+template<class T> void GenerateMeshletsTest::generate() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 0, 2, 3};
+
+    Trade::MeshData out = generateMeshlets(Containers::stridedArrayView(indices), QuadPositions);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Meshlets);
+    CORRADE_VERIFY(!out.isIndexed());
+    CORRADE_COMPARE(out.vertexCount(), 1);
+    CORRADE_COMPARE(out.attributeCount(), 7);
+
+    /* The stride is rounded up to keep the Vector4 attributes aligned in all
+       meshlets */
+    CORRADE_COMPARE(out.attributeStride(MeshAttributeMeshletBoundingSphere), 688);
+    CORRADE_COMPARE(out.attributeOffset(MeshAttributeMeshletBoundingSphere) % 16, 0);
+    CORRADE_COMPARE(out.attributeOffset(MeshAttributeMeshletNormalCone) % 16, 0);
+
+    CORRADE_COMPARE(out.attributeFormat(MeshAttributeMeshletVertices), VertexFormat::UnsignedInt);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletVertices), 64);
+    CORRADE_COMPARE(out.attributeFormat(MeshAttributeMeshletTriangles), VertexFormat::Vector3ub);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletTriangles), 124);
+
+    CORRADE_COMPARE_AS(out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount), Containers::arrayView<UnsignedByte>({
+        4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedShort>(MeshAttributeMeshletTriangleCount), Containers::arrayView<UnsignedShort>({
+        2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[0].prefix(5), Containers::arrayView<UnsignedInt>({
+        /* The rest is zero-filled */
+        0, 1, 2, 3, 0
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3ub[]>(MeshAttributeMeshletTriangles)[0].prefix(3), Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3}, {0, 0, 0}
+    }), TestSuite::Compare::Container);
+
+    /* Sphere centered in the middle of the quad, the cone covers just the +Z
+       direction and starts in the plane */
+    CORRADE_COMPARE(out.attribute<Vector4>(MeshAttributeMeshletBoundingSphere)[0], (Vector4{0.5f, 0.5f, 0.0f, 0.707107f}));
+    CORRADE_COMPARE(out.attribute<Vector4>(MeshAttributeMeshletNormalCone)[0], (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(out.attribute<Vector3>(MeshAttributeMeshletNormalConeApex)[0], (Vector3{0.5f, 0.5f, 0.0f}));
+}
+
+void GenerateMeshletsTest::maxTriangleCount() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> indices = gridIndices();
+
+    Trade::MeshData out = generateMeshlets(Containers::stridedArrayView(indices), positions, 64, 4);
+    CORRADE_COMPARE(out.vertexCount(), 8);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletTriangles), 4);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedShort>(MeshAttributeMeshletTriangleCount), Containers::arrayView<UnsignedShort>({
+        4, 4, 4, 4, 4, 4, 4, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount), Containers::arrayView<UnsignedByte>({
+        6, 6, 6, 6, 6, 6, 6, 6
+    }), TestSuite::Compare::Container);
+
+    /* The first meshlet is the first quad and then the triangles adjacent to
+       it, adding the least vertices */
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[0].prefix(6), Containers::arrayView<UnsignedInt>({
+        0, 1, 6, 5, 7, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3ub[]>(MeshAttributeMeshletTriangles)[0], Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3}, {1, 4, 2}, {1, 5, 4}
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::maxVertexCount() {
+    const Containers::Array<Vector3> positions = gridPositions();
+    const Containers::Array<UnsignedInt> indices = gridIndices();
+
+    Trade::MeshData out = generateMeshlets(Containers::stridedArrayView(indices), positions, 6);
+    CORRADE_COMPARE(out.vertexCount(), 8);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletVertices), 6);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount), Containers::arrayView<UnsignedByte>({
+        6, 6, 6, 6, 6, 6, 6, 6
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedShort>(MeshAttributeMeshletTriangleCount), Containers::arrayView<UnsignedShort>({
+        4, 4, 4, 4, 4, 4, 4, 4
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::twoSided() {
+    const UnsignedInt indices[]{0, 1, 2, 0, 2, 1};
+
+    /* The triangles face opposite directions, so there's no cone that could
+       be used for culling */
+    Trade::MeshData out = generateMeshlets(Containers::stridedArrayView(indices), QuadPositions);
+    CORRADE_COMPARE(out.vertexCount(), 1);
+    CORRADE_COMPARE(out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount)[0], 3);
+    CORRADE_COMPARE(out.attribute<UnsignedShort>(MeshAttributeMeshletTriangleCount)[0], 2);
+    CORRADE_COMPARE(out.attribute<Vector4>(MeshAttributeMeshletNormalCone)[0], (Vector4{0.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(out.attribute<Vector3>(MeshAttributeMeshletNormalConeApex)[0], out.attribute<Vector4>(MeshAttributeMeshletBoundingSphere)[0].xyz());
+}
+
+void GenerateMeshletsTest::sphere() {
+    const Trade::MeshData sphere = Primitives::icosphereSolid(4);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    Trade::MeshData out = generateMeshlets(indices, positions);
+
+    /* 5120 triangles in at most 124 per meshlet is 42 meshlets. Not all
+       meshlets are filled to the brim, but the count shouldn't be much
+       higher. */
+    CORRADE_COMPARE_AS(out.vertexCount(), 42, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(out.vertexCount(), 60, TestSuite::Compare::Less);
+
+    const Containers::StridedArrayView1D<const UnsignedByte> vertexCounts = out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount);
+    const Containers::StridedArrayView1D<const UnsignedShort> triangleCounts = out.attribute<UnsignedShort>(MeshAttributeMeshletTriangleCount);
+    const Containers::StridedArrayView2D<const UnsignedInt> vertices = out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices);
+    const Containers::StridedArrayView2D<const Vector3ub> triangles = out.attribute<Vector3ub[]>(MeshAttributeMeshletTriangles);
+    const Containers::StridedArrayView1D<const Vector4> spheres = out.attribute<Vector4>(MeshAttributeMeshletBoundingSphere);
+    const Containers::StridedArrayView1D<const Vector4> cones = out.attribute<Vector4>(MeshAttributeMeshletNormalCone);
+    const Containers::StridedArrayView1D<const Vector3> apexes = out.attribute<Vector3>(MeshAttributeMeshletNormalConeApex);
+
+    /* Sets of all original triangles and of triangles in the meshlets */
+    std::multiset<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> expectedTriangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        expectedTriangles.emplace(indices[i + 0], indices[i + 1], indices[i + 2]);
+    std::multiset<std::tuple<UnsignedInt, UnsignedInt, UnsignedInt>> actualTriangles;
+
+    const Vector3 cameras[]{
+        {0.0f, 0.0f, 3.0f},
+        {0.0f, -2.0f, 0.0f},
+        {1.5f, 1.5f, -1.5f}
+    };
+    std::size_t culledCount = 0;
+    for(std::size_t i = 0; i != out.vertexCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(vertexCounts[i], 64, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(triangleCounts[i], 124, TestSuite::Compare::LessOrEqual);
+
+        /* All vertices are inside the bounding sphere */
+        for(std::size_t j = 0; j != vertexCounts[i]; ++j)
+            CORRADE_COMPARE_AS((positions[vertices[i][j]] - spheres[i].xyz()).length(), spheres[i].w()*1.0001f, TestSuite::Compare::LessOrEqual);
+
+        for(std::size_t j = 0; j != triangleCounts[i]; ++j) {
+            const Vector3ub triangle = triangles[i][j];
+            CORRADE_COMPARE_AS(triangle.max(), vertexCounts[i], TestSuite::Compare::Less);
+            actualTriangles.emplace(vertices[i][triangle[0]], vertices[i][triangle[1]], vertices[i][triangle[2]]);
+        }
+
+        /* If the cone says the meshlet is back-facing, all its triangles have
+           to be back-facing */
+        for(const Vector3& camera: cameras) {
+            if(Math::dot((apexes[i] - camera).normalized(), cones[i].xyz()) < cones[i].w())
+                continue;
+
+            ++culledCount;
+            for(std::size_t j = 0; j != triangleCounts[i]; ++j) {
+                const Vector3 a = positions[vertices[i][triangles[i][j][0]]];
+                const Vector3 b = positions[vertices[i][triangles[i][j][1]]];
+                const Vector3 c = positions[vertices[i][triangles[i][j][2]]];
+                CORRADE_COMPARE_AS(Math::dot(Math::cross(b - a, c - a), a - camera), 0.0f, TestSuite::Compare::GreaterOrEqual);
+            }
+        }
+    }
+
+    /* Each triangle is in exactly one meshlet */
+    CORRADE_VERIFY(actualTriangles == expectedTriangles);
+
+    /* The cones should be able to cull a significant part of the meshlets
+       for each camera */
+    CORRADE_COMPARE_AS(culledCount, out.vertexCount(), TestSuite::Compare::Greater);
+}
+
+void GenerateMeshletsTest::empty() {
+    Trade::MeshData out = generateMeshlets(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Meshlets);
+    CORRADE_COMPARE(out.vertexCount(), 0);
+    CORRADE_COMPARE(out.attributeCount(), 7);
+}
+
+void GenerateMeshletsTest::erased() {
+    const UnsignedShort indices[]{0, 1, 2, 0, 2, 3};
+
+    Trade::MeshData out = generateMeshlets(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), QuadPositions, 3, 5);
+    CORRADE_COMPARE(out.vertexCount(), 2);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[0], Containers::arrayView<UnsignedInt>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[1], Containers::arrayView<UnsignedInt>({
+        0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::erasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, QuadPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): second index view dimension is not contiguous\n");
+}
+
+void GenerateMeshletsTest::erasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), QuadPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void GenerateMeshletsTest::invalidIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[5]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): index count not divisible by 3\n");
+}
+
+void GenerateMeshletsTest::indexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2, 0, 4, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): index 4 out of bounds for 4 elements\n");
+}
+
+void GenerateMeshletsTest::invalidMaxCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions, 2, 124);
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions, 256, 124);
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions, 64, 0);
+    generateMeshlets(Containers::stridedArrayView(indices), QuadPositions, 64, 513);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): expected max vertex count to be between 3 and 255 but got 2\n"
+        "MeshTools::generateMeshlets(): expected max vertex count to be between 3 and 255 but got 256\n"
+        "MeshTools::generateMeshlets(): expected max triangle count to be between 1 and 512 but got 0\n"
+        "MeshTools::generateMeshlets(): expected max triangle count to be between 1 and 512 but got 513\n");
+}
+
+void GenerateMeshletsTest::meshData() {
+    const UnsignedShort indices[]{0, 1, 2, 0, 2, 3};
+    const Vector2 positions[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    /* 2D positions get expanded to 3D, giving the same result as above */
+    Trade::MeshData out = generateMeshlets(mesh, 16, 8);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Meshlets);
+    CORRADE_COMPARE(out.vertexCount(), 1);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletVertices), 16);
+    CORRADE_COMPARE(out.attributeArraySize(MeshAttributeMeshletTriangles), 8);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[0].prefix(4), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3ub[]>(MeshAttributeMeshletTriangles)[0].prefix(2), Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {0, 2, 3}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.attribute<Vector4>(MeshAttributeMeshletNormalCone)[0], (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+}
+
+void GenerateMeshletsTest::meshDataNotIndexed() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData out = generateMeshlets(mesh);
+    CORRADE_COMPARE(out.vertexCount(), 1);
+    CORRADE_COMPARE(out.attribute<UnsignedByte>(MeshAttributeMeshletVertexCount)[0], 6);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt[]>(MeshAttributeMeshletVertices)[0].prefix(6), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3, 4, 5
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector3ub[]>(MeshAttributeMeshletTriangles)[0].prefix(2), Containers::arrayView<Vector3ub>({
+        {0, 1, 2}, {3, 4, 5}
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMeshletsTest::meshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::TriangleFan, 0};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): expected MeshPrimitive::Triangles but got MeshPrimitive::TriangleFan\n");
+}
+
+void GenerateMeshletsTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void GenerateMeshletsTest::meshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateMeshlets(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateMeshlets(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateMeshletsTest)
@@ -29,6 +29,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
@@ -36,6 +37,7 @@
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/Primitives/Cylinder.h"
+#include "Magnum/Primitives/Icosphere.h"
 #include "Magnum/Trade/MeshData.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -60,8 +62,12 @@ struct GenerateNormalsTest: TestSuite::Tester {
     void smoothCylinder();
     void smoothZeroAreaTriangle();
     void smoothNanPosition();
+    void smoothManyTrianglesByteIndices();
+    void smoothMultithreaded();
+    void smoothMultithreadedErased();
     void smoothWrongCount();
     void smoothOutOfBounds();
+    void smoothMultithreadedOutOfBounds();
     void smoothIntoWrongSize();
 
     template<class T> void smoothErased();
@@ -70,6 +76,18 @@ struct GenerateNormalsTest: TestSuite::Tester {
 
     void benchmarkFlat();
     void benchmarkSmooth();
+    void benchmarkSmoothLarge();
+    void benchmarkSmoothLargeMultithreaded();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} SmoothMultithreadedData[] {
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"all hardware threads", 0}
 };
 
 GenerateNormalsTest::GenerateNormalsTest() {
@@ -88,8 +106,15 @@ GenerateNormalsTest::GenerateNormalsTest() {
               &GenerateNormalsTest::smoothCylinder,
               &GenerateNormalsTest::smoothZeroAreaTriangle,
               &GenerateNormalsTest::smoothNanPosition,
+              &GenerateNormalsTest::smoothManyTrianglesByteIndices});
+
+    addInstancedTests({&GenerateNormalsTest::smoothMultithreaded},
+        Containers::arraySize(SmoothMultithreadedData));
+
+    addTests({&GenerateNormalsTest::smoothMultithreadedErased,
               &GenerateNormalsTest::smoothWrongCount,
               &GenerateNormalsTest::smoothOutOfBounds,
+              &GenerateNormalsTest::smoothMultithreadedOutOfBounds,
               &GenerateNormalsTest::smoothIntoWrongSize,
 
               &GenerateNormalsTest::smoothErased<UnsignedByte>,
@@ -100,6 +125,9 @@ GenerateNormalsTest::GenerateNormalsTest() {
 
     addBenchmarks({&GenerateNormalsTest::benchmarkFlat,
                    &GenerateNormalsTest::benchmarkSmooth}, 150);
+
+    addBenchmarks({&GenerateNormalsTest::benchmarkSmoothLarge,
+                   &GenerateNormalsTest::benchmarkSmoothLargeMultithreaded}, 10);
 }
 
 /* Two vertices connected by one edge, each wound in another direction */
@@ -390,6 +418,68 @@ void GenerateNormalsTest::smoothNanPosition() {
     CORRADE_VERIFY(Math::isNan(generated[3]).all());
 }
 
+void GenerateNormalsTest::smoothManyTrianglesByteIndices() {
+    /* More triangles than what fits into an 8-bit type, the IDs of triangles
+       adjacent to the last three vertices shouldn't get truncated */
+    UnsignedByte indices[300*3 + 3];
+    for(std::size_t i = 0; i != 300*3; ++i)
+        indices[i] = i % 3;
+    indices[300*3 + 0] = 3;
+    indices[300*3 + 1] = 4;
+    indices[300*3 + 2] = 5;
+
+    CORRADE_COMPARE_AS(generateSmoothNormals(indices, TwoTriangles),
+        Containers::arrayView<Vector3>({
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis()
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothMultithreaded() {
+    auto&& data = SmoothMultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 245760 indices, large enough to be split among at least 8 threads. The
+       result should be exactly the same as with the serial variant. */
+    const Trade::MeshData sphere = Primitives::icosphereSolid(6);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    Containers::Array<Vector3> expected{NoInit, positions.size()};
+    generateSmoothNormalsInto(indices, positions, expected);
+
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    generateSmoothNormalsInto(indices, positions, normals, data.threadCount);
+    /* Comparing the bytes, as the default fuzzy comparison would hide any
+       difference in the order of operations */
+    CORRADE_COMPARE_AS(Containers::arrayCast<const char>(normals),
+        Containers::arrayCast<const char>(expected),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothMultithreadedErased() {
+    const Trade::MeshData sphere = Primitives::icosphereSolid(5);
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    /* 61440 16-bit indices, which is enough for three threads */
+    Containers::Array<UnsignedShort> indices{NoInit, sphere.indexCount()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = sphere.indices<UnsignedInt>()[i];
+
+    Containers::Array<Vector3> expected{NoInit, positions.size()};
+    generateSmoothNormalsInto(indices, positions, expected);
+
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    generateSmoothNormalsInto(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), positions, normals, 3);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const char>(normals),
+        Containers::arrayCast<const char>(expected),
+        TestSuite::Compare::Container);
+}
+
 void GenerateNormalsTest::smoothWrongCount() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -414,6 +504,24 @@ void GenerateNormalsTest::smoothOutOfBounds() {
     CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): index 2 out of bounds for 2 elements\n");
 }
 
+void GenerateNormalsTest::smoothMultithreadedOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    /* Enough indices for three threads, with the out-of-bounds indices in the
+       second and third range. The message should mention the first one, same
+       as in the serial variant. */
+    const Vector3 positions[3];
+    Containers::Array<UnsignedInt> indices{ValueInit, 16384*3};
+    indices[16384*2 + 5] = 4;
+    indices[16384 + 7] = 3;
+
+    std::stringstream out;
+    Error redirectError{&out};
+    Vector3 normals[3];
+    generateSmoothNormalsInto(indices, positions, normals, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): index 3 out of bounds for 3 elements\n");
+}
+
 void GenerateNormalsTest::smoothIntoWrongSize() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -449,6 +557,40 @@ void GenerateNormalsTest::benchmarkSmooth() {
     CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
 }
 
+void GenerateNormalsTest::benchmarkSmoothLarge() {
+    /* 327680 triangles */
+    const Trade::MeshData sphere = Primitives::icosphereSolid(7);
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    CORRADE_BENCHMARK(1) {
+        generateSmoothNormalsInto(indices, positions, normals);
+    }
+
+    /* Smooth normals of a sphere should be close to the positions */
+    CORRADE_COMPARE_AS(Math::dot(normals[0], positions[0]), 0.999f,
+        TestSuite::Compare::Greater);
+}
+
+void GenerateNormalsTest::benchmarkSmoothLargeMultithreaded() {
+    /* 327680 triangles */
+    const Trade::MeshData sphere = Primitives::icosphereSolid(7);
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+
+    Containers::Array<Vector3> normals{NoInit, positions.size()};
+    CORRADE_BENCHMARK(1) {
+        generateSmoothNormalsInto(indices, positions, normals, 0);
+    }
+
+    /* Smooth normals of a sphere should be close to the positions */
+    CORRADE_COMPARE_AS(Math::dot(normals[0], positions[0]), 0.999f,
+        TestSuite::Compare::Greater);
+}
+
 template<class T> void GenerateNormalsTest::smoothErased() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -0,0 +1,586 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    template<class T> void quad();
+    void mirroredTextureCoordinates();
+    void rotatedTextureCoordinates();
+    void mixedHandedness();
+    void degenerateTextureCoordinates();
+    void sphere();
+    void multithreaded();
+    void empty();
+    template<class T> void erased();
+    void erasedNonContiguous();
+    void erasedWrongIndexSize();
+    void wrongIndexCount();
+    void wrongAttributeCount();
+    void intoWrongSize();
+    void indexOutOfBounds();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataNotTriangles();
+    void meshDataImplementationSpecificIndexType();
+    void meshDataNoPositions();
+    void meshDataNoNormals();
+    void meshDataNoTextureCoordinates();
+
+    void benchmark();
+    void benchmarkMultithreaded();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} MultithreadedData[] {
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"all hardware threads", 0}
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::quad<UnsignedByte>,
+              &GenerateTangentsTest::quad<UnsignedShort>,
+              &GenerateTangentsTest::quad<UnsignedInt>,
+              &GenerateTangentsTest::mirroredTextureCoordinates,
+              &GenerateTangentsTest::rotatedTextureCoordinates,
+              &GenerateTangentsTest::mixedHandedness,
+              &GenerateTangentsTest::degenerateTextureCoordinates,
+              &GenerateTangentsTest::sphere});
+
+    addInstancedTests({&GenerateTangentsTest::multithreaded},
+        Containers::arraySize(MultithreadedData));
+
+    addTests({&GenerateTangentsTest::empty,
+              &GenerateTangentsTest::erased<UnsignedByte>,
+              &GenerateTangentsTest::erased<UnsignedShort>,
+              &GenerateTangentsTest::erased<UnsignedInt>,
+              &GenerateTangentsTest::erasedNonContiguous,
+              &GenerateTangentsTest::erasedWrongIndexSize,
+              &GenerateTangentsTest::wrongIndexCount,
+              &GenerateTangentsTest::wrongAttributeCount,
+              &GenerateTangentsTest::intoWrongSize,
+              &GenerateTangentsTest::indexOutOfBounds,
+
+              &GenerateTangentsTest::meshData,
+              &GenerateTangentsTest::meshDataNotIndexed,
+              &GenerateTangentsTest::meshDataNotTriangles,
+              &GenerateTangentsTest::meshDataImplementationSpecificIndexType,
+              &GenerateTangentsTest::meshDataNoPositions,
+              &GenerateTangentsTest::meshDataNoNormals,
+              &GenerateTangentsTest::meshDataNoTextureCoordinates});
+
+    addBenchmarks({&GenerateTangentsTest::benchmark,
+                   &GenerateTangentsTest::benchmarkMultithreaded}, 10);
+}
+
+/* A unit quad in the XY plane, facing +Z */
+const Vector3 QuadPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+
+const Vector3 QuadNormals[]{
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis()
+};
+
+const UnsignedInt QuadIndices[]{0, 1, 2, 0, 2, 3};
+
+template<class T> void GenerateTangentsTest::quad() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 0, 2, 3};
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    };
+
+    /* The tangent points in the direction of increasing U */
+    CORRADE_COMPARE_AS(generateTangents(indices, QuadPositions, QuadNormals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::mirroredTextureCoordinates() {
+    const Vector2 textureCoordinates[]{
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    };
+
+    /* U goes in the opposite direction, the bitangent should still point in
+       the direction of increasing V, i.e. +Y */
+    Containers::Array<Vector4> tangents = generateTangents(QuadIndices, QuadPositions, QuadNormals, textureCoordinates);
+    CORRADE_COMPARE_AS(tangents,
+        Containers::arrayView<Vector4>({
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(Math::cross(QuadNormals[0], tangents[0].xyz())*tangents[0].w(), Vector3::yAxis());
+}
+
+void GenerateTangentsTest::rotatedTextureCoordinates() {
+    /* U goes in the -Y direction */
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {-1.0f, 1.0f},
+        {-1.0f, 0.0f}
+    };
+
+    CORRADE_COMPARE_AS(generateTangents(QuadIndices, QuadPositions, QuadNormals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {0.0f, -1.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::mixedHandedness() {
+    /* Three triangles around vertex 0 with U going in the -X direction. The
+       first two have V going in the +Y direction, i.e. are mirrored, the last
+       one has V going in the -Y direction. */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f}
+    };
+    const Vector3 normals[]{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis()
+    };
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {-1.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f}
+    };
+    const UnsignedInt indices[]{
+        0, 1, 2,
+        0, 2, 3,
+        0, 3, 4
+    };
+
+    /* Vertex 0 has the mirrored triangles spanning a larger angle, vertex 3
+       has the same angle on both sides, in which case the right-handed one
+       wins */
+    CORRADE_COMPARE_AS(generateTangents(indices, positions, normals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, 1.0f},
+            {-1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::degenerateTextureCoordinates() {
+    /* The second triangle has a zero area in the texture space, so vertex 3
+       which is used only by it gets the default */
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {-1.0f, 1.0f},
+        {-1.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE_AS(generateTangents(QuadIndices, QuadPositions, QuadNormals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {0.0f, -1.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::sphere() {
+    Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32, Primitives::UVSphereFlag::TextureCoordinates|Primitives::UVSphereFlag::Tangents);
+
+    Containers::Array<Vector4> tangents = generateTangents(sphere.indices(),
+        sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+        sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates));
+
+    /* The generated tangents should be close to the analytical ones the
+       primitive has, except for the two poles where the texture space is
+       singular */
+    const Containers::StridedArrayView1D<const Vector4> expected = sphere.attribute<Vector4>(Trade::MeshAttribute::Tangent);
+    for(std::size_t i = 1; i != tangents.size() - 1; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(Math::dot(tangents[i].xyz(), expected[i].xyz()), 0.99f,
+            TestSuite::Compare::Greater);
+        CORRADE_COMPARE(tangents[i].w(), expected[i].w());
+    }
+}
+
+void GenerateTangentsTest::multithreaded() {
+    auto&& data = MultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Over 600k indices, which is more than one chunk and large enough to be
+       split among at least 8 threads. The result should be exactly the same
+       as with the serial variant. */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(320, 320, Primitives::UVSphereFlag::TextureCoordinates);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    const Containers::StridedArrayView1D<const Vector3> normals = sphere.attribute<Vector3>(Trade::MeshAttribute::Normal);
+    const Containers::StridedArrayView1D<const Vector2> textureCoordinates = sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates);
+
+    Containers::Array<Vector4> expected = generateTangents(indices, positions, normals, textureCoordinates);
+    CORRADE_COMPARE_AS(generateTangents(indices, positions, normals, textureCoordinates, data.threadCount),
+        expected,
+        TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::empty() {
+    CORRADE_COMPARE_AS(generateTangents(Containers::StridedArrayView1D<const UnsignedInt>{}, nullptr, nullptr, nullptr),
+        Containers::ArrayView<const Vector4>{},
+        TestSuite::Compare::Container);
+}
+
+template<class T> void GenerateTangentsTest::erased() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 0, 2, 3};
+    const Vector2 textureCoordinates[]{
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    };
+
+    Vector4 tangents[4];
+    generateTangentsInto(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), QuadPositions, QuadNormals, textureCoordinates, tangents);
+    CORRADE_COMPARE_AS(Containers::arrayView(tangents),
+        Containers::arrayView<Vector4>({
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::erasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+    const Vector3 positions[3];
+    const Vector2 textureCoordinates[3];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, positions, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): second index view dimension is not contiguous\n");
+}
+
+void GenerateTangentsTest::erasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+    const Vector3 positions[3];
+    const Vector2 textureCoordinates[3];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::StridedArrayView2D<const char>{indices, {6, 3}}, positions, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void GenerateTangentsTest::wrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[7]{};
+    const Vector3 positions[1];
+    const Vector2 textureCoordinates[1];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(indices, positions, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): index count not divisible by 3\n");
+}
+
+void GenerateTangentsTest::wrongAttributeCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[3]{};
+    const Vector3 positions[3];
+    const Vector3 normals[2];
+    const Vector2 textureCoordinates[3];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(indices, positions, normals, textureCoordinates);
+    generateTangents(indices, positions, positions, Containers::arrayView(textureCoordinates).exceptSuffix(1));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): expected 3 normals and texture coordinates but got 2 and 3\n"
+        "MeshTools::generateTangentsInto(): expected 3 normals and texture coordinates but got 3 and 2\n");
+}
+
+void GenerateTangentsTest::intoWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[3]{};
+    const Vector3 positions[3];
+    const Vector2 textureCoordinates[3];
+    Vector4 tangents[4];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangentsInto(indices, positions, positions, textureCoordinates, tangents);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): bad output size, expected 3 but got 4\n");
+}
+
+void GenerateTangentsTest::indexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 2, 1, 1, 3, 2};
+    const Vector3 positions[3];
+    const Vector2 textureCoordinates[3];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(indices, positions, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): index 3 out of bounds for 3 elements\n");
+}
+
+void GenerateTangentsTest::meshData() {
+    Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32, Primitives::UVSphereFlag::TextureCoordinates|Primitives::UVSphereFlag::Tangents);
+
+    /* The original tangents get replaced with the generated ones */
+    Trade::MeshData out = generateTangents(sphere);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.vertexCount(), sphere.vertexCount());
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(), sphere.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.attributeCount(), sphere.attributeCount());
+    CORRADE_COMPARE(out.attributeCount(Trade::MeshAttribute::Tangent), 1);
+    CORRADE_COMPARE(out.attributeFormat(Trade::MeshAttribute::Tangent), VertexFormat::Vector4);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position),
+        sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector4>(Trade::MeshAttribute::Tangent),
+        Containers::arrayView(generateTangents(sphere.indices(),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+            sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates))),
+        TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::meshDataNotIndexed() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector3 bitangent;
+        Vector2 textureCoordinates;
+    } vertices[]{
+        {{0.0f, 0.0f, 0.0f}, Vector3::zAxis(), {}, {0.0f, 0.0f}},
+        {{1.0f, 0.0f, 0.0f}, Vector3::zAxis(), {}, {1.0f, 0.0f}},
+        {{1.0f, 1.0f, 0.0f}, Vector3::zAxis(), {}, {1.0f, 1.0f}},
+        {{0.0f, 0.0f, 0.0f}, Vector3::zAxis(), {}, {0.0f, 0.0f}},
+        {{1.0f, 1.0f, 0.0f}, Vector3::zAxis(), {}, {1.0f, 1.0f}},
+        {{0.0f, 1.0f, 0.0f}, Vector3::zAxis(), {}, {0.0f, 1.0f}}
+    };
+    Containers::StridedArrayView1D<const Vertex> view = vertices;
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            view.slice(&Vertex::normal)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent,
+            view.slice(&Vertex::bitangent)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            view.slice(&Vertex::textureCoordinates)}
+    }};
+
+    /* The bitangent gets removed */
+    Trade::MeshData out = generateTangents(mesh);
+    CORRADE_VERIFY(!out.isIndexed());
+    CORRADE_COMPARE(out.vertexCount(), 6);
+    CORRADE_COMPARE(out.attributeCount(), 4);
+    CORRADE_VERIFY(!out.hasAttribute(Trade::MeshAttribute::Bitangent));
+    CORRADE_COMPARE_AS(out.attribute<Vector4>(Trade::MeshAttribute::Tangent),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::meshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::TriangleStrip, 0};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangents(): expected MeshPrimitive::Triangles but got MeshPrimitive::TriangleStrip\n");
+}
+
+void GenerateTangentsTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangents(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void GenerateTangentsTest::meshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangents(): the mesh has no positions\n");
+}
+
+void GenerateTangentsTest::meshDataNoNormals() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, QuadPositions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(QuadPositions)}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangents(): the mesh has no normals\n");
+}
+
+void GenerateTangentsTest::meshDataNoTextureCoordinates() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, QuadPositions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(QuadPositions)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            Containers::arrayView(QuadNormals)}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangents(): the mesh has no texture coordinates\n");
+}
+
+void GenerateTangentsTest::benchmark() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500, Primitives::UVSphereFlag::TextureCoordinates);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+
+    Containers::Array<Vector4> tangents{NoInit, sphere.vertexCount()};
+    CORRADE_BENCHMARK(1) {
+        generateTangentsInto(indices,
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+            sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            tangents);
+    }
+
+    CORRADE_COMPARE(tangents[1000].w(), 1.0f);
+}
+
+void GenerateTangentsTest::benchmarkMultithreaded() {
+    /* 250k triangles */
+    Trade::MeshData sphere = Primitives::uvSphereSolid(250, 500, Primitives::UVSphereFlag::TextureCoordinates);
+    const Containers::StridedArrayView1D<const UnsignedInt> indices = sphere.indices<UnsignedInt>();
+
+    Containers::Array<Vector4> tangents{NoInit, sphere.vertexCount()};
+    CORRADE_BENCHMARK(1) {
+        generateTangentsInto(indices,
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+            sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            tangents, 0);
+    }
+
+    CORRADE_COMPARE(tangents[1000].w(), 1.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
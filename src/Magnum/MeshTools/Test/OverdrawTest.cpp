@@ -0,0 +1,613 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm> /* std::sort() */
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/Overdraw.h"
+#include "Magnum/MeshTools/Transform.h"
+#include "Magnum/MeshTools/VertexCache.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OverdrawTest: TestSuite::Tester {
+    explicit OverdrawTest();
+
+    template<class T> void optimize();
+    void optimizeConcentricSpheres();
+    void optimizeEmpty();
+    void optimizeErased();
+    void optimizeErasedNonContiguous();
+    void optimizeErasedWrongIndexSize();
+    void optimizeWrongIndexCount();
+    void optimizeIndexOutOfBounds();
+    void optimizeInvalidThreshold();
+    void optimizeZeroCacheSize();
+
+    void optimizeMeshData();
+    void optimizeMeshDataRvalue();
+    void optimizeMeshDataNotTriangles();
+    void optimizeMeshDataNotIndexed();
+    void optimizeMeshDataImplementationSpecificIndexType();
+    void optimizeMeshDataNoPositions();
+
+    template<class T> void estimate();
+    void estimateBackFacing();
+    void estimateEmpty();
+    void estimateErased();
+    void estimateErasedNonContiguous();
+    void estimateErasedWrongIndexSize();
+    void estimateWrongIndexCount();
+    void estimateIndexOutOfBounds();
+    void estimateZeroResolution();
+
+    void estimateMeshData();
+    void estimateMeshDataNotIndexed();
+    void estimateMeshDataNotTriangles();
+    void estimateMeshDataNoPositions();
+};
+
+OverdrawTest::OverdrawTest() {
+    addTests({&OverdrawTest::optimize<UnsignedByte>,
+              &OverdrawTest::optimize<UnsignedShort>,
+              &OverdrawTest::optimize<UnsignedInt>,
+              &OverdrawTest::optimizeConcentricSpheres,
+              &OverdrawTest::optimizeEmpty,
+              &OverdrawTest::optimizeErased,
+              &OverdrawTest::optimizeErasedNonContiguous,
+              &OverdrawTest::optimizeErasedWrongIndexSize,
+              &OverdrawTest::optimizeWrongIndexCount,
+              &OverdrawTest::optimizeIndexOutOfBounds,
+              &OverdrawTest::optimizeInvalidThreshold,
+              &OverdrawTest::optimizeZeroCacheSize,
+
+              &OverdrawTest::optimizeMeshData,
+              &OverdrawTest::optimizeMeshDataRvalue,
+              &OverdrawTest::optimizeMeshDataNotTriangles,
+              &OverdrawTest::optimizeMeshDataNotIndexed,
+              &OverdrawTest::optimizeMeshDataImplementationSpecificIndexType,
+              &OverdrawTest::optimizeMeshDataNoPositions,
+
+              &OverdrawTest::estimate<UnsignedByte>,
+              &OverdrawTest::estimate<UnsignedShort>,
+              &OverdrawTest::estimate<UnsignedInt>,
+              &OverdrawTest::estimateBackFacing,
+              &OverdrawTest::estimateEmpty,
+              &OverdrawTest::estimateErased,
+              &OverdrawTest::estimateErasedNonContiguous,
+              &OverdrawTest::estimateErasedWrongIndexSize,
+              &OverdrawTest::estimateWrongIndexCount,
+              &OverdrawTest::estimateIndexOutOfBounds,
+              &OverdrawTest::estimateZeroResolution,
+
+              &OverdrawTest::estimateMeshData,
+              &OverdrawTest::estimateMeshDataNotIndexed,
+              &OverdrawTest::estimateMeshDataNotTriangles,
+              &OverdrawTest::estimateMeshDataNoPositions});
+}
+
+/* Two unit quads facing +Z, the second one in front of the first. Each quad
+   is a separate cluster and the one in front should be drawn first. */
+const Vector3 TwoQuadsPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+
+    {0.0f, 0.0f, 1.0f},
+    {1.0f, 0.0f, 1.0f},
+    {1.0f, 1.0f, 1.0f},
+    {0.0f, 1.0f, 1.0f}
+};
+
+constexpr UnsignedInt TwoQuadsIndices[]{
+    0, 1, 2, 0, 2, 3,
+    4, 5, 6, 4, 6, 7
+};
+
+constexpr UnsignedInt TwoQuadsIndicesOptimized[]{
+    4, 5, 6, 4, 6, 7,
+    0, 1, 2, 0, 2, 3
+};
+
+/* Triangles rotated so the smallest index is first, preserving the winding,
+   and sorted, to check that the output is a permutation of the input */
+Containers::Array<Vector3ui> sortedTriangles(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    Containers::Array<Vector3ui> out{NoInit, indices.size()/3};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        Vector3ui triangle{indices[i*3 + 0], indices[i*3 + 1], indices[i*3 + 2]};
+        while(triangle.x() != triangle.min())
+            triangle = {triangle.y(), triangle.z(), triangle.x()};
+        out[i] = triangle;
+    }
+    std::sort(out.begin(), out.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+    });
+    return out;
+}
+
+template<class T> void OverdrawTest::optimize() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(TwoQuadsIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(TwoQuadsIndices); ++i)
+        indices[i] = TwoQuadsIndices[i];
+
+    /* Looking from +Z, the back quad gets drawn first and then completely
+       overdrawn by the front quad. The quads are culled from -Z and
+       degenerate from the other directions. */
+    CORRADE_COMPARE(estimateOverdraw(Containers::arrayView(indices), TwoQuadsPositions), 2.0f);
+
+    optimizeOverdrawInPlace(indices, TwoQuadsPositions);
+
+    Containers::Array<UnsignedInt> actual{NoInit, Containers::arraySize(indices)};
+    for(std::size_t i = 0; i != actual.size(); ++i)
+        actual[i] = indices[i];
+    CORRADE_COMPARE_AS(actual,
+        Containers::arrayView(TwoQuadsIndicesOptimized),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(estimateOverdraw(Containers::arrayView(indices), TwoQuadsPositions), 1.0f);
+}
+
+void OverdrawTest::optimizeConcentricSpheres() {
+    /* A smaller sphere fully inside a larger one, the smaller one drawn
+       first */
+    Trade::MeshData inner = Primitives::icosphereSolid(2);
+    transform3DInPlace(inner, Matrix4::scaling(Vector3{0.5f}));
+    Trade::MeshData mesh = concatenate({inner, Primitives::icosphereSolid(2)});
+    CORRADE_COMPARE(mesh.indexType(), MeshIndexType::UnsignedInt);
+
+    /* Optimize for vertex cache first, as the overdraw optimization expects */
+    optimizeVertexCacheInPlace(mesh.mutableIndices<UnsignedInt>(), mesh.vertexCount());
+    Containers::Array<Vector3ui> expectedTriangles = sortedTriangles(mesh.indices<UnsignedInt>());
+
+    /* The inner sphere covers a quarter of the outer sphere projection
+       area. Depending on which sphere the vertex cache optimization starts
+       with, it's either overdrawn or not. */
+    const Float overdrawBefore = estimateOverdraw(mesh);
+    CORRADE_COMPARE_AS(overdrawBefore, 1.0f,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(overdrawBefore, 1.3f,
+        TestSuite::Compare::Less);
+    const Float acmrBefore = vertexCacheStatistics(mesh.indices<UnsignedInt>(), mesh.vertexCount(), 32).first();
+
+    optimizeOverdrawInPlace(mesh.mutableIndices<UnsignedInt>(), mesh.attribute<Vector3>(Trade::MeshAttribute::Position));
+
+    /* The output has the same triangles with the same winding */
+    CORRADE_COMPARE_AS(sortedTriangles(mesh.indices<UnsignedInt>()),
+        expectedTriangles,
+        TestSuite::Compare::Container);
+
+    /* The outer sphere should be drawn first, which results in no overdraw
+       except for a few pixel centers that are exactly on triangle edges */
+    CORRADE_COMPARE_AS(estimateOverdraw(mesh), 1.001f,
+        TestSuite::Compare::Less);
+
+    /* The vertex cache efficiency shouldn't get significantly worse */
+    CORRADE_COMPARE_AS(vertexCacheStatistics(mesh.indices<UnsignedInt>(), mesh.vertexCount(), 32).first(), acmrBefore*1.1f,
+        TestSuite::Compare::Less);
+}
+
+void OverdrawTest::optimizeEmpty() {
+    optimizeOverdrawInPlace(Containers::ArrayView<UnsignedInt>{}, Containers::ArrayView<const Vector3>{});
+
+    /* Shouldn't crash or assert */
+    CORRADE_VERIFY(true);
+}
+
+void OverdrawTest::optimizeErased() {
+    UnsignedShort indices[Containers::arraySize(TwoQuadsIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(TwoQuadsIndices); ++i)
+        indices[i] = TwoQuadsIndices[i];
+
+    optimizeOverdrawInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), TwoQuadsPositions);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedShort>({
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void OverdrawTest::optimizeErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(Containers::StridedArrayView2D<char>{indices, {6, 2}, {4, 2}}, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): second index view dimension is not contiguous\n");
+}
+
+void OverdrawTest::optimizeErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(Containers::StridedArrayView2D<char>{indices, {6, 3}}.every(2), TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void OverdrawTest::optimizeWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedByte indices[7]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3\n");
+}
+
+void OverdrawTest::optimizeIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedShort indices[]{0, 1, 2, 3, 8, 1};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): index 8 out of bounds for 8 elements\n");
+}
+
+void OverdrawTest::optimizeInvalidThreshold() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, TwoQuadsPositions, 0.95f);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): expected threshold to be at least 1 but got 0.95\n");
+}
+
+void OverdrawTest::optimizeZeroCacheSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdrawInPlace(indices, TwoQuadsPositions, 1.05f, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdrawInPlace(): expected a non-zero cache size\n");
+}
+
+struct Vertex {
+    Vector3 position;
+    UnsignedInt id;
+};
+
+const Vertex TwoQuadsVertices[]{
+    {TwoQuadsPositions[0], 0},
+    {TwoQuadsPositions[1], 1},
+    {TwoQuadsPositions[2], 2},
+    {TwoQuadsPositions[3], 3},
+    {TwoQuadsPositions[4], 4},
+    {TwoQuadsPositions[5], 5},
+    {TwoQuadsPositions[6], 6},
+    {TwoQuadsPositions[7], 7}
+};
+
+void OverdrawTest::optimizeMeshData() {
+    const UnsignedShort indices[]{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6, 4, 6, 7
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, TwoQuadsVertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(TwoQuadsVertices).slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                Containers::stridedArrayView(TwoQuadsVertices).slice(&Vertex::id)}
+        }};
+
+    CORRADE_COMPARE(estimateOverdraw(mesh), 2.0f);
+
+    Trade::MeshData out = optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+
+    /* The vertex data should be copied unchanged */
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView(TwoQuadsPositions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedInt>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView<UnsignedInt>({0, 1, 2, 3, 4, 5, 6, 7}),
+        TestSuite::Compare::Container);
+
+    /* The original data should stay untouched */
+    CORRADE_COMPARE(indices[0], 0);
+    CORRADE_COMPARE(estimateOverdraw(out), 1.0f);
+}
+
+void OverdrawTest::optimizeMeshDataRvalue() {
+    Containers::Array<char> indexData{NoInit, sizeof(TwoQuadsIndices)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(TwoQuadsIndices)), indexData);
+    Containers::Array<char> vertexData{NoInit, sizeof(TwoQuadsPositions)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(TwoQuadsPositions)), vertexData);
+    const void* indexPointer = indexData.data();
+    const void* vertexPointer = vertexData.data();
+
+    Trade::MeshIndexData indices{Containers::arrayCast<UnsignedInt>(indexData)};
+    Trade::MeshAttributeData positions{Trade::MeshAttribute::Position,
+        Containers::arrayCast<Vector3>(vertexData)};
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        std::move(indexData), indices,
+        std::move(vertexData), {positions}};
+
+    /* Owned data should be reused */
+    Trade::MeshData out = optimizeOverdraw(std::move(mesh));
+    CORRADE_COMPARE(out.indexData().data(), indexPointer);
+    CORRADE_COMPARE(out.vertexData().data(), vertexPointer);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(),
+        Containers::arrayView(TwoQuadsIndicesOptimized),
+        TestSuite::Compare::Container);
+}
+
+void OverdrawTest::optimizeMeshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Lines, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdraw(): expected MeshPrimitive::Triangles but got MeshPrimitive::Lines\n");
+}
+
+void OverdrawTest::optimizeMeshDataNotIndexed() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdraw(): mesh data not indexed\n");
+}
+
+void OverdrawTest::optimizeMeshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdraw(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void OverdrawTest::optimizeMeshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[3]{};
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeOverdraw(): the mesh has no positions\n");
+}
+
+template<class T> void OverdrawTest::estimate() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* A quad in front of another, partially overlapping. Looking from +Z,
+       a quarter of the back quad is overdrawn by the front quad, the rest of
+       the directions don't see anything. */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+
+        {0.5f, 0.5f, 1.0f},
+        {1.5f, 0.5f, 1.0f},
+        {1.5f, 1.5f, 1.0f},
+        {0.5f, 1.5f, 1.0f}
+    };
+    const T indices[]{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6, 4, 6, 7
+    };
+
+    /* With a 3x3 grid, each quad covers 2x2 pixels and they overlap in one,
+       so 7 pixels covered, of which one is shaded twice */
+    CORRADE_COMPARE(estimateOverdraw(indices, positions, 3), 8.0f/7.0f);
+
+    /* Front quad first, there's no overdraw */
+    const T indicesReversed[]{
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    };
+    CORRADE_COMPARE(estimateOverdraw(indicesReversed, positions, 3), 1.0f);
+}
+
+void OverdrawTest::estimateBackFacing() {
+    /* Same as the quads in optimize(), but clockwise. Thus visible from -Z,
+       where the quad at Z = 0 is in front. */
+    const UnsignedInt indices[]{
+        0, 2, 1, 0, 3, 2,
+        4, 6, 5, 4, 7, 6
+    };
+    CORRADE_COMPARE(estimateOverdraw(indices, TwoQuadsPositions), 1.0f);
+
+    const UnsignedInt indicesReversed[]{
+        4, 6, 5, 4, 7, 6,
+        0, 2, 1, 0, 3, 2
+    };
+    CORRADE_COMPARE(estimateOverdraw(indicesReversed, TwoQuadsPositions), 2.0f);
+}
+
+void OverdrawTest::estimateEmpty() {
+    /* No triangles */
+    CORRADE_COMPARE(estimateOverdraw(Containers::ArrayView<const UnsignedInt>{}, TwoQuadsPositions), 0.0f);
+
+    /* Degenerate triangles don't cover anything */
+    const UnsignedInt indices[]{0, 1, 1, 2, 2, 2};
+    CORRADE_COMPARE(estimateOverdraw(indices, TwoQuadsPositions), 0.0f);
+}
+
+void OverdrawTest::estimateErased() {
+    CORRADE_COMPARE(estimateOverdraw(Containers::arrayCast<2, const char>(Containers::stridedArrayView(TwoQuadsIndices)), TwoQuadsPositions), 2.0f);
+}
+
+void OverdrawTest::estimateErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::estimateOverdraw(): second index view dimension is not contiguous\n");
+}
+
+void OverdrawTest::estimateErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::estimateOverdraw(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void OverdrawTest::estimateWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[7]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(indices, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::estimateOverdraw(): index count not divisible by 3\n");
+}
+
+void OverdrawTest::estimateIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedShort indices[]{0, 1, 2, 3, 8, 1};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(indices, TwoQuadsPositions);
+    CORRADE_COMPARE(out.str(), "MeshTools::estimateOverdraw(): index 8 out of bounds for 8 elements\n");
+}
+
+void OverdrawTest::estimateZeroResolution() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(TwoQuadsIndices, TwoQuadsPositions, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::estimateOverdraw(): expected a non-zero resolution\n");
+}
+
+void OverdrawTest::estimateMeshData() {
+    const UnsignedByte indices[]{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6, 4, 6, 7
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, TwoQuadsVertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                Containers::stridedArrayView(TwoQuadsVertices).slice(&Vertex::id)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(TwoQuadsVertices).slice(&Vertex::position)}
+        }};
+
+    CORRADE_COMPARE(estimateOverdraw(mesh), 2.0f);
+}
+
+void OverdrawTest::estimateMeshDataNotIndexed() {
+    const Vector3 positions[]{
+        TwoQuadsPositions[0], TwoQuadsPositions[1], TwoQuadsPositions[2],
+        TwoQuadsPositions[0], TwoQuadsPositions[2], TwoQuadsPositions[3],
+        TwoQuadsPositions[4], TwoQuadsPositions[5], TwoQuadsPositions[6],
+        TwoQuadsPositions[4], TwoQuadsPositions[6], TwoQuadsPositions[7]
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    CORRADE_COMPARE(estimateOverdraw(mesh), 2.0f);
+}
+
+void OverdrawTest::estimateMeshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::TriangleStrip, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::estimateOverdraw(): expected MeshPrimitive::Triangles but got MeshPrimitive::TriangleStrip\n");
+}
+
+void OverdrawTest::estimateMeshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    estimateOverdraw(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::estimateOverdraw(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OverdrawTest)
@@ -0,0 +1,515 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void positions();
+    void positionsSigned();
+    void positionsZeroSize();
+    void positionsEmpty();
+    void positionsWrongSize();
+
+    void normals();
+    void normals8Bit();
+    void normalsPrecision();
+    void normalsZero();
+    void normalsWrongSize();
+
+    void textureCoordinates();
+    void textureCoordinatesWrongSize();
+
+    void meshData();
+    void meshDataNoQuantizedAttributes();
+    void meshDataMultipleAttributes();
+    void meshData2DPositions();
+};
+
+const struct {
+    const char* name;
+    QuantizeFlags flags;
+    VertexFormat positionFormat, normalFormat;
+    UnsignedInt stride;
+} MeshDataData[] {
+    {"", {},
+        VertexFormat::Vector3usNormalized, VertexFormat::Vector2sNormalized, 14},
+    {"signed positions", QuantizeFlag::SignedPositions,
+        VertexFormat::Vector3sNormalized, VertexFormat::Vector2sNormalized, 14},
+    {"8-bit normals", QuantizeFlag::Normals8Bit,
+        VertexFormat::Vector3usNormalized, VertexFormat::Vector2bNormalized, 12}
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::positions,
+              &QuantizeTest::positionsSigned,
+              &QuantizeTest::positionsZeroSize,
+              &QuantizeTest::positionsEmpty,
+              &QuantizeTest::positionsWrongSize,
+
+              &QuantizeTest::normals,
+              &QuantizeTest::normals8Bit,
+              &QuantizeTest::normalsPrecision,
+              &QuantizeTest::normalsZero,
+              &QuantizeTest::normalsWrongSize,
+
+              &QuantizeTest::textureCoordinates,
+              &QuantizeTest::textureCoordinatesWrongSize});
+
+    addInstancedTests({&QuantizeTest::meshData},
+        Containers::arraySize(MeshDataData));
+
+    addTests({&QuantizeTest::meshDataNoQuantizedAttributes,
+              &QuantizeTest::meshDataMultipleAttributes,
+              &QuantizeTest::meshData2DPositions});
+}
+
+const Vector3 Positions[]{
+    {-1.0f, 2.0f, 0.0f},
+    {3.0f, 2.0f, 4.0f},
+    {1.0f, 6.0f, 2.0f},
+    {0.0f, 3.0f, 3.0f}
+};
+
+void QuantizeTest::positions() {
+    Vector3us quantized[4];
+    Matrix4 matrix = quantizePositionsInto(Positions, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {65535, 0, 65535},
+        {32768, 65535, 32768},
+        {16384, 16384, 49151}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(matrix, Matrix4::translation({-1.0f, 2.0f, 0.0f})*Matrix4::scaling(Vector3{4.0f}));
+
+    /* Dequantizing should give back the original, with an error depending on
+       the bounding box size */
+    for(std::size_t i = 0; i != Containers::arraySize(Positions); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS((matrix.transformPoint(Math::unpack<Vector3>(quantized[i])) - Positions[i]).length(), 4.0f/65535.0f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::positionsSigned() {
+    Vector3s quantized[4];
+    Matrix4 matrix = quantizePositionsInto(Positions, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector3s>({
+        {-32767, -32767, -32767},
+        {32767, -32767, 32767},
+        {0, 32767, 0},
+        {-16384, -16384, 16384}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(matrix, Matrix4::translation({1.0f, 4.0f, 2.0f})*Matrix4::scaling(Vector3{2.0f}));
+
+    for(std::size_t i = 0; i != Containers::arraySize(Positions); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS((matrix.transformPoint(Math::unpack<Vector3>(quantized[i])) - Positions[i]).length(), 4.0f/65535.0f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::positionsZeroSize() {
+    /* All points in a plane, the Z scale should be 1 to keep the matrix
+       invertible */
+    const Vector3 positions[]{
+        {1.0f, 2.0f, 5.0f},
+        {3.0f, 4.0f, 5.0f}
+    };
+
+    Vector3us quantized[2];
+    Matrix4 matrix = quantizePositionsInto(positions, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector3us>({
+        {0, 0, 0},
+        {65535, 65535, 0}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(matrix, Matrix4::translation({1.0f, 2.0f, 5.0f})*Matrix4::scaling({2.0f, 2.0f, 1.0f}));
+}
+
+void QuantizeTest::positionsEmpty() {
+    CORRADE_COMPARE(quantizePositionsInto(nullptr, Containers::StridedArrayView1D<Vector3us>{}), Matrix4{});
+    CORRADE_COMPARE(quantizePositionsInto(nullptr, Containers::StridedArrayView1D<Vector3s>{}), Matrix4{});
+}
+
+void QuantizeTest::positionsWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector3us quantized[3];
+    Vector3s quantizedSigned[5];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    quantizePositionsInto(Positions, quantized);
+    quantizePositionsInto(Positions, quantizedSigned);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantizePositionsInto(): bad output size, expected 4 but got 3\n"
+        "MeshTools::quantizePositionsInto(): bad output size, expected 4 but got 5\n");
+}
+
+const Vector3 Normals[]{
+    {0.0f, 0.0f, 1.0f},
+    {0.0f, 0.0f, -1.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 0.0f},
+    /* Doesn't need to be normalized */
+    {0.0f, 0.0f, -3.0f},
+    {-2.0f, 0.0f, -2.0f}
+};
+
+void QuantizeTest::normals() {
+    Vector2s quantized[6];
+    quantizeNormalsOctahedralInto(Normals, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector2s>({
+        {0, 0},
+        {32767, 32767},
+        {32767, 0},
+        {0, -32767},
+        {32767, 32767},
+        {-32767, 16384}
+    }), TestSuite::Compare::Container);
+
+    /* The last one isn't representable exactly */
+    Vector3 dequantized[6];
+    dequantizeNormalsOctahedralInto(quantized, dequantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(dequantized).prefix(5), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Math::dot(dequantized[5], Vector3{-1.0f, 0.0f, -1.0f}.normalized()), 0.999999f,
+        TestSuite::Compare::Greater);
+}
+
+void QuantizeTest::normals8Bit() {
+    Vector2b quantized[6];
+    quantizeNormalsOctahedralInto(Normals, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector2b>({
+        {0, 0},
+        {127, 127},
+        {127, 0},
+        {0, -127},
+        {127, 127},
+        {-127, 64}
+    }), TestSuite::Compare::Container);
+
+    /* The last one isn't representable exactly */
+    Vector3 dequantized[6];
+    dequantizeNormalsOctahedralInto(quantized, dequantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(dequantized).prefix(5), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, -1.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Math::dot(dequantized[5], Vector3{-1.0f, 0.0f, -1.0f}.normalized()), 0.9999f,
+        TestSuite::Compare::Greater);
+}
+
+void QuantizeTest::normalsPrecision() {
+    Trade::MeshData sphere = Primitives::icosphereSolid(4);
+    const Containers::StridedArrayView1D<const Vector3> normals = sphere.attribute<Vector3>(Trade::MeshAttribute::Normal);
+
+    Containers::Array<Vector3> dequantized{NoInit, normals.size()};
+    Containers::Array<Vector2s> quantized{NoInit, normals.size()};
+    Containers::Array<Vector2b> quantized8{NoInit, normals.size()};
+    quantizeNormalsOctahedralInto(normals, quantized);
+    quantizeNormalsOctahedralInto(normals, quantized8);
+
+    /* The 16-bit variant has an error of about 0.04° at most, the 8-bit one
+       about a degree */
+    dequantizeNormalsOctahedralInto(quantized, dequantized);
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(Math::dot(dequantized[i], normals[i]), 0.999999f,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+    dequantizeNormalsOctahedralInto(quantized8, dequantized);
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(Math::dot(dequantized[i], normals[i]), 0.9998f,
+            TestSuite::Compare::GreaterOrEqual);
+    }
+}
+
+void QuantizeTest::normalsZero() {
+    const Vector3 normals[]{
+        {},
+        {0.0f, -0.0f, -0.0f}
+    };
+
+    Vector2s quantized[2];
+    quantizeNormalsOctahedralInto(normals, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector2s>({
+        {0, 0},
+        {0, 0}
+    }), TestSuite::Compare::Container);
+
+    Vector3 dequantized[2];
+    dequantizeNormalsOctahedralInto(quantized, dequantized);
+    CORRADE_COMPARE(dequantized[0], Vector3::zAxis());
+    CORRADE_COMPARE(dequantized[1], Vector3::zAxis());
+}
+
+void QuantizeTest::normalsWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Vector2s quantized[5];
+    Vector2b quantized8[7];
+    Vector3 dequantized[4];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    quantizeNormalsOctahedralInto(Normals, quantized);
+    quantizeNormalsOctahedralInto(Normals, quantized8);
+    dequantizeNormalsOctahedralInto(quantized, dequantized);
+    dequantizeNormalsOctahedralInto(quantized8, dequantized);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantizeNormalsOctahedralInto(): bad output size, expected 6 but got 5\n"
+        "MeshTools::quantizeNormalsOctahedralInto(): bad output size, expected 6 but got 7\n"
+        "MeshTools::dequantizeNormalsOctahedralInto(): bad output size, expected 5 but got 4\n"
+        "MeshTools::dequantizeNormalsOctahedralInto(): bad output size, expected 7 but got 4\n");
+}
+
+void QuantizeTest::textureCoordinates() {
+    const Vector2 textureCoordinates[]{
+        {0.5f, 1.0f},
+        {-1.5f, 2.0f},
+        {0.0f, 3.0f}
+    };
+
+    Vector2us quantized[3];
+    Matrix3 matrix = quantizeTextureCoordinatesInto(textureCoordinates, quantized);
+    CORRADE_COMPARE_AS(Containers::arrayView(quantized), Containers::arrayView<Vector2us>({
+        {65535, 0},
+        {0, 32768},
+        {49151, 65535}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(matrix, Matrix3::translation({-1.5f, 1.0f})*Matrix3::scaling({2.0f, 2.0f}));
+
+    for(std::size_t i = 0; i != Containers::arraySize(textureCoordinates); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS((matrix.transformPoint(Math::unpack<Vector2>(quantized[i])) - textureCoordinates[i]).length(), 2.0f/65535.0f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::textureCoordinatesWrongSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector2 textureCoordinates[3];
+    Vector2us quantized[2];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    quantizeTextureCoordinatesInto(textureCoordinates, quantized);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantizeTextureCoordinatesInto(): bad output size, expected 3 but got 2\n");
+}
+
+void QuantizeTest::meshData() {
+    auto&& data = MeshDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData sphere = Primitives::icosphereSolid(2);
+
+    /* Add texture coordinates and an unrelated attribute to verify it's
+       passed through */
+    Containers::Array<char> vertexData{NoInit, sphere.vertexCount()*(sizeof(Vector3)*2 + sizeof(Vector2) + sizeof(UnsignedInt))};
+    Containers::StridedArrayView1D<Vector3> positions{vertexData,
+        reinterpret_cast<Vector3*>(vertexData.data()),
+        sphere.vertexCount(), sizeof(Vector3)};
+    Containers::StridedArrayView1D<Vector3> normals{vertexData,
+        reinterpret_cast<Vector3*>(vertexData.data() + sphere.vertexCount()*sizeof(Vector3)),
+        sphere.vertexCount(), sizeof(Vector3)};
+    Containers::StridedArrayView1D<Vector2> textureCoordinates{vertexData,
+        reinterpret_cast<Vector2*>(vertexData.data() + sphere.vertexCount()*sizeof(Vector3)*2),
+        sphere.vertexCount(), sizeof(Vector2)};
+    Containers::StridedArrayView1D<UnsignedInt> objectIds{vertexData,
+        reinterpret_cast<UnsignedInt*>(vertexData.data() + sphere.vertexCount()*(sizeof(Vector3)*2 + sizeof(Vector2))),
+        sphere.vertexCount(), sizeof(UnsignedInt)};
+    for(std::size_t i = 0; i != sphere.vertexCount(); ++i) {
+        positions[i] = sphere.attribute<Vector3>(Trade::MeshAttribute::Position)[i];
+        normals[i] = sphere.attribute<Vector3>(Trade::MeshAttribute::Normal)[i];
+        textureCoordinates[i] = positions[i].xy()*0.5f + Vector2{0.5f};
+        objectIds[i] = UnsignedInt(i*3);
+    }
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, sphere.indexData(), Trade::MeshIndexData{sphere.indices<UnsignedInt>()},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, objectIds},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, textureCoordinates}
+        }};
+
+    Containers::Triple<Trade::MeshData, Matrix4, Matrix3> out = quantize(mesh, data.flags);
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(out.first().indices<UnsignedInt>(),
+        sphere.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().vertexCount(), sphere.vertexCount());
+
+    /* The quantized attributes are added to the end, the layout is tightly
+       packed */
+    CORRADE_COMPARE(out.first().attributeCount(), 4);
+    CORRADE_COMPARE(out.first().attributeName(0), Trade::MeshAttribute::ObjectId);
+    CORRADE_COMPARE(out.first().attributeName(1), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(out.first().attributeFormat(1), data.positionFormat);
+    CORRADE_COMPARE(out.first().attributeName(2), MeshAttributeOctahedralNormal);
+    CORRADE_COMPARE(out.first().attributeFormat(2), data.normalFormat);
+    CORRADE_COMPARE(out.first().attributeName(3), Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(out.first().attributeFormat(3), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(out.first().attributeStride(0), data.stride + 4);
+    CORRADE_COMPARE_AS(out.first().attribute<UnsignedInt>(0),
+        Containers::StridedArrayView1D<const UnsignedInt>{objectIds},
+        TestSuite::Compare::Container);
+
+    /* The icosphere is symmetric around the origin, so the signed variant
+       has no translation */
+    if(data.flags & QuantizeFlag::SignedPositions)
+        CORRADE_COMPARE(out.second().translation(), Vector3{});
+    else
+        CORRADE_VERIFY((out.second().translation() < Vector3{}).all());
+
+    /* Verify that the data roundtrip */
+    const Containers::Array<Vector3> outPositions = out.first().positions3DAsArray();
+    const Containers::Array<Vector2> outTextureCoordinates = out.first().textureCoordinates2DAsArray();
+    Containers::Array<Vector3> outNormals{NoInit, sphere.vertexCount()};
+    if(data.flags & QuantizeFlag::Normals8Bit)
+        dequantizeNormalsOctahedralInto(out.first().attribute<Vector2b>(2), outNormals);
+    else
+        dequantizeNormalsOctahedralInto(out.first().attribute<Vector2s>(2), outNormals);
+    for(std::size_t i = 0; i != sphere.vertexCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS((out.second().transformPoint(outPositions[i]) - positions[i]).length(), 2.0f/32767.0f,
+            TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(Math::dot(outNormals[i], normals[i]), 0.9998f,
+            TestSuite::Compare::GreaterOrEqual);
+        CORRADE_COMPARE_AS((out.third().transformPoint(outTextureCoordinates[i]) - textureCoordinates[i]).length(), 1.0f/65535.0f,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void QuantizeTest::meshDataNoQuantizedAttributes() {
+    const UnsignedShort objectIds[]{3, 1, 2};
+    const Trade::MeshData mesh{MeshPrimitive::Points, {}, objectIds, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, Containers::arrayView(objectIds)}
+    }};
+
+    Containers::Triple<Trade::MeshData, Matrix4, Matrix3> out = quantize(mesh);
+    CORRADE_COMPARE(out.first().primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!out.first().isIndexed());
+    CORRADE_COMPARE(out.first().attributeCount(), 1);
+    CORRADE_COMPARE_AS(out.first().attribute<UnsignedShort>(Trade::MeshAttribute::ObjectId),
+        Containers::arrayView(objectIds),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), Matrix4{});
+    CORRADE_COMPARE(out.third(), Matrix3{});
+}
+
+void QuantizeTest::meshDataMultipleAttributes() {
+    struct Vertex {
+        Vector2 textureCoordinates1;
+        Vector3 position;
+        Vector2 textureCoordinates2;
+    } vertices[]{
+        {{0.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}, {2.0f, 3.0f}},
+        {{1.0f, 2.0f}, {1.0f, 0.0f, 0.0f}, {4.0f, 5.0f}}
+    };
+    Containers::StridedArrayView1D<const Vertex> view = vertices;
+    const Trade::MeshData mesh{MeshPrimitive::Lines, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            view.slice(&Vertex::textureCoordinates1)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            view.slice(&Vertex::textureCoordinates2)}
+    }};
+
+    /* Only the first texture coordinate set is quantized, the second is
+       passed through */
+    Containers::Triple<Trade::MeshData, Matrix4, Matrix3> out = quantize(mesh);
+    CORRADE_COMPARE(out.first().attributeCount(), 3);
+    CORRADE_COMPARE(out.first().attributeName(0), Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(out.first().attributeFormat(0), VertexFormat::Vector2);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2>(0),
+        view.slice(&Vertex::textureCoordinates2),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(1), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(out.first().attributeFormat(1), VertexFormat::Vector3usNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector3us>(1),
+        Containers::arrayView<Vector3us>({
+            {0, 0, 0},
+            {65535, 0, 0}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.first().attributeName(2), Trade::MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(out.first().attributeFormat(2), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE_AS(out.first().attribute<Vector2us>(2),
+        Containers::arrayView<Vector2us>({
+            {0, 0},
+            {65535, 65535}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(out.second(), Matrix4::translation(Vector3::xAxis(-1.0f))*Matrix4::scaling({2.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(out.third(), Matrix3::scaling({1.0f, 2.0f}));
+}
+
+void QuantizeTest::meshData2DPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Vector2 positions[3];
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    quantize(mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::quantize(): expected 3D positions but got VertexFormat::Vector2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
@@ -25,6 +25,7 @@
 
 #include <algorithm> /* std::shuffle() */
 #include <random> /* random device for std::shuffle() */
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -42,6 +43,8 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
 
     /* These test also the InPlace variant */
     void removeDuplicates();
+    void removeDuplicatesKeySize();
+    void removeDuplicatesMultithreaded();
     void removeDuplicatesNonContiguous();
     void removeDuplicatesIntoWrongOutputSize();
 
@@ -55,6 +58,8 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
 
     template<class T> void removeDuplicatesFuzzyInPlaceOneDimension();
     template<class T> void removeDuplicatesFuzzyInPlaceMoreDimensions();
+    template<class T> void removeDuplicatesFuzzyInPlaceCellBoundary();
+    void removeDuplicatesFuzzyInPlaceManyDimensions();
     template<class T> void removeDuplicatesFuzzyInPlaceInto();
     void removeDuplicatesFuzzyInPlaceIntoWrongOutputSize();
     #ifdef MAGNUM_BUILD_DEPRECATED
@@ -72,12 +77,14 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
 
     void removeDuplicatesMeshData();
     void removeDuplicatesMeshDataPaddedAttributes();
+    void removeDuplicatesMeshDataMultithreaded();
     void removeDuplicatesMeshDataAttributeless();
     void removeDuplicatesMeshDataImplementationSpecificIndexType();
     void removeDuplicatesMeshDataImplementationSpecificVertexFormat();
 
     void removeDuplicatesMeshDataFuzzy();
     void removeDuplicatesMeshDataFuzzyDouble();
+    void removeDuplicatesMeshDataFuzzyNoisy();
     void removeDuplicatesMeshDataFuzzyAttributeless();
     void removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType();
     void removeDuplicatesMeshDataFuzzyImplementationSpecificVertexFormat();
@@ -86,7 +93,50 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void soakTestFuzzy();
 
     void benchmark();
+    void benchmarkUnique();
     void benchmarkFuzzy();
+    void benchmarkFuzzyNoisyMesh();
+};
+
+const struct {
+    const char* name;
+    std::size_t keySize;
+} RemoveDuplicatesKeySizeData[] {
+    /* Sizes that have a specialized implementation */
+    {"4 bytes", 4},
+    {"8 bytes", 8},
+    {"12 bytes", 12},
+    {"16 bytes", 16},
+    {"24 bytes", 24},
+    {"32 bytes", 32},
+    /* Sizes that go through the generic implementation, with and without a
+       remainder not divisible by 8 */
+    {"1 byte", 1},
+    {"6 bytes", 6},
+    {"20 bytes", 20},
+    {"40 bytes", 40},
+    {"45 bytes", 45},
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} RemoveDuplicatesMultithreadedData[] {
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"all hardware threads", 0}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+    bool indexed;
+} RemoveDuplicatesMeshDataMultithreadedData[] {
+    {"3 threads", 3, false},
+    {"3 threads, indexed", 3, true},
+    {"all hardware threads", 0, false},
+    {"all hardware threads, indexed", 0, true}
 };
 
 const struct {
@@ -195,8 +245,15 @@ const struct {
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::removeDuplicates,
-              &RemoveDuplicatesTest::removeDuplicatesNonContiguous,
+    addTests({&RemoveDuplicatesTest::removeDuplicates});
+
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesKeySize},
+        Containers::arraySize(RemoveDuplicatesKeySizeData));
+
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesMultithreaded},
+        Containers::arraySize(RemoveDuplicatesMultithreadedData));
+
+    addTests({&RemoveDuplicatesTest::removeDuplicatesNonContiguous,
               &RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedShort>,
@@ -214,6 +271,9 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceOneDimension<Double>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceMoreDimensions<Float>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceMoreDimensions<Double>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceCellBoundary<Float>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceCellBoundary<Double>,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceManyDimensions,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Float>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Double>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize,
@@ -243,6 +303,9 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
 
     addTests({&RemoveDuplicatesTest::removeDuplicatesMeshDataPaddedAttributes});
 
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesMeshDataMultithreaded},
+        Containers::arraySize(RemoveDuplicatesMeshDataMultithreadedData));
+
     addTests({&RemoveDuplicatesTest::removeDuplicatesMeshDataAttributeless,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataImplementationSpecificIndexType,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataImplementationSpecificVertexFormat});
@@ -251,6 +314,7 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
         Containers::arraySize(RemoveDuplicatesMeshDataFuzzyData));
 
     addTests({&RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyDouble,
+              &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyNoisy,
 
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyAttributeless,
               &RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyImplementationSpecificIndexType,
@@ -260,7 +324,9 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
                       &RemoveDuplicatesTest::soakTestFuzzy}, 10);
 
     addBenchmarks({&RemoveDuplicatesTest::benchmark,
-                   &RemoveDuplicatesTest::benchmarkFuzzy}, 10);
+                   &RemoveDuplicatesTest::benchmarkUnique,
+                   &RemoveDuplicatesTest::benchmarkFuzzy,
+                   &RemoveDuplicatesTest::benchmarkFuzzyNoisyMesh}, 10);
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -282,6 +348,77 @@ void RemoveDuplicatesTest::removeDuplicates() {
         TestSuite::Compare::Container);
 }
 
+void RemoveDuplicatesTest::removeDuplicatesKeySize() {
+    auto&& data = RemoveDuplicatesKeySizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 96 items made of 7 unique byte patterns that differ only in a single
+       byte, placed at a different position in each pattern to verify the
+       whole key gets hashed and compared. Each item is followed by padding
+       that differs every time, which shouldn't be taken into account. */
+    constexpr std::size_t Count = 96;
+    const std::size_t stride = data.keySize + 3;
+    Containers::Array<char> storage{ValueInit, Count*stride};
+    Containers::StridedArrayView2D<char> items{storage, {Count, data.keySize}, {std::ptrdiff_t(stride), 1}};
+    for(std::size_t i = 0; i != Count; ++i) {
+        const std::size_t pattern = (i*5 + i/7) % 7;
+        if(pattern) items[i][(pattern*3) % data.keySize] = char(pattern);
+        storage[i*stride + data.keySize] = char(i);
+    }
+
+    /* Calculate the expected output with a brute-force search */
+    Containers::Array<UnsignedInt> expected{NoInit, Count};
+    Containers::Array<UnsignedInt> expectedInPlace{NoInit, Count};
+    std::size_t expectedCount = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        std::size_t j = 0;
+        for(; j != i; ++j)
+            if(std::memcmp(items[i].data(), items[j].data(), data.keySize) == 0) break;
+        if(j == i) {
+            expected[i] = i;
+            expectedInPlace[i] = expectedCount++;
+        } else {
+            expected[i] = expected[j];
+            expectedInPlace[i] = expectedInPlace[j];
+        }
+    }
+    CORRADE_COMPARE(expectedCount, 7);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicates(items);
+    CORRADE_COMPARE(result.second, expectedCount);
+    CORRADE_COMPARE_AS(result.first, expected,
+        TestSuite::Compare::Container);
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> resultInPlace =
+        MeshTools::removeDuplicatesInPlace(items);
+    CORRADE_COMPARE(resultInPlace.second, expectedCount);
+    CORRADE_COMPARE_AS(resultInPlace.first, expectedInPlace,
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesMultithreaded() {
+    auto&& data = RemoveDuplicatesMultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 200k items with 50k unique, large enough to be split among at least 8
+       threads, shuffled with a fixed seed. The result should be exactly the
+       same as with the serial variant. */
+    Containers::Array<Vector3i> items{ValueInit, 200000};
+    for(std::size_t i = 0; i != items.size(); ++i)
+        items[i] = {Int(i % 50000), 7, -Int(i % 50000)/3};
+    std::shuffle(items.begin(), items.end(), std::minstd_rand{17});
+    const Containers::StridedArrayView2D<const char> view = Containers::arrayCast<2, const char>(Containers::stridedArrayView(items));
+
+    Containers::Array<UnsignedInt> expected{NoInit, items.size()};
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(view, expected), 50000);
+
+    Containers::Array<UnsignedInt> indices{NoInit, items.size()};
+    CORRADE_COMPARE(MeshTools::removeDuplicatesInto(view, indices, data.threadCount), 50000);
+    CORRADE_COMPARE_AS(indices, expected,
+        TestSuite::Compare::Container);
+}
+
 void RemoveDuplicatesTest::removeDuplicatesNonContiguous() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -458,6 +595,55 @@ template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceMoreDim
         TestSuite::Compare::Container);
 }
 
+template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceCellBoundary() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* The data are put into a grid of cells 4*epsilon large, starting at the
+       minimal value. Items 1 and 2 are in different cells but closer than
+       epsilon, so they should get merged. Item 3 is closer than epsilon to
+       item 2, but item 2 got merged into item 1 and item 3 is further than
+       epsilon from that one, so it's kept. */
+    T data[]{
+        T(0.0),
+        T(0.395), /* cell 0, close to the upper boundary */
+        T(0.405), /* cell 1, close to the lower boundary */
+        T(0.5),   /* cell 1 */
+        T(10.0),
+        T(0.39)   /* merged into item 1 */
+    };
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicatesFuzzyInPlace(
+            Containers::arrayCast<2, T>(Containers::stridedArrayView(data)),
+            T(0.1));
+    CORRADE_COMPARE_AS(Containers::arrayView(result.first),
+        Containers::arrayView<UnsignedInt>({0, 1, 1, 2, 3, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data).prefix(result.second),
+        (Containers::arrayView<T>({T(0.0), T(0.395), T(0.5), T(10.0)})),
+        TestSuite::Compare::Container);
+}
+
+void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceManyDimensions() {
+    /* Only the first four dimensions are used for the grid, the others should
+       be still taken into account when comparing */
+    Math::Vector<6, Float> data[]{
+        {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f},
+        {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 7.0f},
+        {1.0f, 2.0f, 3.0f, 4.1f, 5.0f, 6.1f},
+        {1.0f, 2.0f, 3.0f, 4.0f, 5.1f, 7.2f}
+    };
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+        MeshTools::removeDuplicatesFuzzyInPlace(
+            Containers::arrayCast<2, Float>(Containers::stridedArrayView(data)),
+            0.25f);
+    CORRADE_COMPARE_AS(Containers::arrayView(result.first),
+        Containers::arrayView<UnsignedInt>({0, 1, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(result.second, 2);
+}
+
 template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -825,6 +1011,54 @@ void RemoveDuplicatesTest::removeDuplicatesMeshDataPaddedAttributes() {
     }), TestSuite::Compare::Container);
 }
 
+void RemoveDuplicatesTest::removeDuplicatesMeshDataMultithreaded() {
+    auto&& data = RemoveDuplicatesMeshDataMultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* 100k vertices with roughly a third of them unique, randomly shuffled
+       with a fixed seed */
+    struct Vertex {
+        Vector3 position;
+        UnsignedShort id;
+    };
+    Containers::Array<Vertex> vertices{ValueInit, 100000};
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = {{Float(i % 100), Float(i/3 % 1000), 0.5f}, UnsignedShort(i % 3 == 2 ? i % 7 : 0)};
+    std::shuffle(vertices.begin(), vertices.end(), std::minstd_rand{23});
+
+    Containers::Array<UnsignedInt> indexData{NoInit, 150000};
+    for(std::size_t i = 0; i != indexData.size(); ++i)
+        indexData[i] = (i*7919) % vertices.size();
+
+    Containers::ArrayView<const void> indexView;
+    Trade::MeshIndexData indices;
+    if(data.indexed) {
+        indexView = Containers::arrayView(indexData);
+        indices = Trade::MeshIndexData{Containers::arrayView(indexData)};
+    }
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indexView, indices,
+        {}, Containers::arrayView(vertices), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(vertices).slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                Containers::stridedArrayView(vertices).slice(&Vertex::id)},
+    }};
+
+    /* The output should be exactly the same as with the serial variant */
+    Trade::MeshData expected = MeshTools::removeDuplicates(mesh);
+    Trade::MeshData unique = MeshTools::removeDuplicates(mesh, data.threadCount);
+    CORRADE_COMPARE(unique.vertexCount(), expected.vertexCount());
+    CORRADE_COMPARE(unique.indexType(), expected.indexType());
+    CORRADE_COMPARE_AS(unique.indices<UnsignedInt>(),
+        expected.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(unique.vertexData(),
+        expected.vertexData(),
+        TestSuite::Compare::Container);
+}
+
 void RemoveDuplicatesTest::removeDuplicatesMeshDataAttributeless() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -1168,6 +1402,45 @@ void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyDouble() {
         TestSuite::Compare::Container);
 }
 
+void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyNoisy() {
+    /* A 10x10 grid of positions with each position present four times,
+       jittered in different directions. The normals are jittered as well.
+       Position epsilon gets scaled by the ~9 unit range, so it's ~0.009;
+       normal epsilon is 0.002. */
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    } vertices[400];
+    for(std::size_t i = 0; i != Containers::arraySize(vertices); ++i) {
+        const std::size_t copy = i % 4;
+        const Vector3 jitter{copy & 1 ? 0.002f : -0.002f, copy & 2 ? 0.002f : -0.002f, copy == 1 ? 0.0015f : 0.0f};
+        vertices[i].position = Vector3{Float(i/4 % 10), Float(i/40), 0.0f} + jitter;
+        vertices[i].normal = Vector3::zAxis() + jitter/4.0f;
+    }
+
+    Trade::MeshData mesh{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::stridedArrayView(vertices).slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            Containers::stridedArrayView(vertices).slice(&Vertex::normal)}
+    }};
+
+    Trade::MeshData unique = MeshTools::removeDuplicatesFuzzy(mesh, 0.001f);
+    CORRADE_COMPARE(unique.vertexCount(), 100);
+
+    /* All copies should get collapsed to the first one */
+    Containers::StridedArrayView1D<const UnsignedInt> indices = unique.indices<UnsignedInt>();
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(indices[i], i/4);
+    }
+    for(std::size_t i = 0; i != unique.vertexCount(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(unique.attribute<Vector3>(Trade::MeshAttribute::Position)[i], vertices[i*4].position);
+        CORRADE_COMPARE(unique.attribute<Vector3>(Trade::MeshAttribute::Normal)[i], vertices[0].normal);
+    }
+}
+
 void RemoveDuplicatesTest::removeDuplicatesMeshDataFuzzyAttributeless() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -1249,6 +1522,24 @@ void RemoveDuplicatesTest::benchmark() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkUnique() {
+    /* Array of 100k items with just a few duplicates, shuffled. Unlike the
+       above, this exercises the hash table being filled up. */
+    Containers::Array<Vector3i> data{ValueInit, 100000};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = {Int(i/2 % 50), Int(i/100), Int(i/2)};
+    std::shuffle(data.begin(), data.end(), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count = 0;
+    Containers::Array<UnsignedInt> indices{NoInit, data.size()};
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInPlaceInto(
+            Containers::arrayCast<2, char>(Containers::stridedArrayView(data)),
+            indices);
+
+    CORRADE_COMPARE(count, 50000);
+}
+
 void RemoveDuplicatesTest::benchmarkFuzzy() {
     /* Array of 100 unique items with 100 duplicates each, shuffled */
     Vector3 data[10000];
@@ -1268,6 +1559,39 @@ void RemoveDuplicatesTest::benchmarkFuzzy() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkFuzzyNoisyMesh() {
+    /* Imitating a photogrammetry scan -- a 250x200 grid with each vertex
+       present four times (once for each adjacent quad) and with random noise
+       on positions and normals that's well within the epsilon */
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+    };
+    Containers::Array<Vertex> vertices{NoInit, 200000};
+    std::minstd_rand rng{1};
+    std::uniform_real_distribution<Float> noise{-0.00001f, 0.00001f};
+    for(std::size_t i = 0; i != vertices.size(); ++i) {
+        const Vector3 jitter{noise(rng), noise(rng), noise(rng)};
+        vertices[i].position = Vector3{Float(i/4 % 250), Float(i/1000), 0.0f}*0.01f + jitter;
+        vertices[i].normal = (Vector3::zAxis() + jitter).normalized();
+    }
+    std::shuffle(vertices.begin(), vertices.end(), rng);
+
+    Trade::MeshData mesh{MeshPrimitive::Points,
+        {}, Containers::arrayView(vertices), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(vertices).slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                Containers::stridedArrayView(vertices).slice(&Vertex::normal)}
+    }};
+
+    UnsignedInt vertexCount = 0;
+    CORRADE_BENCHMARK(1)
+        vertexCount = MeshTools::removeDuplicatesFuzzy(mesh, 0.001f).vertexCount();
+
+    CORRADE_COMPARE(vertexCount, 50000);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
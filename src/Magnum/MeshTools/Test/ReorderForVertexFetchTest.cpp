@@ -0,0 +1,328 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/ReorderForVertexFetch.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct ReorderForVertexFetchTest: TestSuite::Tester {
+    explicit ReorderForVertexFetchTest();
+
+    template<class T> void inPlace();
+    void inPlaceEmpty();
+    void inPlaceErased();
+    void inPlaceErasedNonContiguous();
+    void inPlaceErasedWrongIndexSize();
+    void inPlaceIndexOutOfBounds();
+
+    void meshDataInterleaved();
+    void meshDataNonInterleaved();
+    void meshDataRvalue();
+    void meshDataNotIndexed();
+    void meshDataImplementationSpecificIndexType();
+    void meshDataImplementationSpecificVertexFormat();
+};
+
+ReorderForVertexFetchTest::ReorderForVertexFetchTest() {
+    addTests({&ReorderForVertexFetchTest::inPlace<UnsignedByte>,
+              &ReorderForVertexFetchTest::inPlace<UnsignedShort>,
+              &ReorderForVertexFetchTest::inPlace<UnsignedInt>,
+              &ReorderForVertexFetchTest::inPlaceEmpty,
+              &ReorderForVertexFetchTest::inPlaceErased,
+              &ReorderForVertexFetchTest::inPlaceErasedNonContiguous,
+              &ReorderForVertexFetchTest::inPlaceErasedWrongIndexSize,
+              &ReorderForVertexFetchTest::inPlaceIndexOutOfBounds,
+
+              &ReorderForVertexFetchTest::meshDataInterleaved,
+              &ReorderForVertexFetchTest::meshDataNonInterleaved,
+              &ReorderForVertexFetchTest::meshDataRvalue,
+              &ReorderForVertexFetchTest::meshDataNotIndexed,
+              &ReorderForVertexFetchTest::meshDataImplementationSpecificIndexType,
+              &ReorderForVertexFetchTest::meshDataImplementationSpecificVertexFormat});
+}
+
+template<class T> void ReorderForVertexFetchTest::inPlace() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[]{3, 1, 3, 4, 0, 1};
+
+    /* Vertices 2 and 5 are not referenced, they get put at the end */
+    Containers::Array<UnsignedInt> mapping = reorderForVertexFetchInPlace(indices, 6);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        0, 1, 0, 2, 3, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mapping, Containers::arrayView<UnsignedInt>({
+        3, 1, 4, 0, 2, 5
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderForVertexFetchTest::inPlaceEmpty() {
+    /* No indices, the mapping is an identity */
+    Containers::Array<UnsignedInt> mapping = reorderForVertexFetchInPlace(Containers::ArrayView<UnsignedInt>{}, 3);
+    CORRADE_COMPARE_AS(mapping, Containers::arrayView<UnsignedInt>({
+        0, 1, 2
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderForVertexFetchTest::inPlaceErased() {
+    UnsignedShort indices[]{3, 1, 3, 4, 0, 1};
+
+    Containers::Array<UnsignedInt> mapping = reorderForVertexFetchInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), 5);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedShort>({
+        0, 1, 0, 2, 3, 1
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mapping, Containers::arrayView<UnsignedInt>({
+        3, 1, 4, 0, 2
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderForVertexFetchTest::inPlaceErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetchInPlace(Containers::StridedArrayView2D<char>{indices, {6, 2}, {4, 2}}, 5);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::reorderForVertexFetchInPlace(): second index view dimension is not contiguous\n");
+}
+
+void ReorderForVertexFetchTest::inPlaceErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetchInPlace(Containers::StridedArrayView2D<char>{indices, {6, 3}}.every(2), 5);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::reorderForVertexFetchInPlace(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void ReorderForVertexFetchTest::inPlaceIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedShort indices[]{3, 1, 5, 4, 0, 1};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetchInPlace(indices, 5);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::reorderForVertexFetchInPlace(): index 5 out of bounds for 5 vertices\n");
+}
+
+void ReorderForVertexFetchTest::meshDataInterleaved() {
+    const UnsignedByte indices[]{3, 1, 3, 4, 0, 1};
+    const struct Vertex {
+        Vector2 position;
+        UnsignedShort id;
+        /* Padding that's not covered by any attribute, should be copied
+           verbatim */
+        UnsignedShort padding;
+    } vertices[]{
+        {{0.0f, 0.5f}, 0, 0xcaca},
+        {{1.0f, 1.5f}, 1, 0xcaca},
+        {{2.0f, 2.5f}, 2, 0xcaca},
+        {{3.0f, 3.5f}, 3, 0xcaca},
+        {{4.0f, 4.5f}, 4, 0xcaca}
+    };
+    auto view = Containers::stridedArrayView(vertices);
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                view.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                view.slice(&Vertex::id)}
+        }};
+
+    Trade::MeshData out = reorderForVertexFetch(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(out.indices<UnsignedByte>(), Containers::arrayView<UnsignedByte>({
+        0, 1, 0, 2, 3, 1
+    }), TestSuite::Compare::Container);
+
+    /* The layout is preserved */
+    CORRADE_COMPARE(out.vertexCount(), 5);
+    CORRADE_COMPARE(out.vertexData().size(), sizeof(vertices));
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE(out.attributeOffset(0), 0);
+    CORRADE_COMPARE(out.attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE(out.attributeOffset(1), sizeof(Vector2));
+    CORRADE_COMPARE(out.attributeStride(1), sizeof(Vertex));
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::Position), Containers::arrayView<Vector2>({
+        {3.0f, 3.5f},
+        {1.0f, 1.5f},
+        {4.0f, 4.5f},
+        {0.0f, 0.5f},
+        {2.0f, 2.5f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<UnsignedShort>(Trade::MeshAttribute::ObjectId), Containers::arrayView<UnsignedShort>({
+        3, 1, 4, 0, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(Containers::arrayCast<const Vertex>(out.vertexData())).slice(&Vertex::padding), Containers::arrayView<UnsignedShort>({
+        0xcaca, 0xcaca, 0xcaca, 0xcaca, 0xcaca
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderForVertexFetchTest::meshDataNonInterleaved() {
+    const UnsignedInt indices[]{2, 2, 0};
+    struct {
+        UnsignedInt header;
+        Vector3 positions[3];
+        Vector2ub weights[3];
+    } vertexData{
+        0xdeadbeef,
+        {{0.0f, 0.1f, 0.2f},
+         {1.0f, 1.1f, 1.2f},
+         {2.0f, 2.1f, 2.2f}},
+        {{0, 10}, {1, 11}, {2, 12}}
+    };
+    const Trade::MeshData mesh{MeshPrimitive::Points,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, Containers::arrayView(&vertexData, 1), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(vertexData.positions)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(0),
+                VertexFormat::UnsignedByte,
+                Containers::arrayView(vertexData.weights), 2}
+        }};
+
+    Trade::MeshData out = reorderForVertexFetch(mesh);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(out.indices<UnsignedInt>(), Containers::arrayView<UnsignedInt>({
+        0, 0, 1
+    }), TestSuite::Compare::Container);
+
+    /* The layout is preserved, data outside of attributes are copied
+       verbatim */
+    CORRADE_COMPARE(out.vertexCount(), 3);
+    CORRADE_COMPARE(out.vertexData().size(), sizeof(vertexData));
+    CORRADE_COMPARE(*reinterpret_cast<const UnsignedInt*>(out.vertexData().data()), 0xdeadbeef);
+    CORRADE_COMPARE(out.attributeOffset(0), 4);
+    CORRADE_COMPARE(out.attributeStride(0), sizeof(Vector3));
+    CORRADE_COMPARE(out.attributeOffset(1), 4 + 3*sizeof(Vector3));
+    CORRADE_COMPARE(out.attributeStride(1), 2);
+    CORRADE_COMPARE(out.attributeArraySize(1), 2);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(0), Containers::arrayView<Vector3>({
+        {2.0f, 2.1f, 2.2f},
+        {0.0f, 0.1f, 0.2f},
+        {1.0f, 1.1f, 1.2f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::arrayCast<1, const Vector2ub>(out.attribute<UnsignedByte[]>(1))), Containers::arrayView<Vector2ub>({
+        {2, 12}, {0, 10}, {1, 11}
+    }), TestSuite::Compare::Container);
+
+    /* The original data should stay untouched */
+    CORRADE_COMPARE(indices[0], 2);
+    CORRADE_COMPARE(vertexData.positions[0], (Vector3{0.0f, 0.1f, 0.2f}));
+}
+
+void ReorderForVertexFetchTest::meshDataRvalue() {
+    Containers::Array<char> indexData{NoInit, 4*sizeof(UnsignedShort)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView<UnsignedShort>({2, 0, 2, 1})), indexData);
+    Containers::Array<char> vertexData{NoInit, 3*sizeof(Float)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView<Float>({0.0f, 1.0f, 2.0f})), vertexData);
+    const void* indexPointer = indexData.data();
+    const void* vertexPointer = vertexData.data();
+
+    Trade::MeshIndexData indices{Containers::arrayCast<UnsignedShort>(indexData)};
+    Trade::MeshAttributeData positions{Trade::meshAttributeCustom(0),
+        Containers::arrayCast<Float>(vertexData)};
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        std::move(indexData), indices,
+        std::move(vertexData), {positions}};
+
+    /* Owned index data should be reused, vertex data can't be */
+    Trade::MeshData out = reorderForVertexFetch(std::move(mesh));
+    CORRADE_COMPARE(out.indexData().data(), indexPointer);
+    CORRADE_VERIFY(out.vertexData().data() != vertexPointer);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        0, 1, 0, 2
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Float>(0), Containers::arrayView<Float>({
+        2.0f, 0.0f, 1.0f
+    }), TestSuite::Compare::Container);
+}
+
+void ReorderForVertexFetchTest::meshDataNotIndexed() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderForVertexFetch(): mesh data not indexed\n");
+}
+
+void ReorderForVertexFetchTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderForVertexFetch(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void ReorderForVertexFetchTest::meshDataImplementationSpecificVertexFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        nullptr, Trade::MeshIndexData{MeshIndexType::UnsignedShort, nullptr},
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+                vertexFormatWrap(0xcaca), nullptr}
+        }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    reorderForVertexFetch(mesh);
+    CORRADE_COMPARE(out.str(), "MeshTools::reorderForVertexFetch(): attribute 1 has an implementation-specific format 0xcaca\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::ReorderForVertexFetchTest)
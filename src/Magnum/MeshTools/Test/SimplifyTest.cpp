@@ -0,0 +1,527 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    template<class T> void inPlace();
+    void inPlaceTargetIndexCount();
+    void inPlaceTargetErrorTooSmall();
+    void inPlaceSeam();
+    void inPlaceClosed();
+    void inPlaceClosedTargetError();
+    void inPlaceEmpty();
+    void inPlaceErased();
+    void inPlaceErasedNonContiguous();
+    void inPlaceErasedWrongIndexSize();
+    void inPlaceInvalidIndexCount();
+    void inPlaceIndexOutOfBounds();
+    void inPlaceNegativeTargetError();
+
+    void meshData();
+    void meshDataNotTriangles();
+    void meshDataNotIndexed();
+    void meshDataImplementationSpecificIndexType();
+    void meshDataNoPositions();
+    void meshDataImplementationSpecificVertexFormat();
+
+    void levels();
+    void levelsZero();
+    void levelsInvalidRatio();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::inPlace<UnsignedByte>,
+              &SimplifyTest::inPlace<UnsignedShort>,
+              &SimplifyTest::inPlace<UnsignedInt>,
+              &SimplifyTest::inPlaceTargetIndexCount,
+              &SimplifyTest::inPlaceTargetErrorTooSmall,
+              &SimplifyTest::inPlaceSeam,
+              &SimplifyTest::inPlaceClosed,
+              &SimplifyTest::inPlaceClosedTargetError,
+              &SimplifyTest::inPlaceEmpty,
+              &SimplifyTest::inPlaceErased,
+              &SimplifyTest::inPlaceErasedNonContiguous,
+              &SimplifyTest::inPlaceErasedWrongIndexSize,
+              &SimplifyTest::inPlaceInvalidIndexCount,
+              &SimplifyTest::inPlaceIndexOutOfBounds,
+              &SimplifyTest::inPlaceNegativeTargetError,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataNotTriangles,
+              &SimplifyTest::meshDataNotIndexed,
+              &SimplifyTest::meshDataImplementationSpecificIndexType,
+              &SimplifyTest::meshDataNoPositions,
+              &SimplifyTest::meshDataImplementationSpecificVertexFormat,
+
+              &SimplifyTest::levels,
+              &SimplifyTest::levelsZero,
+              &SimplifyTest::levelsInvalidRatio});
+}
+
+/* A flat 4x4 vertex grid with 18 triangles:
+
+    12--13--14--15
+     | / | / | / |
+     8---9--10--11
+     | / | / | / |
+     4---5---6---7
+     | / | / | / |
+     0---1---2---3 */
+const Vector3 GridPositions[]{
+    {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {2.0f, 1.0f, 0.0f}, {3.0f, 1.0f, 0.0f},
+    {0.0f, 2.0f, 0.0f}, {1.0f, 2.0f, 0.0f}, {2.0f, 2.0f, 0.0f}, {3.0f, 2.0f, 0.0f},
+    {0.0f, 3.0f, 0.0f}, {1.0f, 3.0f, 0.0f}, {2.0f, 3.0f, 0.0f}, {3.0f, 3.0f, 0.0f}
+};
+template<class T> Containers::Array<T> gridIndices() {
+    Containers::Array<T> out{NoInit, 3*3*6};
+    std::size_t i = 0;
+    for(T y = 0; y != 3; ++y) for(T x = 0; x != 3; ++x) {
+        const T a = y*4 + x;
+        for(T index: {a, T(a + 1), T(a + 5), a, T(a + 5), T(a + 4)})
+            out[i++] = index;
+    }
+    return out;
+}
+
+Float signedArea(const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt a, UnsignedInt b, UnsignedInt c) {
+    return Math::cross(positions[b] - positions[a], positions[c] - positions[a]).z()*0.5f;
+}
+
+template<class T> void SimplifyTest::inPlace() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Containers::Array<T> indices = gridIndices<T>();
+
+    /* The grid is flat, so with a zero target error it collapses to just the
+       four corners, keeping the winding */
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::stridedArrayView(indices), GridPositions, 0, 0.0f);
+    CORRADE_COMPARE(out.first(), 6);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<T>({
+        0, 3, 15, 0, 15, 12
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::inPlaceTargetIndexCount() {
+    Containers::Array<UnsignedInt> indices = gridIndices<UnsignedInt>();
+
+    /* The collapsing stops once the target is reached */
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::stridedArrayView(indices), GridPositions, 12);
+    CORRADE_COMPARE(out.first(), 12);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<UnsignedInt>({
+        0, 3, 11, 0, 11, 8, 8, 11, 15, 8, 15, 12
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::inPlaceTargetErrorTooSmall() {
+    /* A grid with the center vertex lifted up */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 1.0f}, {2.0f, 1.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f}, {1.0f, 2.0f, 0.0f}, {2.0f, 2.0f, 0.0f}
+    };
+    UnsignedInt indices[]{
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7
+    };
+
+    /* Every vertex is on a plane of some slanted triangle, so any collapse
+       would deform the surface more than allowed and nothing is done */
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.01f);
+    CORRADE_COMPARE(out.first(), 24);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::inPlaceSeam() {
+    /* A 3x3 vertex grid with the middle column duplicated for the right
+       half, as is the case with for example a texture coordinate seam:
+
+        6---7 11--8
+        | / | | / |
+        3---4 10--5
+        | / | | / |
+        0---1 9---2 */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {2.0f, 1.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f}, {1.0f, 2.0f, 0.0f}, {2.0f, 2.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {1.0f, 2.0f, 0.0f}
+    };
+    UnsignedInt indices[]{
+        0, 1, 4, 0, 4, 3,
+        9, 2, 5, 9, 5, 10,
+        3, 4, 7, 3, 7, 6,
+        10, 5, 8, 10, 8, 11
+    };
+
+    /* The seam vertices can only collapse along the seam and both sides
+       together, the seam ends are on a border and thus locked. The corners
+       that are next to them can't move either, so the result is three
+       triangles on each side, not mixing vertices from the other side. */
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.0f);
+    CORRADE_COMPARE(out.first(), 18);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices).prefix(out.first()), Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 9, 2, 10, 0, 4, 7, 0, 7, 6, 10, 2, 8, 10, 8, 11
+    }), TestSuite::Compare::Container);
+
+    /* The area is preserved and no triangle is flipped */
+    Float area = 0.0f;
+    for(std::size_t i = 0; i != out.first(); i += 3) {
+        const Float triangleArea = signedArea(positions, indices[i + 0], indices[i + 1], indices[i + 2]);
+        CORRADE_COMPARE_AS(triangleArea, 0.0f, TestSuite::Compare::Greater);
+        area += triangleArea;
+    }
+    CORRADE_COMPARE(area, 4.0f);
+}
+
+void SimplifyTest::inPlaceClosed() {
+    Trade::MeshData sphere = Primitives::icosphereSolid(3);
+    CORRADE_COMPARE(sphere.indexCount(), 3840);
+    Containers::StridedArrayView1D<UnsignedInt> indices = sphere.mutableIndices<UnsignedInt>();
+    Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(indices, positions, 3840/4);
+    CORRADE_COMPARE_AS(out.first(), 3840/4, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(out.first(), 3840/5, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out.second(), 0.0f, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out.second(), 0.05f, TestSuite::Compare::Less);
+
+    /* All triangles still face outwards */
+    for(std::size_t i = 0; i != out.first(); i += 3) {
+        const Vector3 a = positions[indices[i + 0]];
+        const Vector3 b = positions[indices[i + 1]];
+        const Vector3 c = positions[indices[i + 2]];
+        CORRADE_COMPARE_AS(Math::dot(Math::cross(b - a, c - a), a + b + c), 0.0f, TestSuite::Compare::Greater);
+    }
+}
+
+void SimplifyTest::inPlaceClosedTargetError() {
+    Trade::MeshData sphere = Primitives::icosphereSolid(3);
+    Containers::StridedArrayView1D<UnsignedInt> indices = sphere.mutableIndices<UnsignedInt>();
+    Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+
+    /* With just the error specified, the mesh gets simplified as much as
+       possible while staying under it */
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(indices, positions, 0, 0.02f);
+    CORRADE_COMPARE_AS(out.first(), 3840, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(out.first(), 0, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out.second(), 0.02f, TestSuite::Compare::LessOrEqual);
+
+    /* A stricter error results in more triangles */
+    Trade::MeshData sphere2 = Primitives::icosphereSolid(3);
+    Containers::Pair<std::size_t, Float> out2 = simplifyInPlace(sphere2.mutableIndices<UnsignedInt>(), sphere2.attribute<Vector3>(Trade::MeshAttribute::Position), 0, 0.01f);
+    CORRADE_COMPARE_AS(out2.first(), out.first(), TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(out2.second(), 0.01f, TestSuite::Compare::LessOrEqual);
+}
+
+void SimplifyTest::inPlaceEmpty() {
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::StridedArrayView1D<UnsignedInt>{}, nullptr, 0);
+    CORRADE_COMPARE(out.first(), 0);
+    CORRADE_COMPARE(out.second(), 0.0f);
+}
+
+void SimplifyTest::inPlaceErased() {
+    Containers::Array<UnsignedShort> indices = gridIndices<UnsignedShort>();
+
+    Containers::Pair<std::size_t, Float> out = simplifyInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), GridPositions, 0, 0.0f);
+    CORRADE_COMPARE(out.first(), 6);
+    CORRADE_COMPARE(out.second(), 0.0f);
+    CORRADE_COMPARE_AS(indices.prefix(out.first()), Containers::arrayView<UnsignedShort>({
+        0, 3, 15, 0, 15, 12
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::inPlaceErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyInPlace(Containers::StridedArrayView2D<char>{indices, {6, 2}, {4, 2}}, GridPositions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): second index view dimension is not contiguous\n");
+}
+
+void SimplifyTest::inPlaceErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyInPlace(Containers::StridedArrayView2D<char>{indices, {6, 3}}.every(2), GridPositions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void SimplifyTest::inPlaceInvalidIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[5]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyInPlace(Containers::stridedArrayView(indices), GridPositions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index count not divisible by 3\n");
+}
+
+void SimplifyTest::inPlaceIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 4, 0, 16, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyInPlace(Containers::stridedArrayView(indices), GridPositions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index 16 out of bounds for 16 elements\n");
+}
+
+void SimplifyTest::inPlaceNegativeTargetError() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 4};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyInPlace(Containers::stridedArrayView(indices), GridPositions, 0, -0.5f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): expected a non-negative target error but got -0.5\n");
+}
+
+void SimplifyTest::meshData() {
+    const struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertices[]{
+        #define _c(x, y) {{x, y, 0.0f}, {x/3.0f, y/3.0f}}
+        _c(0.0f, 0.0f), _c(1.0f, 0.0f), _c(2.0f, 0.0f), _c(3.0f, 0.0f),
+        _c(0.0f, 1.0f), _c(1.0f, 1.0f), _c(2.0f, 1.0f), _c(3.0f, 1.0f),
+        _c(0.0f, 2.0f), _c(1.0f, 2.0f), _c(2.0f, 2.0f), _c(3.0f, 2.0f),
+        _c(0.0f, 3.0f), _c(1.0f, 3.0f), _c(2.0f, 3.0f), _c(3.0f, 3.0f),
+        /* Not referenced by the index buffer, gets dropped */
+        _c(7.0f, 7.0f)
+        #undef _c
+    };
+    const Containers::Array<UnsignedShort> indices = gridIndices<UnsignedShort>();
+    const auto view = Containers::stridedArrayView(vertices);
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                view.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                view.slice(&Vertex::textureCoordinates)}
+        }};
+
+    Trade::MeshData out = simplify(mesh, 0, 0.0f);
+    CORRADE_COMPARE(out.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(out.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(out.indices<UnsignedShort>(), Containers::arrayView<UnsignedShort>({
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+
+    /* Only the four corners stay, in the order of first use */
+    CORRADE_COMPARE(out.vertexCount(), 4);
+    CORRADE_COMPARE(out.attributeCount(), 2);
+    CORRADE_COMPARE_AS(out.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f},
+        {3.0f, 3.0f, 0.0f},
+        {0.0f, 3.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates), Containers::arrayView<Vector2>({
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* The original data should stay untouched */
+    CORRADE_COMPARE(indices[2], 5);
+}
+
+void SimplifyTest::meshDataNotTriangles() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::TriangleStrip, 0};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplify(mesh, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): expected MeshPrimitive::Triangles but got MeshPrimitive::TriangleStrip\n");
+}
+
+void SimplifyTest::meshDataNotIndexed() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplify(mesh, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): mesh data not indexed\n");
+}
+
+void SimplifyTest::meshDataImplementationSpecificIndexType() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        nullptr, Trade::MeshIndexData{meshIndexTypeWrap(0xcaca), Containers::StridedArrayView1D<const void>{}},
+        nullptr, {}, 3};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplify(mesh, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): mesh has an implementation-specific index type 0xcaca\n");
+}
+
+void SimplifyTest::meshDataNoPositions() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2};
+    const Vector3 normals[3]{};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, normals, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                Containers::arrayView(normals)}
+        }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplify(mesh, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): the mesh has no positions\n");
+}
+
+void SimplifyTest::meshDataImplementationSpecificVertexFormat() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2};
+    const Vector3 positions[3]{};
+    const Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                vertexFormatWrap(0xcaca), nullptr}
+        }};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplify(mesh, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): attribute 1 has an implementation-specific format 0xcaca\n");
+}
+
+void SimplifyTest::levels() {
+    const Trade::MeshData sphere = Primitives::icosphereSolid(3);
+
+    Containers::Array<Trade::MeshData> out = simplifyLevels(sphere, 4, 0.25f);
+    CORRADE_COMPARE(out.size(), 4);
+
+    /* The first level is the original */
+    CORRADE_COMPARE(out[0].indexCount(), sphere.indexCount());
+    CORRADE_COMPARE(out[0].vertexCount(), sphere.vertexCount());
+    CORRADE_COMPARE(out[0].attributeCount(), sphere.attributeCount());
+
+    /* Each next level is at most a quarter of the previous, but not
+       degenerated to nothing */
+    for(std::size_t i = 1; i != out.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(out[i].primitive(), MeshPrimitive::Triangles);
+        CORRADE_COMPARE(out[i].indexType(), MeshIndexType::UnsignedInt);
+        CORRADE_COMPARE(out[i].attributeCount(), sphere.attributeCount());
+        CORRADE_COMPARE_AS(out[i].indexCount(), out[i - 1].indexCount()/4, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(out[i].indexCount(), 0, TestSuite::Compare::Greater);
+        CORRADE_COMPARE_AS(out[i].vertexCount(), out[i - 1].vertexCount(), TestSuite::Compare::Less);
+    }
+
+    /* With a target error the chain ends with the first level that couldn't
+       reach the target index count */
+    Containers::Array<Trade::MeshData> outError = simplifyLevels(sphere, 10, 0.5f, 0.01f);
+    CORRADE_COMPARE_AS(outError.size(), 10, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(outError.size(), 1, TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(outError.back().indexCount(), outError[outError.size() - 2].indexCount()/2, TestSuite::Compare::Greater);
+}
+
+void SimplifyTest::levelsZero() {
+    const Trade::MeshData sphere = Primitives::icosphereSolid(1);
+    CORRADE_COMPARE(simplifyLevels(sphere, 0).size(), 0);
+}
+
+void SimplifyTest::levelsInvalidRatio() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const Trade::MeshData sphere = Primitives::icosphereSolid(0);
+
+    std::stringstream out;
+    Error redirectError{&out};
+    simplifyLevels(sphere, 3, 1.0f);
+    simplifyLevels(sphere, 3, 0.0f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyLevels(): expected ratio to be between 0 and 1 but got 1\n"
+        "MeshTools::simplifyLevels(): expected ratio to be between 0 and 1 but got 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
@@ -0,0 +1,554 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm> /* std::shuffle(), std::sort() */
+#include <random>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/VertexCache.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct VertexCacheTest: TestSuite::Tester {
+    explicit VertexCacheTest();
+
+    template<class T> void optimize();
+    void optimizeGrid();
+    void optimizeGridFifoScoring();
+    void optimizeDegenerate();
+    void optimizeEmpty();
+    void optimizeErased();
+    void optimizeErasedNonContiguous();
+    void optimizeErasedWrongIndexSize();
+    void optimizeWrongIndexCount();
+    void optimizeIndexOutOfBounds();
+    void optimizeCacheTooSmall();
+
+    template<class T> void statistics();
+    void statisticsEmpty();
+    void statisticsErased();
+    void statisticsErasedNonContiguous();
+    void statisticsErasedWrongIndexSize();
+    void statisticsWrongIndexCount();
+    void statisticsIndexOutOfBounds();
+    void statisticsZeroCacheSize();
+
+    void benchmarkOptimize();
+    void benchmarkStatistics();
+};
+
+/* Same mesh as in TipsifyTest
+
+ 0 ----- 1 ----- 2 ----- 3
+  \ 0  /  \ 7  /  \ 2  /  \
+   \  / 11 \  / 13 \  / 12 \
+    4 ----- 5 ----- 6 ----- 7
+   /  \ 3  /  \ 8  /  \ 5  /
+  / 14 \  / 9  \  / 15 \  /
+ 8 ----- 9 ---- 10 ---- 11          18 ---- 17
+  \ 4  /  \ 1  /  \ 17 /  \           \ 18  /
+   \  / 16 \  / 10 \  / 6  \           \  /
+    12 ---- 13 ---- 14 ---- 15          16
+
+*/
+
+constexpr UnsignedInt Indices[]{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+};
+
+constexpr std::size_t VertexCount = 19;
+
+constexpr UnsignedInt OptimizedFifo[]{
+    16, 17, 18, /* the isolated triangle has the highest valence score */
+    4, 1, 0,
+    1, 4, 5,
+    2, 1, 5,
+    6, 2, 5,
+    6, 3, 2,
+    7, 3, 6,
+    11, 7, 6,
+    14, 15, 11, /* 6 isn't penalized for being in the last triangle */
+    14, 11, 10,
+    6, 10, 11,
+    13, 14, 10,
+    10, 6, 5,
+    10, 5, 9,
+    10, 9, 13,
+    13, 9, 12,
+    12, 9, 8,
+    9, 4, 8,
+    9, 5, 4
+};
+
+constexpr UnsignedInt OptimizedLru[]{
+    16, 17, 18,
+    4, 1, 0,
+    1, 4, 5,
+    2, 1, 5,
+    9, 5, 4, /* diverges from the FIFO variant here */
+    9, 4, 8,
+    12, 9, 8,
+    13, 9, 12,
+    10, 9, 13,
+    10, 5, 9,
+    13, 14, 10,
+    14, 15, 11,
+    14, 11, 10,
+    6, 10, 11,
+    11, 7, 6,
+    10, 6, 5,
+    6, 2, 5,
+    6, 3, 2,
+    7, 3, 6
+};
+
+const struct {
+    const char* name;
+    VertexCacheModel model;
+    Containers::ArrayView<const UnsignedInt> expected;
+    Float expectedFifoAcmr, expectedLruAcmr;
+} OptimizeData[]{
+    {"FIFO", VertexCacheModel::Fifo, OptimizedFifo, 22.0f/19.0f, 22.0f/19.0f},
+    {"LRU", VertexCacheModel::Lru, OptimizedLru, 23.0f/19.0f, 22.0f/19.0f},
+};
+
+const struct {
+    const char* name;
+    VertexCacheModel model;
+    Float expectedAcmr, expectedAtvr;
+} StatisticsData[]{
+    /* Vertex 0 gets evicted by 3 and 4 in the FIFO case, while in the LRU
+       case the hit in the second triangle moves it to the front */
+    {"FIFO", VertexCacheModel::Fifo, 8.0f/3.0f, 8.0f/7.0f},
+    {"LRU", VertexCacheModel::Lru, 7.0f/3.0f, 1.0f},
+};
+
+VertexCacheTest::VertexCacheTest() {
+    addInstancedTests<VertexCacheTest>({
+        &VertexCacheTest::optimize<UnsignedByte>,
+        &VertexCacheTest::optimize<UnsignedShort>,
+        &VertexCacheTest::optimize<UnsignedInt>,
+        &VertexCacheTest::optimizeGrid},
+        Containers::arraySize(OptimizeData));
+
+    addTests({&VertexCacheTest::optimizeGridFifoScoring,
+              &VertexCacheTest::optimizeDegenerate,
+              &VertexCacheTest::optimizeEmpty,
+              &VertexCacheTest::optimizeErased,
+              &VertexCacheTest::optimizeErasedNonContiguous,
+              &VertexCacheTest::optimizeErasedWrongIndexSize,
+              &VertexCacheTest::optimizeWrongIndexCount,
+              &VertexCacheTest::optimizeIndexOutOfBounds,
+              &VertexCacheTest::optimizeCacheTooSmall});
+
+    addInstancedTests<VertexCacheTest>({
+        &VertexCacheTest::statistics<UnsignedByte>,
+        &VertexCacheTest::statistics<UnsignedShort>,
+        &VertexCacheTest::statistics<UnsignedInt>},
+        Containers::arraySize(StatisticsData));
+
+    addTests({&VertexCacheTest::statisticsEmpty,
+              &VertexCacheTest::statisticsErased,
+              &VertexCacheTest::statisticsErasedNonContiguous,
+              &VertexCacheTest::statisticsErasedWrongIndexSize,
+              &VertexCacheTest::statisticsWrongIndexCount,
+              &VertexCacheTest::statisticsIndexOutOfBounds,
+              &VertexCacheTest::statisticsZeroCacheSize});
+
+    addBenchmarks({&VertexCacheTest::benchmarkOptimize,
+                   &VertexCacheTest::benchmarkStatistics}, 10);
+}
+
+/* A shuffled grid of width*height quads, each split into two triangles */
+Containers::Array<UnsignedInt> shuffledGrid(const UnsignedInt width, const UnsignedInt height) {
+    Containers::Array<Vector3ui> triangles{NoInit, width*height*2};
+    for(UnsignedInt y = 0; y != height; ++y) {
+        for(UnsignedInt x = 0; x != width; ++x) {
+            const UnsignedInt a = y*(width + 1) + x;
+            const UnsignedInt c = a + width + 1;
+            triangles[(y*width + x)*2 + 0] = {a, a + 1, c + 1};
+            triangles[(y*width + x)*2 + 1] = {a, c + 1, c};
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::minstd_rand{7});
+
+    Containers::Array<UnsignedInt> indices{NoInit, triangles.size()*3};
+    Utility::copy(Containers::arrayCast<const UnsignedInt>(triangles), indices);
+    return indices;
+}
+
+/* Triangles rotated so the smallest index is first, preserving the winding,
+   and sorted, to check that the output is a permutation of the input */
+Containers::Array<Vector3ui> sortedTriangles(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    Containers::Array<Vector3ui> out{NoInit, indices.size()/3};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        Vector3ui triangle{indices[i*3 + 0], indices[i*3 + 1], indices[i*3 + 2]};
+        while(triangle.x() != triangle.min())
+            triangle = {triangle.y(), triangle.z(), triangle.x()};
+        out[i] = triangle;
+    }
+    std::sort(out.begin(), out.end(), [](const Vector3ui& a, const Vector3ui& b) {
+        return std::lexicographical_compare(a.data(), a.data() + 3, b.data(), b.data() + 3);
+    });
+    return out;
+}
+
+template<class T> void VertexCacheTest::optimize() {
+    auto&& data = OptimizeData[testCaseInstanceId()];
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    T indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+
+    /* Most vertices are cache misses in the original order */
+    CORRADE_COMPARE(vertexCacheStatistics(Containers::arrayView(indices), VertexCount, 6).first(), 45.0f/19.0f);
+
+    optimizeVertexCacheInPlace(indices, VertexCount, 6, data.model);
+
+    Containers::Array<UnsignedInt> actual{NoInit, Containers::arraySize(indices)};
+    for(std::size_t i = 0; i != actual.size(); ++i)
+        actual[i] = indices[i];
+    CORRADE_COMPARE_AS(actual, data.expected,
+        TestSuite::Compare::Container);
+
+    /* The mesh has the same count of vertices and triangles, so ACMR and ATVR
+       are the same */
+    Containers::Pair<Float, Float> fifo = vertexCacheStatistics(Containers::arrayView(indices), VertexCount, 6, VertexCacheModel::Fifo);
+    CORRADE_COMPARE(fifo.first(), data.expectedFifoAcmr);
+    CORRADE_COMPARE(fifo.second(), data.expectedFifoAcmr);
+    Containers::Pair<Float, Float> lru = vertexCacheStatistics(Containers::arrayView(indices), VertexCount, 6, VertexCacheModel::Lru);
+    CORRADE_COMPARE(lru.first(), data.expectedLruAcmr);
+    CORRADE_COMPARE(lru.second(), data.expectedLruAcmr);
+}
+
+void VertexCacheTest::optimizeGrid() {
+    auto&& data = OptimizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<UnsignedInt> indices = shuffledGrid(50, 50);
+    Containers::Array<Vector3ui> expected = sortedTriangles(indices);
+
+    /* Shuffled triangles, so almost every vertex is a cache miss */
+    CORRADE_COMPARE_AS(vertexCacheStatistics(indices, 51*51, 32).first(), 2.9f,
+        TestSuite::Compare::Greater);
+
+    optimizeVertexCacheInPlace(indices, 51*51, 32, data.model);
+
+    /* The output should contain the same triangles with the same winding */
+    CORRADE_COMPARE_AS(sortedTriangles(indices), expected,
+        TestSuite::Compare::Container);
+
+    /* For a 32-entry cache the theoretical optimum is around 0.5 */
+    Containers::Pair<Float, Float> statistics = vertexCacheStatistics(indices, 51*51, 32);
+    CORRADE_COMPARE_AS(statistics.first(), 0.75f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(statistics.second(), 1.5f,
+        TestSuite::Compare::Less);
+}
+
+void VertexCacheTest::optimizeGridFifoScoring() {
+    Containers::Array<UnsignedInt> fifo = shuffledGrid(50, 50);
+    Containers::Array<UnsignedInt> lru{NoInit, fifo.size()};
+    Utility::copy(fifo, lru);
+
+    optimizeVertexCacheInPlace(fifo, 51*51, 32, VertexCacheModel::Fifo);
+    optimizeVertexCacheInPlace(lru, 51*51, 32, VertexCacheModel::Lru);
+
+    /* The FIFO scoring doesn't penalize the front of the cache as it doesn't
+       contain the last triangle, which should result in a noticeably better
+       ACMR than with the LRU scoring if the cache size matches */
+    const Float fifoAcmr = vertexCacheStatistics(fifo, 51*51, 32, VertexCacheModel::Fifo).first();
+    const Float lruAcmr = vertexCacheStatistics(lru, 51*51, 32, VertexCacheModel::Fifo).first();
+    CORRADE_COMPARE_AS(fifoAcmr, 0.625f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(fifoAcmr, lruAcmr,
+        TestSuite::Compare::Less);
+}
+
+void VertexCacheTest::optimizeDegenerate() {
+    /* The degenerate triangle references the same vertex three times, which
+       shouldn't cause it to be emitted multiple times or the vertex being in
+       the cache multiple times */
+    UnsignedInt indices[]{
+        0, 1, 2,
+        3, 3, 3,
+        2, 1, 3,
+        1, 1, 4
+    };
+    optimizeVertexCacheInPlace(indices, 5, 4);
+
+    CORRADE_COMPARE_AS(sortedTriangles(indices), sortedTriangles(Containers::arrayView<UnsignedInt>({
+        0, 1, 2,
+        3, 3, 3,
+        2, 1, 3,
+        1, 1, 4
+    })), TestSuite::Compare::Container);
+}
+
+void VertexCacheTest::optimizeEmpty() {
+    optimizeVertexCacheInPlace(Containers::ArrayView<UnsignedInt>{}, 0);
+
+    /* Shouldn't crash or assert */
+    CORRADE_VERIFY(true);
+}
+
+void VertexCacheTest::optimizeErased() {
+    UnsignedShort indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+
+    optimizeVertexCacheInPlace(Containers::arrayCast<2, char>(Containers::stridedArrayView(indices)), VertexCount, 6, VertexCacheModel::Lru);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<UnsignedShort>({
+        16, 17, 18,
+        4, 1, 0,
+        1, 4, 5,
+        2, 1, 5,
+        9, 5, 4,
+        9, 4, 8,
+        12, 9, 8,
+        13, 9, 12,
+        10, 9, 13,
+        10, 5, 9,
+        13, 14, 10,
+        14, 15, 11,
+        14, 11, 10,
+        6, 10, 11,
+        11, 7, 6,
+        10, 6, 5,
+        6, 2, 5,
+        6, 3, 2,
+        7, 3, 6
+    }), TestSuite::Compare::Container);
+}
+
+void VertexCacheTest::optimizeErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(Containers::StridedArrayView2D<char>{indices, {6, 2}, {4, 2}}, 1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): second index view dimension is not contiguous\n");
+}
+
+void VertexCacheTest::optimizeErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(Containers::StridedArrayView2D<char>{indices, {6, 3}}.every(2), 1);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void VertexCacheTest::optimizeWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedByte indices[7]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(indices, 1);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3\n");
+}
+
+void VertexCacheTest::optimizeIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedShort indices[]{0, 1, 2, 3, 2, 1};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(indices, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): index 3 out of bounds for 3 vertices\n");
+}
+
+void VertexCacheTest::optimizeCacheTooSmall() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    optimizeVertexCacheInPlace(indices, 3, 3);
+    CORRADE_COMPARE(out.str(), "MeshTools::optimizeVertexCacheInPlace(): expected cache size to be at least 4 but got 3\n");
+}
+
+template<class T> void VertexCacheTest::statistics() {
+    auto&& data = StatisticsData[testCaseInstanceId()];
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    const T indices[]{
+        0, 1, 2,
+        0, 3, 4,
+        0, 5, 6
+    };
+
+    /* Vertex 7 is not referenced, so it's not counted in ATVR */
+    Containers::Pair<Float, Float> out = vertexCacheStatistics(Containers::arrayView(indices), 8, 3, data.model);
+    CORRADE_COMPARE(out.first(), data.expectedAcmr);
+    CORRADE_COMPARE(out.second(), data.expectedAtvr);
+}
+
+void VertexCacheTest::statisticsEmpty() {
+    Containers::Pair<Float, Float> out = vertexCacheStatistics(Containers::ArrayView<const UnsignedInt>{}, 5, 16);
+    CORRADE_COMPARE(out.first(), 0.0f);
+    CORRADE_COMPARE(out.second(), 0.0f);
+}
+
+void VertexCacheTest::statisticsErased() {
+    const UnsignedByte indices[]{
+        0, 1, 2,
+        0, 3, 4,
+        0, 5, 6
+    };
+
+    Containers::Pair<Float, Float> out = vertexCacheStatistics(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), 7, 3, VertexCacheModel::Lru);
+    CORRADE_COMPARE(out.first(), 7.0f/3.0f);
+    CORRADE_COMPARE(out.second(), 1.0f);
+}
+
+void VertexCacheTest::statisticsErasedNonContiguous() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    vertexCacheStatistics(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, 1, 16);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::vertexCacheStatistics(): second index view dimension is not contiguous\n");
+}
+
+void VertexCacheTest::statisticsErasedWrongIndexSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    vertexCacheStatistics(Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), 1, 16);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::vertexCacheStatistics(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void VertexCacheTest::statisticsWrongIndexCount() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedByte indices[7]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    vertexCacheStatistics(indices, 1, 16);
+    CORRADE_COMPARE(out.str(), "MeshTools::vertexCacheStatistics(): index count not divisible by 3\n");
+}
+
+void VertexCacheTest::statisticsIndexOutOfBounds() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedShort indices[]{0, 1, 2, 3, 2, 1};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    vertexCacheStatistics(indices, 3, 16, VertexCacheModel::Fifo);
+    vertexCacheStatistics(indices, 3, 16, VertexCacheModel::Lru);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::vertexCacheStatistics(): index 3 out of bounds for 3 vertices\n"
+        "MeshTools::vertexCacheStatistics(): index 3 out of bounds for 3 vertices\n");
+}
+
+void VertexCacheTest::statisticsZeroCacheSize() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    vertexCacheStatistics(indices, 3, 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::vertexCacheStatistics(): expected a non-zero cache size\n");
+}
+
+void VertexCacheTest::benchmarkOptimize() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid(200, 200);
+
+    CORRADE_BENCHMARK(1)
+        optimizeVertexCacheInPlace(indices, 201*201);
+
+    CORRADE_COMPARE_AS(vertexCacheStatistics(indices, 201*201, 32).first(), 0.75f,
+        TestSuite::Compare::Less);
+}
+
+void VertexCacheTest::benchmarkStatistics() {
+    Containers::Array<UnsignedInt> indices = shuffledGrid(200, 200);
+
+    Containers::Pair<Float, Float> statistics;
+    CORRADE_BENCHMARK(10)
+        statistics = vertexCacheStatistics(indices, 201*201, 32);
+
+    CORRADE_COMPARE_AS(statistics.first(), 2.9f,
+        TestSuite::Compare::Greater);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::VertexCacheTest)
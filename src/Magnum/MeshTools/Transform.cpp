@@ -26,7 +26,9 @@
 #include "Transform.h"
 
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/Math/MatrixBatch.h"
 #include "Magnum/MeshTools/FilterAttributes.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/Trade/MeshData.h"
@@ -100,9 +102,8 @@ void transform2DInPlace(Trade::MeshData& data, const Matrix3& transformation, co
     CORRADE_ASSERT(data.attributeFormat(*positionAttributeId) == VertexFormat::Vector2,
         "MeshTools::transform2DInPlace(): expected" << VertexFormat::Vector2 << "positions but got" << data.attributeFormat(*positionAttributeId), );
 
-    /** @todo this needs a proper batch implementation */
-    for(Vector2& position: data.mutableAttribute<Vector2>(*positionAttributeId))
-        position = transformation.transformPoint(position);
+    const Containers::StridedArrayView1D<Vector2> positions = data.mutableAttribute<Vector2>(*positionAttributeId);
+    Math::transformPointsInto(transformation, positions, positions);
 }
 
 Trade::MeshData transform3D(const Trade::MeshData& data, const Matrix4& transformation, const UnsignedInt id, const InterleaveFlags flags) {
@@ -234,9 +235,8 @@ void transform3DInPlace(Trade::MeshData& data, const Matrix4& transformation, co
     CORRADE_ASSERT(!normalAttributeId || data.attributeFormat(*normalAttributeId) == VertexFormat::Vector3,
         "MeshTools::transform3DInPlace(): expected" << VertexFormat::Vector3 << "normals but got" << data.attributeFormat(*normalAttributeId), );
 
-    /** @todo this needs a proper batch implementation */
-    for(Vector3& position: data.mutableAttribute<Vector3>(*positionAttributeId))
-        position = transformation.transformPoint(position);
+    const Containers::StridedArrayView1D<Vector3> positions = data.mutableAttribute<Vector3>(*positionAttributeId);
+    Math::transformPointsInto(transformation, positions, positions);
 
     /* If no other attributes are present, nothing to do */
     if(!tangentAttributeId && !bitangentAttributeId && !normalAttributeId)
@@ -244,22 +244,22 @@ void transform3DInPlace(Trade::MeshData& data, const Matrix4& transformation, co
 
     const Matrix3x3 normalMatrix = transformation.normalMatrix();
     if(tangentAttributeId) {
-    /** @todo this needs a proper batch implementation */
-        if(tangentAttributeFormat == VertexFormat::Vector3)
-            for(Vector3& tangent: data.mutableAttribute<Vector3>(*tangentAttributeId))
-                tangent = normalMatrix*tangent;
-        else for(Vector4& tangent: data.mutableAttribute<Vector4>(*tangentAttributeId)) {
-            tangent.xyz() = normalMatrix*tangent.xyz();
-            /** @todo figure out the fourth component, probably has to get
-                flipped when the scale changes handedness? */
-        }
+        const Containers::StridedArrayView1D<Vector3> tangents =
+            tangentAttributeFormat == VertexFormat::Vector3 ?
+                data.mutableAttribute<Vector3>(*tangentAttributeId) :
+                data.mutableAttribute<Vector4>(*tangentAttributeId).slice(&Vector4::xyz);
+        /** @todo figure out the fourth component, probably has to get
+            flipped when the scale changes handedness? */
+        Math::transformVectorsInto(normalMatrix, tangents, tangents);
+    }
+    if(bitangentAttributeId) {
+        const Containers::StridedArrayView1D<Vector3> bitangents = data.mutableAttribute<Vector3>(*bitangentAttributeId);
+        Math::transformVectorsInto(normalMatrix, bitangents, bitangents);
+    }
+    if(normalAttributeId) {
+        const Containers::StridedArrayView1D<Vector3> normals = data.mutableAttribute<Vector3>(*normalAttributeId);
+        Math::transformVectorsInto(normalMatrix, normals, normals);
     }
-    /** @todo this needs a proper batch implementation */
-    if(bitangentAttributeId) for(Vector3& bitangent: data.mutableAttribute<Vector3>(*bitangentAttributeId))
-        bitangent = normalMatrix*bitangent;
-    /** @todo this needs a proper batch implementation */
-    if(normalAttributeId) for(Vector3& normal: data.mutableAttribute<Vector3>(*normalAttributeId))
-        normal = normalMatrix*normal;
 }
 
 Trade::MeshData transformTextureCoordinates2D(const Trade::MeshData& data, const Matrix3& transformation, const UnsignedInt id, const InterleaveFlags flags) {
@@ -326,9 +326,8 @@ void transformTextureCoordinates2DInPlace(Trade::MeshData& data, const Matrix3&
     CORRADE_ASSERT(data.attributeFormat(*textureCoordinateAttributeId) == VertexFormat::Vector2,
         "MeshTools::transformTextureCoordinates2DInPlace(): expected" << VertexFormat::Vector2 << "texture coordinates but got" << data.attributeFormat(*textureCoordinateAttributeId), );
 
-    /** @todo this needs a proper batch implementation */
-    for(Vector2& position: data.mutableAttribute<Vector2>(*textureCoordinateAttributeId))
-        position = transformation.transformPoint(position);
+    const Containers::StridedArrayView1D<Vector2> textureCoordinates = data.mutableAttribute<Vector2>(*textureCoordinateAttributeId);
+    Math::transformPointsInto(transformation, textureCoordinates, textureCoordinates);
 }
 
 }}
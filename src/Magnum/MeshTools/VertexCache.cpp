@@ -0,0 +1,354 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexCache.h"
+
+#include <cmath>
+#include <Corrade/Containers/BitArray.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Scoring parameters, values taken from the paper */
+constexpr Float LastTriangleScore = 0.75f;
+/* A hit in a FIFO cache doesn't change the eviction order, so all vertices in
+   it are scored the same */
+constexpr Float FifoCacheScore = 0.75f;
+constexpr Float CacheDecayPower = 1.5f;
+constexpr Float ValenceBoostScale = 2.0f;
+constexpr Float ValenceBoostPower = 0.5f;
+/* Vertices with more live triangles than this get the score calculated
+   directly instead of looking it up in a table */
+constexpr UnsignedInt ValenceScoreTableSize = 32;
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3", );
+    CORRADE_ASSERT(cacheSize >= 4,
+        "MeshTools::optimizeVertexCacheInPlace(): expected cache size to be at least 4 but got" << cacheSize, );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexCacheInPlace(): index" << index << "out of bounds for" << vertexCount << "vertices", );
+    #endif
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count.
+       The first liveTriangleCount[i] items starting at neighborOffset[i] are
+       the triangles that weren't emitted yet, emitted triangles get swapped
+       to the end of the range. */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Score tables. In a LRU cache the first three cache positions are the
+       vertices of the last emitted triangle, which get a fixed lower score to
+       avoid picking a triangle that would share just a single edge and lead
+       to strips. In a FIFO cache the front contains only the vertices that
+       were misses, so the position says nothing about the last triangle, and
+       a hit doesn't make the vertex stay in the cache any longer, so there's
+       no reason to prefer recently added vertices either. */
+    Containers::Array<Float> cacheScores{NoInit, cacheSize};
+    for(std::size_t i = 0; i != cacheSize; ++i) {
+        if(model == VertexCacheModel::Fifo)
+            cacheScores[i] = FifoCacheScore;
+        else cacheScores[i] = i < 3 ? LastTriangleScore :
+            std::pow(1.0f - Float(i - 3)/Float(cacheSize - 3), CacheDecayPower);
+    }
+    Float valenceScores[ValenceScoreTableSize];
+    valenceScores[0] = 0.0f;
+    for(UnsignedInt i = 1; i != ValenceScoreTableSize; ++i)
+        valenceScores[i] = ValenceBoostScale*std::pow(Float(i), -ValenceBoostPower);
+
+    /* Per-vertex cache position (or ~UnsignedInt{} if not in the cache) and
+       score */
+    Containers::Array<UnsignedInt> cachePosition{DirectInit, vertexCount, ~UnsignedInt{}};
+    Containers::Array<Float> vertexScore{NoInit, vertexCount};
+    const auto calculateVertexScore = [&](const UnsignedInt v) {
+        const UnsignedInt liveCount = liveTriangleCount[v];
+        /* Vertices with no live triangles don't contribute to anything */
+        if(!liveCount) return -1.0f;
+
+        return (cachePosition[v] < cacheSize ? cacheScores[cachePosition[v]] : 0.0f) +
+            (liveCount < ValenceScoreTableSize ? valenceScores[liveCount] :
+                ValenceBoostScale*std::pow(Float(liveCount), -ValenceBoostPower));
+    };
+    for(UnsignedInt v = 0; v != vertexCount; ++v)
+        vertexScore[v] = calculateVertexScore(v);
+
+    /* Per-triangle score and emitted flag, pick the best triangle to start
+       with */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<Float> triangleScore{NoInit, triangleCount};
+    Containers::BitArray emitted{ValueInit, triangleCount};
+    UnsignedInt bestTriangle = ~UnsignedInt{};
+    Float bestScore = -1.0f;
+    for(std::size_t t = 0; t != triangleCount; ++t) {
+        triangleScore[t] =
+            vertexScore[indices[t*3 + 0]] +
+            vertexScore[indices[t*3 + 1]] +
+            vertexScore[indices[t*3 + 2]];
+        if(triangleScore[t] > bestScore) {
+            bestScore = triangleScore[t];
+            bestTriangle = t;
+        }
+    }
+
+    /* Simulated cache and a scratch space for its updated state. The new
+       state can temporarily contain up to three more vertices, which then
+       get evicted. */
+    Containers::Array<UnsignedInt> cache{NoInit, cacheSize};
+    Containers::Array<UnsignedInt> newCache{NoInit, cacheSize + 3};
+    std::size_t cacheCount = 0;
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+
+    /* Cursor for finding a next triangle if nothing in the cache has any live
+       triangles */
+    std::size_t nextTriangle = 0;
+
+    while(outputIndex != indices.size()) {
+        /* If there's no candidate, take the first not yet emitted triangle.
+           The cursor only goes forward, so this is linear overall. */
+        if(bestTriangle == ~UnsignedInt{}) {
+            while(emitted[nextTriangle]) ++nextTriangle;
+            bestTriangle = nextTriangle;
+        }
+
+        /* Emit the triangle and remove it from live triangle lists of its
+           vertices */
+        const UnsignedInt triangle = bestTriangle;
+        emitted.set(triangle);
+        for(UnsignedInt vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[triangle*3 + vi];
+            outputIndices[outputIndex++] = v;
+
+            UnsignedInt* const live = neighbors.data() + neighborOffset[v];
+            const UnsignedInt last = --liveTriangleCount[v];
+            for(UnsignedInt ti = 0; ti != last; ++ti) if(live[ti] == triangle) {
+                live[ti] = live[last];
+                live[last] = triangle;
+                break;
+            }
+        }
+
+        /* Put the triangle vertices into the cache. For an LRU cache they go
+           to the front and the rest is shifted, for a FIFO cache only the
+           vertices that weren't in the cache yet are added at the front. */
+        std::size_t newCacheCount = 0;
+        for(UnsignedInt vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[triangle*3 + vi];
+            if(model == VertexCacheModel::Fifo && cachePosition[v] < cacheSize)
+                continue;
+            /* Degenerate triangles can have the same vertex multiple times */
+            bool duplicate = false;
+            for(std::size_t i = 0; i != newCacheCount; ++i) if(newCache[i] == v) {
+                duplicate = true;
+                break;
+            }
+            if(!duplicate) newCache[newCacheCount++] = v;
+        }
+        const std::size_t addedCount = newCacheCount;
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            const UnsignedInt v = cache[i];
+            if(model == VertexCacheModel::Lru) {
+                bool added = false;
+                for(std::size_t j = 0; j != addedCount; ++j) if(newCache[j] == v) {
+                    added = true;
+                    break;
+                }
+                if(added) continue;
+            }
+            newCache[newCacheCount++] = v;
+        }
+
+        /* Update cache positions. Vertices that fell out of the cache get
+           their position reset. */
+        for(std::size_t i = cacheSize; i < newCacheCount; ++i)
+            cachePosition[newCache[i]] = ~UnsignedInt{};
+        cacheCount = Math::min(newCacheCount, cacheSize);
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            cache[i] = newCache[i];
+            cachePosition[newCache[i]] = i;
+        }
+
+        /* Update scores of all vertices in the cache as well as the ones that
+           were just evicted, and propagate the difference to their live
+           triangles. All vertices of the emitted triangle are in the updated
+           cache state as well, so it's enough to go through just that. */
+        for(std::size_t i = 0; i != newCacheCount; ++i) {
+            const UnsignedInt v = newCache[i];
+            const Float score = calculateVertexScore(v);
+            const Float difference = score - vertexScore[v];
+            vertexScore[v] = score;
+            if(difference == 0.0f) continue;
+
+            const UnsignedInt* const live = neighbors.data() + neighborOffset[v];
+            for(UnsignedInt ti = 0, tiEnd = liveTriangleCount[v]; ti != tiEnd; ++ti)
+                triangleScore[live[ti]] += difference;
+        }
+
+        /* Pick the best triangle out of the ones referenced by the cache */
+        bestTriangle = ~UnsignedInt{};
+        bestScore = -1.0f;
+        for(std::size_t i = 0; i != cacheCount; ++i) {
+            const UnsignedInt v = cache[i];
+            const UnsignedInt* const live = neighbors.data() + neighborOffset[v];
+            for(UnsignedInt ti = 0, tiEnd = liveTriangleCount[v]; ti != tiEnd; ++ti) {
+                const UnsignedInt t = live[ti];
+                if(triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    /* Copy the optimized index buffer back */
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> Containers::Pair<Float, Float> vertexCacheStatisticsImplementation(const Containers::StridedArrayView1D<const T>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::vertexCacheStatistics(): index count not divisible by 3", {});
+    CORRADE_ASSERT(cacheSize,
+        "MeshTools::vertexCacheStatistics(): expected a non-zero cache size", {});
+
+    if(indices.isEmpty()) return {0.0f, 0.0f};
+
+    Containers::BitArray referenced{ValueInit, vertexCount};
+    std::size_t referencedCount = 0;
+    std::size_t missCount = 0;
+
+    /* A FIFO cache can be simulated with just per-vertex timestamps, with
+       the same trick as in tipsifyInPlace() -- a vertex is in the cache if
+       there was less than cacheSize misses since it was put there. The
+       timestamps start at zero, so the time starts at cacheSize + 1 to
+       make everything initially a miss. */
+    if(model == VertexCacheModel::Fifo) {
+        Containers::Array<std::size_t> timestamp{ValueInit, vertexCount};
+        std::size_t time = cacheSize + 1;
+        for(const T index: indices) {
+            CORRADE_ASSERT(index < vertexCount,
+                "MeshTools::vertexCacheStatistics(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+            if(!referenced[index]) {
+                referenced.set(index);
+                ++referencedCount;
+            }
+            if(time - timestamp[index] > cacheSize) {
+                timestamp[index] = time++;
+                ++missCount;
+            }
+        }
+
+    /* For a LRU cache the position of a vertex changes on every hit, so
+       simulate the actual cache contents, with the most recent vertex at
+       the front */
+    } else if(model == VertexCacheModel::Lru) {
+        Containers::Array<UnsignedInt> cache{NoInit, cacheSize};
+        std::size_t cacheCount = 0;
+        for(const T index: indices) {
+            CORRADE_ASSERT(index < vertexCount,
+                "MeshTools::vertexCacheStatistics(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+            if(!referenced[index]) {
+                referenced.set(index);
+                ++referencedCount;
+            }
+
+            std::size_t position = 0;
+            while(position != cacheCount && cache[position] != index)
+                ++position;
+            if(position == cacheCount) {
+                ++missCount;
+                if(cacheCount != cacheSize) ++cacheCount;
+                position = cacheCount - 1;
+            }
+            for(; position; --position)
+                cache[position] = cache[position - 1];
+            cache[0] = index;
+        }
+    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return {Float(missCount)/Float(indices.size()/3),
+            Float(missCount)/Float(referencedCount)};
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize, model);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize, model);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, cacheSize, model);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::optimizeVertexCacheInPlace(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedInt>(indices), vertexCount, cacheSize, model);
+    else if(indices.size()[1] == 2)
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedShort>(indices), vertexCount, cacheSize, model);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::optimizeVertexCacheInPlace(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return optimizeVertexCacheInPlaceImplementation(Containers::arrayCast<1, UnsignedByte>(indices), vertexCount, cacheSize, model);
+    }
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize, model);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize, model);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    return vertexCacheStatisticsImplementation(indices, vertexCount, cacheSize, model);
+}
+
+Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView2D<const char>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::vertexCacheStatistics(): second index view dimension is not contiguous", {});
+    if(indices.size()[1] == 4)
+        return vertexCacheStatisticsImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), vertexCount, cacheSize, model);
+    else if(indices.size()[1] == 2)
+        return vertexCacheStatisticsImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), vertexCount, cacheSize, model);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::vertexCacheStatistics(): expected index type size 1, 2 or 4 but got" << indices.size()[1], {});
+        return vertexCacheStatisticsImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), vertexCount, cacheSize, model);
+    }
+}
+
+}}
@@ -0,0 +1,170 @@
+#ifndef Magnum_MeshTools_VertexCache_h
+#define Magnum_MeshTools_VertexCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::MeshTools::VertexCacheModel, function @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::vertexCacheStatistics()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Post-transform vertex cache model
+@m_since_latest
+
+@see @ref optimizeVertexCacheInPlace(), @ref vertexCacheStatistics()
+*/
+enum class VertexCacheModel: UnsignedByte {
+    /**
+     * First-in first-out cache. A vertex that's not in the cache is put at
+     * its front and the oldest vertex is evicted, a cache hit doesn't change
+     * the order. Closest to what actual GPU hardware does.
+     */
+    Fifo,
+
+    /**
+     * Least-recently-used cache. Same as @ref VertexCacheModel::Fifo, but
+     * each cache hit moves the vertex to the front.
+     */
+    Lru
+};
+
+/**
+@brief Optimize a triangle mesh for the post-transform vertex cache in-place
+@param[in,out] indices  Triangle index array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] model        Cache model used for scoring the vertices
+@m_since_latest
+
+Reorders triangles in the index array to make better use of the
+post-transform vertex cache, minimizing the number of vertex shader
+invocations. Vertex data are not touched. Algorithm used: *Tom Forsyth --- Linear-Speed Vertex Cache Optimisation, 2006,
+https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html*. Compared
+to @ref tipsifyInPlace() it's slower, but it can model both FIFO and LRU
+caches. Use @ref vertexCacheStatistics() to pick the better ordering for a
+particular mesh and target.
+
+Each vertex gets a score based on whether it's in a simulated cache of
+@p cacheSize entries and on the count of not-yet-emitted triangles referencing
+it, favoring vertices that would otherwise be left isolated. With
+@ref VertexCacheModel::Fifo, which is the default as it's closest to what GPU
+hardware does, all vertices in the cache get the same score, as a cache hit
+doesn't affect how long the vertex stays there. This gives the best results if
+@p cacheSize matches the actual hardware. With @ref VertexCacheModel::Lru the
+score decays with the position in the cache and vertices of the last emitted
+triangle get a fixed lower score, as in the original paper. The result is
+slightly worse for a matching cache size but degrades more gracefully if the
+actual cache is smaller than @p cacheSize. The triangle with
+the highest sum of vertex scores is emitted next and only scores of vertices
+in the cache are updated after, which makes the operation run in
+@f$ \mathcal{O}(n) @f$ with the cache size as a constant factor.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than @p vertexCount and @p cacheSize is at least @cpp 4 @ce.
+@see @ref MeshPrimitive::Triangles
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize = 32, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount, std::size_t cacheSize = 32, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount, std::size_t cacheSize = 32, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+@brief Optimize a type-erased triangle mesh for the post-transform vertex cache in-place
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>&, UnsignedInt, std::size_t, VertexCacheModel)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView2D<char>& indices, UnsignedInt vertexCount, std::size_t cacheSize = 32, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+@brief Post-transform vertex cache statistics
+@param indices      Triangle index array
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+@param model        Cache model to simulate
+@return Average cache miss ratio (ACMR) and average transform to vertex ratio
+    (ATVR)
+@m_since_latest
+
+Simulates a post-transform vertex cache of @p cacheSize entries and counts
+the vertex shader invocations needed to render the mesh. ACMR is the
+invocation count divided by triangle count, ranging from @cpp 0.5 @ce for
+an ideal ordering of a large regular grid to @cpp 3.0 @ce when no vertex is
+reused. ATVR is the invocation count divided by the count of vertices that
+are actually referenced by @p indices, with @cpp 1.0 @ce being the optimum.
+If there are no triangles, returns @cpp 0.0f @ce for both.
+
+Expects that the index count is divisible by @cpp 3 @ce, all indices are less
+than @p vertexCount and @p cacheSize is not zero.
+@see @ref optimizeVertexCacheInPlace(), @ref tipsifyInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedShort>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedByte>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+@brief Post-transform vertex cache statistics for a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref vertexCacheStatistics(const Containers::StridedArrayView1D<const UnsignedInt>&, UnsignedInt, std::size_t, VertexCacheModel)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Pair<Float, Float> vertexCacheStatistics(const Containers::StridedArrayView2D<const char>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+}}
+
+#endif
@@ -0,0 +1,210 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchMeshesByMaterial.h"
+
+#include <string>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/GenerateIndices.h"
+#include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/FlattenMeshHierarchy.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+template<UnsignedInt> struct BatchDimensionTraits;
+template<> struct BatchDimensionTraits<2> {
+    static Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHierarchy(const Trade::SceneData& scene) {
+        return flattenMeshHierarchy2D(scene);
+    }
+    static Trade::MeshData transform(Trade::MeshData&& mesh, const Matrix3& transformation) {
+        return MeshTools::transform2D(std::move(mesh), transformation);
+    }
+    static Trade::MeshData transform(const Trade::MeshData& mesh, const Matrix3& transformation) {
+        return MeshTools::transform2D(mesh, transformation);
+    }
+};
+template<> struct BatchDimensionTraits<3> {
+    static Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy(const Trade::SceneData& scene) {
+        return flattenMeshHierarchy3D(scene);
+    }
+    static Trade::MeshData transform(Trade::MeshData&& mesh, const Matrix4& transformation) {
+        return MeshTools::transform3D(std::move(mesh), transformation);
+    }
+    static Trade::MeshData transform(const Trade::MeshData& mesh, const Matrix4& transformation) {
+        return MeshTools::transform3D(mesh, transformation);
+    }
+};
+
+bool isStripLoopOrFan(const MeshPrimitive primitive) {
+    return primitive == MeshPrimitive::LineStrip ||
+           primitive == MeshPrimitive::LineLoop ||
+           primitive == MeshPrimitive::TriangleStrip ||
+           primitive == MeshPrimitive::TriangleFan;
+}
+
+/* Key describing everything that has to match for meshes to be concatenated
+   without losing any data. Strips, loops and fans get turned into lists by
+   generateIndices() before the concatenation, so they get the same key as the
+   lists. */
+std::string layoutKey(const Trade::MeshData& mesh) {
+    MeshPrimitive primitive = mesh.primitive();
+    if(primitive == MeshPrimitive::LineStrip || primitive == MeshPrimitive::LineLoop)
+        primitive = MeshPrimitive::Lines;
+    else if(primitive == MeshPrimitive::TriangleStrip || primitive == MeshPrimitive::TriangleFan)
+        primitive = MeshPrimitive::Triangles;
+
+    std::string out;
+    out.reserve(sizeof(UnsignedInt)*(1 + mesh.attributeCount()*3));
+    const auto append = [&out](const UnsignedInt value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(UnsignedInt));
+    };
+    append(UnsignedInt(primitive));
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        append(UnsignedInt(mesh.attributeName(i)));
+        append(UnsignedInt(mesh.attributeFormat(i)));
+        append(mesh.attributeArraySize(i));
+    }
+    return out;
+}
+
+template<UnsignedInt dimensions> Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshesByMaterialImplementation(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes) {
+    /* This asserts on the scene not being of the right dimension or not
+       having a hierarchy */
+    const Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> instances = BatchDimensionTraits<dimensions>::flattenMeshHierarchy(scene);
+
+    /* Assign a layout ID to each mesh that's referenced, deduplicating the
+       layouts. Then assign a batch ID to each instance based on the layout
+       and material, in order of first appearance. */
+    Containers::Array<UnsignedInt> meshLayouts{DirectInit, meshes.size(), ~UnsignedInt{}};
+    std::unordered_map<std::string, UnsignedInt> layouts;
+    std::unordered_map<UnsignedLong, UnsignedInt> batches;
+    Containers::Array<UnsignedInt> instanceBatches{NoInit, instances.size()};
+    Containers::Array<Int> batchMaterials;
+    for(std::size_t i = 0; i != instances.size(); ++i) {
+        const UnsignedInt meshId = instances[i].first();
+        CORRADE_ASSERT(meshId < meshes.size(),
+            "SceneTools::batchMeshesByMaterial(): mesh" << meshId << "out of range for" << meshes.size() << "meshes",
+            (Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>>{Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}, {}}));
+        if(meshLayouts[meshId] == ~UnsignedInt{})
+            meshLayouts[meshId] = layouts.emplace(layoutKey(meshes[meshId]), layouts.size()).first->second;
+
+        const UnsignedLong key = UnsignedLong(meshLayouts[meshId]) << 32 | UnsignedInt(instances[i].second());
+        const std::pair<std::unordered_map<UnsignedLong, UnsignedInt>::iterator, bool> inserted = batches.emplace(key, batches.size());
+        if(inserted.second)
+            arrayAppend(batchMaterials, instances[i].second());
+        instanceBatches[i] = inserted.first->second;
+    }
+
+    /* Sort the instances by batch, keeping their original order in each */
+    Containers::Array<UnsignedInt> batchOffsets{ValueInit, batchMaterials.size() + 1};
+    for(const UnsignedInt batch: instanceBatches)
+        ++batchOffsets[batch + 1];
+    for(std::size_t i = 1; i != batchOffsets.size(); ++i)
+        batchOffsets[i] += batchOffsets[i - 1];
+    Containers::Array<UnsignedInt> sortedInstances{NoInit, instances.size()};
+    {
+        Containers::Array<UnsignedInt> batchCursors{NoInit, batchMaterials.size()};
+        Utility::copy(batchOffsets.prefix(batchMaterials.size()), batchCursors);
+        for(std::size_t i = 0; i != instances.size(); ++i)
+            sortedInstances[batchCursors[instanceBatches[i]]++] = i;
+    }
+
+    /* Transform and concatenate meshes in each batch. The transformed copies
+       are made just for one batch at a time to not have all of them in
+       memory at once. */
+    Containers::Array<Trade::MeshData> batchMeshes;
+    arrayReserve(batchMeshes, batchMaterials.size());
+    for(std::size_t batch = 0; batch != batchMaterials.size(); ++batch) {
+        Containers::Array<Trade::MeshData> transformed;
+        arrayReserve(transformed, batchOffsets[batch + 1] - batchOffsets[batch]);
+        for(std::size_t i = batchOffsets[batch]; i != batchOffsets[batch + 1]; ++i) {
+            const Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>& instance = instances[sortedInstances[i]];
+            const Trade::MeshData& mesh = meshes[instance.first()];
+            arrayAppend(transformed, isStripLoopOrFan(mesh.primitive()) ?
+                BatchDimensionTraits<dimensions>::transform(MeshTools::generateIndices(mesh), instance.third()) :
+                BatchDimensionTraits<dimensions>::transform(mesh, instance.third()));
+        }
+
+        arrayAppend(batchMeshes, MeshTools::concatenate(transformed));
+    }
+
+    /* Create the output scene, with one object per batch. All objects are in
+       the root and have an identity transformation so the scene is still
+       usable with flattenMeshHierarchy*D() and other tools. */
+    const std::size_t batchCount = batchMaterials.size();
+    Containers::ArrayView<UnsignedInt> mapping;
+    Containers::ArrayView<Int> parents;
+    Containers::ArrayView<MatrixTypeFor<dimensions, Float>> transformations;
+    Containers::ArrayView<UnsignedInt> meshIds;
+    Containers::ArrayView<Int> materials;
+    Containers::ArrayTuple data{
+        {NoInit, batchCount, mapping},
+        {NoInit, batchCount, parents},
+        {ValueInit, batchCount, transformations},
+        {NoInit, batchCount, meshIds},
+        {NoInit, batchCount, materials}
+    };
+    for(std::size_t i = 0; i != batchCount; ++i) {
+        mapping[i] = i;
+        parents[i] = -1;
+        meshIds[i] = i;
+        materials[i] = batchMaterials[i];
+    }
+
+    return {Trade::SceneData{Trade::SceneMappingType::UnsignedInt, batchCount, std::move(data), {
+        Trade::SceneFieldData{Trade::SceneField::Parent, mapping, parents, Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, mapping, transformations, Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::Mesh, mapping, meshIds, Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial, mapping, materials, Trade::SceneFieldFlag::ImplicitMapping}
+    }}, std::move(batchMeshes)};
+}
+
+}
+
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshesByMaterial2D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes) {
+    return batchMeshesByMaterialImplementation<2>(scene, meshes);
+}
+
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshesByMaterial3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes) {
+    return batchMeshesByMaterialImplementation<3>(scene, meshes);
+}
+
+}}
@@ -0,0 +1,94 @@
+#ifndef Magnum_SceneTools_BatchMeshesByMaterial_h
+#define Magnum_SceneTools_BatchMeshesByMaterial_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::batchMeshesByMaterial2D(), @ref Magnum::SceneTools::batchMeshesByMaterial3D()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Batch meshes in a 2D scene by material
+@m_since_latest
+
+Like @ref batchMeshesByMaterial3D(), but for 2D scenes, with the
+transformations applied using @ref MeshTools::transform2D() and the output
+scene having a @ref Trade::SceneFieldType::Matrix3x3 transformation field.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshesByMaterial2D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes);
+
+/**
+@brief Batch meshes in a 3D scene by material
+@param scene    Input scene
+@param meshes   Meshes referenced by the @ref Trade::SceneField::Mesh field
+@m_since_latest
+
+Flattens the mesh hierarchy using @ref flattenMeshHierarchy3D(), groups all
+mesh instances by their @ref Trade::SceneField::MeshMaterial and vertex layout,
+i.e. the primitive and the list of attribute names, formats and array sizes,
+and for each group applies the absolute transformations to the instances using
+@ref MeshTools::transform3D() and joins them together using
+@ref MeshTools::concatenate(). The result is a scene with one object for each
+group, with no parent, an identity transformation and the group mesh and
+material attached, together with the list of group meshes, in the order the
+groups first appear in the @ref Trade::SceneField::Mesh field. It's useful for
+static scenes where the amount of draws matters more than the ability to
+transform or cull individual objects.
+
+Meshes with @ref MeshPrimitive::LineStrip, @ref MeshPrimitive::LineLoop,
+@ref MeshPrimitive::TriangleStrip and @ref MeshPrimitive::TriangleFan are
+converted to their list counterparts using @ref MeshTools::generateIndices()
+first and are then batched together with the other list meshes. Instances
+without a material are batched as well, their output objects have the material
+set to @cpp -1 @ce. Meshes not referenced by the scene are not present in the
+output.
+
+The same requirements as in @ref flattenMeshHierarchy3D() are imposed on
+@p scene. Expects that all mesh IDs in the @ref Trade::SceneField::Mesh field
+are less than size of @p meshes and that the meshes satisfy the requirements
+of @ref MeshTools::transform3D() and @ref MeshTools::concatenate(). If the
+scene has no @ref Trade::SceneField::Mesh field or it's empty, the returned
+scene and mesh list is empty.
+
+@experimental
+
+@see @ref batchMeshesByMaterial2D(), @ref Trade::SceneData::is3D()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> batchMeshesByMaterial3D(const Trade::SceneData& scene, const Containers::Iterable<const Trade::MeshData>& meshes);
+
+}}
+
+#endif
@@ -0,0 +1,638 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DeduplicateMeshes.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools {
+
+namespace {
+
+/* Same rotate-xor-multiply step as in MeshTools::removeDuplicates(), but
+   consuming the data in pieces. No final avalanche, the hashes are only
+   sorted and compared for equality. */
+constexpr std::uint64_t HashMultiplier = 0x9e3779b97f4a7c15ull;
+
+inline void hashValue(std::uint64_t& hash, const std::uint64_t value) {
+    hash = (((hash << 5)|(hash >> 59)) ^ value)*HashMultiplier;
+}
+
+void hashRows(std::uint64_t& hash, const Containers::StridedArrayView2D<const char>& data) {
+    const std::size_t size = data.size()[1];
+    for(const Containers::StridedArrayView1D<const char> row: data) {
+        const char* const bytes = static_cast<const char*>(row.data());
+        std::size_t i = 0;
+        for(; i + 8 <= size; i += 8) {
+            std::uint64_t value;
+            std::memcpy(&value, bytes + i, 8);
+            hashValue(hash, value);
+        }
+        if(i != size) {
+            std::uint64_t value = 0;
+            std::memcpy(&value, bytes + i, size - i);
+            hashValue(hash, value);
+        }
+    }
+}
+
+bool rowsEqual(const Containers::StridedArrayView2D<const char>& a, const Containers::StridedArrayView2D<const char>& b) {
+    if(a.size() != b.size()) return false;
+    for(std::size_t i = 0; i != a.size()[0]; ++i)
+        if(std::memcmp(a[i].data(), b[i].data(), a.size()[1]) != 0)
+            return false;
+    return true;
+}
+
+/* Attributes that change when the mesh is rigidly transformed */
+bool isRigidAttribute(const Trade::MeshAttribute name) {
+    return name == Trade::MeshAttribute::Position ||
+           name == Trade::MeshAttribute::Normal ||
+           name == Trade::MeshAttribute::Tangent ||
+           name == Trade::MeshAttribute::Bitangent;
+}
+
+/* Size of implementation-specific formats isn't known, so such meshes can't
+   be compared */
+bool isComparable(const Trade::MeshData& mesh) {
+    if(mesh.isIndexed() && isMeshIndexTypeImplementationSpecific(mesh.indexType()))
+        return false;
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i)
+        if(isVertexFormatImplementationSpecific(mesh.attributeFormat(i)))
+            return false;
+    return true;
+}
+
+/* If skipRigidAttributes is set, values of attributes from isRigidAttribute()
+   aren't included, only their names and formats */
+std::uint64_t hashMesh(const Trade::MeshData& mesh, const bool skipRigidAttributes) {
+    std::uint64_t hash = 0;
+    hashValue(hash, UnsignedInt(mesh.primitive()));
+    hashValue(hash, mesh.vertexCount());
+    if(mesh.isIndexed()) {
+        hashValue(hash, UnsignedInt(mesh.indexType()));
+        hashValue(hash, mesh.indexCount());
+        hashRows(hash, mesh.indices());
+    }
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = mesh.attributeName(i);
+        hashValue(hash, UnsignedInt(name));
+        hashValue(hash, UnsignedInt(mesh.attributeFormat(i)));
+        hashValue(hash, mesh.attributeArraySize(i));
+        if(!skipRigidAttributes || !isRigidAttribute(name))
+            hashRows(hash, mesh.attribute(i));
+    }
+    return hash;
+}
+
+bool meshesEqual(const Trade::MeshData& a, const Trade::MeshData& b, const bool skipRigidAttributes) {
+    if(a.primitive() != b.primitive() ||
+       a.vertexCount() != b.vertexCount() ||
+       a.isIndexed() != b.isIndexed() ||
+       a.attributeCount() != b.attributeCount())
+        return false;
+    if(a.isIndexed() && (a.indexType() != b.indexType() || !rowsEqual(a.indices(), b.indices())))
+        return false;
+    for(UnsignedInt i = 0; i != a.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = a.attributeName(i);
+        if(name != b.attributeName(i) ||
+           a.attributeFormat(i) != b.attributeFormat(i) ||
+           a.attributeArraySize(i) != b.attributeArraySize(i))
+            return false;
+        if((!skipRigidAttributes || !isRigidAttribute(name)) && !rowsEqual(a.attribute(i), b.attribute(i)))
+            return false;
+    }
+    return true;
+}
+
+bool isRigidCandidate(const Trade::MeshData& mesh) {
+    return mesh.vertexCount() &&
+        mesh.attributeCount(Trade::MeshAttribute::Position) == 1 &&
+        vertexFormatComponentCount(mesh.attributeFormat(Trade::MeshAttribute::Position)) == 3;
+}
+
+constexpr Double PositionEpsilon = 1.0e-5;
+constexpr Double DirectionEpsilon = 1.0e-4;
+
+bool directionsMatch(const Matrix3x3d& rotation, const Containers::Array<Vector3>& a, const Containers::Array<Vector3>& b) {
+    for(std::size_t i = 0; i != a.size(); ++i)
+        if(Math::abs(rotation*Vector3d{a[i]} - Vector3d{b[i]}).max() > DirectionEpsilon)
+            return false;
+    return true;
+}
+
+/* Finds a rotation and translation that turns `a` into `b`, assuming the
+   vertex order is the same and that everything except the attributes from
+   isRigidAttribute() was already verified to be equal */
+Containers::Optional<Matrix4> findRigidTransformation(const Trade::MeshData& a, const Trade::MeshData& b) {
+    const Containers::Array<Vector3> positionsA = a.positions3DAsArray();
+    const Containers::Array<Vector3> positionsB = b.positions3DAsArray();
+
+    /* Kabsch algorithm. Calculate centroids of both position sets and a
+       cross-covariance matrix of the centered positions, the rotation is then
+       V*Uᵀ from its SVD, with a reflection removed if there's any. Done in
+       doubles to not lose precision on large meshes. */
+    Vector3d centroidA, centroidB;
+    for(std::size_t i = 0; i != positionsA.size(); ++i) {
+        centroidA += Vector3d{positionsA[i]};
+        centroidB += Vector3d{positionsB[i]};
+    }
+    centroidA /= Double(positionsA.size());
+    centroidB /= Double(positionsB.size());
+
+    Matrix3x3d covariance{ZeroInit};
+    for(std::size_t i = 0; i != positionsA.size(); ++i) {
+        const Vector3d centeredA = Vector3d{positionsA[i]} - centroidA;
+        const Vector3d centeredB = Vector3d{positionsB[i]} - centroidB;
+        for(std::size_t column = 0; column != 3; ++column)
+            covariance[column] += centeredA*centeredB[column];
+    }
+
+    Matrix3x3d u{NoInit};
+    Vector3d w{NoInit};
+    Matrix3x3d v{NoInit};
+    std::tie(u, w, v) = Math::Algorithms::svd(covariance);
+
+    /* If the rotation would contain a reflection, flip the axis with the
+       smallest singular value */
+    Matrix3x3d correction;
+    if((v*u.transposed()).determinant() < 0.0) {
+        std::size_t smallest = 0;
+        for(std::size_t i = 1; i != 3; ++i)
+            if(w[i] < w[smallest]) smallest = i;
+        correction[smallest][smallest] = -1.0;
+    }
+    const Matrix3x3d rotation = v*correction*u.transposed();
+
+    /* The SVD returns zero matrices if it doesn't converge */
+    if(Math::abs(rotation.determinant() - 1.0) > DirectionEpsilon)
+        return {};
+
+    const Vector3d translation = centroidB - rotation*centroidA;
+
+    /* Verify that all positions match, with the tolerance relative to their
+       magnitude */
+    Double magnitude = 0.0;
+    for(std::size_t i = 0; i != positionsA.size(); ++i)
+        magnitude = Math::max(magnitude, Double(Math::max(
+            Math::abs(positionsA[i]).max(),
+            Math::abs(positionsB[i]).max())));
+    const Double positionEpsilon = PositionEpsilon*magnitude;
+    for(std::size_t i = 0; i != positionsA.size(); ++i)
+        if(Math::abs(rotation*Vector3d{positionsA[i]} + translation - Vector3d{positionsB[i]}).max() > positionEpsilon)
+            return {};
+
+    /* Verify that all normals, tangents and bitangents got rotated the same
+       way. Bitangent signs are stored in the tangent attribute, which was
+       excluded from the equality comparison, so check them here too. */
+    for(UnsignedInt i = 0, count = a.attributeCount(Trade::MeshAttribute::Normal); i != count; ++i)
+        if(!directionsMatch(rotation, a.normalsAsArray(i), b.normalsAsArray(i)))
+            return {};
+    for(UnsignedInt i = 0, count = a.attributeCount(Trade::MeshAttribute::Tangent); i != count; ++i) {
+        if(!directionsMatch(rotation, a.tangentsAsArray(i), b.tangentsAsArray(i)))
+            return {};
+        if(vertexFormatComponentCount(a.attributeFormat(Trade::MeshAttribute::Tangent, i)) == 4) {
+            const Containers::Array<Float> signsA = a.bitangentSignsAsArray(i);
+            const Containers::Array<Float> signsB = b.bitangentSignsAsArray(i);
+            for(std::size_t j = 0; j != signsA.size(); ++j)
+                if((signsA[j] < 0.0f) != (signsB[j] < 0.0f)) return {};
+        }
+    }
+    for(UnsignedInt i = 0, count = a.attributeCount(Trade::MeshAttribute::Bitangent); i != count; ++i)
+        if(!directionsMatch(rotation, a.bitangentsAsArray(i), b.bitangentsAsArray(i)))
+            return {};
+
+    return Matrix4::from(Matrix3x3{rotation}, Vector3{translation});
+}
+
+/* Sorts the hashes and calls `test(other, mesh)` for each `mesh` with each
+   preceding `other` with the same hash that isn't a duplicate already, until
+   it returns true */
+template<class Test> void findDuplicatesInternal(Containers::ArrayView<Containers::Pair<std::uint64_t, UnsignedInt>> hashes, const Containers::ArrayView<const Containers::Pair<UnsignedInt, Matrix4>> out, Test test) {
+    std::sort(hashes.begin(), hashes.end(), [](const Containers::Pair<std::uint64_t, UnsignedInt>& a, const Containers::Pair<std::uint64_t, UnsignedInt>& b) {
+        return a.first() < b.first() || (a.first() == b.first() && a.second() < b.second());
+    });
+
+    for(std::size_t begin = 0, end; begin != hashes.size(); begin = end) {
+        for(end = begin + 1; end != hashes.size() && hashes[end].first() == hashes[begin].first(); ++end);
+
+        for(std::size_t i = begin + 1; i < end; ++i) {
+            const UnsignedInt mesh = hashes[i].second();
+            for(std::size_t j = begin; j != i; ++j) {
+                const UnsignedInt other = hashes[j].second();
+                if(out[other].first() == other && test(other, mesh))
+                    break;
+            }
+        }
+    }
+}
+
+}
+
+Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> findDuplicateMeshes(const Containers::Iterable<const Trade::MeshData>& meshes, const DuplicateMeshFlags flags) {
+    /* By default each mesh maps to itself */
+    Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> out{NoInit, meshes.size()};
+    for(std::size_t i = 0; i != meshes.size(); ++i)
+        out[i] = {UnsignedInt(i), Matrix4{}};
+
+    /* Hash all meshes that can be compared, compare the ones with the same
+       hash and point each duplicate to the first mesh it's equal to */
+    Containers::Array<Containers::Pair<std::uint64_t, UnsignedInt>> hashes;
+    arrayReserve(hashes, meshes.size());
+    for(std::size_t i = 0; i != meshes.size(); ++i)
+        if(isComparable(meshes[i]))
+            arrayAppend(hashes, InPlaceInit, hashMesh(meshes[i], false), UnsignedInt(i));
+    findDuplicatesInternal(hashes, out, [&](const UnsignedInt other, const UnsignedInt mesh) {
+        if(!meshesEqual(meshes[other], meshes[mesh], false))
+            return false;
+        out[mesh].first() = other;
+        return true;
+    });
+
+    /* Then, if requested, hash the remaining unique meshes again without the
+       rigidly transformed attributes and try to find a rigid transformation
+       for the ones that are equal in everything else */
+    if(flags & DuplicateMeshFlag::RigidTransformations) {
+        arrayResize(hashes, 0);
+        for(std::size_t i = 0; i != meshes.size(); ++i)
+            if(out[i].first() == i && isComparable(meshes[i]) && isRigidCandidate(meshes[i]))
+                arrayAppend(hashes, InPlaceInit, hashMesh(meshes[i], true), UnsignedInt(i));
+        findDuplicatesInternal(hashes, out, [&](const UnsignedInt other, const UnsignedInt mesh) {
+            if(!meshesEqual(meshes[other], meshes[mesh], true))
+                return false;
+            const Containers::Optional<Matrix4> transformation = findRigidTransformation(meshes[other], meshes[mesh]);
+            if(!transformation)
+                return false;
+            out[mesh] = {other, *transformation};
+            return true;
+        });
+
+        /* Exact duplicates of meshes that turned out to be a transformed
+           duplicate of another need to point to the other mesh as well. The
+           meshes always point to ones with a lower ID, so a single pass in
+           order is enough. */
+        for(std::size_t i = 0; i != out.size(); ++i) {
+            const Containers::Pair<UnsignedInt, Matrix4>& target = out[out[i].first()];
+            if(target.first() != out[i].first())
+                out[i] = {target.first(), out[i].second()*target.second()};
+        }
+    }
+
+    return out;
+}
+
+namespace {
+
+/* A transformation field that gets extended with the new objects. If `id` is
+   not set, it's a field that gets newly added. */
+struct TransformationField {
+    Trade::SceneField name;
+    Trade::SceneFieldType type;
+    Containers::Optional<UnsignedInt> id;
+    std::size_t offset;
+};
+
+/* Turns a field pointing to `base` to an offset-only field relative to
+   `base - offset`, with given mapping offset, mapping stride and flags */
+Trade::SceneFieldData offsetOnlyField(const Trade::SceneFieldData& field, const char* const base, const std::size_t offset, const std::size_t mappingOffset, const std::ptrdiff_t mappingStride, const Trade::SceneFieldFlags flags) {
+    const auto dataOffset = [&](const void* const data) -> std::size_t {
+        return field.size() && data ? static_cast<const char*>(data) - base + offset : 0;
+    };
+
+    if(field.fieldType() == Trade::SceneFieldType::Bit) {
+        const Containers::StridedBitArrayView2D fieldData = field.fieldBitData();
+        return Trade::SceneFieldData{field.name(), std::size_t(field.size()), field.mappingType(), mappingOffset, mappingStride, dataOffset(fieldData.data()), fieldData.offset(), fieldData.stride()[0], field.fieldArraySize(), flags};
+    }
+
+    const Containers::StridedArrayView1D<const void> fieldData = field.fieldData();
+    if(Trade::Implementation::isSceneFieldTypeString(field.fieldType()))
+        return Trade::SceneFieldData{field.name(), std::size_t(field.size()), field.mappingType(), mappingOffset, mappingStride, dataOffset(field.stringData()), field.fieldType(), dataOffset(fieldData.data()), fieldData.stride(), flags};
+
+    return Trade::SceneFieldData{field.name(), std::size_t(field.size()), field.mappingType(), mappingOffset, mappingStride, field.fieldType(), dataOffset(fieldData.data()), fieldData.stride(), field.fieldArraySize(), flags};
+}
+
+void setMapping(const Containers::StridedArrayView2D<char>& mapping, const Trade::SceneMappingType type, const std::size_t i, const UnsignedLong object) {
+    if(type == Trade::SceneMappingType::UnsignedByte)
+        Containers::arrayCast<1, UnsignedByte>(mapping)[i] = object;
+    else if(type == Trade::SceneMappingType::UnsignedShort)
+        Containers::arrayCast<1, UnsignedShort>(mapping)[i] = object;
+    else if(type == Trade::SceneMappingType::UnsignedInt)
+        Containers::arrayCast<1, UnsignedInt>(mapping)[i] = object;
+    else if(type == Trade::SceneMappingType::UnsignedLong)
+        Containers::arrayCast<1, UnsignedLong>(mapping)[i] = object;
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Writes a rigid transformation to a transformation, translation, rotation
+   or scaling field of given type */
+void setTransformation(const Containers::StridedArrayView2D<char>& data, const Trade::SceneField name, const Trade::SceneFieldType type, const std::size_t i, const Matrix4& transformation) {
+    switch(type) {
+        case Trade::SceneFieldType::Matrix4x4:
+            Containers::arrayCast<1, Matrix4>(data)[i] = transformation;
+            return;
+        case Trade::SceneFieldType::Matrix4x4d:
+            Containers::arrayCast<1, Matrix4d>(data)[i] = Matrix4d{transformation};
+            return;
+        case Trade::SceneFieldType::Matrix4x3:
+            Containers::arrayCast<1, Matrix4x3>(data)[i] = Matrix4x3{
+                transformation[0].xyz(),
+                transformation[1].xyz(),
+                transformation[2].xyz(),
+                transformation[3].xyz()};
+            return;
+        case Trade::SceneFieldType::Matrix4x3d:
+            Containers::arrayCast<1, Matrix4x3d>(data)[i] = Matrix4x3d{Matrix4x3{
+                transformation[0].xyz(),
+                transformation[1].xyz(),
+                transformation[2].xyz(),
+                transformation[3].xyz()}};
+            return;
+        case Trade::SceneFieldType::DualQuaternion:
+            Containers::arrayCast<1, DualQuaternion>(data)[i] = DualQuaternion::fromMatrix(transformation);
+            return;
+        case Trade::SceneFieldType::DualQuaterniond:
+            Containers::arrayCast<1, DualQuaterniond>(data)[i] = DualQuaterniond::fromMatrix(Matrix4d{transformation});
+            return;
+        case Trade::SceneFieldType::Quaternion:
+            Containers::arrayCast<1, Quaternion>(data)[i] = Quaternion::fromMatrix(transformation.rotationScaling());
+            return;
+        case Trade::SceneFieldType::Quaterniond:
+            Containers::arrayCast<1, Quaterniond>(data)[i] = Quaterniond::fromMatrix(Matrix3x3d{transformation.rotationScaling()});
+            return;
+        case Trade::SceneFieldType::Vector3:
+            Containers::arrayCast<1, Vector3>(data)[i] = name == Trade::SceneField::Translation ? transformation.translation() : Vector3{1.0f};
+            return;
+        case Trade::SceneFieldType::Vector3d:
+            Containers::arrayCast<1, Vector3d>(data)[i] = name == Trade::SceneField::Translation ? Vector3d{transformation.translation()} : Vector3d{1.0};
+            return;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+Trade::SceneData deduplicateMeshReferences(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Containers::Pair<UnsignedInt, Matrix4>>& duplicates) {
+    /* Compacted IDs of unique meshes */
+    Containers::Array<UnsignedInt> uniqueIds{NoInit, duplicates.size()};
+    {
+        UnsignedInt uniqueCount = 0;
+        for(std::size_t i = 0; i != duplicates.size(); ++i)
+            if(duplicates[i].first() == i) uniqueIds[i] = uniqueCount++;
+    }
+
+    /* Gather the mesh references and count how many need a new object for a
+       transformation */
+    const Containers::Optional<UnsignedInt> meshFieldId = scene.findFieldId(Trade::SceneField::Mesh);
+    const std::size_t meshCount = meshFieldId ? scene.fieldSize(*meshFieldId) : 0;
+    Containers::Array<UnsignedInt> meshObjects{NoInit, meshCount};
+    Containers::Array<UnsignedInt> meshIds{NoInit, meshCount};
+    if(meshFieldId)
+        scene.meshesMaterialsInto(Containers::arrayView(meshObjects), Containers::arrayView(meshIds), nullptr);
+    std::size_t newObjectCount = 0;
+    for(const UnsignedInt mesh: meshIds) {
+        CORRADE_ASSERT(mesh < duplicates.size(),
+            "SceneTools::deduplicateMeshReferences(): mesh" << mesh << "out of range for" << duplicates.size() << "meshes",
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        const UnsignedInt unique = duplicates[mesh].first();
+        CORRADE_ASSERT(unique < duplicates.size() && duplicates[unique].first() == unique,
+            "SceneTools::deduplicateMeshReferences(): mesh" << mesh << "is a duplicate of" << unique << "which isn't unique",
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        if(duplicates[mesh].second() != Matrix4{}) ++newObjectCount;
+    }
+
+    const Trade::SceneMappingType mappingType = scene.mappingType();
+    const std::size_t mappingTypeSize = sceneMappingTypeSize(mappingType);
+    const UnsignedLong newObjectOffset = scene.mappingBound();
+    Containers::Optional<UnsignedInt> parentFieldId;
+    Containers::Array<TransformationField> transformationFields;
+    if(newObjectCount) {
+        parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
+        CORRADE_ASSERT(parentFieldId,
+            "SceneTools::deduplicateMeshReferences(): the scene has no hierarchy",
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        CORRADE_ASSERT(!scene.is2D(),
+            "SceneTools::deduplicateMeshReferences(): can't add transformed mesh instances to a 2D scene",
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        #ifndef CORRADE_NO_ASSERT
+        const UnsignedLong newObjectBound = newObjectOffset + newObjectCount;
+        CORRADE_ASSERT(mappingTypeSize == 8 || newObjectBound <= 1ull << 8*mappingTypeSize,
+            "SceneTools::deduplicateMeshReferences(): can't represent" << newObjectBound << "objects with" << mappingType,
+            (Trade::SceneData{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}}));
+        #endif
+
+        /* The new transformations go to the combined transformation field if
+           there's one. Otherwise they go to the TRS fields, which share the
+           same mapping, with a translation and rotation field added if not
+           present already, as the new objects need both. If there's neither,
+           a new transformation field is added. */
+        const Containers::Optional<UnsignedInt> transformationFieldId = scene.findFieldId(Trade::SceneField::Transformation);
+        const Containers::Optional<UnsignedInt> translationFieldId = scene.findFieldId(Trade::SceneField::Translation);
+        const Containers::Optional<UnsignedInt> rotationFieldId = scene.findFieldId(Trade::SceneField::Rotation);
+        const Containers::Optional<UnsignedInt> scalingFieldId = scene.findFieldId(Trade::SceneField::Scaling);
+        if(transformationFieldId)
+            arrayAppend(transformationFields, TransformationField{Trade::SceneField::Transformation, scene.fieldType(*transformationFieldId), transformationFieldId, 0});
+        else if(translationFieldId || rotationFieldId || scalingFieldId) {
+            arrayAppend(transformationFields, TransformationField{Trade::SceneField::Translation, translationFieldId ? scene.fieldType(*translationFieldId) : Trade::SceneFieldType::Vector3, translationFieldId, 0});
+            arrayAppend(transformationFields, TransformationField{Trade::SceneField::Rotation, rotationFieldId ? scene.fieldType(*rotationFieldId) : Trade::SceneFieldType::Quaternion, rotationFieldId, 0});
+            if(scalingFieldId)
+                arrayAppend(transformationFields, TransformationField{Trade::SceneField::Scaling, scene.fieldType(*scalingFieldId), scalingFieldId, 0});
+        } else
+            arrayAppend(transformationFields, TransformationField{Trade::SceneField::Transformation, Trade::SceneFieldType::Matrix4x4, {}, 0});
+    }
+
+    /* Lay out the output data. The original data are copied as a whole to
+       keep all unchanged fields as they were, with the same alignment
+       relative to an 8-byte boundary. Fields that get extended or changed are
+       put after. */
+    const Containers::ArrayView<const char> originalData = Containers::arrayCast<const char>(scene.data());
+    const std::size_t originalOffset = reinterpret_cast<std::uintptr_t>(originalData.data()) & 7;
+    std::size_t dataSize = originalOffset + originalData.size();
+    const auto allocate = [&dataSize](const std::size_t size) {
+        dataSize = (dataSize + 7) & ~std::size_t{7};
+        const std::size_t offset = dataSize;
+        dataSize += size;
+        return offset;
+    };
+
+    std::size_t parentCount{}, parentMappingOffset{}, parentOffset{};
+    Containers::Optional<UnsignedInt> originalTransformationFieldId;
+    std::size_t originalTransformationCount{}, transformationCount{}, transformationMappingOffset{};
+    std::size_t meshMappingOffset{};
+    if(newObjectCount) {
+        parentCount = scene.fieldSize(*parentFieldId) + newObjectCount;
+        parentMappingOffset = allocate(parentCount*mappingTypeSize);
+        parentOffset = allocate(parentCount*sizeof(Int));
+
+        /* All transformation fields share the mapping, take the original one
+           from the first field that exists */
+        for(const TransformationField& field: transformationFields) if(field.id) {
+            originalTransformationFieldId = field.id;
+            originalTransformationCount = scene.fieldSize(*field.id);
+            break;
+        }
+        transformationCount = originalTransformationCount + newObjectCount;
+        transformationMappingOffset = allocate(transformationCount*mappingTypeSize);
+        for(TransformationField& field: transformationFields)
+            field.offset = allocate(transformationCount*sceneFieldTypeSize(field.type));
+
+        meshMappingOffset = allocate(meshCount*mappingTypeSize);
+    }
+    const std::size_t meshOffset = allocate(meshCount*sizeof(UnsignedInt));
+
+    Containers::Array<char> data{ValueInit, dataSize};
+    Utility::copy(originalData, data.sliceSize(originalOffset, originalData.size()));
+
+    const auto mappingView = [&](const std::size_t offset, const std::size_t count) {
+        return Containers::StridedArrayView2D<char>{data, data.data() + offset, {count, mappingTypeSize}, {std::ptrdiff_t(mappingTypeSize), 1}};
+    };
+
+    /* Extend the parent and transformation fields with the new objects */
+    if(newObjectCount) {
+        const std::size_t originalParentCount = scene.fieldSize(*parentFieldId);
+        const Containers::StridedArrayView2D<char> parentMapping = mappingView(parentMappingOffset, parentCount);
+        const Containers::ArrayView<Int> parents = Containers::arrayCast<Int>(data.sliceSize(parentOffset, parentCount*sizeof(Int)));
+        Utility::copy(scene.mapping(*parentFieldId), parentMapping.prefix(originalParentCount));
+        scene.parentsInto(nullptr, parents.prefix(originalParentCount));
+
+        const Containers::StridedArrayView2D<char> transformationMapping = mappingView(transformationMappingOffset, transformationCount);
+        if(originalTransformationFieldId)
+            Utility::copy(scene.mapping(*originalTransformationFieldId), transformationMapping.prefix(originalTransformationCount));
+        Containers::Array<Containers::StridedArrayView2D<char>> transformations{transformationFields.size()};
+        for(std::size_t i = 0; i != transformationFields.size(); ++i) {
+            const TransformationField& field = transformationFields[i];
+            const std::size_t typeSize = sceneFieldTypeSize(field.type);
+            transformations[i] = Containers::StridedArrayView2D<char>{data, data.data() + field.offset, {transformationCount, typeSize}, {std::ptrdiff_t(typeSize), 1}};
+            /* Newly added fields have an identity for the original objects */
+            if(field.id)
+                Utility::copy(scene.field(*field.id), transformations[i].prefix(originalTransformationCount));
+            else for(std::size_t j = 0; j != originalTransformationCount; ++j)
+                setTransformation(transformations[i], field.name, field.type, j, Matrix4{});
+        }
+
+        /* Move the mesh references to the new objects */
+        const Containers::StridedArrayView2D<char> meshMapping = mappingView(meshMappingOffset, meshCount);
+        Utility::copy(scene.mapping(*meshFieldId), meshMapping);
+        for(std::size_t i = 0, newObject = 0; i != meshCount; ++i) {
+            const Matrix4& transformation = duplicates[meshIds[i]].second();
+            if(transformation == Matrix4{}) continue;
+
+            const UnsignedLong object = newObjectOffset + newObject;
+            setMapping(parentMapping, mappingType, originalParentCount + newObject, object);
+            parents[originalParentCount + newObject] = meshObjects[i];
+            setMapping(transformationMapping, mappingType, originalTransformationCount + newObject, object);
+            for(std::size_t j = 0; j != transformationFields.size(); ++j)
+                setTransformation(transformations[j], transformationFields[j].name, transformationFields[j].type, originalTransformationCount + newObject, transformation);
+            setMapping(meshMapping, mappingType, i, object);
+            ++newObject;
+        }
+    }
+
+    /* Point the mesh references to the unique meshes */
+    const Containers::ArrayView<UnsignedInt> meshes = Containers::arrayCast<UnsignedInt>(data.sliceSize(meshOffset, meshCount*sizeof(UnsignedInt)));
+    for(std::size_t i = 0; i != meshCount; ++i)
+        meshes[i] = uniqueIds[duplicates[meshIds[i]].first()];
+
+    /* Make offset-only fields relative to the new data. The parent and
+       transformation fields keep their ordered flag as the new objects have
+       the largest IDs and are added at the end, implicit mapping is lost
+       however. The mesh and material fields lose both. */
+    const auto extendedTransformationField = [&](const TransformationField& field, const Trade::SceneFieldFlags flags) {
+        return Trade::SceneFieldData{field.name, transformationCount, mappingType, transformationMappingOffset, std::ptrdiff_t(mappingTypeSize), field.type, field.offset, std::ptrdiff_t(sceneFieldTypeSize(field.type)), 0, flags};
+    };
+    std::size_t addedFieldCount = 0;
+    for(const TransformationField& field: transformationFields)
+        if(!field.id) ++addedFieldCount;
+    Containers::Array<Trade::SceneFieldData> fields{scene.fieldCount() + addedFieldCount};
+    for(UnsignedInt i = 0; i != scene.fieldCount(); ++i) {
+        const Trade::SceneFieldData field = scene.fieldData(i);
+        const Trade::SceneField name = field.name();
+        const Trade::SceneFieldFlags extendedFlags = field.flags() & ~(Trade::SceneFieldFlag::ImplicitMapping & ~Trade::SceneFieldFlag::OrderedMapping);
+
+        if(newObjectCount && name == Trade::SceneField::Parent) {
+            fields[i] = Trade::SceneFieldData{name, parentCount, mappingType, parentMappingOffset, std::ptrdiff_t(mappingTypeSize), Trade::SceneFieldType::Int, parentOffset, sizeof(Int), 0, extendedFlags};
+            continue;
+        }
+
+        const TransformationField* const transformationField = std::find_if(transformationFields.begin(), transformationFields.end(), [i](const TransformationField& field) {
+            return field.id && *field.id == i;
+        });
+        if(transformationField != transformationFields.end()) {
+            fields[i] = extendedTransformationField(*transformationField, extendedFlags);
+        } else if(name == Trade::SceneField::Mesh) {
+            if(newObjectCount)
+                fields[i] = Trade::SceneFieldData{name, meshCount, mappingType, meshMappingOffset, std::ptrdiff_t(mappingTypeSize), Trade::SceneFieldType::UnsignedInt, meshOffset, sizeof(UnsignedInt), 0, field.flags() & ~Trade::SceneFieldFlag::ImplicitMapping};
+            else
+                fields[i] = Trade::SceneFieldData{name, meshCount, mappingType, meshCount ? std::size_t(static_cast<const char*>(field.mappingData().data()) - originalData.data() + originalOffset) : 0, field.mappingData().stride(), Trade::SceneFieldType::UnsignedInt, meshOffset, sizeof(UnsignedInt), 0, field.flags()};
+        } else if(newObjectCount && name == Trade::SceneField::MeshMaterial) {
+            fields[i] = offsetOnlyField(field, originalData.data(), originalOffset, meshMappingOffset, std::ptrdiff_t(mappingTypeSize), field.flags() & ~Trade::SceneFieldFlag::ImplicitMapping);
+        } else {
+            const Containers::StridedArrayView1D<const void> mapping = field.mappingData();
+            fields[i] = offsetOnlyField(field, originalData.data(), originalOffset, field.size() ? static_cast<const char*>(mapping.data()) - originalData.data() + originalOffset : 0, mapping.stride(), field.flags());
+        }
+    }
+
+    /* Added fields are ordered if the mapping they share with the original
+       fields was, or if there was no original mapping */
+    const Trade::SceneFieldFlags addedFlags = !originalTransformationFieldId || (scene.fieldFlags(*originalTransformationFieldId) & Trade::SceneFieldFlag::OrderedMapping) ? Trade::SceneFieldFlag::OrderedMapping : Trade::SceneFieldFlags{};
+    for(std::size_t i = 0, addedFieldId = scene.fieldCount(); i != transformationFields.size(); ++i)
+        if(!transformationFields[i].id)
+            fields[addedFieldId++] = extendedTransformationField(transformationFields[i], addedFlags);
+
+    return Trade::SceneData{mappingType, newObjectOffset + newObjectCount, std::move(data), std::move(fields)};
+}
+
+Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> deduplicateMeshes(const Trade::SceneData& scene, Containers::Array<Trade::MeshData>&& meshes, const DuplicateMeshFlags flags) {
+    const Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> duplicates = findDuplicateMeshes(meshes, flags);
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+
+    Containers::Array<Trade::MeshData> uniqueMeshes;
+    for(std::size_t i = 0; i != meshes.size(); ++i)
+        if(duplicates[i].first() == i)
+            arrayAppend(uniqueMeshes, std::move(meshes[i]));
+
+    /* Convert back to a default deleter to make the returned array usable
+       with plugins */
+    arrayShrink(uniqueMeshes, DefaultInit);
+
+    return {std::move(out), std::move(uniqueMeshes)};
+}
+
+}}
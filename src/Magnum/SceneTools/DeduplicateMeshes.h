@@ -0,0 +1,180 @@
+#ifndef Magnum_SceneTools_DeduplicateMeshes_h
+#define Magnum_SceneTools_DeduplicateMeshes_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::SceneTools::findDuplicateMeshes(), @ref Magnum::SceneTools::deduplicateMeshReferences(), @ref Magnum::SceneTools::deduplicateMeshes(), enum @ref Magnum::SceneTools::DuplicateMeshFlag, enum set @ref Magnum::SceneTools::DuplicateMeshFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace SceneTools {
+
+/**
+@brief Duplicate mesh detection flag
+@m_since_latest
+
+@see @ref DuplicateMeshFlags, @ref findDuplicateMeshes(),
+    @ref deduplicateMeshes()
+*/
+enum class DuplicateMeshFlag: UnsignedByte {
+    /**
+     * Detect also meshes that differ from another mesh only by a rotation and
+     * translation of the @ref Trade::MeshAttribute::Position,
+     * @relativeref{Trade::MeshAttribute,Normal},
+     * @relativeref{Trade::MeshAttribute,Tangent} and
+     * @relativeref{Trade::MeshAttribute,Bitangent} attributes. See
+     * @ref findDuplicateMeshes() for details.
+     */
+    RigidTransformations = 1 << 0
+};
+
+/**
+@brief Duplicate mesh detection flags
+@m_since_latest
+
+@see @ref findDuplicateMeshes(), @ref deduplicateMeshes()
+*/
+typedef Containers::EnumSet<DuplicateMeshFlag> DuplicateMeshFlags;
+
+CORRADE_ENUMSET_OPERATORS(DuplicateMeshFlags)
+
+/**
+@brief Find duplicate meshes
+@param meshes   Meshes to search for duplicates
+@param flags    Detection flags
+@return For each mesh an ID of the mesh it's a duplicate of and a
+    transformation that turns the other mesh into it
+@m_since_latest
+
+Every mesh is hashed and meshes with the same hash are then compared for
+equality. Two meshes are equal if they have the same primitive, vertex count,
+index type and index values and the same attributes in the same order, with
+the same names, formats, array sizes and values. The actual data layout, such
+as attribute stride, interleaving or padding, doesn't matter.
+
+The first mesh of each set of equal meshes is unique and maps to itself with an
+identity transformation, all other meshes in the set map to it, again with an
+identity transformation. A mesh never maps to a mesh that's a duplicate of
+some other mesh, so the output can be directly passed to
+@ref deduplicateMeshReferences().
+
+If @ref DuplicateMeshFlag::RigidTransformations is set, the unique meshes are
+additionally hashed with the @ref Trade::MeshAttribute::Position,
+@relativeref{Trade::MeshAttribute,Normal},
+@relativeref{Trade::MeshAttribute,Tangent} and
+@relativeref{Trade::MeshAttribute,Bitangent} attribute values left out, and
+meshes that are equal in everything else are tested for being a rigid
+transformation of each other. The transformation is calculated from the
+positions of vertices at the same index, i.e. the meshes are expected to have
+the same vertex order, which is the case for instanced geometry written out
+from most tools. The rotation and translation is then found by fitting the
+positions using the Kabsch algorithm and if all positions match with a
+tolerance of @f$ 10^{-5} @f$ relative to their magnitude and all normals,
+tangents and bitangents match with a tolerance of @f$ 10^{-4} @f$, the mesh is
+marked as a duplicate with the transformation set to the found rotation and
+translation. Only meshes with exactly one three-component
+@ref Trade::MeshAttribute::Position attribute are considered for the rigid
+transformation detection.
+
+Meshes with an implementation-specific index type or vertex format are never
+treated as duplicates.
+@see @ref isMeshIndexTypeImplementationSpecific(),
+    @ref isVertexFormatImplementationSpecific()
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> findDuplicateMeshes(const Containers::Iterable<const Trade::MeshData>& meshes, DuplicateMeshFlags flags = {});
+
+/**
+@brief Replace references to duplicate meshes in a scene
+@param scene        Input scene
+@param duplicates   Duplicate mesh mapping returned from
+    @ref findDuplicateMeshes()
+@m_since_latest
+
+Returns a copy of @p scene with each mesh ID in the @ref Trade::SceneField::Mesh
+field replaced with the ID of the unique mesh it's a duplicate of. The IDs are
+compacted, i.e. a unique mesh @cpp i @ce gets an ID equal to the count of
+unique meshes before it, matching the order in which the meshes are returned
+from @ref deduplicateMeshes().
+
+If a mesh is a duplicate with a non-identity transformation, its
+@ref Trade::SceneField::Mesh and @relativeref{Trade::SceneField,MeshMaterial}
+entries are moved to a new object, which is added as a child of the original
+object with the transformation applied. The new objects are numbered from
+@ref Trade::SceneData::mappingBound() of the original scene. If the scene has a
+@ref Trade::SceneField::Transformation, it's extended with the new
+transformations, otherwise if it has @relativeref{Trade::SceneField,Translation},
+@relativeref{Trade::SceneField,Rotation} or
+@relativeref{Trade::SceneField,Scaling} fields, those are extended, with a
+@ref Trade::SceneFieldType::Vector3 translation and
+@ref Trade::SceneFieldType::Quaternion rotation field added if not present
+already. If it has neither, a new @ref Trade::SceneFieldType::Matrix4x4
+transformation field is added. The @ref Trade::SceneField::Parent field is converted to
+@ref Trade::SceneFieldType::Int in that case. Other fields sharing the object
+mapping with the mesh field are left on the original object.
+
+Expects that all mesh IDs in the @ref Trade::SceneField::Mesh field are less
+than size of @p duplicates. If any objects need to be added, expects that the
+scene has a @ref Trade::SceneField::Parent field, isn't 2D and that the new
+object count is representable with @ref Trade::SceneData::mappingType(). The
+mesh field in the output is always @ref Trade::SceneFieldType::UnsignedInt,
+other fields have the original types. This function will unconditionally make
+a copy of all data.
+@see @ref Trade::SceneData::is2D()
+*/
+MAGNUM_SCENETOOLS_EXPORT Trade::SceneData deduplicateMeshReferences(const Trade::SceneData& scene, const Containers::StridedArrayView1D<const Containers::Pair<UnsignedInt, Matrix4>>& duplicates);
+
+/**
+@brief Remove duplicate meshes from a scene
+@param scene    Input scene
+@param meshes   Meshes referenced by the @ref Trade::SceneField::Mesh field
+@param flags    Detection flags
+@m_since_latest
+
+Finds duplicates in @p meshes using @ref findDuplicateMeshes(), updates the
+scene using @ref deduplicateMeshReferences() and returns it together with the
+unique meshes, moved out of @p meshes. The amount of memory saved is then the
+sum of @ref Trade::MeshData::indexData() and
+@relativeref{Trade::MeshData,vertexData()} sizes of the meshes that were
+dropped.
+
+If there's more than one scene referencing the same meshes, call
+@ref findDuplicateMeshes() once and then @ref deduplicateMeshReferences() on
+each scene instead.
+
+@snippet MagnumSceneTools.cpp deduplicateMeshes
+*/
+MAGNUM_SCENETOOLS_EXPORT Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> deduplicateMeshes(const Trade::SceneData& scene, Containers::Array<Trade::MeshData>&& meshes, DuplicateMeshFlags flags = {});
+
+}}
+
+#endif
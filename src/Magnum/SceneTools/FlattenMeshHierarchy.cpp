@@ -27,14 +27,17 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Containers/BitArray.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Pair.h>
 #include <Corrade/Containers/Triple.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Implementation/Threads.h"
 #include "Magnum/Trade/SceneData.h"
 #include "Magnum/SceneTools/OrderClusterParents.h"
 
@@ -50,6 +53,9 @@ template<> struct SceneDataDimensionTraits<2> {
     static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix3>& transformationDestination) {
         return scene.transformations2DInto(mappingDestination, transformationDestination);
     }
+    static Containers::Optional<Matrix3> transformationFor(const Trade::SceneData& scene, const UnsignedInt object) {
+        return scene.transformation2DFor(object);
+    }
 };
 template<> struct SceneDataDimensionTraits<3> {
     static bool isDimensions(const Trade::SceneData& scene) {
@@ -58,9 +64,57 @@ template<> struct SceneDataDimensionTraits<3> {
     static void transformationsInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<UnsignedInt>& mappingDestination, const Containers::StridedArrayView1D<Matrix4>& transformationDestination) {
         return scene.transformations3DInto(mappingDestination, transformationDestination);
     }
+    static Containers::Optional<Matrix4> transformationFor(const Trade::SceneData& scene, const UnsignedInt object) {
+        return scene.transformation3DFor(object);
+    }
 };
 
-template<UnsignedInt dimensions> void flattenMeshHierarchyIntoImplementation(const Trade::SceneData& scene, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& outputTransformations, const MatrixTypeFor<dimensions, Float>& globalTransformation) {
+/* Offsets of depth levels in the orderClusterParents() output, with the last
+   item being the total size. The output is ordered breadth-first, so each
+   level is a contiguous range and depends only on the levels before. If
+   there's not enough objects to make use of multiple threads, returns just a
+   single range to not waste time on calculating the levels. */
+Containers::Array<UnsignedInt> levelOffsetsFor(const Containers::ArrayView<const Containers::Pair<UnsignedInt, Int>> orderedClusteredParents, const UnsignedLong mappingBound, const UnsignedInt threadCount) {
+    Containers::Array<UnsignedInt> out;
+    arrayAppend(out, 0u);
+    if(MeshTools::Implementation::threadCountFor(threadCount, orderedClusteredParents.size()) != 1) {
+        Containers::Array<UnsignedInt> depths{NoInit, std::size_t(mappingBound + 1)};
+        depths[0] = 0;
+        UnsignedInt currentDepth = 1;
+        for(std::size_t i = 0; i != orderedClusteredParents.size(); ++i) {
+            const UnsignedInt depth = depths[orderedClusteredParents[i].second() + 1] + 1;
+            depths[orderedClusteredParents[i].first() + 1] = depth;
+            if(depth != currentDepth) {
+                arrayAppend(out, UnsignedInt(i));
+                currentDepth = depth;
+            }
+        }
+    }
+    arrayAppend(out, UnsignedInt(orderedClusteredParents.size()));
+    return out;
+}
+
+/* Turns relative transformations into absolute, with levels split across
+   threads. Both are indexed by object ID + 1, with the first element being
+   the global transformation. The views can be the same, as each item is read
+   just before the same item is written. */
+template<class T> void absoluteTransformationsInto(const Containers::ArrayView<const Containers::Pair<UnsignedInt, Int>> orderedClusteredParents, const Containers::ArrayView<const UnsignedInt> levelOffsets, const UnsignedInt threadCount, const Containers::ArrayView<const T> relativeTransformations, const Containers::ArrayView<T> absoluteTransformations) {
+    for(std::size_t level = 0; level + 1 < levelOffsets.size(); ++level) {
+        const std::size_t begin = levelOffsets[level];
+        const std::size_t size = levelOffsets[level + 1] - begin;
+        const std::size_t levelThreadCount = MeshTools::Implementation::threadCountFor(threadCount, size);
+        MeshTools::Implementation::runOnThreads(levelThreadCount, [&](const std::size_t thread) {
+            for(std::size_t i = begin + size*thread/levelThreadCount, iMax = begin + size*(thread + 1)/levelThreadCount; i != iMax; ++i) {
+                const Containers::Pair<UnsignedInt, Int>& parentOffset = orderedClusteredParents[i];
+                absoluteTransformations[parentOffset.first() + 1] =
+                    absoluteTransformations[parentOffset.second() + 1]*
+                    relativeTransformations[parentOffset.first() + 1];
+            }
+        });
+    }
+}
+
+template<UnsignedInt dimensions> void flattenMeshHierarchyIntoImplementation(const Trade::SceneData& scene, const Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>>& outputTransformations, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount) {
     CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
         "SceneTools::flattenMeshHierarchy(): the scene is not" << dimensions << Debug::nospace << "D", );
     const Containers::Optional<UnsignedInt> parentFieldId = scene.findFieldId(Trade::SceneField::Parent);
@@ -105,11 +159,7 @@ template<UnsignedInt dimensions> void flattenMeshHierarchyIntoImplementation(con
     }
 
     /* Turn the transformations into absolute */
-    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: orderedClusteredParents) {
-        absoluteTransformations[parentOffset.first() + 1] =
-            absoluteTransformations[parentOffset.second() + 1]*
-            absoluteTransformations[parentOffset.first() + 1];
-    }
+    absoluteTransformationsInto<MatrixTypeFor<dimensions, Float>>(orderedClusteredParents, levelOffsetsFor(orderedClusteredParents, scene.mappingBound(), threadCount), threadCount, absoluteTransformations, absoluteTransformations);
 
     /* Allocate the output array, retrieve mesh & material IDs and assign
        absolute transformations to each. The matrix location is abused for
@@ -132,7 +182,7 @@ template<UnsignedInt dimensions> Containers::Array<Containers::Triple<UnsignedIn
     Containers::Array<Containers::Triple<UnsignedInt, Int, MatrixTypeFor<dimensions, Float>>> out{NoInit, meshFieldId ? scene.fieldSize(*meshFieldId) : 0};
     flattenMeshHierarchyIntoImplementation<dimensions>(scene,
         stridedArrayView(out).slice(&decltype(out)::Type::third),
-        globalTransformation);
+        globalTransformation, 1);
 
     /* Fetch the additional mesh and material ID as well, which are in the
        same order */
@@ -154,11 +204,15 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix3>> flattenMeshHier
 }
 
 void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation) {
-    return flattenMeshHierarchyIntoImplementation<2>(scene, transformations, globalTransformation);
+    return flattenMeshHierarchyIntoImplementation<2>(scene, transformations, globalTransformation, 1);
 }
 
 void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations) {
-    return flattenMeshHierarchyIntoImplementation<2>(scene, transformations, {});
+    return flattenMeshHierarchyIntoImplementation<2>(scene, transformations, {}, 1);
+}
+
+void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyIntoImplementation<2>(scene, transformations, globalTransformation, threadCount);
 }
 
 Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHierarchy3D(const Trade::SceneData& scene, const Matrix4& globalTransformation) {
@@ -170,11 +224,147 @@ Containers::Array<Containers::Triple<UnsignedInt, Int, Matrix4>> flattenMeshHier
 }
 
 void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation) {
-    return flattenMeshHierarchyIntoImplementation<3>(scene, transformations, globalTransformation);
+    return flattenMeshHierarchyIntoImplementation<3>(scene, transformations, globalTransformation, 1);
 }
 
 void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations) {
-    return flattenMeshHierarchyIntoImplementation<3>(scene, transformations, {});
+    return flattenMeshHierarchyIntoImplementation<3>(scene, transformations, {}, 1);
+}
+
+void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation, const UnsignedInt threadCount) {
+    return flattenMeshHierarchyIntoImplementation<3>(scene, transformations, globalTransformation, threadCount);
+}
+
+template<UnsignedInt dimensions> struct FlattenedMeshHierarchy<dimensions>::State {
+    explicit State(const Trade::SceneData& scene): scene(scene) {}
+
+    const Trade::SceneData& scene;
+    Containers::Array<Containers::Pair<UnsignedInt, Int>> orderedClusteredParents;
+    /* Indexed by object ID + 1, with the first element being the global
+       transformation */
+    Containers::Array<MatrixTypeFor<dimensions, Float>> relativeTransformations;
+    Containers::Array<MatrixTypeFor<dimensions, Float>> absoluteTransformations;
+    /* Object mapping of the mesh field and the output */
+    Containers::Array<UnsignedInt> meshMapping;
+    Containers::Array<MatrixTypeFor<dimensions, Float>> transformations;
+    /* Objects to update, indexed the same as the transformations. Kept
+       around to not allocate on every update, all bits are zero between the
+       updates. */
+    Containers::BitArray dirty;
+};
+
+template<UnsignedInt dimensions> FlattenedMeshHierarchy<dimensions>::FlattenedMeshHierarchy(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation, const UnsignedInt threadCount): _state{InPlaceInit, scene} {
+    CORRADE_ASSERT(SceneDataDimensionTraits<dimensions>::isDimensions(scene),
+        "SceneTools::FlattenedMeshHierarchy: the scene is not" << dimensions << Debug::nospace << "D", );
+    CORRADE_ASSERT(scene.hasField(Trade::SceneField::Parent),
+        "SceneTools::FlattenedMeshHierarchy: the scene has no hierarchy", );
+
+    const std::size_t objectCount = scene.mappingBound() + 1;
+    _state->orderedClusteredParents = orderClusterParents(scene);
+    _state->relativeTransformations = Containers::Array<MatrixTypeFor<dimensions, Float>>{ValueInit, objectCount};
+    _state->absoluteTransformations = Containers::Array<MatrixTypeFor<dimensions, Float>>{NoInit, objectCount};
+    _state->dirty = Containers::BitArray{ValueInit, objectCount};
+
+    /* Retrieve relative transformations of all objects, the same as in
+       flattenMeshHierarchyIntoImplementation() */
+    {
+        Containers::Array<Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>> transformations{NoInit, scene.transformationFieldSize()};
+        SceneDataDimensionTraits<dimensions>::transformationsInto(scene,
+            stridedArrayView(transformations).slice(&decltype(transformations)::Type::first),
+            stridedArrayView(transformations).slice(&decltype(transformations)::Type::second));
+        _state->relativeTransformations[0] = globalTransformation;
+        for(const Containers::Pair<UnsignedInt, MatrixTypeFor<dimensions, Float>>& transformation: transformations) {
+            CORRADE_INTERNAL_ASSERT(transformation.first() < scene.mappingBound());
+            _state->relativeTransformations[transformation.first() + 1] = transformation.second();
+        }
+    }
+
+    /* Calculate the absolute transformations. Objects that are not in the
+       hierarchy get their relative transformation, which is as good as any
+       other unspecified value. */
+    Utility::copy(_state->relativeTransformations, _state->absoluteTransformations);
+    absoluteTransformationsInto<MatrixTypeFor<dimensions, Float>>(_state->orderedClusteredParents, levelOffsetsFor(_state->orderedClusteredParents, scene.mappingBound(), threadCount), threadCount, _state->relativeTransformations, _state->absoluteTransformations);
+
+    /* Build object index for the transformation fields, so the per-object
+       lookups in update() aren't linear. Does nothing for fields that have
+       an ordered or implicit mapping or that already have an index. */
+    for(const Trade::SceneField field: {Trade::SceneField::Transformation,
+                                        Trade::SceneField::Translation,
+                                        Trade::SceneField::Rotation,
+                                        Trade::SceneField::Scaling})
+        if(scene.hasField(field)) scene.buildFieldObjectIndex(field);
+
+    /* Assign the absolute transformations to meshes */
+    if(const Containers::Optional<UnsignedInt> meshFieldId = scene.findFieldId(Trade::SceneField::Mesh)) {
+        _state->meshMapping = scene.mappingAsArray(*meshFieldId);
+        _state->transformations = Containers::Array<MatrixTypeFor<dimensions, Float>>{NoInit, _state->meshMapping.size()};
+        for(std::size_t i = 0; i != _state->meshMapping.size(); ++i) {
+            CORRADE_INTERNAL_ASSERT(_state->meshMapping[i] < scene.mappingBound());
+            _state->transformations[i] = _state->absoluteTransformations[_state->meshMapping[i] + 1];
+        }
+    }
+}
+
+template<UnsignedInt dimensions> FlattenedMeshHierarchy<dimensions>::FlattenedMeshHierarchy(const Trade::SceneData& scene, const UnsignedInt threadCount): FlattenedMeshHierarchy{scene, {}, threadCount} {}
+
+template<UnsignedInt dimensions> FlattenedMeshHierarchy<dimensions>::FlattenedMeshHierarchy(FlattenedMeshHierarchy<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> FlattenedMeshHierarchy<dimensions>::~FlattenedMeshHierarchy() = default;
+
+template<UnsignedInt dimensions> FlattenedMeshHierarchy<dimensions>& FlattenedMeshHierarchy<dimensions>::operator=(FlattenedMeshHierarchy<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> FlattenedMeshHierarchy<dimensions>::transformations() const {
+    return _state->transformations;
 }
 
+template<UnsignedInt dimensions> void FlattenedMeshHierarchy<dimensions>::update(const Containers::StridedArrayView1D<const UnsignedInt>& objects) {
+    State& state = *_state;
+    const UnsignedLong mappingBound = state.scene.mappingBound();
+
+    /* Fetch new relative transformations of the objects and mark them for
+       update. Same as in the constructor, objects that are not in the
+       hierarchy get their relative transformation as the absolute one, for
+       the rest it gets overwritten below. */
+    for(const UnsignedInt object: objects) {
+        CORRADE_ASSERT(object < mappingBound,
+            "SceneTools::FlattenedMeshHierarchy::update(): object" << object << "out of bounds for" << mappingBound << "objects", );
+        const Containers::Optional<MatrixTypeFor<dimensions, Float>> transformation = SceneDataDimensionTraits<dimensions>::transformationFor(state.scene, object);
+        state.relativeTransformations[object + 1] =
+            state.absoluteTransformations[object + 1] =
+                transformation ? *transformation : MatrixTypeFor<dimensions, Float>{};
+        state.dirty.set(object + 1);
+    }
+
+    /* Recalculate the marked objects and everything below them. As the
+       parents are always before their children, marking a child while
+       going through the list makes its own children updated as well. */
+    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: state.orderedClusteredParents) {
+        if(!state.dirty[parentOffset.first() + 1] && !state.dirty[parentOffset.second() + 1])
+            continue;
+        state.absoluteTransformations[parentOffset.first() + 1] =
+            state.absoluteTransformations[parentOffset.second() + 1]*
+            state.relativeTransformations[parentOffset.first() + 1];
+        state.dirty.set(parentOffset.first() + 1);
+    }
+
+    /* Update meshes attached to the marked objects */
+    for(std::size_t i = 0; i != state.meshMapping.size(); ++i)
+        if(state.dirty[state.meshMapping[i] + 1])
+            state.transformations[i] = state.absoluteTransformations[state.meshMapping[i] + 1];
+
+    /* Clear the marks for the next time. All marked objects are either in the
+       list of updated objects or in the hierarchy. */
+    for(const UnsignedInt object: objects)
+        state.dirty.reset(object + 1);
+    for(const Containers::Pair<UnsignedInt, Int>& parentOffset: state.orderedClusteredParents)
+        state.dirty.reset(parentOffset.first() + 1);
+}
+
+template<UnsignedInt dimensions> void FlattenedMeshHierarchy<dimensions>::update(const std::initializer_list<UnsignedInt> objects) {
+    update(Containers::arrayView(objects));
+}
+
+template class MAGNUM_SCENETOOLS_EXPORT FlattenedMeshHierarchy<2>;
+template class MAGNUM_SCENETOOLS_EXPORT FlattenedMeshHierarchy<3>;
+
 }}
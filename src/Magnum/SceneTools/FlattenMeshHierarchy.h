@@ -26,10 +26,14 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D()
+ * @brief Function @ref Magnum::SceneTools::flattenMeshHierarchy2D(), @ref Magnum::SceneTools::flattenMeshHierarchy3D(), class @ref Magnum::SceneTools::FlattenedMeshHierarchy, typedef @ref Magnum::SceneTools::FlattenedMeshHierarchy2D, @ref Magnum::SceneTools::FlattenedMeshHierarchy3D
  * @m_since_latest
  */
 
+#include <initializer_list>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/DimensionTraits.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/SceneTools/visibility.h"
 #include "Magnum/Trade/Trade.h"
@@ -93,6 +97,8 @@ transformations together with object and mesh IDs, but ignoring materials:
 @snippet MagnumSceneTools.cpp flattenMeshHierarchy2DInto
 
 @experimental
+
+@see @ref FlattenedMeshHierarchy2D
 */
 #ifdef DOXYGEN_GENERATING_OUTPUT
 MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation = {});
@@ -102,6 +108,26 @@ MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy2DInto(const Trade::SceneData&
 MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations);
 #endif
 
+/**
+@brief Flatten a 2D mesh hierarchy into an existing array using multiple threads
+@param[in]  scene           Input scene
+@param[out] transformations Where to put the calculated transformations
+@param[in]  globalTransformation Global transformation to prepend
+@param[in]  threadCount     Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+Produces the exact same output as
+@ref flattenMeshHierarchy2DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix3>&, const Matrix3&),
+but the absolute transformations of each depth level of the hierarchy are
+calculated in parallel. At most one thread is used for every 16384 objects in
+a level, if there's not enough objects or the platform doesn't support
+threads, the operation is done on the calling thread.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy2DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix3>& transformations, const Matrix3& globalTransformation, UnsignedInt threadCount);
+
 /**
 @brief Flatten a 3D mesh hierarchy
 @m_since_latest
@@ -159,6 +185,8 @@ transformations together with object and mesh IDs, but ignoring materials:
 @snippet MagnumSceneTools.cpp flattenMeshHierarchy3DInto
 
 @experimental
+
+@see @ref FlattenedMeshHierarchy3D
 */
 #ifdef DOXYGEN_GENERATING_OUTPUT
 MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation = {});
@@ -168,6 +196,153 @@ MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy3DInto(const Trade::SceneData&
 MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations);
 #endif
 
+/**
+@brief Flatten a 3D mesh hierarchy into an existing array using multiple threads
+@param[in]  scene           Input scene
+@param[out] transformations Where to put the calculated transformations
+@param[in]  globalTransformation Global transformation to prepend
+@param[in]  threadCount     Count of threads to use. If @cpp 0 @ce, uses
+    @ref std::thread::hardware_concurrency().
+@m_since_latest
+
+Produces the exact same output as
+@ref flattenMeshHierarchy3DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix4>&, const Matrix4&),
+but the absolute transformations of each depth level of the hierarchy are
+calculated in parallel. At most one thread is used for every 16384 objects in
+a level, if there's not enough objects or the platform doesn't support
+threads, the operation is done on the calling thread.
+
+@experimental
+*/
+MAGNUM_SCENETOOLS_EXPORT void flattenMeshHierarchy3DInto(const Trade::SceneData& scene, const Containers::StridedArrayView1D<Matrix4>& transformations, const Matrix4& globalTransformation, UnsignedInt threadCount);
+
+/**
+@brief Incrementally updated flattened mesh hierarchy
+@m_since_latest
+
+Calculates the same transformations as @ref flattenMeshHierarchy2DInto() /
+@ref flattenMeshHierarchy3DInto() on construction, but keeps the relative and
+absolute transformations of all objects around so when just a few
+transformations in the scene change, only subtrees of the changed objects get
+recalculated by @ref update(). Useful for example in an editor, where the
+scene gets modified in-place and only a small part of it changes every frame:
+
+@snippet MagnumSceneTools.cpp FlattenedMeshHierarchy
+
+The class keeps a reference to the scene, which is expected to stay in scope
+for the whole instance lifetime. The hierarchy, i.e. the
+@ref Trade::SceneField::Parent and @ref Trade::SceneField::Mesh fields, is
+expected to stay the same, in case it changes a new instance has to be
+created. Besides the @ref Trade::SceneData::mappingBound() sized arrays with
+relative and absolute object transformations, the instance stores a copy of the
+@ref orderClusterParents() output and the @ref Trade::SceneField::Mesh object
+mapping. The constructor additionally builds an object index for the
+transformation fields in @p scene, see @ref update() for details.
+
+@experimental
+
+@see @ref FlattenedMeshHierarchy2D, @ref FlattenedMeshHierarchy3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_SCENETOOLS_EXPORT FlattenedMeshHierarchy {
+    public:
+        /**
+         * @brief Constructor
+         * @param scene         Input scene
+         * @param globalTransformation Global transformation to prepend
+         * @param threadCount   Count of threads to use for calculating the
+         *      initial transformations. If @cpp 0 @ce, uses
+         *      @ref std::thread::hardware_concurrency().
+         *
+         * The same requirements as in @ref flattenMeshHierarchy2D() /
+         * @ref flattenMeshHierarchy3D() are imposed on @p scene. The
+         * @p threadCount has the same semantics as in
+         * @ref flattenMeshHierarchy3DInto(const Trade::SceneData&, const Containers::StridedArrayView1D<Matrix4>&, const Matrix4&, UnsignedInt).
+         */
+        explicit FlattenedMeshHierarchy(const Trade::SceneData& scene, const MatrixTypeFor<dimensions, Float>& globalTransformation, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Construct with an identity global transformation
+         *
+         * Equivalent to calling @ref FlattenedMeshHierarchy(const Trade::SceneData&, const MatrixTypeFor<dimensions, Float>&, UnsignedInt)
+         * with an identity matrix.
+         */
+        explicit FlattenedMeshHierarchy(const Trade::SceneData& scene, UnsignedInt threadCount = 1);
+
+        /** @brief Copying is not allowed */
+        FlattenedMeshHierarchy(const FlattenedMeshHierarchy<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        FlattenedMeshHierarchy(FlattenedMeshHierarchy<dimensions>&&) noexcept;
+
+        ~FlattenedMeshHierarchy();
+
+        /** @brief Copying is not allowed */
+        FlattenedMeshHierarchy<dimensions>& operator=(const FlattenedMeshHierarchy<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        FlattenedMeshHierarchy<dimensions>& operator=(FlattenedMeshHierarchy<dimensions>&&) noexcept;
+
+        /**
+         * @brief Absolute mesh transformations
+         *
+         * The view has the same size and order as the
+         * @ref Trade::SceneField::Mesh field, the contents are the same as
+         * what @ref flattenMeshHierarchy2DInto() /
+         * @ref flattenMeshHierarchy3DInto() would produce. Corresponding mesh
+         * and material IDs can be retrieved with
+         * @ref Trade::SceneData::meshesMaterialsInto().
+         */
+        Containers::StridedArrayView1D<const MatrixTypeFor<dimensions, Float>> transformations() const;
+
+        /**
+         * @brief Update transformations of given objects
+         *
+         * Fetches new relative transformations of @p objects from the scene
+         * using @ref Trade::SceneData::transformation2DFor() /
+         * @ref Trade::SceneData::transformation3DFor() and recalculates
+         * absolute transformations of them and all their children. Objects
+         * without a transformation are treated as having an identity. The
+         * constructor builds an object index for the transformation fields
+         * using @ref Trade::SceneData::buildFieldObjectIndex(), so the
+         * lookup of each object is done in a constant time, or logarithmic
+         * in the count of distinct objects in the field if the mapping bound
+         * is much larger than the field size. With that, the operation is
+         * done in an @f$ \mathcal{O}(k + n + m) @f$ execution time, with
+         * @f$ k @f$ being the total size of the updated subtrees, @f$ n @f$
+         * size of the @ref Trade::SceneField::Parent and @f$ m @f$ of the
+         * @ref Trade::SceneField::Mesh field, however only the @f$ k @f$
+         * part involves any matrix multiplication or transformation lookup,
+         * the rest is a linear pass over a bit array.
+         *
+         * Expects that all @p objects are less than
+         * @ref Trade::SceneData::mappingBound(). Duplicates are allowed.
+         */
+        void update(const Containers::StridedArrayView1D<const UnsignedInt>& objects);
+
+        /** @overload */
+        void update(std::initializer_list<UnsignedInt> objects);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Incrementally updated flattened 2D mesh hierarchy
+@m_since_latest
+
+@experimental
+*/
+typedef FlattenedMeshHierarchy<2> FlattenedMeshHierarchy2D;
+
+/**
+@brief Incrementally updated flattened 3D mesh hierarchy
+@m_since_latest
+
+@experimental
+*/
+typedef FlattenedMeshHierarchy<3> FlattenedMeshHierarchy3D;
+
 }}
 
 #endif
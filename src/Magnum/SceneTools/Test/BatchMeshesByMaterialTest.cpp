@@ -0,0 +1,402 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneTools/BatchMeshesByMaterial.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct BatchMeshesByMaterialTest: TestSuite::Tester {
+    explicit BatchMeshesByMaterialTest();
+
+    void test2D();
+    void test3D();
+    void stripsLoopsFans();
+    void noMeshField();
+    void meshOutOfRange();
+};
+
+BatchMeshesByMaterialTest::BatchMeshesByMaterialTest() {
+    addTests({&BatchMeshesByMaterialTest::test2D,
+              &BatchMeshesByMaterialTest::test3D,
+              &BatchMeshesByMaterialTest::stripsLoopsFans,
+              &BatchMeshesByMaterialTest::noMeshField,
+              &BatchMeshesByMaterialTest::meshOutOfRange});
+}
+
+const struct Scene {
+    struct Object {
+        UnsignedInt object;
+        Int parent;
+        Matrix3 transformation2D;
+        Matrix4 transformation3D;
+    } objects[5];
+
+    struct Mesh {
+        UnsignedInt object;
+        UnsignedInt mesh;
+        Int meshMaterial;
+    } meshes[6];
+} SceneData[]{{
+    /* Objects 1 and 3 are children of 0 */
+    {{0, -1, Matrix3::translation({10.0f, 0.0f}),
+             Matrix4::translation({10.0f, 0.0f, 0.0f})},
+     {1, 0, Matrix3::scaling({2.0f, 2.0f}),
+            Matrix4::scaling({2.0f, 2.0f, 2.0f})},
+     {2, -1, Matrix3::translation({0.0f, 5.0f}),
+             Matrix4::translation({0.0f, 5.0f, 0.0f})},
+     {3, 0, {}, {}},
+     {4, -1, Matrix3::translation({-1.0f, 0.0f}),
+             Matrix4::translation({-1.0f, 0.0f, 0.0f})}},
+    /* Meshes 0 and 1 have the same layout, mesh 2 has a different one. The
+       expected batches are, in order of first appearance:
+
+        0:  mesh 0 on object 0, mesh 1 on object 1, mesh 0 on object 3, all
+            with material 7
+        1:  mesh 0 on object 2 with material 3
+        2:  mesh 2 on object 2 with material 7
+        3:  mesh 1 on object 4 with no material */
+    {{0, 0, 7},
+     {2, 0, 3},
+     {1, 1, 7},
+     {2, 2, 7},
+     {4, 1, -1},
+     {3, 0, 7}}
+}};
+
+const Vector2 Positions2DA[]{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}};
+const Vector2 Positions2DB[]{{0.0f, 0.0f}, {0.0f, 2.0f}, {2.0f, 0.0f}};
+const Vector3 Positions3DA[]{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+const Vector3 Positions3DB[]{{0.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}, {2.0f, 0.0f, 0.0f}};
+const struct {
+    Vector3 position;
+    UnsignedInt id;
+} PositionsIds[]{
+    {{0.0f, 0.0f, 1.0f}, 5},
+    {{0.0f, 1.0f, 1.0f}, 6},
+    {{1.0f, 0.0f, 1.0f}, 7},
+};
+const UnsignedShort IndicesA[]{0, 1, 2};
+
+void BatchMeshesByMaterialTest::test2D() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, {}, SceneData, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::object),
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::object),
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::transformation2D)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::meshMaterial)},
+    }};
+
+    const Trade::MeshData meshes[]{
+        /* Indexed and non-indexed meshes with the same attributes get batched
+           together */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, IndicesA, Trade::MeshIndexData{IndicesA},
+            {}, Positions2DA, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(Positions2DA)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, Positions2DB, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(Positions2DB)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, PositionsIds, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                    VertexFormat::Vector2,
+                    Containers::stridedArrayView(PositionsIds).slice(&std::remove_all_extents<decltype(PositionsIds)>::type::position)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                    Containers::stridedArrayView(PositionsIds).slice(&std::remove_all_extents<decltype(PositionsIds)>::type::id)},
+            }}
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshesByMaterial2D(scene, meshes);
+    CORRADE_VERIFY(out.first().is2D());
+    CORRADE_COMPARE(out.first().mappingBound(), 4);
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 7}},
+        {1, {1, 3}},
+        {2, {2, 7}},
+        {3, {3, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, -1},
+        {2, -1},
+        {3, -1},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().transformations2DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix3>>({
+        {0, {}},
+        {1, {}},
+        {2, {}},
+        {3, {}},
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.second().size(), 4);
+
+    /* First batch is mesh 0 on object 0, mesh 1 on object 1 (which is
+       non-indexed, so indices got generated for it) and mesh 0 on object 3 */
+    CORRADE_COMPARE(out.second()[0].primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(out.second()[0].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2,
+        3, 4, 5,
+        6, 7, 8
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[0].positions2DAsArray(), Containers::arrayView<Vector2>({
+        {10.0f, 0.0f}, {11.0f, 0.0f}, {10.0f, 1.0f},
+        {10.0f, 0.0f}, {10.0f, 4.0f}, {14.0f, 0.0f},
+        {10.0f, 0.0f}, {11.0f, 0.0f}, {10.0f, 1.0f},
+    }), TestSuite::Compare::Container);
+
+    /* Second is mesh 0 on object 2 with a different material */
+    CORRADE_COMPARE_AS(out.second()[1].positions2DAsArray(), Containers::arrayView<Vector2>({
+        {0.0f, 5.0f}, {1.0f, 5.0f}, {0.0f, 6.0f},
+    }), TestSuite::Compare::Container);
+
+    /* Third is mesh 2 on object 2, with the object IDs preserved */
+    CORRADE_COMPARE_AS(out.second()[2].positions2DAsArray(), Containers::arrayView<Vector2>({
+        {0.0f, 5.0f}, {0.0f, 6.0f}, {1.0f, 5.0f},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[2].objectIdsAsArray(), Containers::arrayView<UnsignedInt>({
+        5, 6, 7
+    }), TestSuite::Compare::Container);
+
+    /* Fourth is mesh 1 on object 4 */
+    CORRADE_COMPARE_AS(out.second()[3].positions2DAsArray(), Containers::arrayView<Vector2>({
+        {-1.0f, 0.0f}, {-1.0f, 2.0f}, {1.0f, 0.0f},
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesByMaterialTest::test3D() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, {}, SceneData, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::object),
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::object),
+            Containers::stridedArrayView(SceneData->objects)
+                .slice(&Scene::Object::transformation3D)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(SceneData->meshes)
+                .slice(&Scene::Mesh::meshMaterial)},
+    }};
+
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, IndicesA, Trade::MeshIndexData{IndicesA},
+            {}, Positions3DA, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(Positions3DA)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, Positions3DB, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(Positions3DB)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, PositionsIds, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                    Containers::stridedArrayView(PositionsIds).slice(&std::remove_all_extents<decltype(PositionsIds)>::type::position)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId,
+                    Containers::stridedArrayView(PositionsIds).slice(&std::remove_all_extents<decltype(PositionsIds)>::type::id)},
+            }}
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshesByMaterial3D(scene, meshes);
+    CORRADE_VERIFY(out.first().is3D());
+    CORRADE_COMPARE(out.first().mappingBound(), 4);
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 7}},
+        {1, {1, 3}},
+        {2, {2, 7}},
+        {3, {3, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().transformations3DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {1, {}},
+        {2, {}},
+        {3, {}},
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.second().size(), 4);
+    CORRADE_COMPARE_AS(out.second()[0].positions3DAsArray(), Containers::arrayView<Vector3>({
+        {10.0f, 0.0f, 0.0f}, {11.0f, 0.0f, 0.0f}, {10.0f, 1.0f, 0.0f},
+        {10.0f, 0.0f, 0.0f}, {10.0f, 4.0f, 0.0f}, {14.0f, 0.0f, 0.0f},
+        {10.0f, 0.0f, 0.0f}, {11.0f, 0.0f, 0.0f}, {10.0f, 1.0f, 0.0f},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[1].positions3DAsArray(), Containers::arrayView<Vector3>({
+        {0.0f, 5.0f, 0.0f}, {1.0f, 5.0f, 0.0f}, {0.0f, 6.0f, 0.0f},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[2].positions3DAsArray(), Containers::arrayView<Vector3>({
+        {0.0f, 5.0f, 1.0f}, {0.0f, 6.0f, 1.0f}, {1.0f, 5.0f, 1.0f},
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[2].objectIdsAsArray(), Containers::arrayView<UnsignedInt>({
+        5, 6, 7
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[3].positions3DAsArray(), Containers::arrayView<Vector3>({
+        {-1.0f, 0.0f, 0.0f}, {-1.0f, 2.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesByMaterialTest::stripsLoopsFans() {
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        UnsignedInt mesh;
+        Int meshMaterial;
+        Matrix4 transformation;
+    } data[]{
+        {0, -1, 0, 2, {}},
+        {1, -1, 1, 2, Matrix4::translation(Vector3::xAxis(5.0f))},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::meshMaterial)},
+    }};
+
+    const Vector3 stripPositions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+    };
+
+    /* A triangle strip and a triangle list should end up in the same batch */
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::TriangleStrip,
+            {}, stripPositions, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(stripPositions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, Positions3DA, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(Positions3DA)}
+            }},
+    };
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshesByMaterial3D(scene, meshes);
+    CORRADE_COMPARE(out.first().mappingBound(), 1);
+    CORRADE_COMPARE(out.second().size(), 1);
+    CORRADE_COMPARE(out.second()[0].primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(out.second()[0].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 2, 1, 3,
+        4, 5, 6
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[0].positions3DAsArray(), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f},
+        {5.0f, 0.0f, 0.0f}, {6.0f, 0.0f, 0.0f}, {5.0f, 1.0f, 0.0f},
+    }), TestSuite::Compare::Container);
+}
+
+void BatchMeshesByMaterialTest::noMeshField() {
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    /* This should not blow up, just return nothing */
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = batchMeshesByMaterial3D(scene, {});
+    CORRADE_COMPARE(out.first().mappingBound(), 0);
+    CORRADE_VERIFY(out.first().is3D());
+    CORRADE_COMPARE(out.second().size(), 0);
+}
+
+void BatchMeshesByMaterialTest::meshOutOfRange() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        UnsignedInt mesh;
+    } data[]{
+        {0, -1, 0},
+        {1, -1, 2},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles, 3},
+        Trade::MeshData{MeshPrimitive::Triangles, 3},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    batchMeshesByMaterial3D(scene, meshes);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::batchMeshesByMaterial(): mesh 2 out of range for 2 meshes\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::BatchMeshesByMaterialTest)
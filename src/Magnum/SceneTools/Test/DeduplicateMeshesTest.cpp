@@ -0,0 +1,650 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Iterable.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StringIterable.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Containers/Triple.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/SceneTools/DeduplicateMeshes.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneTools { namespace Test { namespace {
+
+struct DeduplicateMeshesTest: TestSuite::Tester {
+    explicit DeduplicateMeshesTest();
+
+    void find();
+    void findImplementationSpecific();
+    void findRigid();
+
+    void referencesNoNewObjects();
+    void referencesTransformation();
+    void referencesTranslationScaling();
+    void referencesNoTransformation();
+    void referencesStringField();
+    void referencesInvalid();
+
+    void deduplicate();
+};
+
+DeduplicateMeshesTest::DeduplicateMeshesTest() {
+    addTests({&DeduplicateMeshesTest::find,
+              &DeduplicateMeshesTest::findImplementationSpecific,
+              &DeduplicateMeshesTest::findRigid,
+
+              &DeduplicateMeshesTest::referencesNoNewObjects,
+              &DeduplicateMeshesTest::referencesTransformation,
+              &DeduplicateMeshesTest::referencesTranslationScaling,
+              &DeduplicateMeshesTest::referencesNoTransformation,
+              &DeduplicateMeshesTest::referencesStringField,
+              &DeduplicateMeshesTest::referencesInvalid,
+
+              &DeduplicateMeshesTest::deduplicate});
+}
+
+using namespace Containers::Literals;
+using namespace Math::Literals;
+
+const struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+} Vertices[]{
+    {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+    {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+    {{0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}},
+};
+const Vertex VerticesScaled[]{
+    {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}},
+    {{2.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}},
+    {{0.0f, 2.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{0.0f, 0.0f, 2.0f}, {0.0f, 0.0f, -1.0f}},
+};
+/* Same as Vertices, just not interleaved */
+const struct NonInterleaved {
+    Vector3 positions[4];
+    Vector3 normals[4];
+} VerticesNonInterleaved[]{{
+    {{0.0f, 0.0f, 0.0f},
+     {1.0f, 0.0f, 0.0f},
+     {0.0f, 1.0f, 0.0f},
+     {0.0f, 0.0f, 1.0f}},
+    {{1.0f, 0.0f, 0.0f},
+     {0.0f, 1.0f, 0.0f},
+     {0.0f, 0.0f, 1.0f},
+     {0.0f, 0.0f, -1.0f}}
+}};
+const UnsignedShort Indices[]{0, 1, 2, 0, 2, 3, 0, 3, 1};
+const UnsignedShort IndicesFlipped[]{0, 2, 1, 0, 3, 2, 0, 1, 3};
+
+Trade::MeshData interleavedMesh(const Containers::ArrayView<const UnsignedShort> indices, const Containers::StridedArrayView1D<const Vertex>& vertices) {
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, vertices.slice(&Vertex::normal)}
+        }};
+}
+
+void DeduplicateMeshesTest::find() {
+    const Trade::MeshData meshes[]{
+        interleavedMesh(Indices, Vertices),
+        /* Different positions */
+        interleavedMesh(Indices, VerticesScaled),
+        /* Same as the first, just with a non-interleaved layout */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, Indices, Trade::MeshIndexData{Indices},
+            {}, VerticesNonInterleaved, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(VerticesNonInterleaved->positions)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::arrayView(VerticesNonInterleaved->normals)}
+            }},
+        /* Different index data */
+        interleavedMesh(IndicesFlipped, Vertices),
+        /* Different primitive */
+        Trade::MeshData{MeshPrimitive::Points,
+            {}, Indices, Trade::MeshIndexData{Indices},
+            {}, Vertices, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::stridedArrayView(Vertices).slice(&Vertex::position)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::stridedArrayView(Vertices).slice(&Vertex::normal)}
+            }},
+        /* Different attribute order */
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, Indices, Trade::MeshIndexData{Indices},
+            {}, Vertices, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::stridedArrayView(Vertices).slice(&Vertex::normal)},
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::stridedArrayView(Vertices).slice(&Vertex::position)}
+            }},
+        /* Same as the second */
+        interleavedMesh(Indices, VerticesScaled),
+    };
+
+    CORRADE_COMPARE_AS(findDuplicateMeshes(meshes), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {1, {}},
+        {0, {}},
+        {3, {}},
+        {4, {}},
+        {5, {}},
+        {1, {}},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::findImplementationSpecific() {
+    /* Bitwise equal but can't be compared as the format size isn't known */
+    const Trade::MeshData meshes[]{
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, VerticesNonInterleaved, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertexFormatWrap(0xcaca), Containers::arrayView(VerticesNonInterleaved->positions)}
+            }},
+        Trade::MeshData{MeshPrimitive::Triangles,
+            {}, VerticesNonInterleaved, {
+                Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertexFormatWrap(0xcaca), Containers::arrayView(VerticesNonInterleaved->positions)}
+            }},
+    };
+
+    CORRADE_COMPARE_AS(findDuplicateMeshes(meshes), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {1, {}},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::findRigid() {
+    const Matrix4 transformation = Matrix4::translation({1.0f, -2.0f, 3.0f})*Matrix4::rotation(35.0_degf, Vector3{1.0f, 2.0f, -0.5f}.normalized());
+    const Matrix4 mirror = Matrix4::scaling({-1.0f, 1.0f, 1.0f});
+    Vertex transformed[Containers::arraySize(Vertices)];
+    Vertex mirrored[Containers::arraySize(Vertices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i) {
+        transformed[i].position = transformation.transformPoint(Vertices[i].position);
+        transformed[i].normal = transformation.transformVector(Vertices[i].normal);
+        mirrored[i].position = mirror.transformPoint(Vertices[i].position);
+        mirrored[i].normal = mirror.transformVector(Vertices[i].normal);
+    }
+
+    /* Only the positions are transformed, normals aren't */
+    Vertex transformedPositions[Containers::arraySize(Vertices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i) {
+        transformedPositions[i].position = transformed[i].position;
+        transformedPositions[i].normal = Vertices[i].normal;
+    }
+
+    const Trade::MeshData meshes[]{
+        interleavedMesh(Indices, Vertices),
+        interleavedMesh(Indices, transformed),
+        /* Exact duplicate of the transformed mesh, should point to the first
+           with the transformation as well */
+        interleavedMesh(Indices, transformed),
+        /* A reflection isn't a rigid transformation */
+        interleavedMesh(Indices, mirrored),
+        interleavedMesh(Indices, transformedPositions),
+        /* Different index data */
+        interleavedMesh(IndicesFlipped, transformed),
+    };
+
+    /* Without the flag only the exact duplicate is found */
+    CORRADE_COMPARE_AS(findDuplicateMeshes(meshes), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {1, {}},
+        {1, {}},
+        {3, {}},
+        {4, {}},
+        {5, {}},
+    })), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE_AS(findDuplicateMeshes(meshes, DuplicateMeshFlag::RigidTransformations), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {0, transformation},
+        {0, transformation},
+        {3, {}},
+        {4, {}},
+        {5, {}},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::referencesNoNewObjects() {
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        UnsignedShort mesh;
+        Int meshMaterial;
+    } data[]{
+        {0, -1, 1, 5},
+        {1, 0, 2, 6},
+        {2, -1, 0, -1},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 3, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::meshMaterial)},
+    }};
+
+    const Containers::Pair<UnsignedInt, Matrix4> duplicates[]{
+        {0, {}},
+        {0, {}},
+        {2, {}},
+    };
+
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+    CORRADE_COMPARE(out.mappingBound(), 3);
+    CORRADE_COMPARE(out.fieldCount(), 3);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Mesh), Trade::SceneFieldType::UnsignedInt);
+    CORRADE_COMPARE_AS(out.meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 5}},
+        {1, {1, 6}},
+        {2, {0, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, 0},
+        {2, -1},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::referencesTransformation() {
+    const struct Data {
+        struct Object {
+            UnsignedShort object;
+            Short parent;
+            Matrix4 transformation;
+        } objects[3];
+
+        struct Mesh {
+            UnsignedShort object;
+            UnsignedInt mesh;
+            Int meshMaterial;
+        } meshes[4];
+    } data[]{{
+        {{0, -1, Matrix4::translation(Vector3::xAxis(5.0f))},
+         {1, 0, {}},
+         {2, -1, Matrix4::scaling(Vector3{2.0f})}},
+        {{0, 0, 5},
+         {1, 1, 6},
+         {2, 2, -1},
+         {2, 1, 7}}
+    }};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 3, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::object),
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::parent),
+            Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::object),
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::transformation),
+            Trade::SceneFieldFlag::ImplicitMapping},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data->meshes)
+                .slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data->meshes)
+                .slice(&Data::Mesh::mesh)},
+        Trade::SceneFieldData{Trade::SceneField::MeshMaterial,
+            Containers::stridedArrayView(data->meshes)
+                .slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data->meshes)
+                .slice(&Data::Mesh::meshMaterial)},
+    }};
+
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(90.0_degf);
+    const Containers::Pair<UnsignedInt, Matrix4> duplicates[]{
+        {0, {}},
+        {0, transformation},
+        {2, {}},
+    };
+
+    /* The references to mesh 1 get moved to new objects 3 and 4, which are
+       children of the original objects */
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+    CORRADE_COMPARE(out.mappingType(), Trade::SceneMappingType::UnsignedShort);
+    CORRADE_COMPARE(out.mappingBound(), 5);
+    CORRADE_COMPARE(out.fieldCount(), 4);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Parent), Trade::SceneFieldType::Int);
+    CORRADE_COMPARE(out.fieldFlags(Trade::SceneField::Parent), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE(out.fieldFlags(Trade::SceneField::Transformation), Trade::SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(out.meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, 5}},
+        {3, {0, 6}},
+        {2, {1, -1}},
+        {4, {0, 7}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, 0},
+        {2, -1},
+        {3, 1},
+        {4, 2},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.transformations3DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, Matrix4::translation(Vector3::xAxis(5.0f))},
+        {1, {}},
+        {2, Matrix4::scaling(Vector3{2.0f})},
+        {3, transformation},
+        {4, transformation},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::referencesTranslationScaling() {
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        Vector3d translation;
+        Vector3d scaling;
+        UnsignedInt mesh;
+    } data[]{
+        {0, -1, {1.0, 0.0, 0.0}, {2.0, 2.0, 2.0}, 1},
+        {1, 0, {}, {1.0, 1.0, 1.0}, 0},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Translation,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::translation)},
+        Trade::SceneFieldData{Trade::SceneField::Scaling,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::scaling)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(90.0_degf);
+    const Containers::Pair<UnsignedInt, Matrix4> duplicates[]{
+        {0, {}},
+        {0, transformation},
+    };
+
+    /* The scene has no rotation field, so it gets added, with an identity
+       for the original objects */
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+    CORRADE_COMPARE(out.mappingBound(), 3);
+    CORRADE_COMPARE(out.fieldCount(), 5);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Translation), Trade::SceneFieldType::Vector3d);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Rotation), Trade::SceneFieldType::Quaternion);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Scaling), Trade::SceneFieldType::Vector3d);
+    CORRADE_COMPARE_AS(out.meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {2, {0, -1}},
+        {1, {0, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, 0},
+        {2, 0},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.translationsRotationsScalings3DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Triple<Vector3, Quaternion, Vector3>>>({
+        {0, {{1.0f, 0.0f, 0.0f}, {}, Vector3{2.0f}}},
+        {1, {{}, {}, Vector3{1.0f}}},
+        {2, {{1.0f, 2.0f, 3.0f}, Quaternion::rotation(90.0_degf, Vector3::zAxis()), Vector3{1.0f}}},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::referencesNoTransformation() {
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        UnsignedInt mesh;
+    } data[]{
+        {0, -1, 0},
+        {1, 0, 1},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(90.0_degf);
+    const Containers::Pair<UnsignedInt, Matrix4> duplicates[]{
+        {0, {}},
+        {0, transformation},
+    };
+
+    /* A new transformation field is added, containing just the new object */
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+    CORRADE_VERIFY(out.is3D());
+    CORRADE_COMPARE(out.mappingBound(), 3);
+    CORRADE_COMPARE(out.fieldCount(), 3);
+    CORRADE_COMPARE(out.fieldType(Trade::SceneField::Transformation), Trade::SceneFieldType::Matrix4x4);
+    CORRADE_COMPARE_AS(out.meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {0, {0, -1}},
+        {2, {0, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, 0},
+        {2, 1},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.transformations3DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {2, transformation},
+    })), TestSuite::Compare::Container);
+}
+
+void DeduplicateMeshesTest::referencesStringField() {
+    const struct Data {
+        struct Object {
+            UnsignedInt object;
+            Int parent;
+            UnsignedInt mesh;
+            UnsignedInt name;
+        } objects[2];
+        char names[12];
+    } data[]{{
+        {{0, -1, 0, 6},
+         {1, 0, 1, 11}},
+        "Chair\0Lamp"
+    }};
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::object),
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::object),
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::mesh)},
+        /* The offsets include the null terminators, which means the strings
+           would be returned with them if the flag got lost */
+        Trade::SceneFieldData{Trade::sceneFieldCustom(15),
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::object),
+            data->names, Trade::SceneFieldType::StringOffset32,
+            Containers::stridedArrayView(data->objects)
+                .slice(&Data::Object::name),
+            Trade::SceneFieldFlag::NullTerminatedString},
+    }};
+
+    const Containers::Pair<UnsignedInt, Matrix4> duplicates[]{
+        {0, {}},
+        {0, Matrix4::translation({1.0f, 2.0f, 3.0f})},
+    };
+
+    Trade::SceneData out = deduplicateMeshReferences(scene, duplicates);
+    CORRADE_COMPARE(out.mappingBound(), 3);
+    CORRADE_COMPARE(out.fieldType(Trade::sceneFieldCustom(15)), Trade::SceneFieldType::StringOffset32);
+    CORRADE_COMPARE(out.fieldFlags(Trade::sceneFieldCustom(15)), Trade::SceneFieldFlag::OffsetOnly|Trade::SceneFieldFlag::NullTerminatedString);
+    CORRADE_COMPARE_AS(out.fieldStrings(Trade::sceneFieldCustom(15)), Containers::arrayView({
+        "Chair"_s, "Lamp"_s
+    }), TestSuite::Compare::Container);
+    for(Containers::StringView i: out.fieldStrings(Trade::sceneFieldCustom(15))) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(i.flags(), Containers::StringViewFlag::NullTerminated);
+        CORRADE_COMPARE(i[i.size()], '\0');
+    }
+}
+
+void DeduplicateMeshesTest::referencesInvalid() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    const struct Data {
+        UnsignedByte object;
+        Int parent;
+        UnsignedInt mesh;
+        Matrix3 transformation;
+    } data[]{
+        {0, -1, 1, {}},
+        {1, -1, 0, {}},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedByte, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+    Trade::SceneData scene2D{Trade::SceneMappingType::UnsignedByte, 2, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+    Trade::SceneData sceneTooManyObjects{Trade::SceneMappingType::UnsignedByte, 256, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+
+    const Containers::Pair<UnsignedInt, Matrix4> notUnique[]{
+        {1, {}},
+        {0, {}},
+    };
+    const Containers::Pair<UnsignedInt, Matrix4> transformed[]{
+        {0, {}},
+        {0, Matrix4::translation(Vector3::xAxis())},
+    };
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    deduplicateMeshReferences(scene, Containers::arrayView(transformed).prefix(1));
+    deduplicateMeshReferences(scene, notUnique);
+    deduplicateMeshReferences(scene, transformed);
+    deduplicateMeshReferences(scene2D, transformed);
+    deduplicateMeshReferences(sceneTooManyObjects, transformed);
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::deduplicateMeshReferences(): mesh 1 out of range for 1 meshes\n"
+        "SceneTools::deduplicateMeshReferences(): mesh 1 is a duplicate of 0 which isn't unique\n"
+        "SceneTools::deduplicateMeshReferences(): the scene has no hierarchy\n"
+        "SceneTools::deduplicateMeshReferences(): can't add transformed mesh instances to a 2D scene\n"
+        "SceneTools::deduplicateMeshReferences(): can't represent 257 objects with Trade::SceneMappingType::UnsignedByte\n");
+}
+
+void DeduplicateMeshesTest::deduplicate() {
+    const struct Data {
+        UnsignedInt object;
+        Int parent;
+        UnsignedInt mesh;
+        Matrix4 transformation;
+    } data[]{
+        {0, -1, 2, {}},
+        {1, -1, 1, Matrix4::translation(Vector3::yAxis())},
+        {2, -1, 0, {}},
+    };
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 3, {}, data, {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data).slice(&Data::object),
+            Containers::stridedArrayView(data).slice(&Data::mesh)},
+    }};
+
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationX(90.0_degf);
+    Vertex transformed[Containers::arraySize(Vertices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i) {
+        transformed[i].position = transformation.transformPoint(Vertices[i].position);
+        transformed[i].normal = transformation.transformVector(Vertices[i].normal);
+    }
+
+    Containers::Array<Trade::MeshData> meshes;
+    arrayAppend(meshes, interleavedMesh(IndicesFlipped, Vertices));
+    arrayAppend(meshes, interleavedMesh(Indices, Vertices));
+    arrayAppend(meshes, interleavedMesh(Indices, transformed));
+
+    Containers::Pair<Trade::SceneData, Containers::Array<Trade::MeshData>> out = deduplicateMeshes(scene, std::move(meshes), DuplicateMeshFlag::RigidTransformations);
+
+    /* The last mesh is a transformed second mesh, it gets removed and the
+       reference to it moved to a new child object */
+    CORRADE_COMPARE(out.second().size(), 2);
+    CORRADE_COMPARE_AS(out.second()[0].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 2, 1, 0, 3, 2, 0, 1, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.second()[1].indicesAsArray(), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 0, 2, 3, 0, 3, 1
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(out.first().mappingBound(), 4);
+    CORRADE_COMPARE_AS(out.first().meshesMaterialsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>>({
+        {3, {1, -1}},
+        {1, {1, -1}},
+        {2, {0, -1}},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, -1},
+        {2, -1},
+        {3, 0},
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first().transformations3DAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Matrix4>>({
+        {0, {}},
+        {1, Matrix4::translation(Vector3::yAxis())},
+        {2, {}},
+        {3, transformation},
+    })), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneTools::Test::DeduplicateMeshesTest)
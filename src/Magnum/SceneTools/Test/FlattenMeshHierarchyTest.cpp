@@ -48,6 +48,14 @@ struct FlattenMeshHierarchyTest: TestSuite::Tester {
     void into2D();
     void into3D();
     void intoInvalidSize();
+    void intoThreads();
+
+    void incremental2D();
+    void incremental3D();
+    void incrementalMeshOnObjectWithoutParent();
+    void incrementalNot2DNot3D();
+    void incrementalNoParentField();
+    void incrementalUpdateInvalidObject();
 };
 
 using namespace Math::Literals;
@@ -100,7 +108,15 @@ FlattenMeshHierarchyTest::FlattenMeshHierarchyTest() {
                        &FlattenMeshHierarchyTest::into3D},
         Containers::arraySize(IntoData));
 
-    addTests({&FlattenMeshHierarchyTest::intoInvalidSize});
+    addTests({&FlattenMeshHierarchyTest::intoInvalidSize,
+              &FlattenMeshHierarchyTest::intoThreads,
+
+              &FlattenMeshHierarchyTest::incremental2D,
+              &FlattenMeshHierarchyTest::incremental3D,
+              &FlattenMeshHierarchyTest::incrementalMeshOnObjectWithoutParent,
+              &FlattenMeshHierarchyTest::incrementalNot2DNot3D,
+              &FlattenMeshHierarchyTest::incrementalNoParentField,
+              &FlattenMeshHierarchyTest::incrementalUpdateInvalidObject});
 }
 
 const struct Scene {
@@ -475,6 +491,262 @@ void FlattenMeshHierarchyTest::intoInvalidSize() {
         "SceneTools::flattenMeshHierarchyInto(): bad output size, expected 5 but got 4\n");
 }
 
+void FlattenMeshHierarchyTest::intoThreads() {
+    /* Three levels, each large enough to be split across multiple threads.
+       Object i in each level has object i from the previous level as a
+       parent, every object has a transformation and a mesh. */
+    constexpr UnsignedInt LevelSize = 40000;
+    struct Object {
+        UnsignedInt object;
+        Int parent;
+        Matrix4 transformation;
+    };
+    Containers::Array<Object> objects{NoInit, LevelSize*3};
+    for(UnsignedInt i = 0; i != objects.size(); ++i) {
+        objects[i].object = i;
+        objects[i].parent = i < LevelSize ? -1 : Int(i - LevelSize);
+        objects[i].transformation =
+            Matrix4::translation(Vector3::xAxis(Float(i % 17)))*
+            Matrix4::rotationY(Deg(Float(i % 360)));
+    }
+
+    Containers::StridedArrayView1D<Object> view = objects;
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, objects.size(), {}, Containers::arrayView(objects), {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            view.slice(&Object::object),
+            view.slice(&Object::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            view.slice(&Object::object),
+            view.slice(&Object::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            view.slice(&Object::object),
+            view.slice(&Object::object)},
+    }};
+
+    const Matrix4 globalTransformation = Matrix4::scaling(Vector3{0.5f});
+    Containers::Array<Matrix4> expected{NoInit, objects.size()};
+    flattenMeshHierarchy3DInto(scene, expected, globalTransformation);
+
+    /* The output should be bit-exact, as the order of operations for each
+       object is the same */
+    Containers::Array<Matrix4> out{NoInit, objects.size()};
+    flattenMeshHierarchy3DInto(scene, out, globalTransformation, 4);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+
+    /* Using the default thread count */
+    Containers::Array<Matrix4> outDefault{NoInit, objects.size()};
+    flattenMeshHierarchy3DInto(scene, outDefault, globalTransformation, 0);
+    CORRADE_COMPARE_AS(outDefault, expected, TestSuite::Compare::Container);
+
+    /* The incremental variant should give the same as well */
+    FlattenedMeshHierarchy3D flattened{scene, globalTransformation, 4};
+    CORRADE_COMPARE_AS(flattened.transformations(), expected, TestSuite::Compare::Container);
+}
+
+void FlattenMeshHierarchyTest::incremental2D() {
+    /* Mutable copy of the data so the transformations can be changed */
+    Scene data = *Data;
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 33, Trade::DataFlag::Mutable, Containers::arrayView(&data, 1), {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data.parents)
+                .slice(&Scene::Parent::object),
+            Containers::stridedArrayView(data.parents)
+                .slice(&Scene::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data.transforms)
+                .slice(&Scene::Transformation::object),
+            Containers::stridedArrayView(data.transforms)
+                .slice(&Scene::Transformation::transformation2D)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Scene::Mesh::mesh)}
+    }};
+
+    const Matrix3 globalTransformation = Matrix3::scaling(Vector2{0.5f});
+    FlattenedMeshHierarchy2D flattened{scene, globalTransformation};
+
+    Containers::Array<Matrix3> expected{NoInit, scene.fieldSize(Trade::SceneField::Mesh)};
+    flattenMeshHierarchy2DInto(scene, expected, globalTransformation);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+
+    /* Change transformation of object 5, which affects the mesh on object 3
+       but not the others */
+    data.transforms[4].transformation2D = Matrix3::rotation(-15.0_degf);
+    flattened.update({5});
+    flattenMeshHierarchy2DInto(scene, expected, globalTransformation);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(flattened.transformations()[1], globalTransformation*
+        Matrix3::translation({1.0f, -1.5f})*
+        Matrix3::rotation(-15.0_degf));
+}
+
+void FlattenMeshHierarchyTest::incremental3D() {
+    /* Mutable copy of the data so the transformations can be changed */
+    Scene data = *Data;
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedShort, 33, Trade::DataFlag::Mutable, Containers::arrayView(&data, 1), {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data.parents)
+                .slice(&Scene::Parent::object),
+            Containers::stridedArrayView(data.parents)
+                .slice(&Scene::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data.transforms)
+                .slice(&Scene::Transformation::object),
+            Containers::stridedArrayView(data.transforms)
+                .slice(&Scene::Transformation::transformation3D)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Scene::Mesh::object),
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Scene::Mesh::mesh)}
+    }};
+
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(Trade::SceneField::Transformation));
+    FlattenedMeshHierarchy3D flattened{scene};
+
+    /* The transformation field is unordered, so the constructor should build
+       an object index for it to make the lookups in update() fast */
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(Trade::SceneField::Transformation));
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(Trade::SceneField::Mesh));
+
+    Containers::Array<Matrix4> expected{NoInit, scene.fieldSize(Trade::SceneField::Mesh)};
+    flattenMeshHierarchy3DInto(scene, expected);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+
+    /* Change the root transformation, which affects everything except the
+       mesh on object 4. Object 4 is updated as well even though it has no
+       transformation, which shouldn't change anything. */
+    data.transforms[1].transformation3D = Matrix4::translation({-1.0f, 0.5f, 3.0f});
+    flattened.update({1, 4});
+    flattenMeshHierarchy3DInto(scene, expected);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(flattened.transformations()[2], Matrix4{});
+
+    /* Changing a leaf and updating it twice */
+    data.transforms[2].transformation3D = Matrix4::scaling(Vector3{2.0f});
+    flattened.update({16, 16});
+    flattenMeshHierarchy3DInto(scene, expected);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(flattened.transformations()[4], Matrix4::scaling(Vector3{2.0f}));
+
+    /* Changing a transformation without calling update() doesn't change
+       anything */
+    data.transforms[0].transformation3D = Matrix4::scaling(Vector3{4.0f});
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+}
+
+void FlattenMeshHierarchyTest::incrementalMeshOnObjectWithoutParent() {
+    struct Data {
+        struct Parent {
+            UnsignedInt object;
+            Int parent;
+        } parents[1];
+        struct Transformation {
+            UnsignedInt object;
+            Matrix4 transformation;
+        } transformations[2];
+        struct Mesh {
+            UnsignedInt object;
+            UnsignedInt mesh;
+        } meshes[2];
+    } data{
+        {{0, -1}},
+        {{0, Matrix4::translation({1.0f, 2.0f, 3.0f})},
+         {1, Matrix4::scaling(Vector3{2.0f})}},
+        {{0, 0},
+         {1, 1}}
+    };
+
+    /* Object 1 has a mesh and a transformation, but isn't in the hierarchy */
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 2, {}, Containers::arrayView(&data, 1), {
+        Trade::SceneFieldData{Trade::SceneField::Parent,
+            Containers::stridedArrayView(data.parents)
+                .slice(&Data::Parent::object),
+            Containers::stridedArrayView(data.parents)
+                .slice(&Data::Parent::parent)},
+        Trade::SceneFieldData{Trade::SceneField::Transformation,
+            Containers::stridedArrayView(data.transformations)
+                .slice(&Data::Transformation::object),
+            Containers::stridedArrayView(data.transformations)
+                .slice(&Data::Transformation::transformation)},
+        Trade::SceneFieldData{Trade::SceneField::Mesh,
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Data::Mesh::object),
+            Containers::stridedArrayView(data.meshes)
+                .slice(&Data::Mesh::mesh)}
+    }};
+
+    FlattenedMeshHierarchy3D flattened{scene};
+
+    Containers::Array<Matrix4> expected{NoInit, 2};
+    flattenMeshHierarchy3DInto(scene, expected);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(flattened.transformations()[1], Matrix4::scaling(Vector3{2.0f}));
+
+    /* Updating the object gives it the new relative transformation, same as
+       the full flatten */
+    data.transformations[1].transformation = Matrix4::rotationX(90.0_degf);
+    flattened.update({1});
+    flattenMeshHierarchy3DInto(scene, expected);
+    CORRADE_COMPARE_AS(flattened.transformations(), expected,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(flattened.transformations()[1], Matrix4::rotationX(90.0_degf));
+}
+
+void FlattenMeshHierarchyTest::incrementalNot2DNot3D() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlattenedMeshHierarchy2D{scene};
+    FlattenedMeshHierarchy3D{scene};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlattenedMeshHierarchy: the scene is not 2D\n"
+        "SceneTools::FlattenedMeshHierarchy: the scene is not 3D\n");
+}
+
+void FlattenMeshHierarchyTest::incrementalNoParentField() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 0, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix3x3, nullptr}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FlattenedMeshHierarchy2D{scene};
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlattenedMeshHierarchy: the scene has no hierarchy\n");
+}
+
+void FlattenMeshHierarchyTest::incrementalUpdateInvalidObject() {
+    CORRADE_SKIP_IF_NO_ASSERT();
+
+    Trade::SceneData scene{Trade::SceneMappingType::UnsignedInt, 5, nullptr, {
+        Trade::SceneFieldData{Trade::SceneField::Parent, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Int, nullptr},
+        Trade::SceneFieldData{Trade::SceneField::Transformation, Trade::SceneMappingType::UnsignedInt, nullptr, Trade::SceneFieldType::Matrix4x4, nullptr}
+    }};
+
+    FlattenedMeshHierarchy3D flattened{scene};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattened.update({3, 5});
+    CORRADE_COMPARE(out.str(),
+        "SceneTools::FlattenedMeshHierarchy::update(): object 5 out of bounds for 5 objects\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::SceneTools::Test::FlattenMeshHierarchyTest)
@@ -38,6 +38,7 @@
 #include "Magnum/MeshTools/Reference.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/SceneTools/DeduplicateMeshes.h"
 #include "Magnum/SceneTools/FlattenMeshHierarchy.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/MeshData.h"
@@ -181,7 +182,8 @@ magnum-sceneconverter [-h|--help] [-I|--importer PLUGIN]
     [-C|--converter PLUGIN]... [-P|--image-converter PLUGIN]...
     [-M|--mesh-converter PLUGIN]... [--plugin-dir DIR] [--map]
     [--only-mesh-attributes N1,N2-N3…] [--remove-duplicate-vertices]
-    [--remove-duplicate-vertices-fuzzy EPSILON] [--phong-to-pbr]
+    [--remove-duplicate-vertices-fuzzy EPSILON] [--deduplicate-meshes]
+    [--deduplicate-meshes-rigid] [--phong-to-pbr]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]...
     [-p|--image-converter-options key=val,key2=val2,…]...
@@ -218,6 +220,14 @@ Arguments:
 -   `--remove-duplicate-vertices-fuzzy EPSILON` --- remove duplicate vertices
     using @ref MeshTools::removeDuplicatesFuzzy(const Trade::MeshData&, Float, Double)
     in all meshes after import
+-   `--deduplicate-meshes` --- remove meshes that are exact duplicates of
+    other meshes using @ref SceneTools::findDuplicateMeshes() and update
+    references to them in all scenes
+-   `--deduplicate-meshes-rigid` --- same as `--deduplicate-meshes`, but
+    remove also meshes that are rigidly transformed duplicates of other
+    meshes, moving their instances to new child objects with the
+    transformation applied. Fails if such an instance is in a 2D scene or a
+    scene without a hierarchy.
 -   `--phong-to-pbr` --- convert Phong materials to PBR metallic/roughness
     using @ref MaterialTools::phongToPbrMetallicRoughness()
 -   `-i`, `--importer-options key=val,key2=val2,…` --- configuration options to
@@ -298,6 +308,13 @@ images / meshes are passed directly to the scene converter.
 The `--remove-duplicate-vertices` and `--phong-to-pbr` operations are performed
 on meshes and materials before passing them to any converter.
 
+The `--deduplicate-meshes` and `--deduplicate-meshes-rigid` operations are
+performed after all other mesh operations, including `-M`, and all scenes are
+then updated to reference only the unique meshes using
+@ref SceneTools::deduplicateMeshReferences(). With `--verbose`, the mesh count
+before and after and the amount of saved mesh data is printed. These options
+can't be used together with `--mesh` or `--concatenate-meshes`.
+
 If `--concatenate-meshes` is given, all meshes of the input file are
 first concatenated into a single mesh using @ref MeshTools::concatenate(), with
 the scene hierarchy transformation baked in using
@@ -407,6 +424,8 @@ int main(int argc, char** argv) {
         .addOption("only-mesh-attributes").setHelp("only-mesh-attributes", "include only mesh attributes of given IDs in the output", "N1,N2-N3…")
         .addBooleanOption("remove-duplicate-vertices").setHelp("remove-duplicate-vertices", "remove duplicate vertices in all meshes after import")
         .addOption("remove-duplicate-vertices-fuzzy").setHelp("remove-duplicate-vertices-fuzzy", "remove duplicate vertices with fuzzy comparison in all meshes after import", "EPSILON")
+        .addBooleanOption("deduplicate-meshes").setHelp("deduplicate-meshes", "remove duplicate meshes and update references to them in all scenes")
+        .addBooleanOption("deduplicate-meshes-rigid").setHelp("deduplicate-meshes-rigid", "remove also meshes that are rigidly transformed duplicates of other meshes")
         .addBooleanOption("phong-to-pbr").setHelp("phong-to-pbr", "convert Phong materials to PBR metallic/roughness")
         .addOption('i', "importer-options").setHelp("importer-options", "configuration options to pass to the importer", "key=val,key2=val2,…")
         .addArrayOption('c', "converter-options").setHelp("converter-options", "configuration options to pass to the converter(s)", "key=val,key2=val2,…")
@@ -485,6 +504,11 @@ images / meshes are passed directly to the scene converter.
 The --remove-duplicate-vertices and --phong-to-pbr operations are performed on
 meshes and materials before passing them to any converter.
 
+The --deduplicate-meshes and --deduplicate-meshes-rigid operations are
+performed after all other mesh operations, including -M, and all scenes are
+then updated to reference only the unique meshes. These options can't be used
+together with --mesh or --concatenate-meshes.
+
 If --concatenate-meshes is given, all meshes of the input file are first
 concatenated into a single mesh, with the scene hierarchy transformation baked
 in, and then passed through the remaining operations. Only attributes that are
@@ -535,6 +559,10 @@ well, the IDs reference attributes of the first mesh.)")
         Error{} << "The --mesh and --concatenate-meshes options are mutually exclusive";
         return 1;
     }
+    if((args.isSet("deduplicate-meshes") || args.isSet("deduplicate-meshes-rigid")) && (args.value<Containers::StringView>("mesh") || args.isSet("concatenate-meshes"))) {
+        Error{} << "The --deduplicate-meshes options can't be used together with --mesh or --concatenate-meshes";
+        return 1;
+    }
     if(args.value<Containers::StringView>("mesh-level") && !args.value<Containers::StringView>("mesh")) {
         Error{} << "The --mesh-level option can only be used with --mesh";
         return 1;
@@ -860,6 +888,8 @@ well, the IDs reference attributes of the first mesh.)")
     Containers::Array<Trade::MeshData> meshes;
     if(args.isSet("remove-duplicate-vertices") ||
        args.value<Containers::StringView>("remove-duplicate-vertices-fuzzy") ||
+       args.isSet("deduplicate-meshes") ||
+       args.isSet("deduplicate-meshes-rigid") ||
        args.arrayValueCount("mesh-converter"))
     {
         arrayReserve(meshes, importer->meshCount());
@@ -947,6 +977,66 @@ well, the IDs reference attributes of the first mesh.)")
         }
     }
 
+    /* Mesh deduplication, done after all other mesh operations as those could
+       make more meshes equal. As the scenes reference the meshes, they're all
+       updated and supplied manually to the converter from the array below.
+       The meshIds array maps the remaining meshes to the original IDs in
+       order to preserve their names. */
+    Containers::Array<Trade::SceneData> scenes;
+    Containers::Array<UnsignedInt> meshIds;
+    if(args.isSet("deduplicate-meshes") || args.isSet("deduplicate-meshes-rigid")) {
+        const bool rigid = args.isSet("deduplicate-meshes-rigid");
+
+        Containers::Array<Containers::Pair<UnsignedInt, Matrix4>> duplicates;
+        {
+            Trade::Implementation::Duration d{conversionTime};
+            duplicates = SceneTools::findDuplicateMeshes(meshes, rigid ? SceneTools::DuplicateMeshFlag::RigidTransformations : SceneTools::DuplicateMeshFlags{});
+        }
+
+        arrayReserve(scenes, importer->sceneCount());
+        for(UnsignedInt i = 0; i != importer->sceneCount(); ++i) {
+            Containers::Optional<Trade::SceneData> scene;
+            {
+                Trade::Implementation::Duration d{importConversionTime};
+                if(!(scene = importer->scene(i))) {
+                    Error{} << "Cannot import scene" << i;
+                    return 1;
+                }
+            }
+
+            /* Rigidly transformed instances are moved to new child objects,
+               which needs a 3D hierarchy. Scenes that reference only meshes
+               that are unique or exact duplicates don't get any new objects
+               and thus can be anything. */
+            if(rigid && (!scene->hasField(Trade::SceneField::Parent) || scene->is2D()) && scene->hasField(Trade::SceneField::Mesh)) {
+                for(const Containers::Pair<UnsignedInt, Containers::Pair<UnsignedInt, Int>>& meshMaterial: scene->meshesMaterialsAsArray()) {
+                    const UnsignedInt mesh = meshMaterial.second().first();
+                    if(mesh < duplicates.size() && duplicates[mesh].second() != Matrix4{}) {
+                        Error{} << "Cannot deduplicate rigidly transformed meshes in scene" << i << "as it's not a 3D scene with a hierarchy";
+                        return 1;
+                    }
+                }
+            }
+
+            Trade::Implementation::Duration d{conversionTime};
+            arrayAppend(scenes, SceneTools::deduplicateMeshReferences(*scene, duplicates));
+        }
+
+        Containers::Array<Trade::MeshData> uniqueMeshes;
+        std::size_t removedDataSize = 0;
+        for(UnsignedInt i = 0; i != meshes.size(); ++i) {
+            if(duplicates[i].first() == i) {
+                arrayAppend(meshIds, i);
+                arrayAppend(uniqueMeshes, std::move(meshes[i]));
+            } else removedDataSize += meshes[i].indexData().size() + meshes[i].vertexData().size();
+        }
+
+        if(args.isSet("verbose"))
+            Debug{} << (rigid ? "Rigid mesh deduplication:" : "Mesh deduplication:") << meshes.size() << "->" << uniqueMeshes.size() << "meshes," << removedDataSize << "bytes of mesh data removed";
+
+        meshes = std::move(uniqueMeshes);
+    }
+
     /* Operations to perform on all materials in the importer. If there are
        any, materials are supplied manually to the converter from the array
        below. */
@@ -1131,7 +1221,9 @@ well, the IDs reference attributes of the first mesh.)")
                     }
                 }
 
-                if(!converter->add(mesh, contents & Trade::SceneContent::Names ? importer->meshName(j) : Containers::String{})) {
+                /* If meshes were deduplicated, the names are taken from the
+                   original IDs */
+                if(!converter->add(mesh, contents & Trade::SceneContent::Names ? importer->meshName(meshIds ? meshIds[j] : j) : Containers::String{})) {
                     Error{} << "Cannot add mesh" << j;
                     return 1;
                 }
@@ -1149,6 +1241,7 @@ well, the IDs reference attributes of the first mesh.)")
                 that each change the output to verify the old meshes don't get
                 reused in the next step again */
             meshes = {};
+            meshIds = {};
         }
 
         /* If there are any loose materials from previous conversion steps, add
@@ -1204,6 +1297,87 @@ well, the IDs reference attributes of the first mesh.)")
             materials = {};
         }
 
+        /* If there are any loose scenes from previous conversion steps, add
+           them directly, and clear the array so the next iteration (if any)
+           takes them from the importer instead */
+        if(scenes) {
+            /* Scenes reference lights, cameras, skins and materials (which
+               reference textures and images), thus we need to add those
+               first. Meshes are always added above in this case. */
+            {
+                const Trade::SceneContents sceneDependencies = contents &
+                    (Trade::SceneContent::Lights|
+                     Trade::SceneContent::Cameras|
+                     Trade::SceneContent::Skins2D|
+                     Trade::SceneContent::Skins3D|
+                     Trade::SceneContent::Materials|
+                     Trade::SceneContent::Images1D|
+                     Trade::SceneContent::Images2D|
+                     Trade::SceneContent::Images3D|
+                     Trade::SceneContent::ImageLevels|
+                     Trade::SceneContent::Textures|
+                     Trade::SceneContent::Names);
+
+                Trade::Implementation::Duration d{importConversionTime};
+                if(!converter->addSupportedImporterContents(*importer, sceneDependencies)) {
+                    Error{} << "Cannot add scene dependencies";
+                    return 5;
+                }
+
+                /* Ensure these are not added by addSupportedImporterContents()
+                   again below, except for names -- those should be added as
+                   long as they were in the contents originally. */
+                contents &= ~(sceneDependencies & ~Trade::SceneContent::Names);
+            }
+
+            if(!(Trade::sceneContentsFor(*converter) & Trade::SceneContent::Scenes)) {
+                Warning{} << "Ignoring" << scenes.size() << "scenes not supported by the converter";
+            } else {
+                Trade::Implementation::Duration d{conversionTime};
+
+                /* Propagate object names, skip ones that are empty. Objects
+                   added by the deduplication have no names. */
+                if(contents & Trade::SceneContent::Names) for(UnsignedLong i = 0, iMax = importer->objectCount(); i != iMax; ++i) {
+                    if(const Containers::String name = importer->objectName(i))
+                        converter->setObjectName(i, name);
+                }
+
+                for(UnsignedInt i = 0; i != scenes.size(); ++i) {
+                    const Trade::SceneData& scene = scenes[i];
+
+                    /* Propagate custom field names, skip ones that are empty.
+                       Compared to data names this is done always to avoid
+                       information loss. */
+                    for(UnsignedInt j = 0; j != scene.fieldCount(); ++j) {
+                        const Trade::SceneField name = scene.fieldName(j);
+                        if(!isSceneFieldCustom(name)) continue;
+                        if(const Containers::String nameString = importer->sceneFieldName(name)) {
+                            converter->setSceneFieldName(name, nameString);
+                        }
+                    }
+
+                    if(!converter->add(scene, contents & Trade::SceneContent::Names ? importer->sceneName(i) : Containers::String{})) {
+                        Error{} << "Cannot add scene" << i;
+                        return 1;
+                    }
+                }
+
+                const Int defaultScene = importer->defaultScene();
+                if(defaultScene != -1)
+                    converter->setDefaultScene(defaultScene);
+            }
+
+            /* Ensure the scenes are not added by addSupportedImporterContents()
+               below. Do this also in case the converter actually doesn't
+               support scene addition, as it would otherwise cause two
+               warnings about the same thing being printed. */
+            contents &= ~Trade::SceneContent::Scenes;
+
+            /* Delete the list to avoid adding them again for the next
+               converter (at which point they would be stale) */
+            scenes = {};
+        }
+
         {
             Trade::Implementation::Duration d{importConversionTime};
             if(!converter->addSupportedImporterContents(*importer, contents)) {
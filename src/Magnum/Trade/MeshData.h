@@ -60,6 +60,21 @@ be of any type. An importer that exposes custom attributes then may also
 provide a string mapping using @ref AbstractImporter::meshAttributeForName()
 and @ref AbstractImporter::meshAttributeName(). See documentation of a
 particular importer for details.
+
+Custom attribute IDs from @cpp 32736 @ce to @cpp 32767 @ce are reserved for
+attributes defined by Magnum itself and applications should use IDs below
+this range to avoid collisions. Currently used are:
+
+-   @cpp 32751 @ce for @ref MeshTools::MeshAttributeOctahedralNormal
+-   @cpp 32752 @ce to @cpp 32758 @ce for
+    @ref MeshTools::MeshAttributeMeshletBoundingSphere,
+    @relativeref{MeshTools,MeshAttributeMeshletNormalCone},
+    @relativeref{MeshTools,MeshAttributeMeshletNormalConeApex},
+    @relativeref{MeshTools,MeshAttributeMeshletVertices},
+    @relativeref{MeshTools,MeshAttributeMeshletTriangleCount},
+    @relativeref{MeshTools,MeshAttributeMeshletVertexCount} and
+    @relativeref{MeshTools,MeshAttributeMeshletTriangles}
+
 @see @ref MeshAttributeData, @ref VertexFormat
 */
 /* 16 bits because 8 bits is not enough to cover all potential per-edge,
@@ -2329,7 +2344,10 @@ namespace Implementation {
     #undef _c
     #endif
     /* LCOV_EXCL_STOP */
+    #endif
 
+    /* Not guarded with CORRADE_NO_ASSERT as these are used to validate
+       deserialized attributes in release builds as well */
     constexpr bool isVertexFormatCompatibleWithAttribute(MeshAttribute name, VertexFormat format) {
         /* Double types intentionally not supported for any builtin attributes
            right now -- only for custom types */
@@ -2422,7 +2440,6 @@ namespace Implementation {
         return name == MeshAttribute::JointIds ||
                name == MeshAttribute::Weights;
     }
-    #endif
 }
 
 constexpr MeshAttributeData::MeshAttributeData(std::nullptr_t, const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView1D<const void>& data, const UnsignedShort arraySize) noexcept:
@@ -25,7 +25,8 @@
 
 #include "SceneData.h"
 
-#include <algorithm> /* std::lower_bound() */
+#include <algorithm> /* std::lower_bound(), std::stable_sort() */
+#include <atomic>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
@@ -776,7 +777,49 @@ Containers::Array<SceneFieldData> sceneFieldDataNonOwningArray(const Containers:
     return Containers::Array<SceneFieldData>{const_cast<SceneFieldData*>(view.data()), view.size(), Implementation::nonOwnedArrayDeleter};
 }
 
-SceneData::SceneData(const SceneMappingType mappingType, const UnsignedLong mappingBound, Containers::Array<char>&& data, Containers::Array<SceneFieldData>&& fields, const void* const importerState) noexcept: _dataFlags{DataFlag::Owned|DataFlag::Mutable}, _mappingType{mappingType}, _dimensions{}, _mappingBound{mappingBound}, _importerState{importerState}, _fields{std::move(fields)}, _data{std::move(data)} {
+namespace Implementation {
+
+/* Object index of a single field. Offsets of entries for object `i` are
+   `offsets[objectOffsets[i]]` up to `offsets[objectOffsets[i + 1]]`, in an
+   increasing order. If `objects` is empty, the index is dense and
+   `objectOffsets` has `mappingBound + 1` items. Otherwise `objects` is a
+   sorted list of unique object IDs present in the field, `i` is a position
+   in it and `objectOffsets` has one item more. */
+struct SceneFieldObjectIndex {
+    Containers::Array<UnsignedInt> objectOffsets;
+    Containers::Array<UnsignedLong> objects;
+    Containers::Array<UnsignedInt> offsets;
+};
+
+struct SceneObjectIndex {
+    struct Field {
+        ~Field() { delete index.load(std::memory_order_relaxed); }
+
+        std::atomic<const SceneFieldObjectIndex*> index{};
+        /* Count of mapping entries visited by linear lookups. Once it reaches
+           the field size, the index gets built. */
+        std::atomic<std::size_t> scanned{};
+    };
+
+    explicit SceneObjectIndex(std::size_t fieldCount): fields{ValueInit, fieldCount} {}
+
+    Containers::Array<Field> fields;
+};
+
+}
+
+namespace {
+
+Containers::Pointer<Implementation::SceneObjectIndex> objectIndexFor(const Containers::ArrayView<const SceneFieldData> fields) {
+    for(const SceneFieldData& field: fields)
+        if(!(field.flags() >= SceneFieldFlag::OrderedMapping))
+            return Containers::pointer<Implementation::SceneObjectIndex>(fields.size());
+    return nullptr;
+}
+
+}
+
+SceneData::SceneData(const SceneMappingType mappingType, const UnsignedLong mappingBound, Containers::Array<char>&& data, Containers::Array<SceneFieldData>&& fields, const void* const importerState) noexcept: _dataFlags{DataFlag::Owned|DataFlag::Mutable}, _mappingType{mappingType}, _dimensions{}, _mappingBound{mappingBound}, _importerState{importerState}, _fields{std::move(fields)}, _data{std::move(data)}, _objectIndex{objectIndexFor(_fields)} {
     /* Check that mapping type is large enough */
     CORRADE_ASSERT(
         (mappingType == SceneMappingType::UnsignedByte && mappingBound <= 0xffull) ||
@@ -1080,6 +1123,7 @@ SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedIn
        returned from AbstractImporter */
     _fields = Containers::Array<SceneFieldData>{1};
     _fields[0] = SceneFieldData{SceneField::Parent, mapping, parents};
+    _objectIndex = objectIndexFor(_fields);
     Utility::copy(children, mapping);
     constexpr Int parent[]{-1};
     Utility::copy(Containers::stridedArrayView(parent).broadcasted<0>(parents.size()), parents);
@@ -1095,6 +1139,9 @@ SceneData& SceneData::operator=(SceneData&&) noexcept = default;
 Containers::ArrayView<char> SceneData::mutableData() & {
     CORRADE_ASSERT(_dataFlags & DataFlag::Mutable,
         "Trade::SceneData::mutableData(): data not mutable", {});
+    /* The mapping may get modified, so discard all object indices */
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        discardFieldObjectIndexInternal(i);
     return _data;
 }
 
@@ -1231,20 +1278,162 @@ template<class T> std::size_t findObject(const SceneFieldFlags flags, const Cont
     return max;
 }
 
+/* Dense index is used if the offset table isn't more than four times larger
+   than the field itself and all object IDs are in bounds */
+template<class T> Implementation::SceneFieldObjectIndex* buildObjectIndex(const Containers::StridedArrayView1D<const void>& mapping, const UnsignedLong mappingBound) {
+    const Containers::StridedArrayView1D<const T> mappingT = Containers::arrayCast<const T>(mapping);
+    const std::size_t size = mappingT.size();
+
+    bool dense = mappingBound/4 <= size;
+    if(dense) for(const T object: mappingT) if(object >= mappingBound) {
+        dense = false;
+        break;
+    }
+
+    Implementation::SceneFieldObjectIndex* out = new Implementation::SceneFieldObjectIndex;
+    out->offsets = Containers::Array<UnsignedInt>{NoInit, size};
+
+    if(dense) {
+        /* Count entries for each object, shifted by one, and turn the counts
+           into offsets */
+        out->objectOffsets = Containers::Array<UnsignedInt>{ValueInit, std::size_t(mappingBound) + 1};
+        for(const T object: mappingT)
+            ++out->objectOffsets[std::size_t(object) + 1];
+        for(std::size_t i = 1; i != out->objectOffsets.size(); ++i)
+            out->objectOffsets[i] += out->objectOffsets[i - 1];
+
+        /* Distribute the entries, using the offsets as insertion cursors.
+           Afterwards each cursor points to where the next object starts, so
+           shift them back by one. */
+        for(std::size_t i = 0; i != size; ++i)
+            out->offsets[out->objectOffsets[mappingT[i]]++] = i;
+        for(std::size_t i = out->objectOffsets.size() - 1; i; --i)
+            out->objectOffsets[i] = out->objectOffsets[i - 1];
+        out->objectOffsets[0] = 0;
+
+    } else {
+        /* Sort the entry offsets by the object, stable to keep the entries
+           of each object in an increasing order */
+        for(std::size_t i = 0; i != size; ++i)
+            out->offsets[i] = i;
+        std::stable_sort(out->offsets.begin(), out->offsets.end(), [&mappingT](const UnsignedInt a, const UnsignedInt b) {
+            return mappingT[a] < mappingT[b];
+        });
+
+        std::size_t objectCount = 0;
+        for(std::size_t i = 0; i != size; ++i)
+            if(!i || mappingT[out->offsets[i]] != mappingT[out->offsets[i - 1]])
+                ++objectCount;
+
+        out->objects = Containers::Array<UnsignedLong>{NoInit, objectCount};
+        out->objectOffsets = Containers::Array<UnsignedInt>{NoInit, objectCount + 1};
+        for(std::size_t i = 0, j = 0; i != size; ++i) {
+            if(i && mappingT[out->offsets[i]] == mappingT[out->offsets[i - 1]])
+                continue;
+            out->objects[j] = mappingT[out->offsets[i]];
+            out->objectOffsets[j] = i;
+            ++j;
+        }
+        out->objectOffsets[objectCount] = size;
+    }
+
+    return out;
+}
+
+std::size_t findObjectIndexed(const Implementation::SceneFieldObjectIndex& index, const UnsignedLong object, const std::size_t offset, const std::size_t max) {
+    std::size_t i;
+    if(index.objects.isEmpty()) {
+        if(object >= index.objectOffsets.size() - 1) return max;
+        i = object;
+    } else {
+        const UnsignedLong* const found = std::lower_bound(index.objects.begin(), index.objects.end(), object);
+        if(found == index.objects.end() || *found != object) return max;
+        i = found - index.objects.begin();
+    }
+
+    /* First entry of the object that's not before the offset */
+    const UnsignedInt* const end = index.offsets + index.objectOffsets[i + 1];
+    const UnsignedInt* const found = std::lower_bound(index.offsets + index.objectOffsets[i], end, offset);
+    return found == end ? max : *found;
+}
+
+}
+
+bool SceneData::isFieldObjectIndexable(const SceneFieldData& field) const {
+    /* Fields with more than 4G entries aren't indexed, the offsets are only
+       32-bit to save memory */
+    return _objectIndex && !(field._flags >= SceneFieldFlag::OrderedMapping) && field._size <= 0xffffffffull;
+}
+
+const Implementation::SceneFieldObjectIndex* SceneData::buildFieldObjectIndexInternal(const UnsignedInt fieldId) const {
+    Implementation::SceneObjectIndex::Field& slot = _objectIndex->fields[fieldId];
+    if(const Implementation::SceneFieldObjectIndex* const index = slot.index.load(std::memory_order_acquire))
+        return index;
+
+    const SceneFieldData& field = _fields[fieldId];
+    const Containers::StridedArrayView1D<const void> mapping = fieldDataMappingViewInternal(field);
+    const SceneMappingType mappingType = field.mappingType();
+    Implementation::SceneFieldObjectIndex* index;
+    if(mappingType == SceneMappingType::UnsignedInt)
+        index = buildObjectIndex<UnsignedInt>(mapping, _mappingBound);
+    else if(mappingType == SceneMappingType::UnsignedShort)
+        index = buildObjectIndex<UnsignedShort>(mapping, _mappingBound);
+    else if(mappingType == SceneMappingType::UnsignedByte)
+        index = buildObjectIndex<UnsignedByte>(mapping, _mappingBound);
+    else if(mappingType == SceneMappingType::UnsignedLong)
+        index = buildObjectIndex<UnsignedLong>(mapping, _mappingBound);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    /* If another thread was faster, use its index and discard ours */
+    const Implementation::SceneFieldObjectIndex* expected = nullptr;
+    if(!slot.index.compare_exchange_strong(expected, index, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        delete index;
+        return expected;
+    }
+
+    return index;
+}
+
+void SceneData::discardFieldObjectIndexInternal(const UnsignedInt fieldId) {
+    if(!_objectIndex) return;
+
+    Implementation::SceneObjectIndex::Field& slot = _objectIndex->fields[fieldId];
+    delete slot.index.exchange(nullptr, std::memory_order_relaxed);
+    slot.scanned.store(0, std::memory_order_relaxed);
 }
 
 std::size_t SceneData::findFieldObjectOffsetInternal(const SceneFieldData& field, const UnsignedLong object, const std::size_t offset) const {
+    /* If the field has an object index, use it. Otherwise do a linear search
+       and build the index once the linear searches visited as many entries
+       as the field has. */
+    const UnsignedInt fieldId = &field - _fields.data();
+    Implementation::SceneObjectIndex::Field* slot = nullptr;
+    if(isFieldObjectIndexable(field)) {
+        slot = &_objectIndex->fields[fieldId];
+        if(const Implementation::SceneFieldObjectIndex* const index = slot->index.load(std::memory_order_acquire))
+            return findObjectIndexed(*index, object, offset, field._size);
+    }
+
     const Containers::StridedArrayView1D<const void> mapping = fieldDataMappingViewInternal(field, offset, field._size - offset);
     const SceneMappingType mappingType = field.mappingType();
+    std::size_t found;
     if(mappingType == SceneMappingType::UnsignedInt)
-        return offset + findObject<UnsignedInt>(field._flags, mapping, offset, object);
+        found = offset + findObject<UnsignedInt>(field._flags, mapping, offset, object);
     else if(mappingType == SceneMappingType::UnsignedShort)
-        return offset + findObject<UnsignedShort>(field._flags, mapping, offset, object);
+        found = offset + findObject<UnsignedShort>(field._flags, mapping, offset, object);
     else if(mappingType == SceneMappingType::UnsignedByte)
-        return offset + findObject<UnsignedByte>(field._flags, mapping, offset, object);
+        found = offset + findObject<UnsignedByte>(field._flags, mapping, offset, object);
     else if(mappingType == SceneMappingType::UnsignedLong)
-        return offset + findObject<UnsignedLong>(field._flags, mapping, offset, object);
+        found = offset + findObject<UnsignedLong>(field._flags, mapping, offset, object);
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    if(slot) {
+        const std::size_t visited = Math::min(found + 1, std::size_t(field._size)) - offset;
+        if(slot->scanned.fetch_add(visited, std::memory_order_relaxed) + visited >= field._size)
+            buildFieldObjectIndexInternal(fieldId);
+    }
+
+    return found;
 }
 
 Containers::Optional<std::size_t> SceneData::findFieldObjectOffset(const UnsignedInt fieldId, const UnsignedLong object, const std::size_t offset) const {
@@ -1333,6 +1522,46 @@ bool SceneData::hasFieldObject(const SceneField fieldName, const UnsignedLong ob
     return findFieldObjectOffsetInternal(field, object, 0) != field._size;
 }
 
+void SceneData::buildFieldObjectIndex(const UnsignedInt fieldId) const {
+    CORRADE_ASSERT(fieldId < _fields.size(),
+        "Trade::SceneData::buildFieldObjectIndex(): index" << fieldId << "out of range for" << _fields.size() << "fields", );
+
+    if(isFieldObjectIndexable(_fields[fieldId]))
+        buildFieldObjectIndexInternal(fieldId);
+}
+
+void SceneData::buildFieldObjectIndex(const SceneField fieldName) const {
+    const UnsignedInt fieldId = findFieldIdInternal(fieldName);
+    CORRADE_ASSERT(fieldId != ~UnsignedInt{},
+        "Trade::SceneData::buildFieldObjectIndex(): field" << fieldName << "not found", );
+
+    if(isFieldObjectIndexable(_fields[fieldId]))
+        buildFieldObjectIndexInternal(fieldId);
+}
+
+void SceneData::buildFieldObjectIndices() const {
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        if(isFieldObjectIndexable(_fields[i]))
+            buildFieldObjectIndexInternal(i);
+}
+
+bool SceneData::hasFieldObjectIndex(const UnsignedInt fieldId) const {
+    CORRADE_ASSERT(fieldId < _fields.size(),
+        "Trade::SceneData::hasFieldObjectIndex(): index" << fieldId << "out of range for" << _fields.size() << "fields", {});
+
+    return isFieldObjectIndexable(_fields[fieldId]) &&
+        _objectIndex->fields[fieldId].index.load(std::memory_order_acquire);
+}
+
+bool SceneData::hasFieldObjectIndex(const SceneField fieldName) const {
+    const UnsignedInt fieldId = findFieldIdInternal(fieldName);
+    CORRADE_ASSERT(fieldId != ~UnsignedInt{},
+        "Trade::SceneData::hasFieldObjectIndex(): field" << fieldName << "not found", {});
+
+    return isFieldObjectIndexable(_fields[fieldId]) &&
+        _objectIndex->fields[fieldId].index.load(std::memory_order_acquire);
+}
+
 SceneFieldFlags SceneData::fieldFlags(const SceneField name) const {
     const UnsignedInt fieldId = findFieldIdInternal(name);
     CORRADE_ASSERT(fieldId != ~UnsignedInt{}, "Trade::SceneData::fieldFlags(): field" << name << "not found", {});
@@ -1372,6 +1601,11 @@ Containers::StridedArrayView2D<char> SceneData::mutableMapping(const UnsignedInt
         "Trade::SceneData::mutableMapping(): data not mutable", {});
     CORRADE_ASSERT(fieldId < _fields.size(),
         "Trade::SceneData::mutableMapping(): index" << fieldId << "out of range for" << _fields.size() << "fields", {});
+    /* The mapping may get modified, so discard the object indices. Not just
+       the index of this field, as the mapping view can be shared with other
+       fields, such as TRS or mesh and material fields. */
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        discardFieldObjectIndexInternal(i);
     const SceneFieldData& field = _fields[fieldId];
     /* Build a 2D view using information about attribute type size */
     const auto out = Containers::arrayCast<2, const char>(
@@ -2926,11 +3160,13 @@ std::vector<UnsignedInt> SceneData::children3D() const {
 Containers::Array<SceneFieldData> SceneData::releaseFieldData() {
     Containers::Array<SceneFieldData> out = std::move(_fields);
     _fields = {};
+    _objectIndex = nullptr;
     return out;
 }
 
 Containers::Array<char> SceneData::releaseData() {
     _fields = {};
+    _objectIndex = nullptr;
     Containers::Array<char> out = std::move(_data);
     _data = {};
     return out;
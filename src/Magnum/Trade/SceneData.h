@@ -30,6 +30,7 @@
  */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Macros.h> /* CORRADE_UNUSED */
 
@@ -99,6 +100,9 @@ MAGNUM_TRADE_EXPORT UnsignedInt sceneMappingTypeAlignment(SceneMappingType type)
 
 namespace Implementation {
     enum: UnsignedInt { SceneFieldCustom = 0x80000000u };
+
+    struct SceneObjectIndex;
+    struct SceneFieldObjectIndex;
 }
 
 /**
@@ -735,7 +739,9 @@ enum class SceneFieldFlag: UnsignedByte {
      *
      * If a field has neither this nor the @ref SceneFieldFlag::ImplicitMapping
      * flag, it's assumed to be unordered, with an
-     * @f$ \mathcal{O}(n) @f$ lookup complexity.
+     * @f$ \mathcal{O}(n) @f$ lookup complexity unless an object index is
+     * built for it. See @ref Trade-SceneData-usage-per-object-index for more
+     * information.
      */
     OrderedMapping = 1 << 1,
 
@@ -752,7 +758,9 @@ enum class SceneFieldFlag: UnsignedByte {
      *
      * If a field has neither this nor the @ref SceneFieldFlag::OrderedMapping
      * flag, it's assumed to be unordered, with an
-     * @f$ \mathcal{O}(n) @f$ lookup complexity.
+     * @f$ \mathcal{O}(n) @f$ lookup complexity unless an object index is
+     * built for it. See @ref Trade-SceneData-usage-per-object-index for more
+     * information.
      */
     ImplicitMapping = (1 << 2)|OrderedMapping,
 
@@ -1709,6 +1717,26 @@ scene representations these are suited mainly for introspection and debugging
 purposes and retrieving field data for many objects is better achieved by
 accessing the field data directly.
 
+@subsection Trade-SceneData-usage-per-object-index Object index for unordered fields
+
+To avoid quadratic complexity when querying many objects in fields that have
+neither @ref SceneFieldFlag::OrderedMapping nor
+@ref SceneFieldFlag::ImplicitMapping set, @ref SceneData maintains a per-field
+object index. It's built lazily once the linear lookups in given field went
+through as many entries as the field has, after which all lookups in that field
+are done in constant time. If the mapping bound is too large compared to the
+field size, the index stores just the objects present in the field and the
+lookup is logarithmic in the count of distinct objects instead.
+
+If you know upfront that you'll be querying many objects, you can build the
+index eagerly with @ref buildFieldObjectIndex(). Building the index is
+thread-safe, so it's also possible to query a @cpp const @ce instance from
+multiple threads. As the index is derived from the mapping data, calling
+@ref mutableMapping() or @ref mutableData() discards indices of all fields,
+since the mapping view may be shared among several fields, and they get built
+again after. Modifying the mapping through a view retrieved earlier while
+doing lookups at the same time is not supported and may lead to wrong results.
+
 @section Trade-SceneData-usage-mutable Mutable data access
 
 The interfaces implicitly provide @cpp const @ce views on the contained object
@@ -2263,6 +2291,66 @@ class MAGNUM_TRADE_EXPORT SceneData {
          */
         bool hasFieldObject(SceneField fieldName, UnsignedLong object) const;
 
+        /**
+         * @brief Build an object index for given field
+         * @m_since_latest
+         *
+         * Builds an index for constant-time object lookup in
+         * @ref findFieldObjectOffset(), @ref fieldObjectOffset(),
+         * @ref hasFieldObject() and all APIs based on these, such as
+         * @ref parentFor() or @ref meshesMaterialsFor(). If the index is
+         * already built or if the field has @ref SceneFieldFlag::OrderedMapping
+         * or @ref SceneFieldFlag::ImplicitMapping set, does nothing. The index
+         * is otherwise built lazily, this function is useful mainly to avoid
+         * the cost of the initial linear lookups. See
+         * @ref Trade-SceneData-usage-per-object-index for more information.
+         *
+         * The @p fieldId is expected to be smaller than @ref fieldCount().
+         * @see @ref hasFieldObjectIndex(UnsignedInt) const,
+         *      @ref buildFieldObjectIndices()
+         */
+        void buildFieldObjectIndex(UnsignedInt fieldId) const;
+
+        /**
+         * @brief Build an object index for given named field
+         * @m_since_latest
+         *
+         * Like @ref buildFieldObjectIndex(UnsignedInt) const, but the field is
+         * looked up by name. The @p fieldName is expected to exist.
+         */
+        void buildFieldObjectIndex(SceneField fieldName) const;
+
+        /**
+         * @brief Build an object index for all fields
+         * @m_since_latest
+         *
+         * Calls @ref buildFieldObjectIndex(UnsignedInt) const for all fields
+         * that have neither @ref SceneFieldFlag::OrderedMapping nor
+         * @ref SceneFieldFlag::ImplicitMapping set.
+         */
+        void buildFieldObjectIndices() const;
+
+        /**
+         * @brief Whether a field has an object index
+         * @m_since_latest
+         *
+         * Returns @cpp false @ce for fields with
+         * @ref SceneFieldFlag::OrderedMapping or
+         * @ref SceneFieldFlag::ImplicitMapping, which don't need an index.
+         * The @p fieldId is expected to be smaller than @ref fieldCount().
+         * @see @ref buildFieldObjectIndex(UnsignedInt) const
+         */
+        bool hasFieldObjectIndex(UnsignedInt fieldId) const;
+
+        /**
+         * @brief Whether a named field has an object index
+         * @m_since_latest
+         *
+         * Like @ref hasFieldObjectIndex(UnsignedInt) const, but the field is
+         * looked up by name. The @p fieldName is expected to exist.
+         */
+        bool hasFieldObjectIndex(SceneField fieldName) const;
+
         /**
          * @brief Flags of a named field
          * @m_since_latest
@@ -3678,6 +3766,10 @@ class MAGNUM_TRADE_EXPORT SceneData {
            ~UnsignedInt{} on failure */
         UnsignedInt findFieldIdInternal(SceneField name) const;
 
+        MAGNUM_TRADE_LOCAL bool isFieldObjectIndexable(const SceneFieldData& field) const;
+        MAGNUM_TRADE_LOCAL const Implementation::SceneFieldObjectIndex* buildFieldObjectIndexInternal(UnsignedInt fieldId) const;
+        MAGNUM_TRADE_LOCAL void discardFieldObjectIndexInternal(UnsignedInt fieldId);
+
         /* Returns the offset at which `object` is for field at index `id`, or
            the end offset if the object is not found. The returned offset can
            be then passed to fieldData{Mapping,Field}ViewInternal(). */
@@ -3719,6 +3811,10 @@ class MAGNUM_TRADE_EXPORT SceneData {
         const void* _importerState;
         Containers::Array<SceneFieldData> _fields;
         Containers::Array<char> _data;
+        /* Lazily populated object indices for fields that have neither an
+           ordered nor an implicit mapping, null if there are no such
+           fields */
+        Containers::Pointer<Implementation::SceneObjectIndex> _objectIndex;
 };
 
 namespace Implementation {
@@ -164,6 +164,11 @@ struct SceneDataTest: TestSuite::Tester {
     void findFieldId();
     template<class T> void findFieldObjectOffset();
     void findFieldObjectOffsetInvalidOffset();
+    template<class T> void fieldObjectIndex();
+    void fieldObjectIndexSparse();
+    void fieldObjectIndexLazy();
+    void fieldObjectIndexDiscardedOnMutableAccess();
+    void fieldObjectIndexDiscardedOnSharedMappingMutableAccess();
     void fieldObjectOffsetNotFound();
 
     template<class T> void mappingAsArrayByIndex();
@@ -527,6 +532,14 @@ SceneDataTest::SceneDataTest() {
     }, Containers::arraySize(FindFieldObjectOffsetData));
 
     addTests({&SceneDataTest::findFieldObjectOffsetInvalidOffset,
+              &SceneDataTest::fieldObjectIndex<UnsignedByte>,
+              &SceneDataTest::fieldObjectIndex<UnsignedShort>,
+              &SceneDataTest::fieldObjectIndex<UnsignedInt>,
+              &SceneDataTest::fieldObjectIndex<UnsignedLong>,
+              &SceneDataTest::fieldObjectIndexSparse,
+              &SceneDataTest::fieldObjectIndexLazy,
+              &SceneDataTest::fieldObjectIndexDiscardedOnMutableAccess,
+              &SceneDataTest::fieldObjectIndexDiscardedOnSharedMappingMutableAccess,
               &SceneDataTest::fieldObjectOffsetNotFound,
 
               &SceneDataTest::mappingAsArrayByIndex<UnsignedByte>,
@@ -4211,6 +4224,17 @@ template<class T> void SceneDataTest::findFieldObjectOffset() {
         CORRADE_COMPARE(scene.fieldObjectOffset(1, data.object, data.offset), *data.expected);
         CORRADE_COMPARE(scene.fieldObjectOffset(SceneField::Mesh, data.object, data.offset), *data.expected);
     }
+
+    /* Building an object index should give back the same results. It's built
+       only for fields with unordered mapping. */
+    scene.buildFieldObjectIndices();
+    CORRADE_COMPARE(scene.hasFieldObjectIndex(1), !(data.flags >= SceneFieldFlag::OrderedMapping));
+    CORRADE_COMPARE(scene.findFieldObjectOffset(1, data.object, data.offset), data.expected);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(SceneField::Mesh, data.object, data.offset), data.expected);
+    if(data.offset == 0) {
+        CORRADE_COMPARE(scene.findFieldObjectOffset(0, data.object), Containers::NullOpt);
+        CORRADE_COMPARE(scene.hasFieldObject(1, data.object), !!data.expected);
+    }
 }
 
 void SceneDataTest::findFieldObjectOffsetInvalidOffset() {
@@ -6537,6 +6561,179 @@ void SceneDataTest::mappingWrongType() {
         "Trade::SceneData::mutableMapping(): mapping is Trade::SceneMappingType::UnsignedShort but requested Trade::SceneMappingType::UnsignedByte\n");
 }
 
+template<class T> void SceneDataTest::fieldObjectIndex() {
+    setTestCaseTemplateName(NameTraits<T>::name());
+
+    /* Multiple entries per object, some objects not present at all */
+    struct Field {
+        T object;
+        UnsignedInt mesh;
+    } fields[]{
+        {T(3), 0},
+        {T(1), 1},
+        {T(3), 2},
+        {T(0), 3},
+        {T(5), 4},
+        {T(3), 5},
+        {T(1), 6},
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    SceneData scene{Implementation::sceneMappingTypeFor<T>(), 7, {}, fields, {
+        SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh)}
+    }};
+
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(0));
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(SceneField::Mesh));
+    scene.buildFieldObjectIndex(SceneField::Mesh);
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Mesh));
+
+    /* Building again is a no-op */
+    scene.buildFieldObjectIndex(0);
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3), 0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 1), 2);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 3), 5);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3, 6), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1, 2), 6);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), 3);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 5), 4);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 2), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 6), Containers::NullOpt);
+    CORRADE_COMPARE_AS(scene.meshesMaterialsFor(3),
+        (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+            {0, -1}, {2, -1}, {5, -1}
+        })), TestSuite::Compare::Container);
+}
+
+void SceneDataTest::fieldObjectIndexSparse() {
+    /* The mapping bound is much larger than the field, so a sparse index
+       gets built instead of a dense one */
+    struct Field {
+        UnsignedInt object;
+        UnsignedInt mesh;
+    } fields[]{
+        {999999, 0},
+        {35, 1},
+        {767676, 2},
+        {35, 3},
+        {0, 4},
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    SceneData scene{SceneMappingType::UnsignedInt, 1000000, {}, fields, {
+        SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh)}
+    }};
+
+    scene.buildFieldObjectIndices();
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 999999), 0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 35), 1);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 35, 2), 3);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 35, 4), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 767676), 2);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), 4);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 767677), Containers::NullOpt);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 999998), Containers::NullOpt);
+}
+
+void SceneDataTest::fieldObjectIndexLazy() {
+    struct Field {
+        UnsignedInt object;
+        UnsignedInt mesh;
+    } fields[]{
+        {3, 0},
+        {1, 1},
+        {2, 2},
+        {0, 3},
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    SceneData scene{SceneMappingType::UnsignedInt, 4, {}, fields, {
+        SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh)}
+    }};
+
+    /* Lookups that visited less entries than the field has don't build the
+       index yet */
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 3), 0);
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 1), 1);
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(0));
+
+    /* With this one the lookups visited all entries, so it gets built */
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), 3);
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 2), 2);
+}
+
+void SceneDataTest::fieldObjectIndexDiscardedOnMutableAccess() {
+    struct Field {
+        UnsignedInt object;
+        UnsignedInt mesh;
+    } fields[]{
+        {3, 0},
+        {1, 1},
+        {2, 2},
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    SceneData scene{SceneMappingType::UnsignedInt, 4, DataFlag::Mutable, fields, {
+        SceneFieldData{SceneField::Mesh, view.slice(&Field::object), view.slice(&Field::mesh)}
+    }};
+
+    scene.buildFieldObjectIndices();
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), Containers::NullOpt);
+
+    /* Changing the mapping discards the index and the lookup sees the new
+       data */
+    scene.mutableMapping<UnsignedInt>(SceneField::Mesh)[1] = 0;
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(0));
+    CORRADE_COMPARE(scene.findFieldObjectOffset(0, 0), 1);
+
+    scene.buildFieldObjectIndices();
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(0));
+
+    /* Same with the whole data */
+    scene.mutableData();
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(0));
+}
+
+void SceneDataTest::fieldObjectIndexDiscardedOnSharedMappingMutableAccess() {
+    struct Field {
+        UnsignedInt object;
+        Vector3 translation;
+        Quaternion rotation;
+    } fields[]{
+        {3, {1.0f, 0.0f, 0.0f}, Quaternion::rotation(90.0_degf, Vector3::xAxis())},
+        {1, {2.0f, 0.0f, 0.0f}, Quaternion::rotation(90.0_degf, Vector3::yAxis())},
+        {2, {3.0f, 0.0f, 0.0f}, Quaternion::rotation(90.0_degf, Vector3::zAxis())},
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    /* TRS fields are required to share the mapping view */
+    SceneData scene{SceneMappingType::UnsignedInt, 4, DataFlag::Mutable, fields, {
+        SceneFieldData{SceneField::Translation, view.slice(&Field::object), view.slice(&Field::translation)},
+        SceneFieldData{SceneField::Rotation, view.slice(&Field::object), view.slice(&Field::rotation)}
+    }};
+
+    scene.buildFieldObjectIndices();
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Translation));
+    CORRADE_VERIFY(scene.hasFieldObjectIndex(SceneField::Rotation));
+    CORRADE_COMPARE(scene.rotationFor(0), Containers::NullOpt);
+
+    /* Changing the mapping through one field discards the index of the other
+       field as well, and lookups in it see the new data */
+    scene.mutableMapping<UnsignedInt>(SceneField::Translation)[1] = 0;
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(SceneField::Translation));
+    CORRADE_VERIFY(!scene.hasFieldObjectIndex(SceneField::Rotation));
+    CORRADE_COMPARE(scene.rotationFor(0), Quaternion::rotation(90.0_degf, Vector3::yAxis()));
+    CORRADE_COMPARE(scene.rotationFor(1), Containers::NullOpt);
+}
+
 void SceneDataTest::fieldNotFound() {
     CORRADE_SKIP_IF_NO_ASSERT();
 
@@ -6557,6 +6754,8 @@ void SceneDataTest::fieldNotFound() {
     scene.findFieldObjectOffset(2, 0);
     scene.fieldObjectOffset(2, 0);
     scene.hasFieldObject(2, 0);
+    scene.buildFieldObjectIndex(2);
+    scene.hasFieldObjectIndex(2);
     scene.fieldData(2);
     scene.fieldName(2);
     scene.fieldFlags(2);
@@ -6583,6 +6782,8 @@ void SceneDataTest::fieldNotFound() {
     scene.findFieldObjectOffset(sceneFieldCustom(666), 0);
     scene.fieldObjectOffset(sceneFieldCustom(666), 0);
     scene.hasFieldObject(sceneFieldCustom(666), 0);
+    scene.buildFieldObjectIndex(sceneFieldCustom(666));
+    scene.hasFieldObjectIndex(sceneFieldCustom(666));
     scene.fieldType(sceneFieldCustom(666));
     scene.fieldSize(sceneFieldCustom(666));
     scene.fieldArraySize(sceneFieldCustom(666));
@@ -6636,6 +6837,8 @@ void SceneDataTest::fieldNotFound() {
         "Trade::SceneData::findFieldObjectOffset(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldObjectOffset(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::hasFieldObject(): index 2 out of range for 2 fields\n"
+        "Trade::SceneData::buildFieldObjectIndex(): index 2 out of range for 2 fields\n"
+        "Trade::SceneData::hasFieldObjectIndex(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldData(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldName(): index 2 out of range for 2 fields\n"
         "Trade::SceneData::fieldFlags(): index 2 out of range for 2 fields\n"
@@ -6662,6 +6865,8 @@ void SceneDataTest::fieldNotFound() {
         "Trade::SceneData::findFieldObjectOffset(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldObjectOffset(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::hasFieldObject(): field Trade::SceneField::Custom(666) not found\n"
+        "Trade::SceneData::buildFieldObjectIndex(): field Trade::SceneField::Custom(666) not found\n"
+        "Trade::SceneData::hasFieldObjectIndex(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldType(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldSize(): field Trade::SceneField::Custom(666) not found\n"
         "Trade::SceneData::fieldArraySize(): field Trade::SceneField::Custom(666) not found\n"
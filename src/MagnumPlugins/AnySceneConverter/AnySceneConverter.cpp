@@ -86,6 +86,8 @@ bool AnySceneConverter::doConvertToFile(const MeshData& mesh, const Containers::
     if(normalizedExtension == ".gltf"_s ||
        normalizedExtension == ".glb"_s)
         plugin = "GltfSceneConverter"_s;
+    else if(normalizedExtension == ".blob"_s)
+        plugin = "MagnumSceneConverter"_s;
     else if(normalizedExtension == ".ply"_s)
         plugin = "StanfordSceneConverter"_s;
     else {
@@ -138,6 +140,8 @@ bool AnySceneConverter::doBeginFile(const Containers::StringView filename) {
     if(normalizedExtension == ".gltf"_s ||
        normalizedExtension == ".glb"_s)
         plugin = "GltfSceneConverter"_s;
+    else if(normalizedExtension == ".blob"_s)
+        plugin = "MagnumSceneConverter"_s;
     else if(normalizedExtension == ".ply"_s)
         plugin = "StanfordSceneConverter"_s;
     else {
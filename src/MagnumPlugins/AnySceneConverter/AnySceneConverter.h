@@ -62,6 +62,8 @@ tries to convert the file with it. Supported formats:
 
 -   glTF (`*.gltf`, `*.glb`), converted with @ref GltfSceneConverter or any
     other plugin that provides it
+-   Magnum blob (`*.blob`), converted with @ref MagnumSceneConverter or any
+    other plugin that provides it
 -   Stanford (`*.ply`), converted with @ref StanfordSceneConverter or any other
     plugin that provides it
 
@@ -75,6 +75,7 @@ constexpr struct {
 } DetectConvertData[]{
     {"glTF", "khronos.gltf", "GltfSceneConverter"},
     {"glTF binary", "khronos.glb", "GltfSceneConverter"},
+    {"Magnum blob", "scene.blob", "MagnumSceneConverter"},
     {"Stanford PLY", "bunny.ply", "StanfordSceneConverter"},
     /* Have at least one test case with uppercase */
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordSceneConverter"}
@@ -87,6 +88,7 @@ constexpr struct {
 } DetectBeginEndData[]{
     {"glTF", "khronos.gltf", "GltfSceneConverter"},
     {"glTF binary", "khronos.glb", "GltfSceneConverter"},
+    {"Magnum blob", "scene.blob", "MagnumSceneConverter"},
     {"Stanford PLY", "bunny.ply", "StanfordSceneConverter"},
     /* Have at least one test case with uppercase */
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordSceneConverter"}
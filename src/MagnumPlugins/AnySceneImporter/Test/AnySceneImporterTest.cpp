@@ -94,6 +94,7 @@ constexpr struct {
     {"FBX", "autodesk.fbx", "FbxImporter"},
     {"glTF", "khronos.gltf", "GltfImporter"},
     {"glTF binary", "khronos.glb", "GltfImporter"},
+    {"Magnum blob", "scene.blob", "MagnumImporter"},
     {"OpenGEX", "eric.ogex", "OpenGexImporter"},
     {"Stanford PLY", "bunny.ply", "StanfordImporter"},
     {"Stanford PLY uppercase", "ARMADI~1.PLY", "StanfordImporter"},
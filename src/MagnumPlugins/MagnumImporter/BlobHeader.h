@@ -0,0 +1,223 @@
+#ifndef Magnum_Trade_BlobHeader_h
+#define Magnum_Trade_BlobHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+
+/* Used by both MagnumImporter and MagnumSceneConverter, which is why it isn't
+   directly inside MagnumImporter.cpp. OTOH it doesn't need to be exposed
+   publicly, which is why it has no docblocks.
+
+   The file starts with a BlobHeader, followed by BlobHeader::chunkCount
+   chunks. Each chunk starts with a type-specific header, which in turn starts
+   with a BlobChunk, followed by a null-terminated name of BlobChunk::nameSize
+   bytes and then data referenced by offsets in the type-specific header.
+   Offsets are relative to the chunk start, every chunk and every piece of data
+   inside it is aligned to BlobAlignment bytes. Arrays of MeshAttributeData,
+   SceneFieldData and MaterialAttributeData are stored verbatim in their
+   in-memory representation, with mesh attributes and scene fields being
+   offset-only, so the importer can reference them directly. Because of that
+   the format is tied to the pointer size, endianness and Magnum version and
+   isn't meant to be an interchange format.
+
+   The header records the pointer size, endianness, sizes of the three stored
+   types and a blobLayoutHash() that additionally covers their alignment, the
+   custom attribute / field ID bases and sizes of all Blob* structures, and
+   the importer rejects files where any of these differ. That can't detect a
+   change in the order or meaning of private members that keeps the size
+   intact, so BlobVersion *has to be* bumped every time the internal layout
+   of MeshAttributeData, SceneFieldData or MaterialAttributeData or any of
+   the structures below changes. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+enum: UnsignedByte { BlobVersion = 1 };
+enum: std::size_t { BlobAlignment = 8 };
+
+constexpr std::size_t blobAligned(std::size_t size) {
+    return (size + BlobAlignment - 1) & ~(BlobAlignment - 1);
+}
+
+enum class BlobChunkType: UnsignedInt {
+    Scene = Utility::Endianness::fourCC('S', 'C', 'N', 'E'),
+    Mesh = Utility::Endianness::fourCC('M', 'E', 'S', 'H'),
+    Material = Utility::Endianness::fourCC('M', 'A', 'T', 'L'),
+    Image1D = Utility::Endianness::fourCC('I', 'M', 'G', '1'),
+    Image2D = Utility::Endianness::fourCC('I', 'M', 'G', '2'),
+    Image3D = Utility::Endianness::fourCC('I', 'M', 'G', '3'),
+    ObjectName = Utility::Endianness::fourCC('O', 'N', 'A', 'M'),
+    SceneFieldName = Utility::Endianness::fourCC('S', 'F', 'N', 'M'),
+    MeshAttributeName = Utility::Endianness::fourCC('M', 'A', 'N', 'M')
+};
+
+struct BlobHeader {
+    char signature[4];                      /* MGBL */
+    UnsignedByte version;                   /* BlobVersion */
+    UnsignedByte pointerSize;               /* sizeof(void*) of the writer */
+    UnsignedByte bigEndian;                 /* 1 if written on Big-Endian */
+    UnsignedByte reserved;
+    UnsignedShort meshAttributeDataSize;    /* sizeof(MeshAttributeData) */
+    UnsignedShort sceneFieldDataSize;       /* sizeof(SceneFieldData) */
+    UnsignedShort materialAttributeDataSize;/* sizeof(MaterialAttributeData) */
+    UnsignedShort layoutHash;               /* blobLayoutHash() */
+    Int defaultScene;                       /* -1 if there's none */
+    UnsignedInt chunkCount;
+    UnsignedLong size;                      /* Size of the whole file */
+};
+
+struct BlobChunk {
+    UnsignedInt type;                       /* BlobChunkType */
+    UnsignedInt nameSize;                   /* Excluding the null terminator */
+    UnsignedLong size;                      /* Including this header */
+};
+
+struct BlobScene {
+    BlobChunk chunk;
+    UnsignedByte mappingType;               /* SceneMappingType */
+    UnsignedByte reserved[3];
+    UnsignedInt fieldCount;
+    UnsignedLong mappingBound;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+    UnsignedLong fieldDataOffset;           /* SceneFieldData[fieldCount] */
+};
+
+struct BlobMesh {
+    BlobChunk chunk;
+    UnsignedInt primitive;                  /* MeshPrimitive */
+    UnsignedInt indexType;                  /* MeshIndexType, 0 if not indexed */
+    UnsignedInt indexCount;
+    Int indexStride;
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong indexOffset;               /* Relative to index data */
+    UnsignedInt vertexCount;
+    UnsignedInt attributeCount;
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+    UnsignedLong attributeDataOffset;       /* MeshAttributeData[attributeCount] */
+};
+
+struct BlobMaterial {
+    BlobChunk chunk;
+    UnsignedInt types;                      /* MaterialTypes */
+    UnsignedInt attributeCount;
+    UnsignedInt layerCount;                 /* 0 if there's no layer data */
+    UnsignedInt reserved;
+    UnsignedLong attributeDataOffset;       /* MaterialAttributeData[attributeCount] */
+    UnsignedLong layerDataOffset;           /* UnsignedInt[layerCount] */
+};
+
+/* Used for all of Image1D, Image2D and Image3D, with unused size and storage
+   components being zero */
+struct BlobImage {
+    BlobChunk chunk;
+    UnsignedByte compressed;
+    UnsignedByte reserved;
+    UnsignedShort flags;                    /* ImageFlags1D / 2D / 3D */
+    UnsignedInt format;                     /* PixelFormat / CompressedPixelFormat */
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    Int size[3];
+    Int alignment;
+    Int rowLength;
+    Int imageHeight;
+    Int skip[3];
+    Int compressedBlockSize[3];
+    Int compressedBlockDataSize;
+    UnsignedInt reserved2;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+struct BlobObjectName {
+    BlobChunk chunk;
+    UnsignedLong object;
+};
+
+/* Used for both SceneFieldName and MeshAttributeName */
+struct BlobCustomName {
+    BlobChunk chunk;
+    UnsignedInt id;                         /* Custom field / attribute ID */
+    UnsignedInt reserved;
+};
+
+static_assert(sizeof(BlobHeader) == 32, "BlobHeader size is not 32 bytes");
+static_assert(sizeof(BlobChunk) == 16, "BlobChunk size is not 16 bytes");
+static_assert(sizeof(BlobScene) == 56, "BlobScene size is not 56 bytes");
+static_assert(sizeof(BlobMesh) == 88, "BlobMesh size is not 88 bytes");
+static_assert(sizeof(BlobMaterial) == 48, "BlobMaterial size is not 48 bytes");
+static_assert(sizeof(BlobImage) == 104, "BlobImage size is not 104 bytes");
+static_assert(sizeof(BlobObjectName) == 24, "BlobObjectName size is not 24 bytes");
+static_assert(sizeof(BlobCustomName) == 24, "BlobCustomName size is not 24 bytes");
+
+/* One round of FNV-1a on a whole value instead of each byte, good enough for
+   telling layouts apart */
+constexpr UnsignedInt blobLayoutHashRound(const UnsignedInt hash, const std::size_t value) {
+    return (hash ^ UnsignedInt(value))*16777619u;
+}
+
+constexpr UnsignedShort blobLayoutHash() {
+    return UnsignedShort(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(
+        blobLayoutHashRound(2166136261u,
+            sizeof(MeshAttributeData)),
+            alignof(MeshAttributeData)),
+            sizeof(SceneFieldData)),
+            alignof(SceneFieldData)),
+            sizeof(MaterialAttributeData)),
+            alignof(MaterialAttributeData)),
+            Trade::Implementation::MeshAttributeCustom),
+            Trade::Implementation::SceneFieldCustom),
+            sizeof(BlobScene)),
+            sizeof(BlobMesh)),
+            sizeof(BlobMaterial)),
+            sizeof(BlobImage)),
+            sizeof(BlobObjectName)),
+            sizeof(BlobCustomName))
+        >> 16);
+}
+
+}}}
+
+#endif
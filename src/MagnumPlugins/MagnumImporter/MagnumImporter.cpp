@@ -0,0 +1,989 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImporter.h"
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+struct MagnumImporter::File {
+    /* Either data passed to openData() (taken over or copied) or a
+       non-owning view on the memory-mapped file stored below */
+    Containers::Array<char> in;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+    #endif
+
+    /* ExternallyOwned if the memory came from openMemory() and thus outlives
+       the importer, empty otherwise */
+    DataFlags dataFlags;
+
+    Int defaultScene;
+    UnsignedLong objectCount{};
+
+    /* Pointers to chunk headers in the `in` array */
+    Containers::Array<const Implementation::BlobScene*> scenes;
+    Containers::Array<const Implementation::BlobMesh*> meshes;
+    Containers::Array<const Implementation::BlobMaterial*> materials;
+    Containers::Array<const Implementation::BlobImage*> images1D;
+    Containers::Array<const Implementation::BlobImage*> images2D;
+    Containers::Array<const Implementation::BlobImage*> images3D;
+
+    /* Views on null-terminated names in the `in` array */
+    std::unordered_map<UnsignedLong, Containers::StringView> objectNames;
+    std::unordered_map<UnsignedInt, Containers::StringView> sceneFieldNames;
+    std::unordered_map<UnsignedInt, Containers::StringView> meshAttributeNames;
+};
+
+namespace {
+
+template<class T> Containers::StringView chunkName(const T& header) {
+    return {reinterpret_cast<const char*>(&header) + sizeof(T), header.chunk.nameSize, Containers::StringViewFlag::NullTerminated};
+}
+
+template<class T> Int chunkForName(const Containers::Array<const T*>& chunks, const Containers::StringView name) {
+    for(std::size_t i = 0; i != chunks.size(); ++i)
+        if(chunkName(*chunks[i]) == name) return i;
+    return -1;
+}
+
+/* Checks that the chunk is large enough for the type-specific header and the
+   null-terminated name that follows it */
+template<class T> const T* chunkHeader(const Containers::ArrayView<const char> chunk, const UnsignedInt id) {
+    const std::size_t nameSize = reinterpret_cast<const Implementation::BlobChunk*>(chunk.data())->nameSize;
+    if(chunk.size() < sizeof(T) + nameSize + 1 || chunk[sizeof(T) + nameSize] != '\0') {
+        Error{} << "Trade::MagnumImporter::openData(): chunk" << id << "is too small for its header and name";
+        return nullptr;
+    }
+
+    return reinterpret_cast<const T*>(chunk.data());
+}
+
+/* Checks that a data range referenced from a chunk header is aligned and
+   inside the chunk */
+bool checkChunkRange(const Containers::ArrayView<const char> chunk, const UnsignedInt id, const UnsignedLong offset, const UnsignedLong size) {
+    if(offset % Implementation::BlobAlignment || offset > chunk.size() || size > chunk.size() - offset) {
+        Error{} << "Trade::MagnumImporter::openData(): data range [" << Debug::nospace << offset << Debug::nospace << ":" << Debug::nospace << offset + size << Debug::nospace << "] of chunk" << id << "is not aligned or out of bounds for" << chunk.size() << "bytes";
+        return false;
+    }
+
+    return true;
+}
+
+/* Checks that `count` items of `typeSize` bytes, `stride` bytes apart and
+   starting at `offset` fit into `size` bytes. Same calculation as in the
+   MeshData and SceneData constructors, except that it works with arbitrary
+   garbage on input without overflowing. Works with bits as well. */
+bool isRangeInBounds(const UnsignedLong size, const UnsignedLong offset, const UnsignedLong count, const Long stride, const UnsignedLong typeSize) {
+    /* Nothing gets accessed for empty views */
+    if(!count) return true;
+
+    const UnsignedLong absStride = stride < 0 ? -stride : stride;
+    if(absStride && count - 1 > ~UnsignedLong{}/absStride) return false;
+    const UnsignedLong span = (count - 1)*absStride;
+
+    /* For negative strides the offset points to the last item in memory */
+    UnsignedLong begin = offset;
+    if(stride < 0) {
+        if(span > begin) return false;
+        begin -= span;
+    }
+
+    return begin <= size && span <= size - begin && typeSize <= size - begin - span;
+}
+
+/* The offset-only MeshAttributeData and SceneFieldData provide offsets and
+   strides only through data views, which are created on a view with a fake
+   size in order to extract them before they're checked against the actual
+   data size. Same as MeshAttributeData::data() and SceneFieldData::fieldData()
+   do. For bits the view has to be small enough to fit into a bit view. */
+constexpr std::size_t FakeDataSize = ~std::size_t{};
+constexpr std::size_t FakeBitDataSize = (std::size_t{1} << (sizeof(std::size_t)*8 - 3))/8 - 1;
+
+bool checkMesh(const Implementation::BlobMesh& mesh) {
+    const char* const chunk = reinterpret_cast<const char*>(&mesh);
+
+    const MeshPrimitive primitive = MeshPrimitive(mesh.primitive);
+    if(!isMeshPrimitiveImplementationSpecific(primitive) && (!mesh.primitive || mesh.primitive > UnsignedInt(MeshPrimitive::Meshlets))) {
+        Error{} << "Trade::MagnumImporter::mesh(): invalid primitive" << primitive;
+        return false;
+    }
+
+    /* Index data are allowed only if there are any indices, same as in the
+       MeshData constructor */
+    if((!mesh.indexType || !mesh.indexCount) && mesh.indexDataSize) {
+        Error{} << "Trade::MagnumImporter::mesh(): expected no index data for a mesh with no indices but got" << mesh.indexDataSize << "bytes";
+        return false;
+    }
+    if(mesh.indexType) {
+        const MeshIndexType indexType = MeshIndexType(mesh.indexType);
+        const bool isImplementationSpecific = isMeshIndexTypeImplementationSpecific(indexType);
+        if(!isImplementationSpecific && mesh.indexType > UnsignedInt(MeshIndexType::UnsignedInt)) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid index type" << indexType;
+            return false;
+        }
+        if(mesh.indexStride < -32768 || mesh.indexStride > 32767) {
+            Error{} << "Trade::MagnumImporter::mesh(): expected index stride to fit into 16 bits but got" << mesh.indexStride;
+            return false;
+        }
+        /* Size of implementation-specific types is unknown, check at least
+           the offset in that case */
+        if(!isRangeInBounds(mesh.indexDataSize, mesh.indexOffset, mesh.indexCount, mesh.indexStride, isImplementationSpecific ? 0 : meshIndexTypeSize(indexType))) {
+            Error{} << "Trade::MagnumImporter::mesh(): indices out of range for" << mesh.indexDataSize << "bytes of index data";
+            return false;
+        }
+    }
+
+    const Containers::ArrayView<const MeshAttributeData> attributes{reinterpret_cast<const MeshAttributeData*>(chunk + mesh.attributeDataOffset), mesh.attributeCount};
+    if(attributes.isEmpty() && mesh.vertexCount == MeshData::ImplicitVertexCount) {
+        Error{} << "Trade::MagnumImporter::mesh(): vertex count can't be implicit if there are no attributes";
+        return false;
+    }
+
+    /* Same as in the MeshData constructor, the attributes all have to have
+       the same vertex count but the mesh vertex count, if not implicit, can
+       be different */
+    const Containers::ArrayView<const void> vertexData{chunk + mesh.vertexDataOffset, FakeDataSize};
+    const UnsignedInt expectedAttributeVertexCount = attributes.isEmpty() ? 0 : attributes[0].data(vertexData).size();
+    const UnsignedInt vertexCount = mesh.vertexCount == MeshData::ImplicitVertexCount ? expectedAttributeVertexCount : mesh.vertexCount;
+    UnsignedInt jointIdAttributeCount = 0;
+    UnsignedInt weightAttributeCount = 0;
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const MeshAttributeData& attribute = attributes[i];
+        if(!attribute.isOffsetOnly()) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "is not offset-only";
+            return false;
+        }
+
+        const MeshAttribute name = attribute.name();
+        if(!isMeshAttributeCustom(name) && (!UnsignedShort(name) || UnsignedShort(name) > UnsignedShort(MeshAttribute::ObjectId))) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid attribute" << i << "name" << name;
+            return false;
+        }
+
+        const VertexFormat format = attribute.format();
+        const bool isImplementationSpecific = isVertexFormatImplementationSpecific(format);
+        if(!isImplementationSpecific && (!UnsignedInt(format) || UnsignedInt(format) > UnsignedInt(VertexFormat::Matrix4x3sNormalizedAligned))) {
+            Error{} << "Trade::MagnumImporter::mesh(): invalid attribute" << i << "format" << format;
+            return false;
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format)) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "format" << format << "is not valid for" << name;
+            return false;
+        }
+        if(attribute.arraySize() && !Implementation::isAttributeArrayAllowed(name)) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "of" << name << "can't be an array";
+            return false;
+        }
+
+        const UnsignedInt attributeVertexCount = attribute.data(vertexData).size();
+        if(attributeVertexCount != expectedAttributeVertexCount) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "has" << attributeVertexCount << "vertices but" << expectedAttributeVertexCount << "expected";
+            return false;
+        }
+
+        /* Size of implementation-specific formats is unknown, check at least
+           the offset in that case */
+        const UnsignedLong typeSize = isImplementationSpecific ? 0 :
+            vertexFormatSize(format)*(attribute.arraySize() ? attribute.arraySize() : 1);
+        if(!isRangeInBounds(mesh.vertexDataSize, attribute.offset(vertexData), vertexCount, attribute.stride(), typeSize)) {
+            Error{} << "Trade::MagnumImporter::mesh(): attribute" << i << "out of range for" << mesh.vertexDataSize << "bytes of vertex data";
+            return false;
+        }
+
+        if(name == MeshAttribute::JointIds) ++jointIdAttributeCount;
+        else if(name == MeshAttribute::Weights) ++weightAttributeCount;
+    }
+
+    /* Joint IDs and weights have to be paired, with matching array sizes */
+    if(weightAttributeCount != jointIdAttributeCount) {
+        Error{} << "Trade::MagnumImporter::mesh(): expected" << jointIdAttributeCount << "weight attributes to match joint IDs but got" << weightAttributeCount;
+        return false;
+    }
+    for(std::size_t i = 0, j = 0, jointIds = 0; jointIds != jointIdAttributeCount; ++i, ++j, ++jointIds) {
+        while(attributes[i].name() != MeshAttribute::JointIds) ++i;
+        while(attributes[j].name() != MeshAttribute::Weights) ++j;
+        if(attributes[i].arraySize() != attributes[j].arraySize()) {
+            Error{} << "Trade::MagnumImporter::mesh(): expected" << attributes[i].arraySize() << "array items for weight attribute" << jointIds << "to match joint IDs but got" << attributes[j].arraySize();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Dimension count of a transformation field type, assuming it was already
+   checked with isSceneFieldTypeCompatibleWithField() */
+UnsignedInt transformationFieldDimensions(const SceneFieldType type) {
+    return type == SceneFieldType::Matrix3x3 ||
+           type == SceneFieldType::Matrix3x3d ||
+           type == SceneFieldType::Matrix3x2 ||
+           type == SceneFieldType::Matrix3x2d ||
+           type == SceneFieldType::DualComplex ||
+           type == SceneFieldType::DualComplexd ||
+           type == SceneFieldType::Vector2 ||
+           type == SceneFieldType::Vector2d ||
+           type == SceneFieldType::Complex ||
+           type == SceneFieldType::Complexd ? 2 : 3;
+}
+
+bool checkScene(const Implementation::BlobScene& scene) {
+    const char* const chunk = reinterpret_cast<const char*>(&scene);
+
+    const SceneMappingType mappingType = SceneMappingType(scene.mappingType);
+    if(!scene.mappingType || scene.mappingType > UnsignedByte(SceneMappingType::UnsignedLong)) {
+        Error{} << "Trade::MagnumImporter::scene(): invalid mapping type" << mappingType;
+        return false;
+    }
+    if((mappingType == SceneMappingType::UnsignedByte && scene.mappingBound > 0xffull) ||
+       (mappingType == SceneMappingType::UnsignedShort && scene.mappingBound > 0xffffull) ||
+       (mappingType == SceneMappingType::UnsignedInt && scene.mappingBound > 0xffffffffull)) {
+        Error{} << "Trade::MagnumImporter::scene():" << mappingType << "is too small for" << scene.mappingBound << "objects";
+        return false;
+    }
+
+    const char* const data = chunk + scene.dataOffset;
+    const Containers::ArrayView<const void> fakeData{data, FakeDataSize};
+    const Containers::ArrayView<const void> fakeBitData{data, FakeBitDataSize};
+    const Containers::ArrayView<const SceneFieldData> fields{reinterpret_cast<const SceneFieldData*>(chunk + scene.fieldDataOffset), scene.fieldCount};
+    const UnsignedInt mappingTypeSize = sceneMappingTypeSize(mappingType);
+    UnsignedInt transformationField = ~UnsignedInt{};
+    UnsignedInt translationField = ~UnsignedInt{};
+    UnsignedInt rotationField = ~UnsignedInt{};
+    UnsignedInt scalingField = ~UnsignedInt{};
+    UnsignedInt meshField = ~UnsignedInt{};
+    UnsignedInt meshMaterialField = ~UnsignedInt{};
+    UnsignedInt skinField = ~UnsignedInt{};
+    for(std::size_t i = 0; i != fields.size(); ++i) {
+        const SceneFieldData& field = fields[i];
+        if(!(field.flags() & SceneFieldFlag::OffsetOnly)) {
+            Error{} << "Trade::MagnumImporter::scene(): field" << i << "is not offset-only";
+            return false;
+        }
+
+        const SceneField name = field.name();
+        if(!isSceneFieldCustom(name) && (!UnsignedInt(name) || UnsignedInt(name) > UnsignedInt(SceneField::ImporterState))) {
+            Error{} << "Trade::MagnumImporter::scene(): invalid field" << i << "name" << name;
+            return false;
+        }
+        for(std::size_t j = 0; j != i; ++j) if(fields[j].name() == name) {
+            Error{} << "Trade::MagnumImporter::scene(): duplicate field" << name;
+            return false;
+        }
+
+        if(field.mappingType() != mappingType) {
+            Error{} << "Trade::MagnumImporter::scene(): inconsistent mapping type, got" << field.mappingType() << "for field" << i << "but expected" << mappingType;
+            return false;
+        }
+
+        const SceneFieldType type = field.fieldType();
+        if(!UnsignedShort(type) || UnsignedShort(type) > UnsignedShort(SceneFieldType::MutablePointer)) {
+            Error{} << "Trade::MagnumImporter::scene(): invalid field" << i << "type" << type;
+            return false;
+        }
+        if(!Implementation::isSceneFieldTypeCompatibleWithField(name, type)) {
+            Error{} << "Trade::MagnumImporter::scene(): field" << i << "type" << type << "is not valid for" << name;
+            return false;
+        }
+        if(field.fieldArraySize() && !Implementation::isSceneFieldArrayAllowed(name)) {
+            Error{} << "Trade::MagnumImporter::scene(): field" << i << "of" << name << "can't be an array";
+            return false;
+        }
+
+        /* Empty fields aren't checked further, same as in the SceneData
+           constructor */
+        if(field.size()) {
+            const Containers::StridedArrayView1D<const void> mappingData = field.mappingData(fakeData);
+            if(!isRangeInBounds(scene.dataSize, static_cast<const char*>(mappingData.data()) - data, field.size(), mappingData.stride(), mappingTypeSize)) {
+                Error{} << "Trade::MagnumImporter::scene(): mapping data of field" << i << "out of range for" << scene.dataSize << "bytes of data";
+                return false;
+            }
+
+            /* Bit fields have the offset, stride and array size in bits */
+            bool fieldInBounds;
+            if(type == SceneFieldType::Bit) {
+                if(field.size() >= UnsignedLong{1} << (sizeof(std::size_t)*8 - 3))
+                    fieldInBounds = false;
+                else {
+                    const Containers::StridedBitArrayView2D fieldData = field.fieldBitData(fakeBitData);
+                    fieldInBounds = isRangeInBounds(scene.dataSize*8, (static_cast<const char*>(fieldData.data()) - data)*8 + fieldData.offset(), field.size(), fieldData.stride()[0], fieldData.size()[1]);
+                }
+            } else {
+                const Containers::StridedArrayView1D<const void> fieldData = field.fieldData(fakeData);
+                fieldInBounds = isRangeInBounds(scene.dataSize, static_cast<const char*>(fieldData.data()) - data, field.size(), fieldData.stride(), sceneFieldTypeSize(type)*(field.fieldArraySize() ? field.fieldArraySize() : 1));
+            }
+            if(!fieldInBounds) {
+                Error{} << "Trade::MagnumImporter::scene(): field data of field" << i << "out of range for" << scene.dataSize << "bytes of data";
+                return false;
+            }
+
+            if(Implementation::isSceneFieldTypeString(type)) {
+                const char* const stringData = field.stringData(fakeData);
+                if(stringData < data || stringData > data + scene.dataSize) {
+                    Error{} << "Trade::MagnumImporter::scene(): string data of field" << i << "out of range for" << scene.dataSize << "bytes of data";
+                    return false;
+                }
+            }
+        }
+
+        if(name == SceneField::Transformation)
+            transformationField = i;
+        else if(name == SceneField::Translation)
+            translationField = i;
+        else if(name == SceneField::Rotation)
+            rotationField = i;
+        else if(name == SceneField::Scaling)
+            scalingField = i;
+        else if(name == SceneField::Mesh)
+            meshField = i;
+        else if(name == SceneField::MeshMaterial)
+            meshMaterialField = i;
+        else if(name == SceneField::Skin)
+            skinField = i;
+    }
+
+    /* TRS fields and mesh / material fields have to share the same object
+       mapping */
+    const auto checkFieldMappingDataMatch = [&](const UnsignedInt a, const UnsignedInt b) -> bool {
+        if(a == ~UnsignedInt{} || b == ~UnsignedInt{} || (fields[a].size() == fields[b].size() && fields[a].mappingData(fakeData).data() == fields[b].mappingData(fakeData).data()))
+            return true;
+        Error{} << "Trade::MagnumImporter::scene():" << fields[b].name() << "mapping data is different from" << fields[a].name() << "mapping data";
+        return false;
+    };
+    if(!checkFieldMappingDataMatch(translationField, rotationField) ||
+       !checkFieldMappingDataMatch(translationField, scalingField) ||
+       !checkFieldMappingDataMatch(rotationField, scalingField) ||
+       !checkFieldMappingDataMatch(meshField, meshMaterialField))
+        return false;
+
+    /* All transformation fields have to agree on the dimension count */
+    UnsignedInt dimensions = transformationField == ~UnsignedInt{} ? 0 :
+        transformationFieldDimensions(fields[transformationField].fieldType());
+    const Containers::Pair<UnsignedInt, const char*> trsFields[]{
+        {translationField, "translation"},
+        {rotationField, "rotation"},
+        {scalingField, "scaling"}
+    };
+    for(const Containers::Pair<UnsignedInt, const char*>& trsField: trsFields) {
+        if(trsField.first() == ~UnsignedInt{}) continue;
+        const SceneFieldType type = fields[trsField.first()].fieldType();
+        const UnsignedInt fieldDimensions = transformationFieldDimensions(type);
+        if(dimensions && dimensions != fieldDimensions) {
+            Error{} << "Trade::MagnumImporter::scene(): expected a" << (dimensions == 2 ? "2D" : "3D") << trsField.second() << "field but got" << type;
+            return false;
+        }
+        dimensions = fieldDimensions;
+    }
+
+    if(skinField != ~UnsignedInt{} && !dimensions) {
+        Error{} << "Trade::MagnumImporter::scene(): a skin field requires some transformation field to be present in order to disambiguate between 2D and 3D";
+        return false;
+    }
+
+    return true;
+}
+
+bool checkMaterial(const Implementation::BlobMaterial& material) {
+    const char* const chunk = reinterpret_cast<const char*>(&material);
+
+    const Containers::ArrayView<const MaterialAttributeData> attributes{reinterpret_cast<const MaterialAttributeData*>(chunk + material.attributeDataOffset), material.attributeCount};
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const MaterialAttributeType type = attributes[i].type();
+        if(!UnsignedByte(type) || UnsignedByte(type) > UnsignedByte(MaterialAttributeType::TextureSwizzle)) {
+            Error{} << "Trade::MagnumImporter::material(): invalid attribute" << i << "type" << type;
+            return false;
+        }
+
+        /* The name has to be non-empty and null-terminated before the value
+           starts. See the MaterialAttributeData::Storage documentation for
+           details about the layout. */
+        constexpr std::size_t Size = Implementation::MaterialAttributeDataSize;
+        const char* const attributeData = reinterpret_cast<const char*>(&attributes[i]);
+        std::size_t nameEndLimit;
+        if(type == MaterialAttributeType::String) {
+            /* A null byte after the name, after the value, a type and a size */
+            const std::size_t size = UnsignedByte(attributeData[Size - 1]);
+            nameEndLimit = size + 4 <= Size && attributeData[Size - 2] == '\0' ? Size - size - 2 : 0;
+        } else if(type == MaterialAttributeType::Buffer) {
+            /* The size is right after the null-terminated name */
+            nameEndLimit = Size - 1;
+        } else nameEndLimit = Size - materialAttributeTypeSize(type);
+        const char* const nameEnd = nameEndLimit > 2 ? static_cast<const char*>(std::memchr(attributeData + 1, '\0', nameEndLimit - 1)) : nullptr;
+        if(!nameEnd || nameEnd == attributeData + 1 || (type == MaterialAttributeType::Buffer && UnsignedByte(nameEnd[1]) > std::size_t(attributeData + Size - nameEnd - 2))) {
+            Error{} << "Trade::MagnumImporter::material(): invalid attribute" << i << "name or value size";
+            return false;
+        }
+    }
+
+    /* Same checks as in the non-owning MaterialData constructor, which
+       asserts on these */
+    const UnsignedInt implicitLayerData[]{material.attributeCount};
+    const Containers::ArrayView<const UnsignedInt> layerOffsets = material.layerCount ?
+        Containers::arrayView(reinterpret_cast<const UnsignedInt*>(chunk + material.layerDataOffset), material.layerCount) :
+        Containers::arrayView(implicitLayerData);
+    UnsignedInt begin = 0;
+    for(std::size_t i = 0; i != layerOffsets.size(); ++i) {
+        const UnsignedInt end = layerOffsets[i];
+        if(begin > end || end > attributes.size()) {
+            Error{} << "Trade::MagnumImporter::material(): invalid range (" << Debug::nospace << begin << Debug::nospace << "," << end << Debug::nospace << ") for layer" << i << "with" << attributes.size() << "attributes in total";
+            return false;
+        }
+
+        for(std::size_t j = begin + 1; j < end; ++j) {
+            if(attributes[j - 1].name() == attributes[j].name()) {
+                Error{} << "Trade::MagnumImporter::material(): duplicate attribute" << attributes[j].name() << "in layer" << i;
+                return false;
+            }
+            if(!(attributes[j - 1].name() < attributes[j].name())) {
+                Error{} << "Trade::MagnumImporter::material():" << attributes[j].name() << "has to be sorted before" << attributes[j - 1].name() << "in layer" << i;
+                return false;
+            }
+        }
+
+        begin = end;
+    }
+
+    if(layerOffsets.back() != attributes.size()) {
+        Error{} << "Trade::MagnumImporter::material(): last layer offset" << layerOffsets.back() << "too short for" << attributes.size() << "attributes in total";
+        return false;
+    }
+
+    return true;
+}
+
+/* Used for calculating image data size from values coming from the file. A
+   saturated result is always larger than the actual data size, failing the
+   check. */
+UnsignedLong saturatingAdd(const UnsignedLong a, const UnsignedLong b) {
+    return a > ~UnsignedLong{} - b ? ~UnsignedLong{} : a + b;
+}
+
+UnsignedLong saturatingMultiply(const UnsignedLong a, const UnsignedLong b) {
+    return b && a > ~UnsignedLong{}/b ? ~UnsignedLong{} : a*b;
+}
+
+constexpr const char* ImageFunctionPrefix[]{
+    nullptr,
+    "Trade::MagnumImporter::image1D():",
+    "Trade::MagnumImporter::image2D():",
+    "Trade::MagnumImporter::image3D():"
+};
+
+template<UnsignedInt dimensions> bool checkImage(const Implementation::BlobImage& image) {
+    const char* const prefix = ImageFunctionPrefix[dimensions];
+
+    const VectorTypeFor<dimensions, Int> imageSize = VectorTypeFor<dimensions, Int>::pad(Vector3i::from(image.size));
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        if(imageSize[i] < 0) {
+            Error{} << prefix << "invalid size" << Debug::packed << imageSize;
+            return false;
+        }
+    }
+    const Vector3i size = Vector3i::pad(imageSize, 1);
+
+    const Vector3i skip = Vector3i::from(image.skip);
+    if(image.rowLength < 0 || image.imageHeight < 0 || skip.x() < 0 || skip.y() < 0 || skip.z() < 0) {
+        Error{} << prefix << "invalid row length" << image.rowLength << Debug::nospace << ", image height" << image.imageHeight << "or skip" << Debug::packed << skip;
+        return false;
+    }
+
+    /* Same checks as in the ImageData constructor, which asserts on these */
+    const UnsignedShort validFlags =
+        dimensions == 3 ? UnsignedShort(ImageFlag3D::Array|ImageFlag3D::CubeMap) :
+        dimensions == 2 ? UnsignedShort(ImageFlag2D::Array) : 0;
+    if(image.flags & ~validFlags) {
+        Error{} << prefix << "invalid flags" << ImageFlag<dimensions>(image.flags);
+        return false;
+    }
+    if(image.flags & UnsignedShort(ImageFlag3D::CubeMap)) {
+        if(size.x() != size.y()) {
+            Error{} << prefix << "expected square faces for a cube map, got" << Debug::packed << size.xy();
+            return false;
+        }
+        if(!(image.flags & UnsignedShort(ImageFlag3D::Array)) && size.z() != 6) {
+            Error{} << prefix << "expected exactly 6 faces for a cube map, got" << size.z();
+            return false;
+        }
+        if(size.z() % 6) {
+            Error{} << prefix << "expected a multiple of 6 faces for a cube map array, got" << size.z();
+            return false;
+        }
+    }
+
+    const bool isEmpty = !size.x() || !size.y() || !size.z();
+    UnsignedLong dataSize;
+    if(!image.compressed) {
+        if(image.alignment != 1 && image.alignment != 2 && image.alignment != 4 && image.alignment != 8) {
+            Error{} << prefix << "invalid alignment" << image.alignment;
+            return false;
+        }
+        if(!image.pixelSize || image.pixelSize >= 256) {
+            Error{} << prefix << "invalid pixel size" << image.pixelSize;
+            return false;
+        }
+
+        /* Same calculation as in PixelStorage::dataProperties() and
+           Magnum::Implementation::imageDataSize(), which is used in the
+           ImageData constructor assertion. The row size can't overflow as
+           it's at most a 31-bit value times an 8-bit value. */
+        const UnsignedLong rowSize = (UnsignedLong(image.rowLength ? image.rowLength : size.x())*image.pixelSize + image.alignment - 1)/image.alignment*image.alignment;
+        const UnsignedLong height = image.imageHeight ? image.imageHeight : size.y();
+        const UnsignedLong skipOffsetX = UnsignedLong(skip.x())*image.pixelSize;
+        const UnsignedLong skipOffsetY = saturatingMultiply(skip.y(), rowSize);
+        const UnsignedLong skipOffsetZ = saturatingMultiply(saturatingMultiply(skip.z(), rowSize), height);
+        if(skipOffsetZ)
+            dataSize = skipOffsetZ;
+        else if(skipOffsetY)
+            dataSize = image.imageHeight ? 0 : skipOffsetY;
+        else if(skipOffsetX)
+            dataSize = image.rowLength ? 0 : skipOffsetX;
+        else dataSize = 0;
+        if(!isEmpty)
+            dataSize = saturatingAdd(dataSize, saturatingMultiply(saturatingMultiply(rowSize, height), size.z()));
+
+    } else {
+        /* Block properties can be left unspecified, in which case the ones
+           from the format are meant to be used. The data size can't be
+           calculated for those, but the ImageData constructor doesn't check
+           it for compressed images either. */
+        const Vector3i blockSize = Vector3i::from(image.compressedBlockSize);
+        if(!image.compressedBlockDataSize && blockSize == Vector3i{})
+            return true;
+        if(image.compressedBlockDataSize <= 0 || blockSize.x() <= 0 || blockSize.y() <= 0 || blockSize.z() <= 0) {
+            Error{} << prefix << "invalid compressed block size" << Debug::packed << blockSize << "and data size" << image.compressedBlockDataSize;
+            return false;
+        }
+
+        /* Same calculation as in CompressedPixelStorage::dataProperties() and
+           Magnum::Implementation::compressedImageDataSizeFor(), with the
+           block count rearranged to not underflow */
+        const auto blockCount = [](const Int size, const Int blockSize) {
+            return (UnsignedLong(size) + blockSize - 1)/blockSize;
+        };
+        const UnsignedLong rowBlockCount = blockCount(image.rowLength ? image.rowLength : size.x(), blockSize.x());
+        const UnsignedLong heightBlockCount = blockCount(image.imageHeight ? image.imageHeight : size.y(), blockSize.y());
+        const UnsignedLong sliceBlockCount = saturatingMultiply(rowBlockCount, heightBlockCount);
+        UnsignedLong blocks = saturatingAdd(blockCount(skip.x(), blockSize.x()),
+            saturatingAdd(saturatingMultiply(blockCount(skip.y(), blockSize.y()), rowBlockCount),
+                saturatingMultiply(blockCount(skip.z(), blockSize.z()), sliceBlockCount)));
+        if(!isEmpty)
+            blocks = saturatingAdd(blocks,
+                saturatingAdd(saturatingMultiply(sliceBlockCount, blockCount(size.z(), blockSize.z()) - 1),
+                    saturatingAdd(saturatingMultiply(rowBlockCount, blockCount(size.y(), blockSize.y()) - 1),
+                        blockCount(size.x(), blockSize.x()))));
+        dataSize = saturatingMultiply(blocks, image.compressedBlockDataSize);
+    }
+
+    if(dataSize > image.dataSize) {
+        Error{} << prefix << "data too small, got" << image.dataSize << "but expected at least" << dataSize << "bytes";
+        return false;
+    }
+
+    return true;
+}
+
+template<UnsignedInt dimensions> ImageData<dimensions> blobImage(const Implementation::BlobImage& image, const DataFlags dataFlags) {
+    const Containers::ArrayView<const char> data{reinterpret_cast<const char*>(&image) + image.dataOffset, std::size_t(image.dataSize)};
+    const VectorTypeFor<dimensions, Int> size = VectorTypeFor<dimensions, Int>::pad(Vector3i::from(image.size));
+    const ImageFlags<dimensions> flags = ImageFlag<dimensions>(image.flags);
+
+    if(image.compressed) {
+        CompressedPixelStorage storage;
+        storage.setRowLength(image.rowLength)
+            .setImageHeight(image.imageHeight)
+            .setSkip(Vector3i::from(image.skip))
+            .setCompressedBlockSize(Vector3i::from(image.compressedBlockSize))
+            .setCompressedBlockDataSize(image.compressedBlockDataSize);
+        return ImageData<dimensions>{storage, CompressedPixelFormat(image.format), size, dataFlags, data, flags};
+    }
+
+    PixelStorage storage;
+    storage.setAlignment(image.alignment)
+        .setRowLength(image.rowLength)
+        .setImageHeight(image.imageHeight)
+        .setSkip(Vector3i::from(image.skip));
+    return ImageData<dimensions>{storage, PixelFormat(image.format), image.formatExtra, image.pixelSize, size, dataFlags, data, flags};
+}
+
+}
+
+MagnumImporter::MagnumImporter() = default;
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const { return ImporterFeature::OpenData; }
+
+void MagnumImporter::doClose() { _file = nullptr; }
+
+bool MagnumImporter::doIsOpened() const { return !!_file; }
+
+void MagnumImporter::doOpenFile(const Containers::StringView filename) {
+    /* Memory-map the file if possible, the data are then referenced directly
+       from the mapped memory. This function gets called only if file
+       callbacks are not set, those go through doOpenData(). */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+    if(!mapped) {
+        Error{} << "Trade::MagnumImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    Containers::Pointer<File> file{InPlaceInit};
+    /* Fake a mutable array with a non-owning deleter to have the same type as
+       in doOpenData(). The actual memory is owned by the `mapped` array. */
+    file->in = Containers::Array<char>{const_cast<char*>(mapped->data()), mapped->size(), [](char*, std::size_t) {}};
+    file->mapped = std::move(mapped);
+    openInternal(std::move(file));
+    #else
+    AbstractImporter::doOpenFile(filename);
+    #endif
+}
+
+void MagnumImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
+    Containers::Pointer<File> file{InPlaceInit};
+
+    /* Take over the existing array or reference the externally owned memory
+       directly. The stored structures are used in-place, so if the memory
+       isn't sufficiently aligned, or if we can't take it over, copy it. A
+       new[]'d array is always aligned enough. */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned) && reinterpret_cast<std::uintptr_t>(data.data()) % Implementation::BlobAlignment == 0) {
+        file->in = std::move(data);
+        if(dataFlags & DataFlag::ExternallyOwned)
+            file->dataFlags = DataFlag::ExternallyOwned;
+    } else {
+        file->in = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, file->in);
+    }
+
+    openInternal(std::move(file));
+}
+
+void MagnumImporter::openInternal(Containers::Pointer<File>&& file) {
+    const Containers::ArrayView<const char> in = file->in;
+    if(in.size() < sizeof(Implementation::BlobHeader)) {
+        Error{} << "Trade::MagnumImporter::openData(): expected at least" << sizeof(Implementation::BlobHeader) << "bytes for a header but got" << in.size();
+        return;
+    }
+
+    const Implementation::BlobHeader& header = *reinterpret_cast<const Implementation::BlobHeader*>(in.data());
+    if(std::memcmp(header.signature, "MGBL", 4) != 0) {
+        Error{} << "Trade::MagnumImporter::openData(): invalid signature";
+        return;
+    }
+    if(header.version != Implementation::BlobVersion) {
+        Error{} << "Trade::MagnumImporter::openData(): unsupported version" << header.version;
+        return;
+    }
+    if(bool(header.bigEndian) != Utility::Endianness::isBigEndian()) {
+        Error{} << "Trade::MagnumImporter::openData(): file produced on a" << (header.bigEndian ? "big-endian" : "little-endian") << "platform";
+        return;
+    }
+    if(header.pointerSize != sizeof(void*)) {
+        Error{} << "Trade::MagnumImporter::openData(): file produced on a" << header.pointerSize*8 << Debug::nospace << "-bit platform";
+        return;
+    }
+    if(header.meshAttributeDataSize != sizeof(MeshAttributeData) ||
+       header.sceneFieldDataSize != sizeof(SceneFieldData) ||
+       header.materialAttributeDataSize != sizeof(MaterialAttributeData) ||
+       header.layoutHash != Implementation::blobLayoutHash()) {
+        Error{} << "Trade::MagnumImporter::openData(): file produced with an incompatible version of Magnum";
+        return;
+    }
+    if(header.size != in.size()) {
+        Error{} << "Trade::MagnumImporter::openData(): expected" << header.size << "bytes but got" << in.size();
+        return;
+    }
+
+    std::size_t offset = sizeof(Implementation::BlobHeader);
+    for(UnsignedInt i = 0; i != header.chunkCount; ++i) {
+        if(in.size() - offset < sizeof(Implementation::BlobChunk)) {
+            Error{} << "Trade::MagnumImporter::openData(): expected" << header.chunkCount << "chunks but got only" << i;
+            return;
+        }
+
+        const Implementation::BlobChunk& chunkHeaderCommon = *reinterpret_cast<const Implementation::BlobChunk*>(in.data() + offset);
+        if(chunkHeaderCommon.size < sizeof(Implementation::BlobChunk) || chunkHeaderCommon.size % Implementation::BlobAlignment || chunkHeaderCommon.size > in.size() - offset) {
+            Error{} << "Trade::MagnumImporter::openData(): invalid chunk" << i << "size" << chunkHeaderCommon.size;
+            return;
+        }
+
+        const Containers::ArrayView<const char> chunk = in.sliceSize(offset, chunkHeaderCommon.size);
+        switch(Implementation::BlobChunkType(chunkHeaderCommon.type)) {
+            case Implementation::BlobChunkType::Scene: {
+                const Implementation::BlobScene* const scene = chunkHeader<Implementation::BlobScene>(chunk, i);
+                if(!scene ||
+                   !checkChunkRange(chunk, i, scene->dataOffset, scene->dataSize) ||
+                   !checkChunkRange(chunk, i, scene->fieldDataOffset, UnsignedLong(scene->fieldCount)*sizeof(SceneFieldData)))
+                    return;
+                arrayAppend(file->scenes, scene);
+                file->objectCount = Math::max(file->objectCount, scene->mappingBound);
+            } break;
+
+            case Implementation::BlobChunkType::Mesh: {
+                const Implementation::BlobMesh* const mesh = chunkHeader<Implementation::BlobMesh>(chunk, i);
+                if(!mesh ||
+                   !checkChunkRange(chunk, i, mesh->indexDataOffset, mesh->indexDataSize) ||
+                   !checkChunkRange(chunk, i, mesh->vertexDataOffset, mesh->vertexDataSize) ||
+                   !checkChunkRange(chunk, i, mesh->attributeDataOffset, UnsignedLong(mesh->attributeCount)*sizeof(MeshAttributeData)))
+                    return;
+                arrayAppend(file->meshes, mesh);
+            } break;
+
+            case Implementation::BlobChunkType::Material: {
+                const Implementation::BlobMaterial* const material = chunkHeader<Implementation::BlobMaterial>(chunk, i);
+                if(!material ||
+                   !checkChunkRange(chunk, i, material->attributeDataOffset, UnsignedLong(material->attributeCount)*sizeof(MaterialAttributeData)) ||
+                   !checkChunkRange(chunk, i, material->layerDataOffset, UnsignedLong(material->layerCount)*sizeof(UnsignedInt)))
+                    return;
+                arrayAppend(file->materials, material);
+            } break;
+
+            case Implementation::BlobChunkType::Image1D:
+            case Implementation::BlobChunkType::Image2D:
+            case Implementation::BlobChunkType::Image3D: {
+                const Implementation::BlobImage* const image = chunkHeader<Implementation::BlobImage>(chunk, i);
+                if(!image || !checkChunkRange(chunk, i, image->dataOffset, image->dataSize))
+                    return;
+                if(Implementation::BlobChunkType(chunkHeaderCommon.type) == Implementation::BlobChunkType::Image1D)
+                    arrayAppend(file->images1D, image);
+                else if(Implementation::BlobChunkType(chunkHeaderCommon.type) == Implementation::BlobChunkType::Image2D)
+                    arrayAppend(file->images2D, image);
+                else
+                    arrayAppend(file->images3D, image);
+            } break;
+
+            case Implementation::BlobChunkType::ObjectName: {
+                const Implementation::BlobObjectName* const name = chunkHeader<Implementation::BlobObjectName>(chunk, i);
+                if(!name) return;
+                file->objectNames[name->object] = chunkName(*name);
+                file->objectCount = Math::max(file->objectCount, name->object + 1);
+            } break;
+
+            case Implementation::BlobChunkType::SceneFieldName:
+            case Implementation::BlobChunkType::MeshAttributeName: {
+                const Implementation::BlobCustomName* const name = chunkHeader<Implementation::BlobCustomName>(chunk, i);
+                if(!name) return;
+                (Implementation::BlobChunkType(chunkHeaderCommon.type) == Implementation::BlobChunkType::SceneFieldName ? file->sceneFieldNames : file->meshAttributeNames)[name->id] = chunkName(*name);
+            } break;
+
+            /* Unknown chunks are skipped. New chunk types can be thus added
+               without breaking existing files. */
+        }
+
+        offset += chunk.size();
+    }
+
+    if(header.defaultScene != -1 && (header.defaultScene < 0 || UnsignedInt(header.defaultScene) >= file->scenes.size())) {
+        Error{} << "Trade::MagnumImporter::openData(): default scene" << header.defaultScene << "out of range for" << file->scenes.size() << "scenes";
+        return;
+    }
+    file->defaultScene = header.defaultScene;
+
+    _file = std::move(file);
+}
+
+Int MagnumImporter::doDefaultScene() const { return _file->defaultScene; }
+
+UnsignedInt MagnumImporter::doSceneCount() const { return _file->scenes.size(); }
+
+UnsignedLong MagnumImporter::doObjectCount() const { return _file->objectCount; }
+
+Int MagnumImporter::doSceneForName(const Containers::StringView name) {
+    return chunkForName(_file->scenes, name);
+}
+
+Long MagnumImporter::doObjectForName(const Containers::StringView name) {
+    for(const auto& objectName: _file->objectNames)
+        if(objectName.second == name) return objectName.first;
+    return -1;
+}
+
+Containers::String MagnumImporter::doSceneName(const UnsignedInt id) {
+    return chunkName(*_file->scenes[id]);
+}
+
+Containers::String MagnumImporter::doObjectName(const UnsignedLong id) {
+    const auto found = _file->objectNames.find(id);
+    return found == _file->objectNames.end() ? Containers::String{} : Containers::String{found->second};
+}
+
+Containers::Optional<SceneData> MagnumImporter::doScene(const UnsignedInt id) {
+    const Implementation::BlobScene& scene = *_file->scenes[id];
+    if(!checkScene(scene)) return {};
+
+    const char* const chunk = reinterpret_cast<const char*>(&scene);
+    return SceneData{SceneMappingType(scene.mappingType), scene.mappingBound,
+        _file->dataFlags, Containers::arrayView(chunk + scene.dataOffset, std::size_t(scene.dataSize)),
+        sceneFieldDataNonOwningArray(Containers::arrayView(reinterpret_cast<const SceneFieldData*>(chunk + scene.fieldDataOffset), scene.fieldCount))};
+}
+
+SceneField MagnumImporter::doSceneFieldForName(const Containers::StringView name) {
+    for(const auto& fieldName: _file->sceneFieldNames)
+        if(fieldName.second == name) return sceneFieldCustom(fieldName.first);
+    return {};
+}
+
+Containers::String MagnumImporter::doSceneFieldName(const UnsignedInt name) {
+    const auto found = _file->sceneFieldNames.find(name);
+    return found == _file->sceneFieldNames.end() ? Containers::String{} : Containers::String{found->second};
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return _file->meshes.size(); }
+
+Int MagnumImporter::doMeshForName(const Containers::StringView name) {
+    return chunkForName(_file->meshes, name);
+}
+
+Containers::String MagnumImporter::doMeshName(const UnsignedInt id) {
+    return chunkName(*_file->meshes[id]);
+}
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    const Implementation::BlobMesh& mesh = *_file->meshes[id];
+    if(!checkMesh(mesh)) return {};
+
+    const char* const chunk = reinterpret_cast<const char*>(&mesh);
+
+    const Containers::ArrayView<const char> indexData{chunk + mesh.indexDataOffset, std::size_t(mesh.indexDataSize)};
+    MeshIndexData indices;
+    if(mesh.indexType)
+        indices = MeshIndexData{MeshIndexType(mesh.indexType), Containers::StridedArrayView1D<const void>{indexData, indexData.data() + mesh.indexOffset, mesh.indexCount, mesh.indexStride}};
+
+    return MeshData{MeshPrimitive(mesh.primitive),
+        _file->dataFlags, indexData, indices,
+        _file->dataFlags, Containers::arrayView(chunk + mesh.vertexDataOffset, std::size_t(mesh.vertexDataSize)),
+        meshAttributeDataNonOwningArray(Containers::arrayView(reinterpret_cast<const MeshAttributeData*>(chunk + mesh.attributeDataOffset), mesh.attributeCount)),
+        mesh.vertexCount};
+}
+
+MeshAttribute MagnumImporter::doMeshAttributeForName(const Containers::StringView name) {
+    for(const auto& attributeName: _file->meshAttributeNames)
+        if(attributeName.second == name) return meshAttributeCustom(attributeName.first);
+    return {};
+}
+
+Containers::String MagnumImporter::doMeshAttributeName(const UnsignedShort name) {
+    const auto found = _file->meshAttributeNames.find(name);
+    return found == _file->meshAttributeNames.end() ? Containers::String{} : Containers::String{found->second};
+}
+
+UnsignedInt MagnumImporter::doMaterialCount() const { return _file->materials.size(); }
+
+Int MagnumImporter::doMaterialForName(const Containers::StringView name) {
+    return chunkForName(_file->materials, name);
+}
+
+Containers::String MagnumImporter::doMaterialName(const UnsignedInt id) {
+    return chunkName(*_file->materials[id]);
+}
+
+Containers::Optional<MaterialData> MagnumImporter::doMaterial(const UnsignedInt id) {
+    const Implementation::BlobMaterial& material = *_file->materials[id];
+    if(!checkMaterial(material)) return {};
+
+    const char* const chunk = reinterpret_cast<const char*>(&material);
+    return MaterialData{MaterialType(material.types),
+        _file->dataFlags, Containers::arrayView(reinterpret_cast<const MaterialAttributeData*>(chunk + material.attributeDataOffset), material.attributeCount),
+        _file->dataFlags, Containers::arrayView(reinterpret_cast<const UnsignedInt*>(chunk + material.layerDataOffset), material.layerCount)};
+}
+
+UnsignedInt MagnumImporter::doImage1DCount() const { return _file->images1D.size(); }
+
+Int MagnumImporter::doImage1DForName(const Containers::StringView name) {
+    return chunkForName(_file->images1D, name);
+}
+
+Containers::String MagnumImporter::doImage1DName(const UnsignedInt id) {
+    return chunkName(*_file->images1D[id]);
+}
+
+Containers::Optional<ImageData1D> MagnumImporter::doImage1D(const UnsignedInt id, UnsignedInt) {
+    const Implementation::BlobImage& image = *_file->images1D[id];
+    if(!checkImage<1>(image)) return {};
+
+    return blobImage<1>(image, _file->dataFlags);
+}
+
+UnsignedInt MagnumImporter::doImage2DCount() const { return _file->images2D.size(); }
+
+Int MagnumImporter::doImage2DForName(const Containers::StringView name) {
+    return chunkForName(_file->images2D, name);
+}
+
+Containers::String MagnumImporter::doImage2DName(const UnsignedInt id) {
+    return chunkName(*_file->images2D[id]);
+}
+
+Containers::Optional<ImageData2D> MagnumImporter::doImage2D(const UnsignedInt id, UnsignedInt) {
+    const Implementation::BlobImage& image = *_file->images2D[id];
+    if(!checkImage<2>(image)) return {};
+
+    return blobImage<2>(image, _file->dataFlags);
+}
+
+UnsignedInt MagnumImporter::doImage3DCount() const { return _file->images3D.size(); }
+
+Int MagnumImporter::doImage3DForName(const Containers::StringView name) {
+    return chunkForName(_file->images3D, name);
+}
+
+Containers::String MagnumImporter::doImage3DName(const UnsignedInt id) {
+    return chunkName(*_file->images3D[id]);
+}
+
+Containers::Optional<ImageData3D> MagnumImporter::doImage3D(const UnsignedInt id, UnsignedInt) {
+    const Implementation::BlobImage& image = *_file->images3D[id];
+    if(!checkImage<3>(image)) return {};
+
+    return blobImage<3>(image, _file->dataFlags);
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.5")
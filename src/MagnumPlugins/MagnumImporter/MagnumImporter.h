@@ -0,0 +1,195 @@
+#ifndef Magnum_Trade_MagnumImporter_h
+#define Magnum_Trade_MagnumImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "MagnumPlugins/MagnumImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMPORTER_BUILD_STATIC
+    #ifdef MagnumImporter_EXPORTS
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMPORTER_EXPORT
+#define MAGNUM_MAGNUMIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Loads Magnum blobs (`*.blob`) produced by @ref MagnumSceneConverter, directly
+referencing the scene, mesh, material and image data in the file without any
+parsing or copying.
+
+@section Trade-MagnumImporter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_MAGNUMIMPORTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MagnumImporter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumImporter` component of the `Magnum` package and
+link to the `Magnum::MagnumImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumImporter-behavior Behavior and limitations
+
+Opening a file only validates the file header and chunk boundaries, which is
+proportional to the number of items in the file and not to the data size.
+Scenes, meshes, materials and images are then returned as non-owning views
+pointing directly into the file memory, with the @ref SceneFieldData,
+@ref MeshAttributeData and @ref MaterialAttributeData arrays referenced
+in-place as well. Mesh and scene data are exactly in the layout they were
+passed to @ref MagnumSceneConverter.
+
+If the file is opened with @ref openMemory(), the returned instances have
+@ref DataFlag::ExternallyOwned set, meaning they can outlive the importer
+instance as long as the memory itself stays in scope. Combined with
+@ref Corrade::Utility::Path::mapRead() (which is what the
+@ref magnum-sceneconverter "magnum-sceneconverter" @cb{.sh} --map @ce option
+does) this makes it possible to load a file with neither parsing nor copying.
+Data passed to @ref openData() are taken over if they're
+@ref DataFlag::Owned and copied otherwise, files opened through
+@ref openFile() are memory-mapped on platforms that support it, unless a
+@ref setFileCallback() "file callback" is set. In those cases the memory is
+owned by the importer and the returned instances have empty @ref DataFlags,
+i.e. they're valid only until the file is closed. If the passed memory isn't
+aligned to 8 bytes, it's copied as well.
+
+The file is tied to the pointer size, endianness and Magnum version it was
+produced with, opening a file produced on an incompatible platform or with an
+incompatible version fails with an error. Apart from the bounds of individual
+chunks, the contents of the stored structures are not validated and a
+corrupted file may trigger assertions in the @ref SceneData, @ref MeshData,
+@ref MaterialData or @ref ImageData constructors. Files from untrusted sources
+should not be opened with this plugin.
+
+Mesh and image levels, animations, lights, cameras, skins and textures are not
+supported by the format. Importer state is not provided.
+*/
+class MAGNUM_MAGNUMIMPORTER_EXPORT MagnumImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImporter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumImporter();
+
+    private:
+        struct File;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenData(Containers::Array<char>&& data, DataFlags dataFlags) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doOpenFile(Containers::StringView filename) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doDefaultScene() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doSceneCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedLong doObjectCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doSceneForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Long doObjectForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doSceneName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doObjectName(UnsignedLong id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<SceneData> doScene(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL SceneField doSceneFieldForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doSceneFieldName(UnsignedInt name) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doMeshForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doMeshName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL MeshAttribute doMeshAttributeForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doMeshAttributeName(UnsignedShort name) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doMaterialCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doMaterialForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doMaterialName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage1DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage1DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage1DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData1D> doImage1D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage2DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage2DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Int doImage3DForName(Containers::StringView name) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::String doImage3DName(UnsignedInt id) override;
+        MAGNUM_MAGNUMIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
+
+        MAGNUM_MAGNUMIMPORTER_LOCAL void openInternal(Containers::Pointer<File>&& file);
+
+        Containers::Pointer<File> _file;
+};
+
+}}
+
+#endif
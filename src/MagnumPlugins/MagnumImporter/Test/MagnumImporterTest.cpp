@@ -0,0 +1,803 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Path.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void invalid();
+
+    void empty();
+    void image();
+    void imageInvalid();
+    void unknownChunk();
+
+    void mesh();
+    void meshInvalid();
+    void scene();
+    void sceneInvalid();
+    void material();
+    void materialInvalid();
+
+    void openMemory();
+    void openMemoryUnaligned();
+    void openFile();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+Implementation::BlobHeader& header(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<Implementation::BlobHeader*>(data.data());
+}
+
+Implementation::BlobImage& imageChunk(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<Implementation::BlobImage*>(data.data() + sizeof(Implementation::BlobHeader));
+}
+
+Implementation::BlobMesh& meshChunk(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<Implementation::BlobMesh*>(data.data() + sizeof(Implementation::BlobHeader));
+}
+
+MeshAttributeData& meshAttribute(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<MeshAttributeData*>(data.data() + sizeof(Implementation::BlobHeader) + 144);
+}
+
+Implementation::BlobScene& sceneChunk(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<Implementation::BlobScene*>(data.data() + sizeof(Implementation::BlobHeader));
+}
+
+SceneFieldData& sceneField(Containers::ArrayView<char> data, UnsignedInt id) {
+    return reinterpret_cast<SceneFieldData*>(data.data() + sizeof(Implementation::BlobHeader) + 128)[id];
+}
+
+Implementation::BlobMaterial& materialChunk(Containers::ArrayView<char> data) {
+    return *reinterpret_cast<Implementation::BlobMaterial*>(data.data() + sizeof(Implementation::BlobHeader));
+}
+
+MaterialAttributeData& materialAttribute(Containers::ArrayView<char> data, UnsignedInt id) {
+    return reinterpret_cast<MaterialAttributeData*>(data.data() + sizeof(Implementation::BlobHeader) + 56)[id];
+}
+
+UnsignedInt& materialLayerOffset(Containers::ArrayView<char> data, UnsignedInt id) {
+    return reinterpret_cast<UnsignedInt*>(data.data() + sizeof(Implementation::BlobHeader) + 248)[id];
+}
+
+/* Fills a header for a file with a single chunk */
+void fillHeader(Containers::ArrayView<char> data) {
+    Implementation::BlobHeader& h = header(data);
+    h.signature[0] = 'M';
+    h.signature[1] = 'G';
+    h.signature[2] = 'B';
+    h.signature[3] = 'L';
+    h.version = Implementation::BlobVersion;
+    h.pointerSize = sizeof(void*);
+    h.bigEndian = Utility::Endianness::isBigEndian();
+    h.meshAttributeDataSize = sizeof(MeshAttributeData);
+    h.sceneFieldDataSize = sizeof(SceneFieldData);
+    h.materialAttributeDataSize = sizeof(MaterialAttributeData);
+    h.layoutHash = Implementation::blobLayoutHash();
+    h.defaultScene = -1;
+    h.chunkCount = 1;
+    h.size = data.size();
+}
+
+/* A 32-byte header followed by a 120-byte chunk containing a 104-byte image
+   header, a null-terminated name padded to 8 bytes and four bytes of data
+   padded to 8 bytes */
+Containers::Array<char> imageFile() {
+    Containers::Array<char> data{ValueInit, 152};
+    fillHeader(data);
+
+    Implementation::BlobImage& image = imageChunk(data);
+    image.chunk.type = UnsignedInt(Implementation::BlobChunkType::Image2D);
+    image.chunk.nameSize = 3;
+    image.chunk.size = 120;
+    image.format = UnsignedInt(PixelFormat::RGBA8Unorm);
+    image.pixelSize = 4;
+    image.size[0] = 1;
+    image.size[1] = 1;
+    image.alignment = 4;
+    image.dataOffset = 112;
+    image.dataSize = 4;
+    Utility::copy(Containers::arrayView({'y', 'e', 's'}), data.sliceSize(32 + 104, 3));
+    Utility::copy(Containers::arrayView({'\xff', '\x33', '\x66', '\x99'}), data.sliceSize(32 + 112, 4));
+
+    return data;
+}
+
+/* A 32-byte header followed by a chunk containing an 88-byte mesh header, a
+   null-terminated name padded to 8 bytes, three Vector3 positions padded to 8
+   bytes, three UnsignedShort indices padded to 8 bytes and a single attribute
+   padded to 8 bytes */
+Containers::Array<char> meshFile() {
+    constexpr std::size_t chunkSize = 144 + (sizeof(MeshAttributeData) + 7)/8*8;
+    Containers::Array<char> data{ValueInit, 32 + chunkSize};
+    fillHeader(data);
+
+    Implementation::BlobMesh& mesh = meshChunk(data);
+    mesh.chunk.type = UnsignedInt(Implementation::BlobChunkType::Mesh);
+    mesh.chunk.nameSize = 3;
+    mesh.chunk.size = chunkSize;
+    mesh.primitive = UnsignedInt(MeshPrimitive::Triangles);
+    mesh.indexType = UnsignedInt(MeshIndexType::UnsignedShort);
+    mesh.indexCount = 3;
+    mesh.indexStride = 2;
+    mesh.indexDataOffset = 136;
+    mesh.indexDataSize = 8;
+    mesh.vertexCount = 3;
+    mesh.attributeCount = 1;
+    mesh.vertexDataOffset = 96;
+    mesh.vertexDataSize = 40;
+    mesh.attributeDataOffset = 144;
+    Utility::copy(Containers::arrayView({'y', 'e', 's'}), data.sliceSize(32 + 88, 3));
+    Utility::copy(Containers::arrayView({
+        Vector3{1.0f, 2.0f, 3.0f},
+        Vector3{4.0f, 5.0f, 6.0f},
+        Vector3{7.0f, 8.0f, 9.0f}
+    }), Containers::arrayCast<Vector3>(data.sliceSize(32 + 96, 36)));
+    Utility::copy(Containers::arrayView<UnsignedShort>({0, 2, 1}), Containers::arrayCast<UnsignedShort>(data.sliceSize(32 + 136, 6)));
+    meshAttribute(data) = MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 0, 3, 12};
+
+    return data;
+}
+
+/* A 32-byte header followed by a chunk containing a 56-byte scene header, a
+   null-terminated name padded to 8 bytes, 64 bytes of data with object
+   mapping, translations and rotations of two objects, and two fields padded
+   to 8 bytes */
+Containers::Array<char> sceneFile() {
+    constexpr std::size_t chunkSize = 128 + (2*sizeof(SceneFieldData) + 7)/8*8;
+    Containers::Array<char> data{ValueInit, 32 + chunkSize};
+    fillHeader(data);
+
+    Implementation::BlobScene& scene = sceneChunk(data);
+    scene.chunk.type = UnsignedInt(Implementation::BlobChunkType::Scene);
+    scene.chunk.nameSize = 3;
+    scene.chunk.size = chunkSize;
+    scene.mappingType = UnsignedByte(SceneMappingType::UnsignedInt);
+    scene.fieldCount = 2;
+    scene.mappingBound = 2;
+    scene.dataOffset = 64;
+    scene.dataSize = 64;
+    scene.fieldDataOffset = 128;
+    Utility::copy(Containers::arrayView({'y', 'e', 's'}), data.sliceSize(32 + 56, 3));
+    Utility::copy(Containers::arrayView<UnsignedInt>({0, 1}), Containers::arrayCast<UnsignedInt>(data.sliceSize(32 + 64, 8)));
+    Utility::copy(Containers::arrayView({
+        Vector3{1.0f, 2.0f, 3.0f},
+        Vector3{4.0f, 5.0f, 6.0f}
+    }), Containers::arrayCast<Vector3>(data.sliceSize(32 + 64 + 8, 24)));
+    Utility::copy(Containers::arrayView({
+        Quaternion{},
+        Quaternion{}
+    }), Containers::arrayCast<Quaternion>(data.sliceSize(32 + 64 + 32, 32)));
+    sceneField(data, 0) = SceneFieldData{SceneField::Translation, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Vector3, 8, 12};
+    sceneField(data, 1) = SceneFieldData{SceneField::Rotation, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Quaternion, 32, 16};
+
+    return data;
+}
+
+/* A 32-byte header followed by a 256-byte chunk containing a 48-byte material
+   header, a null-terminated name padded to 8 bytes, three 64-byte attributes
+   and offsets of two layers */
+Containers::Array<char> materialFile() {
+    Containers::Array<char> data{ValueInit, 32 + 256};
+    fillHeader(data);
+
+    Implementation::BlobMaterial& material = materialChunk(data);
+    material.chunk.type = UnsignedInt(Implementation::BlobChunkType::Material);
+    material.chunk.nameSize = 3;
+    material.chunk.size = 256;
+    material.types = UnsignedInt(MaterialType::PbrClearCoat);
+    material.attributeCount = 3;
+    material.layerCount = 2;
+    material.attributeDataOffset = 56;
+    material.layerDataOffset = 248;
+    Utility::copy(Containers::arrayView({'y', 'e', 's'}), data.sliceSize(32 + 48, 3));
+    materialAttribute(data, 0) = MaterialAttributeData{MaterialAttribute::BaseColorTexture, 2u};
+    materialAttribute(data, 1) = MaterialAttributeData{MaterialAttribute::DoubleSided, true};
+    materialAttribute(data, 2) = MaterialAttributeData{MaterialLayer::ClearCoat};
+    materialLayerOffset(data, 0) = 2;
+    materialLayerOffset(data, 1) = 3;
+
+    return data;
+}
+
+const struct {
+    const char* name;
+    std::size_t size;
+    void(*modify)(Containers::ArrayView<char>);
+    const char* message;
+} InvalidData[]{
+    {"too short", 31, [](Containers::ArrayView<char>) {},
+        "expected at least 32 bytes for a header but got 31"},
+    {"invalid signature", 0, [](Containers::ArrayView<char> data) {
+            header(data).signature[3] = 'K';
+        }, "invalid signature"},
+    {"unsupported version", 0, [](Containers::ArrayView<char> data) {
+            header(data).version = 2;
+        }, "unsupported version 2"},
+    {"different endianness", 0, [](Containers::ArrayView<char> data) {
+            header(data).bigEndian = !Utility::Endianness::isBigEndian();
+        }, Utility::Endianness::isBigEndian() ?
+            "file produced on a little-endian platform" :
+            "file produced on a big-endian platform"},
+    {"different pointer size", 0, [](Containers::ArrayView<char> data) {
+            header(data).pointerSize = sizeof(void*) == 8 ? 4 : 8;
+        }, sizeof(void*) == 8 ?
+            "file produced on a 32-bit platform" :
+            "file produced on a 64-bit platform"},
+    {"different structure size", 0, [](Containers::ArrayView<char> data) {
+            header(data).sceneFieldDataSize += 8;
+        }, "file produced with an incompatible version of Magnum"},
+    {"different layout hash", 0, [](Containers::ArrayView<char> data) {
+            header(data).layoutHash ^= 1;
+        }, "file produced with an incompatible version of Magnum"},
+    {"size mismatch", 0, [](Containers::ArrayView<char> data) {
+            header(data).size = 160;
+        }, "expected 160 bytes but got 152"},
+    {"too few chunks", 0, [](Containers::ArrayView<char> data) {
+            header(data).chunkCount = 2;
+        }, "expected 2 chunks but got only 1"},
+    {"chunk size too small", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).chunk.size = 8;
+        }, "invalid chunk 0 size 8"},
+    {"chunk size not aligned", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).chunk.size = 116;
+        }, "invalid chunk 0 size 116"},
+    {"chunk size out of bounds", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).chunk.size = 128;
+        }, "invalid chunk 0 size 128"},
+    {"chunk name out of bounds", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).chunk.nameSize = 100;
+        }, "chunk 0 is too small for its header and name"},
+    {"chunk name not null-terminated", 0, [](Containers::ArrayView<char> data) {
+            data[32 + 104 + 3] = '!';
+        }, "chunk 0 is too small for its header and name"},
+    {"chunk data out of bounds", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).dataSize = 16;
+        }, "data range [112:128] of chunk 0 is not aligned or out of bounds for 120 bytes"},
+    {"chunk data not aligned", 0, [](Containers::ArrayView<char> data) {
+            imageChunk(data).dataOffset = 108;
+        }, "data range [108:112] of chunk 0 is not aligned or out of bounds for 120 bytes"},
+    {"default scene out of range", 0, [](Containers::ArrayView<char> data) {
+            header(data).defaultScene = 0;
+        }, "default scene 0 out of range for 0 scenes"},
+};
+
+const struct {
+    const char* name;
+    void(*modify)(Containers::ArrayView<char>);
+    const char* message;
+} InvalidImageData[]{
+    {"negative size", [](Containers::ArrayView<char> data) {
+            imageChunk(data).size[1] = -1;
+        }, "invalid size {1, -1}"},
+    {"negative skip", [](Containers::ArrayView<char> data) {
+            imageChunk(data).skip[0] = -1;
+        }, "invalid row length 0, image height 0 or skip {-1, 0, 0}"},
+    {"invalid flags", [](Containers::ArrayView<char> data) {
+            /* CubeMap is valid only for 3D images */
+            imageChunk(data).flags = UnsignedShort(ImageFlag3D::CubeMap);
+        }, "invalid flags ImageFlag2D(0x2)"},
+    {"zero alignment", [](Containers::ArrayView<char> data) {
+            imageChunk(data).alignment = 0;
+        }, "invalid alignment 0"},
+    {"invalid alignment", [](Containers::ArrayView<char> data) {
+            imageChunk(data).alignment = 3;
+        }, "invalid alignment 3"},
+    {"zero pixel size", [](Containers::ArrayView<char> data) {
+            imageChunk(data).pixelSize = 0;
+        }, "invalid pixel size 0"},
+    {"pixel size too large", [](Containers::ArrayView<char> data) {
+            imageChunk(data).pixelSize = 256;
+        }, "invalid pixel size 256"},
+    {"data too small", [](Containers::ArrayView<char> data) {
+            imageChunk(data).size[0] = 2;
+        }, "data too small, got 4 but expected at least 8 bytes"},
+    {"data size overflow", [](Containers::ArrayView<char> data) {
+            Implementation::BlobImage& image = imageChunk(data);
+            image.rowLength = 0x7fffffff;
+            image.imageHeight = 0x7fffffff;
+            image.skip[2] = 0x7fffffff;
+        }, "data too small, got 4 but expected at least 18446744073709551615 bytes"},
+    {"invalid compressed block size", [](Containers::ArrayView<char> data) {
+            Implementation::BlobImage& image = imageChunk(data);
+            image.compressed = 1;
+            image.compressedBlockSize[0] = 4;
+            image.compressedBlockSize[1] = 4;
+            image.compressedBlockDataSize = 16;
+        }, "invalid compressed block size {4, 4, 0} and data size 16"},
+    {"compressed data too small", [](Containers::ArrayView<char> data) {
+            Implementation::BlobImage& image = imageChunk(data);
+            image.compressed = 1;
+            image.compressedBlockSize[0] = 4;
+            image.compressedBlockSize[1] = 4;
+            image.compressedBlockSize[2] = 1;
+            image.compressedBlockDataSize = 16;
+        }, "data too small, got 4 but expected at least 16 bytes"},
+};
+
+/* Data are referenced from these only to verify non-offset-only fields and
+   attributes are rejected */
+const UnsignedInt Mapping[2]{};
+const Vector3 Positions[3]{};
+
+const struct {
+    const char* name;
+    void(*modify)(Containers::ArrayView<char>);
+    const char* message;
+} InvalidMeshData[]{
+    {"invalid primitive", [](Containers::ArrayView<char> data) {
+            meshChunk(data).primitive = 0xdead;
+        }, "invalid primitive MeshPrimitive(0xdead)"},
+    {"index data for a non-indexed mesh", [](Containers::ArrayView<char> data) {
+            meshChunk(data).indexType = 0;
+        }, "expected no index data for a mesh with no indices but got 8 bytes"},
+    {"invalid index type", [](Containers::ArrayView<char> data) {
+            meshChunk(data).indexType = 4;
+        }, "invalid index type MeshIndexType(0x4)"},
+    {"index stride too large", [](Containers::ArrayView<char> data) {
+            meshChunk(data).indexStride = 32768;
+        }, "expected index stride to fit into 16 bits but got 32768"},
+    {"indices out of range", [](Containers::ArrayView<char> data) {
+            meshChunk(data).indexCount = 5;
+        }, "indices out of range for 8 bytes of index data"},
+    {"index offset overflow", [](Containers::ArrayView<char> data) {
+            meshChunk(data).indexOffset = ~UnsignedLong{} - 1;
+        }, "indices out of range for 8 bytes of index data"},
+    {"implicit vertex count", [](Containers::ArrayView<char> data) {
+            meshChunk(data).attributeCount = 0;
+            meshChunk(data).vertexCount = MeshData::ImplicitVertexCount;
+        }, "vertex count can't be implicit if there are no attributes"},
+    {"attribute not offset-only", [](Containers::ArrayView<char> data) {
+            meshAttribute(data) = MeshAttributeData{MeshAttribute::Position, Containers::stridedArrayView(Positions)};
+        }, "attribute 0 is not offset-only"},
+    {"invalid attribute name", [](Containers::ArrayView<char> data) {
+            /* Implementation-specific formats are allowed for any name */
+            meshAttribute(data) = MeshAttributeData{MeshAttribute(0x7000), vertexFormatWrap(0xcafe), 0, 3, 12};
+        }, "invalid attribute 0 name Trade::MeshAttribute(0x7000)"},
+    {"invalid attribute format", [](Containers::ArrayView<char> data) {
+            meshAttribute(data) = MeshAttributeData{meshAttributeCustom(3), VertexFormat(0xdead), 0, 3, 12};
+        }, "invalid attribute 0 format VertexFormat(0xdead)"},
+    {"attribute out of range", [](Containers::ArrayView<char> data) {
+            meshChunk(data).vertexCount = 4;
+        }, "attribute 0 out of range for 40 bytes of vertex data"},
+    {"attribute negative stride out of range", [](Containers::ArrayView<char> data) {
+            meshAttribute(data) = MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 12, 3, -12};
+        }, "attribute 0 out of range for 40 bytes of vertex data"},
+    {"joint IDs without weights", [](Containers::ArrayView<char> data) {
+            meshAttribute(data) = MeshAttributeData{MeshAttribute::JointIds, VertexFormat::UnsignedByte, 0, 3, 12, 4};
+        }, "expected 1 weight attributes to match joint IDs but got 0"},
+};
+
+const struct {
+    const char* name;
+    void(*modify)(Containers::ArrayView<char>);
+    const char* message;
+} InvalidSceneData[]{
+    {"invalid mapping type", [](Containers::ArrayView<char> data) {
+            sceneChunk(data).mappingType = 5;
+        }, "invalid mapping type Trade::SceneMappingType(0x5)"},
+    {"mapping type too small", [](Containers::ArrayView<char> data) {
+            sceneChunk(data).mappingType = UnsignedByte(SceneMappingType::UnsignedByte);
+            sceneChunk(data).mappingBound = 256;
+        }, "Trade::SceneMappingType::UnsignedByte is too small for 256 objects"},
+    {"field not offset-only", [](Containers::ArrayView<char> data) {
+            sceneField(data, 0) = SceneFieldData{SceneField::Translation, Containers::stridedArrayView(Mapping), Containers::stridedArrayView(Positions).prefix(2)};
+        }, "field 0 is not offset-only"},
+    {"duplicate field", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{SceneField::Translation, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Vector3, 8, 12};
+        }, "duplicate field Trade::SceneField::Translation"},
+    {"inconsistent mapping type", [](Containers::ArrayView<char> data) {
+            sceneChunk(data).mappingType = UnsignedByte(SceneMappingType::UnsignedShort);
+        }, "inconsistent mapping type, got Trade::SceneMappingType::UnsignedInt for field 0 but expected Trade::SceneMappingType::UnsignedShort"},
+    {"invalid field type", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{sceneFieldCustom(3), 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType(0xdead), 32, 16};
+        }, "invalid field 1 type Trade::SceneFieldType(0xdead)"},
+    {"mapping out of range", [](Containers::ArrayView<char> data) {
+            sceneField(data, 0) = SceneFieldData{SceneField::Translation, 2, SceneMappingType::UnsignedInt, 60, 4, SceneFieldType::Vector3, 8, 12};
+        }, "mapping data of field 0 out of range for 64 bytes of data"},
+    {"field out of range", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{SceneField::Rotation, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Quaternion, 40, 16};
+        }, "field data of field 1 out of range for 64 bytes of data"},
+    {"field size overflow", [](Containers::ArrayView<char> data) {
+            sceneField(data, 0) = SceneFieldData{SceneField::Translation, ~std::size_t{}/2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Vector3, 8, 12};
+        }, "mapping data of field 0 out of range for 64 bytes of data"},
+    {"string data out of range", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{sceneFieldCustom(3), 2, SceneMappingType::UnsignedInt, 0, 4, 100, SceneFieldType::StringOffset32, 32, 4};
+        }, "string data of field 1 out of range for 64 bytes of data"},
+    {"TRS mapping mismatch", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{SceneField::Rotation, 2, SceneMappingType::UnsignedInt, 4, 4, SceneFieldType::Quaternion, 32, 16};
+        }, "Trade::SceneField::Rotation mapping data is different from Trade::SceneField::Translation mapping data"},
+    {"2D and 3D transformation mismatch", [](Containers::ArrayView<char> data) {
+            sceneField(data, 1) = SceneFieldData{SceneField::Rotation, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Complex, 32, 8};
+        }, "expected a 3D rotation field but got Trade::SceneFieldType::Complex"},
+    {"skin without transformation", [](Containers::ArrayView<char> data) {
+            sceneField(data, 0) = SceneFieldData{SceneField::Parent, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::Int, 8, 4};
+            sceneField(data, 1) = SceneFieldData{SceneField::Skin, 2, SceneMappingType::UnsignedInt, 0, 4, SceneFieldType::UnsignedInt, 16, 4};
+        }, "a skin field requires some transformation field to be present in order to disambiguate between 2D and 3D"},
+};
+
+const struct {
+    const char* name;
+    void(*modify)(Containers::ArrayView<char>);
+    const char* message;
+} InvalidMaterialData[]{
+    {"invalid attribute type", [](Containers::ArrayView<char> data) {
+            /* The type is the first byte of the attribute */
+            data[32 + 56 + 64] = '\xfe';
+        }, "invalid attribute 1 type Trade::MaterialAttributeType(0xfe)"},
+    {"empty attribute name", [](Containers::ArrayView<char> data) {
+            data[32 + 56 + 1] = '\0';
+        }, "invalid attribute 0 name or value size"},
+    {"attribute name not null-terminated", [](Containers::ArrayView<char> data) {
+            /* The UnsignedInt value is in the last four bytes */
+            for(char& c: data.slice(32 + 56 + 1, 32 + 56 + 60)) c = 'a';
+        }, "invalid attribute 0 name or value size"},
+    {"attributes not sorted", [](Containers::ArrayView<char> data) {
+            materialAttribute(data, 0) = MaterialAttributeData{MaterialAttribute::DoubleSided, true};
+            materialAttribute(data, 1) = MaterialAttributeData{MaterialAttribute::BaseColorTexture, 2u};
+        }, "BaseColorTexture has to be sorted before DoubleSided in layer 0"},
+    {"duplicate attribute", [](Containers::ArrayView<char> data) {
+            materialAttribute(data, 1) = MaterialAttributeData{MaterialAttribute::BaseColorTexture, 3u};
+        }, "duplicate attribute BaseColorTexture in layer 0"},
+    {"layer offset out of range", [](Containers::ArrayView<char> data) {
+            materialLayerOffset(data, 0) = 4;
+        }, "invalid range (0,4) for layer 0 with 3 attributes in total"},
+    {"last layer offset too short", [](Containers::ArrayView<char> data) {
+            materialLayerOffset(data, 1) = 2;
+        }, "last layer offset 2 too short for 3 attributes in total"},
+};
+
+MagnumImporterTest::MagnumImporterTest() {
+    addInstancedTests({&MagnumImporterTest::invalid},
+        Containers::arraySize(InvalidData));
+
+    addTests({&MagnumImporterTest::empty,
+              &MagnumImporterTest::image});
+
+    addInstancedTests({&MagnumImporterTest::imageInvalid},
+        Containers::arraySize(InvalidImageData));
+
+    addTests({&MagnumImporterTest::unknownChunk,
+
+              &MagnumImporterTest::mesh});
+
+    addInstancedTests({&MagnumImporterTest::meshInvalid},
+        Containers::arraySize(InvalidMeshData));
+
+    addTests({&MagnumImporterTest::scene});
+
+    addInstancedTests({&MagnumImporterTest::sceneInvalid},
+        Containers::arraySize(InvalidSceneData));
+
+    addTests({&MagnumImporterTest::material});
+
+    addInstancedTests({&MagnumImporterTest::materialInvalid},
+        Containers::arraySize(InvalidMaterialData));
+
+    addTests({&MagnumImporterTest::openMemory,
+              &MagnumImporterTest::openMemoryUnaligned,
+              &MagnumImporterTest::openFile});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Path::make(MAGNUMIMPORTER_TEST_OUTPUT_DIR));
+}
+
+void MagnumImporterTest::invalid() {
+    auto&& data = InvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> file = imageFile();
+    data.modify(file);
+    const Containers::ArrayView<const char> in = file;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.size ? in.prefix(data.size) : in));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::openData(): {}\n", data.message));
+}
+
+void MagnumImporterTest::empty() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> file = imageFile();
+    header(file).chunkCount = 0;
+    header(file).size = 32;
+
+    CORRADE_VERIFY(importer->openData(file.prefix(32)));
+    CORRADE_COMPARE(importer->defaultScene(), -1);
+    CORRADE_COMPARE(importer->sceneCount(), 0);
+    CORRADE_COMPARE(importer->objectCount(), 0);
+    CORRADE_COMPARE(importer->meshCount(), 0);
+    CORRADE_COMPARE(importer->materialCount(), 0);
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 0);
+    CORRADE_COMPARE(importer->image3DCount(), 0);
+}
+
+void MagnumImporterTest::image() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    CORRADE_VERIFY(importer->openData(imageFile()));
+    CORRADE_COMPARE(importer->image1DCount(), 0);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image3DCount(), 0);
+    CORRADE_COMPARE(importer->image2DName(0), "yes");
+    CORRADE_COMPARE(importer->image2DForName("yes"), 0);
+    CORRADE_COMPARE(importer->image2DForName("no"), -1);
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(image->pixelSize(), 4);
+    CORRADE_COMPARE(image->size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView<char>({'\xff', '\x33', '\x66', '\x99'}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::imageInvalid() {
+    auto&& data = InvalidImageData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* The contents are checked only when the image is accessed */
+    Containers::Array<char> file = imageFile();
+    data.modify(file);
+    CORRADE_VERIFY(importer->openData(file));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->image2D(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::image2D(): {}\n", data.message));
+}
+
+void MagnumImporterTest::unknownChunk() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Chunks of unknown types are skipped, the rest is imported as usual */
+    Containers::Array<char> file = imageFile();
+    imageChunk(file).chunk.type = Utility::Endianness::fourCC('W', 'H', 'A', 'T');
+
+    CORRADE_VERIFY(importer->openData(file));
+    CORRADE_COMPARE(importer->image2DCount(), 0);
+}
+
+void MagnumImporterTest::mesh() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    CORRADE_VERIFY(importer->openData(meshFile()));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "yes");
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::meshInvalid() {
+    auto&& data = InvalidMeshData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* The contents are checked only when the mesh is accessed */
+    Containers::Array<char> file = meshFile();
+    data.modify(file);
+    CORRADE_VERIFY(importer->openData(file));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::mesh(): {}\n", data.message));
+}
+
+void MagnumImporterTest::scene() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    CORRADE_VERIFY(importer->openData(sceneFile()));
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+    CORRADE_COMPARE(importer->sceneName(0), "yes");
+    CORRADE_COMPARE(importer->objectCount(), 2);
+
+    Containers::Optional<SceneData> scene = importer->scene(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->mappingType(), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(scene->mappingBound(), 2);
+    CORRADE_COMPARE(scene->fieldCount(), 2);
+    CORRADE_VERIFY(scene->is3D());
+    CORRADE_COMPARE_AS(scene->mapping<UnsignedInt>(SceneField::Translation),
+        Containers::arrayView<UnsignedInt>({0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene->field<Vector3>(SceneField::Translation),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::sceneInvalid() {
+    auto&& data = InvalidSceneData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* The contents are checked only when the scene is accessed */
+    Containers::Array<char> file = sceneFile();
+    data.modify(file);
+    CORRADE_VERIFY(importer->openData(file));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->scene(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::scene(): {}\n", data.message));
+}
+
+void MagnumImporterTest::material() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    CORRADE_VERIFY(importer->openData(materialFile()));
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->materialName(0), "yes");
+
+    Containers::Optional<MaterialData> material = importer->material(0);
+    CORRADE_VERIFY(material);
+    CORRADE_COMPARE(material->types(), MaterialType::PbrClearCoat);
+    CORRADE_COMPARE(material->layerCount(), 2);
+    CORRADE_COMPARE(material->attributeCount(0), 2);
+    CORRADE_COMPARE(material->attributeCount(1), 1);
+    CORRADE_COMPARE(material->attribute<UnsignedInt>(MaterialAttribute::BaseColorTexture), 2);
+    CORRADE_COMPARE(material->attribute<bool>(MaterialAttribute::DoubleSided), true);
+    CORRADE_COMPARE(material->layerName(1), "ClearCoat");
+}
+
+void MagnumImporterTest::materialInvalid() {
+    auto&& data = InvalidMaterialData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* The contents are checked only when the material is accessed */
+    Containers::Array<char> file = materialFile();
+    data.modify(file);
+    CORRADE_VERIFY(importer->openData(file));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->material(0));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::material(): {}\n", data.message));
+}
+
+void MagnumImporterTest::openMemory() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Needs to stay in scope for openMemory(). A new[]'d array is always
+       sufficiently aligned. */
+    Containers::Array<char> file = imageFile();
+    CORRADE_VERIFY(importer->openMemory(file));
+
+    /* The data are referenced directly from the passed memory */
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), static_cast<const void*>(file.data() + 32 + 112));
+}
+
+void MagnumImporterTest::openMemoryUnaligned() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Put the file at an odd offset, which forces the importer to make an
+       aligned copy */
+    Containers::Array<char> original = imageFile();
+    Containers::Array<char> file{ValueInit, original.size() + 1};
+    Utility::copy(original, file.exceptPrefix(1));
+    CORRADE_VERIFY(importer->openMemory(file.exceptPrefix(1)));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_VERIFY(image->data().data() != file.data() + 1 + 32 + 112);
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView<char>({'\xff', '\x33', '\x66', '\x99'}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::openFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::String filename = Utility::Path::join(MAGNUMIMPORTER_TEST_OUTPUT_DIR, "image.blob");
+    CORRADE_VERIFY(Utility::Path::write(filename, imageFile()));
+
+    /* On platforms that support it the file is memory-mapped, but the data
+       are owned by the importer in either case */
+    CORRADE_VERIFY(importer->openFile(filename));
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView<char>({'\xff', '\x33', '\x66', '\x99'}),
+        TestSuite::Compare::Container);
+
+    /* Closing unmaps the file, so it can be deleted on Windows as well */
+    importer->close();
+    CORRADE_VERIFY(Utility::Path::remove(filename));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
@@ -0,0 +1,337 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumSceneConverter.h"
+
+#include <new>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StridedBitArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+static_assert(alignof(MeshAttributeData) <= Implementation::BlobAlignment &&
+              alignof(SceneFieldData) <= Implementation::BlobAlignment &&
+              alignof(MaterialAttributeData) <= Implementation::BlobAlignment,
+    "blob alignment not enough for the Trade data structures");
+
+struct MagnumSceneConverter::State {
+    /* Growable, starts with a BlobHeader that gets filled in doEndData() */
+    Containers::Array<char> data;
+    UnsignedInt chunkCount = 0;
+    Int defaultScene = -1;
+};
+
+namespace {
+
+/* Appends a zero-initialized chunk of given size, fills the common chunk
+   header and the name and returns the type-specific header. The memory is
+   zeroed so padding bytes in the data and in structures constructed inside
+   the chunk are deterministic. */
+template<class T> T& appendChunk(Containers::Array<char>& data, UnsignedInt& chunkCount, const Implementation::BlobChunkType type, const Containers::StringView name, const std::size_t size) {
+    CORRADE_INTERNAL_ASSERT(size % Implementation::BlobAlignment == 0 && size >= sizeof(T) + name.size() + 1);
+    char* const chunk = arrayAppend(data, ValueInit, size).data();
+    T& header = *reinterpret_cast<T*>(chunk);
+    header.chunk.type = UnsignedInt(type);
+    header.chunk.nameSize = name.size();
+    header.chunk.size = size;
+    Utility::copy(name, Containers::arrayView(chunk + sizeof(T), name.size()));
+    ++chunkCount;
+    return header;
+}
+
+template<UnsignedInt dimensions> void appendImage(Containers::Array<char>& data, UnsignedInt& chunkCount, const Implementation::BlobChunkType type, const ImageData<dimensions>& image, const Containers::StringView name) {
+    const Containers::ArrayView<const char> imageData = image.data();
+    const std::size_t dataOffset = Implementation::blobAligned(sizeof(Implementation::BlobImage) + name.size() + 1);
+    const std::size_t size = Implementation::blobAligned(dataOffset + imageData.size());
+
+    Implementation::BlobImage& header = appendChunk<Implementation::BlobImage>(data, chunkCount, type, name, size);
+    header.compressed = image.isCompressed();
+    header.flags = UnsignedShort(image.flags());
+
+    /* Compressed images have no alignment, it stays zero for those */
+    Int rowLength, imageHeight;
+    Vector3i skip;
+    if(image.isCompressed()) {
+        const CompressedPixelStorage storage = image.compressedStorage();
+        header.format = UnsignedInt(image.compressedFormat());
+        rowLength = storage.rowLength();
+        imageHeight = storage.imageHeight();
+        skip = storage.skip();
+        for(std::size_t i = 0; i != 3; ++i)
+            header.compressedBlockSize[i] = storage.compressedBlockSize()[i];
+        header.compressedBlockDataSize = storage.compressedBlockDataSize();
+    } else {
+        const PixelStorage storage = image.storage();
+        header.format = UnsignedInt(image.format());
+        header.formatExtra = image.formatExtra();
+        header.pixelSize = image.pixelSize();
+        header.alignment = storage.alignment();
+        rowLength = storage.rowLength();
+        imageHeight = storage.imageHeight();
+        skip = storage.skip();
+    }
+
+    const Vector3i imageSize = Vector3i::pad(image.size());
+    for(std::size_t i = 0; i != 3; ++i) {
+        header.size[i] = imageSize[i];
+        header.skip[i] = skip[i];
+    }
+    header.rowLength = rowLength;
+    header.imageHeight = imageHeight;
+    header.dataOffset = dataOffset;
+    header.dataSize = imageData.size();
+
+    Utility::copy(imageData, Containers::arrayView(reinterpret_cast<char*>(&header) + dataOffset, imageData.size()));
+}
+
+}
+
+MagnumSceneConverter::MagnumSceneConverter() = default;
+
+MagnumSceneConverter::MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MagnumSceneConverter::~MagnumSceneConverter() = default;
+
+SceneConverterFeatures MagnumSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMultipleToData|
+           SceneConverterFeature::AddScenes|
+           SceneConverterFeature::AddMeshes|
+           SceneConverterFeature::AddMaterials|
+           SceneConverterFeature::AddImages1D|
+           SceneConverterFeature::AddImages2D|
+           SceneConverterFeature::AddImages3D|
+           SceneConverterFeature::AddCompressedImages1D|
+           SceneConverterFeature::AddCompressedImages2D|
+           SceneConverterFeature::AddCompressedImages3D;
+}
+
+void MagnumSceneConverter::doAbort() {
+    _state = nullptr;
+}
+
+bool MagnumSceneConverter::doBeginData() {
+    _state.emplace();
+    arrayAppend(_state->data, ValueInit, sizeof(Implementation::BlobHeader));
+    return true;
+}
+
+Containers::Optional<Containers::Array<char>> MagnumSceneConverter::doEndData() {
+    Implementation::BlobHeader& header = *reinterpret_cast<Implementation::BlobHeader*>(_state->data.data());
+    header.signature[0] = 'M';
+    header.signature[1] = 'G';
+    header.signature[2] = 'B';
+    header.signature[3] = 'L';
+    header.version = Implementation::BlobVersion;
+    header.pointerSize = sizeof(void*);
+    header.bigEndian = Utility::Endianness::isBigEndian();
+    header.meshAttributeDataSize = sizeof(MeshAttributeData);
+    header.sceneFieldDataSize = sizeof(SceneFieldData);
+    header.materialAttributeDataSize = sizeof(MaterialAttributeData);
+    header.layoutHash = Implementation::blobLayoutHash();
+    header.defaultScene = _state->defaultScene;
+    header.chunkCount = _state->chunkCount;
+    header.size = _state->data.size();
+
+    /* Turn the growable array back into a non-growable to avoid a dangling
+       deleter on plugin unload */
+    Containers::Array<char> out = std::move(_state->data);
+    arrayShrink(out);
+    _state = nullptr;
+
+    /* GCC 4.8 needs extra help here */
+    return Containers::optional(std::move(out));
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const SceneData& scene, const Containers::StringView name) {
+    const Containers::ArrayView<const char> data = scene.data();
+    const UnsignedInt fieldCount = scene.fieldCount();
+    const std::size_t dataOffset = Implementation::blobAligned(sizeof(Implementation::BlobScene) + name.size() + 1);
+    const std::size_t fieldDataOffset = Implementation::blobAligned(dataOffset + data.size());
+    const std::size_t size = Implementation::blobAligned(fieldDataOffset + fieldCount*sizeof(SceneFieldData));
+
+    Implementation::BlobScene& header = appendChunk<Implementation::BlobScene>(_state->data, _state->chunkCount, Implementation::BlobChunkType::Scene, name, size);
+    header.mappingType = UnsignedByte(scene.mappingType());
+    header.fieldCount = fieldCount;
+    header.mappingBound = scene.mappingBound();
+    header.dataOffset = dataOffset;
+    header.dataSize = data.size();
+    header.fieldDataOffset = fieldDataOffset;
+
+    char* const chunk = reinterpret_cast<char*>(&header);
+    Utility::copy(data, Containers::arrayView(chunk + dataOffset, data.size()));
+
+    /* Offset of a view relative to the data array. Empty views can have
+       arbitrary pointers, use zero for those. */
+    const auto offset = [&](const void* const pointer, const std::size_t count) -> std::size_t {
+        return count ? static_cast<const char*>(pointer) - data.data() : 0;
+    };
+
+    /* Save all fields as offset-only. The data stay the same, so the field
+       flags including OrderedMapping / ImplicitMapping are preserved. */
+    const SceneMappingType mappingType = scene.mappingType();
+    for(UnsignedInt i = 0; i != fieldCount; ++i) {
+        const SceneField fieldName = scene.fieldName(i);
+        const SceneFieldType fieldType = scene.fieldType(i);
+        const std::size_t fieldSize = scene.fieldSize(i);
+        const SceneFieldFlags flags = scene.fieldFlags(i) & ~SceneFieldFlag::OffsetOnly;
+        const Containers::StridedArrayView2D<const char> mapping = scene.mapping(i);
+        const std::size_t mappingOffset = offset(mapping.data(), fieldSize);
+        void* const out = chunk + fieldDataOffset + i*sizeof(SceneFieldData);
+
+        if(fieldType == SceneFieldType::Bit) {
+            const Containers::StridedBitArrayView2D field = scene.fieldBitArrays(i);
+            new(out) SceneFieldData{fieldName, fieldSize, mappingType, mappingOffset, mapping.stride()[0], offset(field.data(), fieldSize), field.offset(), field.stride()[0], scene.fieldArraySize(i), flags};
+        } else if(Implementation::isSceneFieldTypeString(fieldType)) {
+            const Containers::StridedArrayView2D<const char> field = scene.field(i);
+            new(out) SceneFieldData{fieldName, fieldSize, mappingType, mappingOffset, mapping.stride()[0], std::size_t(scene.fieldStringData(i) - data.data()), fieldType, offset(field.data(), fieldSize), field.stride()[0], flags};
+        } else {
+            const Containers::StridedArrayView2D<const char> field = scene.field(i);
+            new(out) SceneFieldData{fieldName, fieldSize, mappingType, mappingOffset, mapping.stride()[0], fieldType, offset(field.data(), fieldSize), field.stride()[0], scene.fieldArraySize(i), flags};
+        }
+    }
+
+    return true;
+}
+
+void MagnumSceneConverter::doSetSceneFieldName(const UnsignedInt field, const Containers::StringView name) {
+    Implementation::BlobCustomName& header = appendChunk<Implementation::BlobCustomName>(_state->data, _state->chunkCount, Implementation::BlobChunkType::SceneFieldName, name, Implementation::blobAligned(sizeof(Implementation::BlobCustomName) + name.size() + 1));
+    header.id = field;
+}
+
+void MagnumSceneConverter::doSetObjectName(const UnsignedLong object, const Containers::StringView name) {
+    Implementation::BlobObjectName& header = appendChunk<Implementation::BlobObjectName>(_state->data, _state->chunkCount, Implementation::BlobChunkType::ObjectName, name, Implementation::blobAligned(sizeof(Implementation::BlobObjectName) + name.size() + 1));
+    header.object = object;
+}
+
+void MagnumSceneConverter::doSetDefaultScene(const UnsignedInt id) {
+    _state->defaultScene = id;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const MeshData& mesh, const Containers::StringView name) {
+    /* Index data are saved only if the mesh is indexed, the MeshData
+       constructor expects them to be empty otherwise */
+    const Containers::ArrayView<const char> indexData = mesh.isIndexed() ? mesh.indexData() : nullptr;
+    const Containers::ArrayView<const char> vertexData = mesh.vertexData();
+    const UnsignedInt attributeCount = mesh.attributeCount();
+    const std::size_t indexDataOffset = Implementation::blobAligned(sizeof(Implementation::BlobMesh) + name.size() + 1);
+    const std::size_t vertexDataOffset = Implementation::blobAligned(indexDataOffset + indexData.size());
+    const std::size_t attributeDataOffset = Implementation::blobAligned(vertexDataOffset + vertexData.size());
+    const std::size_t size = Implementation::blobAligned(attributeDataOffset + attributeCount*sizeof(MeshAttributeData));
+
+    Implementation::BlobMesh& header = appendChunk<Implementation::BlobMesh>(_state->data, _state->chunkCount, Implementation::BlobChunkType::Mesh, name, size);
+    header.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        header.indexStride = mesh.indexStride();
+        header.indexOffset = mesh.indexOffset();
+    }
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = indexData.size();
+    header.vertexCount = mesh.vertexCount();
+    header.attributeCount = attributeCount;
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = vertexData.size();
+    header.attributeDataOffset = attributeDataOffset;
+
+    char* const chunk = reinterpret_cast<char*>(&header);
+    Utility::copy(indexData, Containers::arrayView(chunk + indexDataOffset, indexData.size()));
+    Utility::copy(vertexData, Containers::arrayView(chunk + vertexDataOffset, vertexData.size()));
+
+    /* Save all attributes as offset-only, the vertex data stay the same */
+    for(UnsignedInt i = 0; i != attributeCount; ++i)
+        new(chunk + attributeDataOffset + i*sizeof(MeshAttributeData)) MeshAttributeData{mesh.attributeName(i), mesh.attributeFormat(i), mesh.attributeOffset(i), mesh.vertexCount(), mesh.attributeStride(i), mesh.attributeArraySize(i)};
+
+    return true;
+}
+
+void MagnumSceneConverter::doSetMeshAttributeName(const UnsignedShort attribute, const Containers::StringView name) {
+    Implementation::BlobCustomName& header = appendChunk<Implementation::BlobCustomName>(_state->data, _state->chunkCount, Implementation::BlobChunkType::MeshAttributeName, name, Implementation::blobAligned(sizeof(Implementation::BlobCustomName) + name.size() + 1));
+    header.id = attribute;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const MaterialData& material, const Containers::StringView name) {
+    const Containers::ArrayView<const MaterialAttributeData> attributeData = material.attributeData();
+    const Containers::ArrayView<const UnsignedInt> layerData = material.layerData();
+
+    /* Everything except pointers is stored inline in MaterialAttributeData */
+    for(const MaterialAttributeData& attribute: attributeData) {
+        if(attribute.type() == MaterialAttributeType::Pointer ||
+           attribute.type() == MaterialAttributeType::MutablePointer) {
+            Error{} << "Trade::MagnumSceneConverter::add(): material attribute" << attribute.name() << "is a" << attribute.type() << Debug::nospace << ", which can't be serialized";
+            return false;
+        }
+    }
+
+    const std::size_t attributeDataOffset = Implementation::blobAligned(sizeof(Implementation::BlobMaterial) + name.size() + 1);
+    const std::size_t layerDataOffset = Implementation::blobAligned(attributeDataOffset + attributeData.size()*sizeof(MaterialAttributeData));
+    const std::size_t size = Implementation::blobAligned(layerDataOffset + layerData.size()*sizeof(UnsignedInt));
+
+    Implementation::BlobMaterial& header = appendChunk<Implementation::BlobMaterial>(_state->data, _state->chunkCount, Implementation::BlobChunkType::Material, name, size);
+    header.types = UnsignedInt(material.types());
+    header.attributeCount = attributeData.size();
+    header.layerCount = layerData.size();
+    header.attributeDataOffset = attributeDataOffset;
+    header.layerDataOffset = layerDataOffset;
+
+    char* const chunk = reinterpret_cast<char*>(&header);
+    Utility::copy(Containers::arrayCast<const char>(attributeData), Containers::arrayView(chunk + attributeDataOffset, attributeData.size()*sizeof(MaterialAttributeData)));
+    Utility::copy(Containers::arrayCast<const char>(layerData), Containers::arrayView(chunk + layerDataOffset, layerData.size()*sizeof(UnsignedInt)));
+
+    return true;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData1D& image, const Containers::StringView name) {
+    appendImage(_state->data, _state->chunkCount, Implementation::BlobChunkType::Image1D, image, name);
+    return true;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData2D& image, const Containers::StringView name) {
+    appendImage(_state->data, _state->chunkCount, Implementation::BlobChunkType::Image2D, image, name);
+    return true;
+}
+
+bool MagnumSceneConverter::doAdd(UnsignedInt, const ImageData3D& image, const Containers::StringView name) {
+    appendImage(_state->data, _state->chunkCount, Implementation::BlobChunkType::Image3D, image, name);
+    return true;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumSceneConverter, Magnum::Trade::MagnumSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.2.1")
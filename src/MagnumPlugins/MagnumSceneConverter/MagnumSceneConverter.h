@@ -0,0 +1,166 @@
+#ifndef Magnum_Trade_MagnumSceneConverter_h
+#define Magnum_Trade_MagnumSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumSceneConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "MagnumPlugins/MagnumSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumSceneConverter_EXPORTS
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMSCENECONVERTER_EXPORT
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob scene converter plugin
+@m_since_latest
+
+Serializes scenes, meshes, materials and images into a Magnum blob (`*.blob`)
+that can be loaded back with @ref MagnumImporter without any parsing or
+copying of the data.
+
+@section Trade-MagnumSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`MAGNUM_WITH_MAGNUMSCENECONVERTER` is enabled when building Magnum. To use as
+a dynamic plugin, load @cpp "MagnumSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(MAGNUM_WITH_MAGNUMSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumSceneConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumSceneConverter-behavior Behavior and limitations
+
+The plugin supports @ref SceneConverterFeature::ConvertMultipleToData and
+@relativeref{SceneConverterFeature,ConvertMultipleToFile}, together with
+@relativeref{SceneConverterFeature,AddScenes},
+@relativeref{SceneConverterFeature,AddMeshes},
+@relativeref{SceneConverterFeature,AddMaterials} and 1D, 2D and 3D
+uncompressed and compressed images. Single-mesh conversion through
+@ref convertToData(const MeshData&) and @ref convertToFile(const MeshData&, Containers::StringView)
+is provided by the base class. Mesh and image levels, animations, lights,
+cameras, skins and textures are not supported.
+
+The output is a sequence of chunks, one for each added item, each containing
+the raw data array followed by the @ref MeshAttributeData,
+@ref SceneFieldData or @ref MaterialAttributeData array as it's laid out in
+memory, with mesh attributes and scene fields converted to offset-only. Index,
+vertex, scene and image data are copied byte-by-byte, preserving the original
+layout, including any padding and interleaving. Everything is aligned to 8
+bytes so @ref MagnumImporter can use the data in-place.
+
+Because the blob stores the in-memory representation directly, it's specific
+to the pointer size and endianness of the platform it was produced on, and
+to the version of Magnum that produced it. It's thus meant as a
+platform-specific cache of already processed assets, not as an interchange
+format.
+
+Mesh, scene, material and image names, object names, custom scene field names
+and custom mesh attribute names are preserved. Materials containing
+@ref MaterialAttributeType::Pointer or
+@relativeref{MaterialAttributeType,MutablePointer} attributes can't be
+serialized and the conversion fails in that case. Importer state is not
+preserved.
+*/
+class MAGNUM_MAGNUMSCENECONVERTER_EXPORT MagnumSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumSceneConverter(PluginManager::AbstractManager& manager, const Containers::StringView& plugin);
+
+        ~MagnumSceneConverter();
+
+    private:
+        struct State;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doAbort() override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doBeginData() override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL Containers::Optional<Containers::Array<char>> doEndData() override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const SceneData& scene, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doSetSceneFieldName(UnsignedInt field, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doSetObjectName(UnsignedLong object, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doSetDefaultScene(UnsignedInt id) override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const MeshData& mesh, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL void doSetMeshAttributeName(UnsignedShort attribute, Containers::StringView name) override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const MaterialData& material, Containers::StringView name) override;
+
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData1D& image, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData2D& image, Containers::StringView name) override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL bool doAdd(UnsignedInt id, const ImageData3D& image, Containers::StringView name) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
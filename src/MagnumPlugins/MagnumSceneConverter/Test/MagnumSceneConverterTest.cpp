@@ -0,0 +1,462 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pair.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h> /** @todo remove once Debug is stream-free */
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SceneData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumSceneConverterTest: TestSuite::Tester {
+    explicit MagnumSceneConverterTest();
+
+    void empty();
+    void materialPointer();
+
+    void mesh();
+    void meshNonIndexed();
+    void scene();
+    void material();
+    void images();
+
+    void openMemory();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+using namespace Math::Literals;
+
+MagnumSceneConverterTest::MagnumSceneConverterTest() {
+    addTests({&MagnumSceneConverterTest::empty,
+              &MagnumSceneConverterTest::materialPointer,
+
+              &MagnumSceneConverterTest::mesh,
+              &MagnumSceneConverterTest::meshNonIndexed,
+              &MagnumSceneConverterTest::scene,
+              &MagnumSceneConverterTest::material,
+              &MagnumSceneConverterTest::images,
+
+              &MagnumSceneConverterTest::openMemory});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumSceneConverterTest::empty() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    CORRADE_VERIFY(converter->beginData());
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->size(), sizeof(Implementation::BlobHeader));
+
+    const Implementation::BlobHeader& header = *reinterpret_cast<const Implementation::BlobHeader*>(data->data());
+    CORRADE_COMPARE(Containers::StringView(header.signature, 4), "MGBL");
+    CORRADE_COMPARE(header.version, Implementation::BlobVersion);
+    CORRADE_COMPARE(header.pointerSize, sizeof(void*));
+    CORRADE_COMPARE(header.layoutHash, Implementation::blobLayoutHash());
+    CORRADE_COMPARE(header.defaultScene, -1);
+    CORRADE_COMPARE(header.chunkCount, 0);
+    CORRADE_COMPARE(header.size, sizeof(Implementation::BlobHeader));
+}
+
+constexpr Int SomeData = 3;
+
+void MagnumSceneConverterTest::materialPointer() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MaterialData material{{}, {
+        {MaterialAttribute::DoubleSided, true},
+        {"pointer!", &SomeData}
+    }};
+
+    CORRADE_VERIFY(converter->beginData());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->add(material));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumSceneConverter::add(): material attribute pointer! is a Trade::MaterialAttributeType::Pointer, which can't be serialized\n");
+}
+
+struct Vertex {
+    Vector3 position;
+    UnsignedShort custom[2];
+};
+
+const Vertex Vertices[]{
+    {{1.0f, 2.0f, 3.0f}, {15, 16}},
+    {{4.0f, 5.0f, 6.0f}, {17, 18}},
+    {{7.0f, 8.0f, 9.0f}, {19, 20}}
+};
+
+/* Index data with some padding in front to verify the offset is kept */
+const UnsignedShort IndexData[]{0xdead, 0, 2, 1, 2};
+
+void MagnumSceneConverterTest::mesh() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    const Containers::ArrayView<const UnsignedShort> indices = Containers::arrayView(IndexData).exceptPrefix(1);
+    MeshData mesh{MeshPrimitive::Triangles,
+        {}, IndexData, MeshIndexData{indices},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{meshAttributeCustom(12), VertexFormat::UnsignedShort, vertices.slice(&Vertex::custom), 2}
+        }};
+
+    CORRADE_VERIFY(converter->beginData());
+    converter->setMeshAttributeName(meshAttributeCustom(12), "veryCustom");
+    CORRADE_VERIFY(converter->add(mesh, "a mesh"));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "a mesh");
+    CORRADE_COMPARE(importer->meshForName("a mesh"), 0);
+    CORRADE_COMPARE(importer->meshAttributeName(meshAttributeCustom(12)), "veryCustom");
+    CORRADE_COMPARE(importer->meshAttributeForName("veryCustom"), meshAttributeCustom(12));
+
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Triangles);
+
+    CORRADE_VERIFY(imported->isIndexed());
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(imported->indexOffset(), 2);
+    CORRADE_COMPARE_AS(imported->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 2, 1, 2}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 2);
+    CORRADE_COMPARE(imported->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(imported->attributeFormat(0), VertexFormat::Vector3);
+    CORRADE_COMPARE(imported->attributeOffset(0), 0);
+    CORRADE_COMPARE(imported->attributeStride(0), sizeof(Vertex));
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(0),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->attributeName(1), meshAttributeCustom(12));
+    CORRADE_COMPARE(imported->attributeFormat(1), VertexFormat::UnsignedShort);
+    CORRADE_COMPARE(imported->attributeOffset(1), 12);
+    CORRADE_COMPARE(imported->attributeStride(1), sizeof(Vertex));
+    CORRADE_COMPARE(imported->attributeArraySize(1), 2);
+    CORRADE_COMPARE_AS(imported->attribute<UnsignedShort[]>(1).transposed<0, 1>()[1],
+        Containers::arrayView<UnsignedShort>({16, 18, 20}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::meshNonIndexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    MeshData mesh{MeshPrimitive::Points, {}, Vertices, {
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)}
+    }};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(mesh));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "");
+
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!imported->isIndexed());
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 1);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::scene() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    struct Field {
+        UnsignedInt object;
+        Int parent;
+        Vector3 translation;
+        UnsignedByte custom;
+    } fields[]{
+        {0, -1, {1.0f, 2.0f, 3.0f}, 7},
+        {1, 0, {4.0f, 5.0f, 6.0f}, 8},
+        {3, 1, {7.0f, 8.0f, 9.0f}, 9}
+    };
+    Containers::StridedArrayView1D<Field> view = fields;
+
+    SceneData scene{SceneMappingType::UnsignedInt, 5, {}, fields, {
+        SceneFieldData{SceneField::Parent, view.slice(&Field::object), view.slice(&Field::parent), SceneFieldFlag::OrderedMapping},
+        SceneFieldData{SceneField::Translation, view.slice(&Field::object), view.slice(&Field::translation)},
+        SceneFieldData{sceneFieldCustom(37), view.slice(&Field::object), view.slice(&Field::custom)}
+    }};
+
+    CORRADE_VERIFY(converter->beginData());
+    converter->setSceneFieldName(sceneFieldCustom(37), "veryCustom");
+    converter->setObjectName(3, "fourth");
+    CORRADE_VERIFY(converter->add(scene, "a scene"));
+    converter->setDefaultScene(0);
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+    CORRADE_COMPARE(importer->sceneCount(), 1);
+    CORRADE_COMPARE(importer->defaultScene(), 0);
+    CORRADE_COMPARE(importer->sceneName(0), "a scene");
+    CORRADE_COMPARE(importer->sceneForName("a scene"), 0);
+    CORRADE_COMPARE(importer->objectCount(), 5);
+    CORRADE_COMPARE(importer->objectName(3), "fourth");
+    CORRADE_COMPARE(importer->objectName(2), "");
+    CORRADE_COMPARE(importer->objectForName("fourth"), 3);
+    CORRADE_COMPARE(importer->sceneFieldName(sceneFieldCustom(37)), "veryCustom");
+    CORRADE_COMPARE(importer->sceneFieldForName("veryCustom"), sceneFieldCustom(37));
+
+    Containers::Optional<SceneData> imported = importer->scene(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->mappingType(), SceneMappingType::UnsignedInt);
+    CORRADE_COMPARE(imported->mappingBound(), 5);
+    CORRADE_COMPARE(imported->fieldCount(), 3);
+
+    /* The fields are saved as offset-only, other flags are preserved */
+    CORRADE_COMPARE(imported->fieldFlags(SceneField::Parent), SceneFieldFlag::OffsetOnly|SceneFieldFlag::OrderedMapping);
+    CORRADE_COMPARE_AS(imported->parentsAsArray(), (Containers::arrayView<Containers::Pair<UnsignedInt, Int>>({
+        {0, -1},
+        {1, 0},
+        {3, 1}
+    })), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imported->field<Vector3>(SceneField::Translation),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->fieldType(sceneFieldCustom(37)), SceneFieldType::UnsignedByte);
+    CORRADE_COMPARE_AS(imported->field<UnsignedByte>(sceneFieldCustom(37)),
+        Containers::arrayView<UnsignedByte>({7, 8, 9}),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::material() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    MaterialData material{MaterialType::PbrMetallicRoughness|MaterialType::PbrClearCoat, {
+        {MaterialAttribute::DoubleSided, true},
+        {"highlightColor", 0x335566ff_rgbaf},
+        {MaterialAttribute::BaseColorTexture, 2u},
+
+        {MaterialLayer::ClearCoat},
+        {"thickness", 0.015f},
+        {MaterialAttribute::LayerFactorTexture, 3u}
+    }, {3, 6}};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(material, "a material"));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+    CORRADE_COMPARE(importer->materialCount(), 1);
+    CORRADE_COMPARE(importer->materialName(0), "a material");
+    CORRADE_COMPARE(importer->materialForName("a material"), 0);
+
+    Containers::Optional<MaterialData> imported = importer->material(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->types(), MaterialType::PbrMetallicRoughness|MaterialType::PbrClearCoat);
+    CORRADE_COMPARE(imported->layerCount(), 2);
+    CORRADE_COMPARE(imported->attributeCount(0), 3);
+    CORRADE_COMPARE(imported->attributeCount(1), 3);
+    CORRADE_COMPARE(imported->layerName(1), "ClearCoat");
+    CORRADE_COMPARE(imported->attribute<bool>(MaterialAttribute::DoubleSided), true);
+    CORRADE_COMPARE(imported->attribute<Color4>("highlightColor"), 0x335566ff_rgbaf);
+    CORRADE_COMPARE(imported->attribute<UnsignedInt>(MaterialAttribute::BaseColorTexture), 2);
+    CORRADE_COMPARE(imported->attribute<Float>(MaterialLayer::ClearCoat, "thickness"), 0.015f);
+    CORRADE_COMPARE(imported->attribute<UnsignedInt>(MaterialLayer::ClearCoat, MaterialAttribute::LayerFactorTexture), 3);
+}
+
+void MagnumSceneConverterTest::images() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const char data1D[]{'\x11', '\x22', '\x33'};
+    ImageData1D image1D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, 3, DataFlags{}, data1D};
+
+    const char data2D[16]{'\x01', '\x02', '\x03', '\x04'};
+    ImageData2D image2D{CompressedPixelFormat::Astc4x4RGBAF, {4, 4}, DataFlags{}, data2D, ImageFlag2D::Array};
+
+    /* Skipping the first slice */
+    const char data3D[]{
+        0, 0, 0, 0,
+        '\xaa', '\xbb', '\xcc', '\xdd'
+    };
+    ImageData3D image3D{PixelStorage{}.setSkip({0, 0, 1}), PixelFormat::RG8Unorm, {2, 1, 1}, DataFlags{}, data3D};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(image1D, "a 1D image"));
+    CORRADE_VERIFY(converter->add(image2D, "a 2D image"));
+    CORRADE_VERIFY(converter->add(image3D, "a 3D image"));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(*data));
+    CORRADE_COMPARE(importer->image1DCount(), 1);
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image3DCount(), 1);
+    CORRADE_COMPARE(importer->image1DName(0), "a 1D image");
+    CORRADE_COMPARE(importer->image2DName(0), "a 2D image");
+    CORRADE_COMPARE(importer->image3DName(0), "a 3D image");
+    CORRADE_COMPARE(importer->image3DForName("a 3D image"), 0);
+
+    {
+        Containers::Optional<ImageData1D> imported = importer->image1D(0);
+        CORRADE_VERIFY(imported);
+        CORRADE_VERIFY(!imported->isCompressed());
+        CORRADE_COMPARE(imported->storage().alignment(), 1);
+        CORRADE_COMPARE(imported->format(), PixelFormat::R8Unorm);
+        CORRADE_COMPARE(imported->size(), Math::Vector<1, Int>{3});
+        CORRADE_COMPARE_AS(imported->data(),
+            Containers::arrayView(data1D),
+            TestSuite::Compare::Container);
+    } {
+        Containers::Optional<ImageData2D> imported = importer->image2D(0);
+        CORRADE_VERIFY(imported);
+        CORRADE_VERIFY(imported->isCompressed());
+        CORRADE_COMPARE(imported->flags(), ImageFlag2D::Array);
+        CORRADE_COMPARE(imported->compressedFormat(), CompressedPixelFormat::Astc4x4RGBAF);
+        CORRADE_COMPARE(imported->size(), (Vector2i{4, 4}));
+        CORRADE_COMPARE_AS(imported->data(),
+            Containers::arrayView(data2D),
+            TestSuite::Compare::Container);
+    } {
+        Containers::Optional<ImageData3D> imported = importer->image3D(0);
+        CORRADE_VERIFY(imported);
+        CORRADE_VERIFY(!imported->isCompressed());
+        CORRADE_COMPARE(imported->storage().skip(), (Vector3i{0, 0, 1}));
+        CORRADE_COMPARE(imported->format(), PixelFormat::RG8Unorm);
+        CORRADE_COMPARE(imported->size(), (Vector3i{2, 1, 1}));
+        CORRADE_COMPARE_AS(imported->pixels<Vector2ub>()[0][0],
+            Containers::arrayView<Vector2ub>({{0xaa, 0xbb}, {0xcc, 0xdd}}),
+            TestSuite::Compare::Container);
+    }
+}
+
+void MagnumSceneConverterTest::openMemory() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    MeshData mesh{MeshPrimitive::Triangles,
+        {}, IndexData, MeshIndexData{IndexData},
+        {}, Vertices, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)}
+        }};
+
+    CORRADE_VERIFY(converter->beginData());
+    CORRADE_VERIFY(converter->add(mesh));
+    Containers::Optional<Containers::Array<char>> data = converter->endData();
+    CORRADE_VERIFY(data);
+
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    /* The data are referenced directly from the passed memory, without any
+       copy */
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openMemory(*data));
+
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->indexDataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_COMPARE(imported->vertexDataFlags(), DataFlag::ExternallyOwned);
+    CORRADE_VERIFY(imported->indexData().data() >= data->begin());
+    CORRADE_VERIFY(imported->indexData().end() <= data->end());
+    CORRADE_VERIFY(imported->vertexData().data() >= data->begin());
+    CORRADE_VERIFY(imported->vertexData().end() <= data->end());
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumSceneConverterTest)
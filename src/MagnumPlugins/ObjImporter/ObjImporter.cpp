@@ -25,60 +25,234 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <unordered_map>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/String.h>
-#include <Corrade/Containers/StringStl.h> /** @todo remove once iostream is dropped */
-#include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
+#include <Corrade/Containers/StringStl.h> /** @todo remove once the name map is not a std::unordered_map */
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Path.h>
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <functional>
+#include <thread>
+#else
+#define MAGNUM_OBJIMPORTER_NO_THREADS
+#endif
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace Trade {
 
+using namespace Containers::Literals;
+
+namespace {
+
+struct ObjMesh {
+    /* Byte range in the file */
+    std::size_t begin, end;
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+};
+
+}
+
 struct ObjImporter::File {
+    /* Either data passed to openData() (taken over or copied) or a
+       non-owning view on the memory-mapped file stored below */
+    Containers::Array<char> in;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped;
+    #endif
+
     std::unordered_map<std::string, UnsignedInt> meshesForName;
-    std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    Containers::Array<Containers::String> meshNames;
+    Containers::Array<ObjMesh> meshes;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+/* The parser works directly on the opened memory, without any per-line
+   allocations. Lines are found with memchr(), tokens are views into the
+   line. */
+
+#ifndef MAGNUM_OBJIMPORTER_NO_THREADS
+/* Minimal amount of bytes parsed by a single thread */
+constexpr std::size_t MinChunkSize = 1024*1024;
+#endif
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+const char* findLineEnd(const char* const begin, const char* const end) {
+    const void* const found = std::memchr(begin, '\n', end - begin);
+    return found ? static_cast<const char*>(found) : end;
+}
+
+/* Splits the keyword from the rest of an already trimmed line */
+Containers::StringView splitKeyword(const Containers::StringView line, Containers::StringView& contents) {
+    const char* i = line.begin();
+    while(i != line.end() && !isWhitespace(*i)) ++i;
+    const Containers::StringView keyword = line.slice(line.begin(), i);
+    while(i != line.end() && isWhitespace(*i)) ++i;
+    contents = line.slice(i, line.end());
+    return keyword;
+}
+
+/* Puts whitespace-separated parts of the string into `out`. Returns the
+   number of parts found, which is `size + 1` if there's more than `size`
+   parts. */
+template<std::size_t size> std::size_t splitOnWhitespace(const Containers::StringView string, Containers::StringView(&out)[size]) {
+    std::size_t count = 0;
+    const char* i = string.begin();
+    for(;;) {
+        while(i != string.end() && isWhitespace(*i)) ++i;
+        if(i == string.end()) break;
+
+        const char* const begin = i;
+        while(i != string.end() && !isWhitespace(*i)) ++i;
+        if(count == size) return size + 1;
+        out[count++] = string.slice(begin, i);
     }
 
-    Math::Vector<size, Float> output;
+    return count;
+}
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+constexpr Float FloatPowersOf10[]{
+    1.0e0f, 1.0e1f, 1.0e2f, 1.0e3f, 1.0e4f, 1.0e5f, 1.0e6f, 1.0e7f, 1.0e8f,
+    1.0e9f, 1.0e10f
+};
+constexpr Double DoublePowersOf10[]{
+    1.0e0, 1.0e1, 1.0e2, 1.0e3, 1.0e4, 1.0e5, 1.0e6, 1.0e7, 1.0e8, 1.0e9,
+    1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15, 1.0e16, 1.0e17, 1.0e18,
+    1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+/* Gives the same result as std::strtof() on the whole string. Plain decimal
+   literals with a short enough mantissa and a small exponent, which is what
+   most OBJ files contain, are converted directly using the Clinger fast path,
+   which is exact because both the mantissa and the power of ten are exactly
+   representable and IEEE division / multiplication is correctly rounded.
+   Everything else (long mantissas, large exponents, hexadecimal floats,
+   infinities, NaNs, invalid input) is delegated to std::strtof(). */
+bool parseFloat(const Containers::StringView string, Float& out) {
+    if(string.isEmpty()) return false;
+
+    const char* i = string.begin();
+    const char* const end = string.end();
+    bool negative = false;
+    if(*i == '+' || *i == '-') {
+        negative = *i == '-';
+        ++i;
+    }
+
+    /* Mantissa digits that don't fit into 64 bits make the literal inexact,
+       only their magnitude is recorded */
+    std::uint64_t mantissa = 0;
+    Int exponent = 0;
+    std::size_t digitCount = 0;
+    bool exact = true;
+    for(; i != end && *i >= '0' && *i <= '9'; ++i, ++digitCount) {
+        if(mantissa < 100000000000000000ull)
+            mantissa = mantissa*10 + (*i - '0');
+        else {
+            if(*i != '0') exact = false;
+            ++exponent;
+        }
+    }
+    if(i != end && *i == '.') for(++i; i != end && *i >= '0' && *i <= '9'; ++i, ++digitCount) {
+        if(mantissa < 100000000000000000ull) {
+            mantissa = mantissa*10 + (*i - '0');
+            --exponent;
+        } else if(*i != '0') exact = false;
+    }
+    if(digitCount && i != end && (*i == 'e' || *i == 'E')) {
+        ++i;
+        bool negativeExponent = false;
+        if(i != end && (*i == '+' || *i == '-')) {
+            negativeExponent = *i == '-';
+            ++i;
+        }
+        /* Require at least one exponent digit, saturate huge values. If
+           there are none, the literal is left to std::strtof(). */
+        Int literalExponent = 0;
+        const char* const exponentBegin = i;
+        for(; i != end && *i >= '0' && *i <= '9'; ++i)
+            if(literalExponent < 100000) literalExponent = literalExponent*10 + (*i - '0');
+        if(i == exponentBegin) exact = false;
+        exponent += negativeExponent ? -literalExponent : literalExponent;
+    }
+
+    if(digitCount && exact && i == end) {
+        /* Both the mantissa and the power of ten are exact in a float, the
+           result is thus correctly rounded. The range is far from both
+           denormals and infinity. */
+        if(mantissa <= (1ull << 24) && exponent >= -10 && exponent <= 10) {
+            const Float value = exponent < 0 ?
+                Float(mantissa)/FloatPowersOf10[-exponent] :
+                Float(mantissa)*FloatPowersOf10[exponent];
+            out = negative ? -value : value;
+            return true;
+        }
+
+        /* The same in a double, which then gets rounded to a float. That's
+           only different from rounding directly if the double result lies
+           exactly halfway between two floats, in which case it goes through
+           the slow path. The range is again far from both denormals and
+           infinity for floats. */
+        if(mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22) {
+            const Double value = exponent < 0 ?
+                Double(mantissa)/DoublePowersOf10[-exponent] :
+                Double(mantissa)*DoublePowersOf10[exponent];
+            const Float rounded = Float(value);
+            const Float other = std::nextafter(rounded, value > Double(rounded) ? HUGE_VALF : -HUGE_VALF);
+            if(Double(rounded) == value || (Double(rounded) + Double(other))*0.5 != value) {
+                out = negative ? -rounded : rounded;
+                return true;
+            }
+        }
+    }
+
+    /* std::strtof() needs a null-terminated string. Usual float literals fit
+       into the small string storage, so this doesn't allocate. Out-of-range
+       values are treated as an error, consistently with std::stof(). */
+    const Containers::String nullTerminated = Containers::String::nullTerminatedView(string);
+    char* parsedEnd;
+    errno = 0;
+    const Float value = std::strtof(nullTerminated.data(), &parsedEnd);
+    if(parsedEnd != nullTerminated.data() + nullTerminated.size() || errno == ERANGE)
+        return false;
+
+    out = value;
+    return true;
+}
+
+bool parseUnsignedInt(const Containers::StringView string, UnsignedInt& out) {
+    if(string.isEmpty()) return false;
 
-        *extra = std::stof(data.back());
+    std::uint64_t value = 0;
+    for(const char c: string) {
+        if(c < '0' || c > '9') return false;
+        value = value*10 + (c - '0');
+        if(value > 0xffffffffull) return false;
     }
 
-    return output;
+    out = UnsignedInt(value);
+    return true;
 }
 
 }
@@ -96,22 +270,38 @@ void ObjImporter::doClose() { _file.reset(); }
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
 void ObjImporter::doOpenFile(const Containers::StringView filename) {
-    /** @todo ARGH clean this up, won't work with UTF-8 */
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
+    /* Memory-map the file if possible, the parser works directly on the
+       mapped memory without having to read a copy first. This function gets
+       called only if file callbacks are not set, those go through
+       doOpenData(). */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    Containers::Optional<Containers::Array<const char, Utility::Path::MapDeleter>> mapped = Utility::Path::mapRead(filename);
+    if(!mapped) {
         Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
         return;
     }
 
     _file.reset(new File);
-    _file->in = std::move(in);
+    /* Fake a mutable array with a non-owning deleter to have the same type as
+       in doOpenData(). The actual memory is owned by the `mapped` array. */
+    _file->in = Containers::Array<char>{const_cast<char*>(mapped->data()), mapped->size(), [](char*, std::size_t) {}};
+    _file->mapped = std::move(mapped);
     parseMeshNames();
+    #else
+    AbstractImporter::doOpenFile(filename);
+    #endif
 }
 
-void ObjImporter::doOpenData(Containers::Array<char>&& data, DataFlags) {
+void ObjImporter::doOpenData(Containers::Array<char>&& data, const DataFlags dataFlags) {
     _file.reset(new File);
-    /** @todo ARGH MY EYES what is this cursed thing, burn it to the ground */
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+
+    /* Take over the existing array or copy the data if we can't */
+    if(dataFlags & (DataFlag::Owned|DataFlag::ExternallyOwned)) {
+        _file->in = std::move(data);
+    } else {
+        _file->in = Containers::Array<char>{NoInit, data.size()};
+        Utility::copy(data, _file->in);
+    }
 
     parseMeshNames();
 }
@@ -122,91 +312,81 @@ void ObjImporter::parseMeshNames() {
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    arrayAppend(_file->meshes, ObjMesh{0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
-    _file->meshNames.emplace_back();
+    arrayAppend(_file->meshNames, InPlaceInit);
 
-    while(_file->in->good()) {
+    const char* const begin = _file->in.begin();
+    const char* const end = _file->in.end();
+    for(const char* i = begin; i != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+        const char* const lineBegin = i;
+        const char* const lineEnd = findLineEnd(i, end);
+        i = lineEnd == end ? end : lineEnd + 1;
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        /* Ignore empty lines and comments */
+        const Containers::StringView line = Containers::StringView{lineBegin, std::size_t(lineEnd - lineBegin)}.trimmed();
+        if(line.isEmpty() || line[0] == '#') continue;
 
         /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        Containers::StringView contents;
+        const Containers::StringView keyword = splitKeyword(line, contents);
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(keyword == "o"_s) {
+            Containers::String name{contents};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
                 thisIsFirstMeshAndItHasNoData = false;
 
                 /* Update its name and add it to name map */
-                if(!name.empty())
-                    _file->meshesForName.emplace(name, _file->meshes.size() - 1);
+                if(!name.isEmpty())
+                    _file->meshesForName.emplace(name, arraySize(_file->meshes) - 1);
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                _file->meshes.back().begin = i - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                _file->meshes.back().end = lineBegin - begin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
-                if(!name.empty())
-                    _file->meshesForName.emplace(name, _file->meshes.size());
-                _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                if(!name.isEmpty())
+                    _file->meshesForName.emplace(name, arraySize(_file->meshes));
+                arrayAppend(_file->meshNames, std::move(name));
+                arrayAppend(_file->meshes, ObjMesh{std::size_t(i - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(keyword == "v"_s) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(keyword == "vn"_s) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    _file->meshes.back().end = end - begin;
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -222,186 +402,348 @@ Containers::String ObjImporter::doMeshName(UnsignedInt id) {
 
 namespace {
 
-template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::Array<T>& data, const Containers::StridedArrayView1D<T>& out, UnsignedInt offset) {
-    /* Check that indices are in range. Add back the original index offset for
-       easier data debugging. */
-    for(UnsignedInt i: indices) if(i >= data.size()) {
-        Error{} << "Trade::ObjImporter::mesh(): index" << (i + offset) << "out of range for" << data.size() << "vertices";
-        return false;
-    }
-
-    MeshTools::duplicateInto(indices, stridedArrayView(data), out);
-    return true;
-}
-
-}
-
-Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+/* Parsing errors are recorded instead of printed right away, because chunks
+   can be parsed on worker threads (where the Error output redirection doesn't
+   apply) and only the first error in file order should get printed */
+enum class ParseError: UnsignedByte {
+    None,
+    InvalidFloatArraySize,
+    InvalidNumber,
+    HomogeneousCoordinates,
+    TextureCoordinates3D,
+    MixedPrimitive,
+    WrongPointIndexCount,
+    WrongLineIndexCount,
+    WrongTriangleIndexCount,
+    Polygons,
+    InvalidIndexData,
+    UnknownKeyword
+};
 
-    Containers::Optional<MeshPrimitive> primitive;
+struct ParsedChunk {
     Containers::Array<Vector3> positions;
     Containers::Array<Vector3> normals;
     Containers::Array<Vector2> textureCoordinates;
     /* Taking a shortcut as there's fortunately nothing else than just 3 types
        of data. First positions, then normals, then texture coordinates. */
     Containers::Array<Vector3ui> indices;
-    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    std::size_t textureCoordinateIndexCount{}, normalIndexCount{};
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+    /* Primitive of the first index line and its position, to detect
+       primitives mixed across chunks */
+    Containers::Optional<MeshPrimitive> primitive;
+    const char* primitiveLine{};
+
+    ParseError error{};
+    const char* errorLine{};
+    /* Primitive that was mixed with `primitive` or an unknown keyword */
+    MeshPrimitive errorPrimitive{};
+    Containers::StringView errorKeyword;
+};
+
+template<std::size_t size> ParseError extractFloatData(const Containers::StringView contents, Math::Vector<size, Float>& out, Float* extra = nullptr) {
+    Containers::StringView data[size + 1];
+    const std::size_t count = splitOnWhitespace(contents, data);
+    if(count < size || count > size + (extra ? 1 : 0))
+        return ParseError::InvalidFloatArraySize;
+
+    for(std::size_t i = 0; i != size; ++i)
+        if(!parseFloat(data[i], out[i])) return ParseError::InvalidNumber;
+
+    if(count == size + 1) {
+        /* This should be obvious from the first if, but add this just to make
+           Clang Analyzer happy */
+        CORRADE_INTERNAL_ASSERT(extra);
+
+        if(!parseFloat(data[size], *extra)) return ParseError::InvalidNumber;
+    }
+
+    return ParseError::None;
+}
 
+/* Parses given line-aligned range of the file. OBJ indices are global for
+   the whole file, so the index data don't need any fixup when the chunks are
+   concatenated afterwards. */
+void parseChunk(const char* const begin, const char* const end, const ObjMesh& mesh, ParsedChunk& out) {
+    const auto fail = [&out](const char* const line, const ParseError error) {
+        out.error = error;
+        out.errorLine = line;
+    };
+
+    for(const char* i = begin; i != end; ) {
         /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
+        const char* const lineBegin = i;
+        const char* const lineEnd = findLineEnd(i, end);
+        i = lineEnd == end ? end : lineEnd + 1;
+        const Containers::StringView line = Containers::StringView{lineBegin, std::size_t(lineEnd - lineBegin)}.trimmed();
 
-        /* Ignore empty lines */
-        if(line.empty()) continue;
+        /* Ignore empty lines and comments */
+        if(line.isEmpty() || line[0] == '#') continue;
 
         /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+        Containers::StringView contents;
+        const Containers::StringView keyword = splitKeyword(line, contents);
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(keyword == "v"_s) {
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
-            }
+            Vector3 data;
+            const ParseError error = extractFloatData<3>(contents, data, &extra);
+            if(error != ParseError::None) return fail(lineBegin, error);
+            if(!Math::TypeTraits<Float>::equals(extra, 1.0f))
+                return fail(lineBegin, ParseError::HomogeneousCoordinates);
 
-            arrayAppend(positions, data);
+            arrayAppend(out.positions, data);
 
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(keyword == "vt"_s) {
             Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
-            }
+            Vector2 data;
+            const ParseError error = extractFloatData<2>(contents, data, &extra);
+            if(error != ParseError::None) return fail(lineBegin, error);
+            if(!Math::TypeTraits<Float>::equals(extra, 0.0f))
+                return fail(lineBegin, ParseError::TextureCoordinates3D);
 
-            arrayAppend(textureCoordinates, data);
+            arrayAppend(out.textureCoordinates, data);
 
         /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
+        } else if(keyword == "vn"_s) {
+            Vector3 data;
+            const ParseError error = extractFloatData<3>(contents, data);
+            if(error != ParseError::None) return fail(lineBegin, error);
+
+            arrayAppend(out.normals, data);
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
-                }
+        } else if(keyword == "p"_s || keyword == "l"_s || keyword == "f"_s) {
+            Containers::StringView indexTuples[3];
+            const std::size_t indexTupleCount = splitOnWhitespace(contents, indexTuples);
+
+            const MeshPrimitive primitive =
+                keyword == "p"_s ? MeshPrimitive::Points :
+                keyword == "l"_s ? MeshPrimitive::Lines :
+                                   MeshPrimitive::Triangles;
+
+            /* Check that we don't mix the primitives in one mesh */
+            if(out.primitive && out.primitive != primitive) {
+                out.errorPrimitive = primitive;
+                return fail(lineBegin, ParseError::MixedPrimitive);
+            }
 
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
-                }
+            /* Remember the first primitive before checking the vertex count
+               so a mixed primitive across chunks gets reported the same way
+               as when parsing everything at once */
+            if(!out.primitive) {
+                out.primitive = primitive;
+                out.primitiveLine = lineBegin;
+            }
 
-                primitive = MeshPrimitive::Points;
+            /* Check vertex count per primitive */
+            if(primitive == MeshPrimitive::Points && indexTupleCount != 1)
+                return fail(lineBegin, ParseError::WrongPointIndexCount);
+            if(primitive == MeshPrimitive::Lines && indexTupleCount != 2)
+                return fail(lineBegin, ParseError::WrongLineIndexCount);
+            if(primitive == MeshPrimitive::Triangles) {
+                if(indexTupleCount < 3)
+                    return fail(lineBegin, ParseError::WrongTriangleIndexCount);
+                else if(indexTupleCount != 3)
+                    return fail(lineBegin, ParseError::Polygons);
+            }
 
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
+            for(std::size_t j = 0; j != indexTupleCount; ++j) {
+                /* Split the tuple on slashes, keeping empty parts */
+                const Containers::StringView indexTuple = indexTuples[j];
+                Containers::StringView indexStrings[3];
+                std::size_t indexStringCount = 0;
+                const char* indexStringBegin = indexTuple.begin();
+                for(const char* c = indexTuple.begin(); ; ++c) {
+                    if(c != indexTuple.end() && *c != '/') continue;
+
+                    if(indexStringCount == 3)
+                        return fail(lineBegin, ParseError::InvalidIndexData);
+
+                    indexStrings[indexStringCount++] = indexTuple.slice(indexStringBegin, c);
+                    if(c == indexTuple.end()) break;
+                    indexStringBegin = c + 1;
                 }
 
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
-                }
+                Vector3ui index;
 
-                primitive = MeshPrimitive::Lines;
+                /* Position indices */
+                if(!parseUnsignedInt(indexStrings[0], index[0]))
+                    return fail(lineBegin, ParseError::InvalidNumber);
+                index[0] -= mesh.positionIndexOffset;
 
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
+                /* Texture coordinates */
+                if(indexStringCount == 2 || (indexStringCount == 3 && !indexStrings[1].isEmpty())) {
+                    if(!parseUnsignedInt(indexStrings[1], index[2]))
+                        return fail(lineBegin, ParseError::InvalidNumber);
+                    index[2] -= mesh.textureCoordinateIndexOffset;
+                    ++out.textureCoordinateIndexCount;
                 }
 
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
+                /* Normal indices */
+                if(indexStringCount == 3) {
+                    if(!parseUnsignedInt(indexStrings[2], index[1]))
+                        return fail(lineBegin, ParseError::InvalidNumber);
+                    index[1] -= mesh.normalIndexOffset;
+                    ++out.normalIndexCount;
                 }
 
-                primitive = MeshPrimitive::Triangles;
+                arrayAppend(out.indices, index);
+            }
 
-            } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(keyword != "mtllib"_s && keyword != "usemtl"_s && keyword != "g"_s && keyword != "s"_s) {
+            out.errorKeyword = keyword;
+            return fail(lineBegin, ParseError::UnknownKeyword);
+        }
+    }
+}
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
-                }
+void printError(const ParsedChunk& chunk) {
+    Error e;
+    e << "Trade::ObjImporter::mesh():";
+    switch(chunk.error) {
+        case ParseError::InvalidFloatArraySize:
+            e << "invalid float array size";
+            return;
+        case ParseError::InvalidNumber:
+            e << "error while converting numeric data";
+            return;
+        case ParseError::HomogeneousCoordinates:
+            e << "homogeneous coordinates are not supported";
+            return;
+        case ParseError::TextureCoordinates3D:
+            e << "3D texture coordinates are not supported";
+            return;
+        case ParseError::MixedPrimitive:
+            e << "mixed primitive" << *chunk.primitive << "and" << chunk.errorPrimitive;
+            return;
+        case ParseError::WrongPointIndexCount:
+            e << "wrong index count for point";
+            return;
+        case ParseError::WrongLineIndexCount:
+            e << "wrong index count for line";
+            return;
+        case ParseError::WrongTriangleIndexCount:
+            e << "wrong index count for triangle";
+            return;
+        case ParseError::Polygons:
+            e << "polygons are not supported";
+            return;
+        case ParseError::InvalidIndexData:
+            e << "invalid index data";
+            return;
+        case ParseError::UnknownKeyword:
+            e << "unknown keyword" << chunk.errorKeyword;
+            return;
+        case ParseError::None: break;
+    }
 
-                Vector3ui index;
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
 
-                /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
+/* Either moves the only chunk's array or concatenates all of them */
+template<class T> Containers::Array<T> mergeChunks(Containers::ArrayView<ParsedChunk> chunks, Containers::Array<T> ParsedChunk::*member) {
+    if(chunks.size() == 1) return std::move(chunks[0].*member);
 
-                /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
-                }
+    std::size_t size = 0;
+    for(const ParsedChunk& chunk: chunks) size += (chunk.*member).size();
+    Containers::Array<T> out{NoInit, size};
+    std::size_t offset = 0;
+    for(const ParsedChunk& chunk: chunks) {
+        Utility::copy(chunk.*member, out.slice(offset, offset + (chunk.*member).size()));
+        offset += (chunk.*member).size();
+    }
 
-                /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
-                }
+    return out;
+}
 
-                arrayAppend(indices, index);
-            }
+template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::Array<T>& data, const Containers::StridedArrayView1D<T>& out, UnsignedInt offset) {
+    /* Check that indices are in range. Add back the original index offset for
+       easier data debugging. */
+    for(UnsignedInt i: indices) if(i >= data.size()) {
+        Error{} << "Trade::ObjImporter::mesh(): index" << (i + offset) << "out of range for" << data.size() << "vertices";
+        return false;
+    }
 
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+    MeshTools::duplicateInto(indices, stridedArrayView(data), out);
+    return true;
+}
+
+}
+
+Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
+    const ObjMesh& mesh = _file->meshes[id];
+    const char* const begin = _file->in.begin() + mesh.begin;
+    const char* const end = _file->in.begin() + mesh.end;
+
+    /* Decide on the thread count. Use just one if the platform doesn't have
+       threads, and at most one thread per MinChunkSize bytes so small files
+       don't get slower due to the thread creation overhead. */
+    #ifndef MAGNUM_OBJIMPORTER_NO_THREADS
+    std::size_t threadCount = configuration().value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = Math::max(Math::min(threadCount, std::size_t(end - begin)/MinChunkSize), std::size_t{1});
+    #else
+    const std::size_t threadCount = 1;
+    #endif
+
+    /* Split the range into line-aligned chunks of roughly equal size */
+    Containers::Array<const char*> chunkBoundaries{NoInit, threadCount + 1};
+    chunkBoundaries[0] = begin;
+    for(std::size_t i = 1; i != threadCount; ++i) {
+        const char* chunkBegin = begin + (end - begin)*i/threadCount;
+        if(chunkBegin < chunkBoundaries[i - 1])
+            chunkBegin = chunkBoundaries[i - 1];
+        const char* const lineEnd = findLineEnd(chunkBegin, end);
+        chunkBoundaries[i] = lineEnd == end ? end : lineEnd + 1;
+    }
+    chunkBoundaries[threadCount] = end;
+
+    /* Parse the first chunk on this thread and the others on worker
+       threads */
+    Containers::Array<ParsedChunk> chunks{threadCount};
+    {
+        #ifndef MAGNUM_OBJIMPORTER_NO_THREADS
+        Containers::Array<std::thread> threads{threadCount - 1};
+        for(std::size_t i = 1; i != threadCount; ++i)
+            threads[i - 1] = std::thread{parseChunk, chunkBoundaries[i], chunkBoundaries[i + 1], std::cref(mesh), std::ref(chunks[i])};
+        #endif
+        parseChunk(chunkBoundaries[0], chunkBoundaries[1], mesh, chunks[0]);
+        #ifndef MAGNUM_OBJIMPORTER_NO_THREADS
+        for(std::thread& thread: threads) thread.join();
+        #endif
+    }
+
+    /* Go through the chunks in order and report the first error, if any */
+    Containers::Optional<MeshPrimitive> primitive;
+    std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+    for(const ParsedChunk& chunk: chunks) {
+        /* Check that we don't mix the primitives in one mesh. If the chunk
+           itself failed before its first index line, the chunk error is
+           reported instead, same as when parsing everything at once. */
+        if(primitive && chunk.primitive && *chunk.primitive != *primitive && (chunk.error == ParseError::None || chunk.primitiveLine <= chunk.errorLine)) {
+            Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << *chunk.primitive;
             return Containers::NullOpt;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        if(chunk.error != ParseError::None) {
+            printError(chunk);
+            return Containers::NullOpt;
+        }
+
+        if(!primitive) primitive = chunk.primitive;
+        textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+        normalIndexCount += chunk.normalIndexCount;
     }
 
+    const Containers::Array<Vector3> positions = mergeChunks(chunks, &ParsedChunk::positions);
+    const Containers::Array<Vector3> normals = mergeChunks(chunks, &ParsedChunk::normals);
+    const Containers::Array<Vector2> textureCoordinates = mergeChunks(chunks, &ParsedChunk::textureCoordinates);
+    Containers::Array<Vector3ui> indices = mergeChunks(chunks, &ParsedChunk::indices);
+
     /* There should be at least indexed position data */
     if(positions.isEmpty() || indices.isEmpty()) {
         Error() << "Trade::ObjImporter::mesh(): incomplete position data";
@@ -458,7 +800,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     {
         Containers::StridedArrayView1D<Vector3> view{vertexData,
             reinterpret_cast<Vector3*>(vertexData.data()), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[0].prefix(vertexCount), positions, view, positionIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[0].prefix(vertexCount), positions, view, mesh.positionIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::Position, view};
         offset += sizeof(Vector3);
@@ -466,7 +808,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     if(normalIndexCount) {
         Containers::StridedArrayView1D<Vector3> view{vertexData,
             reinterpret_cast<Vector3*>(vertexData.data() + offset), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[1].prefix(vertexCount), normals, view, normalIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[1].prefix(vertexCount), normals, view, mesh.normalIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::Normal, view};
         offset += sizeof(Vector3);
@@ -474,7 +816,7 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
     if(textureCoordinateIndexCount) {
         Containers::StridedArrayView1D<Vector2> view{vertexData,
             reinterpret_cast<Vector2*>(vertexData.data() + offset), vertexCount, stride};
-        if(!checkAndDuplicateInto(indicesPerAttribute[2].prefix(vertexCount), textureCoordinates, view, textureCoordinateIndexOffset))
+        if(!checkAndDuplicateInto(indicesPerAttribute[2].prefix(vertexCount), textureCoordinates, view, mesh.textureCoordinateIndexOffset))
             return Containers::NullOpt;
         attributeData[attributeIndex++] = MeshAttributeData{MeshAttribute::TextureCoordinates, view};
         offset += sizeof(Vector2);
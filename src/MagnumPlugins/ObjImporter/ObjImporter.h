@@ -98,6 +98,30 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The file is parsed directly from the memory passed to @ref openData(), without
+any intermediate copies or per-line allocations. If the data are
+@ref DataFlag::Owned or @ref DataFlag::ExternallyOwned, the importer takes
+over or references them directly, otherwise a copy is made. Files opened
+through @ref openFile() are memory-mapped on platforms that support it, unless
+a @ref setFileCallback() "file callback" is set.
+
+Large meshes are parsed in parallel, with each thread parsing a line-aligned
+chunk of the file. The result is the same regardless of the thread count. See
+the @cb{.ini} threads @ce @ref Trade-ObjImporter-configuration "configuration option"
+for controlling the thread count. The plugin links to the system threading
+library (@cpp Threads::Threads @ce in CMake). On Emscripten without pthread
+support, parsing is always single-threaded.
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+See @ref plugins-configuration for more information and an example showing how
+to edit the configuration values.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
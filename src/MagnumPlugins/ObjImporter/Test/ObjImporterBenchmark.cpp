@@ -0,0 +1,175 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020, 2021, 2022 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/String.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void importer();
+    void iostreamBaseline();
+
+    std::string _data;
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* A 10M-face file has around 400 MB, which is too much to be run as part of
+   the test suite. Parsing time scales linearly, so a tenth of that is
+   enough for comparison. */
+constexpr UnsignedInt GridWidth = 1000;
+constexpr UnsignedInt GridHeight = 500;
+constexpr std::size_t FaceCount = GridWidth*GridHeight*2;
+
+const struct {
+    const char* name;
+    UnsignedInt threads;
+} ImporterData[]{
+    {"single-threaded", 1},
+    {"all hardware threads", 0}
+};
+
+ObjImporterBenchmark::ObjImporterBenchmark() {
+    addInstancedBenchmarks({&ObjImporterBenchmark::importer}, 1,
+        Containers::arraySize(ImporterData));
+
+    addBenchmarks({&ObjImporterBenchmark::iostreamBaseline}, 1);
+
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* A grid with a position, texture coordinate and normal for every vertex
+       and two triangles for every cell, with the numbers formatted the same
+       way as usual exporters do */
+    for(UnsignedInt y = 0; y <= GridHeight; ++y) {
+        for(UnsignedInt x = 0; x <= GridWidth; ++x) {
+            const Vector2 coordinates{Float(x)/GridWidth, Float(y)/GridHeight};
+            Utility::formatInto(_data, _data.size(), "v {:.6f} {:.6f} {:.6f}\n", coordinates.x()*2.0f - 1.0f, coordinates.y()*2.0f - 1.0f, coordinates.x()*coordinates.y());
+            Utility::formatInto(_data, _data.size(), "vt {:.6f} {:.6f}\n", coordinates.x(), coordinates.y());
+            Utility::formatInto(_data, _data.size(), "vn {:.4f} {:.4f} {:.4f}\n", -coordinates.y(), -coordinates.x(), 1.0f);
+        }
+    }
+    for(UnsignedInt y = 0; y != GridHeight; ++y) {
+        for(UnsignedInt x = 0; x != GridWidth; ++x) {
+            /* OBJ indices are one-based */
+            const UnsignedInt a = y*(GridWidth + 1) + x + 1;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + GridWidth + 1;
+            const UnsignedInt d = c + 1;
+            Utility::formatInto(_data, _data.size(), "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, b, d);
+            Utility::formatInto(_data, _data.size(), "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, d, c);
+        }
+    }
+}
+
+void ObjImporterBenchmark::importer() {
+    auto&& data = ImporterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", data.threads);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        /* Includes also duplicate removal and building the interleaved
+           vertex buffer, which the baseline doesn't do */
+        importer->openMemory(Containers::ArrayView<const char>{_data.data(), _data.size()});
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexCount(), FaceCount*3);
+    CORRADE_COMPARE(mesh->vertexCount(), (GridWidth + 1)*(GridHeight + 1));
+}
+
+void ObjImporterBenchmark::iostreamBaseline() {
+    /* Tokenization and number parsing the way the importer did it originally,
+       using std::getline() on a std::istringstream, splitting to std::string
+       parts and converting them with std::stof() and std::stoul() */
+    std::size_t faceCount = 0;
+    CORRADE_BENCHMARK(1) {
+        std::istringstream in{_data};
+        std::vector<Vector3> positions;
+        std::vector<Vector2> textureCoordinates;
+        std::vector<Vector3> normals;
+        std::vector<Vector3ui> indices;
+
+        std::string line;
+        while(std::getline(in, line)) {
+            line = Utility::String::trim(line);
+            if(line.empty() || line[0] == '#') continue;
+
+            const std::size_t keywordEnd = line.find(' ');
+            const std::string keyword = line.substr(0, keywordEnd);
+            const std::vector<std::string> contents = Utility::String::splitWithoutEmptyParts(line.substr(keywordEnd + 1), ' ');
+
+            if(keyword == "v" || keyword == "vn") {
+                Vector3 data;
+                for(std::size_t i = 0; i != 3; ++i)
+                    data[i] = std::stof(contents[i]);
+                (keyword == "v" ? positions : normals).push_back(data);
+            } else if(keyword == "vt") {
+                Vector2 data;
+                for(std::size_t i = 0; i != 2; ++i)
+                    data[i] = std::stof(contents[i]);
+                textureCoordinates.push_back(data);
+            } else if(keyword == "f") {
+                for(const std::string& indexTuple: contents) {
+                    const std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
+                    indices.emplace_back(std::stoul(indexStrings[0]) - 1,
+                                         std::stoul(indexStrings[2]) - 1,
+                                         std::stoul(indexStrings[1]) - 1);
+                }
+            }
+        }
+
+        faceCount = indices.size()/3;
+    }
+
+    CORRADE_COMPARE(faceCount, FaceCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
@@ -23,11 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Compare/String.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Path.h>
@@ -41,10 +45,14 @@
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
 
+using namespace Containers::Literals;
+
 struct ObjImporterTest: TestSuite::Tester {
     explicit ObjImporterTest();
 
     void empty();
+    void openFileFailed();
+    void open();
 
     void meshPrimitivePoints();
     void meshPrimitiveLines();
@@ -58,6 +66,8 @@ struct ObjImporterTest: TestSuite::Tester {
     void meshTextureCoordinatesNormals();
 
     void meshIgnoredKeyword();
+    void meshNumberLiterals();
+    void meshWhitespace();
 
     void meshNamed();
     void meshNamedFirstUnnamed();
@@ -77,6 +87,9 @@ struct ObjImporterTest: TestSuite::Tester {
     void invalidIncompleteData();
     void invalidOptionalCoordinate();
 
+    void multithreaded();
+    void multithreadedInvalid();
+
     void openTwice();
     void importTwice();
 
@@ -84,6 +97,23 @@ struct ObjImporterTest: TestSuite::Tester {
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+enum class OpenMethod {
+    File,
+    Data,
+    Memory,
+    FileCallback
+};
+
+const struct {
+    const char* name;
+    OpenMethod method;
+} OpenData[]{
+    {"file", OpenMethod::File},
+    {"data", OpenMethod::Data},
+    {"memory", OpenMethod::Memory},
+    {"file callback", OpenMethod::FileCallback}
+};
+
 const struct {
     const char* name;
     const char* filename;
@@ -118,7 +148,9 @@ const struct {
     const char* message;
 } InvalidNumbersData[]{
     {"invalid float literal", "error while converting numeric data"},
+    {"float literal with a suffix", "error while converting numeric data"},
     {"invalid integer literal", "error while converting numeric data"},
+    {"integer literal out of range", "error while converting numeric data"},
     {"position index out of range", "index 1 out of range for 1 vertices"},
     {"texture index out of range", "index 4 out of range for 3 vertices"},
     {"normal index out of range", "index 3 out of range for 2 vertices"},
@@ -167,10 +199,45 @@ const struct {
     {"texture with optional third component not zero", "3D texture coordinates are not supported"}
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threads;
+} MultithreadedData[]{
+    {"2 threads", 2},
+    {"3 threads", 3},
+    {"8 threads", 8},
+    {"all hardware threads", 0}
+};
+
+const struct {
+    const char* name;
+    const char* firstHalf;
+    const char* secondHalf;
+    bool unknownKeywordInFirstHalf;
+    const char* message;
+} MultithreadedInvalidData[]{
+    {"error in a later chunk",
+        "v 1.0 2.0 3.0\n", "v 1.0 2.0\n", false,
+        "invalid float array size"},
+    {"mixed primitive across chunks",
+        "p 1\n", "l 1 1\n", false,
+        "mixed primitive MeshPrimitive::Points and MeshPrimitive::Lines"},
+    {"mixed primitive across chunks with a wrong index count",
+        "p 1\n", "l 1\n", false,
+        "mixed primitive MeshPrimitive::Points and MeshPrimitive::Lines"},
+    {"error in an earlier chunk before mixed primitive",
+        "p 1\n", "l 1 1\n", true,
+        "unknown keyword bleh"}
+};
+
 ObjImporterTest::ObjImporterTest() {
     addTests({&ObjImporterTest::empty,
+              &ObjImporterTest::openFileFailed});
+
+    addInstancedTests({&ObjImporterTest::open},
+        Containers::arraySize(OpenData));
 
-              &ObjImporterTest::meshPrimitivePoints,
+    addTests({&ObjImporterTest::meshPrimitivePoints,
               &ObjImporterTest::meshPrimitiveLines,
               &ObjImporterTest::meshPrimitiveTriangles,
 
@@ -181,6 +248,8 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::meshTextureCoordinatesNormals,
 
               &ObjImporterTest::meshIgnoredKeyword,
+              &ObjImporterTest::meshNumberLiterals,
+              &ObjImporterTest::meshWhitespace,
 
               &ObjImporterTest::meshNamed});
 
@@ -210,6 +279,12 @@ ObjImporterTest::ObjImporterTest() {
     addInstancedTests({&ObjImporterTest::invalidOptionalCoordinate},
         Containers::arraySize(InvalidOptionalCoordinateData));
 
+    addInstancedTests({&ObjImporterTest::multithreaded},
+        Containers::arraySize(MultithreadedData));
+
+    addInstancedTests({&ObjImporterTest::multithreadedInvalid},
+        Containers::arraySize(MultithreadedInvalidData));
+
     addTests({&ObjImporterTest::openTwice,
               &ObjImporterTest::importTwice});
 
@@ -234,6 +309,69 @@ void ObjImporterTest::empty() {
     CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): incomplete position data\n");
 }
 
+void ObjImporterTest::openFileFailed() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openFile("nonexistent.obj"));
+    /* There's an error message from Path::mapRead() or Path::read() before,
+       and the file is opened either by the plugin or the base
+       implementation */
+    CORRADE_COMPARE_AS(out.str(),
+        "::openFile(): cannot open file nonexistent.obj\n",
+        TestSuite::Compare::StringHasSuffix);
+}
+
+void ObjImporterTest::open() {
+    auto&& data = OpenData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    const Containers::String filename = Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-multiple.obj");
+
+    /* Needs to stay in scope for openMemory() */
+    Containers::Array<char> storage;
+    if(data.method == OpenMethod::FileCallback) {
+        importer->setFileCallback([](const std::string& filename, InputFileCallbackPolicy, Containers::Array<char>& storage) -> Containers::Optional<Containers::ArrayView<const char>> {
+            Containers::Optional<Containers::Array<char>> data = Utility::Path::read(filename);
+            CORRADE_VERIFY(data);
+            storage = *std::move(data);
+            return Containers::ArrayView<const char>{storage};
+        }, storage);
+    }
+
+    if(data.method == OpenMethod::File || data.method == OpenMethod::FileCallback) {
+        CORRADE_VERIFY(importer->openFile(filename));
+    } else {
+        Containers::Optional<Containers::Array<char>> file = Utility::Path::read(filename);
+        CORRADE_VERIFY(file);
+        storage = *std::move(file);
+        if(data.method == OpenMethod::Data) {
+            CORRADE_VERIFY(importer->openData(storage));
+            /* The data got copied, so this shouldn't affect anything */
+            for(char& c: storage) c = '\0';
+        } else if(data.method == OpenMethod::Memory) {
+            CORRADE_VERIFY(importer->openMemory(storage));
+        } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    CORRADE_COMPARE(importer->meshCount(), 3);
+    CORRADE_COMPARE(importer->meshForName("LineMesh"), 1);
+
+    const Containers::Optional<MeshData> mesh = importer->mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.5f, 2.0f, 3.0f},
+            {0.0f, 1.5f, 1.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1, 1, 0}),
+        TestSuite::Compare::Container);
+}
+
 void ObjImporterTest::meshPrimitivePoints() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-primitive-points.obj")));
@@ -452,6 +590,49 @@ void ObjImporterTest::meshIgnoredKeyword() {
         TestSuite::Compare::Container);
 }
 
+void ObjImporterTest::meshNumberLiterals() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openData(
+        "v 1e2 -.5 +1.25\n"
+        /* Long mantissa, maximum float value, mantissa longer than 64 bits */
+        "v 0.100000001490116119384765625 3.4028235e38 1.00000000000000000001\n"
+        "v 123456789.0 -0 1.5E-3\n"
+        "p 1\n"
+        "p 2\n"
+        "p 3\n"_s));
+
+    const Containers::Optional<MeshData> data = importer->mesh(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE_AS(data->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {100.0f, -0.5f, 1.25f},
+            {0.1f, 3.4028235e38f, 1.0f},
+            {123456789.0f, -0.0f, 0.0015f}
+        }), TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::meshWhitespace() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openData(
+        "v\t1 2 3\r\n"
+        "  # indented comment\r\n"
+        "\tv 4  5\t6 \r\n"
+        "\r\n"
+        "l 1\t 2\r\n"_s));
+
+    const Containers::Optional<MeshData> data = importer->mesh(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(data->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({0, 1}),
+        TestSuite::Compare::Container);
+}
+
 void ObjImporterTest::meshNamed() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
     CORRADE_VERIFY(importer->openFile(Utility::Path::join(OBJIMPORTER_TEST_DIR, "mesh-named.obj")));
@@ -666,6 +847,102 @@ void ObjImporterTest::invalidOptionalCoordinate() {
     CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
 }
 
+void ObjImporterTest::multithreaded() {
+    auto&& data = MultithreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A small mesh first to test global index offsets, then a grid that's
+       large enough to be split into several chunks. No newline at the end to
+       test the last chunk boundary. */
+    std::string file = "o small\nv 0 0 0\nvt 0 0\nvn 0 0 1\np 1/1/1\no grid\n";
+    constexpr UnsignedInt Size = 300;
+    for(UnsignedInt y = 0; y <= Size; ++y) {
+        for(UnsignedInt x = 0; x <= Size; ++x) {
+            Utility::formatInto(file, file.size(), "v {} {} {}\n", Float(x)/Size, Float(y)/Size, Float(x*y)/(Size*Size));
+            Utility::formatInto(file, file.size(), "vt {} {}\n", Float(x)/Size, Float(y)/Size);
+            Utility::formatInto(file, file.size(), "vn {} {} 1\n", Float(x)/Size, Float(y)/Size);
+        }
+    }
+    for(UnsignedInt y = 0; y != Size; ++y) {
+        for(UnsignedInt x = 0; x != Size; ++x) {
+            /* OBJ indices are one-based, plus one for the first mesh */
+            const UnsignedInt a = y*(Size + 1) + x + 2;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + Size + 1;
+            const UnsignedInt d = c + 1;
+            Utility::formatInto(file, file.size(), "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, b, d);
+            Utility::formatInto(file, file.size(), "f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2}\n", a, d, c);
+        }
+    }
+    file.pop_back();
+    /* Should be large enough to have at least 8 chunks */
+    CORRADE_COMPARE_AS(file.size(), std::size_t{8*1024*1024},
+        TestSuite::Compare::Greater);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", 1);
+    CORRADE_VERIFY(importer->openData(Containers::ArrayView<const char>{file.data(), file.size()}));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+    Containers::Optional<MeshData> expected = importer->mesh(1);
+    CORRADE_VERIFY(expected);
+    CORRADE_COMPARE(expected->indexCount(), Size*Size*6);
+    CORRADE_COMPARE(expected->vertexCount(), (Size + 1)*(Size + 1));
+
+    importer->configuration().setValue("threads", data.threads);
+    Containers::Optional<MeshData> mesh = importer->mesh(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        expected->indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        expected->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        expected->attribute<Vector3>(MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        expected->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TestSuite::Compare::Container);
+
+    /* The first mesh should be unaffected */
+    Containers::Optional<MeshData> small = importer->mesh(0);
+    CORRADE_VERIFY(small);
+    CORRADE_COMPARE(small->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(small->vertexCount(), 1);
+}
+
+void ObjImporterTest::multithreadedInvalid() {
+    auto&& data = MultithreadedInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Two halves of roughly 2 MB each, so with 4 threads there's a chunk
+       boundary in both halves and also around the middle */
+    std::string file = "v 1.0 2.0 3.0\n";
+    const std::size_t firstHalfSize = 2*1024*1024/std::strlen(data.firstHalf);
+    const std::size_t secondHalfSize = 2*1024*1024/std::strlen(data.secondHalf);
+    for(std::size_t i = 0; i != firstHalfSize; ++i) {
+        if(data.unknownKeywordInFirstHalf && i == firstHalfSize - 10)
+            file += "bleh\n";
+        file += data.firstHalf;
+    }
+    for(std::size_t i = 0; i != secondHalfSize; ++i)
+        file += data.secondHalf;
+
+    for(UnsignedInt threads: {1, 4}) {
+        CORRADE_ITERATION(threads);
+
+        Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+        importer->configuration().setValue("threads", threads);
+        CORRADE_VERIFY(importer->openData(Containers::ArrayView<const char>{file.data(), file.size()}));
+
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->mesh(0));
+        CORRADE_COMPARE(out.str(), Utility::formatString("Trade::ObjImporter::mesh(): {}\n", data.message));
+    }
+}
+
 void ObjImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
 